@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Window.hpp"
+#include "DirtyRegion.hpp"
 #include "helpers/ComPtr.hpp"
 #include "graphics/Graphics.hpp"
 #include "graphics/RenderTarget.hpp"
@@ -13,6 +14,8 @@
 #include <d3d11.h>
 #include <d3d11_4.h>
 #include <dcomp.h>
+#include <cstdint>
+#include <optional>
 
 
 namespace PGUI
@@ -28,10 +31,34 @@ namespace PGUI::Core
 		friend void PGUI::Initialize();
 
 		public:
+		struct PaintStatistics
+		{
+			/**
+			* @brief Pixels actually rasterized by the last frame (bounds of the dirty region)
+			*/
+			std::uint64_t lastFramePixels = 0;
+			/**
+			* @brief Pixels handed to Present1 as dirty by the last frame
+			*/
+			std::uint64_t lastFramePresentedPixels = 0;
+			std::uint64_t surfacePixels = 0;
+			std::uint64_t totalPixels = 0;
+			std::uint64_t frameCount = 0;
+		};
+
 		explicit DirectCompositionWindow(const WindowClass::WindowClassPtr& wndClass) noexcept;
 
 		[[nodiscard]] auto GetGraphics() const noexcept { return Graphics::Graphics{ d2d1Dc }; }
 
+		[[nodiscard]] auto GetPaintStatistics() const noexcept -> const PaintStatistics& { return paintStatistics; }
+		void ResetPaintStatistics() noexcept { paintStatistics = PaintStatistics{ }; }
+
+		/**
+		* @brief Tells the compositor the content of scrollRect moved by offset since the last frame
+		* scrollRect is invalidated as well, it's only a presentation hint
+		*/
+		void ScrollContent(RectL scrollRect, PointL offset) noexcept;
+
 		protected:
 		[[nodiscard]] static auto D3D11Device() noexcept { return d3d11Device; }
 		[[nodiscard]] static auto DXGIDevice() noexcept { return dxgiDevice; }
@@ -41,6 +68,13 @@ namespace PGUI::Core
 		[[nodiscard]] auto DCompositionTarget() const noexcept { return dcompTarget; }
 		[[nodiscard]] auto D2D1DeviceContext() const noexcept { return d2d1Dc; }
 
+		/**
+		* @brief Region repainted by the current BeginDraw/EndDraw pair
+		* Drawing is already clipped to its bounds, paint handlers can use it to skip what's outside
+		*/
+		[[nodiscard]] auto GetDirtyRegion() const noexcept -> const DirtyRegion& { return drawRegion; }
+		[[nodiscard]] auto GetDirtyRect() const noexcept -> RectF { return drawRegion.GetBounds(); }
+
 		virtual void BeginDraw();
 		virtual auto EndDraw() -> HRESULT;
 
@@ -56,6 +90,18 @@ namespace PGUI::Core
 		ComPtr<IDCompositionTarget> dcompTarget;
 		ComPtr<ID2D1DeviceContext7> d2d1Dc;
 
+		SizeL bufferSize{ 1, 1 };
+		/*
+		* Flip model back buffers hold the frame before the previous one,
+		* so each frame redraws what changed now plus what changed last frame
+		*/
+		DirtyRegion presentRegion;
+		DirtyRegion previousPresentRegion;
+		DirtyRegion drawRegion;
+		std::optional<std::pair<RectL, PointL>> pendingScroll;
+		bool fullRepaintRequired = true;
+		PaintStatistics paintStatistics;
+
 		static void InitD3D11Device();
 		static void InitDCompDevice();
 		static void InitD2D1Device();
@@ -63,6 +109,9 @@ namespace PGUI::Core
 		void InitD2D1DeviceContext();
 		void InitDirectComposition();
 
+		void CollectDirtyRegion();
+		void PresentDirtyRegion();
+
 		auto OnNCCreate(UINT msg, WPARAM wParam, LPARAM lParam) -> Core::HandlerResult;
 		auto OnSize(UINT msg, WPARAM wParam, LPARAM lParam) -> Core::HandlerResult;
 	};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Rect.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+namespace PGUI::Core
+{
+	/**
+	* @brief Set of non overlapping rectangles that need to be repainted
+	*
+	* Overlapping rectangles are merged when added and the set is capped at MaxRects,
+	* once it's full the pair that grows the least when merged is combined
+	*/
+	class DirtyRegion
+	{
+		public:
+		static constexpr std::size_t MaxRects = 8;
+
+		DirtyRegion() noexcept = default;
+
+		void Add(RectL rect);
+		void Add(const DirtyRegion& other);
+		void Clear() noexcept;
+		/**
+		* @brief Intersects every rectangle with bounds and drops the ones that end up empty
+		*/
+		void ClipTo(RectL bounds);
+
+		[[nodiscard]] auto IsEmpty() const noexcept { return rects.empty(); }
+		[[nodiscard]] auto GetRects() const noexcept -> std::span<const RectL> { return rects; }
+		[[nodiscard]] auto GetBounds() const noexcept -> RectL;
+		/**
+		* @brief Number of pixels covered, rectangles never overlap so this is exact
+		*/
+		[[nodiscard]] auto GetArea() const noexcept -> std::uint64_t;
+		[[nodiscard]] auto Covers(RectL rect) const noexcept -> bool;
+
+		private:
+		std::vector<RectL> rects;
+
+		void MergeClosestPair();
+		[[nodiscard]] static auto Union(RectL a, RectL b) noexcept -> RectL;
+		[[nodiscard]] static auto AreaOf(RectL rect) noexcept -> std::uint64_t;
+	};
+}
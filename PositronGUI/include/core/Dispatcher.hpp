@@ -0,0 +1,76 @@
+#pragma once
+
+#include "core/DispatcherQueue.hpp"
+
+#include <atomic>
+#include <memory>
+#include <Windows.h>
+
+
+namespace PGUI::Core
+{
+	/**
+	* @brief Hands work from any thread to a UI thread
+	*
+	* Wraps a DispatcherQueue drained by a message only window on the UI thread,
+	* so it runs from any message loop (modal ones too) with one posted message per batch
+	* Background work left over after a Drain continues from a WM_TIMER, which doesn't starve input and painting
+	*/
+	class Dispatcher
+	{
+		public:
+		using Work = DispatcherQueue::Work;
+
+		/**
+		* @brief Dispatcher of the calling thread, created on first use and shut down when the thread exits
+		*/
+		[[nodiscard]] static auto GetForCurrentThread() -> Dispatcher&;
+		/**
+		* @brief nullptr if that thread hasn't created a dispatcher or already exited
+		*/
+		[[nodiscard]] static auto GetForThread(DWORD threadId) -> std::shared_ptr<Dispatcher>;
+
+		Dispatcher();
+		~Dispatcher() noexcept;
+
+		Dispatcher(const Dispatcher&) = delete;
+		auto operator=(const Dispatcher&) -> Dispatcher& = delete;
+		Dispatcher(Dispatcher&&) noexcept = delete;
+		auto operator=(Dispatcher&&) noexcept -> Dispatcher& = delete;
+
+		void Post(Work work, DispatcherPriority priority = DispatcherPriority::Normal)
+		{
+			queue->Post(std::move(work), priority);
+		}
+		/**
+		* @brief co_await dispatcher.SwitchToUI() continues the coroutine on the UI thread
+		*/
+		[[nodiscard]] auto SwitchToUI(DispatcherPriority priority = DispatcherPriority::Normal) noexcept
+		{
+			return queue->SwitchTo(priority);
+		}
+
+		[[nodiscard]] auto IsUIThread() const noexcept { return queue->IsConsumerThread(); }
+		[[nodiscard]] auto GetThreadId() const noexcept { return threadId; }
+		[[nodiscard]] auto GetQueue() const noexcept -> const std::shared_ptr<DispatcherQueue>& { return queue; }
+
+		/**
+		* @brief Destroys the window, work posted afterwards never runs, UI thread only
+		*/
+		void Shutdown() noexcept;
+
+		private:
+		static constexpr UINT WM_DISPATCHER_WAKE = WM_USER;
+		static constexpr UINT_PTR DrainTimerId = 1;
+
+		HWND hWnd = nullptr;
+		DWORD threadId;
+		// Shared with the wake callback, the queue can outlive the dispatcher
+		std::shared_ptr<std::atomic_bool> isShutDown = std::make_shared<std::atomic_bool>(false);
+		std::shared_ptr<DispatcherQueue> queue;
+
+		void Drain();
+
+		static auto CALLBACK WindowProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam) -> LRESULT;
+	};
+}
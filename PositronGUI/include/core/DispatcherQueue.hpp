@@ -0,0 +1,144 @@
+#pragma once
+
+#include "helpers/InlineFunction.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+
+namespace PGUI::Core
+{
+	/**
+	* @brief Order in which queued work runs, Input first
+	*/
+	enum class DispatcherPriority
+	{
+		Input,
+		Render,
+		Normal,
+		Background
+	};
+	constexpr std::size_t DispatcherPriorityCount = 4;
+
+	/**
+	* @brief Multiple producer single consumer work queue, independent of any window system
+	*
+	* Post is lock free: each priority is a stack the consumer takes whole and reverses, so work runs in posting order
+	* The wake callback is called only when the queue goes from idle to having work,
+	* a burst of posts before the consumer gets to Drain costs one wake up
+	*/
+	class DispatcherQueue
+	{
+		public:
+		using Work = InlineFunction<void()>;
+		using WakeCallback = std::function<bool()>;
+		using Clock = std::chrono::steady_clock;
+
+		static constexpr Clock::duration DefaultBackgroundBudget = std::chrono::milliseconds{ 4 };
+
+		struct DrainResult
+		{
+			std::size_t executedCount = 0;
+			/**
+			* @brief Background work left over after the budget ran out, Drain has to be called again
+			*/
+			bool hasRemainingWork = false;
+		};
+
+		class SwitchAwaiter
+		{
+			public:
+			SwitchAwaiter(DispatcherQueue& queue, DispatcherPriority priority) noexcept :
+				queue{ &queue }, priority{ priority }
+			{
+			}
+
+			[[nodiscard]] auto await_ready() const noexcept -> bool { return queue->IsConsumerThread(); }
+			void await_suspend(std::coroutine_handle<> handle) const
+			{
+				queue->Post([handle] { handle.resume(); }, priority);
+			}
+			void await_resume() const noexcept { /* */ }
+
+			private:
+			DispatcherQueue* queue;
+			DispatcherPriority priority;
+		};
+
+		/**
+		* @brief The calling thread becomes the consumer
+		* wakeCallback is called from whichever thread posts, it should only signal the consumer
+		* and return false if that failed, so the next post tries again instead of the work waiting for an unrelated wake up
+		*/
+		explicit DispatcherQueue(WakeCallback wakeCallback);
+		/**
+		* @brief Work that never ran is destroyed without running, suspended coroutines are not resumed
+		*/
+		~DispatcherQueue() noexcept;
+
+		DispatcherQueue(const DispatcherQueue&) = delete;
+		auto operator=(const DispatcherQueue&) -> DispatcherQueue& = delete;
+		DispatcherQueue(DispatcherQueue&&) noexcept = delete;
+		auto operator=(DispatcherQueue&&) noexcept -> DispatcherQueue& = delete;
+
+		/**
+		* @brief Thread safe
+		*/
+		void Post(Work work, DispatcherPriority priority = DispatcherPriority::Normal);
+
+		/**
+		* @brief Runs the queued work by priority, consumer thread only
+		* Everything but Background work runs to completion,
+		* Background work stops once backgroundBudget is used up (at least one item always runs)
+		* Work posted while draining waits for the next Drain
+		*/
+		auto Drain(Clock::duration backgroundBudget = DefaultBackgroundBudget) -> DrainResult;
+
+		/**
+		* @brief co_await queue.SwitchTo() resumes the coroutine on the consumer thread,
+		* right away if it's already running there
+		*/
+		[[nodiscard]] auto SwitchTo(DispatcherPriority priority = DispatcherPriority::Normal) noexcept -> SwitchAwaiter
+		{
+			return SwitchAwaiter{ *this, priority };
+		}
+
+		[[nodiscard]] auto IsConsumerThread() const noexcept -> bool { return std::this_thread::get_id() == consumerThread; }
+		[[nodiscard]] auto GetWakeCount() const noexcept { return wakeCount.load(std::memory_order_relaxed); }
+		[[nodiscard]] auto GetPostedCount() const noexcept { return postedCount.load(std::memory_order_relaxed); }
+
+		private:
+		struct Node
+		{
+			Work work;
+			Node* next = nullptr;
+		};
+		struct NodeList
+		{
+			Node* head = nullptr;
+			Node* tail = nullptr;
+
+			[[nodiscard]] auto IsEmpty() const noexcept { return head == nullptr; }
+			void AppendReversed(Node* stack) noexcept;
+			[[nodiscard]] auto PopFront() noexcept -> Node*;
+			void Destroy() noexcept;
+		};
+
+		std::array<std::atomic<Node*>, DispatcherPriorityCount> incoming{ };
+		std::atomic_bool wakeRequested = false;
+		std::atomic_uint64_t wakeCount = 0;
+		std::atomic_uint64_t postedCount = 0;
+
+		// Consumer thread only
+		std::array<NodeList, DispatcherPriorityCount> pending{ };
+
+		WakeCallback wakeCallback;
+		std::thread::id consumerThread;
+	};
+}
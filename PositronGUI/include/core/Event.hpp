@@ -1,54 +1,343 @@
 #pragma once
 
-#include <functional>
-#include <list>
+#include "core/DispatcherQueue.hpp"
+#include "helpers/InlineFunction.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 
 namespace PGUI::Core
 {
+	enum class EventDelivery
+	{
+		/**
+		* @brief The handler runs on the thread that calls Emit
+		*/
+		Direct,
+		/**
+		* @brief The handler is posted to the Dispatcher of the thread that subscribed it
+		* It gets copies of the arguments, so views and pointers passed to Emit have to outlive the call
+		*/
+		UIThread
+	};
+
+	namespace event_detail
+	{
+		class EventStateBase
+		{
+			public:
+			virtual ~EventStateBase() noexcept = default;
+
+			virtual void Unsubscribe(std::uint64_t id) = 0;
+			[[nodiscard]] virtual auto IsSubscribed(std::uint64_t id) const -> bool = 0;
+		};
+
+		/**
+		* @brief Queue of the calling thread's Dispatcher
+		*/
+		[[nodiscard]] auto GetCurrentThreadQueue() -> std::shared_ptr<DispatcherQueue>;
+	}
+
+	/**
+	* @brief Identifies a subscription, doesn't unsubscribe by itself
+	* Safe to use after the event is gone
+	*/
+	class EventConnection
+	{
+		public:
+		EventConnection() noexcept = default;
+		EventConnection(std::weak_ptr<event_detail::EventStateBase> state, std::uint64_t id) noexcept;
+
+		void Disconnect();
+		[[nodiscard]] auto IsConnected() const -> bool;
+
+		private:
+		std::weak_ptr<event_detail::EventStateBase> state;
+		std::uint64_t id = 0;
+	};
+
+	/**
+	* @brief Unsubscribes when destroyed
+	*/
+	class ScopedEventConnection
+	{
+		public:
+		ScopedEventConnection() noexcept = default;
+		explicit(false) ScopedEventConnection(EventConnection connection) noexcept;
+		~ScopedEventConnection() noexcept;
+
+		ScopedEventConnection(const ScopedEventConnection&) = delete;
+		auto operator=(const ScopedEventConnection&) -> ScopedEventConnection& = delete;
+		ScopedEventConnection(ScopedEventConnection&& other) noexcept;
+		auto operator=(ScopedEventConnection&& other) noexcept -> ScopedEventConnection&;
+
+		void Disconnect();
+		[[nodiscard]] auto IsConnected() const -> bool { return connection.IsConnected(); }
+		/**
+		* @brief Stops managing the subscription without unsubscribing
+		*/
+		[[nodiscard]] auto Release() noexcept -> EventConnection;
+
+		private:
+		EventConnection connection;
+	};
+
+	/**
+	* @brief Thread safe multicast event
+	*
+	* Handlers are kept in an immutable array that Subscribe and Unsubscribe replace (copy on write),
+	* Emit only counts itself in and out of the event and walks the current array,
+	* so it's wait free and doesn't allocate for Direct handlers
+	* Replaced arrays are freed by a later write once no Emit is running
+	*
+	* A handler can subscribe or unsubscribe handlers (itself too) while it runs
+	* An Emit on another thread that already started can still call a handler after Disconnect returns,
+	* Emits that start later or run on the thread that disconnected won't
+	*/
 	template <typename... Args>
 	class Event
 	{
-		using EventHandler = std::function<void(Args...)>;
-
 		public:
-		void Subscribe(const EventHandler& handler) noexcept
+		using EventHandler = InlineFunction<void(Args...)>;
+
+		Event() :
+			state{ std::make_shared<State>() }
 		{
-			eventHandlers.push_back(handler);
 		}
+		~Event() noexcept = default;
 
-		void Emit(Args... args) const
+		Event(const Event&) = delete;
+		auto operator=(const Event&) -> Event& = delete;
+		Event(Event&&) noexcept = default;
+		auto operator=(Event&&) noexcept -> Event& = default;
+
+		auto Subscribe(EventHandler handler, EventDelivery delivery = EventDelivery::Direct) -> EventConnection
 		{
-			for (auto& handler : eventHandlers)
+			if (!state)
 			{
-				std::invoke(handler, args...);
+				state = std::make_shared<State>();
 			}
-		}
-
-		private:
-		std::list<EventHandler> eventHandlers;
-	};
 
-	template <>
-	class Event<void>
-	{
-		using EventHandler = std::function<void(void)>;
+			std::weak_ptr<DispatcherQueue> postQueue;
+			if (delivery == EventDelivery::UIThread)
+			{
+				postQueue = event_detail::GetCurrentThreadQueue();
+			}
 
-		public:
-		void Subscribe(const EventHandler& handler)
+			const auto id = state->Add(std::move(handler), std::move(postQueue), delivery);
+			return EventConnection{ state, id };
+		}
+		void Clear()
 		{
-			eventHandlers.push_back(handler);
+			if (state)
+			{
+				state->Clear();
+			}
 		}
 
-		void Emit() const
+		void Emit(Args... args) const
 		{
-			for (const auto& handler : eventHandlers)
+			if (state)
 			{
-				std::invoke(handler);
+				state->Emit(args...);
 			}
 		}
 
+		[[nodiscard]] auto GetHandlerCount() const -> std::size_t
+		{
+			return state ? state->GetHandlerCount() : 0;
+		}
+
 		private:
-		std::list<EventHandler> eventHandlers;
+		struct Handler
+		{
+			EventHandler function;
+			std::uint64_t id;
+			std::weak_ptr<DispatcherQueue> postQueue;
+			EventDelivery delivery;
+			std::atomic_bool connected = true;
+
+			Handler(EventHandler _function, std::uint64_t _id,
+				std::weak_ptr<DispatcherQueue> _postQueue, EventDelivery _delivery) noexcept :
+				function{ std::move(_function) }, id{ _id }, postQueue{ std::move(_postQueue) }, delivery{ _delivery }
+			{
+			}
+		};
+		using Snapshot = std::vector<std::shared_ptr<Handler>>;
+
+		class State final : public event_detail::EventStateBase
+		{
+			public:
+			~State() noexcept override
+			{
+				delete current.load();
+			}
+
+			auto Add(EventHandler handler, std::weak_ptr<DispatcherQueue> postQueue, EventDelivery delivery) -> std::uint64_t
+			{
+				std::scoped_lock lock{ writeMutex };
+
+				const auto id = nextId++;
+				auto next = Copy();
+				next->push_back(std::make_shared<Handler>(std::move(handler), id, std::move(postQueue), delivery));
+				Publish(std::move(next));
+
+				return id;
+			}
+			void Unsubscribe(std::uint64_t id) override
+			{
+				std::scoped_lock lock{ writeMutex };
+
+				const auto* snapshot = current.load();
+				if (snapshot == nullptr)
+				{
+					return;
+				}
+
+				auto next = std::make_unique<Snapshot>();
+				next->reserve(snapshot->size());
+				for (const auto& handler : *snapshot)
+				{
+					if (handler->id == id)
+					{
+						handler->connected = false;
+					}
+					else
+					{
+						next->push_back(handler);
+					}
+				}
+				Publish(std::move(next));
+			}
+			void Clear()
+			{
+				std::scoped_lock lock{ writeMutex };
+
+				if (const auto* snapshot = current.load();
+					snapshot != nullptr)
+				{
+					for (const auto& handler : *snapshot)
+					{
+						handler->connected = false;
+					}
+				}
+				Publish(nullptr);
+			}
+			[[nodiscard]] auto GetHandlerCount() const -> std::size_t
+			{
+				std::scoped_lock lock{ writeMutex };
+
+				const auto* snapshot = current.load();
+				return snapshot != nullptr ? snapshot->size() : 0;
+			}
+			[[nodiscard]] auto IsSubscribed(std::uint64_t id) const -> bool override
+			{
+				std::scoped_lock lock{ writeMutex };
+
+				const auto* snapshot = current.load();
+				return snapshot != nullptr && std::ranges::any_of(*snapshot, [id](const auto& handler)
+				{
+					return handler->id == id;
+				});
+			}
+
+			void Emit(const Args&... args) const
+			{
+				if (current.load(std::memory_order_relaxed) == nullptr)
+				{
+					return;
+				}
+
+				// Counting in before loading the array is what keeps writers from freeing it under us
+				activeEmitters.fetch_add(1);
+				EmitScope scope{ activeEmitters };
+
+				const auto* snapshot = current.load();
+				if (snapshot == nullptr)
+				{
+					return;
+				}
+
+				for (const auto& handler : *snapshot)
+				{
+					if (!handler->connected.load(std::memory_order_relaxed))
+					{
+						continue;
+					}
+
+					if (handler->delivery == EventDelivery::Direct)
+					{
+						handler->function(args...);
+					}
+					else if (const auto queue = handler->postQueue.lock();
+						queue != nullptr)
+					{
+						queue->Post([handler, ...args = args]
+						{
+							if (handler->connected.load(std::memory_order_relaxed))
+							{
+								handler->function(args...);
+							}
+						});
+					}
+				}
+			}
+
+			private:
+			struct EmitScope
+			{
+				std::atomic_size_t& activeEmitters;
+
+				~EmitScope() noexcept
+				{
+					activeEmitters.fetch_sub(1, std::memory_order_release);
+				}
+			};
+
+			std::atomic<const Snapshot*> current = nullptr;
+			mutable std::atomic_size_t activeEmitters = 0;
+			mutable std::mutex writeMutex;
+			std::vector<std::unique_ptr<const Snapshot>> retired;
+			std::uint64_t nextId = 1;
+
+			[[nodiscard]] auto Copy() const -> std::unique_ptr<Snapshot>
+			{
+				const auto* snapshot = current.load();
+				return snapshot != nullptr ? std::make_unique<Snapshot>(*snapshot) : std::make_unique<Snapshot>();
+			}
+			void Publish(std::unique_ptr<Snapshot> next)
+			{
+				if (next != nullptr && next->empty())
+				{
+					next.reset();
+				}
+
+				if (const auto* previous = current.exchange(next.release());
+					previous != nullptr)
+				{
+					retired.emplace_back(previous);
+				}
+
+				// Any Emit that counts itself in after this sees the new array
+				if (activeEmitters.load() == 0)
+				{
+					retired.clear();
+				}
+			}
+		};
+
+		std::shared_ptr<State> state;
+	};
+
+	template <>
+	class Event<void> : public Event<>
+	{
 	};
 }
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+
+namespace PGUI::Core
+{
+	class IFrameClock
+	{
+		public:
+		using Duration = std::chrono::nanoseconds;
+		using TimePoint = std::chrono::time_point<std::chrono::steady_clock, Duration>;
+
+		virtual ~IFrameClock() noexcept = default;
+
+		[[nodiscard]] virtual auto Now() const noexcept -> TimePoint = 0;
+	};
+
+	class SteadyFrameClock final : public IFrameClock
+	{
+		public:
+		[[nodiscard]] auto Now() const noexcept -> TimePoint override
+		{
+			return std::chrono::time_point_cast<Duration>(std::chrono::steady_clock::now());
+		}
+
+		[[nodiscard]] static auto GetInstance() noexcept -> const SteadyFrameClock&;
+	};
+
+	/**
+	* @brief Frame times over a sliding window plus running totals
+	*/
+	class FrameStatistics
+	{
+		public:
+		using Duration = IFrameClock::Duration;
+
+		explicit FrameStatistics(std::size_t windowSize = 240);
+
+		void AddFrame(Duration frameTime, std::uint64_t missedFrames);
+		void Reset() noexcept;
+
+		[[nodiscard]] auto GetAverageFrameTime() const noexcept -> Duration;
+		/**
+		* @brief percentile is in [0, 1], computed over the sliding window
+		*/
+		[[nodiscard]] auto GetPercentileFrameTime(double percentile) const -> Duration;
+		[[nodiscard]] auto GetP99FrameTime() const -> Duration { return GetPercentileFrameTime(0.99); }
+		[[nodiscard]] auto GetMaxFrameTime() const -> Duration { return GetPercentileFrameTime(1.0); }
+
+		[[nodiscard]] auto GetFrameCount() const noexcept { return frameCount; }
+		[[nodiscard]] auto GetMissedFrameCount() const noexcept { return missedFrameCount; }
+		[[nodiscard]] auto GetWindowSize() const noexcept { return windowSize; }
+
+		private:
+		std::size_t windowSize;
+		std::vector<Duration> samples;
+		std::size_t nextSample = 0;
+		Duration windowSum{ };
+
+		std::uint64_t frameCount = 0;
+		std::uint64_t missedFrameCount = 0;
+	};
+
+	/**
+	* @brief Decides when frames start and keeps FrameStatistics, doesn't wait by itself
+	*
+	* Frames are scheduled on fixed slots of targetFrameTime
+	* A frame that starts one or more whole slots late counts those slots as missed and the schedule skips them,
+	* so a slow frame doesn't cause a burst of catch up frames
+	*/
+	class FramePacer
+	{
+		public:
+		using Duration = IFrameClock::Duration;
+		using TimePoint = IFrameClock::TimePoint;
+
+		explicit FramePacer(Duration targetFrameTime, const IFrameClock& clock = SteadyFrameClock::GetInstance());
+
+		void SetTargetFrameTime(Duration targetFrameTime) noexcept;
+		[[nodiscard]] auto GetTargetFrameTime() const noexcept { return targetFrameTime; }
+
+		/**
+		* @brief Call when a frame starts
+		* @return Time since the previous frame started, zero for the first frame
+		*/
+		auto BeginFrame() -> Duration;
+
+		[[nodiscard]] auto IsFrameDue() const noexcept -> bool;
+		[[nodiscard]] auto GetNextFrameTime() const noexcept -> TimePoint;
+		[[nodiscard]] auto GetTimeUntilNextFrame() const noexcept -> Duration;
+
+		[[nodiscard]] auto GetStatistics() const noexcept -> const FrameStatistics& { return statistics; }
+		void ResetStatistics() noexcept { statistics.Reset(); }
+
+		private:
+		const IFrameClock* clock;
+		Duration targetFrameTime;
+
+		std::optional<TimePoint> lastFrameStart;
+		TimePoint nextFrameTime{ };
+
+		FrameStatistics statistics;
+	};
+}
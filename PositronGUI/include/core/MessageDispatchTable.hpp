@@ -0,0 +1,207 @@
+#pragma once
+
+#include "helpers/EnumFlag.hpp"
+
+#include <array>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include <Windows.h>
+
+
+namespace PGUI::Core
+{
+	enum class HandlerResultFlag
+	{
+		Nothing = 0x00,
+		NoFurtherHandling = 0x01,
+		ForceThisResult = 0x02,
+		ReturnPrevResult = 0x04,
+		PassToDefWindowProc = 0x08
+	};
+}
+EnableEnumFlag(PGUI::Core::HandlerResultFlag);
+
+namespace PGUI::Core
+{
+	struct HandlerResult
+	{
+		LRESULT result;
+		HandlerResultFlag flags;
+
+		HandlerResult(LRESULT _result, HandlerResultFlag _flags = HandlerResultFlag::Nothing) noexcept :
+			result(_result), flags(_flags)
+		{ }
+	};
+
+	/**
+	* @brief Non owning, non allocating reference to a message handler
+	*
+	* Member function handlers keep the object pointer and the member function pointer inline,
+	* anything else is referenced and has to outlive the MessageHandlerRef
+	*/
+	class MessageHandlerRef
+	{
+		public:
+		MessageHandlerRef() noexcept = default;
+
+		template <typename T>
+		MessageHandlerRef(T* object, HandlerResult(T::* memberFunction)(UINT, WPARAM, LPARAM)) noexcept
+		{
+			Store(BoundMember<T, decltype(memberFunction)>{ object, memberFunction });
+		}
+		template <typename T>
+		MessageHandlerRef(const T* object, HandlerResult(T::* memberFunction)(UINT, WPARAM, LPARAM) const) noexcept
+		{
+			Store(BoundMember<const T, decltype(memberFunction)>{ object, memberFunction });
+		}
+
+		template <typename F> requires std::is_invocable_r_v<HandlerResult, F&, UINT, WPARAM, LPARAM>
+		[[nodiscard]] static auto FromCallable(F& callable) noexcept -> MessageHandlerRef
+		{
+			MessageHandlerRef ref;
+			ref.Store(CallableRef<F>{ &callable });
+			return ref;
+		}
+
+		auto operator()(UINT msg, WPARAM wParam, LPARAM lParam) const -> HandlerResult
+		{
+			return thunk(storage.data(), msg, wParam, lParam);
+		}
+
+		[[nodiscard]] explicit operator bool() const noexcept { return thunk != nullptr; }
+
+		private:
+		static constexpr std::size_t StorageSize = 4 * sizeof(void*);
+		using Thunk = HandlerResult(*)(const std::byte*, UINT, WPARAM, LPARAM);
+
+		template <typename T, typename MemberFunction>
+		struct BoundMember
+		{
+			T* object;
+			MemberFunction memberFunction;
+
+			auto operator()(UINT msg, WPARAM wParam, LPARAM lParam) const -> HandlerResult
+			{
+				return (object->*memberFunction)(msg, wParam, lParam);
+			}
+		};
+		template <typename F>
+		struct CallableRef
+		{
+			F* callable;
+
+			auto operator()(UINT msg, WPARAM wParam, LPARAM lParam) const -> HandlerResult
+			{
+				return (*callable)(msg, wParam, lParam);
+			}
+		};
+
+		alignas(void*) std::array<std::byte, StorageSize> storage{ };
+		Thunk thunk = nullptr;
+
+		template <typename Callable>
+		void Store(const Callable& callable) noexcept
+		{
+			static_assert(sizeof(Callable) <= StorageSize, "Member function pointer too large to store inline");
+			static_assert(std::is_trivially_copyable_v<Callable>);
+
+			std::memcpy(storage.data(), &callable, sizeof(Callable));
+			thunk = [](const std::byte* data, UINT msg, WPARAM wParam, LPARAM lParam) -> HandlerResult
+			{
+				Callable c;
+				std::memcpy(&c, data, sizeof(Callable));
+				return c(msg, wParam, lParam);
+			};
+		}
+	};
+
+	/**
+	* @brief Message id to handlers lookup used by _WindowProc
+	*
+	* Handlers are kept in one flat array grouped by message and the groups are sorted by message id
+	* Messages below WM_USER (which is where almost all traffic is) are found with one array index,
+	* everything else with a binary search over the groups
+	*/
+	class MessageDispatchTable
+	{
+		public:
+		static constexpr UINT DenseMessageCount = WM_USER;
+
+		struct DispatchResult
+		{
+			LRESULT result = 0;
+			bool handled = false;
+			bool passToDefWindowProc = false;
+		};
+
+		void Add(UINT msg, MessageHandlerRef handler);
+		void Clear() noexcept;
+
+		[[nodiscard]] auto Find(UINT msg) const noexcept -> std::span<const MessageHandlerRef>;
+		[[nodiscard]] auto Contains(UINT msg) const noexcept -> bool { return !Find(msg).empty(); }
+		[[nodiscard]] auto GetMessageCount() const noexcept { return entries.size(); }
+		[[nodiscard]] auto GetHandlerCount() const noexcept { return handlers.size(); }
+
+		/**
+		* @brief Runs every handler registered for msg and combines their results by HandlerResultFlag
+		* handled is false if there are no handlers for msg
+		*/
+		auto Dispatch(UINT msg, WPARAM wParam, LPARAM lParam) const -> DispatchResult;
+
+		private:
+		static constexpr std::uint8_t NoSlot = 0;
+		static constexpr std::uint8_t OverflowSlot = 0xFF;
+
+		struct Entry
+		{
+			UINT msg;
+			std::uint32_t begin;
+			std::uint32_t count;
+		};
+
+		std::vector<Entry> entries;
+		std::vector<MessageHandlerRef> handlers;
+		/*
+		* Entry index + 1 for messages below DenseMessageCount
+		* OverflowSlot falls back to the binary search
+		*/
+		std::array<std::uint8_t, DenseMessageCount> denseSlots{ };
+		std::uint32_t version = 0;
+
+		void RebuildDenseSlots() noexcept;
+		[[nodiscard]] auto FindEntry(UINT msg) const noexcept -> const Entry*;
+	};
+
+	struct RecordedMessage
+	{
+		UINT msg;
+		WPARAM wParam;
+		LPARAM lParam;
+	};
+
+	struct DispatchBenchmarkResult
+	{
+		std::size_t messageCount = 0;
+		std::size_t handledCount = 0;
+		std::chrono::nanoseconds elapsed{ };
+
+		[[nodiscard]] auto NanosecondsPerMessage() const noexcept -> double
+		{
+			return messageCount == 0 ? 0.0 :
+				static_cast<double>(elapsed.count()) / static_cast<double>(messageCount);
+		}
+	};
+
+	/**
+	* @brief Replays a recorded message stream through table without any real windows
+	* Use Window::RecordMessages to capture a stream from a live window
+	*/
+	[[nodiscard]] auto ReplayMessages(const MessageDispatchTable& table,
+		std::span<const RecordedMessage> messages, std::size_t iterations = 1) -> DispatchBenchmarkResult;
+}
@@ -1,5 +1,12 @@
 #pragma once
 
+#include "core/FramePacer.hpp"
+
+#include <chrono>
+#include <functional>
+#include <vector>
+#include <Windows.h>
+
 
 namespace PGUI::Core
 {
@@ -17,9 +24,54 @@ namespace PGUI::Core
 		[[nodiscard]] auto Run() noexcept -> int override;
 	};
 
+	/**
+	* @brief Game style loop, drains every pending message then runs update and render callbacks once per frame
+	*
+	* Between frames the thread sleeps in MsgWaitForMultipleObjectsEx on either the frame latency waitable object
+	* of a swap chain (if set) or a high resolution waitable timer, so input still wakes it up and it never spins
+	*/
 	class PeekMessageLoop : public MessageLoopBase
 	{
 		public:
+		using Duration = FramePacer::Duration;
+		using UpdateCallback = std::function<void(double deltaSeconds)>;
+		using RenderCallback = std::function<void()>;
+		/**
+		* @brief Gets the time left until the next frame is due
+		*/
+		using IdleCallback = std::function<void(Duration remaining)>;
+
+		explicit PeekMessageLoop(Duration targetFrameTime = std::chrono::nanoseconds{ 16'666'667 });
+
 		[[nodiscard]] auto Run() -> int override;
+
+		void AddUpdateCallback(const UpdateCallback& callback) { updateCallbacks.push_back(callback); }
+		void AddRenderCallback(const RenderCallback& callback) { renderCallbacks.push_back(callback); }
+		void AddIdleCallback(const IdleCallback& callback) { idleCallbacks.push_back(callback); }
+
+		/**
+		* @brief Paces frames with IDXGISwapChain2::GetFrameLatencyWaitableObject instead of the timer
+		* The loop doesn't take ownership, pass nullptr to go back to the timer
+		*/
+		void SetFrameLatencyWaitableObject(HANDLE _frameLatencyWaitableObject) noexcept
+		{
+			frameLatencyWaitableObject = _frameLatencyWaitableObject;
+		}
+
+		void SetTargetFrameTime(Duration targetFrameTime) noexcept { pacer.SetTargetFrameTime(targetFrameTime); }
+		[[nodiscard]] auto GetTargetFrameTime() const noexcept { return pacer.GetTargetFrameTime(); }
+
+		[[nodiscard]] auto GetFramePacer() const noexcept -> const FramePacer& { return pacer; }
+		[[nodiscard]] auto GetFrameStatistics() const noexcept -> const FrameStatistics& { return pacer.GetStatistics(); }
+
+		private:
+		FramePacer pacer;
+		HANDLE frameLatencyWaitableObject = nullptr;
+
+		std::vector<UpdateCallback> updateCallbacks;
+		std::vector<RenderCallback> renderCallbacks;
+		std::vector<IdleCallback> idleCallbacks;
+
+		void RunFrame();
 	};
 }
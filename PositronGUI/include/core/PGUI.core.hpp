@@ -2,8 +2,12 @@
 
 
 #include "Window.hpp"
+#include "MessageDispatchTable.hpp"
 #include "WindowClass.hpp"
 #include "MessageLoop.hpp"
+#include "FramePacer.hpp"
+#include "DispatcherQueue.hpp"
+#include "Dispatcher.hpp"
 #include "Point.hpp"
 #include "Size.hpp"
 #include "Rect.hpp"
@@ -13,3 +17,5 @@
 #include "DirectCompositionWindow.hpp"
 #include "Logger.hpp"
 #include "Exceptions.hpp"
+#include "VisualTree.hpp"
+#include "DirtyRegion.hpp"
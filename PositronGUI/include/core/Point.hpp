@@ -4,8 +4,10 @@
 #include <cstdint>
 #include <numbers>
 #include <type_traits>
+#ifdef _WIN32
 #include <d2d1_1.h>
 #include <Windows.h>
+#endif
 
 
 namespace PGUI
@@ -30,6 +32,7 @@ namespace PGUI
 			x{ x_ }, y{ y_ }
 		{
 		}
+#ifdef _WIN32
 		explicit(false) constexpr Point(const POINT& p) noexcept :
 			x{ (T)p.x }, y{ (T)p.y }
 		{
@@ -46,6 +49,7 @@ namespace PGUI
 			x{ (T)p.x }, y{ (T)p.y }
 		{
 		}
+#endif
 
 		constexpr auto& operator+=(const Point& other) noexcept
 		{
@@ -114,8 +118,8 @@ namespace PGUI
 			long double angleRadians = angleDegrees / 180.0 * std::numbers::pi;
 			long double x_ = x;
 			long double y_ = y;
-			x = (T)(x_ * std::cosl(angleRadians) - y_ * std::sinl(angleRadians));
-			y = (T)(x_ * std::sinl(angleRadians) + y_ * std::cosl(angleRadians));
+			x = (T)(x_ * std::cos(angleRadians) - y_ * std::sin(angleRadians));
+			y = (T)(x_ * std::sin(angleRadians) + y_ * std::cos(angleRadians));
 
 			x += point.x;
 			y += point.y;
@@ -134,6 +138,7 @@ namespace PGUI
 			return Point<U>{ static_cast<U>(x), static_cast<U>(y) };
 		}
 
+#ifdef _WIN32
 		explicit(false) constexpr operator POINT() const noexcept
 		{
 			return POINT{ static_cast<LONG>(x), static_cast<LONG>(y) };
@@ -150,6 +155,7 @@ namespace PGUI
 		{
 			return D2D1_POINT_2U{ static_cast<UINT32>(x), static_cast<UINT32>(y) };
 		}
+#endif
 	};
 
 	template<typename T> requires std::is_arithmetic_v<T>
@@ -7,11 +7,13 @@
 #include <algorithm>
 #include <cstdint>
 #include <type_traits>
+#ifdef _WIN32
 #include <d2d1_1.h>
 #include <Windows.h>
 
 #undef min
 #undef max
+#endif
 
 
 namespace PGUI
@@ -29,6 +31,7 @@ namespace PGUI
 			left{ left_ }, top{ top_ }, right{ right_ }, bottom{ bottom_ }
 		{
 		}
+#ifdef _WIN32
 		explicit(false) constexpr Rect(const RECT& rc) noexcept :
 			left{ static_cast<T>(rc.left) }, top{ static_cast<T>(rc.top) }, 
 			right{ static_cast<T>(rc.right) }, bottom{ static_cast<T>(rc.bottom) }
@@ -44,6 +47,7 @@ namespace PGUI
 			right{ static_cast<T>(rc.right) }, bottom{ static_cast<T>(rc.bottom) }
 		{
 		}
+#endif
 		constexpr Rect(Point<T> position, Size<T> size) noexcept : 
 			left{ position.x }, top{ position.y }, 
 			right{ position.x + size.cx }, bottom{ position.y + size.cy }
@@ -96,7 +100,7 @@ namespace PGUI
 			return left < rect.right
 				&& right > rect.left
 				&& top < rect.bottom
-				&& bottom > top;
+				&& bottom > rect.top;
 		}
 		[[nodiscard]] constexpr auto IntersectRect(Rect<T> rect) const noexcept
 		{
@@ -178,6 +182,7 @@ namespace PGUI
 					static_cast<U>(right), static_cast<U>(bottom) };
 		}
 
+#ifdef _WIN32
 		explicit(false) constexpr operator RECT() const noexcept
 		{
 			return RECT{
@@ -196,6 +201,7 @@ namespace PGUI
 				static_cast<UINT32>(left), static_cast<UINT32>(top),
 				static_cast<UINT32>(right), static_cast<UINT32>(bottom) };
 		}
+#endif
 	};
 
 	using RectF = Rect<float>;
@@ -2,8 +2,10 @@
 
 #include <cstdint>
 #include <type_traits>
+#ifdef _WIN32
 #include <d2d1_1.h>
 #include <Windows.h>
+#endif
 
 
 namespace PGUI
@@ -23,6 +25,7 @@ namespace PGUI
 			cx{ sz }, cy{ sz }
 		{
 		}
+#ifdef _WIN32
 		explicit(false) constexpr Size(const SIZE& sz) noexcept :
 			cx{ (T)sz.cx }, cy{ (T)sz.cy }
 		{
@@ -35,6 +38,7 @@ namespace PGUI
 			cx{ (T)sz.width }, cy{ (T)sz.height }
 		{
 		}
+#endif
 
 		[[nodiscard]] constexpr auto operator==(const Size<T>& other) const noexcept -> bool = default;
 
@@ -66,6 +70,7 @@ namespace PGUI
 			return Size<U>{ static_cast<U>(cx), static_cast<U>(cy) };
 		}
 
+#ifdef _WIN32
 		explicit(false) operator SIZE() const noexcept
 		{
 			return SIZE{ static_cast<LONG>(cx), static_cast<LONG>(cy) };
@@ -78,6 +83,7 @@ namespace PGUI
 		{
 			return D2D1_SIZE_U{ static_cast<UINT32>(cx), static_cast<UINT32>(cy) };
 		}
+#endif
 	};
 
 	template<typename T> requires std::is_arithmetic_v<T>
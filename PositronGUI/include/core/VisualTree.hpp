@@ -0,0 +1,228 @@
+#pragma once
+
+#include "Point.hpp"
+#include "Rect.hpp"
+#include "helpers/EnumFlag.hpp"
+
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+
+namespace PGUI::Core
+{
+	enum class InputEventType
+	{
+		MouseMove,
+		MouseEnter,
+		MouseLeave,
+		MouseDown,
+		MouseUp,
+		MouseWheel,
+		KeyDown,
+		KeyUp,
+		Char
+	};
+
+	enum class MouseButton
+	{
+		None,
+		Left,
+		Right,
+		Middle
+	};
+
+	enum class ModifierKeys
+	{
+		None = 0x00,
+		Shift = 0x01,
+		Control = 0x02,
+		Alt = 0x04
+	};
+}
+EnableEnumFlag(PGUI::Core::ModifierKeys)
+
+namespace PGUI::Core
+{
+	/*
+	* The visual tree doesn't depend on any platform headers
+	* The host window translates its native messages into InputEvents and draws the elements
+	*/
+
+	struct InputEvent
+	{
+		InputEventType type = InputEventType::MouseMove;
+		/**
+		* @brief In tree coordinates when routed, in the receiving element's coordinates when delivered
+		*/
+		PointF position{ };
+		MouseButton button = MouseButton::None;
+		int wheelDelta = 0;
+		/**
+		* @brief Virtual key code for key events, UTF-16 code unit for Char
+		*/
+		std::uint32_t key = 0;
+		ModifierKeys modifiers = ModifierKeys::None;
+	};
+
+	class VisualTree;
+
+	class VisualElement
+	{
+		friend class VisualTree;
+
+		public:
+		using ElementList = std::vector<std::unique_ptr<VisualElement>>;
+
+		VisualElement() noexcept = default;
+		virtual ~VisualElement() noexcept = default;
+
+		VisualElement(const VisualElement&) = delete;
+		auto operator=(const VisualElement&) -> VisualElement& = delete;
+		VisualElement(VisualElement&&) noexcept = delete;
+		auto operator=(VisualElement&&) noexcept -> VisualElement& = delete;
+
+		template <std::derived_from<VisualElement> T, typename ...Args>
+		auto AddChild(Args&&... args) -> T*
+		{
+			return static_cast<T*>(AddChild(std::make_unique<T>(std::forward<Args>(args)...)));
+		}
+		auto AddChild(std::unique_ptr<VisualElement> child) -> VisualElement*;
+		auto RemoveChild(const VisualElement* child) -> std::unique_ptr<VisualElement>;
+
+		[[nodiscard]] auto GetParent() const noexcept { return parent; }
+		[[nodiscard]] auto GetTree() const noexcept { return tree; }
+		[[nodiscard]] auto& GetChildren() const noexcept { return children; }
+		[[nodiscard]] auto IsAncestorOf(const VisualElement* element) const noexcept -> bool;
+
+		/**
+		* @brief Bounds are relative to the parent element
+		*/
+		void SetBounds(RectF bounds) noexcept;
+		[[nodiscard]] auto GetBounds() const noexcept { return bounds; }
+		[[nodiscard]] auto GetAbsoluteBounds() const noexcept -> RectF;
+		[[nodiscard]] auto ToLocal(PointF treePoint) const noexcept -> PointF;
+
+		void Show(bool show = true) noexcept;
+		[[nodiscard]] auto IsVisible() const noexcept { return visible; }
+
+		void Enable(bool enable) noexcept;
+		[[nodiscard]] auto IsEnabled() const noexcept { return enabled; }
+
+		void SetFocusable(bool _focusable) noexcept { focusable = _focusable; }
+		[[nodiscard]] auto IsFocusable() const noexcept { return focusable; }
+
+		void SetHitTestVisible(bool _hitTestVisible) noexcept { hitTestVisible = _hitTestVisible; }
+		[[nodiscard]] auto IsHitTestVisible() const noexcept { return hitTestVisible; }
+
+		[[nodiscard]] auto HasFocus() const noexcept -> bool;
+		void Focus() noexcept;
+
+		void CaptureMouse() noexcept;
+		void ReleaseMouse() noexcept;
+
+		void Invalidate() const noexcept;
+
+		protected:
+		/**
+		* @brief Point is in the element's own coordinates
+		*/
+		[[nodiscard]] virtual auto HitTest(PointF localPoint) const noexcept -> bool;
+		/**
+		* @brief Return true to stop the event from bubbling up to the parent
+		*/
+		virtual auto OnInput(const InputEvent& /*unused*/) -> bool { return false; }
+		virtual void OnFocusChanged(bool /*unused*/) { /* */ }
+		virtual void OnBoundsChanged() { /* */ }
+		virtual void OnAttached() { /* */ }
+		virtual void OnDetached() { /* */ }
+
+		private:
+		VisualElement* parent = nullptr;
+		VisualTree* tree = nullptr;
+		ElementList children;
+
+		RectF bounds{ };
+		bool visible = true;
+		bool enabled = true;
+		bool focusable = false;
+		bool hitTestVisible = true;
+
+		void SetTree(VisualTree* newTree) noexcept;
+	};
+
+	class VisualTree
+	{
+		friend class VisualElement;
+
+		public:
+		using InvalidateCallback = std::function<void(RectF)>;
+		using RenderCallback = std::function<void(VisualElement&, RectF)>;
+		using ElementCallback = std::function<void(VisualElement&)>;
+
+		static constexpr std::uint32_t TabKey = 0x09;
+
+		VisualTree() noexcept;
+		~VisualTree() noexcept = default;
+
+		VisualTree(const VisualTree&) = delete;
+		auto operator=(const VisualTree&) -> VisualTree& = delete;
+		VisualTree(VisualTree&&) noexcept = delete;
+		auto operator=(VisualTree&&) noexcept -> VisualTree& = delete;
+
+		[[nodiscard]] auto GetRoot() noexcept -> VisualElement& { return root; }
+		[[nodiscard]] auto GetRoot() const noexcept -> const VisualElement& { return root; }
+
+		void SetInvalidateCallback(const InvalidateCallback& callback) noexcept { invalidateCallback = callback; }
+		void Invalidate(RectF rect) const;
+
+		/**
+		* @brief Deepest visible and hit test visible element under the point, in tree coordinates
+		*/
+		[[nodiscard]] auto HitTest(PointF point) const noexcept -> VisualElement*;
+		/**
+		* @brief Routes the event to the captured, hovered or focused element and bubbles it up
+		* @return Whether any element handled the event
+		*/
+		auto RouteInput(InputEvent event) -> bool;
+
+		[[nodiscard]] auto GetFocusedElement() const noexcept { return focused; }
+		void SetFocus(VisualElement* element) noexcept;
+		/**
+		* @brief Moves focus to the next or previous focusable element in tree order
+		*/
+		void MoveFocus(bool forward = true) noexcept;
+
+		[[nodiscard]] auto GetHoveredElement() const noexcept { return hovered; }
+		[[nodiscard]] auto GetCapturedElement() const noexcept { return captured; }
+		void SetCapture(VisualElement* element) noexcept;
+		void ReleaseCapture() noexcept;
+
+		/**
+		* @brief Calls render for every visible element in paint order with its absolute bounds
+		* Elements outside of clipRect are skipped
+		*/
+		void Render(const RenderCallback& render, std::optional<RectF> clipRect = std::nullopt) const;
+		void ForEachElement(const ElementCallback& callback) const;
+
+		private:
+		VisualElement root;
+		VisualElement* focused = nullptr;
+		VisualElement* hovered = nullptr;
+		VisualElement* captured = nullptr;
+
+		InvalidateCallback invalidateCallback;
+
+		void ReleaseElementState(const VisualElement& element) noexcept;
+		void UpdateHover(VisualElement* newHovered, const InputEvent& event);
+		auto Dispatch(VisualElement* target, InputEvent event) -> bool;
+
+		[[nodiscard]] static auto HitTestElement(VisualElement& element, PointF point, PointF parentOffset) noexcept -> VisualElement*;
+		static void RenderElement(VisualElement& element, PointF parentOffset,
+			const RenderCallback& render, const std::optional<RectF>& clipRect);
+		static void ForEachElement(VisualElement& element, const ElementCallback& callback);
+	};
+}
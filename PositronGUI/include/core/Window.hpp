@@ -6,6 +6,8 @@
 #include "Rect.hpp"
 #include "Size.hpp"
 #include "WindowClass.hpp"
+#include "MessageDispatchTable.hpp"
+#include "Dispatcher.hpp"
 #include "helpers/HelperFunctions.hpp"
 #include "helpers/ScopedTimer.hpp"
 #include "helpers/EnumFlag.hpp"
@@ -15,6 +17,7 @@
 #include <ranges>
 #include <chrono>
 #include <concepts>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <vector>
@@ -27,25 +30,6 @@ namespace PGUI::Core
 {
 	constexpr UINT DEFAULT_SCREEN_DPI = USER_DEFAULT_SCREEN_DPI;
 
-	enum class HandlerResultFlag
-	{
-		Nothing = 0x00,
-		NoFurtherHandling = 0x01,
-		ForceThisResult = 0x02,
-		ReturnPrevResult = 0x04,
-		PassToDefWindowProc = 0x08
-	};
-
-	struct HandlerResult
-	{
-		LRESULT result;
-		HandlerResultFlag flags;
-
-		HandlerResult(LRESULT _result, HandlerResultFlag _flags = HandlerResultFlag::Nothing) noexcept :
-			result(_result), flags(_flags)
-		{ }
-	};
-
 	struct WindowCreateParams
 	{
 		std::wstring windowName;
@@ -64,7 +48,6 @@ namespace PGUI::Core
 	};
 
 	using Handler = std::function<HandlerResult(UINT, WPARAM, LPARAM)>;
-	using HandlerMap = std::unordered_map<UINT, std::vector<Handler>>;
 
 	class Window;
 
@@ -94,6 +77,9 @@ namespace PGUI::Core
 		template <WindowType T, typename ...Args>
 		[[nodiscard]] static auto Create(const WindowCreateParams& createParams, Args&&... args) -> WindowOwnPtr<T>
 		{
+			// So other threads can find this thread's dispatcher through GetDispatcher
+			static_cast<void>(Dispatcher::GetForCurrentThread());
+
 			auto window = std::make_unique<T>(std::forward<Args>(args)...);
 			auto wnd = window.get();
 
@@ -247,31 +233,47 @@ namespace PGUI::Core
 		[[nodiscard]] auto GetClientSizeWithoutDPI() const noexcept -> SizeL;
 
 		void Invalidate() const noexcept;
+		/**
+		* @brief Adds rect (client coordinates) to the update region, only that part gets repainted
+		*/
+		void Invalidate(RectF rect) const noexcept;
 
 		[[nodiscard]] auto operator==(const Window& other) const noexcept -> bool;
 
+		[[nodiscard]] auto GetMessageDispatchTable() const noexcept -> const MessageDispatchTable& { return dispatchTable; }
+		/**
+		* @brief Appends every message this window receives to sink, for replaying with ReplayMessages
+		* Pass nullptr to stop recording
+		*/
+		void RecordMessages(std::vector<RecordedMessage>* sink) noexcept { messageRecorder = sink; }
+
+		/**
+		* @brief Dispatcher of the thread that owns this window, use it to hand work over from other threads
+		*/
+		[[nodiscard]] auto GetDispatcher() const -> std::shared_ptr<Dispatcher>;
+
 		protected:
 		virtual void RegisterMessageHandler(UINT msg, const Handler& handler) noexcept final;
 		template <typename T>
 		void RegisterMessageHandler(UINT msg, HandlerResult(T::* memberFunction)(UINT, WPARAM, LPARAM)) noexcept
 		{
-			RegisterMessageHandler(msg, std::bind_front(memberFunction, std::bit_cast<T*>(this)));
+			dispatchTable.Add(msg, MessageHandlerRef{ static_cast<T*>(this), memberFunction });
 		}
 		template <typename T>
 		void RegisterMessageHandler(UINT msg, HandlerResult(T::* memberFunction)(UINT, WPARAM, LPARAM) const) noexcept
 		{
-			RegisterMessageHandler(msg, std::bind_front(memberFunction, std::bit_cast<const T*>(this)));
+			dispatchTable.Add(msg, MessageHandlerRef{ static_cast<const T*>(this), memberFunction });
 		}
 
 		template <typename T>
 		void RegisterGeneralMessageHandler(HandlerResult(T::* memberFunction)(UINT, WPARAM, LPARAM)) noexcept
 		{
-			generalHandler = std::bind_front(memberFunction, std::bit_cast<T*>(this));
+			generalHandler = MessageHandlerRef{ static_cast<T*>(this), memberFunction };
 		}
 		template <typename T>
 		void RegisterGeneralHandler(HandlerResult(T::* memberFunction)(UINT, WPARAM, LPARAM) const) noexcept
 		{
-			generalHandler = std::bind_front(memberFunction, std::bit_cast<const T*>(this));
+			generalHandler = MessageHandlerRef{ static_cast<const T*>(this), memberFunction };
 		}
 		void RemoveGeneralHandler();
 
@@ -287,8 +289,14 @@ namespace PGUI::Core
 
 		UINT prevDpi = DEFAULT_SCREEN_DPI;
 
-		HandlerMap handlerMap;
-		std::optional<Handler> generalHandler;
+		MessageDispatchTable dispatchTable;
+		/*
+		* Handlers registered as std::function live here, the table only references them
+		* deque so references stay valid when more are added
+		*/
+		std::deque<Handler> ownedHandlers;
+		MessageHandlerRef generalHandler;
+		std::vector<RecordedMessage>* messageRecorder = nullptr;
 		TimerMap timerMap;
 		WindowClass::WindowClassPtr windowClass;
 		
@@ -297,4 +305,3 @@ namespace PGUI::Core
 
 	auto _WindowProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam) -> LRESULT;
 }
-EnableEnumFlag(PGUI::Core::HandlerResultFlag);
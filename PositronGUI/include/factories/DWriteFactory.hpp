@@ -19,17 +19,23 @@ namespace PGUI
 		auto operator=(DWriteFactory&&) -> DWriteFactory& = delete;
 		~DWriteFactory() = default;
 
+		/**
+		* @brief Thread safe, layouts are shaped on worker threads too
+		*/
 		[[nodiscard]] static auto GetFactory()
 		{
-			if (!directWriteFactory)
-			{
-				HRESULT hr = DWriteCreateFactory(DWRITE_FACTORY_TYPE_SHARED, 
-					__uuidof(IDWriteFactory8), (IUnknown**)directWriteFactory.GetAddressOf()); HR_T(hr);
-			}
+			// A local static is created once even if the first calls race
+			static const auto directWriteFactory = CreateFactory();
 			return directWriteFactory;
 		}
 
 		private:
-		static inline ComPtr<IDWriteFactory8> directWriteFactory = nullptr;
+		[[nodiscard]] static auto CreateFactory() -> ComPtr<IDWriteFactory8>
+		{
+			ComPtr<IDWriteFactory8> factory;
+			HRESULT hr = DWriteCreateFactory(DWRITE_FACTORY_TYPE_SHARED, 
+				__uuidof(IDWriteFactory8), (IUnknown**)factory.GetAddressOf()); HR_T(hr);
+			return factory;
+		}
 	};
 }
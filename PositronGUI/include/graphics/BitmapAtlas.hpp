@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Graphics.hpp"
+#include "GraphicsBitmap.hpp"
+#include "helpers/AtlasPacker.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+
+namespace PGUI::UI::Bmp
+{
+	class BitmapSource;
+}
+namespace PGUI::Graphics
+{
+	/**
+	* @brief Packs small images into a few shared GPU bitmaps, so drawing many icons doesn't need a bitmap each
+	*
+	* Pages are made on the D2D device every DirectCompositionWindow shares, so one atlas can draw into any window,
+	* the Graphics it's made with is only used to create them
+	* Every image is surrounded by copies of its edge pixels, so linear filtering doesn't blend in a neighbour
+	* When the pages are full the atlas repacks once, then evicts the least recently drawn images,
+	* whose ids stop working and have to be added again
+	*/
+	class BitmapAtlas
+	{
+		public:
+		struct Image
+		{
+			GraphicsBitmap page;
+			RectF sourceRect;
+		};
+
+		static constexpr SizeU DefaultPageSize{ 1024, 1024 };
+
+		explicit BitmapAtlas(Graphics graphics, SizeU pageSize = DefaultPageSize, std::size_t maxPageCount = 4);
+
+		/**
+		* @brief Shared by the windows of the calling thread, created with graphics on first use
+		*/
+		[[nodiscard]] static auto GetForCurrentThread(const Graphics& graphics) -> BitmapAtlas&;
+
+		/**
+		* @brief Converted to 32bppPBGRA on the way in
+		*/
+		[[nodiscard]] auto Add(const UI::Bmp::BitmapSource& bmpSrc) -> std::optional<AtlasEntryId>;
+		/**
+		* @brief pixels are 32bppPBGRA
+		*/
+		[[nodiscard]] auto Add(SizeU size, const void* pixels, UINT32 pitch) -> std::optional<AtlasEntryId>;
+		void Remove(AtlasEntryId id);
+
+		/**
+		* @brief Also marks the image as recently used, nullopt if it was evicted
+		*/
+		[[nodiscard]] auto GetImage(AtlasEntryId id) -> std::optional<Image>;
+		/**
+		* @return false if the image was evicted
+		*/
+		auto Draw(const Graphics& g, AtlasEntryId id, RectF destRect, float opacity = 1.0F) -> bool;
+
+		/**
+		* @brief Packs every image again to win back space lost to fragmentation
+		*/
+		void Repack();
+
+		[[nodiscard]] auto GetAllocator() const noexcept -> const AtlasAllocator& { return allocator; }
+		[[nodiscard]] auto GetPageCount() const noexcept { return pages.size(); }
+		[[nodiscard]] auto GetEvictionCount() const noexcept { return evictionCount; }
+
+		private:
+		Graphics graphics;
+		AtlasAllocator allocator;
+		std::vector<GraphicsBitmap> pages;
+		std::uint64_t evictionCount = 0;
+
+		[[nodiscard]] auto Allocate(SizeU size) -> std::optional<AtlasEntryId>;
+		[[nodiscard]] auto CreatePage() const -> GraphicsBitmap;
+		void CreateMissingPages();
+	};
+}
@@ -6,3 +6,5 @@
 #include "BitmapRenderTarget.hpp"
 #include "PixelFormat.hpp"
 #include "AntialiasMode.hpp"
+#include "BitmapAtlas.hpp"
+#include "PixelConversion.hpp"
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "core/Size.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace PGUI::Graphics
+{
+	/**
+	* @brief Instruction set a PixelKernels table is written for
+	*/
+	enum class PixelKernelLevel
+	{
+		Scalar,
+		Sse41,
+		Avx2
+	};
+
+	/**
+	* @brief Row converters between pixel formats, without going through WIC
+	*
+	* Formats are named by their DXGI_FORMAT: Bgra8 is B8G8R8A8_UNORM, Bgr565 is B5G6R5_UNORM (RGB565 with red in the high bits)
+	* and Rgba16Float is R16G16B16A16_FLOAT, one uint64_t per pixel
+	* Every table gives bit for bit the same result as the scalar one
+	* source and destination may be the same row when both formats have the same pixel size
+	*/
+	struct PixelKernels
+	{
+		PixelKernelLevel level;
+
+		/**
+		* @brief Bgra8 to Rgba8 and back
+		*/
+		void (*swapRedBlue)(const std::uint32_t* source, std::uint32_t* destination, std::size_t count) noexcept;
+		/**
+		* @brief Straight to premultiplied alpha, rounded to nearest
+		*/
+		void (*premultiply)(const std::uint32_t* source, std::uint32_t* destination, std::size_t count) noexcept;
+		/**
+		* @brief Premultiplied to straight alpha, rounded to nearest, fully transparent pixels become 0
+		*/
+		void (*unpremultiply)(const std::uint32_t* source, std::uint32_t* destination, std::size_t count) noexcept;
+		/**
+		* @brief Opaque gray
+		*/
+		void (*gray8ToBgra8)(const std::uint8_t* source, std::uint32_t* destination, std::size_t count) noexcept;
+		/**
+		* @brief Bits are replicated into the low bits, so 31 and 63 become 255
+		*/
+		void (*bgr565ToBgra8)(const std::uint16_t* source, std::uint32_t* destination, std::size_t count) noexcept;
+		/**
+		* @brief Rounded to nearest, alpha is dropped
+		*/
+		void (*bgra8ToBgr565)(const std::uint32_t* source, std::uint16_t* destination, std::size_t count) noexcept;
+		/**
+		* @brief srgbToLinear decodes the sRGB transfer curve from color, alpha is always linear
+		*/
+		void (*bgra8ToRgba16Float)(const std::uint32_t* source, std::uint64_t* destination,
+			std::size_t count, bool srgbToLinear) noexcept;
+		/**
+		* @brief Clamped to [0, 1], NaN becomes 0, linearToSrgb encodes color with the sRGB transfer curve
+		*/
+		void (*rgba16FloatToBgra8)(const std::uint64_t* source, std::uint32_t* destination,
+			std::size_t count, bool linearToSrgb) noexcept;
+	};
+
+	/**
+	* @brief Fastest table this CPU runs
+	*/
+	[[nodiscard]] auto GetPixelKernels() noexcept -> const PixelKernels&;
+	/**
+	* @brief Table for level, or the fastest one below it that this CPU runs
+	*/
+	[[nodiscard]] auto GetPixelKernels(PixelKernelLevel level) noexcept -> const PixelKernels&;
+
+	/**
+	* @brief Runs a row kernel over every row of an image, pitches are in bytes
+	* @code ConvertRows(GetPixelKernels().premultiply, frame.data(), framePitch, staging.data(), stagingPitch, size);
+	*/
+	template <typename Source, typename Destination, typename... Args>
+	void ConvertRows(void (*kernel)(const Source*, Destination*, std::size_t, Args...) noexcept,
+		const void* source, std::size_t sourcePitch, void* destination, std::size_t destinationPitch,
+		SizeU size, Args... args) noexcept
+	{
+		const auto* sourceRow = static_cast<const std::byte*>(source);
+		auto* destinationRow = static_cast<std::byte*>(destination);
+
+		for (std::uint32_t y = 0; y < size.cy; y++)
+		{
+			kernel(std::bit_cast<const Source*>(sourceRow), std::bit_cast<Destination*>(destinationRow), size.cx, args...);
+			sourceRow += sourcePitch;
+			destinationRow += destinationPitch;
+		}
+	}
+
+	namespace pixel_detail
+	{
+		[[nodiscard]] auto HalfToFloat(std::uint16_t half) noexcept -> float;
+		/**
+		* @brief Rounds to nearest even like F16C does
+		*/
+		[[nodiscard]] auto FloatToHalf(float value) noexcept -> std::uint16_t;
+	}
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "core/Rect.hpp"
+#include "core/Size.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+
+namespace PGUI
+{
+	/**
+	* @brief MaxRects bin packer for a single page
+	*
+	* Keeps every maximal free rectangle and places each new one where it leaves the shortest side over
+	* Removed rectangles go back to the free list, fragmentation builds up until the page is packed again
+	*/
+	class AtlasPacker
+	{
+		public:
+		explicit AtlasPacker(SizeU pageSize);
+
+		[[nodiscard]] auto Insert(SizeU size) -> std::optional<RectU>;
+		void Remove(RectU rect);
+		void Clear();
+
+		[[nodiscard]] auto GetPageSize() const noexcept { return pageSize; }
+		[[nodiscard]] auto GetUsedArea() const noexcept { return usedArea; }
+		[[nodiscard]] auto GetFreeRectCount() const noexcept { return freeRects.size(); }
+		/**
+		* @brief Used area over page area
+		*/
+		[[nodiscard]] auto GetOccupancy() const noexcept -> double;
+
+		private:
+		SizeU pageSize;
+		std::vector<RectU> freeRects;
+		std::uint64_t usedArea = 0;
+
+		void SplitFreeRects(RectU placed);
+		void PruneFreeRects(std::vector<RectU> newRects);
+		void AddFreeRect(RectU rect);
+	};
+
+	using AtlasEntryId = std::uint64_t;
+
+	struct AtlasSlot
+	{
+		std::size_t page = 0;
+		/**
+		* @brief Without the padding around it
+		*/
+		RectU rect{ };
+	};
+
+	/**
+	* @brief Hands out rectangles on a growing number of AtlasPacker pages,
+	* with least recently used tracking for eviction and repacking to undo fragmentation
+	*/
+	class AtlasAllocator
+	{
+		public:
+		struct Move
+		{
+			AtlasEntryId id;
+			AtlasSlot from;
+			AtlasSlot to;
+		};
+
+		/**
+		* @brief padding pixels are left free on every side of each entry so filtering doesn't pick up neighbours
+		*/
+		explicit AtlasAllocator(SizeU pageSize, std::size_t maxPageCount = 4, std::uint32_t padding = 1);
+
+		/**
+		* @brief Adds a page if the existing ones are full, never evicts
+		*/
+		[[nodiscard]] auto Allocate(SizeU size) -> std::optional<AtlasEntryId>;
+		void Free(AtlasEntryId id);
+		/**
+		* @brief Marks the entry as the most recently used one
+		*/
+		void Touch(AtlasEntryId id);
+
+		[[nodiscard]] auto GetSlot(AtlasEntryId id) const -> std::optional<AtlasSlot>;
+		[[nodiscard]] auto GetLeastRecentlyUsed() const noexcept -> std::optional<AtlasEntryId>;
+		[[nodiscard]] auto CanEverFit(SizeU size) const noexcept -> bool;
+
+		/**
+		* @brief Packs every entry again from scratch, largest first
+		* Leaves everything as it was if the entries wouldn't fit in maxPageCount pages
+		* @return Entries that moved, their pixels have to be copied over by the caller
+		*/
+		[[nodiscard]] auto Repack() -> std::vector<Move>;
+
+		[[nodiscard]] auto GetPageSize() const noexcept { return pageSize; }
+		[[nodiscard]] auto GetPageCount() const noexcept { return pages.size(); }
+		[[nodiscard]] auto GetMaxPageCount() const noexcept { return maxPageCount; }
+		[[nodiscard]] auto GetEntryCount() const noexcept { return entries.size(); }
+		[[nodiscard]] auto GetPadding() const noexcept { return padding; }
+		/**
+		* @brief Used area, padding included, over the area of all pages
+		*/
+		[[nodiscard]] auto GetOccupancy() const noexcept -> double;
+
+		private:
+		struct Entry
+		{
+			std::size_t page;
+			RectU paddedRect;
+			std::list<AtlasEntryId>::iterator lruPosition;
+		};
+
+		SizeU pageSize;
+		std::size_t maxPageCount;
+		std::uint32_t padding;
+
+		std::vector<AtlasPacker> pages;
+		std::unordered_map<AtlasEntryId, Entry> entries;
+		// Most recently used first
+		std::list<AtlasEntryId> lru;
+		AtlasEntryId nextId = 1;
+
+		[[nodiscard]] auto ToSlot(const Entry& entry) const noexcept -> AtlasSlot;
+	};
+
+	/**
+	* @brief Copies 32 bit pixels into the middle of destination, (size.cx + 2 * padding) pixels per row,
+	* and repeats the edge pixels over the padding so filtering at the edges samples the image's own colors
+	*/
+	void CopyWithExtrudedPadding(SizeU size, std::span<const std::uint32_t> source, std::uint32_t sourcePitch,
+		std::uint32_t padding, std::span<std::uint32_t> destination) noexcept;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PGUI_X86 1
+#else
+#define PGUI_X86 0
+#endif
+
+/*
+* MSVC compiles intrinsics of any instruction set, GCC and Clang need them enabled per function
+* Functions marked with these must only be called after checking CpuFeatures
+*/
+#if PGUI_X86 && (defined(__GNUC__) || defined(__clang__))
+#define PGUI_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define PGUI_TARGET_AVX2 __attribute__((target("avx2")))
+#define PGUI_TARGET_AVX2_F16C __attribute__((target("avx2,f16c")))
+#else
+#define PGUI_TARGET_SSE41
+#define PGUI_TARGET_AVX2
+#define PGUI_TARGET_AVX2_F16C
+#endif
+
+
+namespace PGUI
+{
+	/**
+	* @brief Instruction sets usable on this CPU, detected once
+	*/
+	struct CpuFeatures
+	{
+		bool sse41 = false;
+		bool avx2 = false;
+		/**
+		* @brief Half precision float conversions
+		*/
+		bool f16c = false;
+
+		[[nodiscard]] static auto Get() noexcept -> const CpuFeatures&;
+	};
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+
+namespace PGUI
+{
+	/**
+	* @brief Binary indexed tree over a list of non negative values
+	*
+	* Point updates, prefix sums and "which element contains this offset" lookups are all O(log n)
+	* Used by ListView to map between item indexes and y positions
+	*/
+	template <typename T> requires std::is_arithmetic_v<T>
+	class FenwickTree
+	{
+		public:
+		FenwickTree() noexcept = default;
+		explicit FenwickTree(std::span<const T> values)
+		{
+			Assign(values);
+		}
+
+		void Assign(std::span<const T> _values)
+		{
+			values.assign(_values.begin(), _values.end());
+			tree.assign(values.size() + 1, T{ });
+
+			for (std::size_t i = 1; i <= values.size(); i++)
+			{
+				tree[i] += values[i - 1];
+				if (auto parent = i + LowBit(i);
+					parent <= values.size())
+				{
+					tree[parent] += tree[i];
+				}
+			}
+		}
+
+		void Clear() noexcept
+		{
+			values.clear();
+			tree.assign(1, T{ });
+		}
+
+		void PushBack(T value)
+		{
+			if (tree.empty())
+			{
+				tree.push_back(T{ });
+			}
+
+			const auto i = values.size() + 1;
+			values.push_back(value);
+			tree.push_back(value + PrefixSum(i - 1) - PrefixSum(i - LowBit(i)));
+		}
+
+		void PopBack() noexcept
+		{
+			values.pop_back();
+			tree.pop_back();
+		}
+
+		void Set(std::size_t index, T value) noexcept
+		{
+			Add(index, value - values[index]);
+		}
+		void Add(std::size_t index, T delta) noexcept
+		{
+			values[index] += delta;
+			for (auto i = index + 1; i < tree.size(); i += LowBit(i))
+			{
+				tree[i] += delta;
+			}
+		}
+
+		[[nodiscard]] auto Get(std::size_t index) const noexcept -> T { return values[index]; }
+		[[nodiscard]] auto Size() const noexcept -> std::size_t { return values.size(); }
+		[[nodiscard]] auto IsEmpty() const noexcept -> bool { return values.empty(); }
+
+		/**
+		* @brief Sum of the first count elements
+		*/
+		[[nodiscard]] auto PrefixSum(std::size_t count) const noexcept -> T
+		{
+			T sum{ };
+			for (auto i = count; i > 0; i -= LowBit(i))
+			{
+				sum += tree[i];
+			}
+			return sum;
+		}
+		[[nodiscard]] auto Total() const noexcept -> T
+		{
+			return PrefixSum(values.size());
+		}
+
+		/**
+		* @brief Finds the element whose [start, start + value) span contains offset
+		* @return Index of the element or Size() if offset is past the end
+		*/
+		[[nodiscard]] auto Find(T offset) const noexcept -> std::size_t
+		{
+			if (offset < T{ })
+			{
+				return values.size();
+			}
+
+			std::size_t pos = 0;
+			for (auto step = std::bit_floor(values.size()); step > 0; step >>= 1)
+			{
+				if (pos + step <= values.size() && tree[pos + step] <= offset)
+				{
+					pos += step;
+					offset -= tree[pos];
+				}
+			}
+
+			return pos;
+		}
+
+		private:
+		std::vector<T> values;
+		std::vector<T> tree = std::vector<T>(1);
+
+		[[nodiscard]] static constexpr auto LowBit(std::size_t i) noexcept -> std::size_t
+		{
+			return i & (~i + 1);
+		}
+	};
+}
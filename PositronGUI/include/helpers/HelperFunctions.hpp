@@ -6,6 +6,9 @@
 #include "core/Logger.hpp"
 #include <functional>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 #include <string>
 #include <span>
 #include <format>
@@ -61,6 +64,26 @@ namespace PGUI
 		return typeid(T).hash_code();
 	}
 
+	inline constexpr std::uint64_t HashSeed = 0xCBF29CE484222325ULL;
+
+	/**
+	* @brief FNV-1a, pass the result of an earlier call as hash to hash several ranges together
+	*/
+	[[nodiscard]] inline auto HashBytes(std::span<const std::byte> bytes, std::uint64_t hash = HashSeed) noexcept
+		-> std::uint64_t
+	{
+		for (const auto byte : bytes)
+		{
+			hash = (hash ^ static_cast<std::uint64_t>(byte)) * 0x100000001B3ULL;
+		}
+		return hash;
+	}
+	template <typename T> requires std::is_trivially_copyable_v<T>
+	[[nodiscard]] auto HashValue(const T& value, std::uint64_t hash = HashSeed) noexcept -> std::uint64_t
+	{
+		return HashBytes(std::as_bytes(std::span{ &value, 1 }), hash);
+	}
+
 	template <typename T, typename... Args>
 	[[nodiscard]] constexpr auto BindMemberFunc(void (T::* memberFunc)(Args...), T* ptr) noexcept -> std::function<void(Args...)>
 	{
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+namespace PGUI
+{
+	namespace inline_function_detail
+	{
+		template <typename F>
+		constexpr bool IsStdFunction = false;
+		template <typename Signature>
+		constexpr bool IsStdFunction<std::function<Signature>> = true;
+
+		template <typename F>
+		constexpr bool CanBeNull = std::is_pointer_v<F> || std::is_member_pointer_v<F> || IsStdFunction<F>;
+	}
+
+	template <typename Signature, std::size_t InlineSize = 6 * sizeof(void*)>
+	class InlineFunction;
+
+	/**
+	* @brief Move only std::function that keeps callables up to InlineSize bytes inside itself
+	* Larger callables (or ones that can throw when moved) go on the heap
+	*/
+	template <typename R, typename... Args, std::size_t InlineSize>
+	class InlineFunction<R(Args...), InlineSize>
+	{
+		public:
+		template <typename F>
+		static constexpr bool IsStoredInline =
+			sizeof(F) <= InlineSize &&
+			alignof(F) <= alignof(std::max_align_t) &&
+			std::is_nothrow_move_constructible_v<F>;
+
+		InlineFunction() noexcept = default;
+		explicit(false) InlineFunction(std::nullptr_t) noexcept { }
+
+		template <typename F> requires
+			(!std::same_as<std::remove_cvref_t<F>, InlineFunction>) &&
+			std::is_invocable_r_v<R, std::decay_t<F>&, Args...>
+		explicit(false) InlineFunction(F&& callable)
+		{
+			using Callable = std::decay_t<F>;
+
+			if constexpr (inline_function_detail::CanBeNull<Callable>)
+			{
+				if (callable == nullptr)
+				{
+					return;
+				}
+			}
+
+			if constexpr (IsStoredInline<Callable>)
+			{
+				::new (static_cast<void*>(storage.data())) Callable(std::forward<F>(callable));
+				operations = &InlineOperations<Callable>;
+			}
+			else
+			{
+				::new (static_cast<void*>(storage.data())) Callable*(new Callable(std::forward<F>(callable)));
+				operations = &HeapOperations<Callable>;
+			}
+		}
+
+		InlineFunction(InlineFunction&& other) noexcept
+		{
+			MoveFrom(other);
+		}
+		auto operator=(InlineFunction&& other) noexcept -> InlineFunction&
+		{
+			if (this != &other)
+			{
+				Reset();
+				MoveFrom(other);
+			}
+			return *this;
+		}
+		InlineFunction(const InlineFunction&) = delete;
+		auto operator=(const InlineFunction&) -> InlineFunction& = delete;
+
+		~InlineFunction() noexcept
+		{
+			Reset();
+		}
+
+		auto operator()(Args... args) const -> R
+		{
+			return operations->invoke(storage.data(), std::forward<Args>(args)...);
+		}
+
+		[[nodiscard]] explicit operator bool() const noexcept { return operations != nullptr; }
+		[[nodiscard]] auto IsInline() const noexcept { return operations != nullptr && operations->isInline; }
+
+		void Reset() noexcept
+		{
+			if (operations != nullptr)
+			{
+				operations->destroy(storage.data());
+				operations = nullptr;
+			}
+		}
+
+		private:
+		struct Operations
+		{
+			R(*invoke)(std::byte*, Args&&...);
+			void(*relocate)(std::byte* from, std::byte* to) noexcept;
+			void(*destroy)(std::byte*) noexcept;
+			bool isInline;
+		};
+
+		template <typename Callable>
+		static constexpr Operations InlineOperations{
+			[](std::byte* data, Args&&... args) -> R
+			{
+				return std::invoke_r<R>(*std::launder(std::bit_cast<Callable*>(data)), std::forward<Args>(args)...);
+			},
+			[](std::byte* from, std::byte* to) noexcept
+			{
+				auto* source = std::launder(std::bit_cast<Callable*>(from));
+				::new (static_cast<void*>(to)) Callable(std::move(*source));
+				source->~Callable();
+			},
+			[](std::byte* data) noexcept
+			{
+				std::launder(std::bit_cast<Callable*>(data))->~Callable();
+			},
+			true
+		};
+		template <typename Callable>
+		static constexpr Operations HeapOperations{
+			[](std::byte* data, Args&&... args) -> R
+			{
+				return std::invoke_r<R>(**std::launder(std::bit_cast<Callable**>(data)), std::forward<Args>(args)...);
+			},
+			[](std::byte* from, std::byte* to) noexcept
+			{
+				::new (static_cast<void*>(to)) Callable*(*std::launder(std::bit_cast<Callable**>(from)));
+			},
+			[](std::byte* data) noexcept
+			{
+				delete *std::launder(std::bit_cast<Callable**>(data));
+			},
+			false
+		};
+
+		alignas(std::max_align_t) mutable std::array<std::byte, InlineSize> storage{ };
+		const Operations* operations = nullptr;
+
+		void MoveFrom(InlineFunction& other) noexcept
+		{
+			if (other.operations != nullptr)
+			{
+				other.operations->relocate(other.storage.data(), storage.data());
+				operations = std::exchange(other.operations, nullptr);
+			}
+		}
+	};
+}
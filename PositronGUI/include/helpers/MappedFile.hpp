@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <Windows.h>
+
+
+namespace PGUI
+{
+	/**
+	* @brief Read only view of a whole file, pages are loaded by the OS as they're touched
+	*/
+	class MappedFile
+	{
+		public:
+		explicit MappedFile(const std::filesystem::path& path);
+		~MappedFile() noexcept;
+
+		MappedFile(const MappedFile&) = delete;
+		auto operator=(const MappedFile&) -> MappedFile& = delete;
+		MappedFile(MappedFile&& other) noexcept;
+		auto operator=(MappedFile&& other) noexcept -> MappedFile&;
+
+		[[nodiscard]] auto GetData() const noexcept -> std::span<const std::byte> { return { data, size }; }
+		[[nodiscard]] auto GetSize() const noexcept { return size; }
+
+		private:
+		HANDLE file = INVALID_HANDLE_VALUE;
+		HANDLE mapping = nullptr;
+		const std::byte* data = nullptr;
+		std::size_t size = 0;
+
+		void Close() noexcept;
+	};
+}
@@ -4,4 +4,11 @@
 #include "HelperFunctions.hpp"
 #include "PropVariant.hpp"
 #include "EnumFlag.hpp"
+#include "InlineFunction.hpp"
 #include "ScopedTimer.hpp"
+#include "TimerService.hpp"
+#include "TimerEvent.hpp"
+#include "WorkerPool.hpp"
+#include "CpuFeatures.hpp"
+#include "AtlasPacker.hpp"
+#include "MappedFile.hpp"
@@ -1,26 +1,33 @@
 #pragma once
 
 #include "core/Event.hpp"
+#include "helpers/TimerService.hpp"
 #include <chrono>
 #include <optional>
-#include <thread>
 
 
 namespace PGUI
 {
+	/**
+	* @brief Emits every interval from the shared TimerService thread
+	*/
 	class TimerEvent : public Core::Event<>
 	{
 		using milliseconds = std::chrono::milliseconds;
 
 		public:
-		TimerEvent(milliseconds interval, std::optional<milliseconds> startDelay = std::nullopt) noexcept;
+		TimerEvent(milliseconds interval, std::optional<milliseconds> startDelay = std::nullopt);
+		~TimerEvent() noexcept;
 
-		private:
-		void ThreadFunction(const std::stop_token& stopToken) const;
+		TimerEvent(const TimerEvent&) = delete;
+		auto operator=(const TimerEvent&) -> TimerEvent& = delete;
+		TimerEvent(TimerEvent&&) noexcept = delete;
+		auto operator=(TimerEvent&&) noexcept -> TimerEvent& = delete;
 
-		std::jthread thread;
+		[[nodiscard]] auto GetInterval() const noexcept { return interval; }
 
+		private:
 		milliseconds interval;
-		milliseconds startDelay;
+		TimerService::TimerId timerId = TimerService::InvalidTimerId;
 	};
 }
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <stop_token>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+
+namespace PGUI
+{
+	/**
+	* @brief One thread that runs every timer in the process
+	*
+	* Deadlines are kept in a min heap and the thread sleeps on a condition variable until the earliest one
+	* Callbacks run on the timer thread, so they should be short and post anything heavy elsewhere
+	*/
+	class TimerService
+	{
+		public:
+		using Clock = std::chrono::steady_clock;
+		using Duration = Clock::duration;
+		using TimerId = std::uint64_t;
+		using Callback = std::function<void()>;
+
+		static constexpr TimerId InvalidTimerId = 0;
+
+		/**
+		* @brief Process wide instance, started on first use
+		*/
+		[[nodiscard]] static auto GetInstance() -> TimerService&;
+
+		TimerService();
+		~TimerService() noexcept;
+
+		TimerService(const TimerService&) = delete;
+		auto operator=(const TimerService&) -> TimerService& = delete;
+		TimerService(TimerService&&) noexcept = delete;
+		auto operator=(TimerService&&) noexcept -> TimerService& = delete;
+
+		/**
+		* @brief Calls callback every interval, the first time after startDelay (interval if not given)
+		* Deadlines don't drift, if the thread falls behind by more than an interval missed ticks are skipped
+		*/
+		auto Schedule(Duration interval, const Callback& callback, std::optional<Duration> startDelay = std::nullopt) -> TimerId;
+		auto ScheduleOnce(Duration delay, const Callback& callback) -> TimerId;
+		/**
+		* @brief After this returns the callback won't run again
+		* Waits for the callback if it's running on the timer thread right now (unless called from it)
+		*/
+		void Cancel(TimerId id);
+
+		[[nodiscard]] auto IsScheduled(TimerId id) const -> bool;
+		[[nodiscard]] auto GetTimerCount() const -> std::size_t;
+
+		private:
+		struct Timer
+		{
+			Duration interval;
+			Callback callback;
+			bool repeating;
+			bool cancelled = false;
+		};
+		struct Deadline
+		{
+			Clock::time_point time;
+			TimerId id;
+
+			[[nodiscard]] auto operator>(const Deadline& other) const noexcept -> bool { return time > other.time; }
+		};
+
+		mutable std::mutex mutex;
+		std::condition_variable_any wakeCondition;
+		std::condition_variable_any callbackFinishedCondition;
+
+		std::unordered_map<TimerId, Timer> timers;
+		std::priority_queue<Deadline, std::vector<Deadline>, std::greater<>> deadlines;
+		TimerId nextId = 1;
+		TimerId runningId = InvalidTimerId;
+
+		std::jthread thread;
+
+		auto Add(Duration interval, Duration startDelay, const Callback& callback, bool repeating) -> TimerId;
+		void ThreadFunction(const std::stop_token& stopToken);
+		void RunDueTimers(std::unique_lock<std::mutex>& lock);
+	};
+}
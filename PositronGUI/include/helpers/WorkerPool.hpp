@@ -0,0 +1,58 @@
+#pragma once
+
+#include "helpers/InlineFunction.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+
+namespace PGUI
+{
+	/**
+	* @brief Fixed number of threads running submitted tasks in submission order
+	*/
+	class WorkerPool
+	{
+		public:
+		using Task = InlineFunction<void()>;
+		/**
+		* @brief Runs on every worker thread when it starts or exits, e.g. for CoInitializeEx
+		*/
+		using ThreadCallback = std::function<void()>;
+
+		[[nodiscard]] static auto DefaultThreadCount() noexcept -> std::size_t;
+
+		explicit WorkerPool(std::size_t threadCount = DefaultThreadCount(),
+			const ThreadCallback& onThreadStart = nullptr, const ThreadCallback& onThreadExit = nullptr);
+		/**
+		* @brief Waits for running tasks, queued ones (and any those submit) are destroyed without running
+		*/
+		~WorkerPool() noexcept;
+
+		WorkerPool(const WorkerPool&) = delete;
+		auto operator=(const WorkerPool&) -> WorkerPool& = delete;
+		WorkerPool(WorkerPool&&) noexcept = delete;
+		auto operator=(WorkerPool&&) noexcept -> WorkerPool& = delete;
+
+		void Submit(Task task);
+
+		[[nodiscard]] auto GetThreadCount() const noexcept { return threads.size(); }
+		[[nodiscard]] auto GetQueuedCount() const -> std::size_t;
+
+		private:
+		mutable std::mutex mutex;
+		std::condition_variable_any taskCondition;
+		std::deque<Task> tasks;
+
+		std::vector<std::jthread> threads;
+
+		void ThreadFunction(const std::stop_token& stopToken,
+			const ThreadCallback& onThreadStart, const ThreadCallback& onThreadExit);
+	};
+}
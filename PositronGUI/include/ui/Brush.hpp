@@ -6,7 +6,6 @@
 #include "ui/Gradient.hpp"
 
 #include <d2d1_3.h>
-#include <memory>
 #include <optional>
 #include <utility>
 #include <variant>
@@ -118,6 +117,12 @@ namespace PGUI::UI
 		
 		void SetParametersAndCreateBrush(ComPtr<ID2D1RenderTarget> renderTarget, const BrushParameters& parameters) noexcept;
 
+		/**
+		* @brief Brings the brush up to date with the parameters, reusing the one it has where it can
+		*
+		* Solid color brushes are retinted and gradient brushes come from the BrushPool of the render target's device,
+		* so a Brush switching between states it has been in before doesn't allocate
+		*/
 		void CreateBrush(ComPtr<ID2D1RenderTarget> renderTarget) noexcept;
 		void ReleaseBrush() noexcept;
 
@@ -125,15 +130,19 @@ namespace PGUI::UI
 		[[nodiscard]] auto GetParameters() noexcept -> BrushParameters&;
 		void SetParameters(const BrushParameters& parameters) noexcept;
 
-		auto operator=(const BrushParameters& _parameters) noexcept -> Brush& { parameters = _parameters; return *this; }
-		[[nodiscard]] auto operator->() const noexcept -> ID2D1Brush* { return brush->GetBrushPtr(); }
-		[[nodiscard]] explicit(false) operator BrushBase* () const noexcept { return brush.get(); }
-		[[nodiscard]] explicit(false) operator ID2D1Brush* () const noexcept { return brush->GetBrushPtr(); }
-		[[nodiscard]] explicit operator bool() const noexcept { return (bool)brush; }
+		auto operator=(const BrushParameters& _parameters) noexcept -> Brush& { SetParameters(_parameters); return *this; }
+		[[nodiscard]] auto operator->() const noexcept -> ID2D1Brush* { return Get()->GetBrushPtr(); }
+		[[nodiscard]] explicit(false) operator BrushBase* () const noexcept { return Get(); }
+		[[nodiscard]] explicit(false) operator ID2D1Brush* () const noexcept { return Get()->GetBrushPtr(); }
+		/**
+		* @brief False when there's no brush or the parameters changed since it was created
+		*/
+		[[nodiscard]] explicit operator bool() const noexcept { return Get() != nullptr && !parametersChanged; }
 
 		private:
-		std::unique_ptr<BrushBase> brush = nullptr;
+		std::variant<std::monostate, SolidColorBrush, LinearGradientBrush, RadialGradientBrush> brush;
 		BrushParameters parameters;
+		bool parametersChanged = false;
 	};
 
 	void SetGradientBrushRect(Brush& brush, RectF rect);
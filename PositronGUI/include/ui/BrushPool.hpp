@@ -0,0 +1,104 @@
+#pragma once
+
+#include "helpers/ComPtr.hpp"
+#include "ui/Brush.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <d2d1_3.h>
+#include <span>
+#include <unordered_map>
+
+
+namespace PGUI::UI
+{
+	/**
+	* @brief Per device pool Brush gets its Direct2D brushes from, so state changes don't recreate them
+	*
+	* Gradient brushes are shared between every Brush with the same parameters and must not be changed through them
+	* Solid color brushes aren't shared, a Brush keeps its own and has it retinted
+	* Like the single threaded D2D factory, only to be used from the thread that draws
+	*/
+	class BrushPool
+	{
+		public:
+		static constexpr std::size_t DefaultCapacity = 256;
+
+		explicit BrushPool(ComPtr<ID2D1Device> device, std::size_t capacity = DefaultCapacity) noexcept;
+
+		/**
+		* @brief Pool of the device renderTarget draws with, nullptr if it isn't a device context
+		*/
+		[[nodiscard]] static auto ForRenderTarget(ID2D1RenderTarget* renderTarget) -> BrushPool*;
+
+		/**
+		* @brief Retints brush when there is one, creates it otherwise
+		*/
+		[[nodiscard]] auto GetSolidColorBrush(ID2D1RenderTarget* renderTarget,
+			ComPtr<ID2D1SolidColorBrush> brush, RGBA color) -> ComPtr<ID2D1SolidColorBrush>;
+		[[nodiscard]] auto GetLinearGradientBrush(ID2D1RenderTarget* renderTarget,
+			const LinearGradientBrushParameters& parameters) -> ComPtr<ID2D1LinearGradientBrush>;
+		[[nodiscard]] auto GetRadialGradientBrush(ID2D1RenderTarget* renderTarget,
+			const RadialGradientBrushParameters& parameters) -> ComPtr<ID2D1RadialGradientBrush>;
+
+		void Clear() noexcept;
+
+		[[nodiscard]] auto GetCapacity() const noexcept { return capacity; }
+		/**
+		* @brief Least recently used gradient brushes are dropped to fit, Brushes using them keep them alive
+		*/
+		void SetCapacity(std::size_t capacity);
+		[[nodiscard]] auto GetCount() const noexcept { return entries.size(); }
+		/**
+		* @brief Brushes handed out without creating one, shared gradients and retinted solid colors
+		*/
+		[[nodiscard]] auto GetHitCount() const noexcept { return hitCount; }
+		[[nodiscard]] auto GetMissCount() const noexcept { return missCount; }
+
+		private:
+		enum class GradientKind
+		{
+			Linear,
+			Radial
+		};
+		struct Key
+		{
+			GradientKind kind = GradientKind::Linear;
+			// Start and end points, or center, offset and radii, after the reference rect is applied
+			std::array<float, 6> geometry{ };
+			std::span<const GradientStop> stops;
+			D2D1_GAMMA gamma = D2D1_GAMMA_2_2;
+			D2D1_EXTEND_MODE extendMode = D2D1_EXTEND_MODE_CLAMP;
+			std::size_t hash = 0;
+		};
+		struct Entry
+		{
+			GradientStops stops;
+			ComPtr<ID2D1Brush> brush;
+			std::uint64_t lastUse = 0;
+		};
+		struct KeyHash
+		{
+			[[nodiscard]] auto operator()(const Key& key) const noexcept -> std::size_t { return key.hash; }
+		};
+		struct KeyEqual
+		{
+			[[nodiscard]] auto operator()(const Key& left, const Key& right) const noexcept -> bool;
+		};
+
+		// Keys view the stops stored in their entry, lookups view the caller's stops without copying them
+		std::unordered_map<Key, Entry, KeyHash, KeyEqual> entries;
+		ComPtr<ID2D1Device> device;
+		std::size_t capacity;
+		std::uint64_t useCounter = 0;
+		std::uint64_t hitCount = 0;
+		std::uint64_t missCount = 0;
+
+		[[nodiscard]] static auto MakeKey(GradientKind kind, const std::array<float, 6>& geometry,
+			const Gradient& gradient) noexcept -> Key;
+		[[nodiscard]] auto Find(const Key& key) noexcept -> ID2D1Brush*;
+		void Insert(const Key& key, ComPtr<ID2D1Brush> brush);
+		void Trim(std::size_t count);
+	};
+}
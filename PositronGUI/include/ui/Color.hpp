@@ -11,6 +11,76 @@
 
 namespace PGUI::UI
 {
+	namespace color_detail
+	{
+		// Written out instead of using <cmath> so the conversions work in constant expressions,
+		// Min and Max pick the same operand as minps and maxps so the SIMD versions match bit for bit
+		[[nodiscard]] constexpr auto Min(float a, float b) noexcept { return a < b ? a : b; }
+		[[nodiscard]] constexpr auto Max(float a, float b) noexcept { return a > b ? a : b; }
+		[[nodiscard]] constexpr auto Abs(float value) noexcept { return value < 0.0F ? -value : value; }
+		[[nodiscard]] constexpr auto Floor(float value) noexcept -> float
+		{
+			// Floats this large are whole already, NaN fails the comparison too
+			if (!(Abs(value) < 8388608.0F))
+			{
+				return value;
+			}
+			const auto truncated = static_cast<float>(static_cast<std::int32_t>(value));
+			return truncated > value ? truncated - 1.0F : truncated;
+		}
+
+		/**
+		* @brief Hue in degrees to its sector in [0, 6], any hue is accepted
+		*/
+		[[nodiscard]] constexpr auto HueSector(float hue) noexcept
+		{
+			const auto sector = hue / 60.0F;
+			return sector - 6.0F * Floor(sector / 6.0F);
+		}
+		/**
+		* @brief How much of the chroma channel offset loses at sector, from the branchless form of the hexcone model
+		*/
+		[[nodiscard]] constexpr auto HsvWeight(float offset, float sector) noexcept
+		{
+			auto k = offset + sector;
+			k = k >= 6.0F ? k - 6.0F : k;
+			return Max(0.0F, Min(Min(k, 4.0F - k), 1.0F));
+		}
+		[[nodiscard]] constexpr auto HslWeight(float offset, float sector) noexcept
+		{
+			auto k = offset + 2.0F * sector;
+			k = k >= 12.0F ? k - 12.0F : k;
+			return Max(-1.0F, Min(Min(k - 3.0F, 9.0F - k), 1.0F));
+		}
+		/**
+		* @brief Hue in degrees of a color with the given largest channel and chroma
+		*/
+		[[nodiscard]] constexpr auto Hue(float r, float g, float b, float max, float delta) noexcept -> float
+		{
+			if (delta == 0.0F)
+			{
+				return 0.0F;
+			}
+
+			float hue = 0.0F;
+			if (max == r)
+			{
+				hue = (g - b) / delta;
+			}
+			else if (max == g)
+			{
+				hue = (b - r) / delta + 2.0F;
+			}
+			else
+			{
+				hue = (r - g) / delta + 4.0F;
+			}
+			hue = hue < 0.0F ? hue + 6.0F : hue;
+
+			return hue * 60.0F;
+		}
+	}
+
 	class HSL;
 	class HSV;
 	class CMYK;
@@ -19,13 +89,22 @@ namespace PGUI::UI
 	{
 		public:
 		RGBA() noexcept = default;
-		RGBA(FLOAT r, FLOAT g, FLOAT b, FLOAT a = 1.0F) noexcept;
-		RGBA(std::uint8_t r, std::uint8_t g, std::uint8_t b, std::uint8_t a = 255) noexcept;
-		RGBA(std::uint32_t rgb, FLOAT a = 1.0F) noexcept;
-
-		explicit(false) RGBA(HSL hsl) noexcept;
-		explicit(false) RGBA(HSV hsv) noexcept;
-		explicit(false) RGBA(CMYK cmyk) noexcept;
+		constexpr RGBA(FLOAT _r, FLOAT _g, FLOAT _b, FLOAT _a = 1.0F) noexcept :
+			r{ _r }, g{ _g }, b{ _b }, a{ _a }
+		{
+		}
+		constexpr RGBA(std::uint8_t _r, std::uint8_t _g, std::uint8_t _b, std::uint8_t _a = 255) noexcept :
+			r{ _r / 255.0F }, g{ _g / 255.0F }, b{ _b / 255.0F }, a{ _a / 255.0F }
+		{
+		}
+		constexpr RGBA(std::uint32_t rgb, FLOAT _a = 1.0F) noexcept :
+			r{ ((rgb >> 16) & 0xFF) / 255.0F }, g{ ((rgb >> 8) & 0xFF) / 255.0F }, b{ (rgb & 0xFF) / 255.0F }, a{ _a }
+		{
+		}
+
+		explicit(false) constexpr RGBA(HSL hsl) noexcept;
+		explicit(false) constexpr RGBA(HSV hsv) noexcept;
+		explicit(false) constexpr RGBA(CMYK cmyk) noexcept;
 		explicit(false) RGBA(const D2D1_COLOR_F& color) noexcept;
 		explicit(false) RGBA(const winrt::Windows::UI::Color& color) noexcept;
 
@@ -51,11 +130,14 @@ namespace PGUI::UI
 	{
 		public:
 		HSL() noexcept = default;
-		HSL(FLOAT h, FLOAT s, FLOAT l) noexcept;
+		constexpr HSL(FLOAT _h, FLOAT _s, FLOAT _l) noexcept :
+			h{ _h }, s{ _s }, l{ _l }
+		{
+		}
 
-		explicit(false) HSL(const RGBA& rgb) noexcept;
+		explicit(false) constexpr HSL(const RGBA& rgb) noexcept;
 
-		explicit(false) operator RGBA() const noexcept;
+		explicit(false) constexpr operator RGBA() const noexcept { return RGBA{ *this }; }
 
 		[[nodiscard]] constexpr auto operator==(const HSL& other) const noexcept -> bool = default;
 
@@ -68,11 +150,14 @@ namespace PGUI::UI
 	{
 		public:
 		HSV() noexcept = default;
-		HSV(FLOAT h, FLOAT s, FLOAT v) noexcept;
+		constexpr HSV(FLOAT _h, FLOAT _s, FLOAT _v) noexcept :
+			h{ _h }, s{ _s }, v{ _v }
+		{
+		}
 
-		explicit(false) HSV(const RGBA& rgb) noexcept;
+		explicit(false) constexpr HSV(const RGBA& rgb) noexcept;
 
-		explicit(false) operator RGBA() const noexcept;
+		explicit(false) constexpr operator RGBA() const noexcept { return RGBA{ *this }; }
 
 		[[nodiscard]] constexpr auto operator==(const HSV& other) const noexcept -> bool = default;
 
@@ -85,11 +170,14 @@ namespace PGUI::UI
 	{
 		public:
 		CMYK() noexcept = default;
-		CMYK(FLOAT c, FLOAT m, FLOAT y, FLOAT k) noexcept;
+		constexpr CMYK(FLOAT _c, FLOAT _m, FLOAT _y, FLOAT _k) noexcept :
+			c{ _c }, m{ _m }, y{ _y }, k{ _k }
+		{
+		}
 
-		explicit(false) CMYK(const RGBA& rgb) noexcept;
+		explicit(false) constexpr CMYK(const RGBA& rgb) noexcept;
 
-		explicit(false) operator RGBA() const noexcept;
+		explicit(false) constexpr operator RGBA() const noexcept { return RGBA{ *this }; }
 
 		[[nodiscard]] constexpr auto operator==(const CMYK& other) const noexcept -> bool = default;
 
@@ -98,4 +186,67 @@ namespace PGUI::UI
 		FLOAT y = 0.0F;
 		FLOAT k = 0.0F;
 	};
+
+	constexpr RGBA::RGBA(HSL hsl) noexcept :
+		a{ 1.0F }
+	{
+		const auto sector = color_detail::HueSector(hsl.h);
+		const auto chroma = hsl.s * color_detail::Min(hsl.l, 1.0F - hsl.l);
+
+		r = hsl.l - chroma * color_detail::HslWeight(0.0F, sector);
+		g = hsl.l - chroma * color_detail::HslWeight(8.0F, sector);
+		b = hsl.l - chroma * color_detail::HslWeight(4.0F, sector);
+	}
+
+	constexpr RGBA::RGBA(HSV hsv) noexcept :
+		a{ 1.0F }
+	{
+		const auto sector = color_detail::HueSector(hsv.h);
+		const auto chroma = hsv.v * hsv.s;
+
+		r = hsv.v - chroma * color_detail::HsvWeight(5.0F, sector);
+		g = hsv.v - chroma * color_detail::HsvWeight(3.0F, sector);
+		b = hsv.v - chroma * color_detail::HsvWeight(1.0F, sector);
+	}
+
+	constexpr RGBA::RGBA(CMYK cmyk) noexcept :
+		r{ (1.0F - cmyk.c) * (1.0F - cmyk.k) },
+		g{ (1.0F - cmyk.m) * (1.0F - cmyk.k) },
+		b{ (1.0F - cmyk.y) * (1.0F - cmyk.k) },
+		a{ 1.0F }
+	{
+	}
+
+	constexpr HSL::HSL(const RGBA& rgb) noexcept
+	{
+		const auto max = color_detail::Max(color_detail::Max(rgb.r, rgb.g), rgb.b);
+		const auto min = color_detail::Min(color_detail::Min(rgb.r, rgb.g), rgb.b);
+		const auto delta = max - min;
+
+		h = color_detail::Hue(rgb.r, rgb.g, rgb.b, max, delta);
+		l = (max + min) * 0.5F;
+		// Rounding can leave no room below 1 for lightness, saturation is full then
+		s = delta == 0.0F ? 0.0F : color_detail::Min(delta / (1.0F - color_detail::Abs(2.0F * l - 1.0F)), 1.0F);
+	}
+
+	constexpr HSV::HSV(const RGBA& rgb) noexcept
+	{
+		const auto max = color_detail::Max(color_detail::Max(rgb.r, rgb.g), rgb.b);
+		const auto min = color_detail::Min(color_detail::Min(rgb.r, rgb.g), rgb.b);
+		const auto delta = max - min;
+
+		h = color_detail::Hue(rgb.r, rgb.g, rgb.b, max, delta);
+		s = max == 0.0F ? 0.0F : delta / max;
+		v = max;
+	}
+
+	constexpr CMYK::CMYK(const RGBA& rgb) noexcept
+	{
+		const auto max = color_detail::Max(color_detail::Max(rgb.r, rgb.g), rgb.b);
+
+		k = 1.0F - max;
+		c = max == 0.0F ? 0.0F : (max - rgb.r) / max;
+		m = max == 0.0F ? 0.0F : (max - rgb.g) / max;
+		y = max == 0.0F ? 0.0F : (max - rgb.b) / max;
+	}
 }
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "ui/Color.hpp"
+
+#include <cstddef>
+#include <span>
+
+
+namespace PGUI::UI
+{
+	/*
+	* Bulk versions of the RGBA, HSL, HSV and CMYK conversions, for when colors come by the thousand
+	* Results are bit for bit the ones converting each color on its own gives, unless the compiler is allowed to contract floating point math
+	* Planar functions take one array per channel, each holding count values, output arrays may be the input ones
+	* RGB to HSL and HSV expect finite channels
+	*/
+
+	void HsvToRgb(const float* h, const float* s, const float* v,
+		float* r, float* g, float* b, std::size_t count) noexcept;
+	void HslToRgb(const float* h, const float* s, const float* l,
+		float* r, float* g, float* b, std::size_t count) noexcept;
+	void CmykToRgb(const float* c, const float* m, const float* y, const float* k,
+		float* r, float* g, float* b, std::size_t count) noexcept;
+
+	void RgbToHsv(const float* r, const float* g, const float* b,
+		float* h, float* s, float* v, std::size_t count) noexcept;
+	void RgbToHsl(const float* r, const float* g, const float* b,
+		float* h, float* s, float* l, std::size_t count) noexcept;
+	void RgbToCmyk(const float* r, const float* g, const float* b,
+		float* c, float* m, float* y, float* k, std::size_t count) noexcept;
+
+	/**
+	* @brief Packed conversions, destination has room for source.size() colors
+	* Colors converted to RGBA are opaque, alpha is ignored when converting from RGBA
+	*/
+	void ConvertColors(std::span<const HSV> source, RGBA* destination) noexcept;
+	void ConvertColors(std::span<const HSL> source, RGBA* destination) noexcept;
+	void ConvertColors(std::span<const CMYK> source, RGBA* destination) noexcept;
+	void ConvertColors(std::span<const RGBA> source, HSV* destination) noexcept;
+	void ConvertColors(std::span<const RGBA> source, HSL* destination) noexcept;
+	void ConvertColors(std::span<const RGBA> source, CMYK* destination) noexcept;
+}
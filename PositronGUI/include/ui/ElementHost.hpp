@@ -0,0 +1,87 @@
+#pragma once
+
+#include "core/Event.hpp"
+#include "core/VisualTree.hpp"
+#include "ui/Control.hpp"
+#include "ui/Brush.hpp"
+#include "graphics/Graphics.hpp"
+
+#include <concepts>
+#include <memory>
+
+
+namespace PGUI::UI
+{
+	class ElementHost;
+
+	/**
+	* @brief Windowless control, drawn into the surface of the ElementHost it's attached to
+	*/
+	class Element : public Core::VisualElement
+	{
+		friend class ElementHost;
+
+		public:
+		/**
+		* @brief The host clips to renderRect (absolute bounds of the element) before calling this
+		*/
+		virtual void Render(Graphics::Graphics g, RectF renderRect) = 0;
+
+		protected:
+		virtual void CreateDeviceResources(Graphics::Graphics /*unused*/) { /* */ }
+		virtual void DiscardDeviceResources() { /* */ }
+
+		private:
+		bool deviceResourcesCreated = false;
+	};
+
+	/**
+	* @brief Owns a single HWND and swap chain and hosts a tree of windowless Elements
+	*
+	* HWND per control stays the default, ElementHost is opt in and can be mixed with regular controls
+	*/
+	class ElementHost : public Control
+	{
+		public:
+		ElementHost() noexcept;
+
+		template <std::derived_from<Element> T, typename ...Args>
+		auto AddElement(Args&&... args) -> T*
+		{
+			return visualTree.GetRoot().AddChild<T>(std::forward<Args>(args)...);
+		}
+		auto RemoveElement(const Element* element) -> std::unique_ptr<Core::VisualElement>;
+
+		[[nodiscard]] auto GetVisualTree() noexcept -> Core::VisualTree& { return visualTree; }
+		[[nodiscard]] auto GetVisualTree() const noexcept -> const Core::VisualTree& { return visualTree; }
+
+		void SetBackgroundBrush(Brush& brush) noexcept;
+		[[nodiscard]] auto& GetBackgroundBrush() const noexcept { return backgroundBrush; }
+
+		private:
+		Core::VisualTree visualTree;
+		Brush backgroundBrush;
+		// Cleared once the brush is set by hand
+		bool followsTheme = true;
+		Core::ScopedEventConnection themeChangedConnection;
+		bool trackingMouse = false;
+
+		void CreateDeviceResources() override;
+		void DiscardDeviceResources() override;
+
+		void OnThemeChanged() noexcept;
+
+		void RouteMouseEvent(Core::InputEventType type, Core::MouseButton button, WPARAM wParam, PointF position);
+		[[nodiscard]] static auto GetKeyModifiers() noexcept -> Core::ModifierKeys;
+
+		auto OnPaint(UINT msg, WPARAM wParam, LPARAM lParam) -> Core::HandlerResult;
+		auto OnSize(UINT msg, WPARAM wParam, LPARAM lParam) noexcept -> Core::HandlerResult;
+		auto OnMouseMove(UINT msg, WPARAM wParam, LPARAM lParam) -> Core::HandlerResult;
+		auto OnMouseLeave(UINT msg, WPARAM wParam, LPARAM lParam) -> Core::HandlerResult;
+		auto OnMouseButton(UINT msg, WPARAM wParam, LPARAM lParam) -> Core::HandlerResult;
+		auto OnMouseWheel(UINT msg, WPARAM wParam, LPARAM lParam) -> Core::HandlerResult;
+		auto OnKey(UINT msg, WPARAM wParam, LPARAM lParam) -> Core::HandlerResult;
+		auto OnChar(UINT msg, WPARAM wParam, LPARAM lParam) -> Core::HandlerResult;
+		[[nodiscard]] static auto OnGetDlgCode(UINT msg, WPARAM wParam, LPARAM lParam) noexcept -> Core::HandlerResult;
+	};
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "core/Rect.hpp"
+#include "graphics/BitmapRenderTarget.hpp"
+#include "graphics/GraphicsBitmap.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+
+namespace PGUI::UI
+{
+	/**
+	* @brief Composed frames of a GIF's first loop, so later loops don't have to compose again
+	*
+	* Every frame is kept whole while that fits in the byte budget, then playback is one DrawBitmap per frame
+	* Past the budget only every keyframeInterval-th frame stays whole and the rest keep just the area
+	* that changed since the frame before, which playback copies into the compose target
+	* If even that doesn't fit the cache disables itself
+	*/
+	class GifFrameCache
+	{
+		public:
+		enum class Mode
+		{
+			Full,
+			KeyframeDelta,
+			Disabled
+		};
+
+		/**
+		* @brief Frame indices the renderer had after composing a step
+		*/
+		struct Step
+		{
+			std::size_t frameIndex = 0;
+			std::size_t nextFrameIndex = 1;
+		};
+
+		static constexpr std::size_t DefaultByteBudget = 32ULL * 1024 * 1024;
+		static constexpr std::size_t DefaultKeyframeInterval = 16;
+
+		explicit GifFrameCache(std::size_t byteBudget = DefaultByteBudget,
+			std::size_t keyframeInterval = DefaultKeyframeInterval) noexcept;
+
+		/**
+		* @brief Copies the composed frame, changedRect is in pixels
+		* The first step recorded has to be the first frame of a loop
+		*/
+		void Record(const Graphics::BitmapRenderTarget& composeTarget, RectU changedRect, Step step);
+		/**
+		* @brief Call when the first recorded step comes around again
+		*/
+		void Complete() noexcept;
+		/**
+		* @brief Drops everything recorded and starts over in Full mode
+		*/
+		void Reset() noexcept;
+
+		/**
+		* @brief Whole frame of stepIndex, only in Full mode
+		*/
+		[[nodiscard]] auto GetFullFrame(std::size_t stepIndex) const noexcept -> Graphics::GraphicsBitmap;
+		/**
+		* @brief Moves composeTarget from the previous step to stepIndex
+		*/
+		void ApplyStep(const Graphics::BitmapRenderTarget& composeTarget, std::size_t stepIndex);
+		/**
+		* @brief Rebuilds stepIndex in composeTarget from the closest keyframe, whatever it held before
+		* Fails if composeTarget isn't the size the frames were recorded at
+		*/
+		[[nodiscard]] auto RestoreStep(const Graphics::BitmapRenderTarget& composeTarget, std::size_t stepIndex) -> bool;
+
+		void SetByteBudget(std::size_t _byteBudget) noexcept;
+		[[nodiscard]] auto GetByteBudget() const noexcept { return byteBudget; }
+		[[nodiscard]] auto GetByteSize() const noexcept { return byteSize; }
+
+		[[nodiscard]] auto GetMode() const noexcept { return mode; }
+		[[nodiscard]] auto IsComplete() const noexcept { return isComplete; }
+		[[nodiscard]] auto IsRecording() const noexcept { return !isComplete && mode != Mode::Disabled; }
+
+		[[nodiscard]] auto GetStepCount() const noexcept { return entries.size(); }
+		[[nodiscard]] auto GetStep(std::size_t stepIndex) const noexcept { return entries[stepIndex].step; }
+
+		/**
+		* @brief Number of frames played from the cache instead of being composed
+		*/
+		[[nodiscard]] auto GetHitCount() const noexcept { return hitCount; }
+
+		private:
+		struct Entry
+		{
+			Step step;
+			RectU changedRect;
+			/**
+			* @brief Either the whole frame or only changedRect of it
+			*/
+			Graphics::GraphicsBitmap bitmap;
+			bool isKeyframe = false;
+		};
+
+		std::vector<Entry> entries;
+		std::size_t byteBudget;
+		std::size_t keyframeInterval;
+		std::size_t byteSize = 0;
+		std::uint64_t hitCount = 0;
+		SizeU frameSize{ };
+		Mode mode = Mode::Full;
+		bool isComplete = false;
+
+		[[nodiscard]] auto FullFrameBytes() const noexcept -> std::size_t;
+		[[nodiscard]] static auto RectBytes(RectU rect) noexcept -> std::size_t;
+		[[nodiscard]] auto IsWholeFrame(RectU rect) const noexcept -> bool;
+
+		[[nodiscard]] static auto CreateCopy(const Graphics::BitmapRenderTarget& target,
+			const Graphics::GraphicsBitmap& source, std::optional<RectU> srcRect) -> Graphics::GraphicsBitmap;
+
+		static void CopyEntry(const Graphics::GraphicsBitmap& destination, const Entry& entry);
+		void ConvertToDeltas(const Graphics::BitmapRenderTarget& composeTarget);
+		void Disable() noexcept;
+	};
+}
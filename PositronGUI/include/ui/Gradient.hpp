@@ -6,6 +6,10 @@
 #include "PositioningMode.hpp"
 #include "Color.hpp"
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <vector>
 
 
@@ -39,6 +43,14 @@ namespace PGUI::UI
 		[[nodiscard]] auto GetPositioningMode() const noexcept -> PositioningMode;
 		void SetPositioningMode(PositioningMode mode) noexcept;
 
+		/**
+		* @brief Color space the stops are interpolated in
+		*/
+		[[nodiscard]] auto GetGamma() const noexcept { return gamma; }
+		void SetGamma(D2D1_GAMMA _gamma) noexcept { gamma = _gamma; }
+		[[nodiscard]] auto GetExtendMode() const noexcept { return extendMode; }
+		void SetExtendMode(D2D1_EXTEND_MODE _extendMode) noexcept { extendMode = _extendMode; }
+
 		virtual void ApplyReferenceRect(RectF rect) noexcept = 0;
 
 		protected:
@@ -47,6 +59,8 @@ namespace PGUI::UI
 		private:
 		GradientStops stops;
 		PositioningMode mode = PositioningMode::Relative;
+		D2D1_GAMMA gamma = D2D1_GAMMA_2_2;
+		D2D1_EXTEND_MODE extendMode = D2D1_EXTEND_MODE_CLAMP;
 	};
 
 	class LinearGradient : public Gradient
@@ -85,4 +99,31 @@ namespace PGUI::UI
 		Ellipse ellipse;
 		PointF offset;
 	};
+
+	/**
+	* @brief A gradient baked into premultiplied BGRA colors, for drawing without Direct2D
+	*
+	* Stops are interpolated the way a stop collection with the same gamma does, in straight alpha,
+	* the extend mode applies when sampling positions outside [0, 1]
+	*/
+	class GradientLut
+	{
+		public:
+		static constexpr std::size_t Size = 256;
+
+		explicit GradientLut(const Gradient& gradient);
+		GradientLut(std::span<const GradientStop> stops, D2D1_GAMMA gamma, D2D1_EXTEND_MODE extendMode);
+
+		/**
+		* @brief Color i is the gradient at i / (Size - 1)
+		*/
+		[[nodiscard]] auto GetColors() const noexcept -> const std::array<std::uint32_t, Size>& { return colors; }
+		[[nodiscard]] auto GetExtendMode() const noexcept { return extendMode; }
+
+		[[nodiscard]] auto Sample(float position) const noexcept -> std::uint32_t;
+
+		private:
+		std::array<std::uint32_t, Size> colors{ };
+		D2D1_EXTEND_MODE extendMode;
+	};
 }
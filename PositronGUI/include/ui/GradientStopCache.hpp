@@ -0,0 +1,91 @@
+#pragma once
+
+#include "helpers/ComPtr.hpp"
+#include "ui/Gradient.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <d2d1_3.h>
+#include <span>
+#include <unordered_map>
+
+
+namespace PGUI::UI
+{
+	/**
+	* @brief Shares ID2D1GradientStopCollection objects between brushes made from the same stops
+	*
+	* A stop collection works with every render target of the device it was made on, so there is one cache per device
+	* Render targets that aren't device contexts have no device to share with and aren't cached
+	* Like the single threaded D2D factory, only to be used from the thread that draws
+	*/
+	class GradientStopCache
+	{
+		public:
+		static constexpr std::size_t DefaultCapacity = 256;
+
+		explicit GradientStopCache(ComPtr<ID2D1Device> device, std::size_t capacity = DefaultCapacity) noexcept;
+
+		/**
+		* @brief Cache of the device renderTarget draws with, nullptr if it isn't a device context
+		*/
+		[[nodiscard]] static auto ForRenderTarget(ID2D1RenderTarget* renderTarget) -> GradientStopCache*;
+		/**
+		* @brief Goes through the cache of renderTarget when it has one
+		*/
+		[[nodiscard]] static auto GetCollection(ID2D1RenderTarget* renderTarget, const Gradient& gradient)
+			-> ComPtr<ID2D1GradientStopCollection>;
+
+		/**
+		* @brief renderTarget has to be a device context of this cache's device
+		*/
+		[[nodiscard]] auto Get(ID2D1RenderTarget* renderTarget, std::span<const GradientStop> stops,
+			D2D1_GAMMA gamma, D2D1_EXTEND_MODE extendMode) -> ComPtr<ID2D1GradientStopCollection>;
+
+		void Clear() noexcept;
+
+		[[nodiscard]] auto GetCapacity() const noexcept { return capacity; }
+		/**
+		* @brief Least recently used collections are dropped to fit, brushes using them keep them alive
+		*/
+		void SetCapacity(std::size_t capacity);
+		[[nodiscard]] auto GetCount() const noexcept { return entries.size(); }
+		[[nodiscard]] auto GetHitCount() const noexcept { return hitCount; }
+		[[nodiscard]] auto GetMissCount() const noexcept { return missCount; }
+
+		private:
+		struct Key
+		{
+			std::span<const GradientStop> stops;
+			D2D1_GAMMA gamma = D2D1_GAMMA_2_2;
+			D2D1_EXTEND_MODE extendMode = D2D1_EXTEND_MODE_CLAMP;
+			std::size_t hash = 0;
+		};
+		struct Entry
+		{
+			GradientStops stops;
+			ComPtr<ID2D1GradientStopCollection> collection;
+			std::uint64_t lastUse = 0;
+		};
+		struct KeyHash
+		{
+			[[nodiscard]] auto operator()(const Key& key) const noexcept -> std::size_t { return key.hash; }
+		};
+		struct KeyEqual
+		{
+			[[nodiscard]] auto operator()(const Key& left, const Key& right) const noexcept -> bool;
+		};
+
+		// Keys view the stops stored in their entry, lookups view the caller's stops without copying them
+		std::unordered_map<Key, Entry, KeyHash, KeyEqual> entries;
+		ComPtr<ID2D1Device> device;
+		std::size_t capacity;
+		std::uint64_t useCounter = 0;
+		std::uint64_t hitCount = 0;
+		std::uint64_t missCount = 0;
+
+		[[nodiscard]] static auto MakeKey(std::span<const GradientStop> stops,
+			D2D1_GAMMA gamma, D2D1_EXTEND_MODE extendMode) noexcept -> Key;
+		void Trim(std::size_t count);
+	};
+}
@@ -5,8 +5,16 @@
 #include "ui/bmp/BitmapSource.hpp"
 #include "ui/Colors.hpp"
 #include "ui/bmp/BitmapDecoder.hpp"
+#include "ui/bmp/AsyncImageDecoder.hpp"
+#include "ui/bmp/GifDecoder.hpp"
+#include "ui/bmp/TiledImage.hpp"
+#include "ui/GifFrameCache.hpp"
+#include "graphics/BitmapAtlas.hpp"
 #include "graphics/BitmapRenderTarget.hpp"
 
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <variant>
 
 
@@ -45,6 +53,119 @@ namespace PGUI::UI
 		ComPtr<ID2D1Bitmap> bmp = nullptr;
 		Bmp::BitmapSource bmpSrc;
 	};
+	/**
+	* @brief Draws pixels from AsyncImageDecoder, uploaded on the first Render
+	*
+	* Images up to MaxAtlasImageSize on each side go into the thread's BitmapAtlas instead of a bitmap of their own,
+	* so a grid of thumbnails shares a few pages, and keep their pixels to go back in if they're evicted
+	*/
+	class DecodedImageRenderer : public IImgRenderer
+	{
+		public:
+		static constexpr UINT32 MaxAtlasImageSize = 256;
+
+		DecodedImageRenderer(std::wstring_view filePath, Bmp::DecodedImage image) noexcept;
+		~DecodedImageRenderer() noexcept override;
+
+		DecodedImageRenderer(const DecodedImageRenderer&) = delete;
+		auto operator=(const DecodedImageRenderer&) -> DecodedImageRenderer& = delete;
+		DecodedImageRenderer(DecodedImageRenderer&&) noexcept = delete;
+		auto operator=(DecodedImageRenderer&&) noexcept -> DecodedImageRenderer& = delete;
+
+		void Render(Core::WindowPtr<Core::DirectCompositionWindow> wnd) override;
+		[[nodiscard]] auto GetImage() const noexcept -> BmpToRender override;
+
+		[[nodiscard]] auto GetDecodedSize() const noexcept { return decodedSize; }
+		[[nodiscard]] auto GetOriginalSize() const noexcept { return originalSize; }
+
+		private:
+		ComPtr<ID2D1Bitmap> bmp = nullptr;
+		Graphics::BitmapAtlas* atlas = nullptr;
+		std::optional<AtlasEntryId> atlasId = std::nullopt;
+		std::wstring filePath;
+		Bmp::DecodedImage image;
+		SizeU decodedSize;
+		SizeU originalSize;
+
+		auto DrawFromAtlas(const Graphics::Graphics& g, RectF destRect) -> bool;
+	};
+	/**
+	* @brief Pans and zooms over a TiledImage, drawing only the tiles in view at the level that matches the zoom
+	*
+	* The downscaled image from AsyncImageDecoder is drawn underneath and shows until the tiles over it are read,
+	* tiles are read on AsyncImageDecoder's workers, up to MaxPendingTileCount at a time, and each one repaints the window as it arrives
+	*/
+	class TiledImageRenderer : public IImgRenderer
+	{
+		public:
+		static constexpr float MaxZoom = 32.0F;
+		static constexpr std::size_t MaxPendingTileCount = 16;
+		static constexpr std::size_t MaxTileBitmapCount = 96;
+
+		TiledImageRenderer(std::wstring_view filePath,
+			std::shared_ptr<Bmp::TiledImage> tiledImage, Bmp::DecodedImage overview) noexcept;
+		void Render(Core::WindowPtr<Core::DirectCompositionWindow> wnd) override;
+		[[nodiscard]] auto GetImage() const noexcept -> BmpToRender override;
+
+		/**
+		* @brief Window pixels per image pixel, fits the image in the window until zoomed
+		*/
+		[[nodiscard]] auto GetZoom(SizeF clientSize) const noexcept -> float;
+		/**
+		* @brief The image point under anchor stays where it is
+		*/
+		void ZoomAt(float factor, PointF anchor, SizeF clientSize) noexcept;
+		/**
+		* @brief delta is in window pixels
+		*/
+		void Pan(PointF delta, SizeF clientSize) noexcept;
+		void ResetView() noexcept;
+
+		[[nodiscard]] auto GetTiledImage() const noexcept -> const Bmp::TiledImage& { return *tiledImage; }
+
+		private:
+		struct TileBitmap
+		{
+			Graphics::GraphicsBitmap bitmap;
+			std::uint64_t lastFrame = 0;
+		};
+		/**
+		* @brief Only touched on the UI thread, workers post their tiles back, which drop them if the renderer is gone
+		*/
+		struct TileRequests
+		{
+			std::unordered_set<Bmp::TileKey, Bmp::TileKeyHash> pending;
+			std::unordered_map<Bmp::TileKey, std::shared_ptr<const Bmp::ImageTile>, Bmp::TileKeyHash> ready;
+			std::unordered_set<Bmp::TileKey, Bmp::TileKeyHash> failed;
+		};
+
+		std::wstring filePath;
+		std::shared_ptr<Bmp::TiledImage> tiledImage;
+		Bmp::DecodedImage overview;
+		ComPtr<ID2D1Bitmap> overviewBitmap = nullptr;
+
+		std::unordered_map<Bmp::TileKey, TileBitmap, Bmp::TileKeyHash> tileBitmaps;
+		std::shared_ptr<TileRequests> tileRequests = std::make_shared<TileRequests>();
+		std::uint64_t frame = 0;
+
+		// 0 fits the image in the window
+		float zoom = 0.0F;
+		// Image point drawn at the middle of the window
+		PointF center{ };
+
+		[[nodiscard]] auto GetFitZoom(SizeF clientSize) const noexcept -> float;
+		[[nodiscard]] auto ImageToClient(RectF imageRect, SizeF clientSize) const noexcept -> RectF;
+		void DrawOverview(const Graphics::Graphics& g, SizeF clientSize);
+		void DrawTiles(const Graphics::Graphics& g, SizeF clientSize, HWND hWnd);
+		void RequestTile(Bmp::TileKey key, HWND hWnd);
+		void TrimTileBitmaps();
+	};
+	/**
+	* @brief Composes the GIF's frames during its first loop, later loops play them back from a GifFrameCache
+	*
+	* Frames come either from WIC or from the native GifDecoder, which composes on the CPU
+	* and skips WIC's per frame metadata queries and format conversions
+	*/
 	class GifRenderer : public IImgRenderer
 	{
 		struct FrameData
@@ -56,15 +177,27 @@ namespace PGUI::UI
 
 		public:
 		explicit GifRenderer(Core::WindowPtr<Core::DirectCompositionWindow> wnd, Bmp::BitmapDecoder decoder) noexcept;
+		GifRenderer(Core::WindowPtr<Core::DirectCompositionWindow> wnd,
+			std::shared_ptr<const Bmp::GifDecoder> gifDecoder, std::wstring_view filePath);
 		void Render(Core::WindowPtr<Core::DirectCompositionWindow> wnd) noexcept override;
 		[[nodiscard]] auto GetImage() const noexcept -> BmpToRender override;
 		void OnSize(Core::CWindowPtr<Core::DirectCompositionWindow> wnd);
 
+		/**
+		* @brief The cache is dropped and recorded again from the next loop
+		*/
+		void SetFrameCacheBudget(std::size_t byteBudget);
+		[[nodiscard]] auto GetFrameCache() const noexcept -> const GifFrameCache& { return frameCache; }
+
 		private:
 		Bmp::BitmapDecoder decoder;
 		Graphics::GraphicsBitmap savedBitmap;
 		Graphics::BitmapRenderTarget composeRenderTarget;
 
+		std::optional<Bmp::GifComposer> gifComposer;
+		Graphics::GraphicsBitmap canvasBitmap;
+		std::wstring filePath;
+
 		std::vector<FrameData> frameData{ };
 
 		SizeU gifSize{ };
@@ -80,20 +213,33 @@ namespace PGUI::UI
 		std::size_t currentFrameIndex = 0;
 		std::size_t nextFrameIndex = 1;
 
+		GifFrameCache frameCache;
+		std::size_t cacheStep = 0;
+		RectF changedArea{ };
+
 		[[nodiscard]] auto IsLastFrame() const noexcept -> bool;
 		[[nodiscard]] auto EndOfAnimation() const noexcept -> bool;
 
 		//[[nodiscard]] auto CalculateDrawRect(const Core::WindowPtr<Core::Window> wnd) const -> RectF;
 
 		void ComposeFrame(Core::WindowPtr<Core::DirectCompositionWindow> wnd);
+		void PlayCachedFrame();
+		void RecordFrame(bool startsLoop);
+		void RestoreFromCache();
+		void AddChangedArea(RectF area) noexcept;
+		[[nodiscard]] auto ToPixelRect(RectF rect) const -> RectU;
 		void DisposeFrame();
 		void OverlayFrame();
 		void ClearCurrentFrameArea();
 		void SaveComposedFrame();
 		void RestoreSavedFrame() const;
 
+		void ComposeGifDecoderFrames();
+		void UploadCanvas(RectU changedRect);
+
 		void GetGlobalMetadata();
 		void GetBackgroundColor();
 		void GetFrameData();
+		void GetGifDecoderData();
 	};
 }
@@ -4,12 +4,21 @@
 #include "Dialog.hpp"
 #include "UIComponent.hpp"
 #include "Color.hpp"
+#include "ColorConversion.hpp"
 #include "Colors.hpp"
 #include "Gradient.hpp"
+#include "GradientStopCache.hpp"
 #include "Control.hpp"
+#include "ElementHost.hpp"
 #include "Brush.hpp"
+#include "BrushPool.hpp"
 #include "TextFormat.hpp"
+#include "TextFormatCache.hpp"
 #include "TextLayout.hpp"
+#include "TextLayoutCache.hpp"
+#include "TextShapingService.hpp"
+#include "TextBuffer.hpp"
+#include "TextViewport.hpp"
 #include "UIColors.hpp"
 #include "font/PGUI.ui.font.hpp"
 #include "controls/PGUI.ui.controls.hpp"
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "core/DispatcherQueue.hpp"
+#include "helpers/InlineFunction.hpp"
+#include "helpers/WorkerPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace PGUI::UI
+{
+	namespace shaping_detail
+	{
+		/**
+		* @brief Batching and delivery of TextShapingService, kept apart from DirectWrite so any shaper can run it
+		*
+		* A batch is split into one chunk per worker, the callback gets all of its results at once
+		* on the queue it was submitted for
+		* Batches finishing before that queue drains reach it with one post
+		*/
+		template <typename Request, typename Result>
+		class ShapingScheduler
+		{
+			public:
+			using Shaper = std::function<Result(const Request&)>;
+			using Callback = InlineFunction<void(std::span<Result>)>;
+
+			ShapingScheduler(Shaper _shaper, std::size_t workerCount) :
+				shaper{ std::move(_shaper) }, workers{ workerCount }
+			{
+			}
+
+			/**
+			* @brief callback runs on queue's consumer thread
+			* Once stopToken is stopped the rest of the batch isn't shaped, their results stay value initialized,
+			* and callback only runs if invokeWhenCancelled
+			* Batches not finished when the scheduler is destroyed are dropped, their callbacks never run
+			*/
+			void Submit(std::vector<Request> requests, std::stop_token stopToken,
+				std::shared_ptr<Core::DispatcherQueue> queue, Callback callback, bool invokeWhenCancelled)
+			{
+				const auto requestCount = requests.size();
+				const auto chunkCount = std::min(requestCount, workers.GetThreadCount());
+
+				auto batch = std::make_shared<Batch>(std::move(requests), std::vector<Result>(requestCount),
+					std::move(stopToken), std::move(callback), std::move(queue), invokeWhenCancelled, chunkCount);
+
+				if (chunkCount == 0)
+				{
+					Complete(std::move(batch));
+					return;
+				}
+
+				for (std::size_t chunk = 0; chunk < chunkCount; chunk++)
+				{
+					const auto first = chunk * requestCount / chunkCount;
+					const auto last = (chunk + 1) * requestCount / chunkCount;
+
+					workers.Submit([this, batch, first, last]() mutable
+					{
+						for (auto i = first; i < last && !batch->stopToken.stop_requested(); i++)
+						{
+							batch->results[i] = shaper(batch->requests[i]);
+							shapedCount.fetch_add(1, std::memory_order_relaxed);
+						}
+
+						if (batch->remainingChunks.fetch_sub(1, std::memory_order_acq_rel) == 1)
+						{
+							Complete(std::move(batch));
+						}
+					});
+				}
+			}
+
+			[[nodiscard]] auto GetThreadCount() const noexcept { return workers.GetThreadCount(); }
+			/**
+			* @brief Requests shaped so far, cancelled ones don't count
+			*/
+			[[nodiscard]] auto GetShapedCount() const noexcept { return shapedCount.load(std::memory_order_relaxed); }
+			/**
+			* @brief Posts made to deliver results, less than the batch count when they arrive together
+			*/
+			[[nodiscard]] auto GetPostCount() const noexcept { return postCount.load(std::memory_order_relaxed); }
+
+			private:
+			struct Batch
+			{
+				std::vector<Request> requests;
+				std::vector<Result> results;
+				std::stop_token stopToken;
+				Callback callback;
+				std::shared_ptr<Core::DispatcherQueue> queue;
+				bool invokeWhenCancelled;
+				std::atomic_size_t remainingChunks;
+			};
+
+			Shaper shaper;
+
+			std::mutex completedMutex;
+			std::unordered_map<Core::DispatcherQueue*, std::vector<std::shared_ptr<Batch>>> completed;
+
+			std::atomic_uint64_t shapedCount = 0;
+			std::atomic_uint64_t postCount = 0;
+
+			// Last so it's joined before anything its tasks use is destroyed
+			WorkerPool workers;
+
+			void Complete(std::shared_ptr<Batch> batch)
+			{
+				auto queue = batch->queue;
+
+				bool isFirstInBatch = false;
+				{
+					std::scoped_lock lock{ completedMutex };
+
+					auto& delivery = completed[queue.get()];
+					isFirstInBatch = delivery.empty();
+					delivery.push_back(std::move(batch));
+				}
+
+				// Batches finishing before the queue gets to Deliver go with the same post
+				if (isFirstInBatch)
+				{
+					postCount.fetch_add(1, std::memory_order_relaxed);
+					queue->Post([this, queuePtr = queue.get()]
+					{
+						Deliver(queuePtr);
+					}, Core::DispatcherPriority::Render);
+				}
+			}
+
+			void Deliver(Core::DispatcherQueue* queue)
+			{
+				std::vector<std::shared_ptr<Batch>> delivery;
+				{
+					std::scoped_lock lock{ completedMutex };
+
+					auto iter = completed.find(queue);
+					if (iter == completed.end())
+					{
+						return;
+					}
+					delivery = std::move(iter->second);
+					completed.erase(iter);
+				}
+
+				for (const auto& batch : delivery)
+				{
+					if (batch->stopToken.stop_requested() && !batch->invokeWhenCancelled)
+					{
+						continue;
+					}
+
+					batch->callback(batch->results);
+				}
+			}
+		};
+	}
+}
@@ -0,0 +1,254 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace PGUI::UI
+{
+	/**
+	* @brief Piece table text document, headless so anything can keep text in it
+	*
+	* The text is a sequence of pieces viewing the original text and append only add blocks,
+	* kept by position in a balanced tree where every node also sums its subtree's length and line breaks
+	* So inserting, erasing and going between positions and lines are O(log n) in the piece count,
+	* and pieces are kept short so cutting one is bounded work
+	* Edits are recorded as the pieces they took out and put in, undo and redo move pieces and never copy text
+	* Not thread safe
+	*/
+	class TextBuffer
+	{
+		public:
+		static constexpr std::size_t MaxPieceLength = 16ULL * 1024;
+		static constexpr std::size_t AddBlockLength = 64ULL * 1024;
+		static constexpr std::size_t DefaultUndoLimit = 100;
+		static constexpr auto NotFound = std::wstring_view::npos;
+
+		explicit TextBuffer(wchar_t lineBreak = L'\n');
+		explicit TextBuffer(std::wstring text, wchar_t lineBreak = L'\n');
+
+		TextBuffer(const TextBuffer&) = delete;
+		auto operator=(const TextBuffer&) -> TextBuffer& = delete;
+		TextBuffer(TextBuffer&&) = delete;
+		auto operator=(TextBuffer&&) -> TextBuffer& = delete;
+
+		/**
+		* @brief Replaces the whole text and forgets the undo history
+		*/
+		void Assign(std::wstring text);
+
+		/**
+		* @brief Positions past the end are clamped to it
+		*/
+		void Insert(std::size_t position, std::wstring_view text);
+		void Erase(std::size_t position, std::size_t length);
+		/**
+		* @brief Erase and Insert as one undo step
+		*/
+		void Replace(std::size_t position, std::size_t length, std::wstring_view text);
+
+		[[nodiscard]] auto GetLength() const noexcept -> std::size_t;
+		[[nodiscard]] auto IsEmpty() const noexcept { return GetLength() == 0; }
+		[[nodiscard]] auto GetLineBreak() const noexcept { return lineBreak; }
+
+		[[nodiscard]] auto GetChar(std::size_t position) const noexcept -> wchar_t;
+		[[nodiscard]] auto GetText() const -> std::wstring;
+		[[nodiscard]] auto GetText(std::size_t position, std::size_t length) const -> std::wstring;
+
+		/**
+		* @brief Calls visitor with views of the text from position in order, straight out of the pieces
+		*
+		* Nothing is copied, the views are only valid until the next edit
+		* A visitor returning bool stops the visit by returning false
+		*/
+		template <typename Visitor>
+		void VisitText(std::size_t position, std::size_t length, Visitor&& visitor) const
+		{
+			position = std::min(position, GetLength());
+			length = std::min(length, GetLength() - position);
+
+			std::ignore = VisitPieces(root, position, length, 0, visitor);
+		}
+
+		/**
+		* @brief Changes with every edit, undo and redo, so readers can tell if what they read is still current
+		*/
+		[[nodiscard]] auto GetVersion() const noexcept { return version; }
+
+		/**
+		* @brief First occurrence of text starting from position and ending by end, matches may span pieces
+		* @return NotFound if there's none or text is empty
+		*/
+		[[nodiscard]] auto Find(std::wstring_view text, std::size_t position = 0, std::size_t end = NotFound) const
+			-> std::size_t;
+
+		/**
+		* @brief Line breaks plus one, an empty text has one empty line
+		*/
+		[[nodiscard]] auto GetLineCount() const noexcept -> std::size_t;
+		[[nodiscard]] auto GetLineFromPosition(std::size_t position) const noexcept -> std::size_t;
+		/**
+		* @brief Lines past the last start at the end
+		*/
+		[[nodiscard]] auto GetLineStart(std::size_t line) const noexcept -> std::size_t;
+		/**
+		* @brief Without its line break
+		*/
+		[[nodiscard]] auto GetLineLength(std::size_t line) const noexcept -> std::size_t;
+		[[nodiscard]] auto GetLine(std::size_t line) const -> std::wstring;
+
+		/**
+		* @brief Edits until the matching EndUndoGroup undo together, groups nest
+		*/
+		void BeginUndoGroup() noexcept;
+		void EndUndoGroup() noexcept;
+		/**
+		* @brief Consecutive inserts each continuing the last undo together, this makes the next one start a new step
+		*/
+		void StopGroupTyping() noexcept;
+
+		[[nodiscard]] auto CanUndo() const noexcept { return !undoStack.empty() && groupDepth == 0; }
+		[[nodiscard]] auto CanRedo() const noexcept { return !redoStack.empty() && groupDepth == 0; }
+		auto Undo() -> bool;
+		auto Redo() -> bool;
+		void ClearUndo() noexcept;
+
+		[[nodiscard]] auto GetUndoLimit() const noexcept { return undoLimit; }
+		/**
+		* @brief Oldest steps past the limit are forgotten, 0 records nothing
+		*/
+		void SetUndoLimit(std::size_t undoLimit);
+
+		[[nodiscard]] auto GetPieceCount() const noexcept -> std::size_t;
+
+		private:
+		using NodeIndex = std::uint32_t;
+		static constexpr NodeIndex Nil = 0;
+
+		struct Piece
+		{
+			const wchar_t* data = nullptr;
+			std::uint32_t length = 0;
+			std::uint32_t lineBreaks = 0;
+		};
+
+		struct Node
+		{
+			Piece piece;
+			NodeIndex left = Nil;
+			NodeIndex right = Nil;
+			std::uint32_t priority = 0;
+			std::size_t subtreeLength = 0;
+			std::size_t subtreeLineBreaks = 0;
+		};
+
+		struct UndoEdit
+		{
+			std::size_t position = 0;
+			std::size_t erasedLength = 0;
+			std::size_t insertedLength = 0;
+			std::vector<Piece> erased;
+			std::vector<Piece> inserted;
+		};
+		using UndoGroup = std::vector<UndoEdit>;
+
+		wchar_t lineBreak;
+
+		std::wstring original;
+		// Never reallocated, so pieces can point into them
+		std::vector<std::unique_ptr<wchar_t[]>> addBlocks;
+		std::size_t addBlockUsed = AddBlockLength;
+
+		// nodes[Nil] is an empty sentinel so subtree sums need no checks
+		std::vector<Node> nodes;
+		std::vector<NodeIndex> freeNodes;
+		NodeIndex root = Nil;
+		std::uint32_t seed = 0x9E3779B9U;
+		std::uint64_t version = 0;
+
+		std::deque<UndoGroup> undoStack;
+		std::deque<UndoGroup> redoStack;
+		std::size_t undoLimit = DefaultUndoLimit;
+		std::size_t groupDepth = 0;
+		bool isGroupOpen = false;
+		bool isTyping = false;
+		std::size_t typingEnd = 0;
+
+		[[nodiscard]] auto MakePiece(const wchar_t* data, std::size_t length) const noexcept -> Piece;
+		[[nodiscard]] auto CountLineBreaks(const wchar_t* data, std::size_t length) const noexcept -> std::size_t;
+		[[nodiscard]] auto AppendToAddBlocks(std::wstring_view text) -> std::vector<Piece>;
+
+		[[nodiscard]] auto NewNode(const Piece& piece) -> NodeIndex;
+		void FreeSubtree(NodeIndex node, std::vector<Piece>& pieces);
+		void Update(NodeIndex node) noexcept;
+		[[nodiscard]] auto Merge(NodeIndex left, NodeIndex right) noexcept -> NodeIndex;
+		[[nodiscard]] auto Split(NodeIndex node, std::size_t position) -> std::pair<NodeIndex, NodeIndex>;
+		[[nodiscard]] auto Build(std::span<const Piece> pieces) -> NodeIndex;
+		[[nodiscard]] auto ExtendPieceEndingAt(NodeIndex node, std::size_t position, const Piece& piece) noexcept
+			-> bool;
+
+		void InsertPieces(std::size_t position, std::span<const Piece> pieces);
+		[[nodiscard]] auto ErasePieces(std::size_t position, std::size_t length) -> std::vector<Piece>;
+
+		template <typename Visitor>
+		auto VisitPieces(NodeIndex node, std::size_t position, std::size_t length, std::size_t nodeStart,
+			Visitor& visitor) const -> bool;
+
+		void Record(UndoEdit edit, bool isTypingInsert);
+		void TrimUndo() noexcept;
+	};
+
+	template <typename Visitor>
+	auto TextBuffer::VisitPieces(NodeIndex node, std::size_t position, std::size_t length, std::size_t nodeStart,
+		Visitor& visitor) const -> bool
+	{
+		if (node == Nil || length == 0)
+		{
+			return true;
+		}
+
+		const auto& current = nodes[node];
+		const auto pieceStart = nodeStart + nodes[current.left].subtreeLength;
+		const auto pieceEnd = pieceStart + current.piece.length;
+		const auto end = position + length;
+
+		if (position < pieceStart && !VisitPieces(current.left, position, length, nodeStart, visitor))
+		{
+			return false;
+		}
+		if (position < pieceEnd && end > pieceStart)
+		{
+			const auto first = std::max(position, pieceStart);
+			const auto last = std::min(end, pieceEnd);
+			const std::wstring_view text{ current.piece.data + (first - pieceStart), last - first };
+
+			if constexpr (std::is_same_v<std::invoke_result_t<Visitor&, std::wstring_view>, bool>)
+			{
+				if (!visitor(text))
+				{
+					return false;
+				}
+			}
+			else
+			{
+				visitor(text);
+			}
+		}
+		if (end > pieceEnd)
+		{
+			return VisitPieces(current.right, position, length, pieceEnd, visitor);
+		}
+
+		return true;
+	}
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "helpers/ComPtr.hpp"
 #include "helpers/HelperFunctions.hpp"
 #include "ui/font/FontCollection.hpp"
 #include "ui/font/FontEnums.hpp"
@@ -12,12 +13,50 @@
 
 namespace PGUI::UI
 {
+	/**
+	* @brief Everything a TextFormat is made from, defaults are DirectWrite's
+	*/
+	struct TextFormatDescriptor
+	{
+		std::wstring fontFamilyName;
+		FLOAT fontSize = 16.0F;
+		std::wstring localeName;
+		/**
+		* @brief nullopt is the system font collection
+		*/
+		std::optional<Font::FontCollection> fontCollection;
+		Font::FontWeight fontWeight = Font::FontWeights::Medium;
+		Font::FontStyle fontStyle = Font::FontStyles::Normal;
+		Font::FontStretch fontStretch = Font::FontStretches::Normal;
+
+		Font::FlowDirection flowDirection = DWRITE_FLOW_DIRECTION_TOP_TO_BOTTOM;
+		Font::ParagraphAlignment paragraphAlignment = DWRITE_PARAGRAPH_ALIGNMENT_NEAR;
+		Font::ReadingDirection readingDirection = DWRITE_READING_DIRECTION_LEFT_TO_RIGHT;
+		Font::TextAlignment textAlignment = DWRITE_TEXT_ALIGNMENT_LEADING;
+		Font::WordWrapping wordWrapping = DWRITE_WORD_WRAPPING_WRAP;
+		/**
+		* @brief 0 keeps the default of four times the font size
+		*/
+		float incrementalTabStop = 0.0F;
+		DWRITE_LINE_SPACING lineSpacing{ };
+		DWRITE_TRIMMING trimming{ };
+		ComPtr<IDWriteInlineObject> trimmingSign;
+	};
+
 	class TextFormat : public ComPtrHolder<IDWriteTextFormat3>
 	{
 		public:
+		/**
+		* @brief Interned through TextFormatCache, the format is shared so it mustn't be changed with the setters
+		*/
 		[[nodiscard]] static auto GetDefTextFormat(FLOAT fontSize = 16) -> TextFormat;
+		[[nodiscard]] static auto GetDefTextFormatDescriptor(FLOAT fontSize = 16) -> TextFormatDescriptor;
 
 		TextFormat() noexcept = default;
+		/**
+		* @brief A new format nothing else shares
+		*/
+		explicit TextFormat(const TextFormatDescriptor& descriptor) noexcept;
 		TextFormat(std::wstring_view fontFamilyName, 
 			FLOAT fontSize, std::wstring_view localeName,
 			const std::optional<Font::FontCollection>& fontCollection = std::nullopt,
@@ -25,8 +64,13 @@ namespace PGUI::UI
 			Font::FontStyle fontStyle = Font::FontStyles::Normal,
 			Font::FontStretch fontStretch = Font::FontStretches::Normal) noexcept;
 
+		/**
+		* @brief Same format with another font size, interned like GetDefTextFormat
+		*/
 		[[nodiscard]] auto AdjustFontSizeToDPI(float fontSize) const noexcept -> TextFormat;
 
+		[[nodiscard]] auto GetDescriptor() const -> TextFormatDescriptor;
+
 		[[nodiscard]] auto GetFlowDirection() const noexcept -> Font::FlowDirection;
 		void SetFlowDirection(Font::FlowDirection flowDirection) const noexcept;
 		
@@ -53,7 +97,7 @@ namespace PGUI::UI
 		[[nodiscard]] auto GetReadingDirection() const noexcept -> Font::ReadingDirection;
 		void SetReadingDirection(Font::ReadingDirection readingDirection) const noexcept;
 
-		[[nodiscard]] static auto GetTextAlignment() noexcept -> Font::TextAlignment;
+		[[nodiscard]] auto GetTextAlignment() const noexcept -> Font::TextAlignment;
 		void SetTextAlignment(Font::TextAlignment textAlignment) const noexcept;
 
 		[[nodiscard]] auto
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "ui/TextFormat.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+
+namespace PGUI::UI
+{
+	/**
+	* @brief Interns text formats, every Get with an equal descriptor returns the same IDWriteTextFormat3
+	*
+	* Formats from the cache are shared, they mustn't be changed with TextFormat's setters,
+	* change a copy of the descriptor and Get that instead
+	* Thread safe, so layout can be done off the UI thread
+	*/
+	class TextFormatCache
+	{
+		public:
+		static constexpr std::size_t DefaultCapacity = 64;
+
+		[[nodiscard]] static auto GetInstance() -> TextFormatCache&;
+
+		explicit TextFormatCache(std::size_t capacity = DefaultCapacity) noexcept;
+
+		[[nodiscard]] auto Get(const TextFormatDescriptor& descriptor) -> TextFormat;
+		/**
+		* @brief The cached format with textFormat's descriptor, so later changes to textFormat don't reach it
+		*
+		* Controls keep the interned format, a null one stays null
+		* If the cache can't make it the failure is logged and textFormat is returned
+		*/
+		[[nodiscard]] auto Intern(const TextFormat& textFormat) noexcept -> TextFormat;
+
+		void Clear() noexcept;
+
+		[[nodiscard]] auto GetCapacity() const noexcept -> std::size_t;
+		/**
+		* @brief Least recently used formats are dropped to fit, TextFormats and layouts using them keep them alive
+		*/
+		void SetCapacity(std::size_t capacity);
+		[[nodiscard]] auto GetCount() const noexcept -> std::size_t;
+		[[nodiscard]] auto GetHitCount() const noexcept -> std::uint64_t;
+		[[nodiscard]] auto GetMissCount() const noexcept -> std::uint64_t;
+		[[nodiscard]] auto GetEvictionCount() const noexcept -> std::uint64_t;
+
+		private:
+		struct Entry
+		{
+			TextFormatDescriptor descriptor;
+			TextFormat textFormat;
+		};
+		using EntryList = std::list<Entry>;
+
+		struct Key
+		{
+			const TextFormatDescriptor* descriptor;
+			std::size_t hash;
+		};
+		struct KeyHash
+		{
+			[[nodiscard]] auto operator()(const Key& key) const noexcept -> std::size_t { return key.hash; }
+		};
+		struct KeyEqual
+		{
+			[[nodiscard]] auto operator()(const Key& left, const Key& right) const noexcept -> bool;
+		};
+
+		mutable std::mutex mutex;
+		std::size_t capacity;
+		// Most recently used first, keys view the descriptors stored here
+		EntryList lru;
+		std::unordered_map<Key, EntryList::iterator, KeyHash, KeyEqual> entries;
+
+		std::uint64_t hitCount = 0;
+		std::uint64_t missCount = 0;
+		std::uint64_t evictionCount = 0;
+
+		[[nodiscard]] static auto MakeKey(const TextFormatDescriptor& descriptor) noexcept -> Key;
+		void Trim(std::size_t count) noexcept;
+	};
+}
@@ -58,6 +58,10 @@ namespace PGUI::UI
 		void SetMaxWidth(float maxHeight) const noexcept;
 
 		[[nodiscard]] auto GetClusterMetrics() const noexcept -> std::vector<DWRITE_CLUSTER_METRICS>;
+		/**
+		* @brief Number of glyph clusters, without copying their metrics
+		*/
+		[[nodiscard]] auto GetClusterCount() const noexcept -> UINT32;
 		[[nodiscard]] auto GetLineMetrics() const noexcept -> std::vector<DWRITE_LINE_METRICS1>;
 
 		[[nodiscard]] auto GetMetrics() const noexcept -> DWRITE_TEXT_METRICS1;
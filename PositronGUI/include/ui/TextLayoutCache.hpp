@@ -0,0 +1,133 @@
+#pragma once
+
+#include "core/Point.hpp"
+#include "core/Rect.hpp"
+#include "core/Size.hpp"
+#include "ui/TextFormat.hpp"
+#include "ui/TextLayout.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+
+namespace PGUI::UI
+{
+	/**
+	* @brief Shaped text layouts, shared by everything drawing the same text with the same format
+	*
+	* A layout made for one box is reused for another whenever that can't change its line breaks,
+	* it's then drawn moved by as much as its alignment would've moved the lines
+	* So resizing a label only shapes its text again once it wraps differently
+	* Layouts from the cache are shared, they mustn't be changed, neither may a format after it's used here,
+	* layouts are keyed on the format object, controls pass formats through TextFormatCache::Intern for that
+	* Least recently used layouts are dropped once their glyphs go over the budget
+	* Thread safe
+	*/
+	class TextLayoutCache
+	{
+		public:
+		struct PlacedTextLayout
+		{
+			TextLayout textLayout;
+			/**
+			* @brief Added to the origin the layout is drawn at
+			*/
+			PointF offset{ };
+
+			[[nodiscard]] auto GetBoundingRect() const noexcept -> RectF
+			{
+				return textLayout.GetBoundingRect().Shifted(offset.x, offset.y);
+			}
+		};
+
+		static constexpr std::size_t DefaultGlyphBudget = 64ULL * 1024;
+
+		[[nodiscard]] static auto GetInstance() -> TextLayoutCache&;
+
+		explicit TextLayoutCache(std::size_t glyphBudget = DefaultGlyphBudget) noexcept;
+
+		[[nodiscard]] auto Get(std::wstring_view text, const TextFormat& textFormat, SizeF maxSize) -> PlacedTextLayout;
+
+		void Clear() noexcept;
+
+		[[nodiscard]] auto GetGlyphBudget() const noexcept -> std::size_t;
+		/**
+		* @brief Least recently used layouts are dropped to fit, whoever still draws them keeps them alive
+		*/
+		void SetGlyphBudget(std::size_t glyphBudget);
+		/**
+		* @brief Glyph clusters of every cached layout
+		*/
+		[[nodiscard]] auto GetGlyphCount() const noexcept -> std::size_t;
+		[[nodiscard]] auto GetCount() const noexcept -> std::size_t;
+		/**
+		* @brief Layouts handed out without shaping, reused for another box size included
+		*/
+		[[nodiscard]] auto GetHitCount() const noexcept -> std::uint64_t;
+		[[nodiscard]] auto GetMissCount() const noexcept -> std::uint64_t;
+		[[nodiscard]] auto GetEvictionCount() const noexcept -> std::uint64_t;
+
+		private:
+		struct Entry
+		{
+			std::wstring text;
+			TextFormat textFormat;
+			TextLayout textLayout;
+			SizeF maxSize;
+			/**
+			* @brief How far the lines move per unit the box grows, nullopt if only the same size can reuse it
+			*/
+			std::optional<PointF> alignment;
+			// Widths the line breaks stay the same for, the height doesn't break lines
+			float minWidth = 0.0F;
+			float maxWidth = 0.0F;
+			std::size_t glyphCount = 0;
+			std::size_t hash = 0;
+
+			[[nodiscard]] auto Place(SizeF size) const noexcept -> std::optional<PlacedTextLayout>;
+		};
+		using EntryList = std::list<Entry>;
+
+		struct Key
+		{
+			std::wstring_view text;
+			IDWriteTextFormat3* textFormat;
+			std::size_t hash;
+		};
+		struct KeyHash
+		{
+			[[nodiscard]] auto operator()(const Key& key) const noexcept -> std::size_t { return key.hash; }
+		};
+		struct KeyEqual
+		{
+			[[nodiscard]] auto operator()(const Key& left, const Key& right) const noexcept -> bool
+			{
+				return left.hash == right.hash && left.textFormat == right.textFormat && left.text == right.text;
+			}
+		};
+
+		mutable std::mutex mutex;
+		std::size_t glyphBudget;
+		std::size_t glyphCount = 0;
+		// Most recently used first, keys view the text stored here
+		EntryList lru;
+		// Every size a text was laid out for with a format
+		std::unordered_multimap<Key, EntryList::iterator, KeyHash, KeyEqual> entries;
+
+		std::uint64_t hitCount = 0;
+		std::uint64_t missCount = 0;
+		std::uint64_t evictionCount = 0;
+
+		[[nodiscard]] static auto MakeKey(std::wstring_view text, const TextFormat& textFormat) noexcept -> Key;
+		[[nodiscard]] static auto CreateEntry(std::wstring_view text,
+			const TextFormat& textFormat, SizeF maxSize, std::size_t hash) -> Entry;
+		[[nodiscard]] auto Find(const Key& key, SizeF maxSize) -> std::optional<PlacedTextLayout>;
+		void Trim(std::size_t count) noexcept;
+	};
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "core/Size.hpp"
+#include "helpers/InlineFunction.hpp"
+#include "helpers/WorkerPool.hpp"
+#include "ui/ShapingScheduler.hpp"
+#include "ui/TextFormat.hpp"
+#include "ui/TextLayoutCache.hpp"
+
+#include <coroutine>
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <utility>
+#include <vector>
+#include <dwrite_3.h>
+
+
+namespace PGUI::UI
+{
+	struct TextShapingRequest
+	{
+		std::wstring text;
+		TextFormat textFormat;
+		SizeF maxSize{ };
+	};
+
+	/**
+	* @brief A shaped layout and its metrics, E_PENDING if it was cancelled before being shaped
+	*
+	* The layout comes from TextLayoutCache, so a control asking the cache for the same text later gets it
+	* without shaping, and like everything from there it mustn't be changed
+	* Metrics are in the layout's own coordinates, before the offset
+	*/
+	struct ShapedText
+	{
+		HRESULT hr = E_PENDING;
+		TextLayoutCache::PlacedTextLayout layout;
+		DWRITE_TEXT_METRICS1 metrics{ };
+		std::vector<DWRITE_LINE_METRICS1> lineMetrics;
+		std::vector<DWRITE_CLUSTER_METRICS> clusterMetrics;
+
+		[[nodiscard]] auto Succeeded() const noexcept { return SUCCEEDED(hr); }
+	};
+
+	/**
+	* @brief Shapes and measures batches of text on a worker pool, off the UI thread
+	*
+	* DirectWrite's shared factory is thread safe, layouts made on a worker are handed to the requesting thread
+	* through its Dispatcher and drawn there
+	*/
+	class TextShapingService
+	{
+		public:
+		using Callback = InlineFunction<void(std::span<ShapedText>)>;
+
+		class ShapeAwaiter
+		{
+			public:
+			ShapeAwaiter(TextShapingService& service,
+				std::vector<TextShapingRequest> requests, std::stop_token stopToken) noexcept :
+				service{ &service }, requests{ std::move(requests) }, stopToken{ std::move(stopToken) }
+			{
+			}
+
+			[[nodiscard]] auto await_ready() const noexcept -> bool { return false; }
+			void await_suspend(std::coroutine_handle<> handle)
+			{
+				service->Submit(std::move(requests), std::move(stopToken), [this, handle](std::span<ShapedText> shaped)
+				{
+					results.assign(std::make_move_iterator(shaped.begin()), std::make_move_iterator(shaped.end()));
+					handle.resume();
+				}, true);
+			}
+			[[nodiscard]] auto await_resume() noexcept -> std::vector<ShapedText> { return std::move(results); }
+
+			private:
+			TextShapingService* service;
+			std::vector<TextShapingRequest> requests;
+			std::stop_token stopToken;
+			std::vector<ShapedText> results;
+		};
+
+		/**
+		* @brief Process wide instance
+		*/
+		[[nodiscard]] static auto GetInstance() -> TextShapingService&;
+
+		explicit TextShapingService(std::size_t workerCount = WorkerPool::DefaultThreadCount());
+
+		/**
+		* @brief callback gets the results in request order on the calling thread, which needs a Dispatcher
+		* It doesn't run at all if stopToken is stopped before it would
+		*/
+		void ShapeAsync(std::vector<TextShapingRequest> requests, std::stop_token stopToken, Callback callback)
+		{
+			Submit(std::move(requests), std::move(stopToken), std::move(callback), false);
+		}
+		/**
+		* @brief co_await service.Shape(requests) resumes on the calling thread,
+		* with the requests not shaped before stopToken was stopped left E_PENDING
+		*/
+		[[nodiscard]] auto Shape(std::vector<TextShapingRequest> requests, std::stop_token stopToken = { }) noexcept
+			-> ShapeAwaiter
+		{
+			return ShapeAwaiter{ *this, std::move(requests), std::move(stopToken) };
+		}
+
+		/**
+		* @brief Shapes on the calling thread
+		*/
+		[[nodiscard]] static auto ShapeText(const TextShapingRequest& request) -> ShapedText;
+
+		[[nodiscard]] auto GetShapedCount() const noexcept { return scheduler.GetShapedCount(); }
+
+		private:
+		shaping_detail::ShapingScheduler<TextShapingRequest, ShapedText> scheduler;
+
+		void Submit(std::vector<TextShapingRequest> requests, std::stop_token stopToken,
+			Callback callback, bool invokeWhenCancelled);
+	};
+}
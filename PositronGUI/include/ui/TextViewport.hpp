@@ -0,0 +1,108 @@
+#pragma once
+
+#include "core/Point.hpp"
+#include "core/Size.hpp"
+#include "graphics/Graphics.hpp"
+#include "ui/Brush.hpp"
+#include "ui/TextBuffer.hpp"
+#include "ui/TextFormat.hpp"
+#include "ui/TextLayoutCache.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+
+namespace PGUI::UI
+{
+	struct TextViewportFrameStats
+	{
+		std::chrono::steady_clock::duration layoutTime{ };
+		std::chrono::steady_clock::duration drawTime{ };
+		std::size_t firstVisibleLine = 0;
+		std::size_t visibleLineCount = 0;
+		/**
+		* @brief Visible and overscan lines laid out for the frame
+		*/
+		std::size_t realizedLineCount = 0;
+		/**
+		* @brief Realized lines the layout cache didn't have, the rest weren't shaped again
+		*/
+		std::size_t shapedLineCount = 0;
+	};
+
+	/**
+	* @brief Draws a TextBuffer a line per layout, only laying out the lines in view and a few either side of them
+	*
+	* Lines are a fixed height apart, so the ones in view come from the scroll position
+	* and the document's line index, and a frame costs the same however many lines the document has
+	* Layouts come from TextLayoutCache, lines that didn't change since they were last drawn aren't shaped again
+	* The document must outlive the viewport
+	*/
+	class TextViewport
+	{
+		public:
+		using Clock = std::chrono::steady_clock;
+
+		static constexpr std::size_t DefaultOverscan = 4;
+
+		explicit TextViewport(const TextBuffer& document) noexcept;
+
+		[[nodiscard]] auto GetTextFormat() const noexcept -> const TextFormat& { return textFormat; }
+		/**
+		* @brief Lines are as tall as a line of this format, it shouldn't wrap
+		*/
+		void SetTextFormat(const TextFormat& textFormat);
+
+		[[nodiscard]] auto GetLineHeight() const noexcept { return lineHeight; }
+		/**
+		* @brief Replaces the height SetTextFormat measured, for lines that have to sit where another renderer puts them
+		*/
+		void SetLineHeight(float _lineHeight) noexcept { lineHeight = _lineHeight; }
+		[[nodiscard]] auto GetOverscan() const noexcept { return overscan; }
+		void SetOverscan(std::size_t _overscan) noexcept { overscan = _overscan; }
+
+		// Doubles since a few million lines down is past where floats count single pixels
+		[[nodiscard]] auto GetContentHeight() const noexcept -> double;
+		[[nodiscard]] auto GetLineFromY(double y) const noexcept -> std::size_t;
+		[[nodiscard]] auto GetFirstVisibleLine() const noexcept { return frameStats.firstVisibleLine; }
+
+		/**
+		* @brief Lays out the lines overlapping viewSize scrolled by scroll, and the overscan around them
+		*/
+		void Layout(PointL scroll, SizeF viewSize);
+		/**
+		* @brief Draws what the last Layout laid out, the view's top left corner at origin
+		*/
+		void Draw(Graphics::Graphics g, PointF origin, const Brush& textBrush);
+		/**
+		* @brief Highlights the characters from first up to last on the visible lines
+		*/
+		void DrawSelection(Graphics::Graphics g, PointF origin,
+			std::size_t first, std::size_t last, const Brush& selectionBrush) const;
+
+		[[nodiscard]] auto GetFrameStats() const noexcept -> const TextViewportFrameStats& { return frameStats; }
+
+		private:
+		struct RealizedLine
+		{
+			std::size_t start = 0;
+			std::size_t length = 0;
+			TextLayoutCache::PlacedTextLayout layout;
+		};
+
+		const TextBuffer* document;
+		TextFormat textFormat;
+		float lineHeight = 0.0F;
+		std::size_t overscan = DefaultOverscan;
+
+		PointL scroll;
+		std::size_t firstRealizedLine = 0;
+		std::vector<RealizedLine> realizedLines;
+
+		TextViewportFrameStats frameStats;
+
+		[[nodiscard]] auto GetLineOrigin(std::size_t line, PointF origin) const noexcept -> PointF;
+		[[nodiscard]] auto IsVisible(std::size_t line) const noexcept -> bool;
+	};
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "helpers/ComPtr.hpp"
+#include "core/Event.hpp"
 #include "ui/Color.hpp"
 
 #include <memory>
@@ -10,6 +11,31 @@
 
 namespace PGUI::UI
 {
+	/**
+	* @brief Everything UIColors reports, as read at one point in time
+	*/
+	struct ThemeColors
+	{
+		RGBA foreground;
+		RGBA background;
+		RGBA accent;
+		RGBA accentDark1;
+		RGBA accentDark2;
+		RGBA accentDark3;
+		RGBA accentLight1;
+		RGBA accentLight2;
+		RGBA accentLight3;
+		bool isDarkMode = false;
+
+		[[nodiscard]] auto operator==(const ThemeColors& other) const noexcept -> bool = default;
+	};
+
+	/**
+	* @brief System colors and light or dark mode, read once and kept until Windows reports a change
+	*
+	* Changes come from UISettings.ColorValuesChanged and from the WM_SETTINGCHANGE top level windows forward to OnSettingChange,
+	* both notifications of one change raise ThemeChangedEvent once
+	*/
 	class UIColors
 	{
 		public:
@@ -31,6 +57,20 @@ namespace PGUI::UI
 		[[nodiscard]] static auto IsDarkMode() noexcept -> bool;
 		[[nodiscard]] static auto IsLightMode() noexcept -> bool;
 
+		[[nodiscard]] static auto GetTheme() noexcept -> ThemeColors;
+		/**
+		* @brief Reads the theme again, raises ThemeChangedEvent and returns true if it changed
+		*/
+		static auto Refresh() -> bool;
+		/**
+		* @brief For the WM_SETTINGCHANGE of top level windows, refreshes when the color settings changed
+		*/
+		static void OnSettingChange(LPARAM lParam);
+		/**
+		* @brief Raised on the thread that noticed the change, subscribe with EventDelivery::UIThread to re-theme controls
+		*/
+		[[nodiscard]] static auto ThemeChangedEvent() noexcept -> Core::Event<>&;
+
 		protected:
 		UIColors() = default;
 
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "core/Size.hpp"
+#include "core/DispatcherQueue.hpp"
+#include "helpers/InlineFunction.hpp"
+#include "helpers/WorkerPool.hpp"
+#include "ui/bmp/GifDecoder.hpp"
+#include "ui/bmp/TiledImage.hpp"
+
+#include <coroutine>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <wincodec.h>
+
+
+namespace PGUI::UI::Bmp
+{
+	/**
+	* @brief 32bppPBGRA pixels ready to be uploaded with Graphics::CreateBitmap
+	*/
+	struct DecodedImage
+	{
+		SizeU size{ };
+		SizeU originalSize{ };
+		UINT frameCount = 0;
+		UINT stride = 0;
+		std::vector<BYTE> pixels;
+
+		/**
+		* @brief Animated images requested with openAnimation, the parsed GIF
+		* or the file's bytes for WIC when the native decoder can't read it
+		*/
+		std::shared_ptr<const GifDecoder> gifDecoder;
+		std::vector<std::byte> encodedFile;
+		/**
+		* @brief Still images requested with openTiled, nullptr if the file couldn't be opened that way
+		*/
+		std::shared_ptr<TiledImage> tiledImage;
+	};
+
+	struct DecodeResult
+	{
+		HRESULT hr = E_PENDING;
+		DecodedImage image;
+
+		[[nodiscard]] auto Succeeded() const noexcept { return SUCCEEDED(hr); }
+		[[nodiscard]] auto IsCancelled() const noexcept { return hr == HRESULT_FROM_WIN32(ERROR_CANCELLED); }
+	};
+
+	struct DecodeRequest
+	{
+		std::wstring filePath;
+		/**
+		* @brief The image is scaled down to fit inside this size during decode, keeping its aspect ratio
+		* It's never scaled up
+		*/
+		std::optional<SizeU> targetSize = std::nullopt;
+		UINT frameIndex = 0;
+		/**
+		* @brief Animated images are also opened for playback on the worker, see DecodedImage::gifDecoder
+		*/
+		bool openAnimation = false;
+		/**
+		* @brief Still images are also opened as a TiledImage on the worker, its tiles have to be read through Run
+		*/
+		bool openTiled = false;
+	};
+
+	/**
+	* @brief Decodes images on a worker pool and hands the results back to the requesting thread
+	*
+	* Codecs that support IWICBitmapSourceTransform (JPEG for one) scale while decoding,
+	* a high quality scaler takes care of the rest
+	* Results finishing close together reach the UI thread as one batch through its Dispatcher
+	*/
+	class AsyncImageDecoder
+	{
+		public:
+		using Callback = InlineFunction<void(DecodeResult&)>;
+		using Work = InlineFunction<void(IWICImagingFactory*)>;
+
+		class DecodeAwaiter
+		{
+			public:
+			DecodeAwaiter(AsyncImageDecoder& decoder, DecodeRequest request, std::stop_token stopToken) noexcept :
+				decoder{ &decoder }, request{ std::move(request) }, stopToken{ std::move(stopToken) }
+			{
+			}
+
+			[[nodiscard]] auto await_ready() const noexcept -> bool { return false; }
+			void await_suspend(std::coroutine_handle<> handle)
+			{
+				decoder->Submit(std::move(request), std::move(stopToken), [this, handle](DecodeResult& decodeResult)
+				{
+					result = std::move(decodeResult);
+					handle.resume();
+				}, true);
+			}
+			[[nodiscard]] auto await_resume() noexcept -> DecodeResult { return std::move(result); }
+
+			private:
+			AsyncImageDecoder* decoder;
+			DecodeRequest request;
+			std::stop_token stopToken;
+			DecodeResult result;
+		};
+
+		/**
+		* @brief Process wide instance
+		*/
+		[[nodiscard]] static auto GetInstance() -> AsyncImageDecoder&;
+
+		explicit AsyncImageDecoder(std::size_t workerCount = WorkerPool::DefaultThreadCount());
+		~AsyncImageDecoder() noexcept;
+
+		AsyncImageDecoder(const AsyncImageDecoder&) = delete;
+		auto operator=(const AsyncImageDecoder&) -> AsyncImageDecoder& = delete;
+		AsyncImageDecoder(AsyncImageDecoder&&) noexcept = delete;
+		auto operator=(AsyncImageDecoder&&) noexcept -> AsyncImageDecoder& = delete;
+
+		/**
+		* @brief callback runs on the calling thread, which needs a Dispatcher
+		* It doesn't run at all if stopToken is stopped before it would
+		*/
+		void DecodeAsync(DecodeRequest request, std::stop_token stopToken, Callback callback)
+		{
+			Submit(std::move(request), std::move(stopToken), std::move(callback), false);
+		}
+		/**
+		* @brief co_await decoder.Decode(request) resumes on the calling thread,
+		* with a cancelled DecodeResult if stopToken was stopped
+		*/
+		[[nodiscard]] auto Decode(DecodeRequest request, std::stop_token stopToken = { }) noexcept -> DecodeAwaiter
+		{
+			return DecodeAwaiter{ *this, std::move(request), std::move(stopToken) };
+		}
+
+		/**
+		* @brief Runs work on one of the workers, which have COM initialized and a WIC factory each (nullptr if that failed)
+		* Results have to be posted back by work itself
+		*/
+		void Run(Work work);
+
+		/**
+		* @brief Decodes on the calling thread, which has to have COM initialized
+		*/
+		[[nodiscard]] static auto DecodeImage(IWICImagingFactory* factory,
+			const DecodeRequest& request, const std::stop_token& stopToken = { }) -> DecodeResult;
+
+		/**
+		* @brief Largest size with size's aspect ratio that fits in targetSize, size itself if that's smaller
+		*/
+		[[nodiscard]] static auto FitSize(SizeU size, std::optional<SizeU> targetSize) noexcept -> SizeU;
+
+		private:
+		struct Job
+		{
+			DecodeRequest request;
+			std::stop_token stopToken;
+			Callback callback;
+			std::shared_ptr<Core::DispatcherQueue> queue;
+			bool invokeWhenCancelled;
+			DecodeResult result;
+		};
+
+		std::mutex completedMutex;
+		std::unordered_map<Core::DispatcherQueue*, std::vector<std::unique_ptr<Job>>> completed;
+
+		WorkerPool workers;
+
+		void Submit(DecodeRequest request, std::stop_token stopToken, Callback callback, bool invokeWhenCancelled);
+		void Complete(std::unique_ptr<Job> job);
+		void Deliver(Core::DispatcherQueue* queue);
+	};
+}
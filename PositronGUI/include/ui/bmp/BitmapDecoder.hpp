@@ -20,6 +20,8 @@ namespace PGUI::UI::Bmp
 			std::optional<GUID> vendorGUID = std::nullopt);
 		BitmapDecoder(ULONG_PTR fileHandle,
 			std::optional<GUID> vendorGUID = std::nullopt);
+		explicit BitmapDecoder(const ComPtr<IStream>& stream,
+			std::optional<GUID> vendorGUID = std::nullopt);
 		BitmapDecoder() noexcept;
 
 		[[nodiscard]] auto GetFrame(UINT frameIndex = 0) const noexcept -> Frame;
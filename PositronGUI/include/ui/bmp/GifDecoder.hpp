@@ -0,0 +1,166 @@
+#pragma once
+
+#include "core/Rect.hpp"
+#include "core/Size.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+
+namespace PGUI::UI::Bmp
+{
+	enum class GifDisposal : std::uint8_t
+	{
+		Unspecified = 0,
+		None = 1,
+		Background = 2,
+		Previous = 3
+	};
+
+	/**
+	* @brief Color table as premultiplied BGRA, entries past the table's size are opaque black
+	*/
+	using GifPalette = std::array<std::uint32_t, 256>;
+
+	class GifFormatException : public std::runtime_error
+	{
+		public:
+		using std::runtime_error::runtime_error;
+	};
+
+	struct GifFrameInfo
+	{
+		RectU rect{ };
+		std::chrono::milliseconds delay{ 0 };
+		GifDisposal disposal = GifDisposal::Unspecified;
+		std::optional<std::uint8_t> transparentIndex = std::nullopt;
+		bool isInterlaced = false;
+		std::size_t paletteIndex = 0;
+		std::uint8_t minCodeSize = 2;
+		/**
+		* @brief Offset of the first LZW data sub-block in the file
+		*/
+		std::size_t dataOffset = 0;
+	};
+
+	/**
+	* @brief Looks every index up in palette, pixels with transparentIndex leave destination as it was
+	*/
+	void ExpandPaletteIndices(std::span<const std::uint8_t> indices, const GifPalette& palette,
+		std::optional<std::uint8_t> transparentIndex, std::uint32_t* destination) noexcept;
+
+	namespace gif_detail
+	{
+		void ExpandPaletteIndicesScalar(std::span<const std::uint8_t> indices, const GifPalette& palette,
+			std::optional<std::uint8_t> transparentIndex, std::uint32_t* destination) noexcept;
+		void ExpandPaletteIndicesAvx2(std::span<const std::uint8_t> indices, const GifPalette& palette,
+			std::optional<std::uint8_t> transparentIndex, std::uint32_t* destination) noexcept;
+
+		/**
+		* @brief Decodes LZW codes straight out of the sub-blocks starting at subBlocks, without joining them first
+		* Stops at the end code, the block terminator or when output is full
+		* @return Number of indices written
+		*/
+		[[nodiscard]] auto DecodeLzw(std::span<const std::byte> subBlocks, std::uint8_t minCodeSize,
+			std::span<std::uint8_t> output) -> std::size_t;
+	}
+
+	/**
+	* @brief GIF87a/GIF89a parser and LZW decoder that doesn't depend on WIC
+	*
+	* Only the block structure is read up front, frame data is decoded on request
+	* Truncated files keep the frames that are complete
+	*/
+	class GifDecoder
+	{
+		public:
+		explicit GifDecoder(std::vector<std::byte> data);
+
+		[[nodiscard]] static auto FromFile(const std::filesystem::path& path) -> GifDecoder;
+
+		[[nodiscard]] auto GetCanvasSize() const noexcept { return canvasSize; }
+		[[nodiscard]] auto GetFrameCount() const noexcept { return frames.size(); }
+		[[nodiscard]] auto GetFrameInfo(std::size_t frameIndex) const noexcept -> const GifFrameInfo& { return frames[frameIndex]; }
+		[[nodiscard]] auto GetPalette(std::size_t frameIndex) const noexcept -> const GifPalette&
+		{
+			return palettes[frames[frameIndex].paletteIndex];
+		}
+		/**
+		* @brief Global color table entry picked by the logical screen descriptor, transparent without one
+		*/
+		[[nodiscard]] auto GetBackgroundColor() const noexcept { return backgroundColor; }
+		/**
+		* @brief From the NETSCAPE2.0 extension, 0 loops forever, nullopt if the file doesn't have one
+		*/
+		[[nodiscard]] auto GetLoopCount() const noexcept { return loopCount; }
+
+		/**
+		* @brief Color indices of the frame's rect in display order, interlacing undone
+		* Pixels missing from corrupt data get the transparent index
+		*/
+		void DecodeIndices(std::size_t frameIndex, std::vector<std::uint8_t>& indices) const;
+
+		private:
+		std::vector<std::byte> data;
+		std::vector<GifFrameInfo> frames;
+		std::vector<GifPalette> palettes;
+		SizeU canvasSize{ };
+		std::uint32_t backgroundColor = 0;
+		std::optional<std::uint32_t> loopCount = std::nullopt;
+
+		void Parse();
+	};
+
+	/**
+	* @brief Builds the full canvas of every frame from a GifDecoder, applying each frame's disposal before the next one
+	*/
+	class GifComposer
+	{
+		public:
+		explicit GifComposer(std::shared_ptr<const GifDecoder> decoder);
+
+		/**
+		* @brief Frames are expected in order, anything else is composed again from the first frame
+		* @return The area of the canvas that changed
+		*/
+		auto ComposeFrame(std::size_t frameIndex) -> RectU;
+
+		/**
+		* @brief Premultiplied BGRA, GetCanvasSize().cx pixels per row
+		*/
+		[[nodiscard]] auto GetCanvas() const noexcept -> std::span<const std::uint32_t> { return canvas; }
+		[[nodiscard]] auto GetCanvasSize() const noexcept { return decoder->GetCanvasSize(); }
+		[[nodiscard]] auto GetStride() const noexcept { return GetCanvasSize().cx * 4; }
+		[[nodiscard]] auto GetDecoder() const noexcept -> const GifDecoder& { return *decoder; }
+
+		/**
+		* @brief Color of areas disposed to the background, transparent by default like browsers do
+		*/
+		void SetBackgroundColor(std::uint32_t _backgroundColor) noexcept { backgroundColor = _backgroundColor; }
+
+		private:
+		std::shared_ptr<const GifDecoder> decoder;
+		std::vector<std::uint32_t> canvas;
+		std::vector<std::uint32_t> savedArea;
+		std::vector<std::uint8_t> indices;
+		std::optional<std::size_t> lastFrameIndex = std::nullopt;
+		RectU lastFrameRect{ };
+		std::uint32_t backgroundColor = 0;
+
+		void Reset();
+		[[nodiscard]] auto DisposeLastFrame() -> RectU;
+		void FillRect(RectU rect, std::uint32_t color) noexcept;
+		void SaveRect(RectU rect);
+		void RestoreRect(RectU rect) noexcept;
+		void DrawFrame(std::size_t frameIndex);
+		[[nodiscard]] auto ClipToCanvas(RectU rect) const noexcept -> RectU;
+	};
+}
@@ -5,4 +5,8 @@
 #include "BitmapDecoder.hpp"
 #include "Frame.hpp"
 #include "MetadataReader.hpp"
-#include "Palette.hpp"
\ No newline at end of file
+#include "Palette.hpp"
+#include "AsyncImageDecoder.hpp"
+#include "GifDecoder.hpp"
+#include "TilePyramid.hpp"
+#include "TiledImage.hpp"
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "core/Rect.hpp"
+#include "core/Size.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+
+namespace PGUI::UI::Bmp
+{
+	struct TileKey
+	{
+		std::uint32_t level = 0;
+		std::uint32_t column = 0;
+		std::uint32_t row = 0;
+
+		[[nodiscard]] constexpr auto operator==(const TileKey& other) const noexcept -> bool = default;
+	};
+
+	struct TileKeyHash
+	{
+		[[nodiscard]] auto operator()(TileKey key) const noexcept -> std::size_t;
+	};
+
+	/**
+	* @brief Premultiplied BGRA, size.cx pixels per row
+	*/
+	struct ImageTile
+	{
+		TileKey key;
+		SizeU size{ };
+		std::vector<std::uint32_t> pixels;
+	};
+
+	namespace tile_detail
+	{
+		/**
+		* @brief 2x2 box filter into (sourceSize + 1) / 2, pixels past an odd edge average only what's there
+		*/
+		void Downsample(std::span<const std::uint32_t> source, SizeU sourceSize, std::span<std::uint32_t> destination) noexcept;
+	}
+
+	/**
+	* @brief Serves an image as square tiles, read on demand at full resolution and averaged down into a mip pyramid
+	*
+	* Each level halves the one below it, the last one fits in a single tile
+	* Tiles are kept in a least recently used cache with a byte budget, so a zoomed out view
+	* only holds the few coarse tiles it draws
+	* Not thread safe
+	*/
+	class TilePyramid
+	{
+		public:
+		/**
+		* @brief Fills pixels with premultiplied BGRA of rect at full resolution, rect.Width() pixels per row
+		*/
+		using TileReader = std::function<void(RectU rect, std::span<std::uint32_t> pixels)>;
+		using Clock = std::chrono::steady_clock;
+
+		static constexpr std::uint32_t DefaultTileSize = 256;
+		static constexpr std::size_t DefaultByteBudget = 64ULL * 1024 * 1024;
+
+		TilePyramid(SizeU imageSize, TileReader reader,
+			std::uint32_t tileSize = DefaultTileSize, std::size_t byteBudget = DefaultByteBudget);
+
+		[[nodiscard]] auto GetImageSize() const noexcept { return imageSize; }
+		[[nodiscard]] auto GetTileSize() const noexcept { return tileSize; }
+		[[nodiscard]] auto GetLevelCount() const noexcept { return levelCount; }
+		[[nodiscard]] auto GetLevelSize(std::uint32_t level) const noexcept -> SizeU;
+		/**
+		* @brief Number of tile columns and rows
+		*/
+		[[nodiscard]] auto GetTileGrid(std::uint32_t level) const noexcept -> SizeU;
+		/**
+		* @brief In pixels of the tile's level
+		*/
+		[[nodiscard]] auto GetTileRect(TileKey key) const noexcept -> RectU;
+		/**
+		* @brief Coarsest level that still has scale or more pixels per image pixel
+		*/
+		[[nodiscard]] auto SelectLevel(float scale) const noexcept -> std::uint32_t;
+		/**
+		* @brief Tiles of level covering imageRect, which is in full resolution pixels
+		*/
+		[[nodiscard]] auto GetTilesInRect(std::uint32_t level, RectF imageRect) const -> std::vector<TileKey>;
+
+		/**
+		* @brief Reads or builds the tile and whatever it needs from the levels below
+		* Past deadline nothing new is started and nullptr is returned, tiles finished so far stay cached
+		*/
+		[[nodiscard]] auto GetTile(TileKey key,
+			std::optional<Clock::time_point> deadline = std::nullopt) -> std::shared_ptr<const ImageTile>;
+		/**
+		* @brief Only looks in the cache
+		*/
+		[[nodiscard]] auto FindTile(TileKey key) const -> std::shared_ptr<const ImageTile>;
+		void Clear() noexcept;
+
+		void SetByteBudget(std::size_t _byteBudget);
+		[[nodiscard]] auto GetByteBudget() const noexcept { return byteBudget; }
+		[[nodiscard]] auto GetByteSize() const noexcept { return byteSize; }
+		[[nodiscard]] auto GetCachedTileCount() const noexcept { return tiles.size(); }
+		[[nodiscard]] auto GetHitCount() const noexcept { return hitCount; }
+		/**
+		* @brief Full resolution tiles that went through the reader
+		*/
+		[[nodiscard]] auto GetReadCount() const noexcept { return readCount; }
+		/**
+		* @brief Tiles averaged down from the level below
+		*/
+		[[nodiscard]] auto GetBuildCount() const noexcept { return buildCount; }
+
+		private:
+		using TileList = std::list<std::shared_ptr<const ImageTile>>;
+
+		SizeU imageSize;
+		TileReader reader;
+		std::uint32_t tileSize;
+		std::uint32_t levelCount = 1;
+
+		std::size_t byteBudget;
+		std::size_t byteSize = 0;
+		// Most recently used first
+		TileList lru;
+		std::unordered_map<TileKey, TileList::iterator, TileKeyHash> tiles;
+
+		std::uint64_t hitCount = 0;
+		std::uint64_t readCount = 0;
+		std::uint64_t buildCount = 0;
+
+		[[nodiscard]] auto ReadTile(TileKey key) -> std::shared_ptr<const ImageTile>;
+		[[nodiscard]] auto BuildTile(TileKey key, std::optional<Clock::time_point> deadline) -> std::shared_ptr<const ImageTile>;
+		void Insert(const std::shared_ptr<const ImageTile>& tile);
+		void EvictOverBudget() noexcept;
+	};
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "helpers/ComPtr.hpp"
+#include "helpers/MappedFile.hpp"
+#include "ui/bmp/TilePyramid.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <wincodec.h>
+
+
+namespace PGUI::UI::Bmp
+{
+	/**
+	* @brief A TilePyramid over an image file, for images too large to decode whole
+	*
+	* WIC reads the file through a memory mapping, so only the pages a tile needs are loaded
+	* and there is no copy of the file in memory
+	* Uncompressed formats are served straight from the mapping, tiled formats such as TIFF decode one tile at a time,
+	* other codecs decode as little as they support for a rectangle
+	*
+	* The WIC objects come from factory, so the image belongs to factory's apartment,
+	* for AsyncImageDecoder's multithreaded workers that means any of them can read tiles
+	* GetTile calls take turns, the pyramid's geometry can be read from anywhere
+	*/
+	class TiledImage
+	{
+		public:
+		TiledImage(IWICImagingFactory* factory, const std::filesystem::path& filePath,
+			std::uint32_t tileSize = TilePyramid::DefaultTileSize,
+			std::size_t byteBudget = TilePyramid::DefaultByteBudget);
+
+		TiledImage(const TiledImage&) = delete;
+		auto operator=(const TiledImage&) -> TiledImage& = delete;
+		TiledImage(TiledImage&&) noexcept = delete;
+		auto operator=(TiledImage&&) noexcept -> TiledImage& = delete;
+
+		[[nodiscard]] auto GetSize() const noexcept { return pyramid.GetImageSize(); }
+		[[nodiscard]] auto GetPyramid() const noexcept -> const TilePyramid& { return pyramid; }
+
+		/**
+		* @brief TilePyramid::GetTile, blocks while another thread is reading
+		*/
+		[[nodiscard]] auto GetTile(TileKey key) -> std::shared_ptr<const ImageTile>;
+
+		private:
+		std::mutex mutex;
+		MappedFile file;
+		ComPtr<IWICStream> stream;
+		ComPtr<IWICBitmapDecoder> decoder;
+		ComPtr<IWICFormatConverter> converter;
+		TilePyramid pyramid;
+
+		[[nodiscard]] auto OpenSource(IWICImagingFactory* factory) -> SizeU;
+		void ReadPixels(RectU rect, std::span<std::uint32_t> pixels) const;
+	};
+}
@@ -27,14 +27,23 @@ namespace PGUI::UI::Controls
 			CheckBoxColors() = default;
 		};
 
+		using ThemeColorsGetter = auto (*)() noexcept -> CheckBoxColors;
+
 		[[nodiscard]] static auto GetCheckBoxColors() noexcept -> CheckBox::CheckBoxColors;
 		[[nodiscard]] static auto GetCheckBoxAccentedColors() noexcept -> CheckBox::CheckBoxColors;
 
-		explicit CheckBox(CheckBoxColors  colors = GetCheckBoxAccentedColors()) noexcept;
+		explicit CheckBox(CheckBoxColors  colors) noexcept;
+		/**
+		* @brief Colors come from themeColors, which is called again when UIColors reports a theme change
+		*/
+		explicit CheckBox(ThemeColorsGetter themeColors = &GetCheckBoxAccentedColors) noexcept;
 
 		[[nodiscard]] auto GetColors() const noexcept -> const CheckBoxColors& { return colors; }
 		[[nodiscard]] auto GetColors() noexcept -> CheckBoxColors& { return colors; }
-		void SetColors(const CheckBoxColors& newColors) { colors = newColors; }
+		/**
+		* @brief The check box keeps these colors when the theme changes
+		*/
+		void SetColors(const CheckBoxColors& newColors);
 
 		[[nodiscard]] auto IsTriState() const noexcept -> bool { return isTriState; }
 		void SetTriState(bool triState = true) noexcept { isTriState = triState; }
@@ -42,6 +51,8 @@ namespace PGUI::UI::Controls
 		private:
 		bool isTriState = false;
 		CheckBoxColors colors;
+		ThemeColorsGetter themeColors = nullptr;
+		Core::ScopedEventConnection themeChangedConnection;
 
 		Brush backgroundBrush;
 		Brush foregroundBrush;
@@ -51,6 +62,7 @@ namespace PGUI::UI::Controls
 
 		void OnClicked() noexcept;
 		void OnStateChanged(ButtonState state) noexcept;
+		void OnThemeChanged() noexcept;
 
 		auto OnPaint(UINT msg, WPARAM wParam, LPARAM lParam) noexcept -> Core::HandlerResult;
 	};
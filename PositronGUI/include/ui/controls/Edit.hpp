@@ -6,12 +6,16 @@
 #include "ui/Brush.hpp"
 #include "ui/TextFormat.hpp"
 #include "ui/TextLayout.hpp"
+#include "ui/TextBuffer.hpp"
+#include "ui/TextViewport.hpp"
 #include "ui/bmp/Bitmap.hpp"
 #include "helpers/ComPtr.hpp"
 #include "helpers/EnumFlag.hpp"
 #include "graphics/BitmapRenderTarget.hpp"
 
 #include <functional>
+#include <optional>
+#include <utility>
 #include <CommCtrl.h>
 #include <Richedit.h>
 #include <RichOle.h>
@@ -235,8 +239,49 @@ namespace PGUI::UI::Controls
 		
 		explicit Edit(const EditParams& params = EditParams{ });
 
-		void SetText(std::wstring_view text) const noexcept;
-		[[nodiscard]] auto GetText() const noexcept -> std::wstring;
+		void SetText(std::wstring_view text) noexcept;
+		[[nodiscard]] auto GetText() const -> std::wstring;
+
+		/**
+		 * @brief Piece table copy of the text, kept in sync before ChangedEvent is emitted
+		 * Paragraphs end with '\r' like they do in the rich edit, so character indexes are the same in both
+		 */
+		[[nodiscard]] auto GetDocument() const noexcept -> const TextBuffer&
+		{
+			EnsureDocumentSynced();
+			return document;
+		}
+		/**
+		 * @brief Calls visitor with views of the text in charRange straight out of the document, nothing is copied
+		 * The views are only valid until the text changes, which changes GetTextVersion
+		 */
+		template <typename Visitor>
+		void VisitText(CharRange charRange, Visitor&& visitor) const
+		{
+			EnsureDocumentSynced();
+			const auto [position, length] = ToDocumentRange(charRange);
+			document.VisitText(position, length, std::forward<Visitor>(visitor));
+		}
+		[[nodiscard]] auto GetTextVersion() const noexcept
+		{
+			EnsureDocumentSynced();
+			return document.GetVersion();
+		}
+
+		/**
+		 * @brief Paints the document through a TextViewport instead of the rich edit, only the lines in view are laid out
+		 * The rich edit still edits, scrolls and places the caret, the text is drawn in the default char format
+		 * with the rich edit's line pitch and zoom, so it lines up with the caret and selection
+		 */
+		void SetViewportRendering(bool viewportRendering = true);
+		[[nodiscard]] auto IsViewportRendering() const noexcept { return viewportRendering; }
+		/**
+		 * @brief Layout and draw timings of the last frame painted with viewport rendering
+		 */
+		[[nodiscard]] auto GetViewportFrameStats() const noexcept -> const TextViewportFrameStats&
+		{
+			return viewport.GetFrameStats();
+		}
 
 		void SetKeyFilter(const KeyFilterFunction& keyFilter) noexcept;
 		void RemoveKeyFilter() noexcept;
@@ -302,8 +347,9 @@ namespace PGUI::UI::Controls
 		 * @param flags - Specifies the behavior of the search operation (https://learn.microsoft.com/en-us/windows/win32/Controls/em-findtextex)
 		 * @param text - Text to be found
 		 * @return CharRange of the text in which it was found, not found if both min and max are -1
+		 * Case sensitive downward searches with no other flags scan the document instead of the rich edit
 		 */
-		[[nodiscard]] auto Find(EditFindFlag flags, std::wstring_view text, CharRange searchRange = CharRange{ 0, -1 }) const noexcept -> CharRange;
+		[[nodiscard]] auto Find(EditFindFlag flags, std::wstring_view text, CharRange searchRange = CharRange{ 0, -1 }) const -> CharRange;
 		[[nodiscard]] auto FindWordBreak(FindWordBreakOperations op, std::int64_t startPosition) const noexcept -> std::int64_t;
 
 		/**
@@ -318,14 +364,19 @@ namespace PGUI::UI::Controls
 		void SetDefaultCharFormat(const CHARFORMAT2W& cf) noexcept;
 
 		[[nodiscard]] auto GetEventMask() const noexcept -> EditEventMaskFlag;
+		/**
+		 * @brief Change stays on whatever the flags are, the document needs it
+		 */
 		void SetEventMask(EditEventMaskFlag eventFlags) const noexcept;
 
 		[[nodiscard]] auto GetFirstVisibleLine() const noexcept -> std::int64_t;
 
+		[[nodiscard]] auto GetScrollPosition() const noexcept -> PointL;
+
 		[[nodiscard]] auto GetTextLimit() const noexcept -> std::int64_t;
 		void SetTextLimit(std::int64_t limit) const noexcept;
 
-		[[nodiscard]] auto GetLine(int line) const noexcept -> std::wstring;
+		[[nodiscard]] auto GetLine(int line) const -> std::wstring;
 
 		[[nodiscard]] auto GetOptions()  const noexcept -> EditOptionsFlag;
 		void SetOptions(EditOptionsFlag options) const noexcept;
@@ -353,7 +404,7 @@ namespace PGUI::UI::Controls
 
 		[[nodiscard]] auto GetSelectionType() const noexcept -> EditSelectionFlag;
 
-		[[nodiscard]] auto GetSelectedText() const noexcept -> std::wstring;
+		[[nodiscard]] auto GetSelectedText() const -> std::wstring;
 
 		[[nodiscard]] auto GetTextLength(
 			std::optional<GETTEXTLENGTHEX> lengthEx = std::nullopt) const noexcept -> std::int64_t;
@@ -361,13 +412,13 @@ namespace PGUI::UI::Controls
 		[[nodiscard]] auto GetTextMode() const noexcept -> TEXTMODE;
 		void SetTextMode(TEXTMODE textMode) const noexcept;
 
-		[[nodiscard]] auto GetTextRange(CharRange charRange) const noexcept -> std::wstring;
+		[[nodiscard]] auto GetTextRange(CharRange charRange) const -> std::wstring;
 
 		void SetTargetDevice(HDC hdc, std::int64_t lineWidth) const noexcept;
 
 		void ShowSelection() const noexcept;
 		void HideSelection() const noexcept;
-		void ReplaceSelection(std::wstring_view newText, bool canUndo = false) const noexcept;
+		void ReplaceSelection(std::wstring_view newText, bool canUndo = false) noexcept;
 
 		void StopGroupTyping() const noexcept;
 
@@ -402,7 +453,10 @@ namespace PGUI::UI::Controls
 		void EnableAutoURLDetect() const noexcept;
 		void DisableAutoURLDetect() const noexcept;
 
-		[[nodiscard]] auto StreamIn(int streamFormat, EDITSTREAM editStream) const noexcept -> std::int64_t;
+		/**
+		 * @brief The document is read back from the rich edit afterwards, like SetText
+		 */
+		[[nodiscard]] auto StreamIn(int streamFormat, EDITSTREAM editStream) noexcept -> std::int64_t;
 		[[nodiscard]] auto StreamOut(int streamFormat, EDITSTREAM editStream) const noexcept -> std::int64_t;
 
 		#pragma endregion
@@ -437,6 +491,26 @@ namespace PGUI::UI::Controls
 		KeyFilterFunction filteringFunction;
 
 		ComPtr<ITextServices2> textServices;
+
+		// Mutable so a const read can first resync a document a change notification failed to sync
+		mutable TextBuffer document{ L'\r' };
+		// Selection before the edit being forwarded, SyncDocument finds the changed text from it
+		std::optional<CharRange> editSelectionHint;
+		std::uint64_t documentSyncCount = 0;
+		// Set when syncing a change threw, the document is read again whole before it's next used
+		mutable bool documentNeedsResync = false;
+
+		TextViewport viewport{ document };
+		bool viewportRendering = false;
+		// Where the rich edit puts the start of the text when it isn't scrolled
+		PointF viewportOrigin{ };
+		bool viewportGeometryMeasured = false;
+		Brush textBrush;
+		Brush selectionBrush;
+		// Cleared once the text color or the background is set by hand
+		bool followsTheme = true;
+		Core::ScopedEventConnection themeChangedConnection;
+
 		Core::WindowPtr<ScrollBar> verticalScrollBar{};
 		Core::WindowPtr<ScrollBar> horizontalScrollBar{};
 
@@ -476,6 +550,26 @@ namespace PGUI::UI::Controls
 
 		void CaretBlinkHandler(Core::TimerId timerId);
 
+		[[nodiscard]] static auto IsLocalEdit(UINT msg, WPARAM wParam) noexcept -> bool;
+		[[nodiscard]] auto GetPlainTextLength() const noexcept -> std::int64_t;
+		[[nodiscard]] auto ReadTextRange(std::int64_t first, std::int64_t last) const -> std::wstring;
+		void SyncDocument();
+		void ResyncDocument() const;
+		/**
+		 * @brief Resyncs if no change notification has synced the document since syncCount was read
+		 */
+		void ResyncDocumentIfUnchanged(std::uint64_t syncCount) noexcept;
+		void EnsureDocumentSynced() const noexcept;
+		[[nodiscard]] auto HasParagraphLines() const noexcept -> bool;
+		/**
+		 * @brief Position and length in the document, a max of -1 is the end of the text
+		 */
+		[[nodiscard]] auto ToDocumentRange(CharRange charRange) const noexcept -> std::pair<std::size_t, std::size_t>;
+		void UpdateViewportTextFormat();
+		void MeasureViewportGeometry() noexcept;
+		void ApplyThemeColors() noexcept;
+		void OnThemeChanged() noexcept;
+
 		auto OnDPIChange(float dpiScale, RectI suggestedRect) -> Core::HandlerResult override;
 		auto ForwardToTextServices(UINT msg, WPARAM wParam, LPARAM lParam) -> Core::HandlerResult;
 		auto OnCreate(UINT msg, WPARAM wParam, LPARAM lParam) -> Core::HandlerResult;
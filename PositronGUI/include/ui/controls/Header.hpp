@@ -5,6 +5,7 @@
 #include "ui/Brush.hpp"
 #include "ui/TextFormat.hpp"
 #include "ui/TextLayout.hpp"
+#include "ui/TextLayoutCache.hpp"
 
 #include <optional>
 
@@ -56,6 +57,10 @@ namespace PGUI::UI::Controls
 
 		virtual void OnDPIChanged(float dpiScale) = 0;
 		virtual void OnHeaderSizeChanged() = 0;
+		/**
+		* @brief Called by the Header when UIColors reports a theme change, the Header repaints after all its items
+		*/
+		virtual void OnThemeChanged() { /* */ }
 
 		private:
 		Core::Event<void> stateChangedEvent;
@@ -82,17 +87,25 @@ namespace PGUI::UI::Controls
 			HeaderTextItemColors() = default;
 		};
 
+		using ThemeColorsGetter = auto (*)() noexcept -> HeaderTextItemColors;
+
 		[[nodiscard]] static auto GetHeaderTextItemColors() noexcept -> HeaderTextItemColors;
 		[[nodiscard]] static auto GetHeaderTextItemAccentedColors() noexcept -> HeaderTextItemColors;
 
 		HeaderTextItem(std::wstring_view text, long width, 
-			HeaderTextItemColors  colors = GetHeaderTextItemColors(), 
+			HeaderTextItemColors  colors, 
+			TextFormat tf = TextFormat{ }) noexcept;
+		/**
+		* @brief Colors come from themeColors, which the Header calls again when UIColors reports a theme change
+		*/
+		HeaderTextItem(std::wstring_view text, long width,
+			ThemeColorsGetter themeColors = &GetHeaderTextItemColors,
 			TextFormat tf = TextFormat{ }) noexcept;
 
 		[[nodiscard]] auto GetColors() const noexcept -> const HeaderTextItemColors& { return colors; }
 		[[nodiscard]] auto GetColors() noexcept -> HeaderTextItemColors& { return colors; }
 
-		[[nodiscard]] auto GetTextLayout() const noexcept -> TextLayout { return textLayout; }
+		[[nodiscard]] auto GetTextLayout() const noexcept -> TextLayout { return textLayout.textLayout; }
 		void SetTextFormat(TextFormat textFormat) noexcept;
 
 		void InitTextLayout();
@@ -105,20 +118,22 @@ namespace PGUI::UI::Controls
 
 		void OnDPIChanged(float dpiScale) override;
 		void OnHeaderSizeChanged() override;
+		void OnThemeChanged() override;
 
 		private:
 		std::wstring text;
 		
 		HeaderTextItemColors colors;
+		ThemeColorsGetter themeColors = nullptr;
 
 		TextFormat textFormat;
-		TextLayout textLayout;
+		TextLayoutCache::PlacedTextLayout textLayout;
 
 		Brush textBrush;
 		Brush backgroundBrush;
 
+		void SetStateBrushes() noexcept;
 		void OnStateChanged() noexcept;
-
 	};
 
 	class Header : public Control
@@ -177,6 +192,9 @@ namespace PGUI::UI::Controls
 		[[nodiscard]] auto CalculateHeaderItemWidthUpToIndex(std::size_t index) const noexcept -> long;
 		[[nodiscard]] auto GetTotalHeaderWidth() const noexcept -> long;
 
+		void ApplyThemeColors() noexcept;
+		void OnThemeChanged() noexcept;
+
 		Core::Event<std::size_t> headerItemClickedEvent;
 
 		static inline const long sizingMargin = 5;
@@ -184,6 +202,9 @@ namespace PGUI::UI::Controls
 
 		Brush separatorBrush;
 		Brush backgroundBrush;
+		// Cleared once the brushes are set by hand
+		bool followsTheme = true;
+		Core::ScopedEventConnection themeChangedConnection;
 
 		bool dragging = false;
 		bool mouseOnDivider = false;
@@ -1,13 +1,17 @@
 #pragma once
 
 #include "core/Event.hpp"
+#include "helpers/FenwickTree.hpp"
 #include "ui/Control.hpp"
 #include "ui/controls/ScrollBar.hpp"
 #include "ui/Brush.hpp"
 #include "ui/TextFormat.hpp"
 #include "ui/TextLayout.hpp"
+#include "ui/TextLayoutCache.hpp"
 
+#include <cstdint>
 #include <vector>
+#include <unordered_map>
 
 
 namespace PGUI::UI::Controls
@@ -71,6 +75,14 @@ namespace PGUI::UI::Controls
 
 		virtual void OnDPIChanged(float dpiScale) = 0;
 		virtual void OnListViewSizeChanged() = 0;
+		/**
+		* @brief Called after a pooled item has been rebound to another row by the data source
+		*/
+		virtual void OnBound() { /* */ }
+		/**
+		* @brief Called by the ListView when UIColors reports a theme change, the ListView repaints after all its items
+		*/
+		virtual void OnThemeChanged() { /* */ }
 
 		private:
 		Core::Event<void> stateChangedEvent;
@@ -80,6 +92,7 @@ namespace PGUI::UI::Controls
 		long height;
 		long minHeight = 20;
 		ListView* listView = nullptr;
+		std::size_t index = 0;
 	};
 
 	class ListViewTextItem : public ListViewItem
@@ -98,9 +111,14 @@ namespace PGUI::UI::Controls
 			ListViewTextItemColors() = default;
 		};
 
+		[[nodiscard]] static auto GetListViewTextItemColors() noexcept -> ListViewTextItemColors;
+
+		/**
+		* @brief Takes its colors from the theme and follows theme changes until SetColors is called
+		*/
 		ListViewTextItem(std::wstring_view text, long height = 75, TextFormat textFormat = TextFormat{ }) noexcept;
 
-		[[nodiscard]] auto GetTextLayout() const noexcept { return textLayout; }
+		[[nodiscard]] auto GetTextLayout() const noexcept { return textLayout.textLayout; }
 		void SetTextFormat(TextFormat textFormat) noexcept;
 
 		void InitTextLayout();
@@ -122,33 +140,94 @@ namespace PGUI::UI::Controls
 		void OnStateChanged();
 		void OnDPIChanged(float dpiScale) override;
 		void OnListViewSizeChanged() override;
+		void OnBound() override;
+		void OnThemeChanged() override;
 
 		private:
 		std::wstring text;
 
 		ListViewTextItemColors colors;
+		// Cleared once SetColors is called
+		bool followsTheme = true;
 
 		TextFormat textFormat;
-		TextLayout textLayout;
+		TextLayoutCache::PlacedTextLayout textLayout;
 
 		Brush textBrush;
 		Brush backgroundBrush;
 		Brush selectedIndicatorBrush;
+
+		void SetStateBrushes() noexcept;
+	};
+
+	/**
+	* @brief Supplies rows to a ListView in virtual mode
+	* 
+	* The ListView only asks for the rows that are visible and draws them
+	* with a small pool of items that get rebound as the view scrolls
+	*/
+	class IListViewDataSource
+	{
+		public:
+		virtual ~IListViewDataSource() = default;
+
+		[[nodiscard]] virtual auto GetItemCount() const noexcept -> std::size_t = 0;
+		/**
+		* @brief Height of every row at the default DPI
+		*/
+		[[nodiscard]] virtual auto GetItemHeight() const noexcept -> long = 0;
+
+		[[nodiscard]] virtual auto CreateItem() -> std::unique_ptr<ListViewItem> = 0;
+		virtual void BindItem(ListViewItem& item, std::size_t index) = 0;
 	};
 
 	class ListView : public Control
 	{
+		friend class ListViewItem;
+
 		using ListViewItemList = std::vector<std::unique_ptr<ListViewItem>>;
 
+		struct PooledItem
+		{
+			std::unique_ptr<ListViewItem> item;
+			std::optional<std::size_t> boundIndex;
+		};
+		using ItemPool = std::vector<PooledItem>;
+
 		public:
 		ListView() noexcept;
 
+		/**
+		* @brief Switches the ListView to virtual mode, nullptr switches back to owned items
+		* The data source is not owned and must outlive the ListView or be reset
+		*/
+		void SetDataSource(IListViewDataSource* dataSource) noexcept;
+		[[nodiscard]] auto GetDataSource() const noexcept { return dataSource; }
+		[[nodiscard]] auto IsVirtual() const noexcept { return dataSource != nullptr; }
+		/**
+		* @brief Call when the item count or the row data of the data source changes
+		*/
+		void NotifyDataSourceChanged() noexcept;
+
+		[[nodiscard]] auto GetItemCount() const noexcept -> std::size_t;
+		[[nodiscard]] auto GetItemState(std::size_t index) const noexcept -> ListViewItemState;
+		void SetItemState(std::size_t index, ListViewItemState state) noexcept;
+
 		template <std::derived_from<ListViewItem> T, typename ...Args>
 		void AddItem(Args... args)
 		{
 			listViewItems.push_back(std::make_unique<T>(args...));
-			listViewItems.at(listViewItems.size() - 1)->listView = this;
-			listViewItems.at(listViewItems.size() - 1)->Create();
+
+			auto item = listViewItems.back().get();
+			item->listView = this;
+			item->index = listViewItems.size() - 1;
+			item->HeightChangedEvent().Subscribe([this, item]()
+			{
+				OnItemHeightChanged(*item);
+			});
+			heightIndex.PushBack(item->GetHeight());
+
+			item->Create();
 			itemsChangedEvent.Emit();
 			UpdateScrollBar();
 		}
@@ -173,15 +252,24 @@ namespace PGUI::UI::Controls
 			return listViewItems.at(index).get();
 		}
 
+		/**
+		* @brief In virtual mode the item bound to the hovered row, nullptr if nothing is hovered
+		*/
 		template <std::derived_from<ListViewItem> T>
-		[[nodiscard]] auto* GetHoveredItem() const
+		[[nodiscard]] auto GetHoveredItem() const -> T*
 		{
-			auto& ptr = listViewItems.at(*hoveringIndex);
-
-			return dynamic_cast<T*>(ptr.get());
+			return dynamic_cast<T*>(GetHoveredItem());
 		}
-		[[nodiscard]] auto* GetHoveredItem() const
+		[[nodiscard]] auto GetHoveredItem() const -> ListViewItem*
 		{
+			if (!hoveringIndex.has_value())
+			{
+				return nullptr;
+			}
+			if (dataSource)
+			{
+				return GetRealizedItem(*hoveringIndex);
+			}
 			return listViewItems.at(*hoveringIndex).get();
 		}
 
@@ -192,8 +280,10 @@ namespace PGUI::UI::Controls
 		[[nodiscard]] auto GetSelectedItemIndexes() const noexcept -> std::vector<std::size_t>;
 		[[nodiscard]] auto IsIndexSelected(std::size_t index) const noexcept -> bool;
 
-		[[nodiscard]] auto CalculateListViewItemHeightUpToIndex(std::size_t index) const noexcept -> long;
-		[[nodiscard]] auto GetTotalListViewItemHeight() const noexcept -> long;
+		[[nodiscard]] auto CalculateListViewItemHeightUpToIndex(std::size_t index) const noexcept -> std::int64_t;
+		[[nodiscard]] auto GetTotalListViewItemHeight() const noexcept -> std::int64_t;
+
+		void ScrollToIndex(std::size_t index) noexcept;
 
 		void Select(std::size_t index) noexcept;
 		void Deselect(std::size_t index) noexcept;
@@ -219,8 +309,20 @@ namespace PGUI::UI::Controls
 		std::optional<std::size_t> hoveringIndex = std::nullopt;
 
 		ListViewItemList listViewItems{ };
+		FenwickTree<long> heightIndex{ };
+
+		IListViewDataSource* dataSource = nullptr;
+		ItemPool itemPool{ };
+		// Rows differing from the default state, which is Selected after SelectAll so it costs nothing per row
+		std::unordered_map<std::size_t, ListViewItemState> virtualItemStates{ };
+		bool allVirtualItemsSelected = false;
+		bool isBindingItem = false;
+		long virtualItemHeight = 0;
 
 		Brush backgroundBrush;
+		// Cleared once the brush is set by hand
+		bool followsTheme = true;
+		Core::ScopedEventConnection themeChangedConnection;
 
 		SelectionMode selectionMode = SelectionMode::Single;
 
@@ -229,7 +331,18 @@ namespace PGUI::UI::Controls
 
 		void OnClipChanged() override;
 
-		[[nodiscard]] auto GetHoveredListViewItemIndex(long yPos) const noexcept -> std::optional<std::size_t>;
+		[[nodiscard]] auto GetHoveredListViewItemIndex(std::int64_t yPos) const noexcept -> std::optional<std::size_t>;
+
+		void InvalidateItem(std::size_t index) const noexcept;
+		void OnItemHeightChanged(const ListViewItem& item) noexcept;
+		void RebuildHeightIndex() noexcept;
+
+		[[nodiscard]] auto GetRealizedItem(std::size_t index) const noexcept -> ListViewItem*;
+		auto RealizeItem(std::size_t index) -> ListViewItem*;
+		void RecycleItemsOutside(std::size_t first, std::size_t last) noexcept;
+		void SetVirtualSelection(bool selectAll) noexcept;
+		void ForEachItem(const std::function<void(ListViewItem&)>& func) const;
+		void PaintVirtualItems(Graphics::Graphics g);
 
 		void SetStateWithSelected(std::size_t index, ListViewItemState state) noexcept;
 		void AddStateIfSelected(std::size_t index, ListViewItemState state) noexcept;
@@ -238,6 +351,8 @@ namespace PGUI::UI::Controls
 
 		void UpdateScrollBar();
 		void OnScroll();
+		void ApplyThemeColors() noexcept;
+		void OnThemeChanged() noexcept;
 
 		void SelectSingle(std::size_t index) noexcept;
 		void SelectMultiple(std::size_t index) noexcept;
@@ -89,6 +89,9 @@ namespace PGUI::UI::Controls
 
 		Brush thumbBrush;
 		Brush backgroundBrush;
+		// Cleared once the brushes are set by hand
+		bool followsTheme = true;
+		Core::ScopedEventConnection themeChangedConnection;
 
 		ScrollBarDirection direction;
 
@@ -119,6 +122,9 @@ namespace PGUI::UI::Controls
 		void AdjustRect(WPARAM wParam, LPRECT rc) const noexcept;
 
 		void OnButtonClicked(bool isUp);
+		void ApplyThemeColors() noexcept;
+		void OnThemeChanged() noexcept;
+		[[nodiscard]] auto GetButtonColors() const noexcept -> TextButton::TextButtonColors;
 
 		[[nodiscard]] auto CalculateThumbSize() const noexcept -> float;
 		[[nodiscard]] auto CalculateThumbRect() const noexcept -> RectF;
@@ -4,6 +4,9 @@
 #include "ui/ImgRenderer.hpp"
 
 #include <chrono>
+#include <optional>
+#include <stop_token>
+#include <string>
 #include <variant>
 
 
@@ -13,18 +16,63 @@ namespace PGUI::UI::Controls
 	class StaticImage : public UIComponent
 	{
 		public:
+		/**
+		* @brief Decodes the file on a worker thread at the size of the control, nothing is drawn until it's done
+		*/
 		explicit StaticImage(std::wstring_view fileName);
 		explicit StaticImage(const BmpToRender& bmp);
+		~StaticImage() noexcept override;
 
+		/**
+		* @brief Empty while the file is still being decoded
+		*/
 		[[nodiscard]] auto GetImage() const noexcept -> BmpToRender;
 		void SetImage(BmpToRender bmp) noexcept;
+		/**
+		* @brief Replaces the image with an asynchronously decoded file, cancels a decode still in flight
+		*/
+		void SetImage(std::wstring_view fileName);
+
+		[[nodiscard]] auto IsDecoding() const noexcept { return isDecoding; }
+
+		/**
+		* @brief Still images from files are read in tiles as needed, so they can be zoomed with the mouse wheel
+		* and dragged around at any size
+		* Takes effect from the next file
+		*/
+		void SetPanZoomEnabled(bool _panZoomEnabled) noexcept { panZoomEnabled = _panZoomEnabled; }
+		[[nodiscard]] auto IsPanZoomEnabled() const noexcept { return panZoomEnabled; }
+		/**
+		* @brief anchor is in client coordinates and stays over the same point of the image
+		*/
+		void ZoomAt(float factor, PointF anchor);
+		/**
+		* @brief Back to fitting the whole image
+		*/
+		void ResetView();
 
 		private:
 		void CreateRenderer(BmpToRender bmp) noexcept;
 		std::unique_ptr<IImgRenderer> renderer = nullptr;
 
+		std::wstring filePath;
+		std::stop_source decodeStopSource;
+		bool isDecoding = false;
+
+		bool panZoomEnabled = false;
+		std::optional<PointF> dragPoint = std::nullopt;
+
+		void StartDecode();
+		void CancelDecode() noexcept;
+		void OnDecoded(Bmp::DecodeResult& result);
+
 		auto OnCreate(BmpToRender bmp, UINT msg, WPARAM wParam, LPARAM lParam) noexcept -> Core::HandlerResult;
+		auto OnCreateFromFile(UINT msg, WPARAM wParam, LPARAM lParam) -> Core::HandlerResult;
 		auto OnPaint(UINT msg, WPARAM wParam, LPARAM lParam) noexcept -> Core::HandlerResult;
-		[[nodiscard]] auto OnSize(UINT msg, WPARAM wParam, LPARAM lParam) const noexcept -> Core::HandlerResult;
+		[[nodiscard]] auto OnSize(UINT msg, WPARAM wParam, LPARAM lParam) -> Core::HandlerResult;
+		auto OnMouseWheel(UINT msg, WPARAM wParam, LPARAM lParam) -> Core::HandlerResult;
+		auto OnLButtonDown(UINT msg, WPARAM wParam, LPARAM lParam) noexcept -> Core::HandlerResult;
+		auto OnLButtonUp(UINT msg, WPARAM wParam, LPARAM lParam) noexcept -> Core::HandlerResult;
+		auto OnMouseMove(UINT msg, WPARAM wParam, LPARAM lParam) -> Core::HandlerResult;
 	};
 }
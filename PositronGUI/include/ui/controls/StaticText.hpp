@@ -4,6 +4,7 @@
 #include "ui/UIComponent.hpp"
 #include "ui/TextFormat.hpp"
 #include "ui/TextLayout.hpp"
+#include "ui/TextLayoutCache.hpp"
 #include "ui/Brush.hpp"
 
 #include <string>
@@ -40,13 +41,19 @@ namespace PGUI::UI::Controls
 		private:
 		std::wstring text;
 		TextFormat textFormat;
-		TextLayout textLayout;
+		TextLayoutCache::PlacedTextLayout textLayout;
 
 		Brush textBrush;
 		Brush backgroundBrush;
+		// Cleared once either brush is set by hand
+		bool followsTheme = true;
+		Core::ScopedEventConnection themeChangedConnection;
 
 		Core::Event<std::wstring_view> textChangedEvent;
 
+		void ApplyThemeColors() noexcept;
+		void OnThemeChanged() noexcept;
+
 		auto OnDPIChange(float dpiScale, RectI suggestedRect) noexcept -> Core::HandlerResult override;
 		auto OnNCCreate(UINT msg, WPARAM wParam, LPARAM lParam) noexcept -> Core::HandlerResult;
 		auto OnPaint(UINT msg, WPARAM wParam, LPARAM lParam) noexcept -> Core::HandlerResult;
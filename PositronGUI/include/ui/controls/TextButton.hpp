@@ -4,6 +4,7 @@
 #include "ui/Control.hpp"
 #include "ui/TextFormat.hpp"
 #include "ui/TextLayout.hpp"
+#include "ui/TextLayoutCache.hpp"
 #include "ui/Brush.hpp"
 #include "ui/UIColors.hpp"
 #include "ui/controls/ButtonBase.hpp"
@@ -26,10 +27,17 @@ namespace PGUI::UI::Controls
 			TextButtonColors() = default;
 		};
 
+		using ThemeColorsGetter = auto (*)() noexcept -> TextButtonColors;
+
 		[[nodiscard]] static auto GetTextButtonColors() noexcept -> TextButton::TextButtonColors;
 		[[nodiscard]] static auto GetTextButtonAccentedColors() noexcept -> TextButton::TextButtonColors;
 
-		explicit TextButton(TextButtonColors  colors = GetTextButtonColors(), 
+		explicit TextButton(TextButtonColors  colors, 
+			TextFormat textFormat = TextFormat{ }) noexcept;
+		/**
+		* @brief Colors come from themeColors, which is called again when UIColors reports a theme change
+		*/
+		explicit TextButton(ThemeColorsGetter themeColors = &GetTextButtonColors,
 			TextFormat textFormat = TextFormat{ }) noexcept;
 
 		[[nodiscard]] auto GetTextLayout() const noexcept -> TextLayout;
@@ -42,6 +50,10 @@ namespace PGUI::UI::Controls
 
 		[[nodiscard]] auto GetColors() const noexcept -> const TextButtonColors&;
 		[[nodiscard]] auto GetColors() noexcept -> TextButtonColors&;
+		/**
+		* @brief The button keeps these colors when the theme changes
+		*/
+		void SetColors(TextButtonColors newColors) noexcept;
 
 		[[nodiscard]] auto TextChangedEvent() noexcept -> Core::Event<std::wstring_view>&;
 
@@ -51,17 +63,21 @@ namespace PGUI::UI::Controls
 
 		private:
 		TextButtonColors colors;
+		ThemeColorsGetter themeColors = nullptr;
+		Core::ScopedEventConnection themeChangedConnection;
 
 		std::wstring text;
 		TextFormat textFormat;
-		TextLayout textLayout;
+		TextLayoutCache::PlacedTextLayout textLayout;
 
 		Brush textBrush;
 		Brush backgroundBrush;
 
 		Core::Event<std::wstring_view> textChangedEvent;
 
+		void ApplyColors(ButtonState state) noexcept;
 		void OnStateChanged(ButtonState state) noexcept;
+		void OnThemeChanged() noexcept;
 
 		auto OnDPIChange(float dpiScale, RectI suggestedRect) noexcept -> Core::HandlerResult override;
 		auto OnNCCreate(UINT msg, WPARAM wParam, LPARAM lParam) noexcept -> Core::HandlerResult;
@@ -6,6 +6,9 @@
 #include "factories/Direct2DFactory.hpp"
  
 #include <array>
+#include <bit>
+#include <span>
+#include <vector>
 
 
 namespace PGUI::Core
@@ -17,27 +20,134 @@ namespace PGUI::Core
 		RegisterMessageHandler(WM_SIZE, &DirectCompositionWindow::OnSize);
 	}
 
+	void DirectCompositionWindow::ScrollContent(RectL scrollRect, PointL offset) noexcept
+	{
+		pendingScroll = std::pair{ scrollRect, offset };
+		Invalidate(scrollRect);
+	}
+
 	void DirectCompositionWindow::BeginDraw()
 	{
+		CollectDirtyRegion();
 		CreateDeviceResources();
 
 		d2d1Dc->BeginDraw();
+
+		// The clip is in surface space so push it without whatever transform the last frame left behind
+		const RectF clipRect = drawRegion.GetBounds();
+		D2D1_MATRIX_3X2_F prevTransform{ };
+		d2d1Dc->GetTransform(&prevTransform);
+		d2d1Dc->SetTransform(D2D1::IdentityMatrix());
+		d2d1Dc->PushAxisAlignedClip(clipRect, D2D1_ANTIALIAS_MODE_ALIASED);
+		d2d1Dc->SetTransform(prevTransform);
 	}
 
 	auto DirectCompositionWindow::EndDraw() -> HRESULT
 	{
+		d2d1Dc->PopAxisAlignedClip();
+
 		HRESULT hr = d2d1Dc->EndDraw();
 
 		if (hr == D2DERR_RECREATE_TARGET)
 		{
 			DiscardDeviceResources();
+			fullRepaintRequired = true;
 		}
 		HR_L(hr);
 
-		hr = swapChain->Present(1, NULL); HR_L(hr);
+		PresentDirtyRegion();
+
 		return hr;
 	}
 
+	void DirectCompositionWindow::CollectDirtyRegion()
+	{
+		const RectL surfaceRect{ PointL{ }, bufferSize };
+
+		presentRegion.Clear();
+
+		HRGN updateRegion = CreateRectRgn(0, 0, 0, 0);
+		if (GetUpdateRgn(Hwnd(), updateRegion, FALSE) > NULLREGION)
+		{
+			const auto size = GetRegionData(updateRegion, 0, nullptr);
+			std::vector<std::byte> buffer(size);
+			auto* data = std::bit_cast<LPRGNDATA>(buffer.data());
+
+			if (GetRegionData(updateRegion, size, data) != 0)
+			{
+				std::span rects{ std::bit_cast<const RECT*>(&data->Buffer[0]), data->rdh.nCount };
+				for (const auto& rc : rects)
+				{
+					presentRegion.Add(RectL{ rc });
+				}
+			}
+		}
+		DeleteObject(updateRegion);
+		ValidateRect(Hwnd(), nullptr);
+
+		// Nothing invalidated means we're drawing outside of WM_PAINT, assume everything changed
+		if (fullRepaintRequired || presentRegion.IsEmpty())
+		{
+			presentRegion.Clear();
+			presentRegion.Add(surfaceRect);
+		}
+		presentRegion.ClipTo(surfaceRect);
+
+		drawRegion = presentRegion;
+		drawRegion.Add(previousPresentRegion);
+		drawRegion.ClipTo(surfaceRect);
+	}
+
+	void DirectCompositionWindow::PresentDirtyRegion()
+	{
+		const RectL surfaceRect{ PointL{ }, bufferSize };
+
+		std::vector<RECT> dirtyRects;
+		DXGI_PRESENT_PARAMETERS parameters{ };
+
+		RECT scrollRect{ };
+		POINT scrollOffset{ };
+
+		if (!fullRepaintRequired && !presentRegion.Covers(surfaceRect))
+		{
+			for (const auto& rect : presentRegion.GetRects())
+			{
+				dirtyRects.push_back(rect);
+			}
+			parameters.DirtyRectsCount = static_cast<UINT>(dirtyRects.size());
+			parameters.pDirtyRects = dirtyRects.data();
+
+			if (pendingScroll.has_value())
+			{
+				// Both the scrolled rect and where it came from have to be inside the surface
+				auto [rect, offset] = *pendingScroll;
+				rect = rect.IntersectRect(surfaceRect).IntersectRect(surfaceRect.Shifted(offset.x, offset.y));
+
+				if (rect.Width() > 0 && rect.Height() > 0)
+				{
+					scrollRect = rect;
+					scrollOffset = offset;
+					parameters.pScrollRect = &scrollRect;
+					parameters.pScrollOffset = &scrollOffset;
+				}
+			}
+		}
+
+		HRESULT hr = swapChain->Present1(1, NULL, &parameters); HR_L(hr);
+
+		// Drawing is clipped to the bounds of the region, so that's what gets rasterized
+		const auto drawBounds = drawRegion.GetBounds();
+		paintStatistics.lastFramePixels = static_cast<std::uint64_t>(drawBounds.Width()) * static_cast<std::uint64_t>(drawBounds.Height());
+		paintStatistics.lastFramePresentedPixels = presentRegion.GetArea();
+		paintStatistics.surfacePixels = static_cast<std::uint64_t>(bufferSize.cx) * static_cast<std::uint64_t>(bufferSize.cy);
+		paintStatistics.totalPixels += paintStatistics.lastFramePixels;
+		paintStatistics.frameCount++;
+
+		previousPresentRegion = presentRegion;
+		pendingScroll.reset();
+		fullRepaintRequired = FAILED(hr);
+	}
+
 	void DirectCompositionWindow::CreateDeviceResources()
 	{
 		/* Not pure virtual to be optional to override */
@@ -192,6 +302,9 @@ namespace PGUI::Core
 		HRESULT hr = swapChain->ResizeBuffers(0, size.cx, size.cy,
 			DXGI_FORMAT_UNKNOWN, NULL); HR_T(hr);
 
+		bufferSize = size;
+		fullRepaintRequired = true;
+
 		DiscardDeviceResources();
 		InitD2D1DeviceContext();
 
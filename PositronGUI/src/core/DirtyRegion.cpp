@@ -0,0 +1,135 @@
+#include "core/DirtyRegion.hpp"
+
+#include <algorithm>
+#include <limits>
+
+
+namespace PGUI::Core
+{
+	void DirtyRegion::Add(RectL rect)
+	{
+		if (rect.Width() <= 0 || rect.Height() <= 0)
+		{
+			return;
+		}
+
+		// Keep swallowing rects the new one touches until it's disjoint from the rest
+		for (bool merged = true; merged;)
+		{
+			merged = false;
+			for (auto iter = rects.begin(); iter != rects.end(); ++iter)
+			{
+				if (iter->IsIntersectingRect(rect))
+				{
+					rect = Union(rect, *iter);
+					rects.erase(iter);
+					merged = true;
+					break;
+				}
+			}
+		}
+
+		rects.push_back(rect);
+
+		while (rects.size() > MaxRects)
+		{
+			MergeClosestPair();
+		}
+	}
+	void DirtyRegion::Add(const DirtyRegion& other)
+	{
+		for (const auto& rect : other.rects)
+		{
+			Add(rect);
+		}
+	}
+
+	void DirtyRegion::Clear() noexcept
+	{
+		rects.clear();
+	}
+
+	void DirtyRegion::ClipTo(RectL bounds)
+	{
+		for (auto& rect : rects)
+		{
+			rect = rect.IntersectRect(bounds);
+		}
+		std::erase_if(rects, [](const RectL& rect) { return rect.Width() <= 0 || rect.Height() <= 0; });
+	}
+
+	auto DirtyRegion::GetBounds() const noexcept -> RectL
+	{
+		if (rects.empty())
+		{
+			return RectL{ };
+		}
+
+		auto bounds = rects.front();
+		for (const auto& rect : rects)
+		{
+			bounds = Union(bounds, rect);
+		}
+		return bounds;
+	}
+
+	auto DirtyRegion::GetArea() const noexcept -> std::uint64_t
+	{
+		std::uint64_t area = 0;
+		for (const auto& rect : rects)
+		{
+			area += AreaOf(rect);
+		}
+		return area;
+	}
+
+	auto DirtyRegion::Covers(RectL rect) const noexcept -> bool
+	{
+		return std::ranges::any_of(rects, [rect](const RectL& r)
+		{
+			return r.left <= rect.left && r.top <= rect.top &&
+				r.right >= rect.right && r.bottom >= rect.bottom;
+		});
+	}
+
+	void DirtyRegion::MergeClosestPair()
+	{
+		std::size_t bestA = 0;
+		std::size_t bestB = 1;
+		auto bestGrowth = std::numeric_limits<std::uint64_t>::max();
+
+		for (std::size_t a = 0; a < rects.size(); a++)
+		{
+			for (auto b = a + 1; b < rects.size(); b++)
+			{
+				const auto growth = AreaOf(Union(rects[a], rects[b])) - AreaOf(rects[a]) - AreaOf(rects[b]);
+				if (growth < bestGrowth)
+				{
+					bestGrowth = growth;
+					bestA = a;
+					bestB = b;
+				}
+			}
+		}
+
+		const auto merged = Union(rects[bestA], rects[bestB]);
+		rects.erase(rects.begin() + static_cast<std::ptrdiff_t>(bestB));
+		rects.erase(rects.begin() + static_cast<std::ptrdiff_t>(bestA));
+
+		// The union can overlap other rects so add it back through the merging path
+		Add(merged);
+	}
+
+	auto DirtyRegion::Union(RectL a, RectL b) noexcept -> RectL
+	{
+		return RectL{
+			std::min(a.left, b.left), std::min(a.top, b.top),
+			std::max(a.right, b.right), std::max(a.bottom, b.bottom)
+		};
+	}
+
+	auto DirtyRegion::AreaOf(RectL rect) noexcept -> std::uint64_t
+	{
+		return static_cast<std::uint64_t>(rect.Width()) * static_cast<std::uint64_t>(rect.Height());
+	}
+}
@@ -0,0 +1,142 @@
+#include "core/Dispatcher.hpp"
+
+#include "core/Event.hpp"
+#include "core/Exceptions.hpp"
+#include "helpers/HelperFunctions.hpp"
+
+#include <bit>
+#include <mutex>
+#include <unordered_map>
+
+
+namespace PGUI::Core
+{
+	namespace
+	{
+		std::mutex registryMutex;
+		std::unordered_map<DWORD, std::weak_ptr<Dispatcher>> registry;
+
+		struct ThreadDispatcher
+		{
+			std::shared_ptr<Dispatcher> dispatcher = std::make_shared<Dispatcher>();
+
+			ThreadDispatcher()
+			{
+				std::scoped_lock lock{ registryMutex };
+				registry[dispatcher->GetThreadId()] = dispatcher;
+			}
+			~ThreadDispatcher() noexcept
+			{
+				dispatcher->Shutdown();
+
+				std::scoped_lock lock{ registryMutex };
+				registry.erase(dispatcher->GetThreadId());
+			}
+
+			ThreadDispatcher(const ThreadDispatcher&) = delete;
+			auto operator=(const ThreadDispatcher&) -> ThreadDispatcher& = delete;
+			ThreadDispatcher(ThreadDispatcher&&) noexcept = delete;
+			auto operator=(ThreadDispatcher&&) noexcept -> ThreadDispatcher& = delete;
+		};
+	}
+
+	auto Dispatcher::GetForCurrentThread() -> Dispatcher&
+	{
+		thread_local ThreadDispatcher threadDispatcher;
+		return *threadDispatcher.dispatcher;
+	}
+	auto Dispatcher::GetForThread(DWORD threadId) -> std::shared_ptr<Dispatcher>
+	{
+		std::scoped_lock lock{ registryMutex };
+
+		auto iter = registry.find(threadId);
+		return iter != registry.end() ? iter->second.lock() : nullptr;
+	}
+
+	// Defined here so Event itself doesn't depend on Windows
+	auto event_detail::GetCurrentThreadQueue() -> std::shared_ptr<DispatcherQueue>
+	{
+		return Dispatcher::GetForCurrentThread().GetQueue();
+	}
+
+	Dispatcher::Dispatcher() :
+		threadId{ GetCurrentThreadId() }
+	{
+		static const ATOM classAtom = []
+		{
+			WNDCLASSEXW wc{ };
+			wc.cbSize = sizeof(WNDCLASSEXW);
+			wc.lpfnWndProc = WindowProc;
+			wc.hInstance = GetHInstance();
+			wc.lpszClassName = L"PGUI_Dispatcher";
+
+			const auto atom = RegisterClassExW(&wc);
+			if (atom == NULL)
+			{
+				throw Win32Exception{ };
+			}
+			return atom;
+		}();
+
+		hWnd = CreateWindowExW(0, MAKEINTATOM(classAtom), L"", 0,
+			0, 0, 0, 0, HWND_MESSAGE, nullptr, GetHInstance(), nullptr);
+		if (hWnd == nullptr)
+		{
+			throw Win32Exception{ };
+		}
+		SetWindowLongPtrW(hWnd, GWLP_USERDATA, std::bit_cast<LONG_PTR>(this));
+
+		queue = std::make_shared<DispatcherQueue>([window = hWnd, shutDown = isShutDown]
+		{
+			if (shutDown->load(std::memory_order_relaxed))
+			{
+				return false;
+			}
+			if (PostMessageW(window, WM_DISPATCHER_WAKE, 0, 0) == 0)
+			{
+				HR_L(HresultFromWin32());
+				return false;
+			}
+			return true;
+		});
+	}
+	Dispatcher::~Dispatcher() noexcept
+	{
+		Shutdown();
+	}
+
+	void Dispatcher::Shutdown() noexcept
+	{
+		if (isShutDown->exchange(true))
+		{
+			return;
+		}
+
+		SetWindowLongPtrW(hWnd, GWLP_USERDATA, 0);
+		DestroyWindow(hWnd);
+	}
+
+	void Dispatcher::Drain()
+	{
+		KillTimer(hWnd, DrainTimerId);
+
+		if (const auto result = queue->Drain();
+			result.hasRemainingWork)
+		{
+			SetTimer(hWnd, DrainTimerId, USER_TIMER_MINIMUM, nullptr);
+		}
+	}
+
+	auto CALLBACK Dispatcher::WindowProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam) -> LRESULT
+	{
+		auto* dispatcher = std::bit_cast<Dispatcher*>(GetWindowLongPtrW(hWnd, GWLP_USERDATA));
+
+		if (dispatcher != nullptr &&
+			(msg == WM_DISPATCHER_WAKE || (msg == WM_TIMER && wParam == DrainTimerId)))
+		{
+			dispatcher->Drain();
+			return 0;
+		}
+		return DefWindowProcW(hWnd, msg, wParam, lParam);
+	}
+}
@@ -0,0 +1,154 @@
+#include "core/DispatcherQueue.hpp"
+
+#include <memory>
+
+
+namespace PGUI::Core
+{
+#pragma region NodeList
+
+	void DispatcherQueue::NodeList::AppendReversed(Node* stack) noexcept
+	{
+		if (stack == nullptr)
+		{
+			return;
+		}
+
+		// The stack is newest first
+		Node* first = nullptr;
+		Node* last = stack;
+		while (stack != nullptr)
+		{
+			auto* next = stack->next;
+			stack->next = first;
+			first = stack;
+			stack = next;
+		}
+
+		if (tail == nullptr)
+		{
+			head = first;
+		}
+		else
+		{
+			tail->next = first;
+		}
+		tail = last;
+	}
+
+	auto DispatcherQueue::NodeList::PopFront() noexcept -> Node*
+	{
+		auto* node = head;
+		head = node->next;
+		if (head == nullptr)
+		{
+			tail = nullptr;
+		}
+		return node;
+	}
+
+	void DispatcherQueue::NodeList::Destroy() noexcept
+	{
+		while (!IsEmpty())
+		{
+			delete PopFront();
+		}
+	}
+
+#pragma endregion
+
+#pragma region DispatcherQueue
+
+	DispatcherQueue::DispatcherQueue(WakeCallback _wakeCallback) :
+		wakeCallback{ std::move(_wakeCallback) }, consumerThread{ std::this_thread::get_id() }
+	{
+	}
+
+	DispatcherQueue::~DispatcherQueue() noexcept
+	{
+		for (std::size_t i = 0; i < DispatcherPriorityCount; i++)
+		{
+			pending[i].AppendReversed(incoming[i].exchange(nullptr, std::memory_order_acquire));
+			pending[i].Destroy();
+		}
+	}
+
+	void DispatcherQueue::Post(Work work, DispatcherPriority priority)
+	{
+		auto* node = new Node{ std::move(work) };
+
+		auto& stack = incoming[static_cast<std::size_t>(priority)];
+		node->next = stack.load(std::memory_order_relaxed);
+		while (!stack.compare_exchange_weak(node->next, node,
+			std::memory_order_release, std::memory_order_relaxed))
+		{
+		}
+		postedCount.fetch_add(1, std::memory_order_relaxed);
+
+		// Only the first post since the consumer last started draining wakes it up
+		if (wakeRequested.exchange(true))
+		{
+			return;
+		}
+
+		auto woken = false;
+		try
+		{
+			woken = !wakeCallback || wakeCallback();
+		}
+		catch (...)
+		{
+			wakeRequested.store(false);
+			throw;
+		}
+
+		if (woken)
+		{
+			wakeCount.fetch_add(1, std::memory_order_relaxed);
+		}
+		else
+		{
+			wakeRequested.store(false);
+		}
+	}
+
+	auto DispatcherQueue::Drain(Clock::duration backgroundBudget) -> DrainResult
+	{
+		// Cleared before taking the stacks so a post that misses this batch wakes us again
+		wakeRequested.store(false);
+
+		for (std::size_t i = 0; i < DispatcherPriorityCount; i++)
+		{
+			pending[i].AppendReversed(incoming[i].exchange(nullptr, std::memory_order_acquire));
+		}
+
+		DrainResult result;
+		const auto deadline = Clock::now() + backgroundBudget;
+
+		for (std::size_t i = 0; i < DispatcherPriorityCount; i++)
+		{
+			const auto isBackground = i == static_cast<std::size_t>(DispatcherPriority::Background);
+
+			auto& list = pending[i];
+			std::size_t executedInList = 0;
+			while (!list.IsEmpty())
+			{
+				if (isBackground && executedInList != 0 && Clock::now() >= deadline)
+				{
+					break;
+				}
+
+				const std::unique_ptr<Node> node{ list.PopFront() };
+				node->work();
+
+				executedInList++;
+				result.executedCount++;
+			}
+		}
+
+		result.hasRemainingWork = !pending[static_cast<std::size_t>(DispatcherPriority::Background)].IsEmpty();
+		return result;
+	}
+
+#pragma endregion
+}
@@ -0,0 +1,67 @@
+#include "core/Event.hpp"
+
+
+namespace PGUI::Core
+{
+#pragma region EventConnection
+
+	EventConnection::EventConnection(std::weak_ptr<event_detail::EventStateBase> _state, std::uint64_t _id) noexcept :
+		state{ std::move(_state) }, id{ _id }
+	{
+	}
+
+	void EventConnection::Disconnect()
+	{
+		if (const auto eventState = state.lock();
+			eventState)
+		{
+			eventState->Unsubscribe(id);
+		}
+		state.reset();
+	}
+
+	auto EventConnection::IsConnected() const -> bool
+	{
+		const auto eventState = state.lock();
+		return eventState && eventState->IsSubscribed(id);
+	}
+
+#pragma endregion
+
+#pragma region ScopedEventConnection
+
+	ScopedEventConnection::ScopedEventConnection(EventConnection _connection) noexcept :
+		connection{ std::move(_connection) }
+	{
+	}
+	ScopedEventConnection::~ScopedEventConnection() noexcept
+	{
+		connection.Disconnect();
+	}
+
+	ScopedEventConnection::ScopedEventConnection(ScopedEventConnection&& other) noexcept :
+		connection{ std::exchange(other.connection, EventConnection{ }) }
+	{
+	}
+	auto ScopedEventConnection::operator=(ScopedEventConnection&& other) noexcept -> ScopedEventConnection&
+	{
+		if (this != &other)
+		{
+			connection.Disconnect();
+			connection = std::exchange(other.connection, EventConnection{ });
+		}
+		return *this;
+	}
+
+	void ScopedEventConnection::Disconnect()
+	{
+		connection.Disconnect();
+	}
+
+	auto ScopedEventConnection::Release() noexcept -> EventConnection
+	{
+		return std::exchange(connection, EventConnection{ });
+	}
+
+#pragma endregion
+}
@@ -0,0 +1,136 @@
+#include "core/FramePacer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace PGUI::Core
+{
+	auto SteadyFrameClock::GetInstance() noexcept -> const SteadyFrameClock&
+	{
+		static const SteadyFrameClock instance;
+		return instance;
+	}
+
+#pragma region FrameStatistics
+
+	FrameStatistics::FrameStatistics(std::size_t windowSize) :
+		windowSize{ std::max(windowSize, std::size_t{ 1 }) }
+	{
+		samples.reserve(this->windowSize);
+	}
+
+	void FrameStatistics::AddFrame(Duration frameTime, std::uint64_t missedFrames)
+	{
+		if (samples.size() < windowSize)
+		{
+			samples.push_back(frameTime);
+		}
+		else
+		{
+			windowSum -= samples[nextSample];
+			samples[nextSample] = frameTime;
+			nextSample = (nextSample + 1) % windowSize;
+		}
+		windowSum += frameTime;
+
+		frameCount++;
+		missedFrameCount += missedFrames;
+	}
+
+	void FrameStatistics::Reset() noexcept
+	{
+		samples.clear();
+		nextSample = 0;
+		windowSum = Duration::zero();
+		frameCount = 0;
+		missedFrameCount = 0;
+	}
+
+	auto FrameStatistics::GetAverageFrameTime() const noexcept -> Duration
+	{
+		if (samples.empty())
+		{
+			return Duration::zero();
+		}
+		return windowSum / static_cast<Duration::rep>(samples.size());
+	}
+
+	auto FrameStatistics::GetPercentileFrameTime(double percentile) const -> Duration
+	{
+		if (samples.empty())
+		{
+			return Duration::zero();
+		}
+
+		// Nearest rank
+		const auto rank = static_cast<std::size_t>(
+			std::ceil(std::clamp(percentile, 0.0, 1.0) * static_cast<double>(samples.size())));
+		const auto index = std::clamp(rank, std::size_t{ 1 }, samples.size()) - 1;
+
+		auto sorted = samples;
+		std::ranges::nth_element(sorted, sorted.begin() + static_cast<std::ptrdiff_t>(index));
+		return sorted[index];
+	}
+
+#pragma endregion
+
+#pragma region FramePacer
+
+	FramePacer::FramePacer(Duration targetFrameTime, const IFrameClock& clock) :
+		clock{ &clock }, targetFrameTime{ std::max(targetFrameTime, Duration{ 1 }) }
+	{
+	}
+
+	void FramePacer::SetTargetFrameTime(Duration _targetFrameTime) noexcept
+	{
+		targetFrameTime = std::max(_targetFrameTime, Duration{ 1 });
+
+		if (lastFrameStart.has_value())
+		{
+			nextFrameTime = *lastFrameStart + targetFrameTime;
+		}
+	}
+
+	auto FramePacer::BeginFrame() -> Duration
+	{
+		const auto now = clock->Now();
+
+		if (!lastFrameStart.has_value())
+		{
+			lastFrameStart = now;
+			nextFrameTime = now + targetFrameTime;
+			return Duration::zero();
+		}
+
+		const auto frameTime = now - *lastFrameStart;
+		lastFrameStart = now;
+
+		// Slots that went by without a frame starting in them
+		std::uint64_t missed = 0;
+		if (now > nextFrameTime)
+		{
+			missed = static_cast<std::uint64_t>((now - nextFrameTime) / targetFrameTime);
+		}
+		nextFrameTime += targetFrameTime * static_cast<Duration::rep>(missed + 1);
+
+		statistics.AddFrame(frameTime, missed);
+
+		return frameTime;
+	}
+
+	auto FramePacer::IsFrameDue() const noexcept -> bool
+	{
+		return !lastFrameStart.has_value() || clock->Now() >= nextFrameTime;
+	}
+	auto FramePacer::GetNextFrameTime() const noexcept -> TimePoint
+	{
+		return lastFrameStart.has_value() ? nextFrameTime : clock->Now();
+	}
+	auto FramePacer::GetTimeUntilNextFrame() const noexcept -> Duration
+	{
+		return std::max(GetNextFrameTime() - clock->Now(), Duration::zero());
+	}
+
+#pragma endregion
+}
@@ -0,0 +1,164 @@
+#include "core/MessageDispatchTable.hpp"
+
+#include <algorithm>
+
+
+namespace PGUI::Core
+{
+	void MessageDispatchTable::Add(UINT msg, MessageHandlerRef handler)
+	{
+		auto iter = std::ranges::lower_bound(entries, msg, { }, &Entry::msg);
+
+		std::uint32_t insertAt = 0;
+		if (iter != entries.end() && iter->msg == msg)
+		{
+			insertAt = iter->begin + iter->count;
+			iter->count++;
+			++iter;
+		}
+		else
+		{
+			insertAt = iter != entries.end() ? iter->begin : static_cast<std::uint32_t>(handlers.size());
+			iter = entries.insert(iter, Entry{ msg, insertAt, 1 });
+			++iter;
+		}
+
+		handlers.insert(handlers.begin() + insertAt, handler);
+
+		// Every group after the one we grew moved by one
+		for (; iter != entries.end(); ++iter)
+		{
+			iter->begin++;
+		}
+
+		RebuildDenseSlots();
+		version++;
+	}
+
+	void MessageDispatchTable::Clear() noexcept
+	{
+		entries.clear();
+		handlers.clear();
+		denseSlots.fill(NoSlot);
+		version++;
+	}
+
+	auto MessageDispatchTable::Find(UINT msg) const noexcept -> std::span<const MessageHandlerRef>
+	{
+		const Entry* entry = nullptr;
+
+		if (msg < DenseMessageCount)
+		{
+			const auto slot = denseSlots[msg];
+			if (slot == NoSlot)
+			{
+				return { };
+			}
+			entry = slot == OverflowSlot ? FindEntry(msg) : &entries[slot - 1];
+		}
+		else
+		{
+			entry = FindEntry(msg);
+		}
+
+		if (entry == nullptr)
+		{
+			return { };
+		}
+		return std::span{ handlers }.subspan(entry->begin, entry->count);
+	}
+
+	auto MessageDispatchTable::Dispatch(UINT msg, WPARAM wParam, LPARAM lParam) const -> DispatchResult
+	{
+		DispatchResult dispatchResult;
+		bool forceCurrentResult = false;
+
+		auto handlerList = Find(msg);
+		dispatchResult.handled = !handlerList.empty();
+
+		for (std::size_t i = 0; i < handlerList.size(); i++)
+		{
+			const auto currentVersion = version;
+			auto [lResult, flags] = handlerList[i](msg, wParam, lParam);
+			using enum HandlerResultFlag;
+
+			// The handler registered another handler which moved the array
+			if (currentVersion != version)
+			{
+				handlerList = Find(msg);
+			}
+
+			if (!(flags & ReturnPrevResult))
+			{
+				dispatchResult.result = lResult;
+			}
+			if ((flags & NoFurtherHandling) != Nothing)
+			{
+				break;
+			}
+			if (forceCurrentResult)
+			{
+				continue;
+			}
+			if ((flags & ForceThisResult) != Nothing)
+			{
+				forceCurrentResult = true;
+			}
+			if ((flags & PassToDefWindowProc) != Nothing)
+			{
+				dispatchResult.passToDefWindowProc = true;
+			}
+		}
+
+		return dispatchResult;
+	}
+
+	void MessageDispatchTable::RebuildDenseSlots() noexcept
+	{
+		denseSlots.fill(NoSlot);
+
+		for (std::size_t i = 0; i < entries.size(); i++)
+		{
+			const auto msg = entries[i].msg;
+			if (msg >= DenseMessageCount)
+			{
+				break;
+			}
+
+			denseSlots[msg] = i + 1 < OverflowSlot ?
+				static_cast<std::uint8_t>(i + 1) : OverflowSlot;
+		}
+	}
+
+	auto MessageDispatchTable::FindEntry(UINT msg) const noexcept -> const Entry*
+	{
+		auto iter = std::ranges::lower_bound(entries, msg, { }, &Entry::msg);
+		if (iter == entries.end() || iter->msg != msg)
+		{
+			return nullptr;
+		}
+		return &*iter;
+	}
+
+	auto ReplayMessages(const MessageDispatchTable& table,
+		std::span<const RecordedMessage> messages, std::size_t iterations) -> DispatchBenchmarkResult
+	{
+		DispatchBenchmarkResult benchmarkResult;
+
+		const auto start = std::chrono::steady_clock::now();
+		for (std::size_t i = 0; i < iterations; i++)
+		{
+			for (const auto& [msg, wParam, lParam] : messages)
+			{
+				if (table.Dispatch(msg, wParam, lParam).handled)
+				{
+					benchmarkResult.handledCount++;
+				}
+			}
+		}
+		benchmarkResult.elapsed = std::chrono::steady_clock::now() - start;
+		benchmarkResult.messageCount = messages.size() * iterations;
+
+		return benchmarkResult;
+	}
+}
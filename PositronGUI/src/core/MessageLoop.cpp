@@ -3,6 +3,9 @@
 #include "core/Exceptions.hpp"
 #include "helpers/HelperFunctions.hpp"
 
+#include <algorithm>
+#include <memory>
+
 
 namespace PGUI::Core
 {
@@ -26,9 +29,104 @@ namespace PGUI::Core
 		return static_cast<int>(msg.wParam);
 	}
 
-	//TODO Implemet
+	PeekMessageLoop::PeekMessageLoop(Duration targetFrameTime) :
+		pacer{ targetFrameTime }
+	{
+	}
+
 	auto PeekMessageLoop::Run() -> int
 	{
-		throw HresultException{ E_NOTIMPL };
+		struct HandleCloser
+		{
+			void operator()(HANDLE handle) const noexcept { CloseHandle(handle); }
+		};
+
+		std::unique_ptr<void, HandleCloser> timer{ CreateWaitableTimerExW(nullptr, nullptr,
+			CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS) };
+		if (!timer)
+		{
+			// High resolution timers need Windows 10 1803
+			timer.reset(CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS));
+		}
+		if (!timer)
+		{
+			HR_T(HresultFromWin32());
+		}
+
+		while (true)
+		{
+			MSG msg{ };
+			while (PeekMessageW(&msg, nullptr, 0, 0, PM_REMOVE))
+			{
+				if (msg.message == WM_QUIT)
+				{
+					return static_cast<int>(msg.wParam);
+				}
+				TranslateMessage(&msg);
+				DispatchMessageW(&msg);
+			}
+
+			HANDLE waitHandle = frameLatencyWaitableObject;
+			if (waitHandle == nullptr)
+			{
+				if (pacer.IsFrameDue())
+				{
+					RunFrame();
+					continue;
+				}
+
+				// Relative due time in 100ns units
+				LARGE_INTEGER dueTime{ };
+				dueTime.QuadPart = -std::max<LONGLONG>(pacer.GetTimeUntilNextFrame().count() / 100, 1);
+				if (SetWaitableTimer(timer.get(), &dueTime, 0, nullptr, nullptr, FALSE) == 0)
+				{
+					HR_L(HresultFromWin32());
+				}
+				waitHandle = timer.get();
+			}
+
+			switch (MsgWaitForMultipleObjectsEx(1, &waitHandle, INFINITE, QS_ALLINPUT, MWMO_INPUTAVAILABLE))
+			{
+				case WAIT_OBJECT_0:
+					RunFrame();
+					break;
+				case WAIT_FAILED:
+				{
+					auto errCode = GetLastError();
+					HR_L(HresultFromWin32(errCode));
+					return static_cast<int>(errCode);
+				}
+				default:
+					// Input arrived, drain it first
+					break;
+			}
+		}
+	}
+
+	void PeekMessageLoop::RunFrame()
+	{
+		const auto deltaSeconds = std::chrono::duration<double>{ pacer.BeginFrame() }.count();
+
+		for (const auto& callback : updateCallbacks)
+		{
+			callback(deltaSeconds);
+		}
+		for (const auto& callback : renderCallbacks)
+		{
+			callback();
+		}
+
+		if (idleCallbacks.empty())
+		{
+			return;
+		}
+		if (const auto remaining = pacer.GetTimeUntilNextFrame();
+			remaining > Duration::zero())
+		{
+			for (const auto& callback : idleCallbacks)
+			{
+				callback(remaining);
+			}
+		}
 	}
 }
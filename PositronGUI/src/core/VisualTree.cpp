@@ -0,0 +1,483 @@
+#include "core/VisualTree.hpp"
+
+#include <algorithm>
+#include <ranges>
+
+
+namespace PGUI::Core
+{
+#pragma region VisualElement
+
+	auto VisualElement::AddChild(std::unique_ptr<VisualElement> child) -> VisualElement*
+	{
+		auto* ptr = child.get();
+		ptr->parent = this;
+		children.push_back(std::move(child));
+
+		if (tree != nullptr)
+		{
+			ptr->SetTree(tree);
+			ptr->Invalidate();
+		}
+
+		return ptr;
+	}
+	auto VisualElement::RemoveChild(const VisualElement* child) -> std::unique_ptr<VisualElement>
+	{
+		auto iter = std::ranges::find_if(children, [child](const auto& c) { return c.get() == child; });
+		if (iter == children.end())
+		{
+			return nullptr;
+		}
+
+		auto removed = std::move(*iter);
+		children.erase(iter);
+
+		if (tree != nullptr)
+		{
+			tree->Invalidate(removed->GetAbsoluteBounds());
+			tree->ReleaseElementState(*removed);
+			removed->SetTree(nullptr);
+		}
+		removed->parent = nullptr;
+
+		return removed;
+	}
+
+	auto VisualElement::IsAncestorOf(const VisualElement* element) const noexcept -> bool
+	{
+		for (; element != nullptr; element = element->parent)
+		{
+			if (element == this)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void VisualElement::SetBounds(RectF _bounds) noexcept
+	{
+		if (bounds == _bounds)
+		{
+			return;
+		}
+
+		Invalidate();
+		bounds = _bounds;
+		Invalidate();
+
+		OnBoundsChanged();
+	}
+	auto VisualElement::GetAbsoluteBounds() const noexcept -> RectF
+	{
+		auto absolute = bounds;
+		for (auto* p = parent; p != nullptr; p = p->parent)
+		{
+			absolute.Shift(p->bounds.left, p->bounds.top);
+		}
+		return absolute;
+	}
+	auto VisualElement::ToLocal(PointF treePoint) const noexcept -> PointF
+	{
+		return treePoint - GetAbsoluteBounds().TopLeft();
+	}
+
+	void VisualElement::Show(bool show) noexcept
+	{
+		if (visible == show)
+		{
+			return;
+		}
+
+		visible = show;
+		if (tree != nullptr)
+		{
+			if (!visible)
+			{
+				tree->ReleaseElementState(*this);
+			}
+			tree->Invalidate(GetAbsoluteBounds());
+		}
+	}
+	void VisualElement::Enable(bool enable) noexcept
+	{
+		if (enabled == enable)
+		{
+			return;
+		}
+
+		enabled = enable;
+		if (tree != nullptr)
+		{
+			if (!enabled)
+			{
+				tree->ReleaseElementState(*this);
+			}
+			tree->Invalidate(GetAbsoluteBounds());
+		}
+	}
+
+	auto VisualElement::HasFocus() const noexcept -> bool
+	{
+		return tree != nullptr && tree->GetFocusedElement() == this;
+	}
+	void VisualElement::Focus() noexcept
+	{
+		if (tree != nullptr)
+		{
+			tree->SetFocus(this);
+		}
+	}
+
+	void VisualElement::CaptureMouse() noexcept
+	{
+		if (tree != nullptr)
+		{
+			tree->SetCapture(this);
+		}
+	}
+	void VisualElement::ReleaseMouse() noexcept
+	{
+		if (tree != nullptr && tree->GetCapturedElement() == this)
+		{
+			tree->ReleaseCapture();
+		}
+	}
+
+	void VisualElement::Invalidate() const noexcept
+	{
+		if (tree != nullptr && visible)
+		{
+			tree->Invalidate(GetAbsoluteBounds());
+		}
+	}
+
+	auto VisualElement::HitTest(PointF localPoint) const noexcept -> bool
+	{
+		return localPoint.x >= 0 && localPoint.y >= 0 &&
+			localPoint.x < bounds.Width() && localPoint.y < bounds.Height();
+	}
+
+	void VisualElement::SetTree(VisualTree* newTree) noexcept
+	{
+		if (tree == newTree)
+		{
+			return;
+		}
+
+		tree = newTree;
+		if (tree != nullptr)
+		{
+			OnAttached();
+		}
+		else
+		{
+			OnDetached();
+		}
+
+		for (const auto& child : children)
+		{
+			child->SetTree(newTree);
+		}
+	}
+
+#pragma endregion
+
+#pragma region VisualTree
+
+	VisualTree::VisualTree() noexcept
+	{
+		root.tree = this;
+	}
+
+	void VisualTree::Invalidate(RectF rect) const
+	{
+		if (invalidateCallback && rect.Width() > 0 && rect.Height() > 0)
+		{
+			invalidateCallback(rect);
+		}
+	}
+
+	auto VisualTree::HitTest(PointF point) const noexcept -> VisualElement*
+	{
+		return HitTestElement(const_cast<VisualElement&>(root), point, PointF{ });
+	}
+
+	auto VisualTree::RouteInput(InputEvent event) -> bool
+	{
+		switch (event.type)
+		{
+			using enum InputEventType;
+
+			case MouseMove:
+			{
+				auto* target = captured != nullptr ? captured : HitTest(event.position);
+				if (captured == nullptr)
+				{
+					UpdateHover(target, event);
+				}
+				return Dispatch(target, event);
+			}
+			case MouseLeave:
+			{
+				if (captured == nullptr)
+				{
+					UpdateHover(nullptr, event);
+				}
+				return false;
+			}
+			case MouseDown:
+			{
+				auto* target = captured != nullptr ? captured : HitTest(event.position);
+				for (auto* e = target; e != nullptr; e = e->parent)
+				{
+					if (e->focusable && e->enabled)
+					{
+						SetFocus(e);
+						break;
+					}
+				}
+				return Dispatch(target, event);
+			}
+			case MouseUp:
+			{
+				return Dispatch(captured != nullptr ? captured : HitTest(event.position), event);
+			}
+			case MouseWheel:
+			{
+				// Wheel goes to the element under the cursor first so inner scrollables win
+				return Dispatch(HitTest(event.position), event);
+			}
+			case KeyDown:
+			{
+				if (Dispatch(focused, event))
+				{
+					return true;
+				}
+				if (event.key == TabKey)
+				{
+					MoveFocus(!IsFlagSet(event.modifiers, ModifierKeys::Shift));
+					return true;
+				}
+				return false;
+			}
+			case KeyUp:
+			case Char:
+			{
+				return Dispatch(focused, event);
+			}
+			case MouseEnter:
+			{
+				return false;
+			}
+		}
+
+		return false;
+	}
+
+	void VisualTree::SetFocus(VisualElement* element) noexcept
+	{
+		if (element == focused)
+		{
+			return;
+		}
+
+		auto* old = focused;
+		focused = element;
+
+		if (old != nullptr)
+		{
+			old->OnFocusChanged(false);
+			old->Invalidate();
+		}
+		if (focused != nullptr)
+		{
+			focused->OnFocusChanged(true);
+			focused->Invalidate();
+		}
+	}
+	void VisualTree::MoveFocus(bool forward) noexcept
+	{
+		std::vector<VisualElement*> focusables;
+		ForEachElement([&focusables](VisualElement& element)
+		{
+			if (!element.focusable)
+			{
+				return;
+			}
+			for (const auto* e = &element; e != nullptr; e = e->parent)
+			{
+				if (!e->visible || !e->enabled)
+				{
+					return;
+				}
+			}
+			focusables.push_back(&element);
+		});
+
+		if (focusables.empty())
+		{
+			return;
+		}
+
+		auto iter = std::ranges::find(focusables, focused);
+		if (iter == focusables.end())
+		{
+			SetFocus(forward ? focusables.front() : focusables.back());
+			return;
+		}
+
+		const auto count = focusables.size();
+		const auto index = static_cast<std::size_t>(std::distance(focusables.begin(), iter));
+		SetFocus(focusables[forward ? (index + 1) % count : (index + count - 1) % count]);
+	}
+
+	void VisualTree::SetCapture(VisualElement* element) noexcept
+	{
+		captured = element;
+	}
+	void VisualTree::ReleaseCapture() noexcept
+	{
+		captured = nullptr;
+	}
+
+	void VisualTree::Render(const RenderCallback& render, std::optional<RectF> clipRect) const
+	{
+		for (const auto& child : root.children)
+		{
+			RenderElement(*child, root.bounds.TopLeft(), render, clipRect);
+		}
+	}
+	void VisualTree::ForEachElement(const ElementCallback& callback) const
+	{
+		for (const auto& child : root.children)
+		{
+			ForEachElement(*child, callback);
+		}
+	}
+
+	void VisualTree::ReleaseElementState(const VisualElement& element) noexcept
+	{
+		if (element.IsAncestorOf(focused))
+		{
+			SetFocus(nullptr);
+		}
+		if (element.IsAncestorOf(hovered))
+		{
+			hovered = nullptr;
+		}
+		if (element.IsAncestorOf(captured))
+		{
+			captured = nullptr;
+		}
+	}
+
+	void VisualTree::UpdateHover(VisualElement* newHovered, const InputEvent& event)
+	{
+		if (newHovered == hovered)
+		{
+			return;
+		}
+
+		auto* old = hovered;
+		hovered = newHovered;
+
+		if (old != nullptr)
+		{
+			InputEvent leave = event;
+			leave.type = InputEventType::MouseLeave;
+			leave.position = old->ToLocal(event.position);
+			old->OnInput(leave);
+		}
+		if (hovered != nullptr)
+		{
+			InputEvent enter = event;
+			enter.type = InputEventType::MouseEnter;
+			enter.position = hovered->ToLocal(event.position);
+			hovered->OnInput(enter);
+		}
+	}
+
+	auto VisualTree::Dispatch(VisualElement* target, InputEvent event) -> bool
+	{
+		const auto treePosition = event.position;
+
+		for (auto* e = target; e != nullptr; e = e->parent)
+		{
+			if (!e->enabled)
+			{
+				continue;
+			}
+
+			event.position = e->ToLocal(treePosition);
+			if (e->OnInput(event))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	auto VisualTree::HitTestElement(VisualElement& element, PointF point, PointF parentOffset) noexcept -> VisualElement*
+	{
+		if (!element.visible || !element.hitTestVisible)
+		{
+			return nullptr;
+		}
+
+		const auto offset = parentOffset + element.bounds.TopLeft();
+		const auto localPoint = point - offset;
+
+		if (!element.HitTest(localPoint))
+		{
+			return nullptr;
+		}
+
+		// Later children are drawn on top
+		for (const auto& child : element.children | std::views::reverse)
+		{
+			if (auto* hit = HitTestElement(*child, point, offset);
+				hit != nullptr)
+			{
+				return hit;
+			}
+		}
+
+		return &element;
+	}
+
+	void VisualTree::RenderElement(VisualElement& element, PointF parentOffset,
+		const RenderCallback& render, const std::optional<RectF>& clipRect)
+	{
+		if (!element.visible)
+		{
+			return;
+		}
+
+		const auto absolute = element.bounds.Shifted(parentOffset.x, parentOffset.y);
+		if (clipRect && !absolute.IsIntersectingRect(*clipRect))
+		{
+			return;
+		}
+
+		render(element, absolute);
+
+		for (const auto& child : element.children)
+		{
+			RenderElement(*child, absolute.TopLeft(), render, clipRect);
+		}
+	}
+
+	void VisualTree::ForEachElement(VisualElement& element, const ElementCallback& callback)
+	{
+		callback(element);
+		for (const auto& child : element.children)
+		{
+			ForEachElement(*child, callback);
+		}
+	}
+
+#pragma endregion
+}
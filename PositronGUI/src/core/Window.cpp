@@ -1,6 +1,7 @@
 #include "core/Window.hpp"
 
 #include <bit>
+#include <cmath>
 #include <algorithm>
 #include <ranges>
 
@@ -16,6 +17,15 @@ namespace PGUI::Core
 	{
 		InvalidateRect(hWnd, nullptr, false);
 	}
+	void Window::Invalidate(RectF rect) const noexcept
+	{
+		// Round outwards so antialiased edges are included
+		RECT rc{
+			static_cast<LONG>(std::floor(rect.left)), static_cast<LONG>(std::floor(rect.top)),
+			static_cast<LONG>(std::ceil(rect.right)), static_cast<LONG>(std::ceil(rect.bottom))
+		};
+		InvalidateRect(hWnd, &rc, false);
+	}
 
 	void Window::RemoveChildWindow(HWND childHwnd)
 	{
@@ -297,12 +307,13 @@ namespace PGUI::Core
 
 	void Window::RegisterMessageHandler(UINT msg, const Handler& handler) noexcept
 	{
-		handlerMap[msg].push_back(handler);
+		auto& ownedHandler = ownedHandlers.emplace_back(handler);
+		dispatchTable.Add(msg, MessageHandlerRef::FromCallable(ownedHandler));
 	}
 	
 	void Window::RemoveGeneralHandler()
 	{
-		generalHandler.reset();
+		generalHandler = MessageHandlerRef{ };
 	}
 
 	auto Window::OnDPIChange(float dpiScale, RectI suggestedRect) -> HandlerResult
@@ -366,6 +377,16 @@ namespace PGUI::Core
 		return hWnd == other.hWnd;
 	}
 
+	auto Window::GetDispatcher() const -> std::shared_ptr<Dispatcher>
+	{
+		const auto windowThreadId = GetWindowThreadProcessId(hWnd, nullptr);
+		if (windowThreadId == GetCurrentThreadId())
+		{
+			static_cast<void>(Dispatcher::GetForCurrentThread());
+		}
+		return Dispatcher::GetForThread(windowThreadId);
+	}
+
 	auto _WindowProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam) -> LRESULT
 	{
 		if (msg == WM_NCCREATE)
@@ -388,6 +409,11 @@ namespace PGUI::Core
 			return result;
 		}
 
+		if (window->messageRecorder != nullptr)
+		{
+			window->messageRecorder->push_back(RecordedMessage{ msg, wParam, lParam });
+		}
+
 		if (msg == WM_TIMER)
 		{
 			if (auto id = wParam;
@@ -398,45 +424,19 @@ namespace PGUI::Core
 			}
 		}
 
-		else if (!window->handlerMap.contains(msg))
+		auto [dispatchResult, handled, passToDefWindowProc] = window->dispatchTable.Dispatch(msg, wParam, lParam);
+		if (!handled && msg != WM_TIMER)
 		{
-			if (window->generalHandler.has_value())
+			if (window->generalHandler)
 			{
-				result = window->generalHandler.value()(msg, wParam, lParam).result;
+				result = window->generalHandler(msg, wParam, lParam).result;
 				return result;
 			}
 			result = DefWindowProcW(hWnd, msg, wParam, lParam);
 			return result;
 		}
+		result = dispatchResult;
 
-		bool passToDefWindowProc = false;
-		bool forceCurrentResult = false;
-		for (auto const& handler : window->handlerMap[msg])
-		{
-			auto [lResult, flags] = std::invoke(handler, msg, wParam, lParam);
-			using enum HandlerResultFlag;
-
-			if (!(flags & ReturnPrevResult))
-			{
-				result = lResult;
-			}
-			if ((flags & NoFurtherHandling) != Nothing)
-			{
-				break;
-			}
-			if (forceCurrentResult)
-			{
-				continue;
-			}
-			if ((flags & ForceThisResult) != Nothing)
-			{
-				forceCurrentResult = true;
-			}
-			if ((flags & PassToDefWindowProc) != Nothing)
-			{
-				passToDefWindowProc = true;
-			}
-		}
 		if (passToDefWindowProc)
 		{
 			DefWindowProcW(hWnd, msg, wParam, lParam);
@@ -0,0 +1,187 @@
+#include "graphics/BitmapAtlas.hpp"
+#include "ui/bmp/BitmapSource.hpp"
+#include "factories/WICFactory.hpp"
+#include "helpers/HelperFunctions.hpp"
+
+#include <optional>
+#include <span>
+#include <utility>
+
+
+namespace PGUI::Graphics
+{
+	namespace
+	{
+		// Below this a full set of pages is mostly holes, so packing again is worth more than evicting
+		constexpr auto RepackOccupancy = 0.85;
+	}
+
+	BitmapAtlas::BitmapAtlas(Graphics graphics, SizeU pageSize, std::size_t maxPageCount) :
+		graphics{ std::move(graphics) }, allocator{ pageSize, maxPageCount }
+	{
+	}
+
+	auto BitmapAtlas::GetForCurrentThread(const Graphics& graphics) -> BitmapAtlas&
+	{
+		thread_local std::optional<BitmapAtlas> atlas;
+		if (!atlas.has_value())
+		{
+			atlas.emplace(graphics);
+		}
+		return *atlas;
+	}
+
+	auto BitmapAtlas::Add(const UI::Bmp::BitmapSource& bmpSrc) -> std::optional<AtlasEntryId>
+	{
+		const auto size = bmpSrc.GetSize();
+		if (!allocator.CanEverFit(size))
+		{
+			return std::nullopt;
+		}
+
+		ComPtr<IWICFormatConverter> converter;
+		HRESULT hr = WICFactory::GetFactory()->CreateFormatConverter(&converter); HR_T(hr);
+		hr = converter->Initialize(bmpSrc, GUID_WICPixelFormat32bppPBGRA,
+			WICBitmapDitherTypeNone, nullptr, 0.0, WICBitmapPaletteTypeCustom); HR_T(hr);
+
+		const auto stride = size.cx * 4;
+		std::vector<BYTE> pixels(static_cast<std::size_t>(stride) * size.cy);
+		hr = converter->CopyPixels(nullptr, stride, static_cast<UINT>(pixels.size()), pixels.data()); HR_T(hr);
+
+		return Add(size, pixels.data(), stride);
+	}
+
+	auto BitmapAtlas::Add(SizeU size, const void* pixels, UINT32 pitch) -> std::optional<AtlasEntryId>
+	{
+		const auto id = Allocate(size);
+		if (!id.has_value())
+		{
+			return std::nullopt;
+		}
+
+		const auto slot = *allocator.GetSlot(*id);
+		const auto padding = allocator.GetPadding();
+		const RectU paddedRect{
+			slot.rect.left - padding, slot.rect.top - padding,
+			slot.rect.right + padding, slot.rect.bottom + padding };
+
+		// Rows are whole pixels apart in everything the atlas is given
+		const std::span source{ static_cast<const std::uint32_t*>(pixels),
+			static_cast<std::size_t>(pitch / 4) * (size.cy - 1) + size.cx };
+		std::vector<std::uint32_t> padded(static_cast<std::size_t>(paddedRect.Width()) * paddedRect.Height());
+		CopyWithExtrudedPadding(size, source, pitch / 4, padding, padded);
+
+		pages[slot.page].CopyFromMemory(padded.data(), paddedRect.Width() * 4, paddedRect);
+		return id;
+	}
+
+	void BitmapAtlas::Remove(AtlasEntryId id)
+	{
+		allocator.Free(id);
+	}
+
+	auto BitmapAtlas::GetImage(AtlasEntryId id) -> std::optional<Image>
+	{
+		const auto slot = allocator.GetSlot(id);
+		if (!slot.has_value())
+		{
+			return std::nullopt;
+		}
+
+		allocator.Touch(id);
+		return Image{ pages[slot->page], slot->rect };
+	}
+
+	auto BitmapAtlas::Draw(const Graphics& g, AtlasEntryId id, RectF destRect, float opacity) -> bool
+	{
+		const auto image = GetImage(id);
+		if (!image.has_value())
+		{
+			return false;
+		}
+
+		g.DrawBitmap(image->page, destRect, opacity,
+			D2D1_BITMAP_INTERPOLATION_MODE_LINEAR, image->sourceRect);
+		return true;
+	}
+
+	void BitmapAtlas::Repack()
+	{
+		const auto moves = allocator.Repack();
+		if (moves.empty())
+		{
+			return;
+		}
+
+		/*
+		* Moved entries can land on each other's old spots, so copy from the old pages into new ones
+		* Entries that didn't move come along with the whole page copy
+		*/
+		auto oldPages = std::move(pages);
+		pages.clear();
+		CreateMissingPages();
+
+		for (std::size_t i = 0; i < pages.size() && i < oldPages.size(); i++)
+		{
+			pages[i].CopyFromBitmap(oldPages[i]);
+		}
+
+		const auto padding = allocator.GetPadding();
+		for (const auto& move : moves)
+		{
+			const RectU source{
+				move.from.rect.left - padding, move.from.rect.top - padding,
+				move.from.rect.right + padding, move.from.rect.bottom + padding };
+			const PointU destination{ move.to.rect.left - padding, move.to.rect.top - padding };
+
+			pages[move.to.page].CopyFromBitmap(oldPages[move.from.page], destination, source);
+		}
+	}
+
+	auto BitmapAtlas::Allocate(SizeU size) -> std::optional<AtlasEntryId>
+	{
+		if (!allocator.CanEverFit(size))
+		{
+			return std::nullopt;
+		}
+
+		auto id = allocator.Allocate(size);
+		if (!id.has_value() && allocator.GetOccupancy() < RepackOccupancy)
+		{
+			Repack();
+			id = allocator.Allocate(size);
+		}
+
+		while (!id.has_value())
+		{
+			const auto leastRecentlyUsed = allocator.GetLeastRecentlyUsed();
+			if (!leastRecentlyUsed.has_value())
+			{
+				break;
+			}
+
+			allocator.Free(*leastRecentlyUsed);
+			evictionCount++;
+			id = allocator.Allocate(size);
+		}
+
+		CreateMissingPages();
+		return id;
+	}
+
+	auto BitmapAtlas::CreatePage() const -> GraphicsBitmap
+	{
+		const D2D1_BITMAP_PROPERTIES props{
+			D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED), 96.0F, 96.0F };
+
+		return graphics.CreateBitmap(allocator.GetPageSize(), props);
+	}
+
+	void BitmapAtlas::CreateMissingPages()
+	{
+		while (pages.size() < allocator.GetPageCount())
+		{
+			pages.push_back(CreatePage());
+		}
+	}
+}
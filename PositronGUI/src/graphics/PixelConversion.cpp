@@ -0,0 +1,733 @@
+#include "graphics/PixelConversion.hpp"
+
+#include "helpers/CpuFeatures.hpp"
+
+#if PGUI_X86
+#include <immintrin.h>
+#endif
+
+#include <array>
+#include <cmath>
+
+
+namespace PGUI::Graphics
+{
+	namespace
+	{
+		constexpr std::uint32_t AlphaMask = 0xFF000000U;
+		constexpr auto InverseMaxUnorm = 1.0F / 255.0F;
+		// Linear values are quantized to this many steps before looking up their sRGB encoding, enough to be exact at 8 bits
+		constexpr std::size_t SrgbEncodeSteps = 4096;
+
+		struct ConversionTables
+		{
+			std::array<float, 256> srgbToLinear{ };
+			std::array<std::uint16_t, 256> unormToHalf{ };
+			std::array<std::uint16_t, 256> srgbToLinearHalf{ };
+			std::array<std::uint32_t, SrgbEncodeSteps> linearToSrgb{ };
+		};
+
+		[[nodiscard]] auto BuildConversionTables() noexcept -> ConversionTables
+		{
+			ConversionTables tables;
+
+			for (std::uint32_t i = 0; i < 256; i++)
+			{
+				const auto value = static_cast<double>(i) / 255.0;
+				const auto linear = value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4);
+
+				tables.srgbToLinear[i] = static_cast<float>(linear);
+				tables.unormToHalf[i] = pixel_detail::FloatToHalf(static_cast<float>(i) * InverseMaxUnorm);
+				tables.srgbToLinearHalf[i] = pixel_detail::FloatToHalf(tables.srgbToLinear[i]);
+			}
+
+			for (std::size_t i = 0; i < SrgbEncodeSteps; i++)
+			{
+				const auto linear = static_cast<double>(i) / (SrgbEncodeSteps - 1);
+				const auto encoded = linear <= 0.0031308 ? linear * 12.92 : 1.055 * std::pow(linear, 1.0 / 2.4) - 0.055;
+				tables.linearToSrgb[i] = static_cast<std::uint32_t>(std::lround(encoded * 255.0));
+			}
+
+			return tables;
+		}
+
+		[[nodiscard]] auto GetConversionTables() noexcept -> const ConversionTables&
+		{
+			static const auto tables = BuildConversionTables();
+			return tables;
+		}
+
+		[[nodiscard]] constexpr auto MultiplyDivide255(std::uint32_t value, std::uint32_t alpha) noexcept -> std::uint32_t
+		{
+			// value * alpha / 255 rounded, exact for 8 bit inputs
+			const auto product = value * alpha + 128;
+			return (product + (product >> 8)) >> 8;
+		}
+
+		[[nodiscard]] constexpr auto Expand5To8(std::uint32_t value) noexcept
+		{
+			return (value << 3) | (value >> 2);
+		}
+		[[nodiscard]] constexpr auto Expand6To8(std::uint32_t value) noexcept
+		{
+			return (value << 2) | (value >> 4);
+		}
+
+		[[nodiscard]] auto ClampUnit(float value) noexcept -> float
+		{
+			// Written so NaN goes to 0 like the SIMD max/min pair does
+			return value > 0.0F ? (value < 1.0F ? value : 1.0F) : 0.0F;
+		}
+
+		#pragma region Scalar
+
+		void SwapRedBlueScalar(const std::uint32_t* source, std::uint32_t* destination, std::size_t count) noexcept
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+				const auto pixel = source[i];
+				destination[i] = (pixel & 0xFF00FF00U) | ((pixel >> 16) & 0xFFU) | ((pixel & 0xFFU) << 16);
+			}
+		}
+
+		void PremultiplyScalar(const std::uint32_t* source, std::uint32_t* destination, std::size_t count) noexcept
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+				const auto pixel = source[i];
+				const auto alpha = pixel >> 24;
+
+				destination[i] = (pixel & AlphaMask) |
+					(MultiplyDivide255((pixel >> 16) & 0xFFU, alpha) << 16) |
+					(MultiplyDivide255((pixel >> 8) & 0xFFU, alpha) << 8) |
+					MultiplyDivide255(pixel & 0xFFU, alpha);
+			}
+		}
+
+		void UnpremultiplyScalar(const std::uint32_t* source, std::uint32_t* destination, std::size_t count) noexcept
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+				const auto pixel = source[i];
+				const auto alpha = pixel >> 24;
+				if (alpha == 0)
+				{
+					destination[i] = 0;
+					continue;
+				}
+
+				const auto unpremultiply = [alpha](std::uint32_t value)
+				{
+					// value * 255 / alpha rounded half up, premultiplied values over alpha are clamped
+					return std::min((value * 510 + alpha) / (2 * alpha), 255U);
+				};
+
+				destination[i] = (pixel & AlphaMask) |
+					(unpremultiply((pixel >> 16) & 0xFFU) << 16) |
+					(unpremultiply((pixel >> 8) & 0xFFU) << 8) |
+					unpremultiply(pixel & 0xFFU);
+			}
+		}
+
+		void Gray8ToBgra8Scalar(const std::uint8_t* source, std::uint32_t* destination, std::size_t count) noexcept
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+				destination[i] = AlphaMask | (source[i] * 0x010101U);
+			}
+		}
+
+		void Bgr565ToBgra8Scalar(const std::uint16_t* source, std::uint32_t* destination, std::size_t count) noexcept
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+				const std::uint32_t pixel = source[i];
+				destination[i] = AlphaMask |
+					(Expand5To8(pixel >> 11) << 16) |
+					(Expand6To8((pixel >> 5) & 0x3FU) << 8) |
+					Expand5To8(pixel & 0x1FU);
+			}
+		}
+
+		void Bgra8ToBgr565Scalar(const std::uint32_t* source, std::uint16_t* destination, std::size_t count) noexcept
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+				const auto pixel = source[i];
+				const auto red = (((pixel >> 16) & 0xFFU) * 31 + 127) / 255;
+				const auto green = (((pixel >> 8) & 0xFFU) * 63 + 127) / 255;
+				const auto blue = ((pixel & 0xFFU) * 31 + 127) / 255;
+
+				destination[i] = static_cast<std::uint16_t>((red << 11) | (green << 5) | blue);
+			}
+		}
+
+		void Bgra8ToRgba16FloatScalar(const std::uint32_t* source, std::uint64_t* destination,
+			std::size_t count, bool srgbToLinear) noexcept
+		{
+			const auto& tables = GetConversionTables();
+			const auto& colorTable = srgbToLinear ? tables.srgbToLinearHalf : tables.unormToHalf;
+
+			for (std::size_t i = 0; i < count; i++)
+			{
+				const auto pixel = source[i];
+				destination[i] =
+					static_cast<std::uint64_t>(colorTable[(pixel >> 16) & 0xFFU]) |
+					(static_cast<std::uint64_t>(colorTable[(pixel >> 8) & 0xFFU]) << 16) |
+					(static_cast<std::uint64_t>(colorTable[pixel & 0xFFU]) << 32) |
+					(static_cast<std::uint64_t>(tables.unormToHalf[pixel >> 24]) << 48);
+			}
+		}
+
+		void Rgba16FloatToBgra8Scalar(const std::uint64_t* source, std::uint32_t* destination,
+			std::size_t count, bool linearToSrgb) noexcept
+		{
+			const auto& tables = GetConversionTables();
+
+			const auto toUnorm = [](std::uint64_t half)
+			{
+				const auto value = ClampUnit(pixel_detail::HalfToFloat(static_cast<std::uint16_t>(half)));
+				return static_cast<std::uint32_t>(std::nearbyint(value * 255.0F));
+			};
+			const auto toColor = [&tables, linearToSrgb, toUnorm](std::uint64_t half)
+			{
+				if (!linearToSrgb)
+				{
+					return toUnorm(half);
+				}
+				const auto value = ClampUnit(pixel_detail::HalfToFloat(static_cast<std::uint16_t>(half)));
+				return tables.linearToSrgb[static_cast<std::size_t>(std::nearbyint(value * (SrgbEncodeSteps - 1)))];
+			};
+
+			for (std::size_t i = 0; i < count; i++)
+			{
+				const auto pixel = source[i];
+				destination[i] =
+					(toColor(pixel & 0xFFFFU) << 16) |
+					(toColor((pixel >> 16) & 0xFFFFU) << 8) |
+					toColor((pixel >> 32) & 0xFFFFU) |
+					(toUnorm(pixel >> 48) << 24);
+			}
+		}
+
+		#pragma endregion
+
+#if PGUI_X86
+		#pragma region Sse41
+
+		PGUI_TARGET_SSE41 void SwapRedBlueSse41(const std::uint32_t* source, std::uint32_t* destination, std::size_t count) noexcept
+		{
+			const auto order = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+			std::size_t i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				const auto pixels = _mm_loadu_si128(std::bit_cast<const __m128i*>(source + i));
+				_mm_storeu_si128(std::bit_cast<__m128i*>(destination + i), _mm_shuffle_epi8(pixels, order));
+			}
+
+			SwapRedBlueScalar(source + i, destination + i, count - i);
+		}
+
+		PGUI_TARGET_SSE41 auto MultiplyDivide255Sse41(__m128i values, __m128i alphas) noexcept -> __m128i
+		{
+			const auto product = _mm_add_epi16(_mm_mullo_epi16(values, alphas), _mm_set1_epi16(128));
+			return _mm_srli_epi16(_mm_add_epi16(product, _mm_srli_epi16(product, 8)), 8);
+		}
+
+		PGUI_TARGET_SSE41 void PremultiplySse41(const std::uint32_t* source, std::uint32_t* destination, std::size_t count) noexcept
+		{
+			const auto zero = _mm_setzero_si128();
+			const auto alphaMask = _mm_set1_epi32(static_cast<int>(AlphaMask));
+			// Alpha word of each pixel into all four of its words
+			const auto spreadAlpha = _mm_setr_epi8(6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15);
+
+			std::size_t i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				const auto pixels = _mm_loadu_si128(std::bit_cast<const __m128i*>(source + i));
+				const auto low = _mm_unpacklo_epi8(pixels, zero);
+				const auto high = _mm_unpackhi_epi8(pixels, zero);
+
+				const auto result = _mm_packus_epi16(
+					MultiplyDivide255Sse41(low, _mm_shuffle_epi8(low, spreadAlpha)),
+					MultiplyDivide255Sse41(high, _mm_shuffle_epi8(high, spreadAlpha)));
+
+				_mm_storeu_si128(std::bit_cast<__m128i*>(destination + i),
+					_mm_blendv_epi8(result, pixels, alphaMask));
+			}
+
+			PremultiplyScalar(source + i, destination + i, count - i);
+		}
+
+		PGUI_TARGET_SSE41 void UnpremultiplySse41(const std::uint32_t* source, std::uint32_t* destination, std::size_t count) noexcept
+		{
+			const auto byteMask = _mm_set1_epi32(0xFF);
+			const auto half = _mm_set1_ps(0.5F);
+			const auto scale = _mm_set1_ps(255.0F);
+
+			std::size_t i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				const auto pixels = _mm_loadu_si128(std::bit_cast<const __m128i*>(source + i));
+				const auto alphas = _mm_srli_epi32(pixels, 24);
+				const auto alphasFloat = _mm_cvtepi32_ps(alphas);
+
+				auto result = _mm_slli_epi32(alphas, 24);
+				for (int shift = 0; shift < 24; shift += 8)
+				{
+					// Correctly rounded division, so ties come out as in the scalar version
+					const auto values = _mm_and_si128(_mm_srl_epi32(pixels, _mm_cvtsi32_si128(shift)), byteMask);
+					const auto quotient = _mm_div_ps(_mm_mul_ps(_mm_cvtepi32_ps(values), scale), alphasFloat);
+					const auto rounded = _mm_min_epi32(_mm_cvttps_epi32(_mm_add_ps(quotient, half)), byteMask);
+					result = _mm_or_si128(result, _mm_sll_epi32(rounded, _mm_cvtsi32_si128(shift)));
+				}
+
+				const auto transparent = _mm_cmpeq_epi32(alphas, _mm_setzero_si128());
+				_mm_storeu_si128(std::bit_cast<__m128i*>(destination + i), _mm_andnot_si128(transparent, result));
+			}
+
+			UnpremultiplyScalar(source + i, destination + i, count - i);
+		}
+
+		PGUI_TARGET_SSE41 void Gray8ToBgra8Sse41(const std::uint8_t* source, std::uint32_t* destination, std::size_t count) noexcept
+		{
+			const auto alphaMask = _mm_set1_epi32(static_cast<int>(AlphaMask));
+			const auto spread = _mm_setr_epi8(0, 0, 0, -1, 1, 1, 1, -1, 2, 2, 2, -1, 3, 3, 3, -1);
+
+			std::size_t i = 0;
+			for (; i + 16 <= count; i += 16)
+			{
+				auto grays = _mm_loadu_si128(std::bit_cast<const __m128i*>(source + i));
+				for (std::size_t j = 0; j < 16; j += 4)
+				{
+					_mm_storeu_si128(std::bit_cast<__m128i*>(destination + i + j),
+						_mm_or_si128(_mm_shuffle_epi8(grays, spread), alphaMask));
+					grays = _mm_srli_si128(grays, 4);
+				}
+			}
+
+			Gray8ToBgra8Scalar(source + i, destination + i, count - i);
+		}
+
+		PGUI_TARGET_SSE41 void Bgr565ToBgra8Sse41(const std::uint16_t* source, std::uint32_t* destination, std::size_t count) noexcept
+		{
+			const auto alphaMask = _mm_set1_epi32(static_cast<int>(AlphaMask));
+			const auto mask5 = _mm_set1_epi32(0x1F);
+			const auto mask6 = _mm_set1_epi32(0x3F);
+
+			std::size_t i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				const auto pixels = _mm_cvtepu16_epi32(_mm_loadl_epi64(std::bit_cast<const __m128i*>(source + i)));
+				const auto red = _mm_srli_epi32(pixels, 11);
+				const auto green = _mm_and_si128(_mm_srli_epi32(pixels, 5), mask6);
+				const auto blue = _mm_and_si128(pixels, mask5);
+
+				const auto red8 = _mm_or_si128(_mm_slli_epi32(red, 3), _mm_srli_epi32(red, 2));
+				const auto green8 = _mm_or_si128(_mm_slli_epi32(green, 2), _mm_srli_epi32(green, 4));
+				const auto blue8 = _mm_or_si128(_mm_slli_epi32(blue, 3), _mm_srli_epi32(blue, 2));
+
+				const auto result = _mm_or_si128(_mm_or_si128(alphaMask, _mm_slli_epi32(red8, 16)),
+					_mm_or_si128(_mm_slli_epi32(green8, 8), blue8));
+				_mm_storeu_si128(std::bit_cast<__m128i*>(destination + i), result);
+			}
+
+			Bgr565ToBgra8Scalar(source + i, destination + i, count - i);
+		}
+
+		PGUI_TARGET_SSE41 auto Divide255Sse41(__m128i values) noexcept -> __m128i
+		{
+			// Exact for values below 65535
+			return _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(values, _mm_set1_epi32(1)), _mm_srli_epi32(values, 8)), 8);
+		}
+
+		PGUI_TARGET_SSE41 void Bgra8ToBgr565Sse41(const std::uint32_t* source, std::uint16_t* destination, std::size_t count) noexcept
+		{
+			const auto byteMask = _mm_set1_epi32(0xFF);
+			const auto rounding = _mm_set1_epi32(127);
+
+			std::size_t i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				__m128i packed[2];
+				for (std::size_t j = 0; j < 2; j++)
+				{
+					const auto pixels = _mm_loadu_si128(std::bit_cast<const __m128i*>(source + i + j * 4));
+					const auto red = _mm_and_si128(_mm_srli_epi32(pixels, 16), byteMask);
+					const auto green = _mm_and_si128(_mm_srli_epi32(pixels, 8), byteMask);
+					const auto blue = _mm_and_si128(pixels, byteMask);
+
+					const auto red5 = Divide255Sse41(_mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(red, 5), red), rounding));
+					const auto green6 = Divide255Sse41(_mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(green, 6), green), rounding));
+					const auto blue5 = Divide255Sse41(_mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(blue, 5), blue), rounding));
+
+					packed[j] = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(red5, 11), _mm_slli_epi32(green6, 5)), blue5);
+				}
+				_mm_storeu_si128(std::bit_cast<__m128i*>(destination + i), _mm_packus_epi32(packed[0], packed[1]));
+			}
+
+			Bgra8ToBgr565Scalar(source + i, destination + i, count - i);
+		}
+
+		#pragma endregion
+
+		#pragma region Avx2
+
+		PGUI_TARGET_AVX2 void SwapRedBlueAvx2(const std::uint32_t* source, std::uint32_t* destination, std::size_t count) noexcept
+		{
+			const auto order = _mm256_setr_epi8(
+				2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+				2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+			std::size_t i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				const auto pixels = _mm256_loadu_si256(std::bit_cast<const __m256i*>(source + i));
+				_mm256_storeu_si256(std::bit_cast<__m256i*>(destination + i), _mm256_shuffle_epi8(pixels, order));
+			}
+
+			SwapRedBlueScalar(source + i, destination + i, count - i);
+		}
+
+		PGUI_TARGET_AVX2 auto MultiplyDivide255Avx2(__m256i values, __m256i alphas) noexcept -> __m256i
+		{
+			const auto product = _mm256_add_epi16(_mm256_mullo_epi16(values, alphas), _mm256_set1_epi16(128));
+			return _mm256_srli_epi16(_mm256_add_epi16(product, _mm256_srli_epi16(product, 8)), 8);
+		}
+
+		PGUI_TARGET_AVX2 void PremultiplyAvx2(const std::uint32_t* source, std::uint32_t* destination, std::size_t count) noexcept
+		{
+			const auto zero = _mm256_setzero_si256();
+			const auto alphaMask = _mm256_set1_epi32(static_cast<int>(AlphaMask));
+			const auto spreadAlpha = _mm256_setr_epi8(
+				6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15,
+				6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15);
+
+			std::size_t i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				const auto pixels = _mm256_loadu_si256(std::bit_cast<const __m256i*>(source + i));
+				const auto low = _mm256_unpacklo_epi8(pixels, zero);
+				const auto high = _mm256_unpackhi_epi8(pixels, zero);
+
+				const auto result = _mm256_packus_epi16(
+					MultiplyDivide255Avx2(low, _mm256_shuffle_epi8(low, spreadAlpha)),
+					MultiplyDivide255Avx2(high, _mm256_shuffle_epi8(high, spreadAlpha)));
+
+				_mm256_storeu_si256(std::bit_cast<__m256i*>(destination + i),
+					_mm256_blendv_epi8(result, pixels, alphaMask));
+			}
+
+			PremultiplyScalar(source + i, destination + i, count - i);
+		}
+
+		PGUI_TARGET_AVX2 void UnpremultiplyAvx2(const std::uint32_t* source, std::uint32_t* destination, std::size_t count) noexcept
+		{
+			const auto byteMask = _mm256_set1_epi32(0xFF);
+			const auto half = _mm256_set1_ps(0.5F);
+			const auto scale = _mm256_set1_ps(255.0F);
+
+			std::size_t i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				const auto pixels = _mm256_loadu_si256(std::bit_cast<const __m256i*>(source + i));
+				const auto alphas = _mm256_srli_epi32(pixels, 24);
+				const auto alphasFloat = _mm256_cvtepi32_ps(alphas);
+
+				auto result = _mm256_slli_epi32(alphas, 24);
+				for (int shift = 0; shift < 24; shift += 8)
+				{
+					const auto values = _mm256_and_si256(_mm256_srl_epi32(pixels, _mm_cvtsi32_si128(shift)), byteMask);
+					const auto quotient = _mm256_div_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(values), scale), alphasFloat);
+					const auto rounded = _mm256_min_epi32(_mm256_cvttps_epi32(_mm256_add_ps(quotient, half)), byteMask);
+					result = _mm256_or_si256(result, _mm256_sll_epi32(rounded, _mm_cvtsi32_si128(shift)));
+				}
+
+				const auto transparent = _mm256_cmpeq_epi32(alphas, _mm256_setzero_si256());
+				_mm256_storeu_si256(std::bit_cast<__m256i*>(destination + i), _mm256_andnot_si256(transparent, result));
+			}
+
+			UnpremultiplyScalar(source + i, destination + i, count - i);
+		}
+
+		PGUI_TARGET_AVX2 void Gray8ToBgra8Avx2(const std::uint8_t* source, std::uint32_t* destination, std::size_t count) noexcept
+		{
+			const auto alphaMask = _mm256_set1_epi32(static_cast<int>(AlphaMask));
+			const auto spread = _mm256_setr_epi8(
+				0, 0, 0, -1, 4, 4, 4, -1, 8, 8, 8, -1, 12, 12, 12, -1,
+				0, 0, 0, -1, 4, 4, 4, -1, 8, 8, 8, -1, 12, 12, 12, -1);
+
+			std::size_t i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				const auto grays = _mm256_cvtepu8_epi32(_mm_loadl_epi64(std::bit_cast<const __m128i*>(source + i)));
+				_mm256_storeu_si256(std::bit_cast<__m256i*>(destination + i),
+					_mm256_or_si256(_mm256_shuffle_epi8(grays, spread), alphaMask));
+			}
+
+			Gray8ToBgra8Scalar(source + i, destination + i, count - i);
+		}
+
+		PGUI_TARGET_AVX2 void Bgr565ToBgra8Avx2(const std::uint16_t* source, std::uint32_t* destination, std::size_t count) noexcept
+		{
+			const auto alphaMask = _mm256_set1_epi32(static_cast<int>(AlphaMask));
+			const auto mask5 = _mm256_set1_epi32(0x1F);
+			const auto mask6 = _mm256_set1_epi32(0x3F);
+
+			std::size_t i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				const auto pixels = _mm256_cvtepu16_epi32(_mm_loadu_si128(std::bit_cast<const __m128i*>(source + i)));
+				const auto red = _mm256_srli_epi32(pixels, 11);
+				const auto green = _mm256_and_si256(_mm256_srli_epi32(pixels, 5), mask6);
+				const auto blue = _mm256_and_si256(pixels, mask5);
+
+				const auto red8 = _mm256_or_si256(_mm256_slli_epi32(red, 3), _mm256_srli_epi32(red, 2));
+				const auto green8 = _mm256_or_si256(_mm256_slli_epi32(green, 2), _mm256_srli_epi32(green, 4));
+				const auto blue8 = _mm256_or_si256(_mm256_slli_epi32(blue, 3), _mm256_srli_epi32(blue, 2));
+
+				const auto result = _mm256_or_si256(_mm256_or_si256(alphaMask, _mm256_slli_epi32(red8, 16)),
+					_mm256_or_si256(_mm256_slli_epi32(green8, 8), blue8));
+				_mm256_storeu_si256(std::bit_cast<__m256i*>(destination + i), result);
+			}
+
+			Bgr565ToBgra8Scalar(source + i, destination + i, count - i);
+		}
+
+		PGUI_TARGET_AVX2 auto Divide255Avx2(__m256i values) noexcept -> __m256i
+		{
+			return _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(values, _mm256_set1_epi32(1)), _mm256_srli_epi32(values, 8)), 8);
+		}
+
+		PGUI_TARGET_AVX2 void Bgra8ToBgr565Avx2(const std::uint32_t* source, std::uint16_t* destination, std::size_t count) noexcept
+		{
+			const auto byteMask = _mm256_set1_epi32(0xFF);
+			const auto rounding = _mm256_set1_epi32(127);
+
+			std::size_t i = 0;
+			for (; i + 16 <= count; i += 16)
+			{
+				__m256i packed[2];
+				for (std::size_t j = 0; j < 2; j++)
+				{
+					const auto pixels = _mm256_loadu_si256(std::bit_cast<const __m256i*>(source + i + j * 8));
+					const auto red = _mm256_and_si256(_mm256_srli_epi32(pixels, 16), byteMask);
+					const auto green = _mm256_and_si256(_mm256_srli_epi32(pixels, 8), byteMask);
+					const auto blue = _mm256_and_si256(pixels, byteMask);
+
+					const auto red5 = Divide255Avx2(_mm256_add_epi32(_mm256_sub_epi32(_mm256_slli_epi32(red, 5), red), rounding));
+					const auto green6 = Divide255Avx2(_mm256_add_epi32(_mm256_sub_epi32(_mm256_slli_epi32(green, 6), green), rounding));
+					const auto blue5 = Divide255Avx2(_mm256_add_epi32(_mm256_sub_epi32(_mm256_slli_epi32(blue, 5), blue), rounding));
+
+					packed[j] = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi32(red5, 11), _mm256_slli_epi32(green6, 5)), blue5);
+				}
+
+				// packus works within 128 bit lanes, put the quarters back in order
+				const auto words = _mm256_permute4x64_epi64(_mm256_packus_epi32(packed[0], packed[1]), 0b11011000);
+				_mm256_storeu_si256(std::bit_cast<__m256i*>(destination + i), words);
+			}
+
+			Bgra8ToBgr565Scalar(source + i, destination + i, count - i);
+		}
+
+		PGUI_TARGET_AVX2_F16C auto ToHalfAvx2(__m256i values, const float* linearTable) noexcept -> __m128i
+		{
+			const auto floats = linearTable != nullptr ?
+				_mm256_i32gather_ps(linearTable, values, 4) :
+				_mm256_mul_ps(_mm256_cvtepi32_ps(values), _mm256_set1_ps(InverseMaxUnorm));
+			return _mm256_cvtps_ph(floats, _MM_FROUND_TO_NEAREST_INT);
+		}
+
+		PGUI_TARGET_AVX2_F16C void Bgra8ToRgba16FloatAvx2(const std::uint32_t* source, std::uint64_t* destination,
+			std::size_t count, bool srgbToLinear) noexcept
+		{
+			const auto* colorTable = srgbToLinear ? GetConversionTables().srgbToLinear.data() : nullptr;
+			const auto byteMask = _mm256_set1_epi32(0xFF);
+
+			std::size_t i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				const auto pixels = _mm256_loadu_si256(std::bit_cast<const __m256i*>(source + i));
+				const auto red = ToHalfAvx2(_mm256_and_si256(_mm256_srli_epi32(pixels, 16), byteMask), colorTable);
+				const auto green = ToHalfAvx2(_mm256_and_si256(_mm256_srli_epi32(pixels, 8), byteMask), colorTable);
+				const auto blue = ToHalfAvx2(_mm256_and_si256(pixels, byteMask), colorTable);
+				const auto alpha = ToHalfAvx2(_mm256_srli_epi32(pixels, 24), nullptr);
+
+				const auto redGreenLow = _mm_unpacklo_epi16(red, green);
+				const auto redGreenHigh = _mm_unpackhi_epi16(red, green);
+				const auto blueAlphaLow = _mm_unpacklo_epi16(blue, alpha);
+				const auto blueAlphaHigh = _mm_unpackhi_epi16(blue, alpha);
+
+				auto* target = std::bit_cast<__m128i*>(destination + i);
+				_mm_storeu_si128(target, _mm_unpacklo_epi32(redGreenLow, blueAlphaLow));
+				_mm_storeu_si128(target + 1, _mm_unpackhi_epi32(redGreenLow, blueAlphaLow));
+				_mm_storeu_si128(target + 2, _mm_unpacklo_epi32(redGreenHigh, blueAlphaHigh));
+				_mm_storeu_si128(target + 3, _mm_unpackhi_epi32(redGreenHigh, blueAlphaHigh));
+			}
+
+			Bgra8ToRgba16FloatScalar(source + i, destination + i, count - i, srgbToLinear);
+		}
+
+		PGUI_TARGET_AVX2_F16C auto ToUnormAvx2(const std::uint64_t* pair, const std::uint32_t* encodeTable) noexcept -> __m256i
+		{
+			const auto halves = _mm_loadu_si128(std::bit_cast<const __m128i*>(pair));
+			// max then min, so NaN ends up 0
+			const auto values = _mm256_min_ps(_mm256_max_ps(_mm256_cvtph_ps(halves), _mm256_setzero_ps()), _mm256_set1_ps(1.0F));
+			const auto unorm = _mm256_cvtps_epi32(_mm256_mul_ps(values, _mm256_set1_ps(255.0F)));
+			if (encodeTable == nullptr)
+			{
+				return unorm;
+			}
+
+			// Two pixels per vector, lanes 3 and 7 are alpha
+			const auto alphaLanes = _mm256_setr_epi32(0, 0, 0, -1, 0, 0, 0, -1);
+			const auto steps = _mm256_cvtps_epi32(_mm256_mul_ps(values, _mm256_set1_ps(static_cast<float>(SrgbEncodeSteps - 1))));
+			const auto encoded = _mm256_i32gather_epi32(std::bit_cast<const int*>(encodeTable), steps, 4);
+			return _mm256_blendv_epi8(encoded, unorm, alphaLanes);
+		}
+
+		PGUI_TARGET_AVX2_F16C void Rgba16FloatToBgra8Avx2(const std::uint64_t* source, std::uint32_t* destination,
+			std::size_t count, bool linearToSrgb) noexcept
+		{
+			const auto* encodeTable = linearToSrgb ? GetConversionTables().linearToSrgb.data() : nullptr;
+			const auto pixelOrder = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+			const auto rgbaToBgra = _mm256_setr_epi8(
+				2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+				2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+			std::size_t i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				// Pixels 0 2 4 6 end up in the low lane and 1 3 5 7 in the high one
+				const auto words0 = _mm256_packus_epi32(
+					ToUnormAvx2(source + i, encodeTable), ToUnormAvx2(source + i + 2, encodeTable));
+				const auto words1 = _mm256_packus_epi32(
+					ToUnormAvx2(source + i + 4, encodeTable), ToUnormAvx2(source + i + 6, encodeTable));
+				const auto bytes = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(words0, words1), pixelOrder);
+
+				_mm256_storeu_si256(std::bit_cast<__m256i*>(destination + i), _mm256_shuffle_epi8(bytes, rgbaToBgra));
+			}
+
+			Rgba16FloatToBgra8Scalar(source + i, destination + i, count - i, linearToSrgb);
+		}
+
+		#pragma endregion
+#endif
+
+		constexpr PixelKernels ScalarKernels{
+			PixelKernelLevel::Scalar,
+			&SwapRedBlueScalar, &PremultiplyScalar, &UnpremultiplyScalar, &Gray8ToBgra8Scalar,
+			&Bgr565ToBgra8Scalar, &Bgra8ToBgr565Scalar, &Bgra8ToRgba16FloatScalar, &Rgba16FloatToBgra8Scalar
+		};
+
+#if PGUI_X86
+		// Half floats need F16C, which isn't part of SSE4.1
+		constexpr PixelKernels Sse41Kernels{
+			PixelKernelLevel::Sse41,
+			&SwapRedBlueSse41, &PremultiplySse41, &UnpremultiplySse41, &Gray8ToBgra8Sse41,
+			&Bgr565ToBgra8Sse41, &Bgra8ToBgr565Sse41, &Bgra8ToRgba16FloatScalar, &Rgba16FloatToBgra8Scalar
+		};
+		constexpr PixelKernels Avx2Kernels{
+			PixelKernelLevel::Avx2,
+			&SwapRedBlueAvx2, &PremultiplyAvx2, &UnpremultiplyAvx2, &Gray8ToBgra8Avx2,
+			&Bgr565ToBgra8Avx2, &Bgra8ToBgr565Avx2, &Bgra8ToRgba16FloatAvx2, &Rgba16FloatToBgra8Avx2
+		};
+		constexpr PixelKernels Avx2WithoutF16cKernels{
+			PixelKernelLevel::Avx2,
+			&SwapRedBlueAvx2, &PremultiplyAvx2, &UnpremultiplyAvx2, &Gray8ToBgra8Avx2,
+			&Bgr565ToBgra8Avx2, &Bgra8ToBgr565Avx2, &Bgra8ToRgba16FloatScalar, &Rgba16FloatToBgra8Scalar
+		};
+#endif
+	}
+
+	auto GetPixelKernels() noexcept -> const PixelKernels&
+	{
+		static const auto& kernels = GetPixelKernels(PixelKernelLevel::Avx2);
+		return kernels;
+	}
+
+	auto GetPixelKernels(PixelKernelLevel level) noexcept -> const PixelKernels&
+	{
+#if PGUI_X86
+		const auto& features = CpuFeatures::Get();
+		if (level >= PixelKernelLevel::Avx2 && features.avx2)
+		{
+			return features.f16c ? Avx2Kernels : Avx2WithoutF16cKernels;
+		}
+		if (level >= PixelKernelLevel::Sse41 && features.sse41)
+		{
+			return Sse41Kernels;
+		}
+#else
+		(void)level;
+#endif
+		return ScalarKernels;
+	}
+
+	namespace pixel_detail
+	{
+		auto HalfToFloat(std::uint16_t half) noexcept -> float
+		{
+			const auto sign = static_cast<std::uint32_t>(half & 0x8000U) << 16;
+			const auto exponent = (half >> 10) & 0x1FU;
+			const auto mantissa = static_cast<std::uint32_t>(half & 0x3FFU);
+
+			if (exponent == 0)
+			{
+				// Zero or subnormal, mantissa * 2^-24 is exact in a float
+				const auto magnitude = static_cast<float>(mantissa) * 5.9604644775390625e-8F;
+				return std::bit_cast<float>(std::bit_cast<std::uint32_t>(magnitude) | sign);
+			}
+			if (exponent == 0x1F)
+			{
+				return std::bit_cast<float>(sign | 0x7F800000U | (mantissa << 13));
+			}
+			return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+		}
+
+		auto FloatToHalf(float value) noexcept -> std::uint16_t
+		{
+			const auto bits = std::bit_cast<std::uint32_t>(value);
+			const auto sign = (bits >> 16) & 0x8000U;
+			const auto magnitude = bits & 0x7FFFFFFFU;
+
+			if (magnitude >= 0x7F800000U)
+			{
+				// Infinity stays infinity, NaN keeps the top of its payload and is made quiet
+				const auto nan = magnitude > 0x7F800000U ? 0x200U | ((magnitude >> 13) & 0x3FFU) : 0U;
+				return static_cast<std::uint16_t>(sign | 0x7C00U | nan);
+			}
+
+			if (magnitude < 0x38800000U)
+			{
+				// Below the smallest normal half, 2^-25 and under round to zero
+				if (magnitude <= 0x33000000U)
+				{
+					return static_cast<std::uint16_t>(sign);
+				}
+
+				const auto exponent = magnitude >> 23;
+				const auto mantissa = (magnitude & 0x7FFFFFU) | 0x800000U;
+				const auto shift = 126 - exponent;
+
+				auto result = mantissa >> shift;
+				const auto remainder = mantissa & ((1U << shift) - 1);
+				const auto halfway = 1U << (shift - 1);
+				if (remainder > halfway || (remainder == halfway && (result & 1U) != 0))
+				{
+					result++;
+				}
+				return static_cast<std::uint16_t>(sign | result);
+			}
+
+			auto result = (magnitude - 0x38000000U) >> 13;
+			const auto remainder = magnitude & 0x1FFFU;
+			if (remainder > 0x1000U || (remainder == 0x1000U && (result & 1U) != 0))
+			{
+				result++;
+			}
+			return static_cast<std::uint16_t>(sign | std::min(result, 0x7C00U));
+		}
+	}
+}
@@ -0,0 +1,407 @@
+#include "helpers/AtlasPacker.hpp"
+
+#include <algorithm>
+#include <tuple>
+
+
+namespace PGUI
+{
+	namespace
+	{
+		auto Contains(RectU outer, RectU inner) noexcept -> bool
+		{
+			return outer.left <= inner.left && outer.top <= inner.top &&
+				outer.right >= inner.right && outer.bottom >= inner.bottom;
+		}
+		auto RectArea(RectU rect) noexcept -> std::uint64_t
+		{
+			return static_cast<std::uint64_t>(rect.Width()) * rect.Height();
+		}
+	}
+
+	#pragma region AtlasPacker
+
+	AtlasPacker::AtlasPacker(SizeU pageSize) :
+		pageSize{ pageSize }
+	{
+		Clear();
+	}
+
+	auto AtlasPacker::Insert(SizeU size) -> std::optional<RectU>
+	{
+		if (size.cx == 0 || size.cy == 0)
+		{
+			return std::nullopt;
+		}
+
+		// Best short side fit, ties go to the top left most spot so layouts are deterministic
+		const RectU* best = nullptr;
+		auto bestScore = std::tuple{ UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX };
+		for (const auto& freeRect : freeRects)
+		{
+			if (freeRect.Width() < size.cx || freeRect.Height() < size.cy)
+			{
+				continue;
+			}
+
+			const auto leftoverX = freeRect.Width() - size.cx;
+			const auto leftoverY = freeRect.Height() - size.cy;
+			const auto score = std::tuple{
+				std::min(leftoverX, leftoverY), std::max(leftoverX, leftoverY), freeRect.top, freeRect.left };
+
+			if (score < bestScore)
+			{
+				bestScore = score;
+				best = &freeRect;
+			}
+		}
+
+		if (best == nullptr)
+		{
+			return std::nullopt;
+		}
+
+		const RectU placed{ PointU{ best->left, best->top }, size };
+		SplitFreeRects(placed);
+
+		usedArea += RectArea(placed);
+		return placed;
+	}
+
+	void AtlasPacker::Remove(RectU rect)
+	{
+		usedArea -= std::min(usedArea, RectArea(rect));
+		AddFreeRect(rect);
+	}
+
+	void AtlasPacker::Clear()
+	{
+		freeRects.assign(1, RectU{ PointU{ 0, 0 }, pageSize });
+		usedArea = 0;
+	}
+
+	auto AtlasPacker::GetOccupancy() const noexcept -> double
+	{
+		const auto pageArea = static_cast<double>(pageSize.cx) * pageSize.cy;
+		return pageArea == 0.0 ? 0.0 : static_cast<double>(usedArea) / pageArea;
+	}
+
+	void AtlasPacker::SplitFreeRects(RectU placed)
+	{
+		std::vector<RectU> pieces;
+
+		for (std::size_t i = 0; i < freeRects.size();)
+		{
+			const auto freeRect = freeRects[i];
+			if (!freeRect.IsIntersectingRect(placed))
+			{
+				i++;
+				continue;
+			}
+
+			freeRects[i] = freeRects.back();
+			freeRects.pop_back();
+
+			// What's left of freeRect on each side of placed, these overlap each other on purpose
+			if (placed.left > freeRect.left)
+			{
+				pieces.emplace_back(freeRect.left, freeRect.top, placed.left, freeRect.bottom);
+			}
+			if (placed.right < freeRect.right)
+			{
+				pieces.emplace_back(placed.right, freeRect.top, freeRect.right, freeRect.bottom);
+			}
+			if (placed.top > freeRect.top)
+			{
+				pieces.emplace_back(freeRect.left, freeRect.top, freeRect.right, placed.top);
+			}
+			if (placed.bottom < freeRect.bottom)
+			{
+				pieces.emplace_back(freeRect.left, placed.bottom, freeRect.right, freeRect.bottom);
+			}
+		}
+
+		PruneFreeRects(std::move(pieces));
+	}
+
+	void AtlasPacker::PruneFreeRects(std::vector<RectU> newRects)
+	{
+		/*
+		* The old rectangles never contain each other and a piece of a split rectangle can't contain
+		* a rectangle its parent didn't, so only the new ones need checking
+		*/
+		const auto oldCount = freeRects.size();
+		for (std::size_t i = 0; i < newRects.size(); i++)
+		{
+			const auto rect = newRects[i];
+
+			bool isContained = false;
+			for (std::size_t j = 0; j < oldCount && !isContained; j++)
+			{
+				isContained = Contains(freeRects[j], rect);
+			}
+			for (std::size_t j = 0; j < newRects.size() && !isContained; j++)
+			{
+				// Of two equal rectangles the first one stays
+				isContained = j != i && Contains(newRects[j], rect) && (newRects[j] != rect || j < i);
+			}
+
+			if (!isContained)
+			{
+				freeRects.push_back(rect);
+			}
+		}
+	}
+
+	void AtlasPacker::AddFreeRect(RectU rect)
+	{
+		// Grow rect by merging with neighbours that line up with it exactly, then drop what it covers
+		bool merged = true;
+		while (merged)
+		{
+			merged = false;
+			for (std::size_t i = 0; i < freeRects.size(); i++)
+			{
+				const auto& other = freeRects[i];
+				const bool sameColumns = rect.left == other.left && rect.right == other.right &&
+					rect.top <= other.bottom && other.top <= rect.bottom;
+				const bool sameRows = rect.top == other.top && rect.bottom == other.bottom &&
+					rect.left <= other.right && other.left <= rect.right;
+
+				if (sameColumns || sameRows)
+				{
+					rect = RectU{
+						std::min(rect.left, other.left), std::min(rect.top, other.top),
+						std::max(rect.right, other.right), std::max(rect.bottom, other.bottom) };
+					freeRects[i] = freeRects.back();
+					freeRects.pop_back();
+					merged = true;
+					break;
+				}
+			}
+		}
+
+		std::erase_if(freeRects, [rect](RectU other) { return Contains(rect, other); });
+		if (std::ranges::none_of(freeRects, [rect](RectU other) { return Contains(other, rect); }))
+		{
+			freeRects.push_back(rect);
+		}
+	}
+
+	#pragma endregion
+
+	#pragma region AtlasAllocator
+
+	AtlasAllocator::AtlasAllocator(SizeU pageSize, std::size_t maxPageCount, std::uint32_t padding) :
+		pageSize{ pageSize }, maxPageCount{ std::max(maxPageCount, std::size_t{ 1 }) }, padding{ padding }
+	{
+	}
+
+	auto AtlasAllocator::Allocate(SizeU size) -> std::optional<AtlasEntryId>
+	{
+		if (size.cx == 0 || size.cy == 0 || !CanEverFit(size))
+		{
+			return std::nullopt;
+		}
+
+		const SizeU paddedSize{ size.cx + 2 * padding, size.cy + 2 * padding };
+
+		auto place = [this](std::size_t page, RectU paddedRect)
+		{
+			const auto id = nextId++;
+			lru.push_front(id);
+			entries.emplace(id, Entry{ page, paddedRect, lru.begin() });
+			return id;
+		};
+
+		for (std::size_t i = 0; i < pages.size(); i++)
+		{
+			if (auto rect = pages[i].Insert(paddedSize))
+			{
+				return place(i, *rect);
+			}
+		}
+
+		if (pages.size() < maxPageCount)
+		{
+			auto& page = pages.emplace_back(pageSize);
+			if (auto rect = page.Insert(paddedSize))
+			{
+				return place(pages.size() - 1, *rect);
+			}
+		}
+
+		return std::nullopt;
+	}
+
+	void AtlasAllocator::Free(AtlasEntryId id)
+	{
+		auto iter = entries.find(id);
+		if (iter == entries.end())
+		{
+			return;
+		}
+
+		pages[iter->second.page].Remove(iter->second.paddedRect);
+		lru.erase(iter->second.lruPosition);
+		entries.erase(iter);
+	}
+
+	void AtlasAllocator::Touch(AtlasEntryId id)
+	{
+		if (auto iter = entries.find(id);
+			iter != entries.end())
+		{
+			lru.splice(lru.begin(), lru, iter->second.lruPosition);
+		}
+	}
+
+	auto AtlasAllocator::GetSlot(AtlasEntryId id) const -> std::optional<AtlasSlot>
+	{
+		auto iter = entries.find(id);
+		if (iter == entries.end())
+		{
+			return std::nullopt;
+		}
+		return ToSlot(iter->second);
+	}
+
+	auto AtlasAllocator::GetLeastRecentlyUsed() const noexcept -> std::optional<AtlasEntryId>
+	{
+		if (lru.empty())
+		{
+			return std::nullopt;
+		}
+		return lru.back();
+	}
+
+	auto AtlasAllocator::CanEverFit(SizeU size) const noexcept -> bool
+	{
+		return size.cx + 2ULL * padding <= pageSize.cx && size.cy + 2ULL * padding <= pageSize.cy;
+	}
+
+	auto AtlasAllocator::Repack() -> std::vector<Move>
+	{
+		std::vector<std::pair<AtlasEntryId, const Entry*>> order;
+		order.reserve(entries.size());
+		for (const auto& [id, entry] : entries)
+		{
+			order.emplace_back(id, &entry);
+		}
+
+		std::ranges::sort(order, [](const auto& a, const auto& b)
+		{
+			const auto& rectA = a.second->paddedRect;
+			const auto& rectB = b.second->paddedRect;
+			const auto keyA = std::tuple{ std::max(rectA.Width(), rectA.Height()), RectArea(rectA), b.first };
+			const auto keyB = std::tuple{ std::max(rectB.Width(), rectB.Height()), RectArea(rectB), a.first };
+			return keyA > keyB;
+		});
+
+		std::vector<AtlasPacker> packed;
+		std::vector<std::pair<std::size_t, RectU>> placements;
+		placements.reserve(order.size());
+
+		for (const auto& [id, entry] : order)
+		{
+			const auto size = entry->paddedRect.Size();
+
+			std::optional<std::pair<std::size_t, RectU>> placement;
+			for (std::size_t i = 0; i < packed.size() && !placement.has_value(); i++)
+			{
+				if (auto rect = packed[i].Insert(size))
+				{
+					placement.emplace(i, *rect);
+				}
+			}
+			if (!placement.has_value() && packed.size() < maxPageCount)
+			{
+				if (auto rect = packed.emplace_back(pageSize).Insert(size))
+				{
+					placement.emplace(packed.size() - 1, *rect);
+				}
+			}
+
+			if (!placement.has_value())
+			{
+				return { };
+			}
+			placements.push_back(*placement);
+		}
+
+		std::vector<Move> moves;
+		for (std::size_t i = 0; i < order.size(); i++)
+		{
+			const auto id = order[i].first;
+			auto& entry = entries.at(id);
+			const auto& [page, rect] = placements[i];
+
+			if (entry.page != page || entry.paddedRect != rect)
+			{
+				const auto from = ToSlot(entry);
+				entry.page = page;
+				entry.paddedRect = rect;
+				moves.push_back(Move{ id, from, ToSlot(entry) });
+			}
+		}
+
+		pages = std::move(packed);
+		return moves;
+	}
+
+	auto AtlasAllocator::GetOccupancy() const noexcept -> double
+	{
+		const auto totalArea = static_cast<double>(pageSize.cx) * pageSize.cy * static_cast<double>(pages.size());
+		if (totalArea == 0.0)
+		{
+			return 0.0;
+		}
+
+		std::uint64_t usedArea = 0;
+		for (const auto& page : pages)
+		{
+			usedArea += page.GetUsedArea();
+		}
+		return static_cast<double>(usedArea) / totalArea;
+	}
+
+	auto AtlasAllocator::ToSlot(const Entry& entry) const noexcept -> AtlasSlot
+	{
+		return AtlasSlot{ entry.page, RectU{
+			entry.paddedRect.left + padding, entry.paddedRect.top + padding,
+			entry.paddedRect.right - padding, entry.paddedRect.bottom - padding } };
+	}
+
+	#pragma endregion
+
+	void CopyWithExtrudedPadding(SizeU size, std::span<const std::uint32_t> source, std::uint32_t sourcePitch,
+		std::uint32_t padding, std::span<std::uint32_t> destination) noexcept
+	{
+		if (size.cx == 0 || size.cy == 0)
+		{
+			return;
+		}
+
+		const std::size_t paddedWidth = size.cx + 2ULL * padding;
+		auto row = [&destination, paddedWidth](std::size_t y)
+		{
+			return destination.subspan(y * paddedWidth, paddedWidth);
+		};
+
+		for (std::size_t y = 0; y < size.cy; y++)
+		{
+			const auto sourceRow = source.subspan(y * sourcePitch, size.cx);
+			const auto destinationRow = row(y + padding);
+
+			std::ranges::copy(sourceRow, destinationRow.begin() + padding);
+			std::ranges::fill(destinationRow.first(padding), sourceRow.front());
+			std::ranges::fill(destinationRow.last(padding), sourceRow.back());
+		}
+
+		for (std::size_t y = 0; y < padding; y++)
+		{
+			std::ranges::copy(row(padding), row(y).begin());
+			std::ranges::copy(row(padding + size.cy - 1), row(padding + size.cy + y).begin());
+		}
+	}
+}
@@ -0,0 +1,79 @@
+#include "helpers/CpuFeatures.hpp"
+
+#if PGUI_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#include <array>
+#include <cstddef>
+
+
+namespace PGUI
+{
+	namespace
+	{
+#if PGUI_X86
+		auto CpuId(unsigned int leaf, unsigned int subLeaf) noexcept -> std::array<unsigned int, 4>
+		{
+			std::array<unsigned int, 4> registers{ };
+#ifdef _MSC_VER
+			std::array<int, 4> values{ };
+			__cpuidex(values.data(), static_cast<int>(leaf), static_cast<int>(subLeaf));
+			for (std::size_t i = 0; i < registers.size(); i++)
+			{
+				registers[i] = static_cast<unsigned int>(values[i]);
+			}
+#else
+			__cpuid_count(leaf, subLeaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+			return registers;
+		}
+
+		auto ReadXcr0() noexcept -> unsigned long long
+		{
+#ifdef _MSC_VER
+			return _xgetbv(0);
+#else
+			unsigned int low = 0;
+			unsigned int high = 0;
+			__asm__("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+			return (static_cast<unsigned long long>(high) << 32) | low;
+#endif
+		}
+#endif
+
+		auto DetectFeatures() noexcept -> CpuFeatures
+		{
+			CpuFeatures features;
+#if PGUI_X86
+			const auto maxLeaf = CpuId(0, 0)[0];
+			if (maxLeaf < 1)
+			{
+				return features;
+			}
+
+			const auto leaf1 = CpuId(1, 0);
+			features.sse41 = (leaf1[2] & (1U << 19)) != 0;
+
+			// AVX state has to be enabled by the OS too
+			const bool osSavesYmm = (leaf1[2] & (1U << 27)) != 0 && (ReadXcr0() & 0x6) == 0x6;
+			if (maxLeaf >= 7 && osSavesYmm && (leaf1[2] & (1U << 28)) != 0)
+			{
+				features.avx2 = (CpuId(7, 0)[1] & (1U << 5)) != 0;
+			}
+			features.f16c = osSavesYmm && (leaf1[2] & (1U << 29)) != 0;
+#endif
+			return features;
+		}
+	}
+
+	auto CpuFeatures::Get() noexcept -> const CpuFeatures&
+	{
+		static const CpuFeatures features = DetectFeatures();
+		return features;
+	}
+}
@@ -0,0 +1,96 @@
+#include "helpers/MappedFile.hpp"
+
+#include "helpers/HelperFunctions.hpp"
+
+#include <utility>
+
+
+namespace PGUI
+{
+	MappedFile::MappedFile(const std::filesystem::path& path)
+	{
+		file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			HR_T(HresultFromWin32());
+		}
+
+		LARGE_INTEGER fileSize{ };
+		if (!GetFileSizeEx(file, &fileSize))
+		{
+			const auto hr = HresultFromWin32();
+			Close();
+			HR_T(hr);
+		}
+		if (fileSize.QuadPart == 0)
+		{
+			// Empty files can't be mapped
+			Close();
+			HR_T(HRESULT_FROM_WIN32(ERROR_FILE_INVALID));
+		}
+
+		mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr)
+		{
+			const auto hr = HresultFromWin32();
+			Close();
+			HR_T(hr);
+		}
+
+		data = static_cast<const std::byte*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		if (data == nullptr)
+		{
+			const auto hr = HresultFromWin32();
+			Close();
+			HR_T(hr);
+		}
+		size = static_cast<std::size_t>(fileSize.QuadPart);
+	}
+
+	MappedFile::~MappedFile() noexcept
+	{
+		Close();
+	}
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept :
+		file{ std::exchange(other.file, INVALID_HANDLE_VALUE) },
+		mapping{ std::exchange(other.mapping, nullptr) },
+		data{ std::exchange(other.data, nullptr) },
+		size{ std::exchange(other.size, 0) }
+	{
+	}
+
+	auto MappedFile::operator=(MappedFile&& other) noexcept -> MappedFile&
+	{
+		if (this != &other)
+		{
+			Close();
+			file = std::exchange(other.file, INVALID_HANDLE_VALUE);
+			mapping = std::exchange(other.mapping, nullptr);
+			data = std::exchange(other.data, nullptr);
+			size = std::exchange(other.size, 0);
+		}
+		return *this;
+	}
+
+	void MappedFile::Close() noexcept
+	{
+		if (data != nullptr)
+		{
+			UnmapViewOfFile(data);
+			data = nullptr;
+		}
+		if (mapping != nullptr)
+		{
+			CloseHandle(mapping);
+			mapping = nullptr;
+		}
+		if (file != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(file);
+			file = INVALID_HANDLE_VALUE;
+		}
+		size = 0;
+	}
+}
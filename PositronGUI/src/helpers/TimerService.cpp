@@ -0,0 +1,158 @@
+#include "helpers/TimerService.hpp"
+
+#include <algorithm>
+
+
+namespace PGUI
+{
+	auto TimerService::GetInstance() -> TimerService&
+	{
+		static TimerService instance;
+		return instance;
+	}
+
+	TimerService::TimerService() :
+		thread{ std::bind_front(&TimerService::ThreadFunction, this) }
+	{
+	}
+	TimerService::~TimerService() noexcept
+	{
+		thread.request_stop();
+		if (thread.joinable())
+		{
+			thread.join();
+		}
+	}
+
+	auto TimerService::Schedule(Duration interval, const Callback& callback, std::optional<Duration> startDelay) -> TimerId
+	{
+		return Add(interval, startDelay.value_or(interval), callback, true);
+	}
+	auto TimerService::ScheduleOnce(Duration delay, const Callback& callback) -> TimerId
+	{
+		return Add(delay, delay, callback, false);
+	}
+
+	void TimerService::Cancel(TimerId id)
+	{
+		std::unique_lock lock{ mutex };
+
+		auto iter = timers.find(id);
+		if (iter == timers.end())
+		{
+			return;
+		}
+
+		if (runningId != id)
+		{
+			// Its heap entry is skipped when it comes up
+			timers.erase(iter);
+			return;
+		}
+
+		// Running right now, the timer thread erases it once the callback returns
+		iter->second.cancelled = true;
+		if (std::this_thread::get_id() != thread.get_id())
+		{
+			callbackFinishedCondition.wait(lock, [this, id] { return runningId != id; });
+		}
+	}
+
+	auto TimerService::IsScheduled(TimerId id) const -> bool
+	{
+		std::scoped_lock lock{ mutex };
+
+		auto iter = timers.find(id);
+		return iter != timers.end() && !iter->second.cancelled;
+	}
+	auto TimerService::GetTimerCount() const -> std::size_t
+	{
+		std::scoped_lock lock{ mutex };
+		return timers.size();
+	}
+
+	auto TimerService::Add(Duration interval, Duration startDelay, const Callback& callback, bool repeating) -> TimerId
+	{
+		std::scoped_lock lock{ mutex };
+
+		const auto id = nextId++;
+		// A zero interval would make a repeating timer due forever
+		timers.emplace(id, Timer{ std::max(interval, Duration{ 1 }), callback, repeating });
+		deadlines.push(Deadline{ Clock::now() + startDelay, id });
+
+		wakeCondition.notify_one();
+
+		return id;
+	}
+
+	void TimerService::ThreadFunction(const std::stop_token& stopToken)
+	{
+		std::unique_lock lock{ mutex };
+
+		while (!stopToken.stop_requested())
+		{
+			if (deadlines.empty())
+			{
+				wakeCondition.wait(lock, stopToken, [this] { return !deadlines.empty(); });
+				continue;
+			}
+
+			if (const auto next = deadlines.top().time;
+				Clock::now() < next)
+			{
+				// Wakes up early if a timer with an earlier deadline gets added
+				wakeCondition.wait_until(lock, stopToken, next, [this, next]
+				{
+					return !deadlines.empty() && deadlines.top().time < next;
+				});
+				continue;
+			}
+
+			RunDueTimers(lock);
+		}
+	}
+
+	void TimerService::RunDueTimers(std::unique_lock<std::mutex>& lock)
+	{
+		const auto now = Clock::now();
+
+		while (!deadlines.empty() && deadlines.top().time <= now)
+		{
+			const auto [time, id] = deadlines.top();
+			deadlines.pop();
+
+			auto iter = timers.find(id);
+			if (iter == timers.end())
+			{
+				continue;
+			}
+
+			// References into unordered_map survive inserts from other threads while unlocked
+			auto& timer = iter->second;
+			runningId = id;
+
+			lock.unlock();
+			timer.callback();
+			lock.lock();
+
+			runningId = InvalidTimerId;
+			callbackFinishedCondition.notify_all();
+
+			if (timer.cancelled || !timer.repeating)
+			{
+				timers.erase(id);
+				continue;
+			}
+
+			auto nextTime = time + timer.interval;
+			if (const auto current = Clock::now();
+				nextTime <= current)
+			{
+				// Fell behind, skip the missed ticks but keep the phase
+				const auto missed = (current - time) / timer.interval;
+				nextTime = time + (missed + 1) * timer.interval;
+			}
+			deadlines.push(Deadline{ nextTime, id });
+		}
+	}
+}
@@ -0,0 +1,85 @@
+#include "helpers/WorkerPool.hpp"
+
+#include <algorithm>
+
+
+namespace PGUI
+{
+	auto WorkerPool::DefaultThreadCount() noexcept -> std::size_t
+	{
+		// Leave a core for the UI thread
+		const std::size_t hardwareThreads = std::thread::hardware_concurrency();
+		return std::max(hardwareThreads, std::size_t{ 2 }) - 1;
+	}
+
+	WorkerPool::WorkerPool(std::size_t threadCount,
+		const ThreadCallback& onThreadStart, const ThreadCallback& onThreadExit)
+	{
+		threadCount = std::max(threadCount, std::size_t{ 1 });
+		threads.reserve(threadCount);
+
+		for (std::size_t i = 0; i < threadCount; i++)
+		{
+			threads.emplace_back([this, onThreadStart, onThreadExit](const std::stop_token& stopToken)
+			{
+				ThreadFunction(stopToken, onThreadStart, onThreadExit);
+			});
+		}
+	}
+	WorkerPool::~WorkerPool() noexcept
+	{
+		for (auto& thread : threads)
+		{
+			thread.request_stop();
+		}
+		threads.clear();
+	}
+
+	void WorkerPool::Submit(Task task)
+	{
+		{
+			std::scoped_lock lock{ mutex };
+			tasks.push_back(std::move(task));
+		}
+		taskCondition.notify_one();
+	}
+
+	auto WorkerPool::GetQueuedCount() const -> std::size_t
+	{
+		std::scoped_lock lock{ mutex };
+		return tasks.size();
+	}
+
+	void WorkerPool::ThreadFunction(const std::stop_token& stopToken,
+		const ThreadCallback& onThreadStart, const ThreadCallback& onThreadExit)
+	{
+		if (onThreadStart)
+		{
+			onThreadStart();
+		}
+
+		while (true)
+		{
+			Task task;
+			{
+				std::unique_lock lock{ mutex };
+				// The wait only reports the stop when nothing is queued, so check it ourselves to drop what is
+				if (!taskCondition.wait(lock, stopToken, [this] { return !tasks.empty(); }) ||
+					stopToken.stop_requested())
+				{
+					break;
+				}
+
+				task = std::move(tasks.front());
+				tasks.pop_front();
+			}
+
+			task();
+		}
+
+		if (onThreadExit)
+		{
+			onThreadExit();
+		}
+	}
+}
@@ -1,6 +1,7 @@
 #include "ui/AppWindow.hpp"
 
 #include "core/Exceptions.hpp"
+#include "ui/UIColors.hpp"
 
 
 namespace PGUI::UI
@@ -14,6 +15,7 @@ namespace PGUI::UI
 		RegisterMessageHandler(WM_GETTEXTLENGTH, &AppWindow::OnGetTextLength);
 		RegisterMessageHandler(WM_GETMINMAXINFO, &AppWindow::OnGetMinMaxInfo);
 		RegisterMessageHandler(WM_LBUTTONDOWN, &AppWindow::OnLButtonDown);
+		RegisterMessageHandler(WM_SETTINGCHANGE, &AppWindow::OnSettingChange);
 	}
 
 	auto AppWindow::IsFullScreen() const noexcept -> bool
@@ -196,4 +198,10 @@ namespace PGUI::UI
 
 		return 0;
 	}
+	auto AppWindow::OnSettingChange(UINT /*unused*/, WPARAM /*unused*/, LPARAM lParam) const noexcept -> Core::HandlerResult
+	{
+		UIColors::OnSettingChange(lParam);
+
+		return { 0, Core::HandlerResultFlag::PassToDefWindowProc };
+	}
 }
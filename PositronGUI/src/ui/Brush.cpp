@@ -3,6 +3,8 @@
 #include "ui/Brush.hpp"
 
 #include "ui/UIComponent.hpp"
+#include "ui/GradientStopCache.hpp"
+#include "ui/BrushPool.hpp"
 #include "helpers/HelperFunctions.hpp"
 #include "core/Exceptions.hpp"
 
@@ -41,15 +43,9 @@ namespace PGUI::UI
 			gradient.ApplyReferenceRect(referenceRect.value());
 		}
 
-		const auto& gradientStops = gradient.GetGradientStops();
+		const auto gradientStopCollection = GradientStopCache::GetCollection(renderTarget.Get(), gradient);
 
-		ComPtr<ID2D1GradientStopCollection> gradientStopCollection;
-		HRESULT hr = renderTarget->CreateGradientStopCollection(
-			gradientStops.data(), static_cast<UINT32>(gradientStops.size()),
-			D2D1_GAMMA_1_0, D2D1_EXTEND_MODE_CLAMP,
-			&gradientStopCollection); HR_T(hr);
-		
-		renderTarget->CreateLinearGradientBrush(
+		HRESULT hr = renderTarget->CreateLinearGradientBrush(
 			D2D1::LinearGradientBrushProperties(gradient.Start(), gradient.End()),
 			gradientStopCollection.Get(),
 			GetHeldPtrAddress()
@@ -81,18 +77,9 @@ namespace PGUI::UI
 
 		auto xRadius = gradient.GetEllipse().xRadius;
 		auto yRadius = gradient.GetEllipse().yRadius;
-		const auto& gradientStops = gradient.GetGradientStops();
+		const auto gradientStopCollection = GradientStopCache::GetCollection(renderTarget.Get(), gradient);
 
-		ComPtr<ID2D1GradientStopCollection> gradientStopCollection;
-		HRESULT hr = renderTarget->CreateGradientStopCollection(
-			gradientStops.data(), static_cast<UINT32>(gradientStops.size()), &gradientStopCollection); HR_T(hr);
-
-		if (FAILED(hr))
-		{
-			return;
-		}
-
-		renderTarget->CreateRadialGradientBrush(
+		HRESULT hr = renderTarget->CreateRadialGradientBrush(
 			D2D1::RadialGradientBrushProperties(gradient.GetEllipse().center, gradient.Offset(), xRadius, yRadius),
 			gradientStopCollection.Get(),
 			GetHeldPtrAddress()
@@ -136,7 +123,8 @@ namespace PGUI::UI
 
 	Brush::Brush(Brush&& other) noexcept : 
 		brush{ std::move(other.brush) },
-		parameters{ std::move(other.parameters) }
+		parameters{ std::move(other.parameters) },
+		parametersChanged{ other.parametersChanged }
 	{
 	}
 
@@ -147,7 +135,18 @@ namespace PGUI::UI
 
 	auto Brush::Get() const noexcept -> BrushBase*
 	{
-		return brush.get();
+		return std::visit([]<typename T>(const T& held) -> BrushBase*
+		{
+			if constexpr (std::is_same_v<T, std::monostate>)
+			{
+				return nullptr;
+			}
+			else
+			{
+				// Drawing doesn't change the Brush, same as when it held the brush through a unique_ptr
+				return const_cast<T*>(&held);
+			}
+		}, brush);
 	}
 
 	void Brush::SetParametersAndCreateBrush(
@@ -159,27 +158,51 @@ namespace PGUI::UI
 
 	void Brush::CreateBrush(ComPtr<ID2D1RenderTarget> renderTarget) noexcept
 	{
-		ReleaseBrush();
+		auto* pool = BrushPool::ForRenderTarget(renderTarget.Get());
+		parametersChanged = false;
 
-		std::visit([this, renderTarget]<typename T>(T& params)
+		std::visit([this, &renderTarget, pool]<typename T>(const T& params)
 		{
+			if (pool == nullptr)
+			{
+				if constexpr (std::is_same_v<T, RGBA>)
+				{
+					brush.emplace<SolidColorBrush>(renderTarget, params);
+				}
+				else if constexpr (std::is_same_v<T, LinearGradientBrushParameters>)
+				{
+					brush.emplace<LinearGradientBrush>(renderTarget, params.gradient, params.referenceRect);
+				}
+				else if constexpr (std::is_same_v<T, RadialGradientBrushParameters>)
+				{
+					brush.emplace<RadialGradientBrush>(renderTarget, params.gradient, params.referenceRect);
+				}
+				return;
+			}
+
 			if constexpr (std::is_same_v<T, RGBA>)
 			{
-				brush = std::make_unique<SolidColorBrush>(renderTarget, params);
+				ComPtr<ID2D1SolidColorBrush> current;
+				if (const auto* solidColorBrush = std::get_if<SolidColorBrush>(&brush);
+					solidColorBrush != nullptr)
+				{
+					current = static_cast<ID2D1SolidColorBrush*>(*solidColorBrush);
+				}
+				brush.emplace<SolidColorBrush>(pool->GetSolidColorBrush(renderTarget.Get(), std::move(current), params));
 			}
 			else if constexpr (std::is_same_v<T, LinearGradientBrushParameters>)
 			{
-				brush = std::make_unique<LinearGradientBrush>(renderTarget, params.gradient, params.referenceRect);
+				brush.emplace<LinearGradientBrush>(pool->GetLinearGradientBrush(renderTarget.Get(), params));
 			}
 			else if constexpr (std::is_same_v<T, RadialGradientBrushParameters>)
 			{
-				brush = std::make_unique<RadialGradientBrush>(renderTarget, params.gradient, params.referenceRect);
+				brush.emplace<RadialGradientBrush>(pool->GetRadialGradientBrush(renderTarget.Get(), params));
 			}
 		}, parameters);
 	}
 	void Brush::ReleaseBrush() noexcept
 	{
-		brush = nullptr;
+		brush.emplace<std::monostate>();
 	}
 
 	auto Brush::GetParameters() const noexcept -> BrushParameters
@@ -193,6 +216,7 @@ namespace PGUI::UI
 	void Brush::SetParameters(const BrushParameters& _parameters) noexcept
 	{
 		parameters = _parameters;
+		parametersChanged = true;
 	}
 
 	void SetGradientBrushRect(Brush& brush, RectF rect)
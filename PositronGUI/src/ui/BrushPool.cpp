@@ -0,0 +1,206 @@
+#include "ui/BrushPool.hpp"
+
+#include "ui/GradientStopCache.hpp"
+#include "helpers/HelperFunctions.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+
+namespace PGUI::UI
+{
+	namespace
+	{
+		[[nodiscard]] auto GetPools() -> std::unordered_map<ID2D1Device*, BrushPool>&
+		{
+			static std::unordered_map<ID2D1Device*, BrushPool> pools;
+			return pools;
+		}
+	}
+
+	BrushPool::BrushPool(ComPtr<ID2D1Device> _device, std::size_t _capacity) noexcept :
+		device{ std::move(_device) }, capacity{ std::max<std::size_t>(_capacity, 1) }
+	{
+	}
+
+	auto BrushPool::ForRenderTarget(ID2D1RenderTarget* renderTarget) -> BrushPool*
+	{
+		ComPtr<ID2D1DeviceContext> deviceContext;
+		if (FAILED(renderTarget->QueryInterface(deviceContext.GetAddressOf())))
+		{
+			return nullptr;
+		}
+
+		ComPtr<ID2D1Device> device;
+		deviceContext->GetDevice(&device);
+
+		// The pool holds a reference to its device, so the pointer can't be reused by another one
+		auto& pools = GetPools();
+		auto iter = pools.find(device.Get());
+		if (iter == pools.end())
+		{
+			iter = pools.try_emplace(device.Get(), device).first;
+		}
+		return &iter->second;
+	}
+
+	auto BrushPool::GetSolidColorBrush(ID2D1RenderTarget* renderTarget,
+		ComPtr<ID2D1SolidColorBrush> brush, RGBA color) -> ComPtr<ID2D1SolidColorBrush>
+	{
+		if (brush)
+		{
+			hitCount++;
+			brush->SetColor(color);
+			return brush;
+		}
+
+		missCount++;
+		HRESULT hr = renderTarget->CreateSolidColorBrush(color, &brush); HR_T(hr);
+		return brush;
+	}
+
+	auto BrushPool::GetLinearGradientBrush(ID2D1RenderTarget* renderTarget,
+		const LinearGradientBrushParameters& parameters) -> ComPtr<ID2D1LinearGradientBrush>
+	{
+		const auto& gradient = parameters.gradient;
+
+		// Only the points are needed, so the stops aren't copied along with them
+		LinearGradient points{ gradient.Start(), gradient.End(), { } };
+		if (parameters.referenceRect.has_value() && gradient.GetPositioningMode() == PositioningMode::Relative)
+		{
+			points.ApplyReferenceRect(parameters.referenceRect.value());
+		}
+
+		const auto start = points.Start();
+		const auto end = points.End();
+		const auto key = MakeKey(GradientKind::Linear, { start.x, start.y, end.x, end.y, 0.0F, 0.0F }, gradient);
+
+		if (auto* found = Find(key);
+			found != nullptr)
+		{
+			return ComPtr<ID2D1LinearGradientBrush>{ static_cast<ID2D1LinearGradientBrush*>(found) };
+		}
+
+		const auto gradientStopCollection = GradientStopCache::GetCollection(renderTarget, gradient);
+
+		ComPtr<ID2D1LinearGradientBrush> brush;
+		HRESULT hr = renderTarget->CreateLinearGradientBrush(
+			D2D1::LinearGradientBrushProperties(start, end),
+			gradientStopCollection.Get(),
+			&brush
+		); HR_T(hr);
+
+		Insert(key, brush);
+		return brush;
+	}
+
+	auto BrushPool::GetRadialGradientBrush(ID2D1RenderTarget* renderTarget,
+		const RadialGradientBrushParameters& parameters) -> ComPtr<ID2D1RadialGradientBrush>
+	{
+		const auto& gradient = parameters.gradient;
+
+		RadialGradient shape{ gradient.GetEllipse(), gradient.Offset(), { } };
+		if (parameters.referenceRect.has_value() && gradient.GetPositioningMode() == PositioningMode::Relative)
+		{
+			shape.ApplyReferenceRect(parameters.referenceRect.value());
+		}
+
+		const auto ellipse = shape.GetEllipse();
+		const auto offset = shape.Offset();
+		const auto key = MakeKey(GradientKind::Radial,
+			{ ellipse.center.x, ellipse.center.y, offset.x, offset.y, ellipse.xRadius, ellipse.yRadius }, gradient);
+
+		if (auto* found = Find(key);
+			found != nullptr)
+		{
+			return ComPtr<ID2D1RadialGradientBrush>{ static_cast<ID2D1RadialGradientBrush*>(found) };
+		}
+
+		const auto gradientStopCollection = GradientStopCache::GetCollection(renderTarget, gradient);
+
+		ComPtr<ID2D1RadialGradientBrush> brush;
+		HRESULT hr = renderTarget->CreateRadialGradientBrush(
+			D2D1::RadialGradientBrushProperties(ellipse.center, offset, ellipse.xRadius, ellipse.yRadius),
+			gradientStopCollection.Get(),
+			&brush
+		); HR_T(hr);
+
+		Insert(key, brush);
+		return brush;
+	}
+
+	void BrushPool::Clear() noexcept
+	{
+		entries.clear();
+	}
+
+	void BrushPool::SetCapacity(std::size_t _capacity)
+	{
+		capacity = std::max<std::size_t>(_capacity, 1);
+		Trim(capacity);
+	}
+
+	auto BrushPool::KeyEqual::operator()(const Key& left, const Key& right) const noexcept -> bool
+	{
+		// Compared bit for bit to agree with the hash
+		return left.hash == right.hash &&
+			left.kind == right.kind &&
+			left.gamma == right.gamma &&
+			left.extendMode == right.extendMode &&
+			std::memcmp(left.geometry.data(), right.geometry.data(), sizeof(left.geometry)) == 0 &&
+			left.stops.size() == right.stops.size() &&
+			std::memcmp(left.stops.data(), right.stops.data(), left.stops.size_bytes()) == 0;
+	}
+
+	auto BrushPool::MakeKey(GradientKind kind, const std::array<float, 6>& geometry,
+		const Gradient& gradient) noexcept -> Key
+	{
+		const auto& stops = gradient.GetGradientStops();
+		const auto gamma = gradient.GetGamma();
+		const auto extendMode = gradient.GetExtendMode();
+
+		auto hash = HashValue(kind);
+		hash = HashValue(geometry, hash);
+		hash = HashBytes(std::as_bytes(std::span{ stops }), hash);
+		hash = HashValue(gamma, hash);
+		hash = HashValue(extendMode, hash);
+
+		return Key{ kind, geometry, stops, gamma, extendMode, static_cast<std::size_t>(hash) };
+	}
+
+	auto BrushPool::Find(const Key& key) noexcept -> ID2D1Brush*
+	{
+		auto iter = entries.find(key);
+		if (iter == entries.end())
+		{
+			missCount++;
+			return nullptr;
+		}
+
+		hitCount++;
+		iter->second.lastUse = ++useCounter;
+		return iter->second.brush.Get();
+	}
+
+	void BrushPool::Insert(const Key& key, ComPtr<ID2D1Brush> brush)
+	{
+		Trim(capacity - 1);
+
+		// Moving the vector keeps its buffer, so the key can view it before the move
+		Entry entry{ GradientStops(key.stops.begin(), key.stops.end()), std::move(brush), ++useCounter };
+		auto storedKey = key;
+		storedKey.stops = entry.stops;
+		entries.emplace(storedKey, std::move(entry));
+	}
+
+	void BrushPool::Trim(std::size_t count)
+	{
+		while (entries.size() > count)
+		{
+			const auto oldest = std::ranges::min_element(entries, std::less{ },
+				[](const auto& pair) { return pair.second.lastUse; });
+			entries.erase(oldest);
+		}
+	}
+}
@@ -0,0 +1,459 @@
+#include "ui/ColorConversion.hpp"
+
+#include "helpers/CpuFeatures.hpp"
+
+#if PGUI_X86
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <type_traits>
+
+
+namespace PGUI::UI
+{
+	namespace
+	{
+		using PlanarConverter = void (*)(const float* const* inputs, float* const* outputs, std::size_t count) noexcept;
+
+		struct PlanarConverters
+		{
+			PlanarConverter hsvToRgb;
+			PlanarConverter hslToRgb;
+			PlanarConverter cmykToRgb;
+			PlanarConverter rgbToHsv;
+			PlanarConverter rgbToHsl;
+			PlanarConverter rgbToCmyk;
+		};
+
+		#pragma region Scalar
+
+		void HsvToRgbScalar(const float* const* inputs, float* const* outputs, std::size_t count) noexcept
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+				const RGBA color{ HSV{ inputs[0][i], inputs[1][i], inputs[2][i] } };
+				outputs[0][i] = color.r;
+				outputs[1][i] = color.g;
+				outputs[2][i] = color.b;
+			}
+		}
+
+		void HslToRgbScalar(const float* const* inputs, float* const* outputs, std::size_t count) noexcept
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+				const RGBA color{ HSL{ inputs[0][i], inputs[1][i], inputs[2][i] } };
+				outputs[0][i] = color.r;
+				outputs[1][i] = color.g;
+				outputs[2][i] = color.b;
+			}
+		}
+
+		void CmykToRgbScalar(const float* const* inputs, float* const* outputs, std::size_t count) noexcept
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+				const RGBA color{ CMYK{ inputs[0][i], inputs[1][i], inputs[2][i], inputs[3][i] } };
+				outputs[0][i] = color.r;
+				outputs[1][i] = color.g;
+				outputs[2][i] = color.b;
+			}
+		}
+
+		void RgbToHsvScalar(const float* const* inputs, float* const* outputs, std::size_t count) noexcept
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+				const HSV color{ RGBA{ inputs[0][i], inputs[1][i], inputs[2][i] } };
+				outputs[0][i] = color.h;
+				outputs[1][i] = color.s;
+				outputs[2][i] = color.v;
+			}
+		}
+
+		void RgbToHslScalar(const float* const* inputs, float* const* outputs, std::size_t count) noexcept
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+				const HSL color{ RGBA{ inputs[0][i], inputs[1][i], inputs[2][i] } };
+				outputs[0][i] = color.h;
+				outputs[1][i] = color.s;
+				outputs[2][i] = color.l;
+			}
+		}
+
+		void RgbToCmykScalar(const float* const* inputs, float* const* outputs, std::size_t count) noexcept
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+				const CMYK color{ RGBA{ inputs[0][i], inputs[1][i], inputs[2][i] } };
+				outputs[0][i] = color.c;
+				outputs[1][i] = color.m;
+				outputs[2][i] = color.y;
+				outputs[3][i] = color.k;
+			}
+		}
+
+		#pragma endregion
+
+#if PGUI_X86
+		#pragma region Avx2
+
+		// Each of these does the same operations in the same order as color_detail, so lanes match the scalar results
+
+		PGUI_TARGET_AVX2 auto HueSectorAvx2(__m256 hue) noexcept -> __m256
+		{
+			const auto six = _mm256_set1_ps(6.0F);
+			const auto sector = _mm256_div_ps(hue, _mm256_set1_ps(60.0F));
+			return _mm256_sub_ps(sector, _mm256_mul_ps(six, _mm256_floor_ps(_mm256_div_ps(sector, six))));
+		}
+
+		PGUI_TARGET_AVX2 auto HsvWeightAvx2(float offset, __m256 sector) noexcept -> __m256
+		{
+			const auto six = _mm256_set1_ps(6.0F);
+			auto k = _mm256_add_ps(_mm256_set1_ps(offset), sector);
+			k = _mm256_blendv_ps(k, _mm256_sub_ps(k, six), _mm256_cmp_ps(k, six, _CMP_GE_OQ));
+
+			const auto weight = _mm256_min_ps(_mm256_min_ps(k, _mm256_sub_ps(_mm256_set1_ps(4.0F), k)), _mm256_set1_ps(1.0F));
+			return _mm256_max_ps(_mm256_setzero_ps(), weight);
+		}
+
+		PGUI_TARGET_AVX2 auto HslWeightAvx2(float offset, __m256 sector) noexcept -> __m256
+		{
+			const auto twelve = _mm256_set1_ps(12.0F);
+			auto k = _mm256_add_ps(_mm256_set1_ps(offset), _mm256_mul_ps(_mm256_set1_ps(2.0F), sector));
+			k = _mm256_blendv_ps(k, _mm256_sub_ps(k, twelve), _mm256_cmp_ps(k, twelve, _CMP_GE_OQ));
+
+			const auto weight = _mm256_min_ps(_mm256_min_ps(
+				_mm256_sub_ps(k, _mm256_set1_ps(3.0F)), _mm256_sub_ps(_mm256_set1_ps(9.0F), k)), _mm256_set1_ps(1.0F));
+			return _mm256_max_ps(_mm256_set1_ps(-1.0F), weight);
+		}
+
+		PGUI_TARGET_AVX2 auto HueAvx2(__m256 r, __m256 g, __m256 b, __m256 max, __m256 delta) noexcept -> __m256
+		{
+			// The sector of the largest channel is picked without branching, red wins ties like in the scalar version
+			const auto fromRed = _mm256_div_ps(_mm256_sub_ps(g, b), delta);
+			const auto fromGreen = _mm256_add_ps(_mm256_div_ps(_mm256_sub_ps(b, r), delta), _mm256_set1_ps(2.0F));
+			const auto fromBlue = _mm256_add_ps(_mm256_div_ps(_mm256_sub_ps(r, g), delta), _mm256_set1_ps(4.0F));
+
+			auto hue = _mm256_blendv_ps(fromBlue, fromGreen, _mm256_cmp_ps(max, g, _CMP_EQ_OQ));
+			hue = _mm256_blendv_ps(hue, fromRed, _mm256_cmp_ps(max, r, _CMP_EQ_OQ));
+			hue = _mm256_blendv_ps(hue, _mm256_add_ps(hue, _mm256_set1_ps(6.0F)), _mm256_cmp_ps(hue, _mm256_setzero_ps(), _CMP_LT_OQ));
+
+			const auto gray = _mm256_cmp_ps(delta, _mm256_setzero_ps(), _CMP_EQ_OQ);
+			return _mm256_mul_ps(_mm256_andnot_ps(gray, hue), _mm256_set1_ps(60.0F));
+		}
+
+		PGUI_TARGET_AVX2 void HsvToRgbAvx2(const float* const* inputs, float* const* outputs, std::size_t count) noexcept
+		{
+			std::size_t i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				const auto sector = HueSectorAvx2(_mm256_loadu_ps(inputs[0] + i));
+				const auto value = _mm256_loadu_ps(inputs[2] + i);
+				const auto chroma = _mm256_mul_ps(value, _mm256_loadu_ps(inputs[1] + i));
+
+				_mm256_storeu_ps(outputs[0] + i, _mm256_sub_ps(value, _mm256_mul_ps(chroma, HsvWeightAvx2(5.0F, sector))));
+				_mm256_storeu_ps(outputs[1] + i, _mm256_sub_ps(value, _mm256_mul_ps(chroma, HsvWeightAvx2(3.0F, sector))));
+				_mm256_storeu_ps(outputs[2] + i, _mm256_sub_ps(value, _mm256_mul_ps(chroma, HsvWeightAvx2(1.0F, sector))));
+			}
+
+			const std::array<const float*, 3> tailInputs{ inputs[0] + i, inputs[1] + i, inputs[2] + i };
+			const std::array<float*, 3> tailOutputs{ outputs[0] + i, outputs[1] + i, outputs[2] + i };
+			HsvToRgbScalar(tailInputs.data(), tailOutputs.data(), count - i);
+		}
+
+		PGUI_TARGET_AVX2 void HslToRgbAvx2(const float* const* inputs, float* const* outputs, std::size_t count) noexcept
+		{
+			const auto one = _mm256_set1_ps(1.0F);
+
+			std::size_t i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				const auto sector = HueSectorAvx2(_mm256_loadu_ps(inputs[0] + i));
+				const auto lightness = _mm256_loadu_ps(inputs[2] + i);
+				const auto chroma = _mm256_mul_ps(_mm256_loadu_ps(inputs[1] + i),
+					_mm256_min_ps(lightness, _mm256_sub_ps(one, lightness)));
+
+				_mm256_storeu_ps(outputs[0] + i, _mm256_sub_ps(lightness, _mm256_mul_ps(chroma, HslWeightAvx2(0.0F, sector))));
+				_mm256_storeu_ps(outputs[1] + i, _mm256_sub_ps(lightness, _mm256_mul_ps(chroma, HslWeightAvx2(8.0F, sector))));
+				_mm256_storeu_ps(outputs[2] + i, _mm256_sub_ps(lightness, _mm256_mul_ps(chroma, HslWeightAvx2(4.0F, sector))));
+			}
+
+			const std::array<const float*, 3> tailInputs{ inputs[0] + i, inputs[1] + i, inputs[2] + i };
+			const std::array<float*, 3> tailOutputs{ outputs[0] + i, outputs[1] + i, outputs[2] + i };
+			HslToRgbScalar(tailInputs.data(), tailOutputs.data(), count - i);
+		}
+
+		PGUI_TARGET_AVX2 void CmykToRgbAvx2(const float* const* inputs, float* const* outputs, std::size_t count) noexcept
+		{
+			const auto one = _mm256_set1_ps(1.0F);
+
+			std::size_t i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				const auto white = _mm256_sub_ps(one, _mm256_loadu_ps(inputs[3] + i));
+				for (std::size_t channel = 0; channel < 3; channel++)
+				{
+					const auto ink = _mm256_sub_ps(one, _mm256_loadu_ps(inputs[channel] + i));
+					_mm256_storeu_ps(outputs[channel] + i, _mm256_mul_ps(ink, white));
+				}
+			}
+
+			const std::array<const float*, 4> tailInputs{ inputs[0] + i, inputs[1] + i, inputs[2] + i, inputs[3] + i };
+			const std::array<float*, 3> tailOutputs{ outputs[0] + i, outputs[1] + i, outputs[2] + i };
+			CmykToRgbScalar(tailInputs.data(), tailOutputs.data(), count - i);
+		}
+
+		PGUI_TARGET_AVX2 void RgbToHsvAvx2(const float* const* inputs, float* const* outputs, std::size_t count) noexcept
+		{
+			const auto zero = _mm256_setzero_ps();
+
+			std::size_t i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				const auto r = _mm256_loadu_ps(inputs[0] + i);
+				const auto g = _mm256_loadu_ps(inputs[1] + i);
+				const auto b = _mm256_loadu_ps(inputs[2] + i);
+
+				const auto max = _mm256_max_ps(_mm256_max_ps(r, g), b);
+				const auto delta = _mm256_sub_ps(max, _mm256_min_ps(_mm256_min_ps(r, g), b));
+				const auto black = _mm256_cmp_ps(max, zero, _CMP_EQ_OQ);
+
+				_mm256_storeu_ps(outputs[0] + i, HueAvx2(r, g, b, max, delta));
+				_mm256_storeu_ps(outputs[1] + i, _mm256_andnot_ps(black, _mm256_div_ps(delta, max)));
+				_mm256_storeu_ps(outputs[2] + i, max);
+			}
+
+			const std::array<const float*, 3> tailInputs{ inputs[0] + i, inputs[1] + i, inputs[2] + i };
+			const std::array<float*, 3> tailOutputs{ outputs[0] + i, outputs[1] + i, outputs[2] + i };
+			RgbToHsvScalar(tailInputs.data(), tailOutputs.data(), count - i);
+		}
+
+		PGUI_TARGET_AVX2 void RgbToHslAvx2(const float* const* inputs, float* const* outputs, std::size_t count) noexcept
+		{
+			const auto zero = _mm256_setzero_ps();
+			const auto one = _mm256_set1_ps(1.0F);
+			const auto signMask = _mm256_set1_ps(-0.0F);
+
+			std::size_t i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				const auto r = _mm256_loadu_ps(inputs[0] + i);
+				const auto g = _mm256_loadu_ps(inputs[1] + i);
+				const auto b = _mm256_loadu_ps(inputs[2] + i);
+
+				const auto max = _mm256_max_ps(_mm256_max_ps(r, g), b);
+				const auto min = _mm256_min_ps(_mm256_min_ps(r, g), b);
+				const auto delta = _mm256_sub_ps(max, min);
+				const auto lightness = _mm256_mul_ps(_mm256_add_ps(max, min), _mm256_set1_ps(0.5F));
+
+				const auto distance = _mm256_andnot_ps(signMask,
+					_mm256_sub_ps(_mm256_mul_ps(_mm256_set1_ps(2.0F), lightness), one));
+				const auto saturation = _mm256_min_ps(_mm256_div_ps(delta, _mm256_sub_ps(one, distance)), one);
+				const auto gray = _mm256_cmp_ps(delta, zero, _CMP_EQ_OQ);
+
+				_mm256_storeu_ps(outputs[0] + i, HueAvx2(r, g, b, max, delta));
+				_mm256_storeu_ps(outputs[1] + i, _mm256_andnot_ps(gray, saturation));
+				_mm256_storeu_ps(outputs[2] + i, lightness);
+			}
+
+			const std::array<const float*, 3> tailInputs{ inputs[0] + i, inputs[1] + i, inputs[2] + i };
+			const std::array<float*, 3> tailOutputs{ outputs[0] + i, outputs[1] + i, outputs[2] + i };
+			RgbToHslScalar(tailInputs.data(), tailOutputs.data(), count - i);
+		}
+
+		PGUI_TARGET_AVX2 void RgbToCmykAvx2(const float* const* inputs, float* const* outputs, std::size_t count) noexcept
+		{
+			const auto zero = _mm256_setzero_ps();
+
+			std::size_t i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				const std::array channels{
+					_mm256_loadu_ps(inputs[0] + i), _mm256_loadu_ps(inputs[1] + i), _mm256_loadu_ps(inputs[2] + i) };
+
+				const auto max = _mm256_max_ps(_mm256_max_ps(channels[0], channels[1]), channels[2]);
+				const auto black = _mm256_cmp_ps(max, zero, _CMP_EQ_OQ);
+
+				for (std::size_t channel = 0; channel < 3; channel++)
+				{
+					const auto ink = _mm256_div_ps(_mm256_sub_ps(max, channels[channel]), max);
+					_mm256_storeu_ps(outputs[channel] + i, _mm256_andnot_ps(black, ink));
+				}
+				_mm256_storeu_ps(outputs[3] + i, _mm256_sub_ps(_mm256_set1_ps(1.0F), max));
+			}
+
+			const std::array<const float*, 3> tailInputs{ inputs[0] + i, inputs[1] + i, inputs[2] + i };
+			const std::array<float*, 4> tailOutputs{ outputs[0] + i, outputs[1] + i, outputs[2] + i, outputs[3] + i };
+			RgbToCmykScalar(tailInputs.data(), tailOutputs.data(), count - i);
+		}
+
+		#pragma endregion
+#endif
+
+		[[nodiscard]] auto GetPlanarConverters() noexcept -> const PlanarConverters&
+		{
+			static constexpr PlanarConverters scalar{
+				&HsvToRgbScalar, &HslToRgbScalar, &CmykToRgbScalar,
+				&RgbToHsvScalar, &RgbToHslScalar, &RgbToCmykScalar
+			};
+#if PGUI_X86
+			static constexpr PlanarConverters avx2{
+				&HsvToRgbAvx2, &HslToRgbAvx2, &CmykToRgbAvx2,
+				&RgbToHsvAvx2, &RgbToHslAvx2, &RgbToCmykAvx2
+			};
+			static const auto& converters = CpuFeatures::Get().avx2 ? avx2 : scalar;
+			return converters;
+#else
+			return scalar;
+#endif
+		}
+
+		/**
+		* @brief Splits packed colors into planes a block at a time, so the planar kernels do the work
+		*/
+		template <auto SourceMembers, auto DestinationMembers, typename Source, typename Destination>
+		void ConvertPacked(std::span<const Source> source, Destination* destination, PlanarConverter convert) noexcept
+		{
+			constexpr std::size_t BlockSize = 256;
+			constexpr auto SourceChannels = SourceMembers.size();
+			constexpr auto DestinationChannels = DestinationMembers.size();
+
+			std::array<std::array<float, BlockSize>, SourceChannels> inputPlanes;
+			std::array<std::array<float, BlockSize>, DestinationChannels> outputPlanes;
+			std::array<const float*, SourceChannels> inputs{ };
+			std::array<float*, DestinationChannels> outputs{ };
+			for (std::size_t channel = 0; channel < SourceChannels; channel++)
+			{
+				inputs[channel] = inputPlanes[channel].data();
+			}
+			for (std::size_t channel = 0; channel < DestinationChannels; channel++)
+			{
+				outputs[channel] = outputPlanes[channel].data();
+			}
+
+			for (std::size_t offset = 0; offset < source.size(); offset += BlockSize)
+			{
+				const auto count = std::min(BlockSize, source.size() - offset);
+
+				for (std::size_t i = 0; i < count; i++)
+				{
+					for (std::size_t channel = 0; channel < SourceChannels; channel++)
+					{
+						inputPlanes[channel][i] = source[offset + i].*SourceMembers[channel];
+					}
+				}
+
+				convert(inputs.data(), outputs.data(), count);
+
+				for (std::size_t i = 0; i < count; i++)
+				{
+					Destination color{ };
+					for (std::size_t channel = 0; channel < DestinationChannels; channel++)
+					{
+						color.*DestinationMembers[channel] = outputPlanes[channel][i];
+					}
+					if constexpr (std::is_same_v<Destination, RGBA>)
+					{
+						color.a = 1.0F;
+					}
+					destination[offset + i] = color;
+				}
+			}
+		}
+
+		constexpr std::array RgbMembers{ &RGBA::r, &RGBA::g, &RGBA::b };
+		constexpr std::array HsvMembers{ &HSV::h, &HSV::s, &HSV::v };
+		constexpr std::array HslMembers{ &HSL::h, &HSL::s, &HSL::l };
+		constexpr std::array CmykMembers{ &CMYK::c, &CMYK::m, &CMYK::y, &CMYK::k };
+	}
+
+	#pragma region Planar
+
+	void HsvToRgb(const float* h, const float* s, const float* v,
+		float* r, float* g, float* b, std::size_t count) noexcept
+	{
+		const std::array inputs{ h, s, v };
+		const std::array outputs{ r, g, b };
+		GetPlanarConverters().hsvToRgb(inputs.data(), outputs.data(), count);
+	}
+
+	void HslToRgb(const float* h, const float* s, const float* l,
+		float* r, float* g, float* b, std::size_t count) noexcept
+	{
+		const std::array inputs{ h, s, l };
+		const std::array outputs{ r, g, b };
+		GetPlanarConverters().hslToRgb(inputs.data(), outputs.data(), count);
+	}
+
+	void CmykToRgb(const float* c, const float* m, const float* y, const float* k,
+		float* r, float* g, float* b, std::size_t count) noexcept
+	{
+		const std::array inputs{ c, m, y, k };
+		const std::array outputs{ r, g, b };
+		GetPlanarConverters().cmykToRgb(inputs.data(), outputs.data(), count);
+	}
+
+	void RgbToHsv(const float* r, const float* g, const float* b,
+		float* h, float* s, float* v, std::size_t count) noexcept
+	{
+		const std::array inputs{ r, g, b };
+		const std::array outputs{ h, s, v };
+		GetPlanarConverters().rgbToHsv(inputs.data(), outputs.data(), count);
+	}
+
+	void RgbToHsl(const float* r, const float* g, const float* b,
+		float* h, float* s, float* l, std::size_t count) noexcept
+	{
+		const std::array inputs{ r, g, b };
+		const std::array outputs{ h, s, l };
+		GetPlanarConverters().rgbToHsl(inputs.data(), outputs.data(), count);
+	}
+
+	void RgbToCmyk(const float* r, const float* g, const float* b,
+		float* c, float* m, float* y, float* k, std::size_t count) noexcept
+	{
+		const std::array inputs{ r, g, b };
+		const std::array outputs{ c, m, y, k };
+		GetPlanarConverters().rgbToCmyk(inputs.data(), outputs.data(), count);
+	}
+
+	#pragma endregion
+
+	#pragma region Packed
+
+	void ConvertColors(std::span<const HSV> source, RGBA* destination) noexcept
+	{
+		ConvertPacked<HsvMembers, RgbMembers>(source, destination, GetPlanarConverters().hsvToRgb);
+	}
+
+	void ConvertColors(std::span<const HSL> source, RGBA* destination) noexcept
+	{
+		ConvertPacked<HslMembers, RgbMembers>(source, destination, GetPlanarConverters().hslToRgb);
+	}
+
+	void ConvertColors(std::span<const CMYK> source, RGBA* destination) noexcept
+	{
+		ConvertPacked<CmykMembers, RgbMembers>(source, destination, GetPlanarConverters().cmykToRgb);
+	}
+
+	void ConvertColors(std::span<const RGBA> source, HSV* destination) noexcept
+	{
+		ConvertPacked<RgbMembers, HsvMembers>(source, destination, GetPlanarConverters().rgbToHsv);
+	}
+
+	void ConvertColors(std::span<const RGBA> source, HSL* destination) noexcept
+	{
+		ConvertPacked<RgbMembers, HslMembers>(source, destination, GetPlanarConverters().rgbToHsl);
+	}
+
+	void ConvertColors(std::span<const RGBA> source, CMYK* destination) noexcept
+	{
+		ConvertPacked<RgbMembers, CmykMembers>(source, destination, GetPlanarConverters().rgbToCmyk);
+	}
+
+	#pragma endregion
+}
@@ -0,0 +1,280 @@
+#include "ui/ElementHost.hpp"
+
+#include "ui/UIColors.hpp"
+
+#include <windowsx.h>
+
+
+namespace PGUI::UI
+{
+	ElementHost::ElementHost() noexcept :
+		Control{ Core::WindowClass::Create(L"ElementHost_UIControl") }
+	{
+		RegisterMessageHandler(WM_PAINT, &ElementHost::OnPaint);
+		RegisterMessageHandler(WM_SIZE, &ElementHost::OnSize);
+		RegisterMessageHandler(WM_MOUSEMOVE, &ElementHost::OnMouseMove);
+		RegisterMessageHandler(WM_MOUSELEAVE, &ElementHost::OnMouseLeave);
+		RegisterMessageHandler(WM_LBUTTONDOWN, &ElementHost::OnMouseButton);
+		RegisterMessageHandler(WM_LBUTTONUP, &ElementHost::OnMouseButton);
+		RegisterMessageHandler(WM_RBUTTONDOWN, &ElementHost::OnMouseButton);
+		RegisterMessageHandler(WM_RBUTTONUP, &ElementHost::OnMouseButton);
+		RegisterMessageHandler(WM_MBUTTONDOWN, &ElementHost::OnMouseButton);
+		RegisterMessageHandler(WM_MBUTTONUP, &ElementHost::OnMouseButton);
+		RegisterMessageHandler(WM_MOUSEWHEEL, &ElementHost::OnMouseWheel);
+		RegisterMessageHandler(WM_KEYDOWN, &ElementHost::OnKey);
+		RegisterMessageHandler(WM_KEYUP, &ElementHost::OnKey);
+		RegisterMessageHandler(WM_CHAR, &ElementHost::OnChar);
+		RegisterMessageHandler(WM_GETDLGCODE, &ElementHost::OnGetDlgCode);
+
+		visualTree.SetInvalidateCallback([this](RectF rect)
+		{
+			Invalidate(rect);
+		});
+
+		backgroundBrush.SetParameters(UIColors::GetBackgroundColor());
+		themeChangedConnection = UIColors::ThemeChangedEvent().Subscribe(
+			BindMemberFunc(&ElementHost::OnThemeChanged, this), Core::EventDelivery::UIThread);
+	}
+
+	auto ElementHost::RemoveElement(const Element* element) -> std::unique_ptr<Core::VisualElement>
+	{
+		return visualTree.GetRoot().RemoveChild(element);
+	}
+
+	void ElementHost::SetBackgroundBrush(Brush& brush) noexcept
+	{
+		followsTheme = false;
+		backgroundBrush.SetParameters(brush.GetParameters());
+		backgroundBrush.ReleaseBrush();
+		Invalidate();
+	}
+
+	void ElementHost::OnThemeChanged() noexcept
+	{
+		if (followsTheme)
+		{
+			backgroundBrush.SetParameters(UIColors::GetBackgroundColor());
+			backgroundBrush.ReleaseBrush();
+			Invalidate();
+		}
+	}
+
+	void ElementHost::CreateDeviceResources()
+	{
+		auto g = GetGraphics();
+
+		if (!backgroundBrush)
+		{
+			g.CreateBrush(backgroundBrush);
+		}
+	}
+	void ElementHost::DiscardDeviceResources()
+	{
+		backgroundBrush.ReleaseBrush();
+
+		visualTree.ForEachElement([](Core::VisualElement& visualElement)
+		{
+			if (auto* element = dynamic_cast<Element*>(&visualElement);
+				element != nullptr && element->deviceResourcesCreated)
+			{
+				element->DiscardDeviceResources();
+				element->deviceResourcesCreated = false;
+			}
+		});
+	}
+
+	void ElementHost::RouteMouseEvent(Core::InputEventType type, Core::MouseButton button, WPARAM wParam, PointF position)
+	{
+		Core::InputEvent event{ };
+		event.type = type;
+		event.position = position;
+		event.button = button;
+
+		if (wParam & MK_SHIFT)
+		{
+			event.modifiers |= Core::ModifierKeys::Shift;
+		}
+		if (wParam & MK_CONTROL)
+		{
+			event.modifiers |= Core::ModifierKeys::Control;
+		}
+		if (GetKeyState(VK_MENU) < 0)
+		{
+			event.modifiers |= Core::ModifierKeys::Alt;
+		}
+
+		visualTree.RouteInput(event);
+	}
+	auto ElementHost::GetKeyModifiers() noexcept -> Core::ModifierKeys
+	{
+		auto modifiers = Core::ModifierKeys::None;
+
+		if (GetKeyState(VK_SHIFT) < 0)
+		{
+			modifiers |= Core::ModifierKeys::Shift;
+		}
+		if (GetKeyState(VK_CONTROL) < 0)
+		{
+			modifiers |= Core::ModifierKeys::Control;
+		}
+		if (GetKeyState(VK_MENU) < 0)
+		{
+			modifiers |= Core::ModifierKeys::Alt;
+		}
+
+		return modifiers;
+	}
+
+	auto ElementHost::OnPaint(UINT /*unused*/, WPARAM /*unused*/, LPARAM /*unused*/) -> Core::HandlerResult
+	{
+		BeginDraw();
+
+		auto g = GetGraphics();
+
+		g.Clear(backgroundBrush);
+
+		visualTree.Render([&g](Core::VisualElement& visualElement, RectF renderRect)
+		{
+			auto* element = dynamic_cast<Element*>(&visualElement);
+			if (element == nullptr)
+			{
+				return;
+			}
+
+			if (!element->deviceResourcesCreated)
+			{
+				element->CreateDeviceResources(g);
+				element->deviceResourcesCreated = true;
+			}
+
+			g.PushAxisAlignedClip(renderRect, g.GetAntialiasMode());
+			element->Render(g, renderRect);
+			g.PopAxisAlignedClip();
+		}, GetDirtyRect());
+
+		EndDraw();
+
+		return 0;
+	}
+
+	auto ElementHost::OnSize(UINT /*unused*/, WPARAM /*unused*/, LPARAM /*unused*/) noexcept -> Core::HandlerResult
+	{
+		visualTree.GetRoot().SetBounds(RectF{ PointF{ }, SizeF{ GetClientSize() } });
+
+		return 0;
+	}
+
+	auto ElementHost::OnMouseMove(UINT /*unused*/, WPARAM wParam, LPARAM lParam) -> Core::HandlerResult
+	{
+		if (!trackingMouse)
+		{
+			TRACKMOUSEEVENT tme{ };
+			tme.cbSize = sizeof(TRACKMOUSEEVENT);
+			tme.dwFlags = TME_LEAVE;
+			tme.hwndTrack = Hwnd();
+			TrackMouseEvent(&tme);
+
+			trackingMouse = true;
+		}
+
+		RouteMouseEvent(Core::InputEventType::MouseMove, Core::MouseButton::None, wParam, PointF{ MAKEPOINTS(lParam) });
+
+		return 0;
+	}
+	auto ElementHost::OnMouseLeave(UINT /*unused*/, WPARAM /*unused*/, LPARAM /*unused*/) -> Core::HandlerResult
+	{
+		trackingMouse = false;
+
+		visualTree.RouteInput(Core::InputEvent{ .type = Core::InputEventType::MouseLeave });
+
+		return 0;
+	}
+	auto ElementHost::OnMouseButton(UINT msg, WPARAM wParam, LPARAM lParam) -> Core::HandlerResult
+	{
+		auto type = Core::InputEventType::MouseDown;
+		auto button = Core::MouseButton::Left;
+
+		switch (msg)
+		{
+			case WM_LBUTTONUP:
+				type = Core::InputEventType::MouseUp;
+				break;
+			case WM_RBUTTONDOWN:
+				button = Core::MouseButton::Right;
+				break;
+			case WM_RBUTTONUP:
+				type = Core::InputEventType::MouseUp;
+				button = Core::MouseButton::Right;
+				break;
+			case WM_MBUTTONDOWN:
+				button = Core::MouseButton::Middle;
+				break;
+			case WM_MBUTTONUP:
+				type = Core::InputEventType::MouseUp;
+				button = Core::MouseButton::Middle;
+				break;
+			default:
+				break;
+		}
+
+		// Keep receiving mouse messages while a button is held so dragged elements get their MouseUp
+		if (type == Core::InputEventType::MouseDown)
+		{
+			// This replaces Control's WM_LBUTTONDOWN handler, which is what focuses a control when it's clicked
+			if (GetFocus() != Hwnd())
+			{
+				SetFocus(Hwnd());
+			}
+			SetCapture(Hwnd());
+		}
+		else if (constexpr WPARAM heldButtons = MK_LBUTTON | MK_RBUTTON | MK_MBUTTON | MK_XBUTTON1 | MK_XBUTTON2;
+			(wParam & heldButtons) == 0 && GetCapture() == Hwnd())
+		{
+			// wParam has the buttons still held after this one went up
+			ReleaseCapture();
+		}
+
+		RouteMouseEvent(type, button, wParam, PointF{ MAKEPOINTS(lParam) });
+
+		return 0;
+	}
+	auto ElementHost::OnMouseWheel(UINT /*unused*/, WPARAM wParam, LPARAM lParam) -> Core::HandlerResult
+	{
+		Core::InputEvent event{ };
+		event.type = Core::InputEventType::MouseWheel;
+		event.position = ScreenToClient(PointL{ GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam) });
+		event.wheelDelta = GET_WHEEL_DELTA_WPARAM(wParam);
+		event.modifiers = GetKeyModifiers();
+
+		visualTree.RouteInput(event);
+
+		return 0;
+	}
+	auto ElementHost::OnKey(UINT msg, WPARAM wParam, LPARAM /*unused*/) -> Core::HandlerResult
+	{
+		Core::InputEvent event{ };
+		event.type = msg == WM_KEYDOWN ? Core::InputEventType::KeyDown : Core::InputEventType::KeyUp;
+		event.key = static_cast<std::uint32_t>(wParam);
+		event.modifiers = GetKeyModifiers();
+
+		visualTree.RouteInput(event);
+
+		return 0;
+	}
+	auto ElementHost::OnChar(UINT /*unused*/, WPARAM wParam, LPARAM /*unused*/) -> Core::HandlerResult
+	{
+		Core::InputEvent event{ };
+		event.type = Core::InputEventType::Char;
+		event.key = static_cast<std::uint32_t>(wParam);
+		event.modifiers = GetKeyModifiers();
+
+		visualTree.RouteInput(event);
+
+		return 0;
+	}
+	auto ElementHost::OnGetDlgCode(UINT /*unused*/, WPARAM /*unused*/, LPARAM /*unused*/) noexcept -> Core::HandlerResult
+	{
+		// Tab and arrow keys move focus between elements, not between windows
+		return DLGC_WANTALLKEYS | DLGC_WANTCHARS;
+	}
+}
@@ -0,0 +1,230 @@
+#include "ui/GifFrameCache.hpp"
+
+#include <algorithm>
+
+
+namespace PGUI::UI
+{
+	GifFrameCache::GifFrameCache(std::size_t byteBudget, std::size_t keyframeInterval) noexcept :
+		byteBudget{ byteBudget }, keyframeInterval{ std::max(keyframeInterval, std::size_t{ 1 }) }
+	{
+	}
+
+	void GifFrameCache::Record(const Graphics::BitmapRenderTarget& composeTarget, RectU changedRect, Step step)
+	{
+		if (!IsRecording())
+		{
+			return;
+		}
+
+		auto composed = composeTarget.GetBitmap();
+		if (entries.empty())
+		{
+			frameSize = composed.GetPixelSize();
+		}
+		else if (composed.GetPixelSize() != frameSize)
+		{
+			Reset();
+			return;
+		}
+
+		changedRect = changedRect.IntersectRect(RectU{ PointU{ 0, 0 }, frameSize });
+
+		if (mode == Mode::Full)
+		{
+			if (byteSize + FullFrameBytes() <= byteBudget)
+			{
+				entries.push_back(Entry{ step, changedRect, CreateCopy(composeTarget, composed, std::nullopt), true });
+				byteSize += FullFrameBytes();
+				return;
+			}
+
+			ConvertToDeltas(composeTarget);
+			if (mode == Mode::Disabled)
+			{
+				return;
+			}
+		}
+
+		const bool isKeyframe = entries.empty() || IsWholeFrame(changedRect) ||
+			(entries.size() % keyframeInterval == 0 && byteSize + FullFrameBytes() <= byteBudget);
+		const auto bytes = isKeyframe ? FullFrameBytes() : RectBytes(changedRect);
+
+		if (byteSize + bytes > byteBudget)
+		{
+			Disable();
+			return;
+		}
+
+		Graphics::GraphicsBitmap bitmap;
+		if (isKeyframe)
+		{
+			bitmap = CreateCopy(composeTarget, composed, std::nullopt);
+		}
+		else if (bytes != 0)
+		{
+			bitmap = CreateCopy(composeTarget, composed, changedRect);
+		}
+
+		entries.push_back(Entry{ step, changedRect, std::move(bitmap), isKeyframe });
+		byteSize += bytes;
+	}
+
+	void GifFrameCache::Complete() noexcept
+	{
+		if (mode != Mode::Disabled && !entries.empty())
+		{
+			isComplete = true;
+		}
+	}
+
+	void GifFrameCache::Reset() noexcept
+	{
+		entries.clear();
+		byteSize = 0;
+		frameSize = { };
+		mode = Mode::Full;
+		isComplete = false;
+	}
+
+	auto GifFrameCache::GetFullFrame(std::size_t stepIndex) const noexcept -> Graphics::GraphicsBitmap
+	{
+		if (mode != Mode::Full || stepIndex >= entries.size())
+		{
+			return Graphics::GraphicsBitmap{ };
+		}
+		return entries[stepIndex].bitmap;
+	}
+
+	void GifFrameCache::ApplyStep(const Graphics::BitmapRenderTarget& composeTarget, std::size_t stepIndex)
+	{
+		hitCount++;
+
+		// Full frames are drawn straight from the cache, the compose target isn't used
+		if (mode != Mode::KeyframeDelta)
+		{
+			return;
+		}
+
+		CopyEntry(composeTarget.GetBitmap(), entries[stepIndex]);
+	}
+
+	auto GifFrameCache::RestoreStep(const Graphics::BitmapRenderTarget& composeTarget, std::size_t stepIndex) -> bool
+	{
+		if (!isComplete || stepIndex >= entries.size())
+		{
+			return false;
+		}
+
+		auto destination = composeTarget.GetBitmap();
+		if (destination.GetPixelSize() != frameSize)
+		{
+			return false;
+		}
+
+		// The first entry is always a keyframe
+		auto keyframeIndex = stepIndex;
+		while (!entries[keyframeIndex].isKeyframe)
+		{
+			keyframeIndex--;
+		}
+
+		for (auto i = keyframeIndex; i <= stepIndex; i++)
+		{
+			CopyEntry(destination, entries[i]);
+		}
+		return true;
+	}
+
+	void GifFrameCache::SetByteBudget(std::size_t _byteBudget) noexcept
+	{
+		byteBudget = _byteBudget;
+	}
+
+	auto GifFrameCache::FullFrameBytes() const noexcept -> std::size_t
+	{
+		return static_cast<std::size_t>(frameSize.cx) * frameSize.cy * 4;
+	}
+	auto GifFrameCache::RectBytes(RectU rect) noexcept -> std::size_t
+	{
+		return static_cast<std::size_t>(rect.Width()) * rect.Height() * 4;
+	}
+	auto GifFrameCache::IsWholeFrame(RectU rect) const noexcept -> bool
+	{
+		return rect == RectU{ PointU{ 0, 0 }, frameSize };
+	}
+
+	auto GifFrameCache::CreateCopy(const Graphics::BitmapRenderTarget& target,
+		const Graphics::GraphicsBitmap& source, std::optional<RectU> srcRect) -> Graphics::GraphicsBitmap
+	{
+		D2D1_BITMAP_PROPERTIES bitmapProp{ };
+		source->GetDpi(&bitmapProp.dpiX, &bitmapProp.dpiY);
+		bitmapProp.pixelFormat = source->GetPixelFormat();
+
+		const SizeU bitmapSize = srcRect.has_value() ? srcRect->Size() : source.GetPixelSize();
+
+		auto bitmap = target.CreateBitmap(bitmapSize, bitmapProp);
+		bitmap.CopyFromBitmap(source, PointU{ 0, 0 }, srcRect);
+
+		return bitmap;
+	}
+
+	void GifFrameCache::CopyEntry(const Graphics::GraphicsBitmap& destination, const Entry& entry)
+	{
+		if (!entry.bitmap)
+		{
+			return;
+		}
+
+		if (entry.isKeyframe)
+		{
+			destination.CopyFromBitmap(entry.bitmap);
+		}
+		else
+		{
+			destination.CopyFromBitmap(entry.bitmap, entry.changedRect.TopLeft());
+		}
+	}
+
+	void GifFrameCache::ConvertToDeltas(const Graphics::BitmapRenderTarget& composeTarget)
+	{
+		mode = Mode::KeyframeDelta;
+
+		auto convert = [this, &composeTarget](bool keepIntervalKeyframes)
+		{
+			byteSize = 0;
+			for (std::size_t i = 0; i < entries.size(); i++)
+			{
+				auto& entry = entries[i];
+				if (entry.isKeyframe &&
+					i != 0 && !IsWholeFrame(entry.changedRect) &&
+					!(keepIntervalKeyframes && i % keyframeInterval == 0))
+				{
+					entry.bitmap = RectBytes(entry.changedRect) != 0 ?
+						CreateCopy(composeTarget, entry.bitmap, entry.changedRect) :
+						Graphics::GraphicsBitmap{ };
+					entry.isKeyframe = false;
+				}
+
+				byteSize += entry.isKeyframe ? FullFrameBytes() : RectBytes(entry.changedRect);
+			}
+		};
+
+		convert(true);
+		if (byteSize > byteBudget)
+		{
+			convert(false);
+		}
+		if (byteSize > byteBudget)
+		{
+			Disable();
+		}
+	}
+
+	void GifFrameCache::Disable() noexcept
+	{
+		entries.clear();
+		byteSize = 0;
+		mode = Mode::Disabled;
+	}
+}
@@ -4,6 +4,9 @@
 
 #include "helpers/HelperFunctions.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 
 namespace PGUI::UI
 {
@@ -32,7 +35,10 @@ namespace PGUI::UI
 
 	LinearGradient::LinearGradient(PointF _start, PointF _end, const GradientStops& stops) noexcept :
 		Gradient{ stops }, start(_start), end(_end)
-	{ }
+	{
+		// Linear gradient brushes have always interpolated in linear light
+		SetGamma(D2D1_GAMMA_1_0);
+	}
 	
 	auto LinearGradient::Start() const noexcept -> PointF
 	{
@@ -118,4 +124,112 @@ namespace PGUI::UI
 
 		return gradient;
 	}
+
+	namespace
+	{
+		[[nodiscard]] auto SrgbToLinear(float value) noexcept -> float
+		{
+			return value <= 0.04045F ? value / 12.92F : std::pow((value + 0.055F) / 1.055F, 2.4F);
+		}
+		[[nodiscard]] auto LinearToSrgb(float value) noexcept -> float
+		{
+			return value <= 0.0031308F ? value * 12.92F : 1.055F * std::pow(value, 1.0F / 2.4F) - 0.055F;
+		}
+
+		[[nodiscard]] auto ToUnorm(float value) noexcept -> std::uint32_t
+		{
+			return static_cast<std::uint32_t>(std::clamp(value, 0.0F, 1.0F) * 255.0F + 0.5F);
+		}
+	}
+
+	GradientLut::GradientLut(const Gradient& gradient) :
+		GradientLut{ gradient.GetGradientStops(), gradient.GetGamma(), gradient.GetExtendMode() }
+	{
+	}
+
+	GradientLut::GradientLut(std::span<const GradientStop> stops, D2D1_GAMMA gamma, D2D1_EXTEND_MODE _extendMode) :
+		extendMode{ _extendMode }
+	{
+		if (stops.empty())
+		{
+			return;
+		}
+
+		// Stops are applied in position order, equal positions keep their order for a hard edge
+		std::vector<D2D1_GRADIENT_STOP> sorted{ stops.begin(), stops.end() };
+		std::ranges::stable_sort(sorted, std::less{ }, &D2D1_GRADIENT_STOP::position);
+
+		const auto isLinear = gamma == D2D1_GAMMA_1_0;
+		if (isLinear)
+		{
+			for (auto& stop : sorted)
+			{
+				stop.color.r = SrgbToLinear(stop.color.r);
+				stop.color.g = SrgbToLinear(stop.color.g);
+				stop.color.b = SrgbToLinear(stop.color.b);
+			}
+		}
+
+		std::size_t next = 0;
+		for (std::size_t i = 0; i < Size; i++)
+		{
+			const auto position = static_cast<float>(i) / (Size - 1);
+			while (next < sorted.size() && sorted[next].position <= position)
+			{
+				next++;
+			}
+
+			D2D1_COLOR_F color{ };
+			if (next == 0)
+			{
+				color = sorted.front().color;
+			}
+			else if (next == sorted.size())
+			{
+				color = sorted.back().color;
+			}
+			else
+			{
+				const auto& from = sorted[next - 1];
+				const auto& to = sorted[next];
+				const auto weight = (position - from.position) / (to.position - from.position);
+
+				color.r = std::lerp(from.color.r, to.color.r, weight);
+				color.g = std::lerp(from.color.g, to.color.g, weight);
+				color.b = std::lerp(from.color.b, to.color.b, weight);
+				color.a = std::lerp(from.color.a, to.color.a, weight);
+			}
+
+			if (isLinear)
+			{
+				color.r = LinearToSrgb(color.r);
+				color.g = LinearToSrgb(color.g);
+				color.b = LinearToSrgb(color.b);
+			}
+
+			const auto alpha = std::clamp(color.a, 0.0F, 1.0F);
+			colors[i] = (ToUnorm(alpha) << 24) |
+				(ToUnorm(color.r * alpha) << 16) | (ToUnorm(color.g * alpha) << 8) | ToUnorm(color.b * alpha);
+		}
+	}
+
+	auto GradientLut::Sample(float position) const noexcept -> std::uint32_t
+	{
+		switch (extendMode)
+		{
+			case D2D1_EXTEND_MODE_WRAP:
+				position -= std::floor(position);
+				break;
+			case D2D1_EXTEND_MODE_MIRROR:
+				position -= 2.0F * std::floor(position / 2.0F);
+				position = position > 1.0F ? 2.0F - position : position;
+				break;
+			default:
+				break;
+		}
+
+		// Also maps NaN to the first color
+		position = position > 0.0F ? (position < 1.0F ? position : 1.0F) : 0.0F;
+		return colors[static_cast<std::size_t>(position * (Size - 1) + 0.5F)];
+	}
 }
@@ -0,0 +1,136 @@
+#include "ui/GradientStopCache.hpp"
+
+#include "helpers/HelperFunctions.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+
+namespace PGUI::UI
+{
+	namespace
+	{
+		static_assert(sizeof(GradientStop) == sizeof(D2D1_GRADIENT_STOP));
+
+		[[nodiscard]] auto GetCaches() -> std::unordered_map<ID2D1Device*, GradientStopCache>&
+		{
+			static std::unordered_map<ID2D1Device*, GradientStopCache> caches;
+			return caches;
+		}
+	}
+
+	GradientStopCache::GradientStopCache(ComPtr<ID2D1Device> _device, std::size_t _capacity) noexcept :
+		device{ std::move(_device) }, capacity{ std::max<std::size_t>(_capacity, 1) }
+	{
+	}
+
+	auto GradientStopCache::ForRenderTarget(ID2D1RenderTarget* renderTarget) -> GradientStopCache*
+	{
+		ComPtr<ID2D1DeviceContext> deviceContext;
+		if (FAILED(renderTarget->QueryInterface(deviceContext.GetAddressOf())))
+		{
+			return nullptr;
+		}
+
+		ComPtr<ID2D1Device> device;
+		deviceContext->GetDevice(&device);
+
+		// The cache holds a reference to its device, so the pointer can't be reused by another one
+		auto& caches = GetCaches();
+		auto iter = caches.find(device.Get());
+		if (iter == caches.end())
+		{
+			iter = caches.try_emplace(device.Get(), device).first;
+		}
+		return &iter->second;
+	}
+
+	auto GradientStopCache::GetCollection(ID2D1RenderTarget* renderTarget, const Gradient& gradient)
+		-> ComPtr<ID2D1GradientStopCollection>
+	{
+		const auto& stops = gradient.GetGradientStops();
+
+		if (auto* cache = ForRenderTarget(renderTarget);
+			cache != nullptr)
+		{
+			return cache->Get(renderTarget, stops, gradient.GetGamma(), gradient.GetExtendMode());
+		}
+
+		ComPtr<ID2D1GradientStopCollection> collection;
+		HRESULT hr = renderTarget->CreateGradientStopCollection(
+			stops.data(), static_cast<UINT32>(stops.size()),
+			gradient.GetGamma(), gradient.GetExtendMode(), &collection); HR_T(hr);
+		return collection;
+	}
+
+	auto GradientStopCache::Get(ID2D1RenderTarget* renderTarget, std::span<const GradientStop> stops,
+		D2D1_GAMMA gamma, D2D1_EXTEND_MODE extendMode) -> ComPtr<ID2D1GradientStopCollection>
+	{
+		const auto key = MakeKey(stops, gamma, extendMode);
+		if (auto iter = entries.find(key);
+			iter != entries.end())
+		{
+			hitCount++;
+			iter->second.lastUse = ++useCounter;
+			return iter->second.collection;
+		}
+
+		missCount++;
+
+		ComPtr<ID2D1GradientStopCollection> collection;
+		HRESULT hr = renderTarget->CreateGradientStopCollection(
+			stops.data(), static_cast<UINT32>(stops.size()), gamma, extendMode, &collection); HR_T(hr);
+
+		Trim(capacity - 1);
+
+		// Moving the vector keeps its buffer, so the key can view it before the move
+		Entry entry{ GradientStops(stops.begin(), stops.end()), collection, ++useCounter };
+		auto storedKey = key;
+		storedKey.stops = entry.stops;
+		entries.emplace(storedKey, std::move(entry));
+
+		return collection;
+	}
+
+	void GradientStopCache::Clear() noexcept
+	{
+		entries.clear();
+	}
+
+	void GradientStopCache::SetCapacity(std::size_t _capacity)
+	{
+		capacity = std::max<std::size_t>(_capacity, 1);
+		Trim(capacity);
+	}
+
+	auto GradientStopCache::KeyEqual::operator()(const Key& left, const Key& right) const noexcept -> bool
+	{
+		// Compared bit for bit to agree with the hash
+		return left.hash == right.hash &&
+			left.gamma == right.gamma &&
+			left.extendMode == right.extendMode &&
+			left.stops.size() == right.stops.size() &&
+			std::memcmp(left.stops.data(), right.stops.data(), left.stops.size_bytes()) == 0;
+	}
+
+	auto GradientStopCache::MakeKey(std::span<const GradientStop> stops,
+		D2D1_GAMMA gamma, D2D1_EXTEND_MODE extendMode) noexcept -> Key
+	{
+		auto hash = HashBytes(std::as_bytes(stops));
+		hash = HashValue(gamma, hash);
+		hash = HashValue(extendMode, hash);
+
+		return Key{ stops, gamma, extendMode, static_cast<std::size_t>(hash) };
+	}
+
+	void GradientStopCache::Trim(std::size_t count)
+	{
+		while (entries.size() > count)
+		{
+			const auto oldest = std::ranges::min_element(entries, std::less{ },
+				[](const auto& pair) { return pair.second.lastUse; });
+			entries.erase(oldest);
+		}
+	}
+}
@@ -4,8 +4,12 @@
 #include "helpers/PropVariant.hpp"
 #include "ui/bmp/MetadataReader.hpp"
 #include "ui/bmp/Palette.hpp"
+#include "core/Dispatcher.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <new>
 
 
 namespace PGUI::UI
@@ -38,6 +42,294 @@ namespace PGUI::UI
 
 	#pragma endregion
 
+	#pragma region DecodedImageRenderer
+
+	DecodedImageRenderer::DecodedImageRenderer(std::wstring_view filePath, Bmp::DecodedImage image) noexcept :
+		filePath{ filePath }, image{ std::move(image) },
+		decodedSize{ this->image.size }, originalSize{ this->image.originalSize }
+	{
+	}
+
+	DecodedImageRenderer::~DecodedImageRenderer() noexcept
+	{
+		if (atlas != nullptr && atlasId.has_value())
+		{
+			atlas->Remove(*atlasId);
+		}
+	}
+
+	void DecodedImageRenderer::Render(Core::WindowPtr<Core::DirectCompositionWindow> wnd)
+	{
+		auto g = wnd->GetGraphics();
+
+		if (!bmp && DrawFromAtlas(g, wnd->GetClientRect()))
+		{
+			return;
+		}
+
+		if (!bmp)
+		{
+			const auto properties = D2D1::BitmapProperties(
+				D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED));
+			bmp = g.CreateBitmap(image.size, image.pixels.data(), image.stride, properties);
+
+			// The GPU copy is all that's needed from here on
+			image.pixels = { };
+		}
+
+		g.DrawBitmap(Graphics::GraphicsBitmap{ bmp }, wnd->GetClientRect());
+	}
+
+	auto DecodedImageRenderer::GetImage() const noexcept -> BmpToRender
+	{
+		return Bmp::BitmapDecoder{ filePath };
+	}
+
+	auto DecodedImageRenderer::DrawFromAtlas(const Graphics::Graphics& g, RectF destRect) -> bool
+	{
+		if (image.size.cx > MaxAtlasImageSize || image.size.cy > MaxAtlasImageSize || image.pixels.empty())
+		{
+			return false;
+		}
+
+		if (atlas == nullptr)
+		{
+			atlas = &Graphics::BitmapAtlas::GetForCurrentThread(g);
+		}
+		if (atlasId.has_value() && atlas->Draw(g, *atlasId, destRect))
+		{
+			return true;
+		}
+
+		// First draw, or evicted since the last one
+		atlasId = atlas->Add(image.size, image.pixels.data(), image.stride);
+		return atlasId.has_value() && atlas->Draw(g, *atlasId, destRect);
+	}
+
+	#pragma endregion
+
+	#pragma region TiledImageRenderer
+
+	TiledImageRenderer::TiledImageRenderer(std::wstring_view filePath,
+		std::shared_ptr<Bmp::TiledImage> tiledImage, Bmp::DecodedImage overview) noexcept :
+		filePath{ filePath }, tiledImage{ std::move(tiledImage) }, overview{ std::move(overview) }
+	{
+		ResetView();
+	}
+
+	void TiledImageRenderer::Render(Core::WindowPtr<Core::DirectCompositionWindow> wnd)
+	{
+		auto g = wnd->GetGraphics();
+		const SizeF clientSize = wnd->GetClientSize();
+
+		g.Clear(Colors::Transparent);
+		DrawOverview(g, clientSize);
+		DrawTiles(g, clientSize, wnd->Hwnd());
+	}
+
+	auto TiledImageRenderer::GetImage() const noexcept -> BmpToRender
+	{
+		return Bmp::BitmapDecoder{ filePath };
+	}
+
+	auto TiledImageRenderer::GetZoom(SizeF clientSize) const noexcept -> float
+	{
+		return zoom > 0.0F ? zoom : GetFitZoom(clientSize);
+	}
+
+	void TiledImageRenderer::ZoomAt(float factor, PointF anchor, SizeF clientSize) noexcept
+	{
+		const auto oldZoom = GetZoom(clientSize);
+		const auto newZoom = std::clamp(oldZoom * factor, std::min(GetFitZoom(clientSize), 1.0F), MaxZoom);
+
+		const PointF offset{ anchor.x - clientSize.cx / 2.0F, anchor.y - clientSize.cy / 2.0F };
+		center.x += offset.x / oldZoom - offset.x / newZoom;
+		center.y += offset.y / oldZoom - offset.y / newZoom;
+		zoom = newZoom;
+
+		Pan(PointF{ }, clientSize);
+	}
+
+	void TiledImageRenderer::Pan(PointF delta, SizeF clientSize) noexcept
+	{
+		const auto currentZoom = GetZoom(clientSize);
+		const SizeF imageSize = tiledImage->GetSize();
+
+		center.x = std::clamp(center.x - delta.x / currentZoom, 0.0F, imageSize.cx);
+		center.y = std::clamp(center.y - delta.y / currentZoom, 0.0F, imageSize.cy);
+	}
+
+	void TiledImageRenderer::ResetView() noexcept
+	{
+		const SizeF imageSize = tiledImage->GetSize();
+		zoom = 0.0F;
+		center = PointF{ imageSize.cx / 2.0F, imageSize.cy / 2.0F };
+	}
+
+	auto TiledImageRenderer::GetFitZoom(SizeF clientSize) const noexcept -> float
+	{
+		const SizeF imageSize = tiledImage->GetSize();
+		if (imageSize.cx == 0.0F || imageSize.cy == 0.0F)
+		{
+			return 1.0F;
+		}
+		return std::min(clientSize.cx / imageSize.cx, clientSize.cy / imageSize.cy);
+	}
+
+	auto TiledImageRenderer::ImageToClient(RectF imageRect, SizeF clientSize) const noexcept -> RectF
+	{
+		const auto currentZoom = GetZoom(clientSize);
+		const auto toClient = [currentZoom](float value, float imageCenter, float clientCenter)
+		{
+			// Whole pixels so neighbouring tiles share their edges exactly, seams show otherwise
+			return std::round((value - imageCenter) * currentZoom + clientCenter);
+		};
+
+		return RectF{
+			toClient(imageRect.left, center.x, clientSize.cx / 2.0F),
+			toClient(imageRect.top, center.y, clientSize.cy / 2.0F),
+			toClient(imageRect.right, center.x, clientSize.cx / 2.0F),
+			toClient(imageRect.bottom, center.y, clientSize.cy / 2.0F) };
+	}
+
+	void TiledImageRenderer::DrawOverview(const Graphics::Graphics& g, SizeF clientSize)
+	{
+		if (overview.pixels.empty() && !overviewBitmap)
+		{
+			return;
+		}
+
+		if (!overviewBitmap)
+		{
+			const auto properties = D2D1::BitmapProperties(
+				D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED));
+			overviewBitmap = g.CreateBitmap(overview.size, overview.pixels.data(), overview.stride, properties);
+			overview.pixels = { };
+		}
+
+		const SizeF imageSize = tiledImage->GetSize();
+		g.DrawBitmap(Graphics::GraphicsBitmap{ overviewBitmap },
+			ImageToClient(RectF{ PointF{ }, imageSize }, clientSize));
+	}
+
+	void TiledImageRenderer::DrawTiles(const Graphics::Graphics& g, SizeF clientSize, HWND hWnd)
+	{
+		const auto currentZoom = GetZoom(clientSize);
+		const SizeF imageSize = tiledImage->GetSize();
+
+		// Tiles can't add anything the overview doesn't already show
+		if (imageSize.cx == 0.0F || currentZoom <= static_cast<float>(overview.size.cx) / imageSize.cx)
+		{
+			return;
+		}
+
+		const auto& pyramid = tiledImage->GetPyramid();
+		const auto level = pyramid.SelectLevel(currentZoom);
+		const auto levelScale = std::ldexp(1.0F, static_cast<int>(level));
+		const RectF visibleRect{
+			center.x - clientSize.cx / (2.0F * currentZoom), center.y - clientSize.cy / (2.0F * currentZoom),
+			center.x + clientSize.cx / (2.0F * currentZoom), center.y + clientSize.cy / (2.0F * currentZoom) };
+
+		const auto properties = D2D1::BitmapProperties(
+			D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED));
+
+		frame++;
+		for (const auto key : pyramid.GetTilesInRect(level, visibleRect))
+		{
+			auto& tileBitmap = tileBitmaps[key];
+			if (!tileBitmap.bitmap)
+			{
+				const auto readyTile = tileRequests->ready.find(key);
+				if (readyTile == tileRequests->ready.end())
+				{
+					tileBitmaps.erase(key);
+					if (!tileRequests->pending.contains(key) && !tileRequests->failed.contains(key) &&
+						tileRequests->pending.size() < MaxPendingTileCount)
+					{
+						RequestTile(key, hWnd);
+					}
+					continue;
+				}
+
+				const auto& tile = readyTile->second;
+				tileBitmap.bitmap = g.CreateBitmap(tile->size, tile->pixels.data(), tile->size.cx * 4, properties);
+				tileRequests->ready.erase(readyTile);
+			}
+			tileBitmap.lastFrame = frame;
+
+			const auto tileRect = pyramid.GetTileRect(key);
+			const RectF imageRect{
+				static_cast<float>(tileRect.left) * levelScale, static_cast<float>(tileRect.top) * levelScale,
+				static_cast<float>(tileRect.right) * levelScale, static_cast<float>(tileRect.bottom) * levelScale };
+			g.DrawBitmap(tileBitmap.bitmap, ImageToClient(imageRect, clientSize));
+		}
+
+		// Tiles panned out of view before they arrived stay in the pyramid's cache
+		tileRequests->ready.clear();
+		TrimTileBitmaps();
+	}
+
+	void TiledImageRenderer::RequestTile(Bmp::TileKey key, HWND hWnd)
+	{
+		tileRequests->pending.insert(key);
+
+		Bmp::AsyncImageDecoder::GetInstance().Run(
+			[tiledImage = tiledImage, key, hWnd, requests = std::weak_ptr{ tileRequests },
+			queue = Core::Dispatcher::GetForCurrentThread().GetQueue()](IWICImagingFactory* /*unused*/) mutable
+		{
+			std::shared_ptr<const Bmp::ImageTile> tile;
+			try
+			{
+				tile = tiledImage->GetTile(key);
+			}
+			catch (const Core::PGUIException& exception)
+			{
+				HR_L(exception.GetErrorCode());
+			}
+			catch (const std::bad_alloc&)
+			{
+				HR_L(E_OUTOFMEMORY);
+			}
+
+			queue->Post([key, hWnd, requests = std::move(requests), tile = std::move(tile)]() mutable
+			{
+				const auto state = requests.lock();
+				if (!state)
+				{
+					return;
+				}
+
+				state->pending.erase(key);
+				if (tile)
+				{
+					state->ready.insert_or_assign(key, std::move(tile));
+				}
+				else
+				{
+					// The overview keeps showing there
+					state->failed.insert(key);
+				}
+				InvalidateRect(hWnd, nullptr, FALSE);
+			}, Core::DispatcherPriority::Render);
+		});
+	}
+
+	void TiledImageRenderer::TrimTileBitmaps()
+	{
+		if (tileBitmaps.size() <= MaxTileBitmapCount)
+		{
+			return;
+		}
+
+		// GPU copies are cheap to make again from the pyramid's cache, keep only what the last frame drew
+		std::erase_if(tileBitmaps, [this](const auto& entry)
+		{
+			return entry.second.lastFrame != frame;
+		});
+	}
+
+	#pragma endregion
+
 	#pragma region GifRenderer
 
 	GifRenderer::GifRenderer(Core::WindowPtr<Core::DirectCompositionWindow> wnd, Bmp::BitmapDecoder decoder) noexcept :
@@ -48,6 +340,15 @@ namespace PGUI::UI
 		GetFrameData();
 		ComposeFrame(wnd);
 	}
+	GifRenderer::GifRenderer(Core::WindowPtr<Core::DirectCompositionWindow> wnd,
+		std::shared_ptr<const Bmp::GifDecoder> gifDecoder, std::wstring_view filePath) :
+		composeRenderTarget{ wnd->GetGraphics().CreateCompatibleRenderTarget() },
+		gifComposer{ std::in_place, std::move(gifDecoder) },
+		filePath{ filePath }
+	{
+		GetGifDecoderData();
+		ComposeFrame(wnd);
+	}
 
 	void GifRenderer::Render(Core::WindowPtr<Core::DirectCompositionWindow> wnd) noexcept
 	{
@@ -56,7 +357,12 @@ namespace PGUI::UI
 			return;
 		}
 
-		auto frameToRender = composeRenderTarget.GetBitmap();
+		auto frameToRender = frameCache.IsComplete() ?
+			frameCache.GetFullFrame(cacheStep) : Graphics::GraphicsBitmap{ };
+		if (!frameToRender)
+		{
+			frameToRender = composeRenderTarget.GetBitmap();
+		}
 
 		auto g = wnd->GetGraphics();
 
@@ -70,6 +376,10 @@ namespace PGUI::UI
 
 	auto GifRenderer::GetImage() const noexcept -> BmpToRender
 	{
+		if (gifComposer.has_value())
+		{
+			return Bmp::BitmapDecoder{ filePath };
+		}
 		return decoder;
 	}
 
@@ -77,6 +387,20 @@ namespace PGUI::UI
 	{
 		composeRenderTarget = wnd->GetGraphics().CreateCompatibleRenderTarget(
 			gifPixelSize);
+
+		RestoreFromCache();
+	}
+
+	void GifRenderer::SetFrameCacheBudget(std::size_t byteBudget)
+	{
+		// Frames played from the cache in full never touched the compose target
+		if (frameCache.IsComplete())
+		{
+			RestoreFromCache();
+		}
+
+		frameCache.SetByteBudget(byteBudget);
+		frameCache.Reset();
 	}
 
 	auto GifRenderer::IsLastFrame() const noexcept -> bool
@@ -92,13 +416,37 @@ namespace PGUI::UI
 	{
 		wnd->RemoveTimer(frameTimer);
 
-		DisposeFrame();
-		OverlayFrame();
+		if (currentFrameIndex == 0 && frameCache.IsRecording() && frameCache.GetStepCount() != 0)
+		{
+			frameCache.Complete();
+		}
 
-		while (frameData[currentFrameIndex].frameDelay == 0ms && !IsLastFrame())
+		if (frameCache.IsComplete())
 		{
-			DisposeFrame();
-			OverlayFrame();
+			PlayCachedFrame();
+		}
+		else
+		{
+			const bool startsLoop = currentFrameIndex == 0;
+			changedArea = RectF{ };
+
+			if (gifComposer.has_value())
+			{
+				ComposeGifDecoderFrames();
+			}
+			else
+			{
+				DisposeFrame();
+				OverlayFrame();
+
+				while (frameData[currentFrameIndex].frameDelay == 0ms && !IsLastFrame())
+				{
+					DisposeFrame();
+					OverlayFrame();
+				}
+			}
+
+			RecordFrame(startsLoop);
 		}
 
 		if (!EndOfAnimation() && frameData.size() > 1)
@@ -113,6 +461,114 @@ namespace PGUI::UI
 		wnd->Invalidate();
 	}
 
+	void GifRenderer::PlayCachedFrame()
+	{
+		cacheStep = (cacheStep + 1) % frameCache.GetStepCount();
+		if (cacheStep == 0)
+		{
+			loopCount++;
+		}
+
+		try
+		{
+			frameCache.ApplyStep(composeRenderTarget, cacheStep);
+		}
+		catch (Core::HresultException& exception)
+		{
+			HR_L(exception);
+		}
+
+		const auto step = frameCache.GetStep(cacheStep);
+		currentFrameIndex = step.frameIndex;
+		nextFrameIndex = step.nextFrameIndex;
+	}
+
+	void GifRenderer::RecordFrame(bool startsLoop)
+	{
+		// Recording always starts with the first frame, so the cache holds whole loops
+		if (!frameCache.IsRecording() || (!startsLoop && frameCache.GetStepCount() == 0))
+		{
+			return;
+		}
+
+		try
+		{
+			frameCache.Record(composeRenderTarget, ToPixelRect(changedArea),
+				GifFrameCache::Step{ currentFrameIndex, nextFrameIndex });
+		}
+		catch (Core::HresultException& exception)
+		{
+			HR_L(exception);
+			frameCache.Reset();
+		}
+
+		if (frameCache.GetStepCount() != 0)
+		{
+			cacheStep = frameCache.GetStepCount() - 1;
+		}
+	}
+
+	void GifRenderer::RestoreFromCache()
+	{
+		if (!frameCache.IsComplete())
+		{
+			frameCache.Reset();
+			return;
+		}
+
+		try
+		{
+			if (!frameCache.RestoreStep(composeRenderTarget, cacheStep))
+			{
+				frameCache.Reset();
+			}
+		}
+		catch (Core::HresultException& exception)
+		{
+			HR_L(exception);
+			frameCache.Reset();
+		}
+	}
+
+	void GifRenderer::AddChangedArea(RectF area) noexcept
+	{
+		if (changedArea.Width() <= 0.F || changedArea.Height() <= 0.F)
+		{
+			changedArea = area;
+			return;
+		}
+
+		changedArea = RectF{
+			std::min(changedArea.left, area.left),
+			std::min(changedArea.top, area.top),
+			std::max(changedArea.right, area.right),
+			std::max(changedArea.bottom, area.bottom) };
+	}
+
+	auto GifRenderer::ToPixelRect(RectF rect) const -> RectU
+	{
+		const SizeF size = composeRenderTarget.GetSize();
+		const SizeU pixelSize = composeRenderTarget.GetPixelSize();
+		if (size.cx <= 0.F || size.cy <= 0.F)
+		{
+			return RectU{ };
+		}
+
+		const auto scaleX = static_cast<float>(pixelSize.cx) / size.cx;
+		const auto scaleY = static_cast<float>(pixelSize.cy) / size.cy;
+
+		auto toPixel = [](float value, UINT32 limit)
+		{
+			return static_cast<UINT32>(std::clamp(value, 0.F, static_cast<float>(limit)));
+		};
+
+		return RectU{
+			toPixel(std::floor(rect.left * scaleX), pixelSize.cx),
+			toPixel(std::floor(rect.top * scaleY), pixelSize.cy),
+			toPixel(std::ceil(rect.right * scaleX), pixelSize.cx),
+			toPixel(std::ceil(rect.bottom * scaleY), pixelSize.cy) };
+	}
+
 	void GifRenderer::DisposeFrame()
 	{
 		auto dispose = frameData[currentFrameIndex].disposal;
@@ -121,9 +577,11 @@ namespace PGUI::UI
 		{
 			case FrameDisposal::BACKGROUND:
 				ClearCurrentFrameArea();
+				AddChangedArea(frameData[currentFrameIndex].framePosition);
 				return;
 			case FrameDisposal::PREVIOUS:
 				RestoreSavedFrame();
+				AddChangedArea(RectF{ PointF{ 0.F, 0.F }, composeRenderTarget.GetSize() });
 				return;
 			default:
 				return;
@@ -145,6 +603,7 @@ namespace PGUI::UI
 		{
 			composeRenderTarget->Clear(backgroundColor);
 			loopCount++;
+			AddChangedArea(RectF{ PointF{ 0.F, 0.F }, composeRenderTarget.GetSize() });
 		}
 
 		auto b = composeRenderTarget.GetBitmap();
@@ -152,6 +611,7 @@ namespace PGUI::UI
 		composeRenderTarget.DrawBitmap(
 			composeRenderTarget.CreateBitmap(decoder.GetFrame(static_cast<UINT>(currentFrameIndex))),
 			currentFrameData.framePosition);
+		AddChangedArea(currentFrameData.framePosition);
 
 		HRESULT hr = composeRenderTarget->EndDraw(); HR_L(hr);
 
@@ -204,6 +664,82 @@ namespace PGUI::UI
 		frameToCopyTo.CopyFromBitmap(savedBitmap);
 	}
 
+	void GifRenderer::ComposeGifDecoderFrames()
+	{
+		RectU changedRect{ };
+
+		auto composeNextFrame = [this, &changedRect]
+		{
+			if (currentFrameIndex == 0)
+			{
+				loopCount++;
+			}
+
+			const auto frameRect = gifComposer->ComposeFrame(currentFrameIndex);
+			changedRect = changedRect.Area() == 0 ? frameRect : RectU{
+				std::min(changedRect.left, frameRect.left), std::min(changedRect.top, frameRect.top),
+				std::max(changedRect.right, frameRect.right), std::max(changedRect.bottom, frameRect.bottom) };
+
+			currentFrameIndex = nextFrameIndex;
+			nextFrameIndex++;
+			nextFrameIndex %= frameData.size();
+		};
+
+		try
+		{
+			composeNextFrame();
+			while (frameData[currentFrameIndex].frameDelay == 0ms && !IsLastFrame())
+			{
+				composeNextFrame();
+			}
+
+			UploadCanvas(changedRect);
+		}
+		catch (const Bmp::GifFormatException&)
+		{
+			HR_L(WINCODEC_ERR_BADIMAGE);
+		}
+		catch (Core::HresultException& exception)
+		{
+			HR_L(exception);
+		}
+	}
+
+	void GifRenderer::UploadCanvas(RectU changedRect)
+	{
+		if (changedRect.Area() == 0)
+		{
+			return;
+		}
+
+		const auto canvasSize = gifComposer->GetCanvasSize();
+		if (!canvasBitmap)
+		{
+			D2D1_BITMAP_PROPERTIES bitmapProp{ };
+			bitmapProp.pixelFormat = D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED);
+			canvasBitmap = composeRenderTarget.CreateBitmap(canvasSize, bitmapProp);
+			changedRect = RectU{ PointU{ 0, 0 }, canvasSize };
+		}
+
+		// Only the rows and columns that changed are sent to the GPU
+		const auto canvas = gifComposer->GetCanvas();
+		canvasBitmap.CopyFromMemory(
+			canvas.data() + static_cast<std::size_t>(changedRect.top) * canvasSize.cx + changedRect.left,
+			gifComposer->GetStride(), changedRect);
+
+		const SizeF targetSize = composeRenderTarget.GetSize();
+		composeRenderTarget->BeginDraw();
+		composeRenderTarget->Clear(Colors::Transparent);
+		composeRenderTarget.DrawBitmap(canvasBitmap, RectF{ PointF{ 0.F, 0.F }, targetSize });
+		HRESULT hr = composeRenderTarget->EndDraw(); HR_L(hr);
+
+		const auto scaleX = targetSize.cx / static_cast<float>(canvasSize.cx);
+		const auto scaleY = targetSize.cy / static_cast<float>(canvasSize.cy);
+		AddChangedArea(RectF{
+			static_cast<float>(changedRect.left) * scaleX, static_cast<float>(changedRect.top) * scaleY,
+			static_cast<float>(changedRect.right) * scaleX, static_cast<float>(changedRect.bottom) * scaleY });
+	}
+
 	void GifRenderer::GetGlobalMetadata()
 	{
 		GetBackgroundColor();
@@ -354,5 +890,31 @@ namespace PGUI::UI
 		}
 	}
 
+	void GifRenderer::GetGifDecoderData()
+	{
+		const auto& gifDecoder = gifComposer->GetDecoder();
+
+		gifSize = gifDecoder.GetCanvasSize();
+		gifPixelSize = gifSize;
+
+		if (const auto loopCountValue = gifDecoder.GetLoopCount();
+			loopCountValue.has_value())
+		{
+			totalLoopCount = *loopCountValue;
+			loop = totalLoopCount != 0;
+		}
+
+		for (std::size_t i = 0; i < gifDecoder.GetFrameCount(); i++)
+		{
+			const auto& info = gifDecoder.GetFrameInfo(i);
+
+			FrameData data;
+			data.framePosition = info.rect;
+			data.frameDelay = info.delay;
+			data.disposal = FrameDisposal{ static_cast<int>(info.disposal) };
+			frameData.push_back(data);
+		}
+	}
+
 	#pragma endregion
 }
@@ -0,0 +1,795 @@
+#include "ui/TextBuffer.hpp"
+
+#include "helpers/CpuFeatures.hpp"
+
+#if PGUI_X86
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <bit>
+#include <ranges>
+#include <tuple>
+
+
+namespace PGUI::UI
+{
+	namespace
+	{
+		using TextFinder = std::size_t (*)(std::wstring_view text, std::wstring_view pattern) noexcept;
+
+		auto FindScalar(std::wstring_view text, std::wstring_view pattern) noexcept -> std::size_t
+		{
+			return text.find(pattern);
+		}
+
+#if PGUI_X86
+		PGUI_TARGET_AVX2 auto SplatAvx2(wchar_t c) noexcept -> __m256i
+		{
+			if constexpr (sizeof(wchar_t) == 2)
+			{
+				return _mm256_set1_epi16(static_cast<short>(c));
+			}
+			else
+			{
+				return _mm256_set1_epi32(static_cast<int>(c));
+			}
+		}
+		PGUI_TARGET_AVX2 auto CompareAvx2(__m256i a, __m256i b) noexcept -> __m256i
+		{
+			if constexpr (sizeof(wchar_t) == 2)
+			{
+				return _mm256_cmpeq_epi16(a, b);
+			}
+			else
+			{
+				return _mm256_cmpeq_epi32(a, b);
+			}
+		}
+
+		/*
+		* Compares a block of positions against the pattern's first and last characters at once,
+		* only the positions matching both are compared in full
+		*/
+		PGUI_TARGET_AVX2 auto FindAvx2(std::wstring_view text, std::wstring_view pattern) noexcept -> std::size_t
+		{
+			constexpr auto lanes = sizeof(__m256i) / sizeof(wchar_t);
+			constexpr auto laneMask = (1U << sizeof(wchar_t)) - 1;
+
+			const auto last = pattern.size() - 1;
+			const auto first = SplatAvx2(pattern.front());
+			const auto lastChar = SplatAvx2(pattern.back());
+
+			std::size_t position = 0;
+			for (; position + lanes + last <= text.size(); position += lanes)
+			{
+				const auto firstBlock = _mm256_loadu_si256(std::bit_cast<const __m256i*>(text.data() + position));
+				const auto lastBlock = _mm256_loadu_si256(std::bit_cast<const __m256i*>(text.data() + position + last));
+
+				auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+					_mm256_and_si256(CompareAvx2(first, firstBlock), CompareAvx2(lastChar, lastBlock))));
+				while (mask != 0)
+				{
+					const auto lane = static_cast<std::size_t>(std::countr_zero(mask)) / sizeof(wchar_t);
+					if (text.substr(position + lane, pattern.size()) == pattern)
+					{
+						return position + lane;
+					}
+					mask &= ~(laneMask << (lane * sizeof(wchar_t)));
+				}
+			}
+
+			const auto found = text.substr(position).find(pattern);
+			return found == std::wstring_view::npos ? found : position + found;
+		}
+#endif
+
+		auto FindInText(std::wstring_view text, std::wstring_view pattern) noexcept -> std::size_t
+		{
+#if PGUI_X86
+			static const TextFinder finder = CpuFeatures::Get().avx2 ? FindAvx2 : FindScalar;
+#else
+			static const TextFinder finder = FindScalar;
+#endif
+
+			return finder(text, pattern);
+		}
+	}
+
+	TextBuffer::TextBuffer(wchar_t _lineBreak) :
+		TextBuffer{ std::wstring{ }, _lineBreak }
+	{
+	}
+	TextBuffer::TextBuffer(std::wstring text, wchar_t _lineBreak) :
+		lineBreak{ _lineBreak }
+	{
+		Assign(std::move(text));
+	}
+
+	void TextBuffer::Assign(std::wstring text)
+	{
+		nodes.clear();
+		nodes.emplace_back();
+		freeNodes.clear();
+		addBlocks.clear();
+		addBlockUsed = AddBlockLength;
+		ClearUndo();
+
+		original = std::move(text);
+
+		std::vector<Piece> pieces;
+		pieces.reserve((original.size() + MaxPieceLength - 1) / MaxPieceLength);
+		for (std::size_t offset = 0; offset < original.size(); offset += MaxPieceLength)
+		{
+			pieces.push_back(MakePiece(original.data() + offset, std::min(MaxPieceLength, original.size() - offset)));
+		}
+
+		root = Build(pieces);
+		version++;
+	}
+
+	void TextBuffer::Insert(std::size_t position, std::wstring_view text)
+	{
+		if (text.empty())
+		{
+			return;
+		}
+
+		position = std::min(position, GetLength());
+
+		auto pieces = AppendToAddBlocks(text);
+		InsertPieces(position, pieces);
+
+		Record(UndoEdit{
+			.position = position,
+			.erasedLength = 0,
+			.insertedLength = text.size(),
+			.erased = { },
+			.inserted = std::move(pieces)
+		}, true);
+	}
+
+	void TextBuffer::Erase(std::size_t position, std::size_t length)
+	{
+		position = std::min(position, GetLength());
+		length = std::min(length, GetLength() - position);
+		if (length == 0)
+		{
+			return;
+		}
+
+		Record(UndoEdit{
+			.position = position,
+			.erasedLength = length,
+			.insertedLength = 0,
+			.erased = ErasePieces(position, length),
+			.inserted = { }
+		}, false);
+	}
+
+	void TextBuffer::Replace(std::size_t position, std::size_t length, std::wstring_view text)
+	{
+		position = std::min(position, GetLength());
+		length = std::min(length, GetLength() - position);
+		if (length == 0)
+		{
+			Insert(position, text);
+			return;
+		}
+
+		auto erased = ErasePieces(position, length);
+		auto inserted = AppendToAddBlocks(text);
+		InsertPieces(position, inserted);
+
+		Record(UndoEdit{
+			.position = position,
+			.erasedLength = length,
+			.insertedLength = text.size(),
+			.erased = std::move(erased),
+			.inserted = std::move(inserted)
+		}, false);
+	}
+
+	auto TextBuffer::GetLength() const noexcept -> std::size_t
+	{
+		return nodes[root].subtreeLength;
+	}
+
+	auto TextBuffer::GetChar(std::size_t position) const noexcept -> wchar_t
+	{
+		auto node = root;
+		while (node != Nil)
+		{
+			const auto& current = nodes[node];
+			const auto leftLength = nodes[current.left].subtreeLength;
+
+			if (position < leftLength)
+			{
+				node = current.left;
+				continue;
+			}
+			position -= leftLength;
+
+			if (position < current.piece.length)
+			{
+				return current.piece.data[position];
+			}
+			position -= current.piece.length;
+			node = current.right;
+		}
+
+		return L'\0';
+	}
+
+	auto TextBuffer::GetText() const -> std::wstring
+	{
+		return GetText(0, GetLength());
+	}
+	auto TextBuffer::GetText(std::size_t position, std::size_t length) const -> std::wstring
+	{
+		position = std::min(position, GetLength());
+		length = std::min(length, GetLength() - position);
+
+		std::wstring text;
+		text.reserve(length);
+
+		VisitText(position, length, [&text](std::wstring_view view) { text.append(view); });
+
+		return text;
+	}
+
+	auto TextBuffer::Find(std::wstring_view text, std::size_t position, std::size_t end) const -> std::size_t
+	{
+		position = std::min(position, GetLength());
+		end = std::clamp(end, position, GetLength());
+		if (text.empty() || text.size() > end - position)
+		{
+			return NotFound;
+		}
+
+		// The last few characters before the piece being searched, matches starting there end in this piece
+		const auto overlap = text.size() - 1;
+		std::wstring carry;
+		carry.reserve(2 * overlap);
+
+		auto chunkStart = position;
+		auto found = NotFound;
+		VisitText(position, end - position, [&](std::wstring_view chunk)
+		{
+			if (!carry.empty())
+			{
+				const auto carryLength = carry.size();
+				carry.append(chunk.substr(0, overlap));
+
+				if (const auto index = FindInText(carry, text); index < carryLength)
+				{
+					found = chunkStart - carryLength + index;
+					return false;
+				}
+				carry.resize(carryLength);
+			}
+
+			if (const auto index = FindInText(chunk, text); index != NotFound)
+			{
+				found = chunkStart + index;
+				return false;
+			}
+
+			chunkStart += chunk.size();
+			carry.append(chunk.substr(chunk.size() - std::min(chunk.size(), overlap)));
+			carry.erase(0, carry.size() - std::min(carry.size(), overlap));
+
+			return true;
+		});
+
+		return found;
+	}
+
+	auto TextBuffer::GetLineCount() const noexcept -> std::size_t
+	{
+		return nodes[root].subtreeLineBreaks + 1;
+	}
+
+	auto TextBuffer::GetLineFromPosition(std::size_t position) const noexcept -> std::size_t
+	{
+		std::size_t line = 0;
+
+		auto node = root;
+		while (node != Nil)
+		{
+			const auto& current = nodes[node];
+			const auto& left = nodes[current.left];
+
+			if (position < left.subtreeLength)
+			{
+				node = current.left;
+				continue;
+			}
+			position -= left.subtreeLength;
+			line += left.subtreeLineBreaks;
+
+			if (position < current.piece.length)
+			{
+				return line + CountLineBreaks(current.piece.data, position);
+			}
+			position -= current.piece.length;
+			line += current.piece.lineBreaks;
+			node = current.right;
+		}
+
+		return line;
+	}
+
+	auto TextBuffer::GetLineStart(std::size_t line) const noexcept -> std::size_t
+	{
+		if (line == 0)
+		{
+			return 0;
+		}
+		if (line >= GetLineCount())
+		{
+			return GetLength();
+		}
+
+		// Right after the line'th line break
+		std::size_t position = 0;
+
+		auto node = root;
+		while (node != Nil)
+		{
+			const auto& current = nodes[node];
+			const auto& left = nodes[current.left];
+
+			if (line <= left.subtreeLineBreaks)
+			{
+				node = current.left;
+				continue;
+			}
+			line -= left.subtreeLineBreaks;
+			position += left.subtreeLength;
+
+			if (line <= current.piece.lineBreaks)
+			{
+				const auto* data = current.piece.data;
+				const auto* end = data + current.piece.length;
+				for (; line > 0; line--)
+				{
+					data = std::find(data, end, lineBreak) + 1;
+				}
+
+				return position + static_cast<std::size_t>(data - current.piece.data);
+			}
+			line -= current.piece.lineBreaks;
+			position += current.piece.length;
+			node = current.right;
+		}
+
+		return GetLength();
+	}
+
+	auto TextBuffer::GetLineLength(std::size_t line) const noexcept -> std::size_t
+	{
+		const auto lineCount = GetLineCount();
+		if (line >= lineCount)
+		{
+			return 0;
+		}
+
+		const auto lineEnd = line + 1 < lineCount ? GetLineStart(line + 1) - 1 : GetLength();
+		return lineEnd - GetLineStart(line);
+	}
+
+	auto TextBuffer::GetLine(std::size_t line) const -> std::wstring
+	{
+		return GetText(GetLineStart(line), GetLineLength(line));
+	}
+
+	void TextBuffer::BeginUndoGroup() noexcept
+	{
+		isTyping = false;
+		groupDepth++;
+	}
+	void TextBuffer::EndUndoGroup() noexcept
+	{
+		if (groupDepth == 0)
+		{
+			return;
+		}
+
+		isTyping = false;
+		if (--groupDepth == 0)
+		{
+			isGroupOpen = false;
+			TrimUndo();
+		}
+	}
+
+	void TextBuffer::StopGroupTyping() noexcept
+	{
+		isTyping = false;
+	}
+
+	auto TextBuffer::Undo() -> bool
+	{
+		if (!CanUndo())
+		{
+			return false;
+		}
+
+		auto group = std::move(undoStack.back());
+		undoStack.pop_back();
+
+		for (const auto& edit : group | std::views::reverse)
+		{
+			std::ignore = ErasePieces(edit.position, edit.insertedLength);
+			InsertPieces(edit.position, edit.erased);
+		}
+
+		redoStack.push_back(std::move(group));
+		isTyping = false;
+
+		return true;
+	}
+	auto TextBuffer::Redo() -> bool
+	{
+		if (!CanRedo())
+		{
+			return false;
+		}
+
+		auto group = std::move(redoStack.back());
+		redoStack.pop_back();
+
+		for (const auto& edit : group)
+		{
+			std::ignore = ErasePieces(edit.position, edit.erasedLength);
+			InsertPieces(edit.position, edit.inserted);
+		}
+
+		undoStack.push_back(std::move(group));
+		isTyping = false;
+
+		return true;
+	}
+
+	void TextBuffer::ClearUndo() noexcept
+	{
+		undoStack.clear();
+		redoStack.clear();
+		isGroupOpen = false;
+		isTyping = false;
+	}
+
+	void TextBuffer::SetUndoLimit(std::size_t _undoLimit)
+	{
+		undoLimit = _undoLimit;
+		TrimUndo();
+	}
+
+	auto TextBuffer::GetPieceCount() const noexcept -> std::size_t
+	{
+		return nodes.size() - freeNodes.size() - 1;
+	}
+
+	auto TextBuffer::MakePiece(const wchar_t* data, std::size_t length) const noexcept -> Piece
+	{
+		return Piece{
+			data,
+			static_cast<std::uint32_t>(length),
+			static_cast<std::uint32_t>(CountLineBreaks(data, length))
+		};
+	}
+
+	auto TextBuffer::CountLineBreaks(const wchar_t* data, std::size_t length) const noexcept -> std::size_t
+	{
+		return static_cast<std::size_t>(std::count(data, data + length, lineBreak));
+	}
+
+	auto TextBuffer::AppendToAddBlocks(std::wstring_view text) -> std::vector<Piece>
+	{
+		std::vector<Piece> pieces;
+
+		while (!text.empty())
+		{
+			if (addBlockUsed == AddBlockLength)
+			{
+				addBlocks.push_back(std::make_unique_for_overwrite<wchar_t[]>(AddBlockLength));
+				addBlockUsed = 0;
+			}
+
+			const auto count = std::min({ text.size(), AddBlockLength - addBlockUsed, MaxPieceLength });
+			auto* data = addBlocks.back().get() + addBlockUsed;
+
+			std::ranges::copy(text.substr(0, count), data);
+			addBlockUsed += count;
+			text.remove_prefix(count);
+
+			pieces.push_back(MakePiece(data, count));
+		}
+
+		return pieces;
+	}
+
+	auto TextBuffer::NewNode(const Piece& piece) -> NodeIndex
+	{
+		// xorshift, the tree only needs priorities that don't follow the positions
+		seed ^= seed << 13;
+		seed ^= seed >> 17;
+		seed ^= seed << 5;
+
+		Node node{
+			.piece = piece,
+			.priority = seed,
+			.subtreeLength = piece.length,
+			.subtreeLineBreaks = piece.lineBreaks
+		};
+
+		if (!freeNodes.empty())
+		{
+			const auto index = freeNodes.back();
+			freeNodes.pop_back();
+			nodes[index] = node;
+			return index;
+		}
+
+		nodes.push_back(node);
+		return static_cast<NodeIndex>(nodes.size() - 1);
+	}
+
+	void TextBuffer::FreeSubtree(NodeIndex node, std::vector<Piece>& pieces)
+	{
+		if (node == Nil)
+		{
+			return;
+		}
+
+		FreeSubtree(nodes[node].left, pieces);
+		pieces.push_back(nodes[node].piece);
+		FreeSubtree(nodes[node].right, pieces);
+
+		freeNodes.push_back(node);
+	}
+
+	void TextBuffer::Update(NodeIndex node) noexcept
+	{
+		auto& current = nodes[node];
+		const auto& left = nodes[current.left];
+		const auto& right = nodes[current.right];
+
+		current.subtreeLength = left.subtreeLength + current.piece.length + right.subtreeLength;
+		current.subtreeLineBreaks = left.subtreeLineBreaks + current.piece.lineBreaks + right.subtreeLineBreaks;
+	}
+
+	auto TextBuffer::Merge(NodeIndex left, NodeIndex right) noexcept -> NodeIndex
+	{
+		if (left == Nil)
+		{
+			return right;
+		}
+		if (right == Nil)
+		{
+			return left;
+		}
+
+		if (nodes[left].priority > nodes[right].priority)
+		{
+			const auto merged = Merge(nodes[left].right, right);
+			nodes[left].right = merged;
+			Update(left);
+			return left;
+		}
+
+		const auto merged = Merge(left, nodes[right].left);
+		nodes[right].left = merged;
+		Update(right);
+		return right;
+	}
+
+	auto TextBuffer::Split(NodeIndex node, std::size_t position) -> std::pair<NodeIndex, NodeIndex>
+	{
+		if (node == Nil)
+		{
+			return { Nil, Nil };
+		}
+
+		const auto leftLength = nodes[nodes[node].left].subtreeLength;
+		const auto pieceLength = nodes[node].piece.length;
+
+		if (position <= leftLength)
+		{
+			const auto [left, right] = Split(nodes[node].left, position);
+			nodes[node].left = right;
+			Update(node);
+			return { left, node };
+		}
+		if (position >= leftLength + pieceLength)
+		{
+			const auto [left, right] = Split(nodes[node].right, position - leftLength - pieceLength);
+			nodes[node].right = left;
+			Update(node);
+			return { node, right };
+		}
+
+		// Cuts the piece, the node keeps the head and the tail goes in a new one
+		const auto offset = position - leftLength;
+		const auto piece = nodes[node].piece;
+
+		Piece head{ piece.data, static_cast<std::uint32_t>(offset), 0 };
+		Piece tail{ piece.data + offset, static_cast<std::uint32_t>(piece.length - offset), 0 };
+		if (head.length <= tail.length)
+		{
+			head.lineBreaks = static_cast<std::uint32_t>(CountLineBreaks(head.data, head.length));
+			tail.lineBreaks = piece.lineBreaks - head.lineBreaks;
+		}
+		else
+		{
+			tail.lineBreaks = static_cast<std::uint32_t>(CountLineBreaks(tail.data, tail.length));
+			head.lineBreaks = piece.lineBreaks - tail.lineBreaks;
+		}
+
+		const auto tailNode = NewNode(tail);
+
+		const auto right = nodes[node].right;
+		nodes[node].piece = head;
+		nodes[node].right = Nil;
+		Update(node);
+
+		return { node, Merge(tailNode, right) };
+	}
+
+	auto TextBuffer::Build(std::span<const Piece> pieces) -> NodeIndex
+	{
+		NodeIndex built = Nil;
+		for (const auto& piece : pieces)
+		{
+			const auto node = NewNode(piece);
+			built = Merge(built, node);
+		}
+
+		return built;
+	}
+
+	auto TextBuffer::ExtendPieceEndingAt(NodeIndex node, std::size_t position, const Piece& piece) noexcept -> bool
+	{
+		if (node == Nil)
+		{
+			return false;
+		}
+
+		auto& current = nodes[node];
+		const auto leftLength = nodes[current.left].subtreeLength;
+		const auto pieceEnd = leftLength + current.piece.length;
+
+		bool isExtended = false;
+		if (position <= leftLength)
+		{
+			isExtended = ExtendPieceEndingAt(current.left, position, piece);
+		}
+		else if (position > pieceEnd)
+		{
+			isExtended = ExtendPieceEndingAt(current.right, position - pieceEnd, piece);
+		}
+		else if (position == pieceEnd &&
+			current.piece.data + current.piece.length == piece.data &&
+			current.piece.length + piece.length <= MaxPieceLength)
+		{
+			current.piece.length += piece.length;
+			current.piece.lineBreaks += piece.lineBreaks;
+			isExtended = true;
+		}
+
+		if (isExtended)
+		{
+			Update(node);
+		}
+
+		return isExtended;
+	}
+
+	void TextBuffer::InsertPieces(std::size_t position, std::span<const Piece> pieces)
+	{
+		if (pieces.empty())
+		{
+			return;
+		}
+		version++;
+
+		// Text typed or put back right after the piece it continues in memory just lengthens that piece
+		if (position > 0 && ExtendPieceEndingAt(root, position, pieces.front()))
+		{
+			position += pieces.front().length;
+			pieces = pieces.subspan(1);
+
+			if (pieces.empty())
+			{
+				return;
+			}
+		}
+
+		const auto inserted = Build(pieces);
+		const auto [left, right] = Split(root, position);
+		root = Merge(Merge(left, inserted), right);
+	}
+
+	auto TextBuffer::ErasePieces(std::size_t position, std::size_t length) -> std::vector<Piece>
+	{
+		std::vector<Piece> erased;
+		if (length == 0)
+		{
+			return erased;
+		}
+		version++;
+
+		const auto [left, rest] = Split(root, position);
+		const auto [middle, right] = Split(rest, length);
+
+		FreeSubtree(middle, erased);
+		root = Merge(left, right);
+
+		return erased;
+	}
+
+	void TextBuffer::Record(UndoEdit edit, bool isTypingInsert)
+	{
+		if (undoLimit == 0)
+		{
+			return;
+		}
+
+		redoStack.clear();
+
+		const bool continuesTyping = isTypingInsert && isTyping && edit.position == typingEnd;
+		const bool startsGroup = groupDepth > 0 ? !isGroupOpen : !continuesTyping;
+		if (startsGroup || undoStack.empty())
+		{
+			undoStack.emplace_back();
+			isGroupOpen = groupDepth > 0;
+		}
+
+		isTyping = isTypingInsert && groupDepth == 0;
+		typingEnd = edit.position + edit.insertedLength;
+
+		auto& group = undoStack.back();
+		if (isTypingInsert && !group.empty() &&
+			group.back().position + group.back().insertedLength == edit.position)
+		{
+			// Continues the last edit, its pieces are merged where they're adjacent in memory too
+			auto& last = group.back();
+			for (const auto& piece : edit.inserted)
+			{
+				if (!last.inserted.empty() &&
+					last.inserted.back().data + last.inserted.back().length == piece.data &&
+					last.inserted.back().length + piece.length <= MaxPieceLength)
+				{
+					last.inserted.back().length += piece.length;
+					last.inserted.back().lineBreaks += piece.lineBreaks;
+				}
+				else
+				{
+					last.inserted.push_back(piece);
+				}
+			}
+			last.insertedLength += edit.insertedLength;
+		}
+		else
+		{
+			group.push_back(std::move(edit));
+		}
+
+		TrimUndo();
+	}
+
+	void TextBuffer::TrimUndo() noexcept
+	{
+		// The open group stays even when it's over the limit
+		const auto keep = std::max<std::size_t>(undoLimit, isGroupOpen ? 1 : 0);
+		while (undoStack.size() > keep)
+		{
+			undoStack.pop_front();
+		}
+		while (redoStack.size() > undoLimit)
+		{
+			redoStack.pop_front();
+		}
+	}
+}
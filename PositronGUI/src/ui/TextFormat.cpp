@@ -3,18 +3,24 @@
 #include "helpers/HelperFunctions.hpp"
 #include "factories/DWriteFactory.hpp"
 #include "ui/font/FontSet.hpp"
+#include "ui/TextFormatCache.hpp"
 
 
 namespace PGUI::UI
 {
 	auto TextFormat::GetDefTextFormat(FLOAT fontSize) -> TextFormat
 	{
-		auto textFormat = TextFormat{ L"Segoe UI", fontSize, GetUserLocaleName() };
-
-		textFormat.SetParagraphAlignment(Font::ParagraphAlignments::Center);
-		textFormat.SetTextAlignment(Font::TextAlignments::Center);
-
-		return textFormat;
+		return TextFormatCache::GetInstance().Get(GetDefTextFormatDescriptor(fontSize));
+	}
+	auto TextFormat::GetDefTextFormatDescriptor(FLOAT fontSize) -> TextFormatDescriptor
+	{
+		return TextFormatDescriptor{
+			.fontFamilyName = L"Segoe UI",
+			.fontSize = fontSize,
+			.localeName = GetUserLocaleName(),
+			.paragraphAlignment = Font::ParagraphAlignments::Center,
+			.textAlignment = Font::TextAlignments::Center
+		};
 	}
 	TextFormat::TextFormat(std::wstring_view fontFamilyName,
 		FLOAT fontSize, std::wstring_view localeName,
@@ -37,22 +43,71 @@ namespace PGUI::UI
 			fontSize, localeName.data(), GetHeldPtrAddress()); HR_L(hr);
 	}
 
+	TextFormat::TextFormat(const TextFormatDescriptor& descriptor) noexcept :
+		TextFormat{ descriptor.fontFamilyName, descriptor.fontSize, descriptor.localeName, descriptor.fontCollection,
+			descriptor.fontWeight, descriptor.fontStyle, descriptor.fontStretch }
+	{
+		if (!IsInitialized())
+		{
+			return;
+		}
+
+		SetFlowDirection(descriptor.flowDirection);
+		SetParagraphAlignment(descriptor.paragraphAlignment);
+		SetReadingDirection(descriptor.readingDirection);
+		SetTextAlignment(descriptor.textAlignment);
+		SetWordWrapping(descriptor.wordWrapping);
+		if (descriptor.incrementalTabStop > 0.0F)
+		{
+			SetIncrementalTabStop(descriptor.incrementalTabStop);
+		}
+		SetLineSpacing(descriptor.lineSpacing);
+		SetTrimming(descriptor.trimming, descriptor.trimmingSign);
+	}
+
 	auto TextFormat::AdjustFontSizeToDPI(float fontSize) const noexcept -> TextFormat
 	{
-		TextFormat newTf{ GetFontFamilyName(), fontSize, GetLocaleName(),
-			GetFontCollection(), GetFontWeight(), GetFontStyle(), GetFontStretch() };
+		auto descriptor = GetDescriptor();
+		descriptor.fontSize = fontSize;
 
-		newTf.SetFlowDirection(GetFlowDirection());
-		newTf.SetIncrementalTabStop(GetIncrementalTabStop());
-		newTf.SetLineSpacing(GetLineSpacing());
-		newTf.SetParagraphAlignment(GetParagraphAlignment());
-		newTf.SetReadingDirection(GetReadingDirection());
-		newTf.SetTextAlignment(GetTextAlignment());
-		auto [trimming, inlineObj] = GetTrimming();
-		newTf.SetTrimming(trimming, inlineObj);
-		newTf.SetWordWrapping(GetWordWrapping());
+		return TextFormatCache::GetInstance().Get(descriptor);
+	}
+
+	auto TextFormat::GetDescriptor() const -> TextFormatDescriptor
+	{
+		auto [trimming, trimmingSign] = GetTrimming();
+
+		TextFormatDescriptor descriptor{
+			.fontFamilyName = GetFontFamilyName(),
+			.fontSize = GetFontSize(),
+			.localeName = GetLocaleName(),
+			.fontWeight = GetFontWeight(),
+			.fontStyle = GetFontStyle(),
+			.fontStretch = GetFontStretch(),
+			.flowDirection = GetFlowDirection(),
+			.paragraphAlignment = GetParagraphAlignment(),
+			.readingDirection = GetReadingDirection(),
+			.textAlignment = GetTextAlignment(),
+			.wordWrapping = GetWordWrapping(),
+			.incrementalTabStop = GetIncrementalTabStop(),
+			.lineSpacing = GetLineSpacing(),
+			.trimming = trimming,
+			.trimmingSign = trimmingSign
+		};
+
+		// Left as defaults so the descriptor matches the ones formats are made from
+		if (auto fontCollection = GetFontCollection();
+			static_cast<IDWriteFontCollection3*>(fontCollection) !=
+			static_cast<IDWriteFontCollection3*>(Font::FontCollection::GetSystemFontCollection()))
+		{
+			descriptor.fontCollection = fontCollection;
+		}
+		if (descriptor.incrementalTabStop == 4.0F * descriptor.fontSize)
+		{
+			descriptor.incrementalTabStop = 0.0F;
+		}
 
-		return newTf;
+		return descriptor;
 	}
 
 	auto TextFormat::GetFlowDirection() const noexcept -> Font::FlowDirection
@@ -183,9 +238,9 @@ namespace PGUI::UI
 		HRESULT hr = GetHeldComPtr()->SetReadingDirection(readingDirection); HR_L(hr);
 	}
 	
-	auto TextFormat::GetTextAlignment() noexcept -> Font::TextAlignment
+	auto TextFormat::GetTextAlignment() const noexcept -> Font::TextAlignment
 	{
-		return {};
+		return GetHeldComPtr()->GetTextAlignment();
 	}
 	void TextFormat::SetTextAlignment(Font::TextAlignment textAlignment) const noexcept
 	{
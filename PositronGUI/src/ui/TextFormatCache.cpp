@@ -0,0 +1,185 @@
+#include "ui/TextFormatCache.hpp"
+
+#include "core/Exceptions.hpp"
+#include "helpers/HelperFunctions.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <new>
+#include <tuple>
+
+
+namespace PGUI::UI
+{
+	namespace
+	{
+		// Everything but the strings, floats by their bits so equality agrees with the hash
+		[[nodiscard]] auto GetFields(const TextFormatDescriptor& descriptor) noexcept
+		{
+			const auto* fontCollection = descriptor.fontCollection.has_value() ?
+				static_cast<IDWriteFontCollection3*>(descriptor.fontCollection.value()) : nullptr;
+
+			return std::tuple{
+				std::bit_cast<std::uint32_t>(descriptor.fontSize),
+				static_cast<DWRITE_FONT_WEIGHT>(descriptor.fontWeight),
+				static_cast<DWRITE_FONT_STYLE>(descriptor.fontStyle),
+				static_cast<DWRITE_FONT_STRETCH>(descriptor.fontStretch),
+				static_cast<DWRITE_FLOW_DIRECTION>(descriptor.flowDirection),
+				static_cast<DWRITE_PARAGRAPH_ALIGNMENT>(descriptor.paragraphAlignment),
+				static_cast<DWRITE_READING_DIRECTION>(descriptor.readingDirection),
+				static_cast<DWRITE_TEXT_ALIGNMENT>(descriptor.textAlignment),
+				static_cast<DWRITE_WORD_WRAPPING>(descriptor.wordWrapping),
+				std::bit_cast<std::uint32_t>(descriptor.incrementalTabStop),
+				descriptor.lineSpacing.method,
+				std::bit_cast<std::uint32_t>(descriptor.lineSpacing.height),
+				std::bit_cast<std::uint32_t>(descriptor.lineSpacing.baseline),
+				std::bit_cast<std::uint32_t>(descriptor.lineSpacing.leadingBefore),
+				descriptor.lineSpacing.fontLineGapUsage,
+				descriptor.trimming.granularity,
+				descriptor.trimming.delimiter,
+				descriptor.trimming.delimiterCount,
+				fontCollection,
+				static_cast<const IDWriteInlineObject*>(descriptor.trimmingSign.Get())
+			};
+		}
+	}
+
+	auto TextFormatCache::GetInstance() -> TextFormatCache&
+	{
+		static TextFormatCache instance;
+		return instance;
+	}
+
+	TextFormatCache::TextFormatCache(std::size_t _capacity) noexcept :
+		capacity{ std::max<std::size_t>(_capacity, 1) }
+	{
+	}
+
+	auto TextFormatCache::Get(const TextFormatDescriptor& descriptor) -> TextFormat
+	{
+		const auto key = MakeKey(descriptor);
+
+		std::scoped_lock lock{ mutex };
+
+		if (auto iter = entries.find(key);
+			iter != entries.end())
+		{
+			hitCount++;
+			lru.splice(lru.begin(), lru, iter->second);
+			return iter->second->textFormat;
+		}
+
+		missCount++;
+
+		TextFormat textFormat{ descriptor };
+		if (!textFormat)
+		{
+			// Failed to create, already logged, don't cache the empty format
+			return textFormat;
+		}
+
+		Trim(capacity - 1);
+
+		lru.emplace_front(descriptor, textFormat);
+		entries.emplace(Key{ &lru.front().descriptor, key.hash }, lru.begin());
+
+		return textFormat;
+	}
+
+	auto TextFormatCache::Intern(const TextFormat& textFormat) noexcept -> TextFormat
+	{
+		if (!textFormat)
+		{
+			return textFormat;
+		}
+
+		try
+		{
+			return Get(textFormat.GetDescriptor());
+		}
+		catch (const Core::PGUIException& exception)
+		{
+			HR_L(exception.GetErrorCode());
+		}
+		catch (const std::bad_alloc&)
+		{
+			HR_L(E_OUTOFMEMORY);
+		}
+
+		return textFormat;
+	}
+
+	void TextFormatCache::Clear() noexcept
+	{
+		std::scoped_lock lock{ mutex };
+
+		entries.clear();
+		lru.clear();
+	}
+
+	auto TextFormatCache::GetCapacity() const noexcept -> std::size_t
+	{
+		std::scoped_lock lock{ mutex };
+		return capacity;
+	}
+	void TextFormatCache::SetCapacity(std::size_t _capacity)
+	{
+		std::scoped_lock lock{ mutex };
+
+		capacity = std::max<std::size_t>(_capacity, 1);
+		Trim(capacity);
+	}
+	auto TextFormatCache::GetCount() const noexcept -> std::size_t
+	{
+		std::scoped_lock lock{ mutex };
+		return entries.size();
+	}
+	auto TextFormatCache::GetHitCount() const noexcept -> std::uint64_t
+	{
+		std::scoped_lock lock{ mutex };
+		return hitCount;
+	}
+	auto TextFormatCache::GetMissCount() const noexcept -> std::uint64_t
+	{
+		std::scoped_lock lock{ mutex };
+		return missCount;
+	}
+	auto TextFormatCache::GetEvictionCount() const noexcept -> std::uint64_t
+	{
+		std::scoped_lock lock{ mutex };
+		return evictionCount;
+	}
+
+	auto TextFormatCache::KeyEqual::operator()(const Key& left, const Key& right) const noexcept -> bool
+	{
+		return left.hash == right.hash &&
+			left.descriptor->fontFamilyName == right.descriptor->fontFamilyName &&
+			left.descriptor->localeName == right.descriptor->localeName &&
+			GetFields(*left.descriptor) == GetFields(*right.descriptor);
+	}
+
+	auto TextFormatCache::MakeKey(const TextFormatDescriptor& descriptor) noexcept -> Key
+	{
+		auto hash = HashBytes(std::as_bytes(std::span{ descriptor.fontFamilyName }));
+		hash = HashValue(descriptor.fontFamilyName.size(), hash);
+		hash = HashBytes(std::as_bytes(std::span{ descriptor.localeName }), hash);
+
+		std::apply([&hash](const auto&... fields)
+		{
+			((hash = HashValue(fields, hash)), ...);
+		}, GetFields(descriptor));
+
+		return Key{ &descriptor, static_cast<std::size_t>(hash) };
+	}
+
+	void TextFormatCache::Trim(std::size_t count) noexcept
+	{
+		while (entries.size() > count)
+		{
+			const auto& oldest = lru.back();
+			entries.erase(Key{ &oldest.descriptor, MakeKey(oldest.descriptor).hash });
+			lru.pop_back();
+			evictionCount++;
+		}
+	}
+}
@@ -71,6 +71,14 @@ namespace PGUI::UI
 
 		return clusterMetrics;
 	}
+	auto TextLayout::GetClusterCount() const noexcept -> UINT32
+	{
+		// Fails with E_NOT_SUFFICIENT_BUFFER whenever there are clusters, so that isn't logged
+		UINT32 clusterCount = 0;
+		GetHeldComPtr()->GetClusterMetrics(nullptr, 0, &clusterCount);
+
+		return clusterCount;
+	}
 	auto TextLayout::GetLineMetrics() const noexcept -> std::vector<DWRITE_LINE_METRICS1>
 	{
 		auto tl = GetHeldComPtr();
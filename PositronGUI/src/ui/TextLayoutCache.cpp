@@ -0,0 +1,297 @@
+#include "ui/TextLayoutCache.hpp"
+
+#include "helpers/HelperFunctions.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <span>
+#include <utility>
+
+
+namespace PGUI::UI
+{
+	namespace
+	{
+		/**
+		* @brief Share of the extra width and height the lines move by, for alignments that only move them
+		*/
+		[[nodiscard]] auto GetAlignment(const TextLayout& textLayout) noexcept -> std::optional<PointF>
+		{
+			IDWriteTextLayout4* layout = textLayout;
+
+			// Trimming depends on the size too, where it cuts the text off changes with it
+			DWRITE_TRIMMING trimming{ };
+			ComPtr<IDWriteInlineObject> trimmingSign;
+			HRESULT hr = layout->GetTrimming(&trimming, &trimmingSign); HR_L(hr);
+			if (FAILED(hr) || trimming.granularity != DWRITE_TRIMMING_GRANULARITY_NONE)
+			{
+				return std::nullopt;
+			}
+
+			const auto readingDirection = layout->GetReadingDirection();
+			const auto flowDirection = layout->GetFlowDirection();
+			if ((readingDirection != DWRITE_READING_DIRECTION_LEFT_TO_RIGHT &&
+				readingDirection != DWRITE_READING_DIRECTION_RIGHT_TO_LEFT) ||
+				(flowDirection != DWRITE_FLOW_DIRECTION_TOP_TO_BOTTOM &&
+				flowDirection != DWRITE_FLOW_DIRECTION_BOTTOM_TO_TOP))
+			{
+				return std::nullopt;
+			}
+
+			const bool isRightToLeft = readingDirection == DWRITE_READING_DIRECTION_RIGHT_TO_LEFT;
+			const bool isBottomToTop = flowDirection == DWRITE_FLOW_DIRECTION_BOTTOM_TO_TOP;
+
+			PointF alignment;
+			switch (layout->GetTextAlignment())
+			{
+				case DWRITE_TEXT_ALIGNMENT_LEADING:
+					alignment.x = isRightToLeft ? 1.0F : 0.0F;
+					break;
+				case DWRITE_TEXT_ALIGNMENT_TRAILING:
+					alignment.x = isRightToLeft ? 0.0F : 1.0F;
+					break;
+				case DWRITE_TEXT_ALIGNMENT_CENTER:
+					alignment.x = 0.5F;
+					break;
+				default:
+					// Justified lines are stretched to the width
+					return std::nullopt;
+			}
+			switch (layout->GetParagraphAlignment())
+			{
+				case DWRITE_PARAGRAPH_ALIGNMENT_NEAR:
+					alignment.y = isBottomToTop ? 1.0F : 0.0F;
+					break;
+				case DWRITE_PARAGRAPH_ALIGNMENT_FAR:
+					alignment.y = isBottomToTop ? 0.0F : 1.0F;
+					break;
+				case DWRITE_PARAGRAPH_ALIGNMENT_CENTER:
+					alignment.y = 0.5F;
+					break;
+				default:
+					return std::nullopt;
+			}
+
+			return alignment;
+		}
+
+		/**
+		* @brief Whether a line ended because it was out of width rather than at a line break
+		*/
+		[[nodiscard]] auto IsWrapped(const TextLayout& textLayout) noexcept -> bool
+		{
+			if (textLayout->GetWordWrapping() == DWRITE_WORD_WRAPPING_NO_WRAP)
+			{
+				return false;
+			}
+
+			const auto lineMetrics = textLayout.GetLineMetrics();
+			return std::ranges::any_of(lineMetrics.begin(), lineMetrics.end() - (lineMetrics.empty() ? 0 : 1),
+				[](const auto& line) { return line.newlineLength == 0; });
+		}
+
+		[[nodiscard]] auto IsSameSize(SizeF left, SizeF right) noexcept -> bool
+		{
+			return std::bit_cast<std::uint32_t>(left.cx) == std::bit_cast<std::uint32_t>(right.cx) &&
+				std::bit_cast<std::uint32_t>(left.cy) == std::bit_cast<std::uint32_t>(right.cy);
+		}
+	}
+
+	auto TextLayoutCache::GetInstance() -> TextLayoutCache&
+	{
+		static TextLayoutCache instance;
+		return instance;
+	}
+
+	TextLayoutCache::TextLayoutCache(std::size_t _glyphBudget) noexcept :
+		glyphBudget{ _glyphBudget }
+	{
+	}
+
+	auto TextLayoutCache::Get(std::wstring_view text, const TextFormat& textFormat, SizeF maxSize) -> PlacedTextLayout
+	{
+		if (!textFormat)
+		{
+			return PlacedTextLayout{ TextLayout{ text, textFormat, maxSize } };
+		}
+
+		const auto key = MakeKey(text, textFormat);
+		{
+			std::scoped_lock lock{ mutex };
+
+			if (auto placed = Find(key, maxSize);
+				placed.has_value())
+			{
+				hitCount++;
+				return placed.value();
+			}
+			missCount++;
+		}
+
+		// Shaped without the lock so other threads aren't held up by it
+		auto entry = CreateEntry(text, textFormat, maxSize, key.hash);
+		PlacedTextLayout placed{ entry.textLayout };
+
+		std::scoped_lock lock{ mutex };
+
+		if (!entry.textLayout || entry.glyphCount > glyphBudget)
+		{
+			return placed;
+		}
+
+		Trim(glyphBudget - entry.glyphCount);
+
+		glyphCount += entry.glyphCount;
+		lru.push_front(std::move(entry));
+
+		const auto& stored = lru.front();
+		entries.emplace(Key{ stored.text, stored.textFormat, stored.hash }, lru.begin());
+
+		return placed;
+	}
+
+	void TextLayoutCache::Clear() noexcept
+	{
+		std::scoped_lock lock{ mutex };
+
+		entries.clear();
+		lru.clear();
+		glyphCount = 0;
+	}
+
+	auto TextLayoutCache::GetGlyphBudget() const noexcept -> std::size_t
+	{
+		std::scoped_lock lock{ mutex };
+		return glyphBudget;
+	}
+	void TextLayoutCache::SetGlyphBudget(std::size_t _glyphBudget)
+	{
+		std::scoped_lock lock{ mutex };
+
+		glyphBudget = _glyphBudget;
+		Trim(glyphBudget);
+	}
+	auto TextLayoutCache::GetGlyphCount() const noexcept -> std::size_t
+	{
+		std::scoped_lock lock{ mutex };
+		return glyphCount;
+	}
+	auto TextLayoutCache::GetCount() const noexcept -> std::size_t
+	{
+		std::scoped_lock lock{ mutex };
+		return lru.size();
+	}
+	auto TextLayoutCache::GetHitCount() const noexcept -> std::uint64_t
+	{
+		std::scoped_lock lock{ mutex };
+		return hitCount;
+	}
+	auto TextLayoutCache::GetMissCount() const noexcept -> std::uint64_t
+	{
+		std::scoped_lock lock{ mutex };
+		return missCount;
+	}
+	auto TextLayoutCache::GetEvictionCount() const noexcept -> std::uint64_t
+	{
+		std::scoped_lock lock{ mutex };
+		return evictionCount;
+	}
+
+	auto TextLayoutCache::Entry::Place(SizeF size) const noexcept -> std::optional<PlacedTextLayout>
+	{
+		if (IsSameSize(size, maxSize))
+		{
+			return PlacedTextLayout{ textLayout };
+		}
+		if (!alignment.has_value() || size.cx < minWidth || size.cx > maxWidth)
+		{
+			return std::nullopt;
+		}
+
+		return PlacedTextLayout{ textLayout, PointF{
+			alignment->x * (size.cx - maxSize.cx),
+			alignment->y * (size.cy - maxSize.cy)
+		} };
+	}
+
+	auto TextLayoutCache::MakeKey(std::wstring_view text, const TextFormat& textFormat) noexcept -> Key
+	{
+		IDWriteTextFormat3* format = textFormat;
+
+		auto hash = HashBytes(std::as_bytes(std::span{ text }));
+		hash = HashValue(format, hash);
+
+		return Key{ text, format, static_cast<std::size_t>(hash) };
+	}
+
+	auto TextLayoutCache::CreateEntry(std::wstring_view text,
+		const TextFormat& textFormat, SizeF maxSize, std::size_t hash) -> Entry
+	{
+		Entry entry{
+			.text = std::wstring{ text },
+			.textFormat = textFormat,
+			.textLayout = TextLayout{ text, textFormat, maxSize },
+			.maxSize = maxSize,
+			.alignment = std::nullopt,
+			.minWidth = 0.0F,
+			.maxWidth = 0.0F,
+			.glyphCount = 0,
+			.hash = hash
+		};
+		if (!entry.textLayout)
+		{
+			return entry;
+		}
+
+		// Empty text still takes a slot
+		entry.glyphCount = std::max<std::size_t>(entry.textLayout.GetClusterCount(), 1);
+
+		entry.alignment = GetAlignment(entry.textLayout);
+		if (entry.alignment.has_value())
+		{
+			// Narrower than the widest line breaks it, wider lets wrapped lines take in more words
+			entry.minWidth = entry.textLayout.GetMetrics().widthIncludingTrailingWhitespace;
+			entry.maxWidth = IsWrapped(entry.textLayout) ?
+				maxSize.cx : std::numeric_limits<float>::infinity();
+		}
+
+		return entry;
+	}
+
+	auto TextLayoutCache::Find(const Key& key, SizeF maxSize) -> std::optional<PlacedTextLayout>
+	{
+		auto [first, last] = entries.equal_range(key);
+		for (auto iter = first; iter != last; ++iter)
+		{
+			if (auto placed = iter->second->Place(maxSize);
+				placed.has_value())
+			{
+				lru.splice(lru.begin(), lru, iter->second);
+				return placed;
+			}
+		}
+
+		return std::nullopt;
+	}
+
+	void TextLayoutCache::Trim(std::size_t count) noexcept
+	{
+		while (glyphCount > count && !lru.empty())
+		{
+			const auto oldest = std::prev(lru.end());
+
+			auto [first, last] = entries.equal_range(Key{ oldest->text, oldest->textFormat, oldest->hash });
+			const auto iter = std::ranges::find_if(first, last,
+				[&oldest](const auto& pair) { return pair.second == oldest; });
+			if (iter != last)
+			{
+				entries.erase(iter);
+			}
+
+			glyphCount -= oldest->glyphCount;
+			lru.erase(oldest);
+			evictionCount++;
+		}
+	}
+}
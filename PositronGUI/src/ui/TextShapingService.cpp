@@ -0,0 +1,60 @@
+#include "ui/TextShapingService.hpp"
+
+#include "core/Dispatcher.hpp"
+#include "core/Exceptions.hpp"
+
+#include <new>
+
+
+namespace PGUI::UI
+{
+	auto TextShapingService::GetInstance() -> TextShapingService&
+	{
+		static TextShapingService instance;
+		return instance;
+	}
+
+	TextShapingService::TextShapingService(std::size_t workerCount) :
+		scheduler{ &TextShapingService::ShapeText, workerCount }
+	{
+	}
+
+	auto TextShapingService::ShapeText(const TextShapingRequest& request) -> ShapedText
+	{
+		ShapedText shaped;
+
+		try
+		{
+			shaped.layout = TextLayoutCache::GetInstance().Get(request.text, request.textFormat, request.maxSize);
+
+			const auto& textLayout = shaped.layout.textLayout;
+			if (!textLayout)
+			{
+				shaped.hr = E_FAIL;
+				return shaped;
+			}
+
+			shaped.metrics = textLayout.GetMetrics();
+			shaped.lineMetrics = textLayout.GetLineMetrics();
+			shaped.clusterMetrics = textLayout.GetClusterMetrics();
+			shaped.hr = S_OK;
+		}
+		catch (const Core::PGUIException& exception)
+		{
+			shaped.hr = exception.GetErrorCode();
+		}
+		catch (const std::bad_alloc&)
+		{
+			shaped.hr = E_OUTOFMEMORY;
+		}
+
+		return shaped;
+	}
+
+	void TextShapingService::Submit(std::vector<TextShapingRequest> requests, std::stop_token stopToken,
+		Callback callback, bool invokeWhenCancelled)
+	{
+		scheduler.Submit(std::move(requests), std::move(stopToken),
+			Core::Dispatcher::GetForCurrentThread().GetQueue(), std::move(callback), invokeWhenCancelled);
+	}
+}
@@ -0,0 +1,186 @@
+#include "ui/TextViewport.hpp"
+
+#include "helpers/HelperFunctions.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <ranges>
+
+
+namespace PGUI::UI
+{
+	TextViewport::TextViewport(const TextBuffer& _document) noexcept :
+		document{ &_document }
+	{
+	}
+
+	void TextViewport::SetTextFormat(const TextFormat& _textFormat)
+	{
+		textFormat = _textFormat;
+		realizedLines.clear();
+
+		lineHeight = 0.0F;
+		if (!textFormat)
+		{
+			return;
+		}
+
+		constexpr auto maxFloat = std::numeric_limits<float>::max();
+		if (const TextLayout sample{ L"M", textFormat, SizeF{ maxFloat, maxFloat } };
+			sample)
+		{
+			lineHeight = sample.GetMetrics().height;
+		}
+	}
+
+	auto TextViewport::GetContentHeight() const noexcept -> double
+	{
+		return static_cast<double>(document->GetLineCount()) * lineHeight;
+	}
+
+	auto TextViewport::GetLineFromY(double y) const noexcept -> std::size_t
+	{
+		if (lineHeight <= 0.0F || y <= 0.0)
+		{
+			return 0;
+		}
+
+		const auto lastLine = document->GetLineCount() - 1;
+		const auto line = y / lineHeight;
+
+		return line >= static_cast<double>(lastLine) ? lastLine : static_cast<std::size_t>(line);
+	}
+
+	void TextViewport::Layout(PointL _scroll, SizeF viewSize)
+	{
+		const auto layoutStart = Clock::now();
+
+		scroll = _scroll;
+		realizedLines.clear();
+		frameStats = TextViewportFrameStats{ };
+
+		if (!textFormat || lineHeight <= 0.0F)
+		{
+			frameStats.layoutTime = Clock::now() - layoutStart;
+			return;
+		}
+
+		const auto lineCount = document->GetLineCount();
+		const auto firstVisible = GetLineFromY(scroll.y);
+		const auto lastVisible = std::min(GetLineFromY(static_cast<double>(scroll.y) + viewSize.cy) + 1, lineCount);
+
+		firstRealizedLine = firstVisible - std::min(firstVisible, overscan);
+		const auto lastRealized = std::min(lastVisible + overscan, lineCount);
+
+		auto& layoutCache = TextLayoutCache::GetInstance();
+		const auto missCount = layoutCache.GetMissCount();
+
+		// Lines only wrap if the format does, the view's width keeps layouts reusable across scrolls
+		const SizeF maxSize{ std::max(viewSize.cx, lineHeight), lineHeight };
+
+		auto lineStart = document->GetLineStart(firstRealizedLine);
+		for (auto line = firstRealizedLine; line < lastRealized; line++)
+		{
+			const auto nextLineStart = document->GetLineStart(line + 1);
+			const auto lineLength = line + 1 < lineCount ? nextLineStart - lineStart - 1 : nextLineStart - lineStart;
+
+			const auto text = document->GetText(lineStart, lineLength);
+			realizedLines.push_back(RealizedLine{ lineStart, lineLength, layoutCache.Get(text, textFormat, maxSize) });
+
+			lineStart = nextLineStart;
+		}
+
+		frameStats.firstVisibleLine = firstVisible;
+		frameStats.visibleLineCount = lastVisible - firstVisible;
+		frameStats.realizedLineCount = realizedLines.size();
+		frameStats.shapedLineCount = static_cast<std::size_t>(layoutCache.GetMissCount() - missCount);
+		frameStats.layoutTime = Clock::now() - layoutStart;
+	}
+
+	void TextViewport::Draw(Graphics::Graphics g, PointF origin, const Brush& textBrush)
+	{
+		const auto drawStart = Clock::now();
+
+		for (std::size_t i = 0; i < realizedLines.size(); i++)
+		{
+			const auto line = firstRealizedLine + i;
+			if (!IsVisible(line))
+			{
+				continue;
+			}
+
+			const auto& [start, length, layout] = realizedLines[i];
+			const auto lineOrigin = GetLineOrigin(line, origin);
+
+			g.DrawTextLayout(PointF{ lineOrigin.x + layout.offset.x, lineOrigin.y + layout.offset.y },
+				layout.textLayout, textBrush);
+		}
+
+		frameStats.drawTime = Clock::now() - drawStart;
+	}
+
+	void TextViewport::DrawSelection(Graphics::Graphics g, PointF origin,
+		std::size_t first, std::size_t last, const Brush& selectionBrush) const
+	{
+		std::vector<DWRITE_HIT_TEST_METRICS> hitTestMetrics;
+
+		for (std::size_t i = 0; i < realizedLines.size(); i++)
+		{
+			const auto line = firstRealizedLine + i;
+			const auto& [start, length, layout] = realizedLines[i];
+
+			const auto selectionStart = std::max(first, start);
+			const auto selectionEnd = std::min(last, start + length);
+			if (!IsVisible(line) || selectionStart >= selectionEnd || !layout.textLayout)
+			{
+				continue;
+			}
+
+			const auto position = static_cast<UINT32>(selectionStart - start);
+			const auto selectionLength = static_cast<UINT32>(selectionEnd - selectionStart);
+
+			UINT32 metricsCount = 0;
+			HRESULT hr = layout.textLayout->HitTestTextRange(
+				position, selectionLength, 0.0F, 0.0F, nullptr, 0, &metricsCount);
+			if (hr != E_NOT_SUFFICIENT_BUFFER)
+			{
+				HR_L(hr);
+				continue;
+			}
+
+			hitTestMetrics.resize(metricsCount);
+			hr = layout.textLayout->HitTestTextRange(position, selectionLength, 0.0F, 0.0F,
+				hitTestMetrics.data(), metricsCount, &metricsCount); HR_L(hr);
+			if (FAILED(hr))
+			{
+				continue;
+			}
+
+			const auto lineOrigin = GetLineOrigin(line, origin);
+			for (const auto& metrics : hitTestMetrics | std::views::take(metricsCount))
+			{
+				const auto left = lineOrigin.x + layout.offset.x + metrics.left;
+				const auto top = lineOrigin.y + layout.offset.y + metrics.top;
+
+				g.FillRect(RectF{ left, top, left + metrics.width, top + metrics.height }, selectionBrush);
+			}
+		}
+	}
+
+	auto TextViewport::GetLineOrigin(std::size_t line, PointF origin) const noexcept -> PointF
+	{
+		// Relative to the scroll position first, so it's small enough for a float again
+		const auto top = static_cast<double>(line) * lineHeight - static_cast<double>(scroll.y);
+
+		return PointF{
+			origin.x - static_cast<float>(scroll.x),
+			origin.y + static_cast<float>(top)
+		};
+	}
+
+	auto TextViewport::IsVisible(std::size_t line) const noexcept -> bool
+	{
+		return line >= frameStats.firstVisibleLine &&
+			line < frameStats.firstVisibleLine + frameStats.visibleLineCount;
+	}
+}
@@ -6,66 +6,171 @@
 #include <windows.foundation.h>
 #include <wrl/wrappers/corewrappers.h>
 #include <objbase.h>
+#include <bit>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
 
 
 namespace PGUI::UI
 {
 	using enum winrt::Windows::UI::ViewManagement::UIColorType;
 
+	namespace
+	{
+		[[nodiscard]] auto ReadIsLightMode() noexcept -> bool
+		{
+			DWORD value = 1;
+			DWORD size = sizeof(value);
+
+			if (LSTATUS status = RegGetValueW(HKEY_CURRENT_USER, 
+				LR"(Software\Microsoft\Windows\CurrentVersion\Themes\Personalize)",
+				L"AppsUseLightTheme", RRF_RT_DWORD, nullptr, &value, &size);
+				status != ERROR_SUCCESS)
+			{
+				HR_L(HRESULT_FROM_WIN32(status));
+			}
+
+			return static_cast<bool>(value);
+		}
+
+		[[nodiscard]] auto ReadTheme() noexcept -> ThemeColors
+		{
+			const auto& uiSettings = UIColors::GetInstance();
+
+			return ThemeColors{
+				.foreground = uiSettings.GetColorValue(Foreground),
+				.background = uiSettings.GetColorValue(Background),
+				.accent = uiSettings.GetColorValue(Accent),
+				.accentDark1 = uiSettings.GetColorValue(AccentDark1),
+				.accentDark2 = uiSettings.GetColorValue(AccentDark2),
+				.accentDark3 = uiSettings.GetColorValue(AccentDark3),
+				.accentLight1 = uiSettings.GetColorValue(AccentLight1),
+				.accentLight2 = uiSettings.GetColorValue(AccentLight2),
+				.accentLight3 = uiSettings.GetColorValue(AccentLight3),
+				.isDarkMode = !ReadIsLightMode()
+			};
+		}
+
+		struct ThemeState
+		{
+			std::shared_mutex mutex;
+			ThemeColors colors = ReadTheme();
+			Core::Event<> themeChangedEvent;
+			winrt::Windows::UI::ViewManagement::UISettings::ColorValuesChanged_revoker colorValuesChangedRevoker;
+
+			ThemeState()
+			{
+				// Comes from a thread pool thread
+				colorValuesChangedRevoker = UIColors::GetInstance().ColorValuesChanged(winrt::auto_revoke,
+					[](const auto& /*unused*/, const auto& /*unused*/)
+				{
+					UIColors::Refresh();
+				});
+			}
+		};
+
+		[[nodiscard]] auto GetThemeState() -> ThemeState&
+		{
+			static ThemeState state;
+			return state;
+		}
+
+		template <typename T>
+		[[nodiscard]] auto ReadThemeMember(T ThemeColors::* member) noexcept -> T
+		{
+			auto& state = GetThemeState();
+			std::shared_lock lock{ state.mutex };
+
+			return state.colors.*member;
+		}
+	}
+
 	auto UIColors::GetForegroundColor() noexcept -> RGBA
 	{
-		return uiSettings.GetColorValue(Foreground);
+		return ReadThemeMember(&ThemeColors::foreground);
 	}
 	auto UIColors::GetBackgroundColor() noexcept -> RGBA
 	{
-		return uiSettings.GetColorValue(Background);
+		return ReadThemeMember(&ThemeColors::background);
 	}
 	auto UIColors::GetAccentColor() noexcept -> RGBA
 	{	
-		return uiSettings.GetColorValue(Accent);
+		return ReadThemeMember(&ThemeColors::accent);
 	}
 	auto UIColors::GetAccentDark1Color() noexcept -> RGBA
 	{	
-		return uiSettings.GetColorValue(AccentDark1);
+		return ReadThemeMember(&ThemeColors::accentDark1);
 	}
 	auto UIColors::GetAccentDark2Color() noexcept -> RGBA
 	{	
-		return uiSettings.GetColorValue(AccentDark2);
+		return ReadThemeMember(&ThemeColors::accentDark2);
 	}
 	auto UIColors::GetAccentDark3Color() noexcept -> RGBA
 	{
-		return uiSettings.GetColorValue(AccentDark3);
+		return ReadThemeMember(&ThemeColors::accentDark3);
 	}
 	auto UIColors::GetAccentLight1Color() noexcept -> RGBA
 	{
-		return uiSettings.GetColorValue(AccentLight1);
+		return ReadThemeMember(&ThemeColors::accentLight1);
 	}
 	auto UIColors::GetAccentLight2Color() noexcept -> RGBA
 	{
-		return uiSettings.GetColorValue(AccentLight2);
+		return ReadThemeMember(&ThemeColors::accentLight2);
 	}
 	auto UIColors::GetAccentLight3Color() noexcept -> RGBA
 	{
-		return uiSettings.GetColorValue(AccentLight3);
+		return ReadThemeMember(&ThemeColors::accentLight3);
 	}
 
 	auto UIColors::IsDarkMode() noexcept -> bool
 	{
-		return !IsLightMode();
+		return ReadThemeMember(&ThemeColors::isDarkMode);
 	}
 	auto UIColors::IsLightMode() noexcept -> bool
 	{
-		DWORD value = 1;
-		DWORD size = sizeof(value);
+		return !IsDarkMode();
+	}
+
+	auto UIColors::GetTheme() noexcept -> ThemeColors
+	{
+		auto& state = GetThemeState();
+		std::shared_lock lock{ state.mutex };
+
+		return state.colors;
+	}
+
+	auto UIColors::Refresh() -> bool
+	{
+		auto& state = GetThemeState();
+		{
+			// Read under the lock so a stale read can't overwrite a newer one
+			std::scoped_lock lock{ state.mutex };
 
-		if (LSTATUS status = RegGetValueW(HKEY_CURRENT_USER, 
-			LR"(Software\Microsoft\Windows\CurrentVersion\Themes\Personalize)",
-			L"AppsUseLightTheme", RRF_RT_DWORD, nullptr, &value, &size);
-			status != ERROR_SUCCESS)
+			auto colors = ReadTheme();
+			if (colors == state.colors)
+			{
+				return false;
+			}
+			state.colors = colors;
+		}
+
+		state.themeChangedEvent.Emit();
+		return true;
+	}
+
+	void UIColors::OnSettingChange(LPARAM lParam)
+	{
+		// Switching between light and dark mode is reported as ImmersiveColorSet
+		if (const auto* area = std::bit_cast<const wchar_t*>(lParam);
+			area != nullptr && std::wstring_view{ area } == L"ImmersiveColorSet")
 		{
-			HR_L(HRESULT_FROM_WIN32(status));
+			Refresh();
 		}
+	}
 
-		return static_cast<bool>(value);
+	auto UIColors::ThemeChangedEvent() noexcept -> Core::Event<>&
+	{
+		return GetThemeState().themeChangedEvent;
 	}
 }
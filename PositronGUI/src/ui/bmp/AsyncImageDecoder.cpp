@@ -0,0 +1,324 @@
+#include "ui/bmp/AsyncImageDecoder.hpp"
+
+#include "core/Dispatcher.hpp"
+#include "core/Exceptions.hpp"
+#include "helpers/ComPtr.hpp"
+#include "helpers/HelperFunctions.hpp"
+#include "helpers/MappedFile.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <new>
+
+
+namespace PGUI::UI::Bmp
+{
+	namespace
+	{
+		constexpr HRESULT CancelledHresult = HRESULT_FROM_WIN32(ERROR_CANCELLED);
+
+		// WIC objects belong to the apartment that created them, so every worker gets its own factory
+		thread_local ComPtr<IWICImagingFactory> workerFactory;
+
+		auto GetBitsPerPixel(IWICImagingFactory* factory, const WICPixelFormatGUID& format) -> UINT
+		{
+			ComPtr<IWICComponentInfo> componentInfo;
+			HRESULT hr = factory->CreateComponentInfo(format, &componentInfo); HR_T(hr);
+
+			ComPtr<IWICPixelFormatInfo> pixelFormatInfo;
+			hr = componentInfo.As(&pixelFormatInfo); HR_T(hr);
+
+			UINT bitsPerPixel = 0;
+			hr = pixelFormatInfo->GetBitsPerPixel(&bitsPerPixel); HR_T(hr);
+
+			return bitsPerPixel;
+		}
+
+		/*
+		* Asks the codec for the smallest size it can decode to directly that still isn't below targetSize
+		* For JPEG that's a power of two reduction that skips most of the IDCT work
+		*/
+		auto TryScaleDuringDecode(IWICImagingFactory* factory, const ComPtr<IWICBitmapFrameDecode>& frame,
+			SizeU originalSize, SizeU targetSize) -> ComPtr<IWICBitmapSource>
+		{
+			ComPtr<IWICBitmapSourceTransform> transform;
+			if (FAILED(frame.As(&transform)))
+			{
+				return nullptr;
+			}
+
+			UINT width = targetSize.cx;
+			UINT height = targetSize.cy;
+			if (FAILED(transform->GetClosestSize(&width, &height)) ||
+				width < targetSize.cx || height < targetSize.cy ||
+				(width >= originalSize.cx && height >= originalSize.cy))
+			{
+				return nullptr;
+			}
+
+			WICPixelFormatGUID format = GUID_WICPixelFormat32bppBGRA;
+			HRESULT hr = transform->GetClosestPixelFormat(&format); HR_T(hr);
+
+			const auto stride = (width * GetBitsPerPixel(factory, format) + 7) / 8;
+			std::vector<BYTE> buffer(static_cast<std::size_t>(stride) * height);
+
+			hr = transform->CopyPixels(nullptr, width, height, &format, WICBitmapTransformRotate0,
+				stride, static_cast<UINT>(buffer.size()), buffer.data()); HR_T(hr);
+
+			ComPtr<IWICBitmap> bitmap;
+			hr = factory->CreateBitmapFromMemory(width, height, format, stride,
+				static_cast<UINT>(buffer.size()), buffer.data(), &bitmap); HR_T(hr);
+
+			return bitmap;
+		}
+
+		void OpenAnimation(const std::wstring& filePath, DecodedImage& image)
+		{
+			const MappedFile file{ filePath };
+			const auto data = file.GetData();
+
+			try
+			{
+				image.gifDecoder = std::make_shared<const GifDecoder>(std::vector<std::byte>{ data.begin(), data.end() });
+			}
+			catch (const GifFormatException&)
+			{
+				// Other animated formats and GIFs the native decoder rejects are opened by WIC from these bytes
+				image.encodedFile.assign(data.begin(), data.end());
+			}
+		}
+
+		void OpenTiled(IWICImagingFactory* factory, const std::wstring& filePath, DecodedImage& image) noexcept
+		{
+			try
+			{
+				image.tiledImage = std::make_shared<TiledImage>(factory, filePath);
+			}
+			catch (const Core::PGUIException& exception)
+			{
+				// Still viewable, just not past the decoded size
+				HR_L(exception.GetErrorCode());
+			}
+			catch (const std::bad_alloc&)
+			{
+				HR_L(E_OUTOFMEMORY);
+			}
+		}
+	}
+
+	auto AsyncImageDecoder::GetInstance() -> AsyncImageDecoder&
+	{
+		static AsyncImageDecoder instance;
+		return instance;
+	}
+
+	AsyncImageDecoder::AsyncImageDecoder(std::size_t workerCount) :
+		workers{ workerCount, []
+		{
+			HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED); HR_L(hr);
+			hr = CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER,
+				__uuidof(IWICImagingFactory), std::bit_cast<void**>(workerFactory.GetAddressOf())); HR_L(hr);
+		}, []
+		{
+			workerFactory.Reset();
+			CoUninitialize();
+		} }
+	{
+	}
+	AsyncImageDecoder::~AsyncImageDecoder() noexcept = default;
+
+	auto AsyncImageDecoder::FitSize(SizeU size, std::optional<SizeU> targetSize) noexcept -> SizeU
+	{
+		if (!targetSize.has_value() ||
+			targetSize->cx == 0 || targetSize->cy == 0 ||
+			(size.cx <= targetSize->cx && size.cy <= targetSize->cy))
+		{
+			return size;
+		}
+
+		const auto scale = std::min(
+			static_cast<double>(targetSize->cx) / static_cast<double>(size.cx),
+			static_cast<double>(targetSize->cy) / static_cast<double>(size.cy));
+
+		return SizeU{
+			std::max(static_cast<UINT32>(std::lround(size.cx * scale)), UINT32{ 1 }),
+			std::max(static_cast<UINT32>(std::lround(size.cy * scale)), UINT32{ 1 }) };
+	}
+
+	auto AsyncImageDecoder::DecodeImage(IWICImagingFactory* factory,
+		const DecodeRequest& request, const std::stop_token& stopToken) -> DecodeResult
+	{
+		DecodeResult result;
+		auto& image = result.image;
+
+		try
+		{
+			ComPtr<IWICBitmapDecoder> decoder;
+			HRESULT hr = factory->CreateDecoderFromFilename(request.filePath.c_str(), nullptr,
+				GENERIC_READ, WICDecodeMetadataCacheOnDemand, &decoder); HR_T(hr);
+
+			hr = decoder->GetFrameCount(&image.frameCount); HR_T(hr);
+
+			ComPtr<IWICBitmapFrameDecode> frame;
+			hr = decoder->GetFrame(request.frameIndex, &frame); HR_T(hr);
+
+			hr = frame->GetSize(&image.originalSize.cx, &image.originalSize.cy); HR_T(hr);
+			image.size = FitSize(image.originalSize, request.targetSize);
+
+			if (stopToken.stop_requested())
+			{
+				result.hr = CancelledHresult;
+				return result;
+			}
+
+			ComPtr<IWICBitmapSource> source = frame;
+			SizeU sourceSize = image.originalSize;
+			if (image.size != image.originalSize)
+			{
+				if (auto scaledDuringDecode = TryScaleDuringDecode(factory, frame, image.originalSize, image.size))
+				{
+					source = scaledDuringDecode;
+					hr = source->GetSize(&sourceSize.cx, &sourceSize.cy); HR_T(hr);
+				}
+			}
+
+			if (sourceSize != image.size)
+			{
+				ComPtr<IWICBitmapScaler> scaler;
+				hr = factory->CreateBitmapScaler(&scaler); HR_T(hr);
+				hr = scaler->Initialize(source.Get(), image.size.cx, image.size.cy,
+					WICBitmapInterpolationModeHighQualityCubic); HR_T(hr);
+				source = scaler;
+			}
+
+			ComPtr<IWICFormatConverter> converter;
+			hr = factory->CreateFormatConverter(&converter); HR_T(hr);
+			hr = converter->Initialize(source.Get(), GUID_WICPixelFormat32bppPBGRA,
+				WICBitmapDitherTypeNone, nullptr, 0.0, WICBitmapPaletteTypeCustom); HR_T(hr);
+
+			if (stopToken.stop_requested())
+			{
+				result.hr = CancelledHresult;
+				return result;
+			}
+
+			image.stride = image.size.cx * 4;
+			image.pixels.resize(static_cast<std::size_t>(image.stride) * image.size.cy);
+			hr = converter->CopyPixels(nullptr, image.stride,
+				static_cast<UINT>(image.pixels.size()), image.pixels.data()); HR_T(hr);
+
+			if (request.openAnimation && image.frameCount > 1)
+			{
+				OpenAnimation(request.filePath, image);
+			}
+			else if (request.openTiled && image.frameCount == 1)
+			{
+				OpenTiled(factory, request.filePath, image);
+			}
+
+			result.hr = S_OK;
+		}
+		catch (const Core::PGUIException& exception)
+		{
+			result.hr = exception.GetErrorCode();
+		}
+		catch (const std::bad_alloc&)
+		{
+			result.hr = E_OUTOFMEMORY;
+		}
+
+		if (FAILED(result.hr))
+		{
+			image.pixels = { };
+		}
+		return result;
+	}
+
+	void AsyncImageDecoder::Run(Work work)
+	{
+		workers.Submit([work = std::move(work)]() mutable
+		{
+			work(workerFactory.Get());
+		});
+	}
+
+	void AsyncImageDecoder::Submit(DecodeRequest request, std::stop_token stopToken,
+		Callback callback, bool invokeWhenCancelled)
+	{
+		auto job = std::make_unique<Job>(Job{
+			std::move(request), std::move(stopToken), std::move(callback),
+			Core::Dispatcher::GetForCurrentThread().GetQueue(), invokeWhenCancelled, DecodeResult{ } });
+
+		workers.Submit([this, job = std::move(job)]() mutable
+		{
+			if (job->stopToken.stop_requested())
+			{
+				job->result.hr = CancelledHresult;
+			}
+			else if (!workerFactory)
+			{
+				job->result.hr = CO_E_NOTINITIALIZED;
+			}
+			else
+			{
+				job->result = DecodeImage(workerFactory.Get(), job->request, job->stopToken);
+			}
+
+			Complete(std::move(job));
+		});
+	}
+
+	void AsyncImageDecoder::Complete(std::unique_ptr<Job> job)
+	{
+		auto queue = job->queue;
+
+		bool isFirstInBatch = false;
+		{
+			std::scoped_lock lock{ completedMutex };
+
+			auto& batch = completed[queue.get()];
+			isFirstInBatch = batch.empty();
+			batch.push_back(std::move(job));
+		}
+
+		// Jobs finishing before the UI thread gets to Deliver join the same batch
+		if (isFirstInBatch)
+		{
+			queue->Post([this, queuePtr = queue.get()]
+			{
+				Deliver(queuePtr);
+			}, Core::DispatcherPriority::Render);
+		}
+	}
+
+	void AsyncImageDecoder::Deliver(Core::DispatcherQueue* queue)
+	{
+		std::vector<std::unique_ptr<Job>> batch;
+		{
+			std::scoped_lock lock{ completedMutex };
+
+			auto iter = completed.find(queue);
+			if (iter == completed.end())
+			{
+				return;
+			}
+			batch = std::move(iter->second);
+			completed.erase(iter);
+		}
+
+		for (const auto& job : batch)
+		{
+			if (job->stopToken.stop_requested())
+			{
+				if (!job->invokeWhenCancelled)
+				{
+					continue;
+				}
+				job->result = DecodeResult{ CancelledHresult, { } };
+			}
+
+			job->callback(job->result);
+		}
+	}
+}
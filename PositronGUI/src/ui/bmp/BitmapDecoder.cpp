@@ -38,8 +38,7 @@ namespace PGUI::UI::Bmp
 			fileHandle, vendor, WICDecodeMetadataCacheOnDemand, GetHeldPtrAddress()); HR_L(hr);
 	}
 
-	/*
-	Image::Image(ComPtr<IStream> stream, std::optional<GUID> vendorGUID) noexcept
+	BitmapDecoder::BitmapDecoder(const ComPtr<IStream>& stream, std::optional<GUID> vendorGUID)
 	{
 		auto wicFactory = PGUI::WICFactory::GetFactory();
 
@@ -50,9 +49,8 @@ namespace PGUI::UI::Bmp
 		}
 
 		HRESULT hr = wicFactory->CreateDecoderFromStream(
-			stream.Get(), vendor, WICDecodeMetadataCacheOnDemand, GetHeldComPtrAddress()); HR_L(hr);
+			stream.Get(), vendor, WICDecodeMetadataCacheOnDemand, GetHeldPtrAddress()); HR_L(hr);
 	}
-	*/
 
 	BitmapDecoder::BitmapDecoder() noexcept : 
 		ComPtrHolder{ nullptr }
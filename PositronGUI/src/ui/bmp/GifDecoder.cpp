@@ -0,0 +1,730 @@
+#include "ui/bmp/GifDecoder.hpp"
+
+#include "helpers/CpuFeatures.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string_view>
+
+#if PGUI_X86
+#include <immintrin.h>
+#endif
+
+
+namespace PGUI::UI::Bmp
+{
+	namespace
+	{
+		constexpr std::size_t MaxLzwCodes = 4096;
+		constexpr std::uint32_t MaxLzwCodeSize = 12;
+
+		constexpr std::byte ExtensionIntroducer{ 0x21 };
+		constexpr std::byte ImageSeparator{ 0x2C };
+		constexpr std::byte Trailer{ 0x3B };
+		constexpr std::byte GraphicControlLabel{ 0xF9 };
+		constexpr std::byte ApplicationLabel{ 0xFF };
+
+		constexpr std::uint32_t OpaqueBlack = 0xFF000000;
+		// 8192 x 8192, anything bigger is more likely a corrupt header than an animation
+		constexpr std::uint64_t MaxPixelCount = 1ULL << 26;
+
+		class ByteReader
+		{
+			public:
+			explicit ByteReader(std::span<const std::byte> data) noexcept :
+				data{ data }
+			{
+			}
+
+			[[nodiscard]] auto GetPosition() const noexcept { return position; }
+			[[nodiscard]] auto GetRemaining() const noexcept { return data.size() - position; }
+
+			[[nodiscard]] auto ReadByte() -> std::uint8_t
+			{
+				Require(1);
+				return std::to_integer<std::uint8_t>(data[position++]);
+			}
+			[[nodiscard]] auto ReadUInt16() -> std::uint16_t
+			{
+				Require(2);
+				const auto low = std::to_integer<std::uint16_t>(data[position]);
+				const auto high = std::to_integer<std::uint16_t>(data[position + 1]);
+				position += 2;
+				return static_cast<std::uint16_t>(low | (high << 8));
+			}
+			[[nodiscard]] auto ReadBytes(std::size_t count) -> std::span<const std::byte>
+			{
+				Require(count);
+				auto bytes = data.subspan(position, count);
+				position += count;
+				return bytes;
+			}
+			void SkipSubBlocks()
+			{
+				while (true)
+				{
+					const auto blockSize = ReadByte();
+					if (blockSize == 0)
+					{
+						return;
+					}
+					(void)ReadBytes(blockSize);
+				}
+			}
+
+			private:
+			std::span<const std::byte> data;
+			std::size_t position = 0;
+
+			void Require(std::size_t count) const
+			{
+				if (GetRemaining() < count)
+				{
+					throw GifFormatException{ "Unexpected end of GIF data" };
+				}
+			}
+		};
+
+		auto ReadPalette(ByteReader& reader, std::uint8_t sizeBits) -> GifPalette
+		{
+			const std::size_t colorCount = std::size_t{ 2 } << sizeBits;
+			const auto colors = reader.ReadBytes(colorCount * 3);
+
+			GifPalette palette;
+			palette.fill(OpaqueBlack);
+			for (std::size_t i = 0; i < colorCount; i++)
+			{
+				const auto red = std::to_integer<std::uint32_t>(colors[i * 3]);
+				const auto green = std::to_integer<std::uint32_t>(colors[i * 3 + 1]);
+				const auto blue = std::to_integer<std::uint32_t>(colors[i * 3 + 2]);
+				palette[i] = OpaqueBlack | (red << 16) | (green << 8) | blue;
+			}
+			return palette;
+		}
+
+		/*
+		* Interlaced frames store every 8th row starting at 0, then every 8th from 4,
+		* every 4th from 2 and finally every 2nd from 1
+		*/
+		auto InterlacedRowToDisplayRow(std::size_t row, std::size_t height) noexcept -> std::size_t
+		{
+			const auto pass1 = (height + 7) / 8;
+			if (row < pass1)
+			{
+				return row * 8;
+			}
+			row -= pass1;
+
+			const auto pass2 = (height + 3) / 8;
+			if (row < pass2)
+			{
+				return 4 + row * 8;
+			}
+			row -= pass2;
+
+			const auto pass3 = (height + 1) / 4;
+			if (row < pass3)
+			{
+				return 2 + row * 4;
+			}
+			row -= pass3;
+
+			return 1 + row * 2;
+		}
+
+		using ExpandFunction = void(*)(std::span<const std::uint8_t>, const GifPalette&,
+			std::optional<std::uint8_t>, std::uint32_t*) noexcept;
+
+		auto SelectExpandFunction() noexcept -> ExpandFunction
+		{
+			if (CpuFeatures::Get().avx2)
+			{
+				return &gif_detail::ExpandPaletteIndicesAvx2;
+			}
+			return &gif_detail::ExpandPaletteIndicesScalar;
+		}
+	}
+
+	#pragma region PaletteExpansion
+
+	void ExpandPaletteIndices(std::span<const std::uint8_t> indices, const GifPalette& palette,
+		std::optional<std::uint8_t> transparentIndex, std::uint32_t* destination) noexcept
+	{
+		static const auto expand = SelectExpandFunction();
+		expand(indices, palette, transparentIndex, destination);
+	}
+
+	namespace gif_detail
+	{
+		void ExpandPaletteIndicesScalar(std::span<const std::uint8_t> indices, const GifPalette& palette,
+			std::optional<std::uint8_t> transparentIndex, std::uint32_t* destination) noexcept
+		{
+			if (!transparentIndex.has_value())
+			{
+				for (std::size_t i = 0; i < indices.size(); i++)
+				{
+					destination[i] = palette[indices[i]];
+				}
+				return;
+			}
+
+			const auto transparent = *transparentIndex;
+			for (std::size_t i = 0; i < indices.size(); i++)
+			{
+				if (indices[i] != transparent)
+				{
+					destination[i] = palette[indices[i]];
+				}
+			}
+		}
+
+#if PGUI_X86
+		PGUI_TARGET_AVX2 void ExpandPaletteIndicesAvx2(std::span<const std::uint8_t> indices, const GifPalette& palette,
+			std::optional<std::uint8_t> transparentIndex, std::uint32_t* destination) noexcept
+		{
+			const auto* table = std::bit_cast<const int*>(palette.data());
+			const auto count = indices.size();
+			std::size_t i = 0;
+
+			if (!transparentIndex.has_value())
+			{
+				for (; i + 8 <= count; i += 8)
+				{
+					const auto packed = _mm_loadl_epi64(std::bit_cast<const __m128i*>(indices.data() + i));
+					const auto colors = _mm256_i32gather_epi32(table, _mm256_cvtepu8_epi32(packed), 4);
+					_mm256_storeu_si256(std::bit_cast<__m256i*>(destination + i), colors);
+				}
+			}
+			else
+			{
+				const auto transparent = _mm256_set1_epi32(*transparentIndex);
+				for (; i + 8 <= count; i += 8)
+				{
+					const auto packed = _mm_loadl_epi64(std::bit_cast<const __m128i*>(indices.data() + i));
+					const auto offsets = _mm256_cvtepu8_epi32(packed);
+					const auto colors = _mm256_i32gather_epi32(table, offsets, 4);
+
+					auto* target = std::bit_cast<__m256i*>(destination + i);
+					const auto keep = _mm256_cmpeq_epi32(offsets, transparent);
+					_mm256_storeu_si256(target, _mm256_blendv_epi8(colors, _mm256_loadu_si256(target), keep));
+				}
+			}
+
+			ExpandPaletteIndicesScalar(indices.subspan(i), palette, transparentIndex, destination + i);
+		}
+#else
+		void ExpandPaletteIndicesAvx2(std::span<const std::uint8_t> indices, const GifPalette& palette,
+			std::optional<std::uint8_t> transparentIndex, std::uint32_t* destination) noexcept
+		{
+			ExpandPaletteIndicesScalar(indices, palette, transparentIndex, destination);
+		}
+#endif
+
+		auto DecodeLzw(std::span<const std::byte> subBlocks, std::uint8_t minCodeSize,
+			std::span<std::uint8_t> output) -> std::size_t
+		{
+			if (minCodeSize < 1 || minCodeSize > 8)
+			{
+				throw GifFormatException{ "Invalid LZW minimum code size" };
+			}
+
+			// Each code is its prefix code plus one byte, strings are written back to front straight into output
+			std::array<std::uint16_t, MaxLzwCodes> prefixes;
+			std::array<std::uint8_t, MaxLzwCodes> suffixes;
+			std::array<std::uint8_t, MaxLzwCodes> firstBytes;
+			std::array<std::uint16_t, MaxLzwCodes> lengths;
+
+			const std::uint32_t clearCode = 1U << minCodeSize;
+			const std::uint32_t endCode = clearCode + 1;
+			for (std::uint32_t code = 0; code < clearCode; code++)
+			{
+				suffixes[code] = static_cast<std::uint8_t>(code);
+				firstBytes[code] = static_cast<std::uint8_t>(code);
+				lengths[code] = 1;
+			}
+
+			std::uint32_t codeSize = minCodeSize + 1U;
+			std::uint32_t nextCode = clearCode + 2;
+			// No string to extend right after a clear code
+			constexpr std::uint32_t NoCode = MaxLzwCodes;
+			std::uint32_t previousCode = NoCode;
+
+			std::uint32_t bitBuffer = 0;
+			std::uint32_t bitCount = 0;
+			std::size_t position = 0;
+			std::size_t blockRemaining = 0;
+
+			std::size_t written = 0;
+			const auto outputSize = output.size();
+
+			while (written < outputSize)
+			{
+				while (bitCount < codeSize)
+				{
+					if (blockRemaining == 0)
+					{
+						if (position >= subBlocks.size())
+						{
+							return written;
+						}
+						blockRemaining = std::to_integer<std::size_t>(subBlocks[position++]);
+						if (blockRemaining == 0)
+						{
+							return written;
+						}
+					}
+					if (position >= subBlocks.size())
+					{
+						return written;
+					}
+
+					bitBuffer |= std::to_integer<std::uint32_t>(subBlocks[position++]) << bitCount;
+					bitCount += 8;
+					blockRemaining--;
+				}
+
+				const auto code = bitBuffer & ((1U << codeSize) - 1);
+				bitBuffer >>= codeSize;
+				bitCount -= codeSize;
+
+				if (code == clearCode)
+				{
+					codeSize = minCodeSize + 1U;
+					nextCode = clearCode + 2;
+					previousCode = NoCode;
+					continue;
+				}
+				if (code == endCode)
+				{
+					break;
+				}
+
+				if (previousCode != NoCode)
+				{
+					if (code > nextCode || (code == nextCode && nextCode == MaxLzwCodes))
+					{
+						break;
+					}
+
+					// The table stops growing once full, until the encoder sends a clear code
+					if (nextCode < MaxLzwCodes)
+					{
+						prefixes[nextCode] = static_cast<std::uint16_t>(previousCode);
+						suffixes[nextCode] = firstBytes[code < nextCode ? code : previousCode];
+						firstBytes[nextCode] = firstBytes[previousCode];
+						lengths[nextCode] = static_cast<std::uint16_t>(lengths[previousCode] + 1);
+						nextCode++;
+
+						if (nextCode == (1U << codeSize) && codeSize < MaxLzwCodeSize)
+						{
+							codeSize++;
+						}
+					}
+				}
+				else if (code > endCode)
+				{
+					break;
+				}
+
+				const std::size_t length = lengths[code];
+				auto stringCode = code;
+				if (written + length <= outputSize)
+				{
+					for (auto i = length; i-- > 0;)
+					{
+						output[written + i] = suffixes[stringCode];
+						stringCode = prefixes[stringCode];
+					}
+					written += length;
+				}
+				else
+				{
+					for (auto i = length; i-- > 0;)
+					{
+						if (written + i < outputSize)
+						{
+							output[written + i] = suffixes[stringCode];
+						}
+						stringCode = prefixes[stringCode];
+					}
+					written = outputSize;
+				}
+
+				previousCode = code;
+			}
+
+			return written;
+		}
+	}
+
+	#pragma endregion
+
+	#pragma region GifDecoder
+
+	GifDecoder::GifDecoder(std::vector<std::byte> data) :
+		data{ std::move(data) }
+	{
+		Parse();
+	}
+
+	auto GifDecoder::FromFile(const std::filesystem::path& path) -> GifDecoder
+	{
+		std::ifstream file{ path, std::ios::binary };
+		if (!file)
+		{
+			throw GifFormatException{ "Can't open GIF file" };
+		}
+
+		std::vector<char> contents{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{ } };
+
+		std::vector<std::byte> bytes(contents.size());
+		std::memcpy(bytes.data(), contents.data(), contents.size());
+
+		return GifDecoder{ std::move(bytes) };
+	}
+
+	void GifDecoder::Parse()
+	{
+		ByteReader reader{ data };
+
+		const auto signature = reader.ReadBytes(6);
+		const std::string_view header{ std::bit_cast<const char*>(signature.data()), signature.size() };
+		if (header != "GIF87a" && header != "GIF89a")
+		{
+			throw GifFormatException{ "Not a GIF file" };
+		}
+
+		canvasSize.cx = reader.ReadUInt16();
+		canvasSize.cy = reader.ReadUInt16();
+		const auto screenFlags = reader.ReadByte();
+		const auto backgroundIndex = reader.ReadByte();
+		(void)reader.ReadByte();
+
+		if (canvasSize.cx == 0 || canvasSize.cy == 0)
+		{
+			throw GifFormatException{ "GIF canvas is empty" };
+		}
+		if (static_cast<std::uint64_t>(canvasSize.cx) * canvasSize.cy > MaxPixelCount)
+		{
+			throw GifFormatException{ "GIF canvas is too large" };
+		}
+
+		std::optional<std::size_t> globalPaletteIndex;
+		if ((screenFlags & 0x80) != 0)
+		{
+			palettes.push_back(ReadPalette(reader, screenFlags & 0x07));
+			globalPaletteIndex = 0;
+			backgroundColor = palettes.front()[backgroundIndex];
+		}
+		else
+		{
+			GifPalette grayscale;
+			for (std::uint32_t i = 0; i < grayscale.size(); i++)
+			{
+				grayscale[i] = OpaqueBlack | (i << 16) | (i << 8) | i;
+			}
+			palettes.push_back(grayscale);
+		}
+
+		GifFrameInfo pending;
+		try
+		{
+			while (reader.GetRemaining() != 0)
+			{
+				const auto blockType = std::byte{ reader.ReadByte() };
+
+				if (blockType == Trailer)
+				{
+					break;
+				}
+				if (blockType == ExtensionIntroducer)
+				{
+					const auto label = std::byte{ reader.ReadByte() };
+					if (label == GraphicControlLabel)
+					{
+						const auto blockSize = reader.ReadByte();
+						const auto block = reader.ReadBytes(blockSize);
+						if (blockSize >= 4)
+						{
+							const auto flags = std::to_integer<std::uint8_t>(block[0]);
+							const auto delay = std::to_integer<std::uint32_t>(block[1]) |
+								(std::to_integer<std::uint32_t>(block[2]) << 8);
+
+							pending.disposal = GifDisposal{ static_cast<std::uint8_t>((flags >> 2) & 0x07) };
+							if (pending.disposal > GifDisposal::Previous)
+							{
+								pending.disposal = GifDisposal::Unspecified;
+							}
+							pending.delay = std::chrono::milliseconds{ delay * 10 };
+							pending.transparentIndex = (flags & 0x01) != 0 ?
+								std::optional{ std::to_integer<std::uint8_t>(block[3]) } : std::nullopt;
+						}
+						reader.SkipSubBlocks();
+					}
+					else if (label == ApplicationLabel)
+					{
+						const auto blockSize = reader.ReadByte();
+						const auto identifier = reader.ReadBytes(blockSize);
+						const std::string_view application{ std::bit_cast<const char*>(identifier.data()), identifier.size() };
+
+						if (application == "NETSCAPE2.0" || application == "ANIMEXTS1.0")
+						{
+							if (const auto subBlockSize = reader.ReadByte();
+								subBlockSize != 0)
+							{
+								const auto subBlock = reader.ReadBytes(subBlockSize);
+								if (subBlockSize >= 3 && std::to_integer<std::uint8_t>(subBlock[0]) == 1)
+								{
+									loopCount = std::to_integer<std::uint32_t>(subBlock[1]) |
+										(std::to_integer<std::uint32_t>(subBlock[2]) << 8);
+								}
+								reader.SkipSubBlocks();
+							}
+						}
+						else
+						{
+							reader.SkipSubBlocks();
+						}
+					}
+					else
+					{
+						reader.SkipSubBlocks();
+					}
+					continue;
+				}
+				if (blockType != ImageSeparator)
+				{
+					throw GifFormatException{ "Unknown GIF block" };
+				}
+
+				GifFrameInfo frame = pending;
+				pending = GifFrameInfo{ };
+
+				const std::uint32_t left = reader.ReadUInt16();
+				const std::uint32_t top = reader.ReadUInt16();
+				const std::uint32_t width = reader.ReadUInt16();
+				const std::uint32_t height = reader.ReadUInt16();
+				frame.rect = RectU{ left, top, left + width, top + height };
+				if (static_cast<std::uint64_t>(width) * height > MaxPixelCount)
+				{
+					throw GifFormatException{ "GIF frame is too large" };
+				}
+
+				const auto imageFlags = reader.ReadByte();
+				frame.isInterlaced = (imageFlags & 0x40) != 0;
+				if ((imageFlags & 0x80) != 0)
+				{
+					frame.paletteIndex = palettes.size();
+					palettes.push_back(ReadPalette(reader, imageFlags & 0x07));
+				}
+				else
+				{
+					frame.paletteIndex = globalPaletteIndex.value_or(0);
+				}
+
+				frame.minCodeSize = reader.ReadByte();
+				frame.dataOffset = reader.GetPosition();
+				reader.SkipSubBlocks();
+
+				frames.push_back(frame);
+			}
+		}
+		catch (const GifFormatException&)
+		{
+			// Browsers show what's there of a truncated file
+			if (frames.empty())
+			{
+				throw;
+			}
+		}
+
+		if (frames.empty())
+		{
+			throw GifFormatException{ "GIF has no frames" };
+		}
+	}
+
+	void GifDecoder::DecodeIndices(std::size_t frameIndex, std::vector<std::uint8_t>& indices) const
+	{
+		const auto& frame = frames[frameIndex];
+		const std::size_t width = frame.rect.Width();
+		const std::size_t height = frame.rect.Height();
+		const auto fill = frame.transparentIndex.value_or(0);
+
+		indices.resize(width * height);
+
+		const auto subBlocks = std::span<const std::byte>{ data }.subspan(frame.dataOffset);
+		if (!frame.isInterlaced)
+		{
+			const auto written = gif_detail::DecodeLzw(subBlocks, frame.minCodeSize, indices);
+			std::fill(indices.begin() + static_cast<std::ptrdiff_t>(written), indices.end(), fill);
+			return;
+		}
+
+		std::vector<std::uint8_t> interlaced(width * height, fill);
+		(void)gif_detail::DecodeLzw(subBlocks, frame.minCodeSize, interlaced);
+
+		for (std::size_t row = 0; row < height; row++)
+		{
+			std::copy_n(interlaced.begin() + static_cast<std::ptrdiff_t>(row * width), width,
+				indices.begin() + static_cast<std::ptrdiff_t>(InterlacedRowToDisplayRow(row, height) * width));
+		}
+	}
+
+	#pragma endregion
+
+	#pragma region GifComposer
+
+	GifComposer::GifComposer(std::shared_ptr<const GifDecoder> decoder) :
+		decoder{ std::move(decoder) }
+	{
+		Reset();
+	}
+
+	auto GifComposer::ComposeFrame(std::size_t frameIndex) -> RectU
+	{
+		if (frameIndex >= decoder->GetFrameCount())
+		{
+			return RectU{ };
+		}
+
+		RectU changed;
+		if (frameIndex == 0 || !lastFrameIndex.has_value() || *lastFrameIndex + 1 != frameIndex)
+		{
+			Reset();
+			for (std::size_t i = 0; i < frameIndex; i++)
+			{
+				(void)ComposeFrame(i);
+			}
+			if (lastFrameIndex.has_value())
+			{
+				(void)DisposeLastFrame();
+			}
+			changed = RectU{ PointU{ 0, 0 }, GetCanvasSize() };
+		}
+		else
+		{
+			changed = DisposeLastFrame();
+		}
+
+		const auto& frame = decoder->GetFrameInfo(frameIndex);
+		const auto frameRect = ClipToCanvas(frame.rect);
+
+		if (frame.disposal == GifDisposal::Previous)
+		{
+			SaveRect(frameRect);
+		}
+		DrawFrame(frameIndex);
+
+		lastFrameIndex = frameIndex;
+		lastFrameRect = frameRect;
+
+		if (changed.Area() == 0)
+		{
+			return frameRect;
+		}
+		if (frameRect.Area() == 0)
+		{
+			return changed;
+		}
+		return RectU{
+			std::min(changed.left, frameRect.left), std::min(changed.top, frameRect.top),
+			std::max(changed.right, frameRect.right), std::max(changed.bottom, frameRect.bottom) };
+	}
+
+	void GifComposer::Reset()
+	{
+		const auto size = GetCanvasSize();
+		canvas.assign(static_cast<std::size_t>(size.cx) * size.cy, backgroundColor);
+		lastFrameIndex.reset();
+		lastFrameRect = RectU{ };
+	}
+
+	auto GifComposer::DisposeLastFrame() -> RectU
+	{
+		switch (decoder->GetFrameInfo(*lastFrameIndex).disposal)
+		{
+			case GifDisposal::Background:
+				FillRect(lastFrameRect, backgroundColor);
+				return lastFrameRect;
+			case GifDisposal::Previous:
+				RestoreRect(lastFrameRect);
+				return lastFrameRect;
+			default:
+				return RectU{ };
+		}
+	}
+
+	void GifComposer::FillRect(RectU rect, std::uint32_t color) noexcept
+	{
+		const auto canvasWidth = GetCanvasSize().cx;
+		for (auto y = rect.top; y < rect.bottom; y++)
+		{
+			const auto rowStart = canvas.begin() + static_cast<std::ptrdiff_t>(static_cast<std::size_t>(y) * canvasWidth);
+			std::fill(rowStart + rect.left, rowStart + rect.right, color);
+		}
+	}
+
+	void GifComposer::SaveRect(RectU rect)
+	{
+		const auto canvasWidth = GetCanvasSize().cx;
+		const std::size_t width = rect.Width();
+
+		savedArea.resize(width * rect.Height());
+		for (auto y = rect.top; y < rect.bottom; y++)
+		{
+			std::copy_n(canvas.begin() + static_cast<std::ptrdiff_t>(static_cast<std::size_t>(y) * canvasWidth + rect.left), width,
+				savedArea.begin() + static_cast<std::ptrdiff_t>((y - rect.top) * width));
+		}
+	}
+
+	void GifComposer::RestoreRect(RectU rect) noexcept
+	{
+		const auto canvasWidth = GetCanvasSize().cx;
+		const std::size_t width = rect.Width();
+		if (savedArea.size() != width * rect.Height())
+		{
+			return;
+		}
+
+		for (auto y = rect.top; y < rect.bottom; y++)
+		{
+			std::copy_n(savedArea.begin() + static_cast<std::ptrdiff_t>((y - rect.top) * width), width,
+				canvas.begin() + static_cast<std::ptrdiff_t>(static_cast<std::size_t>(y) * canvasWidth + rect.left));
+		}
+	}
+
+	void GifComposer::DrawFrame(std::size_t frameIndex)
+	{
+		const auto& frame = decoder->GetFrameInfo(frameIndex);
+		const auto& palette = decoder->GetPalette(frameIndex);
+		const auto visible = ClipToCanvas(frame.rect);
+		if (visible.Area() == 0)
+		{
+			return;
+		}
+
+		decoder->DecodeIndices(frameIndex, indices);
+
+		const auto canvasWidth = GetCanvasSize().cx;
+		const std::size_t frameWidth = frame.rect.Width();
+		const std::size_t visibleWidth = visible.Width();
+
+		for (auto y = visible.top; y < visible.bottom; y++)
+		{
+			const auto row = std::span{ indices }.subspan((y - frame.rect.top) * frameWidth, visibleWidth);
+			ExpandPaletteIndices(row, palette, frame.transparentIndex,
+				canvas.data() + static_cast<std::size_t>(y) * canvasWidth + visible.left);
+		}
+	}
+
+	auto GifComposer::ClipToCanvas(RectU rect) const noexcept -> RectU
+	{
+		return rect.IntersectRect(RectU{ PointU{ 0, 0 }, GetCanvasSize() });
+	}
+
+	#pragma endregion
+}
@@ -0,0 +1,288 @@
+#include "ui/bmp/TilePyramid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+
+namespace PGUI::UI::Bmp
+{
+	namespace
+	{
+		[[nodiscard]] auto TileBytes(const ImageTile& tile) noexcept -> std::size_t
+		{
+			return tile.pixels.size() * sizeof(std::uint32_t);
+		}
+
+		[[nodiscard]] constexpr auto HalveRoundingUp(std::uint32_t value, std::uint32_t times) noexcept -> std::uint32_t
+		{
+			for (std::uint32_t i = 0; i < times; i++)
+			{
+				value = (value + 1) / 2;
+			}
+			return value;
+		}
+	}
+
+	auto TileKeyHash::operator()(TileKey key) const noexcept -> std::size_t
+	{
+		const auto packed = (static_cast<std::uint64_t>(key.level) << 56) ^
+			(static_cast<std::uint64_t>(key.column) << 28) ^ key.row;
+		return std::hash<std::uint64_t>{ }(packed);
+	}
+
+	void tile_detail::Downsample(std::span<const std::uint32_t> source, SizeU sourceSize,
+		std::span<std::uint32_t> destination) noexcept
+	{
+		const auto width = (sourceSize.cx + 1) / 2;
+		const auto height = (sourceSize.cy + 1) / 2;
+
+		for (std::uint32_t y = 0; y < height; y++)
+		{
+			const auto* row0 = source.data() + static_cast<std::size_t>(2 * y) * sourceSize.cx;
+			const auto* row1 = 2 * y + 1 < sourceSize.cy ? row0 + sourceSize.cx : row0;
+			auto* out = destination.data() + static_cast<std::size_t>(y) * width;
+
+			for (std::uint32_t x = 0; x < width; x++)
+			{
+				const auto x0 = 2 * x;
+				const auto x1 = x0 + 1 < sourceSize.cx ? x0 + 1 : x0;
+				const std::uint32_t pixels[4] = { row0[x0], row0[x1], row1[x0], row1[x1] };
+
+				// Premultiplied channels can be averaged independently, the two masks keep the sums from carrying over
+				std::uint32_t evenSum = 2 * 0x00010001U;
+				std::uint32_t oddSum = 2 * 0x00010001U;
+				for (const auto pixel : pixels)
+				{
+					evenSum += pixel & 0x00FF00FFU;
+					oddSum += (pixel >> 8) & 0x00FF00FFU;
+				}
+				out[x] = ((evenSum >> 2) & 0x00FF00FFU) | (((oddSum >> 2) & 0x00FF00FFU) << 8);
+			}
+		}
+	}
+
+	TilePyramid::TilePyramid(SizeU imageSize, TileReader reader, std::uint32_t tileSize, std::size_t byteBudget) :
+		imageSize{ imageSize }, reader{ std::move(reader) },
+		tileSize{ std::max(tileSize, 1U) }, byteBudget{ byteBudget }
+	{
+		while (GetLevelSize(levelCount - 1).cx > this->tileSize || GetLevelSize(levelCount - 1).cy > this->tileSize)
+		{
+			levelCount++;
+		}
+	}
+
+	auto TilePyramid::GetLevelSize(std::uint32_t level) const noexcept -> SizeU
+	{
+		return SizeU{ HalveRoundingUp(imageSize.cx, level), HalveRoundingUp(imageSize.cy, level) };
+	}
+
+	auto TilePyramid::GetTileGrid(std::uint32_t level) const noexcept -> SizeU
+	{
+		const auto levelSize = GetLevelSize(level);
+		return SizeU{ (levelSize.cx + tileSize - 1) / tileSize, (levelSize.cy + tileSize - 1) / tileSize };
+	}
+
+	auto TilePyramid::GetTileRect(TileKey key) const noexcept -> RectU
+	{
+		const auto levelSize = GetLevelSize(key.level);
+		return RectU{
+			key.column * tileSize, key.row * tileSize,
+			std::min((key.column + 1) * tileSize, levelSize.cx),
+			std::min((key.row + 1) * tileSize, levelSize.cy) };
+	}
+
+	auto TilePyramid::SelectLevel(float scale) const noexcept -> std::uint32_t
+	{
+		if (!(scale > 0.0F) || scale >= 1.0F)
+		{
+			return 0;
+		}
+
+		const auto level = static_cast<std::uint32_t>(std::floor(std::log2(1.0F / scale)));
+		return std::min(level, levelCount - 1);
+	}
+
+	auto TilePyramid::GetTilesInRect(std::uint32_t level, RectF imageRect) const -> std::vector<TileKey>
+	{
+		level = std::min(level, levelCount - 1);
+
+		const auto levelSize = GetLevelSize(level);
+		const auto scale = std::ldexp(1.0F, -static_cast<int>(level));
+		const auto toLevel = [scale](float value, std::uint32_t limit)
+		{
+			return std::clamp(value * scale, 0.0F, static_cast<float>(limit));
+		};
+
+		const auto left = static_cast<std::uint32_t>(toLevel(imageRect.left, levelSize.cx)) / tileSize;
+		const auto top = static_cast<std::uint32_t>(toLevel(imageRect.top, levelSize.cy)) / tileSize;
+		const auto right = (static_cast<std::uint32_t>(std::ceil(toLevel(imageRect.right, levelSize.cx))) + tileSize - 1) / tileSize;
+		const auto bottom = (static_cast<std::uint32_t>(std::ceil(toLevel(imageRect.bottom, levelSize.cy))) + tileSize - 1) / tileSize;
+
+		std::vector<TileKey> keys;
+		for (auto row = top; row < bottom; row++)
+		{
+			for (auto column = left; column < right; column++)
+			{
+				keys.push_back(TileKey{ level, column, row });
+			}
+		}
+		return keys;
+	}
+
+	auto TilePyramid::GetTile(TileKey key, std::optional<Clock::time_point> deadline) -> std::shared_ptr<const ImageTile>
+	{
+		if (auto iter = tiles.find(key);
+			iter != tiles.end())
+		{
+			hitCount++;
+			lru.splice(lru.begin(), lru, iter->second);
+			return *iter->second;
+		}
+
+		if (key.level >= levelCount)
+		{
+			return nullptr;
+		}
+		if (const auto grid = GetTileGrid(key.level);
+			key.column >= grid.cx || key.row >= grid.cy)
+		{
+			return nullptr;
+		}
+
+		if (key.level == 0)
+		{
+			if (deadline.has_value() && Clock::now() >= *deadline)
+			{
+				return nullptr;
+			}
+			return ReadTile(key);
+		}
+		return BuildTile(key, deadline);
+	}
+
+	auto TilePyramid::FindTile(TileKey key) const -> std::shared_ptr<const ImageTile>
+	{
+		if (auto iter = tiles.find(key);
+			iter != tiles.end())
+		{
+			return *iter->second;
+		}
+		return nullptr;
+	}
+
+	void TilePyramid::Clear() noexcept
+	{
+		tiles.clear();
+		lru.clear();
+		byteSize = 0;
+	}
+
+	void TilePyramid::SetByteBudget(std::size_t _byteBudget)
+	{
+		byteBudget = _byteBudget;
+		EvictOverBudget();
+	}
+
+	auto TilePyramid::ReadTile(TileKey key) -> std::shared_ptr<const ImageTile>
+	{
+		const auto rect = GetTileRect(key);
+
+		auto tile = std::make_shared<ImageTile>();
+		tile->key = key;
+		tile->size = rect.Size();
+		tile->pixels.resize(static_cast<std::size_t>(rect.Width()) * rect.Height());
+		reader(rect, tile->pixels);
+
+		readCount++;
+		Insert(tile);
+		return tile;
+	}
+
+	auto TilePyramid::BuildTile(TileKey key, std::optional<Clock::time_point> deadline) -> std::shared_ptr<const ImageTile>
+	{
+		// Held here so building one child can't evict another before they're averaged
+		std::shared_ptr<const ImageTile> children[2][2];
+		bool isComplete = true;
+
+		const auto childGrid = GetTileGrid(key.level - 1);
+		for (std::uint32_t dy = 0; dy < 2; dy++)
+		{
+			for (std::uint32_t dx = 0; dx < 2; dx++)
+			{
+				const TileKey childKey{ key.level - 1, 2 * key.column + dx, 2 * key.row + dy };
+				if (childKey.column >= childGrid.cx || childKey.row >= childGrid.cy)
+				{
+					continue;
+				}
+
+				children[dy][dx] = GetTile(childKey, deadline);
+				isComplete = isComplete && children[dy][dx] != nullptr;
+			}
+		}
+		if (!isComplete)
+		{
+			return nullptr;
+		}
+
+		// The children put together cover twice the tile's rect, clipped to the level below
+		const auto rect = GetTileRect(key);
+		const auto childLevelSize = GetLevelSize(key.level - 1);
+		const SizeU sourceSize{
+			std::min(2 * rect.right, childLevelSize.cx) - 2 * rect.left,
+			std::min(2 * rect.bottom, childLevelSize.cy) - 2 * rect.top };
+
+		std::vector<std::uint32_t> source(static_cast<std::size_t>(sourceSize.cx) * sourceSize.cy);
+		for (std::uint32_t dy = 0; dy < 2; dy++)
+		{
+			for (std::uint32_t dx = 0; dx < 2; dx++)
+			{
+				const auto& child = children[dy][dx];
+				if (!child)
+				{
+					continue;
+				}
+
+				auto* destination = source.data() + static_cast<std::size_t>(dy) * tileSize * sourceSize.cx + dx * tileSize;
+				for (std::uint32_t y = 0; y < child->size.cy; y++)
+				{
+					std::memcpy(destination + static_cast<std::size_t>(y) * sourceSize.cx,
+						child->pixels.data() + static_cast<std::size_t>(y) * child->size.cx,
+						child->size.cx * sizeof(std::uint32_t));
+				}
+			}
+		}
+
+		auto tile = std::make_shared<ImageTile>();
+		tile->key = key;
+		tile->size = rect.Size();
+		tile->pixels.resize(static_cast<std::size_t>(rect.Width()) * rect.Height());
+		tile_detail::Downsample(source, sourceSize, tile->pixels);
+
+		buildCount++;
+		Insert(tile);
+		return tile;
+	}
+
+	void TilePyramid::Insert(const std::shared_ptr<const ImageTile>& tile)
+	{
+		lru.push_front(tile);
+		tiles.emplace(tile->key, lru.begin());
+		byteSize += TileBytes(*tile);
+
+		EvictOverBudget();
+	}
+
+	void TilePyramid::EvictOverBudget() noexcept
+	{
+		// The most recent tile stays even over budget, it's about to be drawn
+		while (byteSize > byteBudget && lru.size() > 1)
+		{
+			const auto& oldest = lru.back();
+			byteSize -= TileBytes(*oldest);
+			tiles.erase(oldest->key);
+			lru.pop_back();
+		}
+	}
+}
@@ -0,0 +1,64 @@
+#include "ui/bmp/TiledImage.hpp"
+
+#include "helpers/HelperFunctions.hpp"
+
+#include <bit>
+
+
+namespace PGUI::UI::Bmp
+{
+	TiledImage::TiledImage(IWICImagingFactory* factory, const std::filesystem::path& filePath,
+		std::uint32_t tileSize, std::size_t byteBudget) :
+		file{ filePath },
+		pyramid{ OpenSource(factory), [this](RectU rect, std::span<std::uint32_t> pixels)
+		{
+			ReadPixels(rect, pixels);
+		}, tileSize, byteBudget }
+	{
+	}
+
+	auto TiledImage::GetTile(TileKey key) -> std::shared_ptr<const ImageTile>
+	{
+		std::scoped_lock lock{ mutex };
+		return pyramid.GetTile(key);
+	}
+
+	auto TiledImage::OpenSource(IWICImagingFactory* wicFactory) -> SizeU
+	{
+		const auto data = file.GetData();
+
+		if (data.size() > MAXDWORD)
+		{
+			// Memory streams are limited to 4GB
+			HR_T(HRESULT_FROM_WIN32(ERROR_FILE_TOO_LARGE));
+		}
+
+		// WIC only reads through the stream, the mapping itself is read only
+		HRESULT hr = wicFactory->CreateStream(&stream); HR_T(hr);
+		hr = stream->InitializeFromMemory(
+			const_cast<BYTE*>(std::bit_cast<const BYTE*>(data.data())), static_cast<DWORD>(data.size())); HR_T(hr);
+
+		hr = wicFactory->CreateDecoderFromStream(stream.Get(), nullptr, WICDecodeMetadataCacheOnDemand, &decoder); HR_T(hr);
+
+		ComPtr<IWICBitmapFrameDecode> frame;
+		hr = decoder->GetFrame(0, &frame); HR_T(hr);
+
+		hr = wicFactory->CreateFormatConverter(&converter); HR_T(hr);
+		hr = converter->Initialize(frame.Get(), GUID_WICPixelFormat32bppPBGRA,
+			WICBitmapDitherTypeNone, nullptr, 0.0, WICBitmapPaletteTypeCustom); HR_T(hr);
+
+		SizeU size{ };
+		hr = converter->GetSize(&size.cx, &size.cy); HR_T(hr);
+		return size;
+	}
+
+	void TiledImage::ReadPixels(RectU rect, std::span<std::uint32_t> pixels) const
+	{
+		const WICRect wicRect{
+			static_cast<INT>(rect.left), static_cast<INT>(rect.top),
+			static_cast<INT>(rect.Width()), static_cast<INT>(rect.Height()) };
+
+		HRESULT hr = converter->CopyPixels(&wicRect, rect.Width() * 4,
+			static_cast<UINT>(pixels.size_bytes()), std::bit_cast<BYTE*>(pixels.data())); HR_T(hr);
+	}
+}
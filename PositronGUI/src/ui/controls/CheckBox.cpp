@@ -103,6 +103,22 @@ namespace PGUI::UI::Controls
 		StateChangedEvent().Subscribe(PGUI::BindMemberFunc(&CheckBox::OnStateChanged, this));
 		OnStateChanged(GetState());
 	}
+	CheckBox::CheckBox(ThemeColorsGetter _themeColors) noexcept :
+		CheckBox{ _themeColors() }
+	{
+		themeColors = _themeColors;
+		themeChangedConnection = UIColors::ThemeChangedEvent().Subscribe(
+			PGUI::BindMemberFunc(&CheckBox::OnThemeChanged, this), Core::EventDelivery::UIThread);
+	}
+
+	void CheckBox::SetColors(const CheckBoxColors& newColors)
+	{
+		colors = newColors;
+		themeColors = nullptr;
+		themeChangedConnection.Disconnect();
+
+		OnStateChanged(GetState());
+	}
 
 	void CheckBox::CreateDeviceResources()
 	{
@@ -197,10 +213,15 @@ namespace PGUI::UI::Controls
 				return;
 		}
 
-		DiscardDeviceResources();
 		Invalidate();
 	}
 
+	void CheckBox::OnThemeChanged() noexcept
+	{
+		colors = themeColors();
+		OnStateChanged(GetState());
+	}
+
 	auto CheckBox::OnPaint(UINT /*unused*/, WPARAM /*unused*/, LPARAM /*unused*/) noexcept -> Core::HandlerResult
 	{
 		BeginDraw();
@@ -2,10 +2,14 @@
 
 #include "helpers/HelperFunctions.hpp"
 #include "ui/Colors.hpp"
+#include "ui/TextFormatCache.hpp"
 #include "factories/WICFactory.hpp"
 
+#include <algorithm>
 #include <cwctype>
+#include <new>
 #include <type_traits>
+#include <utility>
 #include <strsafe.h>
 #include <TOM.h>
 
@@ -118,6 +122,18 @@ namespace PGUI::UI::Controls
 		StringCchCopyW(
 			static_cast<STRSAFE_LPWSTR>(charFormat.szFaceName), params.fontFace.length(), params.fontFace.c_str());
 
+		ApplyThemeColors();
+		themeChangedConnection = UIColors::ThemeChangedEvent().Subscribe(
+			BindMemberFunc(&Edit::OnThemeChanged, this), Core::EventDelivery::UIThread);
+
+		// The rich edit keeps the undo history
+		document.SetUndoLimit(0);
+
+		Msftedit::LoadMsftedit();
+	}
+
+	void Edit::ApplyThemeColors() noexcept
+	{
 		if (UIColors::IsDarkMode())
 		{
 			charFormat.crTextColor = Colors::Aliceblue;
@@ -131,22 +147,52 @@ namespace PGUI::UI::Controls
 			charFormat.crBackColor = std::get<RGBA>(backgroundBrush.GetParameters());
 		}
 
-		Msftedit::LoadMsftedit();
+		auto selectionColor = UIColors::GetAccentColor();
+		selectionColor.a = 0.4F;
+		selectionBrush.SetParameters(selectionColor);
+	}
+
+	void Edit::OnThemeChanged() noexcept
+	{
+		if (!followsTheme)
+		{
+			return;
+		}
+
+		ApplyThemeColors();
+		if (textServices)
+		{
+			SetDefaultCharFormat(charFormat);
+		}
+		Invalidate();
 	}
 
-	void Edit::SetText(std::wstring_view text) const noexcept
+	void Edit::SetText(std::wstring_view text) noexcept
 	{
+		const auto syncCount = documentSyncCount;
 		textServices->TxSetText(text.data());
+		ResyncDocumentIfUnchanged(syncCount);
+
 		Invalidate();
 	}
 
-	auto Edit::GetText() const noexcept -> std::wstring
+	auto Edit::GetText() const -> std::wstring
 	{
-		std::wstring text(GetTextLength(), L'\0');
+		EnsureDocumentSynced();
 
-		HRESULT hr = textServices->TxSendMessage(WM_GETTEXT, text.length() + 1,
-			std::bit_cast<LPARAM>(text.data()), nullptr);
-		HR_L(hr);
+		// Paragraphs end with "\r\n" like WM_GETTEXT's, but copied from the document in one pass
+		std::wstring text;
+		text.reserve(document.GetLength() + document.GetLineCount() - 1);
+
+		document.VisitText(0, document.GetLength(), [&text](std::wstring_view chunk)
+		{
+			for (auto lineEnd = chunk.find(L'\r'); lineEnd != std::wstring_view::npos; lineEnd = chunk.find(L'\r'))
+			{
+				text.append(chunk.substr(0, lineEnd + 1)).push_back(L'\n');
+				chunk.remove_prefix(lineEnd + 1);
+			}
+			text.append(chunk);
+		});
 
 		return text;
 	}
@@ -162,6 +208,7 @@ namespace PGUI::UI::Controls
 
 	void Edit::SetTextColor(RGBA color) noexcept
 	{
+		followsTheme = false;
 		charFormat.crTextColor = color;
 		SetDefaultCharFormat(charFormat);
 	}
@@ -179,6 +226,17 @@ namespace PGUI::UI::Controls
 		SetDefaultCharFormat(charFormat);
 	}
 
+	void Edit::SetViewportRendering(bool _viewportRendering)
+	{
+		viewportRendering = _viewportRendering;
+		if (viewportRendering)
+		{
+			UpdateViewportTextFormat();
+		}
+
+		Invalidate();
+	}
+
 	auto Edit::GetCaretPosition() const noexcept -> PointL
 	{
 		return textHost.caretPos;
@@ -199,6 +257,7 @@ namespace PGUI::UI::Controls
 
 	void Edit::SetBackgroundBrush(const Brush& bkgndBrush) noexcept
 	{
+		followsTheme = false;
 		backgroundBrush.SetParameters(bkgndBrush.GetParameters());
 	}
 
@@ -263,7 +322,7 @@ namespace PGUI::UI::Controls
 		POINT p{ };
 
 		HRESULT hr =
-			textServices->TxSendMessage(EM_POSFROMCHAR, std::bit_cast<WPARAM>(p), index, nullptr);
+			textServices->TxSendMessage(EM_POSFROMCHAR, std::bit_cast<WPARAM>(&p), index, nullptr);
 		HR_L(hr);
 
 		return p;
@@ -339,8 +398,21 @@ namespace PGUI::UI::Controls
 		textServices->OnTxPropertyBitsChange(propertyBits, propertyBits);
 	}
 
-	auto Edit::Find(EditFindFlag flags, std::wstring_view text, CharRange searchRange) const noexcept -> CharRange
+	auto Edit::Find(EditFindFlag flags, std::wstring_view text, CharRange searchRange) const -> CharRange
 	{
+		if (flags == (EditFindFlag::Down | EditFindFlag::CaseSensitive))
+		{
+			EnsureDocumentSynced();
+			const auto [position, length] = ToDocumentRange(searchRange);
+			const auto found = document.Find(text, position, position + length);
+			if (found == TextBuffer::NotFound)
+			{
+				return CharRange{ -1, -1 };
+			}
+
+			return CharRange{ static_cast<long>(found), static_cast<long>(found + text.length()) };
+		}
+
 		FINDTEXTEXW ft{ };
 		ft.chrg = searchRange;
 		ft.lpstrText = text.data();
@@ -395,12 +467,18 @@ namespace PGUI::UI::Controls
 	{
 		HRESULT hr =
 			textServices->TxSendMessage(EM_SETEVENTMASK, NULL, 
-				static_cast<LPARAM>(eventFlag), nullptr);
+				static_cast<LPARAM>(eventFlag | EditEventMaskFlag::Change), nullptr);
 		HR_L(hr);
 	}
 
 	auto Edit::GetFirstVisibleLine() const noexcept -> std::int64_t
 	{
+		if (viewportRendering && viewport.GetLineHeight() > 0.0F)
+		{
+			EnsureDocumentSynced();
+			return static_cast<std::int64_t>(viewport.GetLineFromY(GetScrollPosition().y));
+		}
+
 		LRESULT ret{ };
 		HRESULT hr =
 			textServices->TxSendMessage(EM_GETFIRSTVISIBLELINE, NULL, NULL, &ret);
@@ -409,6 +487,16 @@ namespace PGUI::UI::Controls
 		return ret;
 	}
 
+	auto Edit::GetScrollPosition() const noexcept -> PointL
+	{
+		// EM_GETSCROLLPOS only has 16 bits per coordinate, the text services keep the whole LONG
+		PointL scrollPos{ };
+		HRESULT hr = textServices->TxGetHScroll(nullptr, nullptr, &scrollPos.x, nullptr, nullptr); HR_L(hr);
+		hr = textServices->TxGetVScroll(nullptr, nullptr, &scrollPos.y, nullptr, nullptr); HR_L(hr);
+
+		return scrollPos;
+	}
+
 	auto Edit::GetRichEditOle() const noexcept -> ComPtr<IRichEditOle>
 	{
 		ComPtr<IRichEditOle> ole;
@@ -558,18 +646,12 @@ namespace PGUI::UI::Controls
 		return static_cast<EditSelectionFlag>(ret);
 	}
 
-	auto Edit::GetSelectedText() const noexcept -> std::wstring
+	auto Edit::GetSelectedText() const -> std::wstring
 	{
-		auto selectionSize = GetSelection().Length() + 1;
-
-		std::wstring selectedText(selectionSize, L'\0');
-
-		HRESULT hr =
-			textServices->TxSendMessage(EM_GETSELTEXT, NULL,
-				std::bit_cast<LPARAM>(selectedText.data()), nullptr);
-		HR_L(hr);
+		EnsureDocumentSynced();
+		const auto [position, length] = ToDocumentRange(GetSelection());
 
-		return selectedText;
+		return document.GetText(position, length);
 	}
 
 	auto Edit::GetTextLength(std::optional<GETTEXTLENGTHEX> lengthEx) const noexcept -> std::int64_t
@@ -611,20 +693,12 @@ namespace PGUI::UI::Controls
 		HR_L(hr);
 	}
 
-	auto Edit::GetTextRange(CharRange charRange) const noexcept -> std::wstring
+	auto Edit::GetTextRange(CharRange charRange) const -> std::wstring
 	{
-		std::wstring text(charRange.Length(), L'\0');
-
-		TEXTRANGEW tr{ };
-		tr.chrg = charRange;
-		tr.lpstrText = text.data();
+		EnsureDocumentSynced();
+		const auto [position, length] = ToDocumentRange(charRange);
 
-		HRESULT hr =
-			textServices->TxSendMessage(EM_GETTEXTRANGE, NULL,
-				std::bit_cast<LPARAM>(&tr), nullptr);
-		HR_L(hr);
-
-		return text;
+		return document.GetText(position, length);
 	}
 
 	void Edit::SetTargetDevice(HDC hdc, std::int64_t lineWidth) const noexcept
@@ -658,11 +732,13 @@ namespace PGUI::UI::Controls
 				NULL, nullptr);
 		HR_L(hr);
 	}
-	void Edit::ReplaceSelection(std::wstring_view newText, bool canUndo) const noexcept
+	void Edit::ReplaceSelection(std::wstring_view newText, bool canUndo) noexcept
 	{
+		editSelectionHint = GetSelection();
 		HRESULT hr =
 			textServices->TxSendMessage(EM_REPLACESEL, canUndo,
 				std::bit_cast<LPARAM>(newText.data()), nullptr);
+		editSelectionHint.reset();
 		HR_L(hr);
 	}
 
@@ -674,8 +750,14 @@ namespace PGUI::UI::Controls
 		HR_L(hr);
 	}
 
-	auto Edit::GetLine(int line) const noexcept -> std::wstring
+	auto Edit::GetLine(int line) const -> std::wstring
 	{
+		if (line >= 0 && HasParagraphLines())
+		{
+			EnsureDocumentSynced();
+			return document.GetLine(static_cast<std::size_t>(line));
+		}
+
 		auto length = GetLineLength(GetLineIndex(line));
 
 		std::wstring lineText(length, L'\0');
@@ -698,6 +780,13 @@ namespace PGUI::UI::Controls
 
 	auto Edit::GetLineFromCharIndex(std::int64_t index) const noexcept -> std::int64_t
 	{
+		if (HasParagraphLines())
+		{
+			EnsureDocumentSynced();
+			const auto position = index < 0 ? GetSelection().min : index;
+			return static_cast<std::int64_t>(document.GetLineFromPosition(static_cast<std::size_t>(position)));
+		}
+
 		LRESULT ret{ };
 		HRESULT hr =
 			textServices->TxSendMessage(EM_EXLINEFROMCHAR, NULL,
@@ -709,6 +798,20 @@ namespace PGUI::UI::Controls
 
 	auto Edit::GetLineIndex(std::int64_t line) const noexcept -> std::int64_t
 	{
+		if (HasParagraphLines())
+		{
+			EnsureDocumentSynced();
+			const auto lineIndex = line < 0 ?
+				document.GetLineFromPosition(static_cast<std::size_t>(GetSelection().min)) :
+				static_cast<std::size_t>(line);
+			if (lineIndex >= document.GetLineCount())
+			{
+				return -1;
+			}
+
+			return static_cast<std::int64_t>(document.GetLineStart(lineIndex));
+		}
+
 		LRESULT ret{ };
 		HRESULT hr =
 			textServices->TxSendMessage(EM_LINEINDEX, line,
@@ -720,6 +823,13 @@ namespace PGUI::UI::Controls
 
 	auto Edit::GetLineLength(std::int64_t index) const noexcept -> std::int64_t
 	{
+		if (index >= 0 && HasParagraphLines())
+		{
+			EnsureDocumentSynced();
+			const auto line = document.GetLineFromPosition(static_cast<std::size_t>(index));
+			return static_cast<std::int64_t>(document.GetLineLength(line));
+		}
+
 		LRESULT ret{ };
 		HRESULT hr =
 			textServices->TxSendMessage(EM_LINELENGTH, index,
@@ -768,14 +878,19 @@ namespace PGUI::UI::Controls
 		HR_L(hr);
 	}
 
-	auto Edit::StreamIn(int streamFormat, EDITSTREAM editStream) const noexcept -> std::int64_t
+	auto Edit::StreamIn(int streamFormat, EDITSTREAM editStream) noexcept -> std::int64_t
 	{
+		const auto syncCount = documentSyncCount;
+
 		LRESULT ret{ };
 		HRESULT hr =
 			textServices->TxSendMessage(EM_STREAMIN, streamFormat,
 				std::bit_cast<LPARAM>(&editStream), &ret);
 		HR_L(hr);
 
+		// Like TxSetText, streaming in doesn't always notify a change
+		ResyncDocumentIfUnchanged(syncCount);
+
 		return ret;
 	}
 	auto Edit::StreamOut(int streamFormat, EDITSTREAM editStream) const noexcept -> std::int64_t
@@ -796,6 +911,11 @@ namespace PGUI::UI::Controls
 			textServices->TxSendMessage(EM_SETCHARFORMAT, SPF_SETDEFAULT,
 				std::bit_cast<LPARAM>(&charFormat), nullptr);
 		HR_L(hr);
+
+		if (viewportRendering)
+		{
+			UpdateViewportTextFormat();
+		}
 	}
 
 	#pragma endregion
@@ -809,22 +929,47 @@ namespace PGUI::UI::Controls
 			SetGradientBrushRect(backgroundBrush, GetClientRect());
 			g.CreateBrush(backgroundBrush);
 		}
+		if (!textBrush)
+		{
+			g.CreateBrush(textBrush);
+		}
+		if (!selectionBrush)
+		{
+			g.CreateBrush(selectionBrush);
+		}
 	}
 
 	void Edit::DiscardDeviceResources()
 	{
 		backgroundBrush.ReleaseBrush();
+		textBrush.ReleaseBrush();
+		selectionBrush.ReleaseBrush();
 	}
 
 	void Edit::CaretBlinkHandler(Core::TimerId /*unused*/)
 	{
 		showCaret = !showCaret;
-		Invalidate();
+
+		// Only the caret changes between blinks
+		if (textHost.caretRenderTarget)
+		{
+			const PointF caretPos = textHost.caretPos;
+			const SizeF caretSize = textHost.caretRenderTarget.GetBitmap()->GetSize();
+			Invalidate(RectF{ caretPos, caretSize });
+		}
+		else
+		{
+			Invalidate();
+		}
 	}
 
 	auto Edit::OnDPIChange(float dpiScale, RectI suggestedRect) -> Core::HandlerResult
 	{
 		textServices->TxSendMessage(EM_SETZOOM, GetDPI(), PGUI::Core::DEFAULT_SCREEN_DPI, nullptr);
+		if (viewportRendering)
+		{
+			UpdateViewportTextFormat();
+		}
 
 		return Window::OnDPIChange(dpiScale, suggestedRect);
 	}
@@ -855,8 +1000,15 @@ namespace PGUI::UI::Controls
 			p->y = ScaleByDPI(p->y);
 		}
 		
-		if (HRESULT hr = textServices->TxSendMessage(msg, wParam, lParam, &result); 
-			hr == E_OUTOFMEMORY)
+		if (IsLocalEdit(msg, wParam))
+		{
+			editSelectionHint = GetSelection();
+		}
+
+		HRESULT hr = textServices->TxSendMessage(msg, wParam, lParam, &result);
+		editSelectionHint.reset();
+
+		if (hr == E_OUTOFMEMORY)
 		{
 			HR_T(hr);
 		}
@@ -864,6 +1016,237 @@ namespace PGUI::UI::Controls
 		return result;
 	}
 
+	auto Edit::IsLocalEdit(UINT msg, WPARAM wParam) noexcept -> bool
+	{
+		// Edits that only touch the text at and around the selection, undo and redo can change it anywhere
+		switch (msg)
+		{
+			case WM_CHAR:
+				return wParam >= L' ' || wParam == L'\r' || wParam == L'\t' || wParam == L'\b';
+			case WM_KEYDOWN:
+			{
+				const bool isControlDown = (GetKeyState(VK_CONTROL) & 0x8000) != 0;
+				switch (wParam)
+				{
+					case VK_BACK:
+					case VK_DELETE:
+					case VK_INSERT:
+						return true;
+					case 'V':
+					case 'X':
+						return isControlDown;
+					default:
+						return false;
+				}
+			}
+			case WM_CUT:
+			case WM_CLEAR:
+			case WM_PASTE:
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	auto Edit::GetPlainTextLength() const noexcept -> std::int64_t
+	{
+		// Paragraphs as a single '\r', the same as character indexes count them
+		return GetTextLength(GETTEXTLENGTHEX{ GTL_NUMCHARS | GTL_PRECISE, 1200 });
+	}
+
+	auto Edit::ReadTextRange(std::int64_t first, std::int64_t last) const -> std::wstring
+	{
+		std::wstring text(static_cast<std::size_t>(last - first), L'\0');
+
+		TEXTRANGEW textRange{ };
+		textRange.chrg = CharRange{ static_cast<long>(first), static_cast<long>(last) };
+		textRange.lpstrText = text.data();
+
+		LRESULT copied{ };
+		HRESULT hr =
+			textServices->TxSendMessage(EM_GETTEXTRANGE, NULL,
+				std::bit_cast<LPARAM>(&textRange), &copied);
+		HR_L(hr);
+
+		text.resize(std::clamp<std::size_t>(static_cast<std::size_t>(copied), 0, text.size()));
+		return text;
+	}
+
+	void Edit::SyncDocument()
+	{
+		documentSyncCount++;
+
+		// A document that missed a change can't be patched from the selections
+		if (!editSelectionHint.has_value() || documentNeedsResync)
+		{
+			ResyncDocument();
+			return;
+		}
+
+		const auto oldLength = static_cast<std::int64_t>(document.GetLength());
+		const auto newLength = GetPlainTextLength();
+		const auto delta = newLength - oldLength;
+
+		const auto before = editSelectionHint.value();
+		const auto after = GetSelection();
+
+		// The edit replaced the old text from where either selection starts up to where the old one ends,
+		// or further on for keys like Delete, which take text after the caret and leave it where it was
+		const auto start = std::min<std::int64_t>(before.min, after.min);
+		const auto oldEnd = std::max<std::int64_t>({
+			before.max, after.max - delta, start - std::min<std::int64_t>(delta, 0)
+		});
+		const auto newEnd = oldEnd + delta;
+		if (start < 0 || oldEnd > oldLength || newEnd < start)
+		{
+			ResyncDocument();
+			return;
+		}
+
+		// Read with a character either side, if those don't match the guess was wrong
+		const auto readFirst = std::max<std::int64_t>(start - 1, 0);
+		const auto readLast = std::min(newEnd + 1, newLength);
+		const auto read = ReadTextRange(readFirst, readLast);
+		if (std::cmp_not_equal(read.size(), readLast - readFirst) ||
+			(start > 0 && read.front() != document.GetChar(static_cast<std::size_t>(start - 1))) ||
+			(newEnd < newLength && read.back() != document.GetChar(static_cast<std::size_t>(oldEnd))))
+		{
+			ResyncDocument();
+			return;
+		}
+
+		const auto inserted = std::wstring_view{ read }.substr(
+			static_cast<std::size_t>(start - readFirst), static_cast<std::size_t>(newEnd - start));
+		document.Replace(static_cast<std::size_t>(start), static_cast<std::size_t>(oldEnd - start), inserted);
+
+		// A second change from the same message carries on from here
+		editSelectionHint = after;
+	}
+
+	void Edit::ResyncDocument() const
+	{
+		const auto length = GetPlainTextLength();
+		std::wstring text(static_cast<std::size_t>(length), L'\0');
+
+		GETTEXTEX getText{ };
+		getText.cb = static_cast<DWORD>((text.size() + 1) * sizeof(wchar_t));
+		getText.flags = GT_DEFAULT;
+		getText.codepage = 1200;
+
+		LRESULT copied{ };
+		HRESULT hr =
+			textServices->TxSendMessage(EM_GETTEXTEX, std::bit_cast<WPARAM>(&getText),
+				std::bit_cast<LPARAM>(text.data()), &copied);
+		HR_L(hr);
+
+		text.resize(std::clamp<std::size_t>(static_cast<std::size_t>(copied), 0, text.size()));
+		document.Assign(std::move(text));
+		documentNeedsResync = false;
+	}
+
+	void Edit::ResyncDocumentIfUnchanged(std::uint64_t syncCount) noexcept
+	{
+		if (documentSyncCount != syncCount)
+		{
+			return;
+		}
+
+		try
+		{
+			ResyncDocument();
+		}
+		catch (const std::bad_alloc&)
+		{
+			HR_L(E_OUTOFMEMORY);
+		}
+	}
+
+	void Edit::EnsureDocumentSynced() const noexcept
+	{
+		if (!documentNeedsResync)
+		{
+			return;
+		}
+
+		try
+		{
+			ResyncDocument();
+		}
+		catch (const std::bad_alloc&)
+		{
+			// Stays flagged, the next read tries again
+			HR_L(E_OUTOFMEMORY);
+		}
+	}
+
+	auto Edit::HasParagraphLines() const noexcept -> bool
+	{
+		// Without word wrap the rich edit's lines are its paragraphs, which are the document's lines
+		return (propertyBits & TXTBIT_WORDWRAP) == 0;
+	}
+
+	auto Edit::ToDocumentRange(CharRange charRange) const noexcept -> std::pair<std::size_t, std::size_t>
+	{
+		const auto textLength = document.GetLength();
+		const auto first = std::min(static_cast<std::size_t>(std::max(charRange.min, 0L)), textLength);
+		const auto last = charRange.max < 0 ?
+			textLength : std::clamp(static_cast<std::size_t>(charRange.max), first, textLength);
+
+		return { first, last - first };
+	}
+
+	void Edit::UpdateViewportTextFormat()
+	{
+		Font::FontWeight fontWeight = Font::FontWeights::Normal;
+		if ((charFormat.dwMask & CFM_WEIGHT) != 0 && charFormat.wWeight != 0)
+		{
+			fontWeight = static_cast<DWRITE_FONT_WEIGHT>(charFormat.wWeight);
+		}
+		else if ((charFormat.dwMask & CFM_BOLD) != 0 && (charFormat.dwEffects & CFE_BOLD) != 0)
+		{
+			fontWeight = Font::FontWeights::Bold;
+		}
+		const auto isItalic = (charFormat.dwMask & CFM_ITALIC) != 0 && (charFormat.dwEffects & CFE_ITALIC) != 0;
+
+		// In the rich edit's units, it's zoomed by the DPI
+		viewport.SetTextFormat(TextFormatCache::GetInstance().Get(TextFormatDescriptor{
+			.fontFamilyName = static_cast<const wchar_t*>(charFormat.szFaceName),
+			.fontSize = ScaleByDPI(static_cast<float>(charFormat.yHeight) / static_cast<float>(PixelsToTwips(1))),
+			.fontWeight = fontWeight,
+			.fontStyle = isItalic ? Font::FontStyles::Italic : Font::FontStyles::Normal,
+			.wordWrapping = DWRITE_WORD_WRAPPING_NO_WRAP
+		}));
+		viewportGeometryMeasured = false;
+		MeasureViewportGeometry();
+
+		textBrush.SetParameters(RGBA{
+			GetRValue(charFormat.crTextColor), GetGValue(charFormat.crTextColor), GetBValue(charFormat.crTextColor)
+		});
+	}
+
+	void Edit::MeasureViewportGeometry() noexcept
+	{
+		EnsureDocumentSynced();
+
+		// The rich edit's line pitch can't be read until there's a second line to measure it to
+		if (!textServices || document.GetLineCount() < 2)
+		{
+			return;
+		}
+
+		const auto first = GetPositionFromCharIndex(0);
+		const auto second = GetPositionFromCharIndex(static_cast<std::int64_t>(document.GetLineStart(1)));
+		if (second.y <= first.y)
+		{
+			return;
+		}
+
+		const auto scroll = GetScrollPosition();
+		viewport.SetLineHeight(static_cast<float>(second.y - first.y));
+		viewportOrigin = PointF{ static_cast<float>(first.x + scroll.x), static_cast<float>(first.y + scroll.y) };
+		viewportGeometryMeasured = true;
+	}
+
 	auto Edit::OnCreate(UINT /*unused*/, WPARAM /*unused*/, LPARAM lParam) -> Core::HandlerResult
 	{
 		const auto clientRect = GetClientRect();
@@ -900,9 +1283,12 @@ namespace PGUI::UI::Controls
 			0x1000 | 0x2000, nullptr);
 		textServices->OnTxInPlaceActivate(nullptr);
 
+		textServices->TxSendMessage(EM_SETEVENTMASK, NULL, ENM_CHANGE, nullptr);
+
 		const auto* createStruct = std::bit_cast<LPCREATESTRUCTW>(lParam);
 
 		textServices->TxSetText(createStruct->lpszName);
+		ResyncDocument();
 
 		textServices->TxSendMessage(EM_SETZOOM, GetDPI(), PGUI::Core::DEFAULT_SCREEN_DPI, nullptr);
 
@@ -928,7 +1314,36 @@ namespace PGUI::UI::Controls
 		bounds.right -= verticalScrollBar->IsVisible() ? ScaleByDPI(20) : 0;
 		bounds.bottom -= horizontalScrollBar->IsVisible() ? ScaleByDPI(20) : 0;
 
-		textServices->TxDrawD2D(g, std::bit_cast<LPRECTL>(&bounds), nullptr, TXTVIEW_ACTIVE);
+		if (viewportRendering)
+		{
+			EnsureDocumentSynced();
+			if (!viewportGeometryMeasured)
+			{
+				MeasureViewportGeometry();
+			}
+
+			const RectF viewRect{ bounds };
+			const PointF origin{ viewRect.left + viewportOrigin.x, viewRect.top + viewportOrigin.y };
+
+			viewport.Layout(GetScrollPosition(), viewRect.Size());
+
+			g.PushAxisAlignedClip(viewRect, g.GetAntialiasMode());
+
+			if (const auto selection = GetSelection();
+				selection.min < selection.max)
+			{
+				viewport.DrawSelection(g, origin,
+					static_cast<std::size_t>(selection.min), static_cast<std::size_t>(selection.max), selectionBrush);
+			}
+			viewport.Draw(g, origin, textBrush);
+
+			g.PopAxisAlignedClip();
+		}
+		else
+		{
+			RECT updateRect = GetDirtyRect();
+			textServices->TxDrawD2D(g, std::bit_cast<LPRECTL>(&bounds), std::bit_cast<LPRECTL>(&updateRect), TXTVIEW_ACTIVE);
+		}
 
 		if (textHost.caretRenderTarget && showCaret)
 		{
@@ -1280,6 +1695,22 @@ namespace PGUI::UI::Controls
 		{
 			case EN_CHANGE:
 			{
+				// Nothing may be thrown back into the text services, the document is read again whole when next used
+				try
+				{
+					parentWindow->SyncDocument();
+				}
+				catch (const Core::PGUIException& exception)
+				{
+					HR_L(exception.GetErrorCode());
+					parentWindow->documentNeedsResync = true;
+				}
+				catch (const std::bad_alloc&)
+				{
+					HR_L(E_OUTOFMEMORY);
+					parentWindow->documentNeedsResync = true;
+				}
+
 				const auto* changeNotify = std::bit_cast<CHANGENOTIFY*>(data);
 				parentWindow->changedEvent.Emit(
 					static_cast<ChangeEventType>(changeNotify->dwChangeType));
@@ -1,6 +1,7 @@
 #include "ui/controls/Header.hpp"
 
 #include "ui/Colors.hpp"
+#include "ui/TextFormatCache.hpp"
 #include "ui/UIColors.hpp"
 
 #include <algorithm>
@@ -85,7 +86,7 @@ namespace PGUI::UI::Controls
 		TextFormat tf) noexcept :
 		HeaderItem{ width },
 		text{ text },
-		colors{std::move( colors )}, textFormat{std::move( tf )}
+		colors{std::move( colors )}, textFormat{ TextFormatCache::GetInstance().Intern(tf) }
 	{
 		WidthChangedEvent().Subscribe([this]()
 		{
@@ -94,26 +95,34 @@ namespace PGUI::UI::Controls
 
 		StateChangedEvent().Subscribe(BindMemberFunc(&HeaderTextItem::OnStateChanged, this));
 	}
+	HeaderTextItem::HeaderTextItem(std::wstring_view text,
+		long width,
+		ThemeColorsGetter _themeColors,
+		TextFormat tf) noexcept :
+		HeaderTextItem{ text, width, _themeColors(), std::move(tf) }
+	{
+		themeColors = _themeColors;
+	}
 
 	void HeaderTextItem::SetTextFormat(TextFormat _textFormat) noexcept
 	{
-		textFormat = std::move(_textFormat);
+		textFormat = TextFormatCache::GetInstance().Intern(_textFormat);
 		InitTextLayout();
 	}
 
 	void HeaderTextItem::InitTextLayout()
 	{
 		auto height = GetHeaderWindow()->GetClientSize().cy;
-		textLayout = TextLayout{ text, textFormat, 
+		textLayout = TextLayoutCache::GetInstance().Get(text, textFormat,
 			SizeF {
 				static_cast<float>(GetWidth()),
 				static_cast<float>(height) 
 			}
-		};
+		);
 		textBrush.ReleaseBrush();
 	}
 
-	void HeaderTextItem::OnStateChanged() noexcept
+	void HeaderTextItem::SetStateBrushes() noexcept
 	{
 		using enum HeaderItemState;
 		switch (GetState())
@@ -137,10 +146,23 @@ namespace PGUI::UI::Controls
 				break;
 			}
 		}
-		DiscardDeviceResources(Graphics::Graphics{ nullptr });
+	}
+
+	void HeaderTextItem::OnStateChanged() noexcept
+	{
+		SetStateBrushes();
 		Invalidate();
 	}
 
+	void HeaderTextItem::OnThemeChanged()
+	{
+		if (themeColors != nullptr)
+		{
+			colors = themeColors();
+			SetStateBrushes();
+		}
+	}
+
 	void HeaderTextItem::Create()
 	{
 		if (!textFormat)
@@ -156,7 +178,7 @@ namespace PGUI::UI::Controls
 		g.SetTransform(GetHeaderWindow()->GetDpiScaleTransform(renderRect.Center()));
 		
 		g.FillRect(renderRect, backgroundBrush);
-		g.DrawTextLayout(renderRect.TopLeft(), textLayout, textBrush);
+		g.DrawTextLayout(renderRect.TopLeft() + textLayout.offset, textLayout.textLayout, textBrush);
 
 		g.SetTransform(prevTransform);
 	}
@@ -207,6 +229,26 @@ namespace PGUI::UI::Controls
 		RegisterMessageHandler(WM_SETCURSOR, &Header::OnSetCursor);
 		RegisterMessageHandler(WM_SIZE, &Header::OnSize);
 
+		ApplyThemeColors();
+		themeChangedConnection = UIColors::ThemeChangedEvent().Subscribe(
+			BindMemberFunc(&Header::OnThemeChanged, this), Core::EventDelivery::UIThread);
+	}
+
+	void Header::SetSeparatorBrush(const Brush& _separatorBrush) noexcept
+	{
+		followsTheme = false;
+		separatorBrush.SetParameters(_separatorBrush.GetParameters());
+		Invalidate();
+	}
+	void Header::SetBackgroundBrush(const Brush& _backgroundBrush) noexcept
+	{
+		followsTheme = false;
+		backgroundBrush.SetParameters(_backgroundBrush.GetParameters());
+		Invalidate();
+	}
+
+	void Header::ApplyThemeColors() noexcept
+	{
 		if (UIColors::IsDarkMode())
 		{
 			separatorBrush.SetParameters(RGBA{ 0x272727 });
@@ -219,14 +261,19 @@ namespace PGUI::UI::Controls
 		}
 	}
 
-	void Header::SetSeparatorBrush(const Brush& _separatorBrush) noexcept
+	void Header::OnThemeChanged() noexcept
 	{
-		separatorBrush.SetParameters(_separatorBrush.GetParameters());
-		Invalidate();
-	}
-	void Header::SetBackgroundBrush(const Brush& _backgroundBrush) noexcept
-	{
-		backgroundBrush.SetParameters(_backgroundBrush.GetParameters());
+		if (followsTheme)
+		{
+			ApplyThemeColors();
+		}
+
+		// One subscription for the whole header, the items only swap their colors and it repaints once
+		std::ranges::for_each(headerItems, [](const auto& item)
+		{
+			item->OnThemeChanged();
+		});
+
 		Invalidate();
 	}
 
@@ -1,29 +1,56 @@
 #include "ui/controls/ListView.hpp"
 
 #include "helpers/ScopedTimer.hpp"
+#include "ui/TextFormatCache.hpp"
 #include "ui/UIColors.hpp"
 #include "ui/Colors.hpp"
 
 #include <windowsx.h>
 #include <span>
 #include <ranges>
-#include <numeric>
 #include <algorithm>
+#include <cstdint>
+#include <limits>
 
 
 namespace PGUI::UI::Controls
 {
+	namespace
+	{
+		/**
+		* @brief Height of count rows of the same height, saturating instead of wrapping past the int64 range
+		*/
+		[[nodiscard]] auto GetUniformHeight(std::size_t count, long itemHeight) noexcept -> std::int64_t
+		{
+			if (itemHeight <= 0)
+			{
+				return 0;
+			}
+
+			constexpr auto maxHeight = std::numeric_limits<std::int64_t>::max();
+			if (count > static_cast<std::size_t>(maxHeight / itemHeight))
+			{
+				return maxHeight;
+			}
+			return static_cast<std::int64_t>(count) * itemHeight;
+		}
+	}
+
 	void ListViewItem::Invalidate() const noexcept
 	{
-		listView->Invalidate();
+		// A pooled item is bound while its row is being painted, that paint already draws its new state
+		if (!listView->isBindingItem)
+		{
+			listView->InvalidateItem(index);
+		}
 	}
 
 	#pragma region ListViewTextItem
 
-	ListViewTextItem::ListViewTextItem(std::wstring_view text, long height, TextFormat _textFormat) noexcept :
-		ListViewItem{ height },
-		text{ text }, textFormat{ _textFormat }
+	auto ListViewTextItem::GetListViewTextItemColors() noexcept -> ListViewTextItemColors
 	{
+		ListViewTextItemColors colors;
+
 		if (UIColors::IsDarkMode())
 		{
 			colors.normalText = Colors::Aliceblue;
@@ -32,7 +59,7 @@ namespace PGUI::UI::Controls
 			colors.hoverBackground = RGBA{ 0x202020 };
 			colors.pressedText = Colors::Aliceblue;
 			colors.pressedBackground = RGBA{ 0x191919 };
-			selectedIndicatorBrush.SetParameters(UIColors::GetAccentColor());
+			colors.selectedIndicator = UIColors::GetAccentColor();
 		}
 		else
 		{
@@ -42,9 +69,18 @@ namespace PGUI::UI::Controls
 			colors.hoverBackground = RGBA{ 0xffffff };
 			colors.pressedText = Colors::Black;
 			colors.pressedBackground = RGBA{ 0xe5e5e5 };
-			selectedIndicatorBrush.SetParameters(UIColors::GetAccentDark2Color());
+			colors.selectedIndicator = UIColors::GetAccentDark2Color();
 		}
 
+		return colors;
+	}
+
+	ListViewTextItem::ListViewTextItem(std::wstring_view text, long height, TextFormat _textFormat) noexcept :
+		ListViewItem{ height },
+		text{ text }, colors{ GetListViewTextItemColors() }, textFormat{ TextFormatCache::GetInstance().Intern(_textFormat) }
+	{
+		selectedIndicatorBrush.SetParameters(colors.selectedIndicator);
+
 		HeightChangedEvent().Subscribe([this]()
 		{
 			InitTextLayout();
@@ -55,26 +91,26 @@ namespace PGUI::UI::Controls
 
 	void ListViewTextItem::SetTextFormat(TextFormat _textFormat) noexcept
 	{
-		textFormat = _textFormat;
+		textFormat = TextFormatCache::GetInstance().Intern(_textFormat);
 		InitTextLayout();
 	}
 
 	void ListViewTextItem::InitTextLayout()
 	{
-		textLayout.Reset();
-
 		auto width = GetListViewWindow()->GetClientSize().cx;
 
-		textLayout = TextLayout{ text, textFormat,
+		textLayout = TextLayoutCache::GetInstance().Get(text, textFormat,
 			SizeF{
 				static_cast<float>(width),
 				static_cast<float>(GetHeight())
-		} };
+		});
 		textBrush.ReleaseBrush();
 	}
 
 	void ListViewTextItem::SetColors(const ListViewTextItemColors& _colors) noexcept
 	{
+		followsTheme = false;
+
 		colors = _colors;
 		selectedIndicatorBrush.SetParameters(colors.selectedIndicator);
 		DiscardDeviceResources(Graphics::Graphics{ nullptr });
@@ -110,7 +146,7 @@ namespace PGUI::UI::Controls
 				selectedIndicatorBrush);
 		}
 
-		g.DrawTextLayout(renderRect.TopLeft(), textLayout, textBrush);
+		g.DrawTextLayout(renderRect.TopLeft() + textLayout.offset, textLayout.textLayout, textBrush);
 	}
 	void ListViewTextItem::CreateDeviceResources(Graphics::Graphics g)
 	{
@@ -136,7 +172,7 @@ namespace PGUI::UI::Controls
 		selectedIndicatorBrush.ReleaseBrush();
 	}
 
-	void ListViewTextItem::OnStateChanged()
+	void ListViewTextItem::SetStateBrushes() noexcept
 	{
 		using enum ListViewItemState;
 		switch (GetState() & ~Selected)
@@ -163,10 +199,24 @@ namespace PGUI::UI::Controls
 			default:
 				break;
 		}
-		DiscardDeviceResources(Graphics::Graphics{ nullptr });
+	}
+
+	void ListViewTextItem::OnStateChanged()
+	{
+		SetStateBrushes();
 		Invalidate();
 	}
 
+	void ListViewTextItem::OnThemeChanged()
+	{
+		if (followsTheme)
+		{
+			colors = GetListViewTextItemColors();
+			selectedIndicatorBrush.SetParameters(colors.selectedIndicator);
+			SetStateBrushes();
+		}
+	}
+
 	void ListViewTextItem::OnDPIChanged(float dpiScale)
 	{
 		SetHeight(ScaleForDPI(GetHeight(), dpiScale));
@@ -178,6 +228,11 @@ namespace PGUI::UI::Controls
 		InitTextLayout();
 	}
 
+	void ListViewTextItem::OnBound()
+	{
+		InitTextLayout();
+	}
+
 	#pragma endregion
 
 	#pragma region ListView
@@ -196,24 +251,135 @@ namespace PGUI::UI::Controls
 
 		itemsChangedEvent.Subscribe(BindMemberFunc(&ListView::UpdateScrollBar, this));
 
-		if (UIColors::IsDarkMode())
+		ApplyThemeColors();
+		themeChangedConnection = UIColors::ThemeChangedEvent().Subscribe(
+			BindMemberFunc(&ListView::OnThemeChanged, this), Core::EventDelivery::UIThread);
+
+		for (const auto& item : listViewItems)
 		{
-			backgroundBrush.SetParameters(RGBA{ 0x181818 });
+			item->Create();
+		}
+	}
+
+	void ListView::SetDataSource(IListViewDataSource* _dataSource) noexcept
+	{
+		dataSource = _dataSource;
+
+		itemPool.clear();
+		virtualItemStates.clear();
+		allVirtualItemsSelected = false;
+		hoveringIndex = std::nullopt;
+		lastPressedIndex = std::nullopt;
+
+		if (dataSource)
+		{
+			virtualItemHeight = ScaleByDPI(dataSource->GetItemHeight());
+		}
+
+		itemsChangedEvent.Emit();
+		selectionChangedEvent.Emit();
+	}
+
+	void ListView::NotifyDataSourceChanged() noexcept
+	{
+		if (!dataSource)
+		{
+			return;
+		}
+
+		const auto itemCount = GetItemCount();
+		bool selectionChanged = false;
+
+		std::erase_if(virtualItemStates, [itemCount, &selectionChanged](const auto& pair)
+		{
+			if (pair.first < itemCount)
+			{
+				return false;
+			}
+			selectionChanged |= IsFlagSet(pair.second, ListViewItemState::Selected);
+			return true;
+		});
+
+		if (hoveringIndex.has_value() && *hoveringIndex >= itemCount)
+		{
+			hoveringIndex = std::nullopt;
+		}
+		if (lastPressedIndex.has_value() && *lastPressedIndex >= itemCount)
+		{
+			lastPressedIndex = std::nullopt;
+		}
+
+		for (auto& pooled : itemPool)
+		{
+			pooled.boundIndex.reset();
+		}
+
+		itemsChangedEvent.Emit();
+		if (selectionChanged)
+		{
+			selectionChangedEvent.Emit();
+		}
+	}
+
+	auto ListView::GetItemCount() const noexcept -> std::size_t
+	{
+		if (dataSource)
+		{
+			return dataSource->GetItemCount();
+		}
+		return listViewItems.size();
+	}
+
+	auto ListView::GetItemState(std::size_t index) const noexcept -> ListViewItemState
+	{
+		if (dataSource)
+		{
+			if (auto iter = virtualItemStates.find(index);
+				iter != virtualItemStates.end())
+			{
+				return iter->second;
+			}
+			return allVirtualItemsSelected ? ListViewItemState::Selected : ListViewItemState::Normal;
+		}
+		if (index < listViewItems.size())
+		{
+			return listViewItems.at(index)->GetState();
+		}
+		return ListViewItemState::Normal;
+	}
+
+	void ListView::SetItemState(std::size_t index, ListViewItemState state) noexcept
+	{
+		if (index >= GetItemCount())
+		{
+			return;
+		}
+
+		if (!dataSource)
+		{
+			listViewItems.at(index)->SetState(state);
+			return;
+		}
+
+		if (state == (allVirtualItemsSelected ? ListViewItemState::Selected : ListViewItemState::Normal))
+		{
+			virtualItemStates.erase(index);
 		}
 		else
 		{
-			backgroundBrush.SetParameters(Colors::White);
+			virtualItemStates[index] = state;
 		}
 
-		for (const auto& item : listViewItems)
+		if (auto item = GetRealizedItem(index);
+			item != nullptr)
 		{
-			item->Create();
+			item->SetState(state);
 		}
 	}
 
 	void ListView::RemoveItem(std::size_t index) noexcept
 	{
-		if (index >= listViewItems.size())
+		if (dataSource || index >= listViewItems.size())
 		{
 			return;
 		}
@@ -221,6 +387,7 @@ namespace PGUI::UI::Controls
 		bool wasSelected = listViewItems.at(index)->IsSelected();
 
 		listViewItems.erase(std::ranges::next(listViewItems.begin(), index));
+		RebuildHeightIndex();
 		UpdateScrollBar();
 		
 		if (wasSelected)
@@ -232,27 +399,40 @@ namespace PGUI::UI::Controls
 	void ListView::Clear() noexcept
 	{
 		listViewItems.clear();
+		heightIndex.Clear();
 		scrollBar->Show(false);
 		UpdateScrollBar();
 		selectionChangedEvent.Emit();
 	}
 	void ListView::ClearSelected() noexcept
 	{
+		if (dataSource)
+		{
+			return;
+		}
+
 		auto ret = std::ranges::remove_if(listViewItems, [](const auto& item) -> bool
 		{
 			return item->IsSelected();
 		});
 		listViewItems.erase(ret.begin(), ret.end());
+		RebuildHeightIndex();
 		UpdateScrollBar();
 		selectionChangedEvent.Emit();
 	}
 	void ListView::ClearUnselected() noexcept
 	{
+		if (dataSource)
+		{
+			return;
+		}
+
 		auto ret = std::ranges::remove_if(listViewItems, [](const auto& item) -> bool
 		{
 			return !item->IsSelected();
 		});
 		listViewItems.erase(ret.begin(), ret.end());
+		RebuildHeightIndex();
 		UpdateScrollBar();
 		selectionChangedEvent.Emit();
 	}
@@ -265,7 +445,14 @@ namespace PGUI::UI::Controls
 			return;
 		}
 
-		for (auto i : std::views::iota(0ULL, listViewItems.size()))
+		if (dataSource)
+		{
+			SetVirtualSelection(true);
+			selectionChangedEvent.Emit();
+			return;
+		}
+
+		for (auto i : std::views::iota(0ULL, GetItemCount()))
 		{
 			AddSelected(i);
 		}
@@ -273,7 +460,14 @@ namespace PGUI::UI::Controls
 	}
 	void ListView::DeselectAll() noexcept
 	{
-		for (auto i : std::views::iota(0ULL, listViewItems.size()))
+		if (dataSource)
+		{
+			SetVirtualSelection(false);
+			selectionChangedEvent.Emit();
+			return;
+		}
+
+		for (auto i : GetSelectedItemIndexes())
 		{
 			RemoveSelected(i);
 		}
@@ -283,6 +477,20 @@ namespace PGUI::UI::Controls
 	auto ListView::GetSelectedItems() const noexcept -> std::vector<ListViewItem*>
 	{
 		std::vector<ListViewItem*> selectedItems;
+
+		if (dataSource)
+		{
+			// Only the realized rows have an item to return
+			std::ranges::for_each(itemPool, [&selectedItems](const auto& pooled)
+			{
+				if (pooled.boundIndex.has_value() && pooled.item->IsSelected())
+				{
+					selectedItems.push_back(pooled.item.get());
+				}
+			});
+			return selectedItems;
+		}
+
 		std::ranges::for_each(listViewItems, [&selectedItems](const auto& item)
 		{
 			if (item->IsSelected())
@@ -296,8 +504,37 @@ namespace PGUI::UI::Controls
 
 	void ListView::SetBackgroundBrush(Brush& brush) noexcept
 	{
+		followsTheme = false;
 		backgroundBrush.SetParameters(brush.GetParameters());
 	}
+
+	void ListView::ApplyThemeColors() noexcept
+	{
+		if (UIColors::IsDarkMode())
+		{
+			backgroundBrush.SetParameters(RGBA{ 0x181818 });
+		}
+		else
+		{
+			backgroundBrush.SetParameters(Colors::White);
+		}
+	}
+
+	void ListView::OnThemeChanged() noexcept
+	{
+		if (followsTheme)
+		{
+			ApplyThemeColors();
+		}
+
+		// One subscription for the whole list, the items only swap their colors and it repaints once
+		ForEachItem([](auto& item)
+		{
+			item.OnThemeChanged();
+		});
+
+		Invalidate();
+	}
 	void ListView::SetSelectionMode(SelectionMode _selectionMode) noexcept
 	{
 		if (selectionMode == _selectionMode)
@@ -306,7 +543,12 @@ namespace PGUI::UI::Controls
 		}
 
 		if (auto selectedItemIndex = GetSelectedItemIndex();
-			_selectionMode == SelectionMode::Single && selectedItemIndex.has_value())
+			_selectionMode == SelectionMode::Single && dataSource && selectedItemIndex.has_value())
+		{
+			SetVirtualSelection(false);
+			AddSelected(*selectedItemIndex);
+		}
+		else if (_selectionMode == SelectionMode::Single && selectedItemIndex.has_value())
 		{
 			auto selectedItemIndexes = GetSelectedItemIndexes();
 			std::ranges::for_each(
@@ -314,8 +556,7 @@ namespace PGUI::UI::Controls
 				selectedItemIndexes.end(),
 				[this](auto index)
 			{
-				const auto& item = listViewItems.at(index);
-				item->SetState(item->GetState() & ~ListViewItemState::Selected);
+				RemoveSelected(index);
 			});
 		}
 
@@ -333,9 +574,9 @@ namespace PGUI::UI::Controls
 			g.CreateBrush(backgroundBrush);
 		}
 
-		std::ranges::for_each(listViewItems, [g](const auto& listViewItem)
+		ForEachItem([g](auto& listViewItem)
 		{
-			listViewItem->CreateDeviceResources(g);
+			listViewItem.CreateDeviceResources(g);
 		});
 	}
 	void ListView::DiscardDeviceResources()
@@ -344,9 +585,9 @@ namespace PGUI::UI::Controls
 
 		backgroundBrush.ReleaseBrush();
 
-		std::ranges::for_each(listViewItems, [g](const auto& listViewItem)
+		ForEachItem([g](auto& listViewItem)
 		{
-			listViewItem->DiscardDeviceResources(g);
+			listViewItem.DiscardDeviceResources(g);
 		});
 	}
 
@@ -355,27 +596,62 @@ namespace PGUI::UI::Controls
 		scrollBar->SetClip(GetClip().GetParameters());
 	}
 
-	auto ListView::GetHoveredListViewItemIndex(long yPos) const noexcept -> std::optional<std::size_t>
+	auto ListView::GetHoveredListViewItemIndex(std::int64_t yPos) const noexcept -> std::optional<std::size_t>
 	{
-		long totalHeight = 0;
-
-		for (const auto& [index, listViewItem] : listViewItems | std::views::enumerate)
+		if (dataSource)
 		{
-			auto height = listViewItem->GetHeight();
-
-			if (totalHeight <= yPos &&
-				yPos <= totalHeight + height)
+			if (yPos < 0 || virtualItemHeight <= 0)
+			{
+				return std::nullopt;
+			}
+			if (auto index = static_cast<std::size_t>(yPos / virtualItemHeight);
+				index < GetItemCount())
 			{
 				return index;
 			}
+			return std::nullopt;
+		}
 
-			totalHeight += height;
+		if (yPos > heightIndex.Total())
+		{
+			return std::nullopt;
+		}
+		if (auto index = heightIndex.Find(static_cast<long>(yPos));
+			index < heightIndex.Size())
+		{
+			return index;
 		}
 
 		return std::nullopt;
 	}
 	auto ListView::GetSelectedItemIndex() const noexcept -> std::optional<std::size_t>
 	{
+		if (dataSource)
+		{
+			if (allVirtualItemsSelected)
+			{
+				// Only rows with an entry can be deselected, so one is found within the entry count
+				for (std::size_t index = 0; index < GetItemCount(); index++)
+				{
+					if (IsIndexSelected(index))
+					{
+						return index;
+					}
+				}
+				return std::nullopt;
+			}
+
+			std::optional<std::size_t> selectedItemIndex;
+			for (const auto& [index, state] : virtualItemStates)
+			{
+				if (IsFlagSet(state, ListViewItemState::Selected))
+				{
+					selectedItemIndex = std::min(index, selectedItemIndex.value_or(index));
+				}
+			}
+			return selectedItemIndex;
+		}
+
 		if (auto iter = std::ranges::find_if(listViewItems, [](const auto& item)
 		{
 			return item->IsSelected();
@@ -388,6 +664,32 @@ namespace PGUI::UI::Controls
 	auto ListView::GetSelectedItemIndexes() const noexcept -> std::vector<std::size_t>
 	{
 		std::vector<std::size_t> selectedItemIndexes;
+
+		if (dataSource)
+		{
+			if (allVirtualItemsSelected)
+			{
+				for (auto index : std::views::iota(0ULL, GetItemCount()))
+				{
+					if (IsIndexSelected(index))
+					{
+						selectedItemIndexes.push_back(index);
+					}
+				}
+				return selectedItemIndexes;
+			}
+
+			for (const auto& [index, state] : virtualItemStates)
+			{
+				if (IsFlagSet(state, ListViewItemState::Selected))
+				{
+					selectedItemIndexes.push_back(index);
+				}
+			}
+			std::ranges::sort(selectedItemIndexes);
+			return selectedItemIndexes;
+		}
+
 		for (const auto& [index, item] : listViewItems | std::views::enumerate)
 		{
 			if (item->IsSelected())
@@ -400,26 +702,73 @@ namespace PGUI::UI::Controls
 
 	auto ListView::IsIndexSelected(std::size_t index) const noexcept -> bool
 	{
-		if (index <= listViewItems.size())
+		return IsFlagSet(GetItemState(index), ListViewItemState::Selected);
+	}
+
+	auto ListView::CalculateListViewItemHeightUpToIndex(std::size_t index) const noexcept -> std::int64_t
+	{
+		if (dataSource)
 		{
-			return listViewItems.at(index)->IsSelected();
+			return GetUniformHeight(index, virtualItemHeight);
 		}
-		return false;
+
+		return heightIndex.PrefixSum(std::min(index, heightIndex.Size()));
 	}
+	void ListView::InvalidateItem(std::size_t index) const noexcept
+	{
+		if (index >= GetItemCount())
+		{
+			return;
+		}
+
+		const auto itemHeight = dataSource ? virtualItemHeight : heightIndex.Get(index);
+		const auto top = static_cast<float>(
+			CalculateListViewItemHeightUpToIndex(index) - scrollBar->GetScrollPos());
 
-	auto ListView::CalculateListViewItemHeightUpToIndex(std::size_t index) const noexcept -> long
+		Invalidate(RectF{
+			0, top,
+			static_cast<float>(GetClientSize().cx), top + static_cast<float>(itemHeight)
+		});
+	}
+	auto ListView::GetTotalListViewItemHeight() const noexcept -> std::int64_t
 	{
-		return std::accumulate(
-			listViewItems.cbegin(), std::next(listViewItems.cbegin(), index), 0,
-			[](long y, const auto& item) { return y + item->GetHeight(); }
-		);
+		if (dataSource)
+		{
+			return GetUniformHeight(GetItemCount(), virtualItemHeight);
+		}
+
+		return heightIndex.Total();
+	}
+
+	void ListView::ScrollToIndex(std::size_t index) noexcept
+	{
+		if (index >= GetItemCount())
+		{
+			return;
+		}
+
+		scrollBar->ScrollTo(CalculateListViewItemHeightUpToIndex(index));
 	}
-	auto ListView::GetTotalListViewItemHeight() const noexcept -> long
+
+	void ListView::OnItemHeightChanged(const ListViewItem& item) noexcept
 	{
-		return std::accumulate(
-			listViewItems.cbegin(), listViewItems.cend(), 0,
-			[](long y, const auto& item) { return y + item->GetHeight(); }
-		);
+		if (item.index < heightIndex.Size())
+		{
+			heightIndex.Set(item.index, item.GetHeight());
+		}
+	}
+	void ListView::RebuildHeightIndex() noexcept
+	{
+		std::vector<long> heights;
+		heights.reserve(listViewItems.size());
+
+		for (const auto& [index, item] : listViewItems | std::views::enumerate)
+		{
+			item->index = static_cast<std::size_t>(index);
+			heights.push_back(item->GetHeight());
+		}
+
+		heightIndex.Assign(heights);
 	}
 
 	void ListView::Select(std::size_t index) noexcept
@@ -460,43 +809,128 @@ namespace PGUI::UI::Controls
 
 	void ListView::SetStateWithSelected(std::size_t index, ListViewItemState state) noexcept
 	{
-		if (index < listViewItems.size())
-		{
-			listViewItems.at(index)->SetState(state | ListViewItemState::Selected);
-		}
+		SetItemState(index, state | ListViewItemState::Selected);
 	}
 	void ListView::AddStateIfSelected(std::size_t index, ListViewItemState state) noexcept
 	{
-		if (index >= listViewItems.size())
+		if (index >= GetItemCount())
 		{
 			return;
 		}
 
-		if (const auto& item = listViewItems.at(index);
-			IsFlagSet(item->GetState(), ListViewItemState::Selected))
+		if (IsIndexSelected(index))
 		{
-			item->SetState(ListViewItemState::Selected | state);
+			SetItemState(index, ListViewItemState::Selected | state);
 		}
 		else
 		{
-			item->SetState(state);
+			SetItemState(index, state);
 		}
 	}
 
 	void ListView::AddSelected(std::size_t index) noexcept
 	{
-		if (index < listViewItems.size())
+		SetItemState(index, GetItemState(index) | ListViewItemState::Selected);
+	}
+	void ListView::RemoveSelected(std::size_t index) noexcept
+	{
+		SetItemState(index, GetItemState(index) & ~ListViewItemState::Selected);
+	}
+
+	auto ListView::GetRealizedItem(std::size_t index) const noexcept -> ListViewItem*
+	{
+		if (auto iter = std::ranges::find(itemPool, std::optional{ index }, &PooledItem::boundIndex);
+			iter != itemPool.end())
 		{
-			const auto& item = listViewItems.at(index);
-			item->SetState(item->GetState() | ListViewItemState::Selected);
+			return iter->item.get();
 		}
+		return nullptr;
 	}
-	void ListView::RemoveSelected(std::size_t index) noexcept
+	auto ListView::RealizeItem(std::size_t index) -> ListViewItem*
 	{
-		if (index < listViewItems.size())
+		if (auto item = GetRealizedItem(index);
+			item != nullptr)
+		{
+			return item;
+		}
+
+		auto iter = std::ranges::find(itemPool, std::optional<std::size_t>{ }, &PooledItem::boundIndex);
+		if (iter == itemPool.end())
+		{
+			auto item = dataSource->CreateItem();
+			item->listView = this;
+			item->Create();
+
+			itemPool.push_back(PooledItem{ std::move(item), std::nullopt });
+			iter = std::prev(itemPool.end());
+		}
+
+		auto& item = *iter->item;
+		item.index = index;
+		iter->boundIndex = index;
+
+		isBindingItem = true;
+		try
+		{
+			dataSource->BindItem(item, index);
+
+			if (item.GetHeight() != virtualItemHeight)
+			{
+				item.SetHeight(virtualItemHeight);
+			}
+			item.OnBound();
+			item.SetState(GetItemState(index));
+		}
+		catch (...)
+		{
+			isBindingItem = false;
+			throw;
+		}
+		isBindingItem = false;
+
+		return &item;
+	}
+	void ListView::RecycleItemsOutside(std::size_t first, std::size_t last) noexcept
+	{
+		for (auto& pooled : itemPool)
+		{
+			if (pooled.boundIndex.has_value() &&
+				(*pooled.boundIndex < first || *pooled.boundIndex >= last))
+			{
+				pooled.boundIndex.reset();
+			}
+		}
+	}
+	void ListView::SetVirtualSelection(bool selectAll) noexcept
+	{
+		allVirtualItemsSelected = selectAll;
+
+		for (auto& [index, state] : virtualItemStates)
+		{
+			state = selectAll ? state | ListViewItemState::Selected : state & ~ListViewItemState::Selected;
+		}
+		std::erase_if(virtualItemStates, [selectAll](const auto& pair)
+		{
+			return pair.second == (selectAll ? ListViewItemState::Selected : ListViewItemState::Normal);
+		});
+
+		for (const auto& pooled : itemPool)
+		{
+			if (pooled.boundIndex.has_value())
+			{
+				pooled.item->SetState(GetItemState(*pooled.boundIndex));
+			}
+		}
+	}
+	void ListView::ForEachItem(const std::function<void(ListViewItem&)>& func) const
+	{
+		for (const auto& item : listViewItems)
 		{
-			const auto& item = listViewItems.at(index);
-			item->SetState(item->GetState() & ~ListViewItemState::Selected);
+			func(*item);
+		}
+		for (const auto& pooled : itemPool)
+		{
+			func(*pooled.item);
 		}
 	}
 
@@ -514,7 +948,7 @@ namespace PGUI::UI::Controls
 		}
 		scrollBar->Show();
 
-		scrollBar->SetMaxScroll(static_cast<std::int64_t>(totalItemHeight - clientSize.cy));
+		scrollBar->SetMaxScroll(totalItemHeight - clientSize.cy);
 		scrollBar->SetPageSize(clientSize.cy);
 		scrollBar->SetScrollMult();
 		scrollBar->SetScrollPos(scrollBar->GetScrollPos());
@@ -543,11 +977,24 @@ namespace PGUI::UI::Controls
 	}
 	void ListView::SelectExtended(std::size_t index, bool shiftPressed, bool ctrlPressed) noexcept
 	{
-		auto selectedItemIndexes = GetSelectedItemIndexes();
-
 		if (!lastPressedIndex.has_value() ||
 			!(shiftPressed || ctrlPressed))
 		{
+			if (dataSource && allVirtualItemsSelected)
+			{
+				// Deselecting row by row would walk every row, the selection is dropped as a whole instead
+				const auto wasSelected = IsIndexSelected(index);
+				const auto clickedState = GetItemState(index) & ~ListViewItemState::Selected;
+
+				SetVirtualSelection(false);
+				virtualItemStates.clear();
+				SetItemState(index, wasSelected ? clickedState : clickedState | ListViewItemState::Selected);
+
+				selectionChangedEvent.Emit();
+				return;
+			}
+
+			const auto selectedItemIndexes = GetSelectedItemIndexes();
 			std::ranges::for_each(selectedItemIndexes, [this](const auto& i)
 			{
 				RemoveSelected(i);
@@ -569,14 +1016,7 @@ namespace PGUI::UI::Controls
 				return;
 			}
 
-			std::ranges::for_each(selectedItemIndexes, [this, index](const auto& i)
-			{
-				if (i != index)
-				{
-					AddSelected(i);
-				}
-			});
-
+			// The rows already selected stay selected
 			AddSelected(index);
 			selectionChangedEvent.Emit();
 		}
@@ -597,9 +1037,11 @@ namespace PGUI::UI::Controls
 
 	auto ListView::OnDPIChange(float dpiScale, RectI suggestedRect) noexcept -> Core::HandlerResult
 	{
-		std::ranges::for_each(listViewItems, [dpiScale](const auto& item)
+		virtualItemHeight = ScaleForDPI(virtualItemHeight, dpiScale);
+
+		ForEachItem([dpiScale](auto& item)
 		{
-			item->OnDPIChanged(dpiScale);
+			item.OnDPIChanged(dpiScale);
 		});
 
 		return Window::OnDPIChange(dpiScale, suggestedRect);
@@ -628,29 +1070,37 @@ namespace PGUI::UI::Controls
 	{
 		BeginDraw();
 
-		long totalHeight = 0;
+		std::int64_t totalHeight = 0;
 		long width = GetClientSize().cx;
-		long height = GetClientSize().cy;
 		auto scrollPos = scrollBar->GetScrollPos();
+		const RectL dirtyRect = GetDirtyRect();
 
 		auto g = GetGraphics();
 
 		g.Clear(backgroundBrush);
-		
+
+		if (dataSource)
+		{
+			PaintVirtualItems(g);
+
+			EndDraw();
+
+			return 0;
+		}
+
 		g.SetTransform(
 			D2D1::Matrix3x2F::Translation(
 				SizeF{ 0, -static_cast<float>(scrollPos) }
 			)
 		);
 
-		for (const auto& listViewItem : listViewItems)
+		// Only items overlapping the dirty rect are drawn
+		const auto firstVisibleIndex = heightIndex.Find(static_cast<long>(scrollPos) + dirtyRect.top);
+		totalHeight = CalculateListViewItemHeightUpToIndex(firstVisibleIndex);
+
+		for (const auto& listViewItem : listViewItems | std::views::drop(firstVisibleIndex))
 		{
-			if (totalHeight < scrollPos - height)
-			{
-				totalHeight += listViewItem->GetHeight();
-				continue;
-			}
-			else if (totalHeight > scrollPos + height)
+			if (totalHeight > scrollPos + dirtyRect.bottom)
 			{
 				break;
 			}
@@ -677,6 +1127,45 @@ namespace PGUI::UI::Controls
 
 		return 0;
 	}
+	void ListView::PaintVirtualItems(Graphics::Graphics g)
+	{
+		if (virtualItemHeight <= 0)
+		{
+			return;
+		}
+
+		const auto itemCount = GetItemCount();
+		const auto width = GetClientSize().cx;
+		const auto height = GetClientSize().cy;
+		const auto scrollPos = scrollBar->GetScrollPos();
+
+		const auto first = std::min(static_cast<std::size_t>(scrollPos / virtualItemHeight), itemCount);
+		const auto last = std::min(static_cast<std::size_t>((scrollPos + height) / virtualItemHeight) + 1, itemCount);
+
+		RecycleItemsOutside(first, last);
+
+		for (auto index : std::views::iota(first, last))
+		{
+			auto listViewItem = RealizeItem(index);
+			listViewItem->CreateDeviceResources(g);
+
+			// Relative to the scroll position, a float can't place rows millions of pixels down
+			auto top = static_cast<float>(CalculateListViewItemHeightUpToIndex(index) - scrollPos);
+			auto itemRect = RectF{
+				0,
+				top,
+				static_cast<float>(width - 20 * IsWindowVisible(scrollBar->Hwnd())),
+				top + static_cast<float>(virtualItemHeight)
+			};
+
+			g.PushAxisAlignedClip(itemRect, g.GetAntialiasMode());
+
+			listViewItem->Render(g, itemRect);
+
+			g.PopAxisAlignedClip();
+		}
+	}
+
 	auto ListView::OnMouseWheel(UINT /*unused*/, WPARAM wParam, LPARAM /*unused*/) -> Core::HandlerResult
 	{
 		if (scrollBar->IsVisible())
@@ -694,40 +1183,47 @@ namespace PGUI::UI::Controls
 		tme.hwndTrack = Hwnd();
 		TrackMouseEvent(&tme);
 
-		PointL mousePos = MAKEPOINTS(lParam);
-		mousePos.y += static_cast<long>(scrollBar->GetScrollPos());
+		const PointL mousePos = MAKEPOINTS(lParam);
+		const auto contentY = mousePos.y + scrollBar->GetScrollPos();
 
 		const auto prevHoveredItemIndex = hoveringIndex;
-		hoveringIndex = GetHoveredListViewItemIndex(mousePos.y);
+		hoveringIndex = GetHoveredListViewItemIndex(contentY);
 
-		if (mousePos.y > GetTotalListViewItemHeight())
+		if (contentY > GetTotalListViewItemHeight())
 		{
 			if (prevHoveredItemIndex.has_value())
 			{
 				AddStateIfSelected(*prevHoveredItemIndex, ListViewItemState::Normal);
-				Invalidate();
+				InvalidateItem(*prevHoveredItemIndex);
 			}
 			return 0;
 		}
 
-		hoveringIndex = GetHoveredListViewItemIndex(mousePos.y);
+		hoveringIndex = GetHoveredListViewItemIndex(contentY);
 
 		if (prevHoveredItemIndex.has_value() &&
-			prevHoveredItemIndex < listViewItems.size() &&
-			*prevHoveredItemIndex != *hoveringIndex)
+			prevHoveredItemIndex < GetItemCount() &&
+			prevHoveredItemIndex != hoveringIndex)
 		{
 			AddStateIfSelected(*prevHoveredItemIndex, ListViewItemState::Normal);
 		}
 		if (hoveringIndex.has_value() &&
-			hoveringIndex < listViewItems.size() &&
-			!IsFlagSet(listViewItems.at(*hoveringIndex)->GetState(), ListViewItemState::Pressed))
+			hoveringIndex < GetItemCount() &&
+			!IsFlagSet(GetItemState(*hoveringIndex), ListViewItemState::Pressed))
 		{
 			AddStateIfSelected(*hoveringIndex, ListViewItemState::Hover);
 		}
 
 		if (prevHoveredItemIndex != hoveringIndex)
 		{
-			Invalidate();
+			if (prevHoveredItemIndex.has_value())
+			{
+				InvalidateItem(*prevHoveredItemIndex);
+			}
+			if (hoveringIndex.has_value())
+			{
+				InvalidateItem(*hoveringIndex);
+			}
 		}
 
 		return 0;
@@ -737,7 +1233,7 @@ namespace PGUI::UI::Controls
 		if (hoveringIndex.has_value())
 		{
 			AddStateIfSelected(*hoveringIndex, ListViewItemState::Pressed);
-			Invalidate();
+			InvalidateItem(*hoveringIndex);
 		}
 
 		return 0;
@@ -750,8 +1246,7 @@ namespace PGUI::UI::Controls
 		{
 			return 0;
 		}
-		if (const auto& item = listViewItems.at(*hoveringIndex);
-			!IsFlagSet(item->GetState(), Pressed))
+		if (!IsFlagSet(GetItemState(*hoveringIndex), Pressed))
 		{
 			return 0;
 		}
@@ -794,7 +1289,7 @@ namespace PGUI::UI::Controls
 		if (hoveringIndex.has_value())
 		{
 			AddStateIfSelected(*hoveringIndex, ListViewItemState::Normal);
-			Invalidate();
+			InvalidateItem(*hoveringIndex);
 		}
 		hoveringIndex = std::nullopt;
 
@@ -804,9 +1299,9 @@ namespace PGUI::UI::Controls
 	{
 		UpdateScrollBar();
 
-		std::ranges::for_each(listViewItems, [](const auto& item)
+		ForEachItem([](auto& item)
 		{
-			item->OnListViewSizeChanged();
+			item.OnListViewSizeChanged();
 		});
 
 		return 0;
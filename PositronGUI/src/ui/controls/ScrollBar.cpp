@@ -31,6 +31,13 @@ namespace PGUI::UI::Controls
 		RegisterMessageHandler(WM_SIZING, &ScrollBar::OnSizing);
 		RegisterMessageHandler(WM_NCCALCSIZE, &ScrollBar::OnNCCalcSize);
 
+		ApplyThemeColors();
+		themeChangedConnection = UIColors::ThemeChangedEvent().Subscribe(
+			PGUI::BindMemberFunc(&ScrollBar::OnThemeChanged, this), Core::EventDelivery::UIThread);
+	}
+
+	void ScrollBar::ApplyThemeColors() noexcept
+	{
 		if (UIColors::IsDarkMode())
 		{
 			thumbBrush.SetParameters(RGBA{ 0x555555 });
@@ -43,6 +50,41 @@ namespace PGUI::UI::Controls
 		}
 	}
 
+	void ScrollBar::OnThemeChanged() noexcept
+	{
+		if (!followsTheme)
+		{
+			return;
+		}
+
+		ApplyThemeColors();
+		if (upButton != nullptr)
+		{
+			upButton->SetColors(GetButtonColors());
+			downButton->SetColors(GetButtonColors());
+		}
+		Invalidate();
+	}
+
+	auto ScrollBar::GetButtonColors() const noexcept -> TextButton::TextButtonColors
+	{
+		auto colors = TextButton::GetTextButtonColors();
+
+		colors.normalBackground = backgroundBrush.GetParameters();
+		
+		colors.hoverBackground = backgroundBrush.GetParameters();
+		std::get<RGBA>(colors.hoverBackground).Lighten(0.02F);
+
+		colors.clickedBackground = backgroundBrush.GetParameters();
+		std::get<RGBA>(colors.clickedBackground).Darken(0.02F);
+
+		colors.normalText = thumbBrush.GetParameters();
+		colors.hoverText = thumbBrush.GetParameters();
+		colors.clickedText = thumbBrush.GetParameters();
+
+		return colors;
+	}
+
 	void ScrollBar::SetPageSize(std::int64_t _pageSize) noexcept
 	{
 		if (_pageSize < GetScrollRange())
@@ -109,11 +151,13 @@ namespace PGUI::UI::Controls
 
 	void ScrollBar::SetThumbBrush(Brush& brush)
 	{
+		followsTheme = false;
 		thumbBrush.SetParameters(brush.GetParameters());
 		Invalidate();
 	}
 	void ScrollBar::SetBackgroundBrush(Brush& brush)
 	{
+		followsTheme = false;
 		backgroundBrush.SetParameters(brush.GetParameters());
 		Invalidate();
 	}
@@ -345,19 +389,7 @@ namespace PGUI::UI::Controls
 
 		auto size = GetClientSizeWithoutDPI();
 
-		auto colors = TextButton::GetTextButtonColors();
-
-		colors.normalBackground = backgroundBrush.GetParameters();
-		
-		colors.hoverBackground = backgroundBrush.GetParameters();
-		std::get<RGBA>(colors.hoverBackground).Lighten(0.02F);
-
-		colors.clickedBackground = backgroundBrush.GetParameters();
-		std::get<RGBA>(colors.clickedBackground).Darken(0.02F);
-
-		colors.normalText = thumbBrush.GetParameters();
-		colors.hoverText = thumbBrush.GetParameters();
-		colors.clickedText = thumbBrush.GetParameters();
+		const auto colors = GetButtonColors();
 		
 		Core::WindowCreateParams upButtonParams{ L"▲", { 0, 0 }, { size.cx, static_cast<int>(buttonSize) }, NULL };
 		Core::WindowCreateParams downButtonParams{ L"▼", 
@@ -1,8 +1,15 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <new>
 #include <utility>
+#include <windowsx.h>
+#include <Shlwapi.h>
 
 #include "ui/controls/StaticImage.hpp"
 
 #include "ui/bmp/Frame.hpp"
+#include "ui/bmp/AsyncImageDecoder.hpp"
 #include "ui/Color.hpp"
 #include "helpers/HelperFunctions.hpp"
 #include "factories/WICFactory.hpp"
@@ -10,9 +17,17 @@
  
 namespace PGUI::UI::Controls
 {
-	StaticImage::StaticImage(std::wstring_view fileName) : 
-		StaticImage{ Bmp::BitmapDecoder{ fileName } }
+	StaticImage::StaticImage(std::wstring_view fileName) :
+		UIComponent{ Core::WindowClass::Create(L"StaticImage_UIComponent") },
+		filePath{ fileName }
 	{
+		RegisterMessageHandler(WM_CREATE, &StaticImage::OnCreateFromFile);
+		RegisterMessageHandler(WM_SIZE, &StaticImage::OnSize);
+		RegisterMessageHandler(WM_PAINT, &StaticImage::OnPaint);
+		RegisterMessageHandler(WM_MOUSEWHEEL, &StaticImage::OnMouseWheel);
+		RegisterMessageHandler(WM_LBUTTONDOWN, &StaticImage::OnLButtonDown);
+		RegisterMessageHandler(WM_LBUTTONUP, &StaticImage::OnLButtonUp);
+		RegisterMessageHandler(WM_MOUSEMOVE, &StaticImage::OnMouseMove);
 	}
 
 	StaticImage::StaticImage(const BmpToRender& bmp) : 
@@ -21,19 +36,133 @@ namespace PGUI::UI::Controls
 		RegisterMessageHandler(WM_CREATE, std::bind_front(&StaticImage::OnCreate, this, bmp));
 		RegisterMessageHandler(WM_SIZE, &StaticImage::OnSize);
 		RegisterMessageHandler(WM_PAINT, &StaticImage::OnPaint);
+		RegisterMessageHandler(WM_MOUSEWHEEL, &StaticImage::OnMouseWheel);
+		RegisterMessageHandler(WM_LBUTTONDOWN, &StaticImage::OnLButtonDown);
+		RegisterMessageHandler(WM_LBUTTONUP, &StaticImage::OnLButtonUp);
+		RegisterMessageHandler(WM_MOUSEMOVE, &StaticImage::OnMouseMove);
+	}
+
+	StaticImage::~StaticImage() noexcept
+	{
+		CancelDecode();
 	}
 
 	auto StaticImage::GetImage() const noexcept -> BmpToRender
 	{
+		if (!renderer)
+		{
+			return Bmp::BitmapDecoder{ };
+		}
 		return renderer->GetImage();
 	}
 
 	void StaticImage::SetImage(BmpToRender bmp) noexcept
 	{
+		CancelDecode();
+		filePath.clear();
+
 		CreateRenderer(std::move(bmp));
 		Invalidate();
 	}
 
+	void StaticImage::SetImage(std::wstring_view fileName)
+	{
+		filePath = fileName;
+		StartDecode();
+	}
+
+	void StaticImage::ZoomAt(float factor, PointF anchor)
+	{
+		if (auto* tiledRenderer = dynamic_cast<TiledImageRenderer*>(renderer.get()))
+		{
+			tiledRenderer->ZoomAt(factor, anchor, GetClientSize());
+			Invalidate();
+		}
+	}
+
+	void StaticImage::ResetView()
+	{
+		if (auto* tiledRenderer = dynamic_cast<TiledImageRenderer*>(renderer.get()))
+		{
+			tiledRenderer->ResetView();
+			Invalidate();
+		}
+	}
+
+	void StaticImage::StartDecode()
+	{
+		CancelDecode();
+		decodeStopSource = std::stop_source{ };
+		isDecoding = true;
+
+		const auto clientSize = GetClientRect().Size();
+		Bmp::DecodeRequest request{
+			filePath,
+			SizeU{
+				static_cast<UINT32>(std::max(clientSize.cx, 0L)),
+				static_cast<UINT32>(std::max(clientSize.cy, 0L)) } };
+		request.openAnimation = true;
+		request.openTiled = panZoomEnabled;
+
+		Bmp::AsyncImageDecoder::GetInstance().DecodeAsync(std::move(request), decodeStopSource.get_token(),
+			[this](Bmp::DecodeResult& result)
+		{
+			OnDecoded(result);
+		});
+	}
+
+	void StaticImage::CancelDecode() noexcept
+	{
+		// The callback checks the token on this thread, so it can't run after this
+		decodeStopSource.request_stop();
+		isDecoding = false;
+	}
+
+	void StaticImage::OnDecoded(Bmp::DecodeResult& result)
+	{
+		isDecoding = false;
+
+		if (!result.Succeeded())
+		{
+			HR_L(result.hr);
+			return;
+		}
+
+		if (result.image.frameCount > 1)
+		{
+			// Opened on the worker, frames are composed one by one on this thread as they play
+			if (result.image.gifDecoder)
+			{
+				renderer = std::make_unique<GifRenderer>(this, std::move(result.image.gifDecoder), filePath);
+			}
+			else
+			{
+				const auto& encodedFile = result.image.encodedFile;
+
+				ComPtr<IStream> stream;
+				stream.Attach(SHCreateMemStream(
+					std::bit_cast<const BYTE*>(encodedFile.data()), static_cast<UINT>(encodedFile.size())));
+				if (!stream)
+				{
+					HR_L(E_OUTOFMEMORY);
+					return;
+				}
+				renderer = std::make_unique<GifRenderer>(this, Bmp::BitmapDecoder{ stream });
+			}
+		}
+		else if (result.image.tiledImage)
+		{
+			// Opened on the worker, its tiles are read there too
+			auto tiledImage = std::move(result.image.tiledImage);
+			renderer = std::make_unique<TiledImageRenderer>(filePath, std::move(tiledImage), std::move(result.image));
+		}
+		else
+		{
+			renderer = std::make_unique<DecodedImageRenderer>(filePath, std::move(result.image));
+		}
+		Invalidate();
+	}
+
 	void StaticImage::CreateRenderer(BmpToRender bmp) noexcept
 	{
 		std::visit([this, bmp]<typename T>(T& param)
@@ -69,23 +198,111 @@ namespace PGUI::UI::Controls
 		return 0;
 	}
 
+	auto StaticImage::OnCreateFromFile(UINT /*unused*/, WPARAM /*unused*/, LPARAM /*unused*/) -> Core::HandlerResult
+	{
+		StartDecode();
+
+		return 0;
+	}
+
 	auto StaticImage::OnPaint(UINT /*unused*/, WPARAM /*unused*/, LPARAM /*unused*/) noexcept -> Core::HandlerResult
 	{
 		BeginDraw();
 
-		renderer->Render(this);
+		if (renderer)
+		{
+			try
+			{
+				renderer->Render(this);
+			}
+			catch (const Core::PGUIException& exception)
+			{
+				HR_L(exception.GetErrorCode());
+			}
+			catch (const std::bad_alloc&)
+			{
+				HR_L(E_OUTOFMEMORY);
+			}
+		}
+		else
+		{
+			GetGraphics().Clear(Colors::Transparent);
+		}
 
 		EndDraw();
 
 		return 0;
 	}
 
-	auto StaticImage::OnSize(UINT /*unused*/, WPARAM /*unused*/, LPARAM /*unused*/) const noexcept -> Core::HandlerResult
+	auto StaticImage::OnSize(UINT /*unused*/, WPARAM /*unused*/, LPARAM /*unused*/) -> Core::HandlerResult
 	{
 		if (auto* gifRenderer = dynamic_cast<GifRenderer*>(renderer.get()))
 		{
 			gifRenderer->OnSize(this);
 		}
+		else if (const auto* decodedRenderer = dynamic_cast<DecodedImageRenderer*>(renderer.get());
+			decodedRenderer != nullptr && !isDecoding)
+		{
+			// Grew past the decoded size of a downscaled image, decode again rather than stretch
+			const auto clientSize = GetClientRect().Size();
+			const auto decodedSize = decodedRenderer->GetDecodedSize();
+			if (decodedSize != decodedRenderer->GetOriginalSize() &&
+				(clientSize.cx > static_cast<long>(decodedSize.cx) || clientSize.cy > static_cast<long>(decodedSize.cy)))
+			{
+				StartDecode();
+			}
+		}
+
+		return 0;
+	}
+
+	auto StaticImage::OnMouseWheel(UINT /*unused*/, WPARAM wParam, LPARAM lParam) -> Core::HandlerResult
+	{
+		// Wheel messages carry screen coordinates
+		const PointL screenPoint{ GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam) };
+		const auto notches = static_cast<float>(GET_WHEEL_DELTA_WPARAM(wParam)) / WHEEL_DELTA;
+
+		ZoomAt(std::pow(1.25F, notches), ScreenToClient(screenPoint));
+
+		return 0;
+	}
+
+	auto StaticImage::OnLButtonDown(UINT /*unused*/, WPARAM /*unused*/, LPARAM lParam) noexcept -> Core::HandlerResult
+	{
+		if (dynamic_cast<TiledImageRenderer*>(renderer.get()) == nullptr)
+		{
+			return 0;
+		}
+
+		SetCapture(Hwnd());
+		dragPoint = PointF{ MAKEPOINTS(lParam) };
+
+		return 0;
+	}
+
+	auto StaticImage::OnLButtonUp(UINT /*unused*/, WPARAM /*unused*/, LPARAM /*unused*/) noexcept -> Core::HandlerResult
+	{
+		if (dragPoint.has_value())
+		{
+			dragPoint.reset();
+			ReleaseCapture();
+		}
+
+		return 0;
+	}
+
+	auto StaticImage::OnMouseMove(UINT /*unused*/, WPARAM wParam, LPARAM lParam) -> Core::HandlerResult
+	{
+		auto* tiledRenderer = dynamic_cast<TiledImageRenderer*>(renderer.get());
+		if (tiledRenderer == nullptr || !dragPoint.has_value() || !(wParam & MK_LBUTTON) || GetCapture() != Hwnd())
+		{
+			return 0;
+		}
+
+		const PointF point = MAKEPOINTS(lParam);
+		tiledRenderer->Pan(PointF{ point.x - dragPoint->x, point.y - dragPoint->y }, GetClientSize());
+		dragPoint = point;
+		Invalidate();
 
 		return 0;
 	}
@@ -1,5 +1,6 @@
 #include "ui/controls/StaticText.hpp"
 
+#include "ui/TextFormatCache.hpp"
 #include "ui/UIColors.hpp"
 #include "ui/Color.hpp"
 #include "ui/Colors.hpp"
@@ -12,7 +13,7 @@
 
 namespace PGUI::UI::Controls
 {
-	static auto GetStaticTextColors() -> std::pair<RGBA, RGBA>
+	static auto GetStaticTextColors() noexcept -> std::pair<RGBA, RGBA>
 	{
 		RGBA textColor;
 		RGBA backgroundColor;
@@ -33,7 +34,7 @@ namespace PGUI::UI::Controls
 
 	StaticText::StaticText(TextFormat _textFormat) noexcept :
 		UIComponent{ PGUI::Core::WindowClass::Create(L"StaticText_UIComponent") },
-		textFormat(std::move(_textFormat))
+		textFormat(TextFormatCache::GetInstance().Intern(_textFormat))
 	{
 		RegisterMessageHandler(WM_NCCREATE, &StaticText::OnNCCreate);
 		RegisterMessageHandler(WM_PAINT, &StaticText::OnPaint);
@@ -42,30 +43,44 @@ namespace PGUI::UI::Controls
 		RegisterMessageHandler(WM_GETTEXT, &StaticText::OnGetText);
 		RegisterMessageHandler(WM_GETTEXTLENGTH, &StaticText::OnGetTextLength);
 
+		ApplyThemeColors();
+		themeChangedConnection = UIColors::ThemeChangedEvent().Subscribe(
+			BindMemberFunc(&StaticText::OnThemeChanged, this), Core::EventDelivery::UIThread);
+	}
+
+	void StaticText::ApplyThemeColors() noexcept
+	{
 		auto [textColor, backgroundColor] = GetStaticTextColors();
 		textBrush.SetParameters(textColor);
 		backgroundBrush.SetParameters(backgroundColor);
 	}
 
+	void StaticText::OnThemeChanged() noexcept
+	{
+		if (followsTheme)
+		{
+			ApplyThemeColors();
+			Invalidate();
+		}
+	}
+
 	auto StaticText::GetTextLayout() const noexcept -> TextLayout
 	{
-		return textLayout;
+		return textLayout.textLayout;
 	}
 
 	void StaticText::SetTextFormat(TextFormat _textFormat) noexcept
 	{
-		textFormat = std::move(_textFormat);
+		textFormat = TextFormatCache::GetInstance().Intern(_textFormat);
 
 		InitTextLayout();
 	}
 
 	void StaticText::InitTextLayout()
 	{
-		textLayout.Reset();
-
 		auto size = GetClientSize();
 
-		textLayout = TextLayout{ text, textFormat, size };
+		textLayout = TextLayoutCache::GetInstance().Get(text, textFormat, size);
 		textBrush.ReleaseBrush();
 	}
 
@@ -92,6 +107,7 @@ namespace PGUI::UI::Controls
 
 	void StaticText::SetTextBrush(const Brush& brush) noexcept
 	{
+		followsTheme = false;
 		textBrush.SetParameters(brush.GetParameters());
 		Invalidate();
 	}
@@ -103,6 +119,7 @@ namespace PGUI::UI::Controls
 
 	void StaticText::SetBackgroundBrush(const Brush& brush) noexcept
 	{
+		followsTheme = false;
 		backgroundBrush.SetParameters(brush.GetParameters());
 		Invalidate();
 	}
@@ -170,7 +187,7 @@ namespace PGUI::UI::Controls
 		auto prevTransform = g.GetTransform();
 		g.SetTransform(GetDpiScaleTransform(textLayout.GetBoundingRect().Center()));
 
-		g.DrawTextLayout(PointF{ 0, 0 }, textLayout, textBrush);
+		g.DrawTextLayout(textLayout.offset, textLayout.textLayout, textBrush);
 
 		g.SetTransform(prevTransform);
 
@@ -1,6 +1,7 @@
 #include "ui/controls/TextButton.hpp"
 
 #include "ui/Colors.hpp"
+#include "ui/TextFormatCache.hpp"
 #include "helpers/ScopedTimer.hpp"
 
 #include <algorithm>
@@ -73,7 +74,7 @@ namespace PGUI::UI::Controls
 
 	TextButton::TextButton(TextButtonColors  _colors, TextFormat _textFormat) noexcept :
 		ButtonBase{ PGUI::Core::WindowClass::Create(L"TextButton_UIControl") },
-		colors(std::move(_colors)), textFormat(std::move(_textFormat))
+		colors(std::move(_colors)), textFormat(TextFormatCache::GetInstance().Intern(_textFormat))
 	{
 		RegisterMessageHandler(WM_NCCREATE, &TextButton::OnNCCreate);
 		RegisterMessageHandler(WM_PAINT, &TextButton::OnPaint);
@@ -84,52 +85,33 @@ namespace PGUI::UI::Controls
 		RegisterMessageHandler(WM_GETTEXTLENGTH, &TextButton::OnGetTextLength);
 
 		StateChangedEvent().Subscribe(PGUI::BindMemberFunc(&TextButton::OnStateChanged, this));
-		switch (GetState())
-		{
-			using enum PGUI::UI::Controls::ButtonState;
-
-			case Normal:
-			{
-				textBrush.SetParameters(colors.normalText);
-				backgroundBrush.SetParameters(colors.normalBackground);
-				break;
-			}
-			case Hover:
-			{
-				textBrush.SetParameters(colors.hoverText);
-				backgroundBrush.SetParameters(colors.hoverBackground);
-				break;
-			}
-			case Pressed:
-			{
-				textBrush.SetParameters(colors.clickedText);
-				backgroundBrush.SetParameters(colors.clickedBackground);
-				break;
-			}
-			default:
-				break;
-		}
+		ApplyColors(GetState());
+	}
+	TextButton::TextButton(ThemeColorsGetter _themeColors, TextFormat _textFormat) noexcept :
+		TextButton{ _themeColors(), std::move(_textFormat) }
+	{
+		themeColors = _themeColors;
+		themeChangedConnection = UIColors::ThemeChangedEvent().Subscribe(
+			PGUI::BindMemberFunc(&TextButton::OnThemeChanged, this), Core::EventDelivery::UIThread);
 	}
 
 	auto TextButton::GetTextLayout() const noexcept -> TextLayout
 	{
-		return textLayout;
+		return textLayout.textLayout;
 	}
 
 	void TextButton::SetTextFormat(TextFormat _textFormat) noexcept
 	{
-		textFormat = std::move(_textFormat);
+		textFormat = TextFormatCache::GetInstance().Intern(_textFormat);
 
 		InitTextLayout();
 	}
 
 	void TextButton::InitTextLayout()
 	{
-		textLayout.Reset();
-
 		auto size = GetClientSize();
 
-		textLayout = TextLayout{ text, textFormat, size };
+		textLayout = TextLayoutCache::GetInstance().Get(text, textFormat, size);
 		textBrush.ReleaseBrush();
 	}
 
@@ -157,6 +139,14 @@ namespace PGUI::UI::Controls
 	{
 		return colors;
 	}
+	void TextButton::SetColors(TextButtonColors newColors) noexcept
+	{
+		colors = std::move(newColors);
+		themeColors = nullptr;
+		themeChangedConnection.Disconnect();
+
+		OnStateChanged(GetState());
+	}
 
 	auto TextButton::TextChangedEvent() noexcept -> Core::Event<std::wstring_view>&
 	{
@@ -164,6 +154,12 @@ namespace PGUI::UI::Controls
 	}
 
 	void TextButton::OnStateChanged(ButtonState newState) noexcept
+	{
+		ApplyColors(newState);
+		Invalidate();
+	}
+
+	void TextButton::ApplyColors(ButtonState newState) noexcept
 	{
 		switch (newState)
 		{
@@ -190,9 +186,12 @@ namespace PGUI::UI::Controls
 			default:
 				break;
 		}
+	}
 
-		DiscardDeviceResources();
-		Invalidate();
+	void TextButton::OnThemeChanged() noexcept
+	{
+		colors = themeColors();
+		OnStateChanged(GetState());
 	}
 
 	void TextButton::CreateDeviceResources()
@@ -248,7 +247,7 @@ namespace PGUI::UI::Controls
 		auto prevTransform = g.GetTransform();
 		g.SetTransform(GetDpiScaleTransform(textLayout.GetBoundingRect().Center()));
 
-		g.DrawTextLayout(PointF{ 0, 0 }, textLayout, textBrush);
+		g.DrawTextLayout(textLayout.offset, textLayout.textLayout, textBrush);
 
 		g.SetTransform(prevTransform);
 
@@ -1,5 +1,6 @@
 #include "ui/dialogs/MessageBoxDialog.hpp"
 #include "ui/Colors.hpp"
+#include "ui/TextFormatCache.hpp"
 
 #include "factories/DWriteFactory.hpp"
 
@@ -229,9 +230,10 @@ namespace PGUI::UI::Dialogs
 
 		maxSize = ScaleByDPI(SizeF{ maxSize });
 
-		textFormat = TextFormat::GetDefTextFormat(ScaleByDPI(16.0F));
-		textFormat.SetParagraphAlignment(Font::ParagraphAlignments::Near);
-		textFormat.SetTextAlignment(Font::TextAlignments::Leading);
+		auto textFormatDescriptor = TextFormat::GetDefTextFormatDescriptor(ScaleByDPI(16.0F));
+		textFormatDescriptor.paragraphAlignment = Font::ParagraphAlignments::Near;
+		textFormatDescriptor.textAlignment = Font::TextAlignments::Leading;
+		textFormat = TextFormatCache::GetInstance().Get(textFormatDescriptor);
 
 		auto layoutSize = GetClientSize();
 		layoutSize.cx -= margin.left + margin.right;
@@ -0,0 +1,180 @@
+#include "Check.hpp"
+#include "helpers/AtlasPacker.hpp"
+
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <random>
+#include <tuple>
+#include <vector>
+
+
+namespace
+{
+	using namespace PGUI;
+
+	auto Next(std::mt19937& random) -> std::uint32_t
+	{
+		return static_cast<std::uint32_t>(random());
+	}
+
+	void PackerNeverOverlaps()
+	{
+		std::mt19937 random{ 3 };
+		auto matches = true;
+
+		for (auto trial = 0; trial < 200; trial++)
+		{
+			AtlasPacker packer{ SizeU{ 256, 256 } };
+			std::vector<RectU> used;
+
+			for (auto step = 0; step < 300; step++)
+			{
+				if (!used.empty() && Next(random) % 3 == 0)
+				{
+					const auto index = Next(random) % used.size();
+					packer.Remove(used[index]);
+					used.erase(used.begin() + static_cast<std::ptrdiff_t>(index));
+				}
+				else if (const auto rect = packer.Insert(SizeU{ 1 + Next(random) % 64, 1 + Next(random) % 64 }))
+				{
+					matches = matches && rect->right <= 256 && rect->bottom <= 256;
+					for (const auto& other : used)
+					{
+						matches = matches && !other.IsIntersectingRect(*rect);
+					}
+					used.push_back(*rect);
+				}
+			}
+
+			std::uint64_t area = 0;
+			for (const auto& rect : used)
+			{
+				area += static_cast<std::uint64_t>(rect.Width()) * rect.Height();
+			}
+			matches = matches && area == packer.GetUsedArea();
+		}
+		PGUI_CHECK(matches);
+
+		AtlasPacker packer{ SizeU{ 64, 64 } };
+		PGUI_CHECK(!packer.Insert(SizeU{ 0, 8 }).has_value());
+		PGUI_CHECK(!packer.Insert(SizeU{ 65, 8 }).has_value());
+		PGUI_CHECK(packer.Insert(SizeU{ 64, 64 }).has_value());
+		PGUI_CHECK(!packer.Insert(SizeU{ 1, 1 }).has_value());
+		packer.Clear();
+		PGUI_CHECK(packer.GetUsedArea() == 0);
+	}
+
+	void AllocatorKeepsEntriesApartThroughRepacks()
+	{
+		std::mt19937 random{ 3 };
+		AtlasAllocator allocator{ SizeU{ 512, 512 }, 3, 1 };
+		std::map<AtlasEntryId, SizeU> live;
+		auto matches = true;
+
+		for (auto step = 0; step < 3000; step++)
+		{
+			if (!live.empty() && Next(random) % 2 == 0)
+			{
+				auto iter = live.begin();
+				std::advance(iter, Next(random) % live.size());
+				allocator.Free(iter->first);
+				live.erase(iter);
+			}
+
+			const SizeU size{ 8 + Next(random) % 56, 8 + Next(random) % 56 };
+			if (const auto id = allocator.Allocate(size))
+			{
+				live[*id] = size;
+			}
+			if (step % 500 == 0)
+			{
+				std::ignore = allocator.Repack();
+			}
+
+			if (step % 100 != 0)
+			{
+				continue;
+			}
+
+			// The padding around each entry has to stay clear of the others
+			std::vector<AtlasSlot> slots;
+			for (const auto& [id, entrySize] : live)
+			{
+				const auto slot = allocator.GetSlot(id);
+				matches = matches && slot.has_value() && slot->rect.Size() == entrySize;
+				if (slot.has_value())
+				{
+					slots.push_back(*slot);
+				}
+			}
+			for (std::size_t i = 0; i < slots.size(); i++)
+			{
+				for (auto j = i + 1; j < slots.size(); j++)
+				{
+					matches = matches && (slots[i].page != slots[j].page ||
+						!slots[i].rect.Inflated(1, 1).IsIntersectingRect(slots[j].rect));
+				}
+			}
+		}
+		PGUI_CHECK(matches);
+		PGUI_CHECK(allocator.GetEntryCount() == live.size());
+		PGUI_CHECK(allocator.GetPageCount() <= 3);
+	}
+
+	void LeastRecentlyUsedFollowsTouches()
+	{
+		AtlasAllocator allocator{ SizeU{ 128, 128 }, 1, 1 };
+		const auto first = allocator.Allocate(SizeU{ 10, 10 });
+		const auto second = allocator.Allocate(SizeU{ 10, 10 });
+		PGUI_CHECK(first.has_value() && second.has_value());
+
+		PGUI_CHECK(allocator.GetLeastRecentlyUsed() == first);
+		allocator.Touch(*first);
+		PGUI_CHECK(allocator.GetLeastRecentlyUsed() == second);
+
+		allocator.Free(*second);
+		PGUI_CHECK(!allocator.GetSlot(*second).has_value());
+		PGUI_CHECK(allocator.GetLeastRecentlyUsed() == first);
+		PGUI_CHECK(!allocator.CanEverFit(SizeU{ 127, 10 }));
+		PGUI_CHECK(allocator.CanEverFit(SizeU{ 126, 126 }));
+	}
+
+	void PaddingRepeatsTheEdges()
+	{
+		constexpr SizeU size{ 3, 2 };
+		constexpr std::uint32_t padding = 2;
+		constexpr std::uint32_t sourcePitch = 5;
+
+		// Row pitch wider than the image, the extra pixels mustn't be copied
+		const std::vector<std::uint32_t> source{
+			1, 2, 3, 99, 99,
+			4, 5, 6 };
+
+		std::vector<std::uint32_t> padded((size.cx + 2 * padding) * (size.cy + 2 * padding), 0);
+		CopyWithExtrudedPadding(size, source, sourcePitch, padding, padded);
+
+		const std::vector<std::uint32_t> expected{
+			1, 1, 1, 2, 3, 3, 3,
+			1, 1, 1, 2, 3, 3, 3,
+			1, 1, 1, 2, 3, 3, 3,
+			4, 4, 4, 5, 6, 6, 6,
+			4, 4, 4, 5, 6, 6, 6,
+			4, 4, 4, 5, 6, 6, 6 };
+		PGUI_CHECK(padded == expected);
+
+		std::vector<std::uint32_t> unpadded(6, 0);
+		CopyWithExtrudedPadding(size, source, sourcePitch, 0, unpadded);
+		PGUI_CHECK((unpadded == std::vector<std::uint32_t>{ 1, 2, 3, 4, 5, 6 }));
+	}
+}
+
+auto main() -> int
+{
+	PackerNeverOverlaps();
+	AllocatorKeepsEntriesApartThroughRepacks();
+	LeastRecentlyUsedFollowsTouches();
+	PaddingRepeatsTheEdges();
+
+	return PGUI::Tests::Finish();
+}
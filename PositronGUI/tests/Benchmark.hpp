@@ -0,0 +1,41 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+
+namespace PGUI::Tests
+{
+	/**
+	* @brief Keeps the compiler from optimizing away a result nothing else reads
+	*/
+	template <typename T>
+	void KeepAlive(const T& value) noexcept
+	{
+		asm volatile("" : : "r,m"(value) : "memory");
+	}
+
+	/**
+	* @brief Best average time of a call to function over a few runs of iterations calls, in nanoseconds
+	*/
+	template <typename Function>
+	[[nodiscard]] auto MeasureNanoseconds(std::size_t iterations, Function&& function) -> double
+	{
+		using Clock = std::chrono::steady_clock;
+		constexpr auto runs = 5;
+
+		auto best = std::chrono::duration<double, std::nano>::max();
+		for (auto run = 0; run < runs; run++)
+		{
+			const auto start = Clock::now();
+			for (std::size_t i = 0; i < iterations; i++)
+			{
+				function(i);
+			}
+			best = std::min(best, std::chrono::duration<double, std::nano>(Clock::now() - start));
+		}
+
+		return best.count() / static_cast<double>(iterations);
+	}
+}
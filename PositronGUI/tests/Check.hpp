@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdio>
+#include <source_location>
+
+
+namespace PGUI::Tests
+{
+	inline int failedChecks = 0;
+
+	inline void Check(bool condition, const char* expression,
+		std::source_location location = std::source_location::current()) noexcept
+	{
+		if (!condition)
+		{
+			std::printf("%s:%u: check failed: %s\n", location.file_name(), location.line(), expression);
+			failedChecks++;
+		}
+	}
+
+	/**
+	* @brief Prints the result, return it from main
+	*/
+	[[nodiscard]] inline auto Finish() noexcept -> int
+	{
+		std::printf(failedChecks == 0 ? "All checks passed\n" : "%d checks failed\n", failedChecks);
+		return failedChecks == 0 ? 0 : 1;
+	}
+}
+
+#define PGUI_CHECK(condition) PGUI::Tests::Check(static_cast<bool>(condition), #condition)
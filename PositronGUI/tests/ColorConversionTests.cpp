@@ -0,0 +1,376 @@
+#include "Check.hpp"
+#include "ui/ColorConversion.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+	using namespace PGUI::UI;
+
+	static_assert(RGBA{ HSV{ 120.0F, 1.0F, 1.0F } } == RGBA{ 0.0F, 1.0F, 0.0F });
+	static_assert(RGBA{ HSL{ 240.0F, 1.0F, 0.5F } } == RGBA{ 0.0F, 0.0F, 1.0F });
+	static_assert(HSV{ RGBA{ 1.0F, 0.0F, 1.0F } } == HSV{ 300.0F, 1.0F, 1.0F });
+	static_assert(CMYK{ RGBA{ 0.0F, 0.0F, 0.0F } } == CMYK{ 0.0F, 0.0F, 0.0F, 1.0F });
+	static_assert(RGBA{ 0xFF8000U }.g > 0.5F);
+
+	constexpr std::size_t ColorCount = 1000003;
+
+	/*
+	* The textbook hexcone conversions with an if chain over the hue sector, what the branch-free ones have to agree with
+	*/
+	void ReferenceSector(float huePrime, float chroma, float x, float& r, float& g, float& b) noexcept
+	{
+		r = g = b = 0.0F;
+		switch (std::min(static_cast<int>(huePrime), 5))
+		{
+			case 0:
+				r = chroma;
+				g = x;
+				break;
+			case 1:
+				r = x;
+				g = chroma;
+				break;
+			case 2:
+				g = chroma;
+				b = x;
+				break;
+			case 3:
+				g = x;
+				b = chroma;
+				break;
+			case 4:
+				r = x;
+				b = chroma;
+				break;
+			default:
+				r = chroma;
+				b = x;
+				break;
+		}
+	}
+
+	auto ReferenceFromHsv(HSV hsv) noexcept -> RGBA
+	{
+		const auto chroma = hsv.v * hsv.s;
+		const auto huePrime = hsv.h / 60.0F;
+		const auto x = chroma * (1.0F - std::abs(std::fmod(huePrime, 2.0F) - 1.0F));
+		float r = 0.0F;
+		float g = 0.0F;
+		float b = 0.0F;
+		ReferenceSector(huePrime, chroma, x, r, g, b);
+		const auto m = hsv.v - chroma;
+		return RGBA{ r + m, g + m, b + m };
+	}
+
+	auto ReferenceFromHsl(HSL hsl) noexcept -> RGBA
+	{
+		const auto chroma = (1.0F - std::abs(2.0F * hsl.l - 1.0F)) * hsl.s;
+		const auto huePrime = hsl.h / 60.0F;
+		const auto x = chroma * (1.0F - std::abs(std::fmod(huePrime, 2.0F) - 1.0F));
+		float r = 0.0F;
+		float g = 0.0F;
+		float b = 0.0F;
+		ReferenceSector(huePrime, chroma, x, r, g, b);
+		const auto m = hsl.l - chroma / 2.0F;
+		return RGBA{ r + m, g + m, b + m };
+	}
+
+	auto ReferenceFromCmyk(CMYK cmyk) noexcept -> RGBA
+	{
+		return RGBA{ (1.0F - cmyk.c) * (1.0F - cmyk.k), (1.0F - cmyk.m) * (1.0F - cmyk.k), (1.0F - cmyk.y) * (1.0F - cmyk.k) };
+	}
+
+	void ReferenceToHsv(double r, double g, double b, double& h, double& s) noexcept
+	{
+		const auto max = std::max({ r, g, b });
+		const auto delta = max - std::min({ r, g, b });
+		s = max == 0.0 ? 0.0 : delta / max;
+
+		if (delta == 0.0)
+		{
+			h = 0.0;
+		}
+		else if (max == r)
+		{
+			h = std::fmod((g - b) / delta + 6.0, 6.0);
+		}
+		else if (max == g)
+		{
+			h = (b - r) / delta + 2.0;
+		}
+		else
+		{
+			h = (r - g) / delta + 4.0;
+		}
+		h *= 60.0;
+	}
+
+	auto IsSame(float a, float b) noexcept -> bool
+	{
+		return std::bit_cast<std::uint32_t>(a) == std::bit_cast<std::uint32_t>(b);
+	}
+
+	auto IsSame(RGBA color, float r, float g, float b) noexcept -> bool
+	{
+		return IsSame(color.r, r) && IsSame(color.g, g) && IsSame(color.b, b);
+	}
+
+	auto IsNear(RGBA color, float r, float g, float b, float tolerance) noexcept -> bool
+	{
+		return std::abs(color.r - r) < tolerance && std::abs(color.g - g) < tolerance && std::abs(color.b - b) < tolerance;
+	}
+
+	auto MaxDifference(RGBA a, RGBA b) noexcept -> float
+	{
+		return std::max({ std::abs(a.r - b.r), std::abs(a.g - b.g), std::abs(a.b - b.b) });
+	}
+
+	struct Planes
+	{
+		explicit Planes(std::size_t count) :
+			first(count), second(count), third(count), fourth(count)
+		{
+		}
+
+		std::vector<float> first;
+		std::vector<float> second;
+		std::vector<float> third;
+		std::vector<float> fourth;
+	};
+
+	void ToRgbMatchesSingleAndReference()
+	{
+		std::mt19937 engine{ 7 };
+		std::uniform_real_distribution<float> unit{ 0.0F, 1.0F };
+		std::uniform_real_distribution<float> hue{ 0.0F, 360.0F };
+		std::uniform_real_distribution<float> wideHue{ -1000.0F, 1000.0F };
+
+		Planes source{ ColorCount };
+		for (std::size_t i = 0; i < ColorCount; i++)
+		{
+			// Every quarter degree, including the sector edges, then random hues with some outside [0, 360)
+			source.first[i] = i < 360 * 4 ? static_cast<float>(i) * 0.25F : (i % 7 == 0 ? wideHue(engine) : hue(engine));
+			source.second[i] = unit(engine);
+			source.third[i] = unit(engine);
+			source.fourth[i] = unit(engine);
+		}
+		const auto& [h, s, v, k] = source;
+		Planes rgb{ ColorCount };
+		auto& [r, g, b, unused] = rgb;
+
+		HsvToRgb(h.data(), s.data(), v.data(), r.data(), g.data(), b.data(), ColorCount);
+		auto matches = true;
+		auto wrapsHue = true;
+		auto maxDifference = 0.0F;
+		for (std::size_t i = 0; i < ColorCount; i++)
+		{
+			const RGBA single{ HSV{ h[i], s[i], v[i] } };
+			matches = matches && IsSame(single, r[i], g[i], b[i]);
+
+			if (h[i] >= 0.0F && h[i] < 360.0F)
+			{
+				maxDifference = std::max(maxDifference, MaxDifference(single, ReferenceFromHsv(HSV{ h[i], s[i], v[i] })));
+			}
+			else
+			{
+				auto wrapped = std::fmod(h[i], 360.0F);
+				wrapped = wrapped < 0.0F ? wrapped + 360.0F : wrapped;
+				wrapped = wrapped >= 360.0F ? 0.0F : wrapped;
+				const auto reference = ReferenceFromHsv(HSV{ wrapped, s[i], v[i] });
+				wrapsHue = wrapsHue && IsNear(single, reference.r, reference.g, reference.b, 1e-4F);
+			}
+		}
+		PGUI_CHECK(matches);
+		PGUI_CHECK(wrapsHue);
+		PGUI_CHECK(maxDifference < 1e-6F);
+
+		HslToRgb(h.data(), s.data(), v.data(), r.data(), g.data(), b.data(), ColorCount);
+		matches = true;
+		maxDifference = 0.0F;
+		for (std::size_t i = 0; i < ColorCount; i++)
+		{
+			const RGBA single{ HSL{ h[i], s[i], v[i] } };
+			matches = matches && IsSame(single, r[i], g[i], b[i]);
+			if (h[i] >= 0.0F && h[i] < 360.0F)
+			{
+				maxDifference = std::max(maxDifference, MaxDifference(single, ReferenceFromHsl(HSL{ h[i], s[i], v[i] })));
+			}
+		}
+		PGUI_CHECK(matches);
+		PGUI_CHECK(maxDifference < 1e-6F);
+
+		// Hues are valid CMYK channels too
+		CmykToRgb(h.data(), s.data(), v.data(), k.data(), r.data(), g.data(), b.data(), ColorCount);
+		matches = true;
+		for (std::size_t i = 0; i < ColorCount; i++)
+		{
+			const CMYK cmyk{ h[i], s[i], v[i], k[i] };
+			const RGBA single{ cmyk };
+			matches = matches && IsSame(single, r[i], g[i], b[i]) && single == ReferenceFromCmyk(cmyk);
+		}
+		PGUI_CHECK(matches);
+	}
+
+	void FromRgbMatchesSingleAndRoundTrips()
+	{
+		std::mt19937 engine{ 7 };
+		std::uniform_real_distribution<float> unit{ 0.0F, 1.0F };
+
+		Planes rgb{ ColorCount };
+		auto& [r, g, b, unused] = rgb;
+		for (std::size_t i = 0; i < ColorCount; i++)
+		{
+			// Grays, quantized channels and ties between the largest channels pick the sector by their edge cases
+			r[i] = unit(engine);
+			g[i] = i % 5 == 0 ? r[i] : unit(engine);
+			b[i] = i % 11 == 0 ? g[i] : (i % 13 == 0 ? std::round(unit(engine) * 4.0F) / 4.0F : unit(engine));
+			if (i % 17 == 0)
+			{
+				r[i] = g[i] = b[i] = 0.0F;
+			}
+			if (i % 19 == 0)
+			{
+				r[i] = 1.0F;
+				g[i] = b[i] = 0.99999994F;
+			}
+		}
+		Planes result{ ColorCount };
+		auto& [first, second, third, fourth] = result;
+
+		RgbToHsv(r.data(), g.data(), b.data(), first.data(), second.data(), third.data(), ColorCount);
+		auto matches = true;
+		auto roundTrips = true;
+		auto maxDifference = 0.0;
+		for (std::size_t i = 0; i < ColorCount; i++)
+		{
+			const HSV single{ RGBA{ r[i], g[i], b[i] } };
+			matches = matches && IsSame(single.h, first[i]) && IsSame(single.s, second[i]) && IsSame(single.v, third[i]) &&
+				single.h >= 0.0F && single.h <= 360.0F;
+
+			auto referenceHue = 0.0;
+			auto referenceSaturation = 0.0;
+			ReferenceToHsv(r[i], g[i], b[i], referenceHue, referenceSaturation);
+			auto hueDifference = std::abs(referenceHue - single.h);
+			hueDifference = std::min(hueDifference, 360.0 - hueDifference);
+			maxDifference = std::max({ maxDifference, hueDifference / 360.0, std::abs(referenceSaturation - single.s) });
+
+			roundTrips = roundTrips && IsNear(RGBA{ single }, r[i], g[i], b[i], 2e-6F);
+		}
+		PGUI_CHECK(matches);
+		PGUI_CHECK(roundTrips);
+		PGUI_CHECK(maxDifference < 1e-6);
+
+		RgbToHsl(r.data(), g.data(), b.data(), first.data(), second.data(), third.data(), ColorCount);
+		matches = true;
+		roundTrips = true;
+		for (std::size_t i = 0; i < ColorCount; i++)
+		{
+			const HSL single{ RGBA{ r[i], g[i], b[i] } };
+			matches = matches && IsSame(single.h, first[i]) && IsSame(single.s, second[i]) && IsSame(single.l, third[i]) &&
+				single.s >= 0.0F && single.s <= 1.0F;
+			roundTrips = roundTrips && IsNear(RGBA{ single }, r[i], g[i], b[i], 3e-6F);
+		}
+		PGUI_CHECK(matches);
+		PGUI_CHECK(roundTrips);
+
+		RgbToCmyk(r.data(), g.data(), b.data(), first.data(), second.data(), third.data(), fourth.data(), ColorCount);
+		matches = true;
+		roundTrips = true;
+		for (std::size_t i = 0; i < ColorCount; i++)
+		{
+			const CMYK single{ RGBA{ r[i], g[i], b[i] } };
+			matches = matches && IsSame(single.c, first[i]) && IsSame(single.m, second[i]) &&
+				IsSame(single.y, third[i]) && IsSame(single.k, fourth[i]);
+			roundTrips = roundTrips && IsNear(RGBA{ single }, r[i], g[i], b[i], 2e-6F);
+		}
+		PGUI_CHECK(matches);
+		PGUI_CHECK(roundTrips);
+	}
+
+	void PlanarConvertsInPlace()
+	{
+		std::mt19937 engine{ 3 };
+		std::uniform_real_distribution<float> unit{ 0.0F, 1.0F };
+
+		constexpr std::size_t count = 1001;
+		std::vector<float> h(count);
+		std::vector<float> s(count);
+		std::vector<float> v(count);
+		for (std::size_t i = 0; i < count; i++)
+		{
+			h[i] = unit(engine) * 360.0F;
+			s[i] = unit(engine);
+			v[i] = unit(engine);
+		}
+
+		std::vector<float> r(count);
+		std::vector<float> g(count);
+		std::vector<float> b(count);
+		HsvToRgb(h.data(), s.data(), v.data(), r.data(), g.data(), b.data(), count);
+		HsvToRgb(h.data(), s.data(), v.data(), h.data(), s.data(), v.data(), count);
+		PGUI_CHECK(h == r && s == g && v == b);
+	}
+
+	void PackedMatchesSingle()
+	{
+		std::mt19937 engine{ 5 };
+		std::uniform_real_distribution<float> unit{ 0.0F, 1.0F };
+
+		// More than one 256 color batch, and not a multiple of it
+		std::vector<HSV> hsv(1337);
+		for (auto& color : hsv)
+		{
+			color = HSV{ unit(engine) * 360.0F, unit(engine), unit(engine) };
+		}
+
+		std::vector<RGBA> rgba(hsv.size());
+		ConvertColors(hsv, rgba.data());
+		auto matches = true;
+		for (std::size_t i = 0; i < hsv.size(); i++)
+		{
+			matches = matches && rgba[i] == RGBA{ hsv[i] };
+		}
+		PGUI_CHECK(matches);
+
+		std::vector<HSL> hsl(rgba.size());
+		std::vector<HSV> hsvBack(rgba.size());
+		std::vector<CMYK> cmyk(rgba.size());
+		ConvertColors(rgba, hsl.data());
+		ConvertColors(rgba, hsvBack.data());
+		ConvertColors(rgba, cmyk.data());
+		matches = true;
+		for (std::size_t i = 0; i < rgba.size(); i++)
+		{
+			matches = matches && hsl[i] == HSL{ rgba[i] } && hsvBack[i] == HSV{ rgba[i] } && cmyk[i] == CMYK{ rgba[i] };
+		}
+		PGUI_CHECK(matches);
+
+		std::vector<RGBA> fromHsl(hsl.size());
+		std::vector<RGBA> fromCmyk(cmyk.size());
+		ConvertColors(std::span<const HSL>{ hsl }, fromHsl.data());
+		ConvertColors(std::span<const CMYK>{ cmyk }, fromCmyk.data());
+		matches = true;
+		for (std::size_t i = 0; i < rgba.size(); i++)
+		{
+			matches = matches && fromHsl[i] == RGBA{ hsl[i] } && fromCmyk[i] == RGBA{ cmyk[i] };
+		}
+		PGUI_CHECK(matches);
+	}
+}
+
+auto main() -> int
+{
+	ToRgbMatchesSingleAndReference();
+	FromRgbMatchesSingleAndRoundTrips();
+	PlanarConvertsInPlace();
+	PackedMatchesSingle();
+
+	return PGUI::Tests::Finish();
+}
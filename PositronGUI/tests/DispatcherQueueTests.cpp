@@ -0,0 +1,224 @@
+#include "Check.hpp"
+#include "core/DispatcherQueue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+	using namespace PGUI::Core;
+
+	struct FireAndForget
+	{
+		struct promise_type
+		{
+			auto get_return_object() const noexcept { return FireAndForget{ }; }
+			auto initial_suspend() const noexcept { return std::suspend_never{ }; }
+			auto final_suspend() const noexcept { return std::suspend_never{ }; }
+			void return_void() const noexcept { }
+			void unhandled_exception() const noexcept { std::terminate(); }
+		};
+	};
+
+	auto ResumeOnConsumer(DispatcherQueue& queue, std::thread::id& resumedOn) -> FireAndForget
+	{
+		co_await queue.SwitchTo(DispatcherPriority::Render);
+		resumedOn = std::this_thread::get_id();
+	}
+
+	void RunsByPriorityWithOneWakePerBatch()
+	{
+		int wakes = 0;
+		DispatcherQueue queue{ [&wakes] { wakes++; return true; } };
+		std::string order;
+
+		queue.Post([&order] { order += 'b'; }, DispatcherPriority::Background);
+		queue.Post([&order] { order += 'n'; });
+		queue.Post([&order] { order += 'i'; }, DispatcherPriority::Input);
+		queue.Post([&order] { order += 'r'; }, DispatcherPriority::Render);
+		queue.Post([&order] { order += 'N'; });
+		PGUI_CHECK(wakes == 1);
+
+		const auto result = queue.Drain();
+		PGUI_CHECK(order == "irnNb");
+		PGUI_CHECK(result.executedCount == 5);
+		PGUI_CHECK(!result.hasRemainingWork);
+
+		// Posted while draining, runs in the next Drain
+		queue.Post([&] { queue.Post([&order] { order += 'x'; }); });
+		PGUI_CHECK(wakes == 2);
+		queue.Drain();
+		PGUI_CHECK(order == "irnNb");
+		PGUI_CHECK(wakes == 3);
+		queue.Drain();
+		PGUI_CHECK(order == "irnNbx");
+		PGUI_CHECK(queue.GetWakeCount() == 3);
+	}
+
+	void FailedWakeIsRetried()
+	{
+		auto failWakes = true;
+		int attempts = 0;
+		DispatcherQueue queue{ [&]
+		{
+			attempts++;
+			return !failWakes;
+		} };
+
+		int ran = 0;
+		queue.Post([&ran] { ran++; });
+		PGUI_CHECK(attempts == 1);
+		PGUI_CHECK(queue.GetWakeCount() == 0);
+
+		// Without the retry this post would be left waiting for a wake up that never comes
+		failWakes = false;
+		queue.Post([&ran] { ran++; });
+		PGUI_CHECK(attempts == 2);
+		PGUI_CHECK(queue.GetWakeCount() == 1);
+
+		queue.Post([&ran] { ran++; });
+		PGUI_CHECK(attempts == 2);
+
+		queue.Drain();
+		PGUI_CHECK(ran == 3);
+	}
+
+	void ThrowingWakeIsRetried()
+	{
+		auto throwOnWake = true;
+		int attempts = 0;
+		DispatcherQueue queue{ [&]() -> bool
+		{
+			attempts++;
+			if (throwOnWake)
+			{
+				throw std::runtime_error{ "wake failed" };
+			}
+			return true;
+		} };
+
+		int ran = 0;
+		auto threw = false;
+		try
+		{
+			queue.Post([&ran] { ran++; });
+		}
+		catch (const std::runtime_error&)
+		{
+			threw = true;
+		}
+		PGUI_CHECK(threw);
+
+		throwOnWake = false;
+		queue.Post([&ran] { ran++; });
+		PGUI_CHECK(attempts == 2);
+
+		queue.Drain();
+		PGUI_CHECK(ran == 2);
+	}
+
+	void BackgroundWorkKeepsToTheBudget()
+	{
+		DispatcherQueue queue{ nullptr };
+		int ran = 0;
+		for (auto i = 0; i < 100; i++)
+		{
+			queue.Post([&ran]
+			{
+				ran++;
+				std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+			}, DispatcherPriority::Background);
+		}
+
+		const auto result = queue.Drain(std::chrono::milliseconds{ 5 });
+		PGUI_CHECK(result.hasRemainingWork);
+		PGUI_CHECK(result.executedCount >= 1 && ran < 100);
+
+		while (queue.Drain(std::chrono::milliseconds{ 50 }).hasRemainingWork)
+		{
+		}
+		PGUI_CHECK(ran == 100);
+	}
+
+	void ManyProducersOneConsumer()
+	{
+		std::mutex mutex;
+		std::condition_variable signal;
+		auto signaled = false;
+
+		DispatcherQueue queue{ [&]
+		{
+			std::scoped_lock lock{ mutex };
+			signaled = true;
+			signal.notify_one();
+			return true;
+		} };
+
+		constexpr auto ProducerCount = 8;
+		constexpr auto PostsPerProducer = 20000;
+
+		std::atomic_long sum = 0;
+		std::atomic_bool stop = false;
+		std::thread::id resumedOn;
+
+		std::jthread producers{ [&]
+		{
+			{
+				std::vector<std::jthread> threads;
+				for (auto producer = 0; producer < ProducerCount; producer++)
+				{
+					threads.emplace_back([&, producer]
+					{
+						for (auto i = 0; i < PostsPerProducer; i++)
+						{
+							queue.Post([&sum] { sum++; }, static_cast<DispatcherPriority>(i % DispatcherPriorityCount));
+						}
+						if (producer == 0)
+						{
+							ResumeOnConsumer(queue, resumedOn);
+						}
+					});
+				}
+			}
+			queue.Post([&stop] { stop = true; });
+		} };
+
+		while (!stop)
+		{
+			{
+				std::unique_lock lock{ mutex };
+				signal.wait(lock, [&signaled] { return signaled; });
+				signaled = false;
+			}
+			queue.Drain();
+		}
+		producers.join();
+		while (queue.Drain().hasRemainingWork)
+		{
+		}
+
+		PGUI_CHECK(sum == ProducerCount * PostsPerProducer);
+		PGUI_CHECK(resumedOn == std::this_thread::get_id());
+		PGUI_CHECK(queue.GetPostedCount() == ProducerCount * PostsPerProducer + 2);
+	}
+}
+
+auto main() -> int
+{
+	RunsByPriorityWithOneWakePerBatch();
+	FailedWakeIsRetried();
+	ThrowingWakeIsRetried();
+	BackgroundWorkKeepsToTheBudget();
+	ManyProducersOneConsumer();
+
+	return PGUI::Tests::Finish();
+}
@@ -0,0 +1,278 @@
+#include "Check.hpp"
+#include "core/Event.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+
+// GCC can't tell the replaced operator new uses malloc
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+namespace
+{
+	std::atomic_size_t allocationCount = 0;
+}
+
+// Counts allocations so the test can check Emit doesn't make any
+auto operator new(std::size_t size) -> void*
+{
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	if (auto* memory = std::malloc(size == 0 ? 1 : size);
+		memory != nullptr)
+	{
+		return memory;
+	}
+	throw std::bad_alloc{ };
+}
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+void operator delete(void* memory, std::size_t /*unused*/) noexcept
+{
+	std::free(memory);
+}
+
+namespace PGUI::Core
+{
+	// The library gets this from the thread's Dispatcher, which needs Windows
+	std::shared_ptr<DispatcherQueue> testQueue;
+
+	auto event_detail::GetCurrentThreadQueue() -> std::shared_ptr<DispatcherQueue>
+	{
+		return testQueue;
+	}
+}
+
+namespace
+{
+	using namespace PGUI::Core;
+
+	void SubscribeAndDisconnect()
+	{
+		Event<int> event;
+		int sum = 0;
+
+		auto connection = event.Subscribe([&sum](int value) { sum += value; });
+		event.Emit(2);
+		PGUI_CHECK(sum == 2);
+		PGUI_CHECK(connection.IsConnected());
+
+		{
+			ScopedEventConnection scoped = event.Subscribe([&sum](int value) { sum += 10 * value; });
+			PGUI_CHECK(event.GetHandlerCount() == 2);
+			event.Emit(1);
+			PGUI_CHECK(sum == 13);
+		}
+		PGUI_CHECK(event.GetHandlerCount() == 1);
+
+		event.Emit(1);
+		PGUI_CHECK(sum == 14);
+
+		connection.Disconnect();
+		event.Emit(1);
+		PGUI_CHECK(sum == 14);
+		PGUI_CHECK(!connection.IsConnected());
+		PGUI_CHECK(event.GetHandlerCount() == 0);
+	}
+
+	void HandlersChangeSubscriptionsWhileRunning()
+	{
+		Event<> event;
+		int selfCalls = 0;
+		int addedCalls = 0;
+
+		EventConnection self;
+		self = event.Subscribe([&]
+		{
+			selfCalls++;
+			self.Disconnect();
+			// Added handlers run from the next Emit on
+			std::ignore = event.Subscribe([&addedCalls] { addedCalls++; });
+		});
+
+		event.Emit();
+		PGUI_CHECK(selfCalls == 1 && addedCalls == 0);
+		event.Emit();
+		PGUI_CHECK(selfCalls == 1 && addedCalls == 1);
+	}
+
+	void DisconnectedLaterInTheSameEmit()
+	{
+		Event<> event;
+		int secondCalls = 0;
+
+		EventConnection second;
+		std::ignore = event.Subscribe([&second] { second.Disconnect(); });
+		second = event.Subscribe([&secondCalls] { secondCalls++; });
+
+		// Disconnected by the first handler on this thread before its turn came
+		event.Emit();
+		PGUI_CHECK(secondCalls == 0);
+	}
+
+	void ClearAndConnectionsOutlivingTheEvent()
+	{
+		ScopedEventConnection scoped;
+		EventConnection connection;
+		{
+			Event<void> event;
+			scoped = event.Subscribe([] { });
+			connection = event.Subscribe([] { });
+
+			event.Clear();
+			PGUI_CHECK(event.GetHandlerCount() == 0);
+			PGUI_CHECK(!connection.IsConnected());
+		}
+
+		PGUI_CHECK(!scoped.IsConnected());
+		scoped.Disconnect();
+		connection.Disconnect();
+
+		// Released connections stay subscribed
+		Event<void> event;
+		int calls = 0;
+		EventConnection released;
+		{
+			ScopedEventConnection owner = event.Subscribe([&calls] { calls++; });
+			released = owner.Release();
+		}
+		event.Emit();
+		PGUI_CHECK(calls == 1);
+		PGUI_CHECK(released.IsConnected());
+	}
+
+	void MovedEventsKeepTheirHandlers()
+	{
+		Event<int> event;
+		int sum = 0;
+		auto connection = event.Subscribe([&sum](int value) { sum += value; });
+
+		auto moved = std::move(event);
+		moved.Emit(5);
+		PGUI_CHECK(sum == 5);
+
+		connection.Disconnect();
+		moved.Emit(5);
+		PGUI_CHECK(sum == 5);
+	}
+
+	void EmitDoesNotAllocate()
+	{
+		Event<int, const std::string&> event;
+		std::size_t totalLength = 0;
+
+		for (auto i = 0; i < 8; i++)
+		{
+			std::ignore = event.Subscribe([&totalLength, i](int value, const std::string& text)
+			{
+				totalLength += text.size() + static_cast<std::size_t>(value + i);
+			});
+		}
+
+		const std::string text = "a string too long for the small string buffer";
+		const auto before = allocationCount.load();
+		for (auto i = 0; i < 1000; i++)
+		{
+			event.Emit(0, text);
+		}
+		PGUI_CHECK(allocationCount.load() == before);
+		PGUI_CHECK(totalLength != 0);
+	}
+
+	void SmallHandlersAreInline()
+	{
+		PGUI::InlineFunction<void(int)> small = [value = 1](int) { static_cast<void>(value); };
+		PGUI_CHECK(small.IsInline());
+
+		struct Large
+		{
+			char buffer[256]{ };
+			void operator()(int /*unused*/) const { }
+		};
+		PGUI::InlineFunction<void(int)> large = Large{ };
+		PGUI_CHECK(!large.IsInline());
+
+		auto moved = std::move(large);
+		moved(1);
+		PGUI_CHECK(static_cast<bool>(moved));
+	}
+
+	void UIThreadDelivery()
+	{
+		int wakes = 0;
+		testQueue = std::make_shared<DispatcherQueue>([&wakes] { wakes++; return true; });
+
+		Event<int> event;
+		int sum = 0;
+		std::ignore = event.Subscribe([&sum](int value) { sum += value; }, EventDelivery::UIThread);
+
+		std::jthread{ [&event] { event.Emit(3); event.Emit(4); } }.join();
+		PGUI_CHECK(sum == 0);
+		PGUI_CHECK(wakes == 1);
+
+		testQueue->Drain();
+		PGUI_CHECK(sum == 7);
+
+		// Disconnected before the posted call ran
+		auto connection = event.Subscribe([&sum](int value) { sum += 100 * value; }, EventDelivery::UIThread);
+		event.Emit(1);
+		connection.Disconnect();
+		testQueue->Drain();
+		PGUI_CHECK(sum == 8);
+
+		testQueue.reset();
+	}
+
+	void ConcurrentEmitAndSubscribe()
+	{
+		Event<int> event;
+		std::atomic_long calls = 0;
+		std::atomic_bool stop = false;
+
+		{
+			std::vector<std::jthread> emitters;
+			for (auto i = 0; i < 4; i++)
+			{
+				emitters.emplace_back([&]
+				{
+					while (!stop)
+					{
+						event.Emit(1);
+					}
+				});
+			}
+
+			for (auto i = 0; i < 5000; i++)
+			{
+				auto connection = event.Subscribe([&calls](int value) { calls += value; });
+				ScopedEventConnection scoped = event.Subscribe([](int) { });
+				connection.Disconnect();
+			}
+			stop = true;
+		}
+
+		PGUI_CHECK(event.GetHandlerCount() == 0);
+	}
+}
+
+auto main() -> int
+{
+	SubscribeAndDisconnect();
+	HandlersChangeSubscriptionsWhileRunning();
+	DisconnectedLaterInTheSameEmit();
+	ClearAndConnectionsOutlivingTheEvent();
+	MovedEventsKeepTheirHandlers();
+	EmitDoesNotAllocate();
+	SmallHandlersAreInline();
+	UIThreadDelivery();
+	ConcurrentEmitAndSubscribe();
+
+	return PGUI::Tests::Finish();
+}
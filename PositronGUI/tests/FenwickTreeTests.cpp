@@ -0,0 +1,144 @@
+#include "Check.hpp"
+#include "helpers/FenwickTree.hpp"
+
+#include <numeric>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+	using PGUI::FenwickTree;
+
+	// What ListView did before the index, walk the heights until one contains the offset
+	auto LinearFind(const std::vector<long>& heights, long offset) -> std::size_t
+	{
+		if (offset < 0)
+		{
+			return heights.size();
+		}
+
+		std::size_t index = 0;
+		for (long top = 0; index < heights.size(); index++)
+		{
+			top += heights[index];
+			if (offset < top)
+			{
+				break;
+			}
+		}
+		return index;
+	}
+
+	void CheckAgainst(const FenwickTree<long>& tree, const std::vector<long>& heights, std::mt19937& random)
+	{
+		PGUI_CHECK(tree.Size() == heights.size());
+
+		const auto total = std::accumulate(heights.begin(), heights.end(), 0L);
+		PGUI_CHECK(tree.Total() == total);
+
+		for (std::size_t count = 0; count <= heights.size(); count++)
+		{
+			PGUI_CHECK(tree.PrefixSum(count) == std::accumulate(heights.begin(), heights.begin() + count, 0L));
+		}
+
+		std::uniform_int_distribution<long> offsets{ -5, total + 5 };
+		for (auto i = 0; i < 64; i++)
+		{
+			const auto offset = offsets(random);
+			PGUI_CHECK(tree.Find(offset) == LinearFind(heights, offset));
+		}
+	}
+
+	void EmptyTree()
+	{
+		FenwickTree<long> tree;
+		PGUI_CHECK(tree.IsEmpty());
+		PGUI_CHECK(tree.Total() == 0);
+		PGUI_CHECK(tree.Find(0) == 0);
+		PGUI_CHECK(tree.Find(-1) == 0);
+	}
+
+	void RowBoundaries()
+	{
+		const std::vector<long> heights{ 10, 20, 0, 30 };
+		const FenwickTree<long> tree{ heights };
+
+		PGUI_CHECK(tree.Find(0) == 0);
+		PGUI_CHECK(tree.Find(9) == 0);
+		PGUI_CHECK(tree.Find(10) == 1);
+		PGUI_CHECK(tree.Find(29) == 1);
+		// Zero height rows are never hit
+		PGUI_CHECK(tree.Find(30) == 3);
+		PGUI_CHECK(tree.Find(59) == 3);
+		PGUI_CHECK(tree.Find(60) == 4);
+		PGUI_CHECK(tree.Find(-1) == 4);
+	}
+
+	void RandomEdits()
+	{
+		std::mt19937 random{ 2 };
+		std::uniform_int_distribution<long> heightDistribution{ 0, 100 };
+
+		FenwickTree<long> tree;
+		std::vector<long> heights;
+
+		for (auto step = 0; step < 2000; step++)
+		{
+			switch (random() % 5)
+			{
+				case 0:
+				case 1:
+				{
+					heights.push_back(heightDistribution(random));
+					tree.PushBack(heights.back());
+					break;
+				}
+				case 2:
+				{
+					if (!heights.empty())
+					{
+						heights.pop_back();
+						tree.PopBack();
+					}
+					break;
+				}
+				case 3:
+				{
+					if (!heights.empty())
+					{
+						const auto index = random() % heights.size();
+						heights[index] = heightDistribution(random);
+						tree.Set(index, heights[index]);
+					}
+					break;
+				}
+				default:
+				{
+					if (random() % 50 == 0)
+					{
+						tree.Assign(heights);
+					}
+					break;
+				}
+			}
+
+			if (step % 20 == 0)
+			{
+				CheckAgainst(tree, heights, random);
+			}
+		}
+
+		tree.Clear();
+		PGUI_CHECK(tree.IsEmpty() && tree.Total() == 0);
+	}
+}
+
+auto main() -> int
+{
+	EmptyTree();
+	RowBoundaries();
+	RandomEdits();
+
+	return PGUI::Tests::Finish();
+}
@@ -0,0 +1,170 @@
+#include "Check.hpp"
+#include "core/FramePacer.hpp"
+
+#include <chrono>
+#include <cstdint>
+
+
+namespace
+{
+	using namespace PGUI::Core;
+	using namespace std::chrono_literals;
+	using Duration = IFrameClock::Duration;
+
+	// Time only moves when the test moves it
+	class FakeFrameClock final : public IFrameClock
+	{
+		public:
+		[[nodiscard]] auto Now() const noexcept -> TimePoint override { return now; }
+
+		void Advance(Duration duration) noexcept { now += duration; }
+
+		private:
+		TimePoint now{ 1s };
+	};
+
+	void SchedulesSlots()
+	{
+		FakeFrameClock clock;
+		FramePacer pacer{ 10ms, clock };
+
+		// The first frame is due right away and has no frame time
+		PGUI_CHECK(pacer.IsFrameDue());
+		PGUI_CHECK(pacer.GetNextFrameTime() == clock.Now());
+		PGUI_CHECK(pacer.BeginFrame() == Duration::zero());
+		PGUI_CHECK(pacer.GetStatistics().GetFrameCount() == 0);
+
+		PGUI_CHECK(!pacer.IsFrameDue());
+		PGUI_CHECK(pacer.GetTimeUntilNextFrame() == 10ms);
+
+		clock.Advance(4ms);
+		PGUI_CHECK(!pacer.IsFrameDue());
+		PGUI_CHECK(pacer.GetTimeUntilNextFrame() == 6ms);
+
+		clock.Advance(6ms);
+		PGUI_CHECK(pacer.IsFrameDue());
+		PGUI_CHECK(pacer.GetTimeUntilNextFrame() == Duration::zero());
+
+		// A frame a little late keeps the slots, the next one is still on the 10 ms grid
+		clock.Advance(1ms);
+		PGUI_CHECK(pacer.BeginFrame() == 11ms);
+		PGUI_CHECK(pacer.GetTimeUntilNextFrame() == 9ms);
+		PGUI_CHECK(pacer.GetStatistics().GetFrameCount() == 1);
+		PGUI_CHECK(pacer.GetStatistics().GetMissedFrameCount() == 0);
+
+		// Changing the target moves the next slot relative to the last frame
+		pacer.SetTargetFrameTime(20ms);
+		PGUI_CHECK(pacer.GetTargetFrameTime() == 20ms);
+		PGUI_CHECK(pacer.GetTimeUntilNextFrame() == 20ms);
+
+		pacer.SetTargetFrameTime(Duration::zero());
+		PGUI_CHECK(pacer.GetTargetFrameTime() == Duration{ 1 });
+	}
+
+	void CountsMissedFrames()
+	{
+		FakeFrameClock clock;
+		FramePacer pacer{ 10ms, clock };
+		pacer.BeginFrame();
+
+		// Started at 46 ms, the 10, 20 and 30 ms slots went by without a frame and this one takes the 40 ms slot
+		clock.Advance(46ms);
+		PGUI_CHECK(pacer.BeginFrame() == 46ms);
+		PGUI_CHECK(pacer.GetStatistics().GetMissedFrameCount() == 3);
+		// The skipped slots aren't caught up, the next frame goes on the 50 ms slot
+		PGUI_CHECK(pacer.GetTimeUntilNextFrame() == 4ms);
+
+		// Early frames don't miss anything and don't move the schedule back
+		clock.Advance(1ms);
+		pacer.BeginFrame();
+		PGUI_CHECK(pacer.GetStatistics().GetMissedFrameCount() == 3);
+		PGUI_CHECK(pacer.GetTimeUntilNextFrame() == 13ms);
+
+		// Starting exactly on the slot isn't late
+		clock.Advance(13ms);
+		pacer.BeginFrame();
+		PGUI_CHECK(pacer.GetStatistics().GetMissedFrameCount() == 3);
+		PGUI_CHECK(pacer.GetStatistics().GetFrameCount() == 3);
+
+		pacer.ResetStatistics();
+		PGUI_CHECK(pacer.GetStatistics().GetFrameCount() == 0);
+		PGUI_CHECK(pacer.GetStatistics().GetMissedFrameCount() == 0);
+		PGUI_CHECK(pacer.GetStatistics().GetAverageFrameTime() == Duration::zero());
+	}
+
+	void Percentiles()
+	{
+		FrameStatistics statistics{ 100 };
+		PGUI_CHECK(statistics.GetAverageFrameTime() == Duration::zero());
+		PGUI_CHECK(statistics.GetP99FrameTime() == Duration::zero());
+
+		// 1 ms to 100 ms, added out of order
+		for (std::int64_t i = 0; i < 100; i++)
+		{
+			statistics.AddFrame(std::chrono::milliseconds{ (i * 37) % 100 + 1 }, 0);
+		}
+		PGUI_CHECK(statistics.GetFrameCount() == 100);
+		PGUI_CHECK(statistics.GetAverageFrameTime() == 50500us);
+		PGUI_CHECK(statistics.GetPercentileFrameTime(0.5) == 50ms);
+		PGUI_CHECK(statistics.GetPercentileFrameTime(0.901) == 91ms);
+		PGUI_CHECK(statistics.GetP99FrameTime() == 99ms);
+		PGUI_CHECK(statistics.GetMaxFrameTime() == 100ms);
+		PGUI_CHECK(statistics.GetPercentileFrameTime(0.0) == 1ms);
+		// Out of range percentiles are clamped
+		PGUI_CHECK(statistics.GetPercentileFrameTime(-1.0) == 1ms);
+		PGUI_CHECK(statistics.GetPercentileFrameTime(2.0) == 100ms);
+
+		// One slow frame in a hundred is the p99 and not the average
+		FrameStatistics spike{ 100 };
+		for (auto i = 0; i < 99; i++)
+		{
+			spike.AddFrame(10ms, 0);
+		}
+		spike.AddFrame(50ms, 4);
+		PGUI_CHECK(spike.GetP99FrameTime() == 10ms);
+		PGUI_CHECK(spike.GetMaxFrameTime() == 50ms);
+		PGUI_CHECK(spike.GetAverageFrameTime() == 10400us);
+		PGUI_CHECK(spike.GetMissedFrameCount() == 4);
+	}
+
+	void SlidingWindow()
+	{
+		FrameStatistics statistics{ 4 };
+		PGUI_CHECK(statistics.GetWindowSize() == 4);
+
+		for (std::int64_t i = 1; i <= 10; i++)
+		{
+			statistics.AddFrame(Duration{ i }, 1);
+		}
+		// Only 7 to 10 are left in the window, the totals still count all of them
+		PGUI_CHECK(statistics.GetAverageFrameTime() == Duration{ 8 });
+		PGUI_CHECK(statistics.GetMaxFrameTime() == Duration{ 10 });
+		PGUI_CHECK(statistics.GetPercentileFrameTime(0.0) == Duration{ 7 });
+		PGUI_CHECK(statistics.GetFrameCount() == 10);
+		PGUI_CHECK(statistics.GetMissedFrameCount() == 10);
+
+		// A window of zero keeps the last frame
+		FrameStatistics single{ 0 };
+		PGUI_CHECK(single.GetWindowSize() == 1);
+		single.AddFrame(5ms, 0);
+		single.AddFrame(3ms, 0);
+		PGUI_CHECK(single.GetAverageFrameTime() == 3ms);
+		PGUI_CHECK(single.GetMaxFrameTime() == 3ms);
+
+		statistics.Reset();
+		PGUI_CHECK(statistics.GetFrameCount() == 0);
+		PGUI_CHECK(statistics.GetMaxFrameTime() == Duration::zero());
+		statistics.AddFrame(Duration{ 2 }, 0);
+		PGUI_CHECK(statistics.GetAverageFrameTime() == Duration{ 2 });
+	}
+}
+
+auto main() -> int
+{
+	SchedulesSlots();
+	CountsMissedFrames();
+	Percentiles();
+	SlidingWindow();
+
+	return PGUI::Tests::Finish();
+}
@@ -0,0 +1,485 @@
+#include "Check.hpp"
+#include "helpers/CpuFeatures.hpp"
+#include "ui/bmp/GifDecoder.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <random>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+	using namespace PGUI::UI::Bmp;
+
+	struct Rgb
+	{
+		std::uint8_t r, g, b;
+	};
+
+	auto ToBgra(Rgb color) noexcept -> std::uint32_t
+	{
+		return 0xFF000000U | (std::uint32_t{ color.r } << 16) | (std::uint32_t{ color.g } << 8) | color.b;
+	}
+
+	/*
+	* Plain LZW encoder, deferredClear keeps using a full table instead of clearing it
+	* like some encoders do, both have to decode the same
+	*/
+	auto EncodeLzw(const std::vector<std::uint8_t>& indices, std::uint8_t minCodeSize, bool deferredClear)
+		-> std::vector<std::uint8_t>
+	{
+		const std::uint32_t clearCode = 1U << minCodeSize;
+		const std::uint32_t endCode = clearCode + 1;
+
+		std::vector<std::uint8_t> bytes;
+		std::uint32_t accumulator = 0;
+		std::uint32_t bitCount = 0;
+		auto write = [&](std::uint32_t code, std::uint32_t size)
+		{
+			accumulator |= code << bitCount;
+			bitCount += size;
+			while (bitCount >= 8)
+			{
+				bytes.push_back(static_cast<std::uint8_t>(accumulator));
+				accumulator >>= 8;
+				bitCount -= 8;
+			}
+		};
+
+		std::unordered_map<std::uint32_t, std::uint32_t> table;
+		std::uint32_t nextCode = endCode + 1;
+		std::uint32_t codeSize = minCodeSize + 1U;
+		write(clearCode, codeSize);
+
+		std::optional<std::uint32_t> prefix;
+		for (const auto index : indices)
+		{
+			if (!prefix.has_value())
+			{
+				prefix = index;
+				continue;
+			}
+
+			const auto key = (*prefix << 8) | index;
+			if (const auto iter = table.find(key);
+				iter != table.end())
+			{
+				prefix = iter->second;
+				continue;
+			}
+
+			write(*prefix, codeSize);
+			if (nextCode < 4096)
+			{
+				table[key] = nextCode++;
+				if (nextCode > (1U << codeSize) && codeSize < 12)
+				{
+					codeSize++;
+				}
+			}
+			else if (!deferredClear)
+			{
+				write(clearCode, codeSize);
+				table.clear();
+				nextCode = endCode + 1;
+				codeSize = minCodeSize + 1U;
+			}
+			prefix = index;
+		}
+		if (prefix.has_value())
+		{
+			write(*prefix, codeSize);
+		}
+		write(endCode, codeSize);
+		if (bitCount != 0)
+		{
+			bytes.push_back(static_cast<std::uint8_t>(accumulator));
+		}
+
+		std::vector<std::uint8_t> subBlocks;
+		for (std::size_t i = 0; i < bytes.size(); i += 255)
+		{
+			const auto length = std::min<std::size_t>(255, bytes.size() - i);
+			subBlocks.push_back(static_cast<std::uint8_t>(length));
+			subBlocks.insert(subBlocks.end(), bytes.begin() + static_cast<std::ptrdiff_t>(i),
+				bytes.begin() + static_cast<std::ptrdiff_t>(i + length));
+		}
+		subBlocks.push_back(0);
+		return subBlocks;
+	}
+
+	/*
+	* Random animated GIF and the canvas every frame should compose to,
+	* worked out the simple way with the same disposal rules
+	*/
+	struct TestGif
+	{
+		std::vector<std::byte> file;
+		std::uint32_t width = 0;
+		std::uint32_t height = 0;
+		std::vector<std::vector<std::uint32_t>> expectedCanvases;
+		// File size at the end of each frame's image data
+		std::vector<std::size_t> frameEnds;
+	};
+
+	auto MakeTestGif(std::mt19937& random) -> TestGif
+	{
+		auto uniform = [&random](int low, int high)
+		{
+			return std::uniform_int_distribution{ low, high }(random);
+		};
+		auto chance = [&random](double probability)
+		{
+			return std::bernoulli_distribution{ probability }(random);
+		};
+		auto randomPalette = [&](int bits)
+		{
+			std::vector<Rgb> palette(std::size_t{ 2 } << bits);
+			for (auto& color : palette)
+			{
+				color = Rgb{ static_cast<std::uint8_t>(uniform(0, 255)),
+					static_cast<std::uint8_t>(uniform(0, 255)), static_cast<std::uint8_t>(uniform(0, 255)) };
+			}
+			return palette;
+		};
+
+		TestGif gif;
+		gif.width = static_cast<std::uint32_t>(uniform(20, 90));
+		gif.height = static_cast<std::uint32_t>(uniform(20, 90));
+
+		std::vector<std::uint8_t> out;
+		auto put16 = [&out](std::uint32_t value)
+		{
+			out.push_back(static_cast<std::uint8_t>(value));
+			out.push_back(static_cast<std::uint8_t>(value >> 8));
+		};
+		auto putPalette = [&out](const std::vector<Rgb>& palette)
+		{
+			for (const auto& color : palette)
+			{
+				out.insert(out.end(), { color.r, color.g, color.b });
+			}
+		};
+
+		const auto globalBits = uniform(0, 7);
+		const auto globalPalette = randomPalette(globalBits);
+
+		for (const auto character : std::string_view{ "GIF89a" })
+		{
+			out.push_back(static_cast<std::uint8_t>(character));
+		}
+		put16(gif.width);
+		put16(gif.height);
+		out.push_back(static_cast<std::uint8_t>(0x80 | globalBits));
+		out.push_back(static_cast<std::uint8_t>(uniform(0, static_cast<int>(globalPalette.size()) - 1)));
+		out.push_back(0);
+		putPalette(globalPalette);
+
+		// Loops three times, then a comment the parser has to skip
+		out.insert(out.end(), { 0x21, 0xFF, 0x0B });
+		for (const auto character : std::string_view{ "NETSCAPE2.0" })
+		{
+			out.push_back(static_cast<std::uint8_t>(character));
+		}
+		out.insert(out.end(), { 0x03, 0x01, 0x03, 0x00, 0x00 });
+		out.insert(out.end(), { 0x21, 0xFE, 0x05, 'h', 'e', 'l', 'l', 'o', 0x00 });
+
+		const auto width = gif.width;
+		const auto height = gif.height;
+		std::vector<std::uint32_t> canvas(static_cast<std::size_t>(width) * height, 0);
+
+		struct Previous
+		{
+			int disposal;
+			std::uint32_t left, top, width, height;
+			std::vector<std::uint32_t> saved;
+		};
+		std::optional<Previous> previous;
+
+		const auto frameCount = uniform(2, 12);
+		for (auto frame = 0; frame < frameCount; frame++)
+		{
+			if (previous.has_value())
+			{
+				for (auto y = previous->top; y < std::min(previous->top + previous->height, height); y++)
+				{
+					for (auto x = previous->left; x < std::min(previous->left + previous->width, width); x++)
+					{
+						const auto pixel = static_cast<std::size_t>(y) * width + x;
+						if (previous->disposal == 2)
+						{
+							canvas[pixel] = 0;
+						}
+						else if (previous->disposal == 3)
+						{
+							canvas[pixel] = previous->saved[pixel];
+						}
+					}
+				}
+			}
+
+			// The rect may run past the canvas
+			const auto frameWidth = static_cast<std::uint32_t>(uniform(1, static_cast<int>(width)));
+			const auto frameHeight = static_cast<std::uint32_t>(uniform(1, static_cast<int>(height)));
+			const auto left = static_cast<std::uint32_t>(uniform(0, static_cast<int>(width) - 1));
+			const auto top = static_cast<std::uint32_t>(uniform(0, static_cast<int>(height) - 1));
+			const auto disposal = uniform(0, 3);
+
+			const auto useLocalPalette = chance(0.3);
+			const auto localBits = uniform(0, 7);
+			const auto palette = useLocalPalette ? randomPalette(localBits) : globalPalette;
+			const auto colorCount = static_cast<int>(palette.size());
+
+			std::optional<std::uint8_t> transparentIndex;
+			if (chance(0.6))
+			{
+				transparentIndex = static_cast<std::uint8_t>(uniform(0, colorCount - 1));
+			}
+			const auto isInterlaced = chance(0.4);
+			const auto minCodeSize = static_cast<std::uint8_t>(std::max(2, static_cast<int>(std::bit_width(
+				static_cast<unsigned>(colorCount - 1)))));
+
+			std::vector<std::uint8_t> indices(static_cast<std::size_t>(frameWidth) * frameHeight);
+			for (std::uint32_t y = 0; y < frameHeight; y++)
+			{
+				for (std::uint32_t x = 0; x < frameWidth; x++)
+				{
+					indices[y * frameWidth + x] = static_cast<std::uint8_t>(chance(0.5) ?
+						uniform(0, colorCount - 1) : static_cast<int>((x / 4 + y / 4) % static_cast<std::uint32_t>(colorCount)));
+				}
+			}
+
+			auto saved = canvas;
+			for (std::uint32_t y = 0; y < frameHeight; y++)
+			{
+				for (std::uint32_t x = 0; x < frameWidth; x++)
+				{
+					const auto index = indices[y * frameWidth + x];
+					if (left + x >= width || top + y >= height || index == transparentIndex)
+					{
+						continue;
+					}
+					canvas[static_cast<std::size_t>(top + y) * width + left + x] = ToBgra(palette[index]);
+				}
+			}
+			gif.expectedCanvases.push_back(canvas);
+			previous = Previous{ disposal, left, top, frameWidth, frameHeight, std::move(saved) };
+
+			out.insert(out.end(), { 0x21, 0xF9, 0x04 });
+			out.push_back(static_cast<std::uint8_t>((disposal << 2) | (transparentIndex.has_value() ? 1 : 0)));
+			put16(static_cast<std::uint32_t>(uniform(0, 20)));
+			out.push_back(transparentIndex.value_or(0));
+			out.push_back(0);
+
+			out.push_back(0x2C);
+			put16(left);
+			put16(top);
+			put16(frameWidth);
+			put16(frameHeight);
+			out.push_back(static_cast<std::uint8_t>((useLocalPalette ? 0x80 | localBits : 0) | (isInterlaced ? 0x40 : 0)));
+			if (useLocalPalette)
+			{
+				putPalette(palette);
+			}
+
+			auto stream = indices;
+			if (isInterlaced)
+			{
+				stream.clear();
+				for (const auto& [start, step] : { std::pair{ 0U, 8U }, { 4U, 8U }, { 2U, 4U }, { 1U, 2U } })
+				{
+					for (auto row = start; row < frameHeight; row += step)
+					{
+						stream.insert(stream.end(), indices.begin() + row * frameWidth, indices.begin() + (row + 1) * frameWidth);
+					}
+				}
+			}
+
+			out.push_back(minCodeSize);
+			const auto data = EncodeLzw(stream, minCodeSize, chance(0.5));
+			out.insert(out.end(), data.begin(), data.end());
+			gif.frameEnds.push_back(out.size());
+		}
+		out.push_back(0x3B);
+
+		gif.file.resize(out.size());
+		std::ranges::transform(out, gif.file.begin(), [](std::uint8_t value) { return std::byte{ value }; });
+		return gif;
+	}
+
+	void ComposesRandomAnimations()
+	{
+		std::mt19937 random{ 1 };
+		for (auto seed = 0; seed < 60; seed++)
+		{
+			const auto gif = MakeTestGif(random);
+			const auto decoder = std::make_shared<const GifDecoder>(gif.file);
+
+			PGUI_CHECK(decoder->GetCanvasSize().cx == gif.width);
+			PGUI_CHECK(decoder->GetCanvasSize().cy == gif.height);
+			PGUI_CHECK(decoder->GetFrameCount() == gif.expectedCanvases.size());
+			PGUI_CHECK(decoder->GetLoopCount() == 3U);
+
+			GifComposer composer{ decoder };
+			auto matches = true;
+			// The second loop goes through the wrap around back to the first frame
+			for (auto loop = 0; loop < 2; loop++)
+			{
+				for (std::size_t frame = 0; frame < gif.expectedCanvases.size(); frame++)
+				{
+					const std::vector<std::uint32_t> before{ composer.GetCanvas().begin(), composer.GetCanvas().end() };
+					const auto changed = composer.ComposeFrame(frame);
+					const auto canvas = composer.GetCanvas();
+
+					matches = matches && std::ranges::equal(canvas, gif.expectedCanvases[frame]);
+					for (std::size_t pixel = 0; frame != 0 && pixel < canvas.size(); pixel++)
+					{
+						const auto x = static_cast<std::uint32_t>(pixel % gif.width);
+						const auto y = static_cast<std::uint32_t>(pixel / gif.width);
+						const auto isInChanged = x >= changed.left && x < changed.right && y >= changed.top && y < changed.bottom;
+						matches = matches && (isInChanged || before[pixel] == canvas[pixel]);
+					}
+				}
+			}
+			PGUI_CHECK(matches);
+
+			// Out of order composes again from the start
+			composer.ComposeFrame(gif.expectedCanvases.size() - 1);
+			composer.ComposeFrame(1);
+			PGUI_CHECK(std::ranges::equal(composer.GetCanvas(), gif.expectedCanvases[1]));
+		}
+	}
+
+	void TruncatedFilesKeepCompleteFrames()
+	{
+		std::mt19937 random{ 2 };
+		for (auto seed = 0; seed < 20; seed++)
+		{
+			const auto gif = MakeTestGif(random);
+
+			// Cut inside the last frame's image data
+			const auto lastComplete = gif.frameEnds.size() - 2;
+			auto truncated = gif.file;
+			truncated.resize(gif.frameEnds.back() - 2);
+
+			const auto decoder = std::make_shared<const GifDecoder>(std::move(truncated));
+			PGUI_CHECK(decoder->GetFrameCount() == lastComplete + 1);
+
+			GifComposer composer{ decoder };
+			for (std::size_t frame = 0; frame <= lastComplete; frame++)
+			{
+				composer.ComposeFrame(frame);
+			}
+			PGUI_CHECK(std::ranges::equal(composer.GetCanvas(), gif.expectedCanvases[lastComplete]));
+		}
+
+		auto threw = false;
+		try
+		{
+			std::ignore = GifDecoder{ std::vector<std::byte>(20, std::byte{ 'G' }) };
+		}
+		catch (const GifFormatException&)
+		{
+			threw = true;
+		}
+		PGUI_CHECK(threw);
+	}
+
+	void SurvivesCorruption()
+	{
+		std::mt19937 random{ 3 };
+		const auto gif = MakeTestGif(random);
+
+		auto decoded = 0;
+		auto rejected = 0;
+		for (auto iteration = 0; iteration < 2000; iteration++)
+		{
+			auto corrupt = gif.file;
+			if (iteration % 3 == 0)
+			{
+				corrupt.resize(random() % corrupt.size());
+			}
+			else
+			{
+				for (auto change = 0U; change < 1 + random() % 8; change++)
+				{
+					corrupt[random() % corrupt.size()] = std::byte{ static_cast<std::uint8_t>(random()) };
+				}
+			}
+
+			try
+			{
+				const auto decoder = std::make_shared<const GifDecoder>(std::move(corrupt));
+				GifComposer composer{ decoder };
+				for (std::size_t frame = 0; frame < decoder->GetFrameCount(); frame++)
+				{
+					composer.ComposeFrame(frame);
+				}
+				decoded++;
+			}
+			catch (const GifFormatException&)
+			{
+				rejected++;
+			}
+			catch (const std::bad_alloc&)
+			{
+				rejected++;
+			}
+		}
+		PGUI_CHECK(decoded + rejected == 2000);
+		PGUI_CHECK(decoded > 0);
+	}
+
+	void VectorExpansionMatchesScalar()
+	{
+		if (!PGUI::CpuFeatures::Get().avx2)
+		{
+			return;
+		}
+
+		std::mt19937 random{ 4 };
+		GifPalette palette{ };
+		for (auto& color : palette)
+		{
+			color = random() | 0xFF000000U;
+		}
+
+		for (const auto count : { 0U, 1U, 7U, 31U, 32U, 33U, 100U, 4096U })
+		{
+			std::vector<std::uint8_t> indices(count);
+			for (auto& index : indices)
+			{
+				index = static_cast<std::uint8_t>(random());
+			}
+
+			for (const auto transparentIndex : { std::optional<std::uint8_t>{ }, std::optional<std::uint8_t>{ indices.empty() ? 0 : indices[0] } })
+			{
+				std::vector<std::uint32_t> scalar(count, 0x12345678U);
+				std::vector<std::uint32_t> vector(count, 0x12345678U);
+				gif_detail::ExpandPaletteIndicesScalar(indices, palette, transparentIndex, scalar.data());
+				gif_detail::ExpandPaletteIndicesAvx2(indices, palette, transparentIndex, vector.data());
+				PGUI_CHECK(scalar == vector);
+			}
+		}
+	}
+}
+
+auto main() -> int
+{
+	ComposesRandomAnimations();
+	TruncatedFilesKeepCompleteFrames();
+	SurvivesCorruption();
+	VectorExpansionMatchesScalar();
+
+	return PGUI::Tests::Finish();
+}
@@ -0,0 +1,226 @@
+#include "Check.hpp"
+#include "core/MessageDispatchTable.hpp"
+
+#include <cstddef>
+#include <vector>
+
+
+namespace
+{
+	using namespace PGUI::Core;
+
+	struct TestWindow
+	{
+		int callCount = 0;
+
+		auto OnMessage(UINT msg, WPARAM, LPARAM) -> HandlerResult
+		{
+			callCount++;
+			return static_cast<LRESULT>(msg);
+		}
+		auto OnMessageConst(UINT, WPARAM wParam, LPARAM) const -> HandlerResult
+		{
+			return static_cast<LRESULT>(wParam);
+		}
+	};
+
+	/*
+	* Messages below WM_USER go through the dense slots
+	*/
+	void DenseMessages()
+	{
+		TestWindow window;
+		MessageDispatchTable table;
+
+		for (const auto msg : { WM_PAINT, WM_CREATE, WM_MOUSEMOVE, WM_NCHITTEST, WM_SIZE })
+		{
+			table.Add(msg, MessageHandlerRef{ &window, &TestWindow::OnMessage });
+		}
+		table.Add(WM_MOUSEMOVE, MessageHandlerRef{ static_cast<const TestWindow*>(&window), &TestWindow::OnMessageConst });
+
+		PGUI_CHECK(table.GetMessageCount() == 5);
+		PGUI_CHECK(table.GetHandlerCount() == 6);
+		PGUI_CHECK(table.Contains(WM_CREATE));
+		PGUI_CHECK(table.Contains(WM_NCHITTEST));
+		PGUI_CHECK(!table.Contains(WM_DESTROY));
+		PGUI_CHECK(!table.Contains(WM_LBUTTONDOWN));
+		PGUI_CHECK(table.Find(WM_MOUSEMOVE).size() == 2);
+		PGUI_CHECK(table.Find(WM_PAINT).size() == 1);
+
+		auto result = table.Dispatch(WM_PAINT, 0, 0);
+		PGUI_CHECK(result.handled);
+		PGUI_CHECK(result.result == WM_PAINT);
+		PGUI_CHECK(!result.passToDefWindowProc);
+
+		// Handlers run in the order they were added, the last one's result wins
+		result = table.Dispatch(WM_MOUSEMOVE, 42, 0);
+		PGUI_CHECK(result.result == 42);
+		PGUI_CHECK(window.callCount == 2);
+
+		result = table.Dispatch(WM_DESTROY, 0, 0);
+		PGUI_CHECK(!result.handled);
+		PGUI_CHECK(window.callCount == 2);
+
+		table.Clear();
+		PGUI_CHECK(table.GetMessageCount() == 0);
+		PGUI_CHECK(!table.Contains(WM_PAINT));
+		PGUI_CHECK(!table.Dispatch(WM_PAINT, 0, 0).handled);
+	}
+
+	/*
+	* Past 254 dense messages the slots overflow into the binary search,
+	* and WM_USER and up always use it
+	*/
+	void SparseMessages()
+	{
+		TestWindow window;
+		MessageDispatchTable table;
+
+		constexpr UINT RegisteredMessage = 0xC123;
+		const UINT sparseMessages[] = { RegisteredMessage, WM_USER + 7, WM_USER, 0xFFFF };
+		for (const auto msg : sparseMessages)
+		{
+			table.Add(msg, MessageHandlerRef{ &window, &TestWindow::OnMessage });
+		}
+		PGUI_CHECK(table.Contains(WM_USER));
+		PGUI_CHECK(table.Contains(WM_USER + 7));
+		PGUI_CHECK(table.Contains(RegisteredMessage));
+		PGUI_CHECK(table.Contains(0xFFFF));
+		PGUI_CHECK(!table.Contains(WM_USER + 1));
+		PGUI_CHECK(!table.Contains(RegisteredMessage + 1));
+		PGUI_CHECK(table.Dispatch(RegisteredMessage, 0, 0).result == RegisteredMessage);
+
+		for (UINT msg = 1; msg < 600; msg += 2)
+		{
+			table.Add(msg, MessageHandlerRef{ &window, &TestWindow::OnMessage });
+		}
+		bool allFound = true;
+		for (UINT msg = 0; msg < 600; msg++)
+		{
+			const auto expected = msg % 2 == 1 || msg == WM_USER;
+			allFound = allFound && table.Contains(msg) == expected;
+		}
+		PGUI_CHECK(allFound);
+		PGUI_CHECK(table.Dispatch(599, 0, 0).result == 599);
+		PGUI_CHECK(table.Find(RegisteredMessage).size() == 1);
+	}
+
+	void CombinesResults()
+	{
+		MessageDispatchTable table;
+
+		auto returnsOne = [](UINT, WPARAM, LPARAM) -> HandlerResult { return 1; };
+		auto keepsPrevious = [](UINT, WPARAM, LPARAM) -> HandlerResult
+		{
+			return { 2, HandlerResultFlag::ReturnPrevResult };
+		};
+		auto forcesThree = [](UINT, WPARAM, LPARAM) -> HandlerResult
+		{
+			return { 3, HandlerResultFlag::ForceThisResult };
+		};
+		auto passesFour = [](UINT, WPARAM, LPARAM) -> HandlerResult
+		{
+			return { 4, HandlerResultFlag::PassToDefWindowProc };
+		};
+		auto stopsAtFive = [](UINT, WPARAM, LPARAM) -> HandlerResult
+		{
+			return { 5, HandlerResultFlag::NoFurtherHandling };
+		};
+		int lateCallCount = 0;
+		auto late = [&lateCallCount](UINT, WPARAM, LPARAM) -> HandlerResult
+		{
+			lateCallCount++;
+			return 6;
+		};
+
+		table.Add(WM_SIZE, MessageHandlerRef::FromCallable(returnsOne));
+		table.Add(WM_SIZE, MessageHandlerRef::FromCallable(keepsPrevious));
+		PGUI_CHECK(table.Dispatch(WM_SIZE, 0, 0).result == 1);
+
+		table.Add(WM_SIZE, MessageHandlerRef::FromCallable(passesFour));
+		auto result = table.Dispatch(WM_SIZE, 0, 0);
+		PGUI_CHECK(result.result == 4);
+		PGUI_CHECK(result.passToDefWindowProc);
+
+		// After ForceThisResult the later handlers still run but their flags are ignored
+		table.Add(WM_CHAR, MessageHandlerRef::FromCallable(forcesThree));
+		table.Add(WM_CHAR, MessageHandlerRef::FromCallable(passesFour));
+		result = table.Dispatch(WM_CHAR, 0, 0);
+		PGUI_CHECK(result.result == 4);
+		PGUI_CHECK(!result.passToDefWindowProc);
+
+		table.Add(WM_TIMER, MessageHandlerRef::FromCallable(passesFour));
+		table.Add(WM_TIMER, MessageHandlerRef::FromCallable(stopsAtFive));
+		table.Add(WM_TIMER, MessageHandlerRef::FromCallable(late));
+		result = table.Dispatch(WM_TIMER, 0, 0);
+		PGUI_CHECK(result.result == 5);
+		PGUI_CHECK(result.passToDefWindowProc);
+		PGUI_CHECK(lateCallCount == 0);
+	}
+
+	/*
+	* Adding a handler from inside a handler moves the array Dispatch is walking
+	*/
+	void AddDuringDispatch()
+	{
+		MessageDispatchTable table;
+
+		int lateCallCount = 0;
+		auto late = [&lateCallCount](UINT, WPARAM, LPARAM) -> HandlerResult
+		{
+			lateCallCount++;
+			return 2;
+		};
+		auto registersMore = [&table, &late](UINT, WPARAM, LPARAM) -> HandlerResult
+		{
+			for (UINT msg = 1; msg < 64; msg++)
+			{
+				table.Add(msg, MessageHandlerRef::FromCallable(late));
+			}
+			return 1;
+		};
+		table.Add(WM_CREATE, MessageHandlerRef::FromCallable(registersMore));
+
+		const auto result = table.Dispatch(WM_CREATE, 0, 0);
+		PGUI_CHECK(result.handled);
+		PGUI_CHECK(result.result == 2);
+		PGUI_CHECK(lateCallCount == 1);
+		PGUI_CHECK(table.GetMessageCount() == 63);
+	}
+
+	void Replay()
+	{
+		TestWindow window;
+		MessageDispatchTable table;
+		table.Add(WM_MOUSEMOVE, MessageHandlerRef{ &window, &TestWindow::OnMessage });
+		table.Add(WM_USER + 1, MessageHandlerRef{ &window, &TestWindow::OnMessage });
+
+		const std::vector<RecordedMessage> messages{
+			{ WM_MOUSEMOVE, 0, 0 },
+			{ WM_NCHITTEST, 0, 0 },
+			{ WM_USER + 1, 0, 0 },
+			{ WM_SETCURSOR, 0, 0 }
+		};
+
+		const auto benchmarkResult = ReplayMessages(table, messages, 3);
+		PGUI_CHECK(benchmarkResult.messageCount == 12);
+		PGUI_CHECK(benchmarkResult.handledCount == 6);
+		PGUI_CHECK(window.callCount == 6);
+		PGUI_CHECK(benchmarkResult.NanosecondsPerMessage() >= 0.0);
+
+		const auto empty = ReplayMessages(table, { });
+		PGUI_CHECK(empty.messageCount == 0);
+		PGUI_CHECK(empty.NanosecondsPerMessage() == 0.0);
+	}
+}
+
+auto main() -> int
+{
+	DenseMessages();
+	SparseMessages();
+	CombinesResults();
+	AddDuringDispatch();
+	Replay();
+
+	return PGUI::Tests::Finish();
+}
@@ -0,0 +1,271 @@
+#include "Check.hpp"
+#include "graphics/PixelConversion.hpp"
+#include "helpers/CpuFeatures.hpp"
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#if PGUI_X86
+#include <immintrin.h>
+#endif
+
+
+namespace
+{
+	using namespace PGUI;
+	using namespace PGUI::Graphics;
+
+#if PGUI_X86
+	__attribute__((target("f16c"))) auto HardwareFloatToHalf(float value) noexcept -> std::uint16_t
+	{
+		return static_cast<std::uint16_t>(_cvtss_sh(value, 0));
+	}
+	__attribute__((target("f16c"))) auto HardwareHalfToFloat(std::uint16_t half) noexcept -> float
+	{
+		return _cvtsh_ss(half);
+	}
+#endif
+
+	/*
+	* Every pair of alpha and one color byte, with the other two color bytes derived from them
+	*/
+	auto AlphaColorPairs() -> std::vector<std::uint32_t>
+	{
+		// Not a multiple of any vector width, so the scalar tails run too
+		std::vector<std::uint32_t> pixels(65536 * 4 + 13);
+		for (std::size_t i = 0; i < pixels.size(); i++)
+		{
+			const auto alpha = static_cast<std::uint32_t>(i >> 8) & 0xFF;
+			const auto color = static_cast<std::uint32_t>(i) & 0xFF;
+			pixels[i] = alpha << 24 | color << 16 | ((color * 7 + alpha) & 0xFF) << 8 | ((color ^ alpha) & 0xFF);
+		}
+		return pixels;
+	}
+
+	auto RandomPixels() -> std::vector<std::uint32_t>
+	{
+		std::mt19937 engine{ 1 };
+		std::vector<std::uint32_t> pixels(100003);
+		for (auto& pixel : pixels)
+		{
+			pixel = static_cast<std::uint32_t>(engine());
+		}
+		return pixels;
+	}
+
+	void HalfConversionsMatchF16c()
+	{
+#if PGUI_X86
+		if (!CpuFeatures::Get().f16c)
+		{
+			return;
+		}
+
+		auto matches = true;
+		// A stride coprime with every field width still reaches every exponent and both signs
+		for (std::uint64_t bits = 0; bits < (1ULL << 32); bits += 65537)
+		{
+			const auto value = std::bit_cast<float>(static_cast<std::uint32_t>(bits));
+			matches = matches && pixel_detail::FloatToHalf(value) == HardwareFloatToHalf(value);
+		}
+		for (const auto value : { 0.0F, -0.0F, 65504.0F, 65520.0F, 5.9604645e-8F, 2.9802322e-8F,
+			INFINITY, -INFINITY, NAN })
+		{
+			matches = matches && pixel_detail::FloatToHalf(value) == HardwareFloatToHalf(value);
+		}
+		PGUI_CHECK(matches);
+
+		matches = true;
+		for (std::uint32_t half = 0; half < 65536; half++)
+		{
+			const auto expected = HardwareHalfToFloat(static_cast<std::uint16_t>(half));
+			const auto actual = pixel_detail::HalfToFloat(static_cast<std::uint16_t>(half));
+			matches = matches && (std::isnan(expected) ?
+				std::isnan(actual) : std::bit_cast<std::uint32_t>(actual) == std::bit_cast<std::uint32_t>(expected));
+		}
+		PGUI_CHECK(matches);
+#endif
+	}
+
+	void VectorKernelsMatchScalar(const PixelKernels& kernels)
+	{
+		const auto& scalar = GetPixelKernels(PixelKernelLevel::Scalar);
+
+		for (const auto& source : { AlphaColorPairs(), RandomPixels() })
+		{
+			const auto count = source.size();
+			std::vector<std::uint32_t> expected(count);
+			std::vector<std::uint32_t> actual(count);
+
+			scalar.swapRedBlue(source.data(), expected.data(), count);
+			kernels.swapRedBlue(source.data(), actual.data(), count);
+			PGUI_CHECK(actual == expected);
+
+			scalar.premultiply(source.data(), expected.data(), count);
+			kernels.premultiply(source.data(), actual.data(), count);
+			PGUI_CHECK(actual == expected);
+
+			auto inPlace = source;
+			kernels.premultiply(inPlace.data(), inPlace.data(), count);
+			PGUI_CHECK(inPlace == expected);
+
+			scalar.unpremultiply(source.data(), expected.data(), count);
+			kernels.unpremultiply(source.data(), actual.data(), count);
+			PGUI_CHECK(actual == expected);
+
+			std::vector<std::uint16_t> expected565(count);
+			std::vector<std::uint16_t> actual565(count);
+			scalar.bgra8ToBgr565(source.data(), expected565.data(), count);
+			kernels.bgra8ToBgr565(source.data(), actual565.data(), count);
+			PGUI_CHECK(actual565 == expected565);
+
+			std::vector<std::uint64_t> expectedHalves(count);
+			std::vector<std::uint64_t> actualHalves(count);
+			for (const auto srgb : { false, true })
+			{
+				scalar.bgra8ToRgba16Float(source.data(), expectedHalves.data(), count, srgb);
+				kernels.bgra8ToRgba16Float(source.data(), actualHalves.data(), count, srgb);
+				PGUI_CHECK(actualHalves == expectedHalves);
+			}
+		}
+
+		std::vector<std::uint16_t> all565(65536 + 7);
+		for (std::size_t i = 0; i < all565.size(); i++)
+		{
+			all565[i] = static_cast<std::uint16_t>(i);
+		}
+		std::vector<std::uint32_t> expected(all565.size());
+		std::vector<std::uint32_t> actual(all565.size());
+		scalar.bgr565ToBgra8(all565.data(), expected.data(), all565.size());
+		kernels.bgr565ToBgra8(all565.data(), actual.data(), all565.size());
+		PGUI_CHECK(actual == expected);
+
+		std::vector<std::uint8_t> grays(999);
+		for (std::size_t i = 0; i < grays.size(); i++)
+		{
+			grays[i] = static_cast<std::uint8_t>(i * 37);
+		}
+		expected.assign(grays.size(), 0);
+		actual.assign(grays.size(), 0);
+		scalar.gray8ToBgra8(grays.data(), expected.data(), grays.size());
+		kernels.gray8ToBgra8(grays.data(), actual.data(), grays.size());
+		PGUI_CHECK(actual == expected);
+
+		// Every half in every channel, NaN and infinities included
+		std::vector<std::uint64_t> halves(65536 + 5);
+		for (std::size_t i = 0; i < halves.size(); i++)
+		{
+			const std::uint64_t half = i & 0xFFFF;
+			halves[i] = half | (half ^ 0x1234) << 16 | ((half * 3) & 0xFFFF) << 32 | ((half + 77) & 0xFFFF) << 48;
+		}
+		expected.assign(halves.size(), 0);
+		actual.assign(halves.size(), 0);
+		for (const auto srgb : { false, true })
+		{
+			scalar.rgba16FloatToBgra8(halves.data(), expected.data(), halves.size(), srgb);
+			kernels.rgba16FloatToBgra8(halves.data(), actual.data(), halves.size(), srgb);
+			PGUI_CHECK(actual == expected);
+		}
+	}
+
+	void ScalarKernelsConvert()
+	{
+		const auto& scalar = GetPixelKernels(PixelKernelLevel::Scalar);
+
+		std::uint32_t pixel = 0x80FF4000;
+		std::uint32_t result = 0;
+		scalar.premultiply(&pixel, &result, 1);
+		PGUI_CHECK(result == 0x80802000);
+		scalar.unpremultiply(&result, &pixel, 1);
+		PGUI_CHECK(pixel == 0x80FF4000);
+
+		const std::uint32_t transparent = 0x00123456;
+		scalar.unpremultiply(&transparent, &result, 1);
+		PGUI_CHECK(result == 0);
+
+		const std::uint32_t swapped = 0x11223344;
+		scalar.swapRedBlue(&swapped, &result, 1);
+		PGUI_CHECK(result == 0x11443322);
+
+		const std::uint16_t white = 0xFFFF;
+		scalar.bgr565ToBgra8(&white, &result, 1);
+		PGUI_CHECK(result == 0xFFFFFFFF);
+
+		const std::uint8_t gray = 0x42;
+		scalar.gray8ToBgra8(&gray, &result, 1);
+		PGUI_CHECK(result == 0xFF424242);
+	}
+
+	void RoundTripsAreLossless()
+	{
+		const auto& kernels = GetPixelKernels();
+
+		std::vector<std::uint32_t> pixels(256);
+		for (std::uint32_t i = 0; i < 256; i++)
+		{
+			pixels[i] = i * 0x01010101U;
+		}
+		std::vector<std::uint64_t> halves(pixels.size());
+		std::vector<std::uint32_t> back(pixels.size());
+		for (const auto srgb : { false, true })
+		{
+			kernels.bgra8ToRgba16Float(pixels.data(), halves.data(), pixels.size(), srgb);
+			kernels.rgba16FloatToBgra8(halves.data(), back.data(), halves.size(), srgb);
+			PGUI_CHECK(back == pixels);
+		}
+
+		std::vector<std::uint16_t> all565(65536);
+		for (std::uint32_t i = 0; i < 65536; i++)
+		{
+			all565[i] = static_cast<std::uint16_t>(i);
+		}
+		std::vector<std::uint32_t> expanded(all565.size());
+		std::vector<std::uint16_t> packed(all565.size());
+		kernels.bgr565ToBgra8(all565.data(), expanded.data(), all565.size());
+		kernels.bgra8ToBgr565(expanded.data(), packed.data(), expanded.size());
+		PGUI_CHECK(packed == all565);
+	}
+
+	void ConvertRowsFollowsPitches()
+	{
+		const SizeU size{ 10, 7 };
+		const std::vector<std::uint32_t> image(size.cx * size.cy, 0x80FF0000);
+
+		// Two pixels of padding per destination row stay untouched
+		std::vector<std::uint32_t> premultiplied((size.cx + 2) * size.cy);
+		ConvertRows(GetPixelKernels().premultiply, image.data(), size.cx * 4, premultiplied.data(), (size.cx + 2) * 4, size);
+		PGUI_CHECK(premultiplied[(size.cx + 2) * 6 + 9] == 0x80800000);
+		PGUI_CHECK(premultiplied[size.cx] == 0);
+
+		std::vector<std::uint64_t> halves(size.cx * size.cy);
+		ConvertRows(GetPixelKernels().bgra8ToRgba16Float, image.data(), size.cx * 4, halves.data(), size.cx * 8, size, true);
+		PGUI_CHECK(halves.back() != 0);
+	}
+}
+
+auto main() -> int
+{
+	HalfConversionsMatchF16c();
+
+	const auto& features = PGUI::CpuFeatures::Get();
+	if (features.sse41)
+	{
+		PGUI_CHECK(GetPixelKernels(PixelKernelLevel::Sse41).level == PixelKernelLevel::Sse41);
+		VectorKernelsMatchScalar(GetPixelKernels(PixelKernelLevel::Sse41));
+	}
+	if (features.avx2)
+	{
+		PGUI_CHECK(GetPixelKernels(PixelKernelLevel::Avx2).level == PixelKernelLevel::Avx2);
+		VectorKernelsMatchScalar(GetPixelKernels(PixelKernelLevel::Avx2));
+	}
+	PGUI_CHECK(&GetPixelKernels() == &GetPixelKernels(PixelKernelLevel::Avx2));
+
+	ScalarKernelsConvert();
+	RoundTripsAreLossless();
+	ConvertRowsFollowsPitches();
+
+	return PGUI::Tests::Finish();
+}
@@ -0,0 +1,238 @@
+#include "Check.hpp"
+#include "ui/ShapingScheduler.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+// GCC 12 loses track of stop_source's state through request_stop
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+namespace
+{
+	using namespace PGUI::Core;
+	using PGUI::UI::shaping_detail::ShapingScheduler;
+
+	/**
+	* @brief Stands in for a text, the mock shaper squares the value
+	*/
+	struct MockRequest
+	{
+		int value = 0;
+		// Set once the request is being shaped, the shaper then waits for release
+		std::atomic_bool* started = nullptr;
+		const std::atomic_bool* release = nullptr;
+	};
+
+	auto MockShape(const MockRequest& request) -> int
+	{
+		if (request.started != nullptr)
+		{
+			request.started->store(true);
+		}
+		if (request.release != nullptr)
+		{
+			while (!request.release->load())
+			{
+				std::this_thread::yield();
+			}
+		}
+		return request.value * request.value;
+	}
+
+	auto MakeRequests(int count) -> std::vector<MockRequest>
+	{
+		std::vector<MockRequest> requests(static_cast<std::size_t>(count));
+		for (int i = 0; i < count; i++)
+		{
+			requests[static_cast<std::size_t>(i)].value = i + 1;
+		}
+		return requests;
+	}
+
+	void WaitFor(const std::atomic_bool& flag)
+	{
+		while (!flag.load())
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	// Drains until done() or a few seconds went by, like the message loop would
+	template <typename Condition>
+	void DrainUntil(DispatcherQueue& queue, Condition&& done)
+	{
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{ 10 };
+		while (!done() && std::chrono::steady_clock::now() < deadline)
+		{
+			queue.Drain();
+			std::this_thread::yield();
+		}
+	}
+
+	void ResultsArriveInOrderOnTheQueue()
+	{
+		DispatcherQueue queue{ [] { return true; } };
+		ShapingScheduler<MockRequest, int> scheduler{ &MockShape, 4 };
+
+		std::vector<int> results;
+		std::thread::id deliveredOn;
+		scheduler.Submit(MakeRequests(1001), { }, std::shared_ptr<DispatcherQueue>{ &queue, [](auto*) { } },
+			[&](std::span<int> shaped)
+		{
+			results.assign(shaped.begin(), shaped.end());
+			deliveredOn = std::this_thread::get_id();
+		}, false);
+
+		DrainUntil(queue, [&results] { return !results.empty(); });
+		PGUI_CHECK(results.size() == 1001);
+		auto inOrder = true;
+		for (std::size_t i = 0; i < results.size(); i++)
+		{
+			const auto value = static_cast<int>(i) + 1;
+			inOrder = inOrder && results[i] == value * value;
+		}
+		PGUI_CHECK(inOrder);
+		PGUI_CHECK(deliveredOn == std::this_thread::get_id());
+		PGUI_CHECK(scheduler.GetShapedCount() == 1001);
+	}
+
+	void EmptyBatchStillCallsBack()
+	{
+		DispatcherQueue queue{ [] { return true; } };
+		ShapingScheduler<MockRequest, int> scheduler{ &MockShape, 2 };
+
+		auto calls = 0;
+		std::size_t size = 1;
+		scheduler.Submit({ }, { }, std::shared_ptr<DispatcherQueue>{ &queue, [](auto*) { } },
+			[&](std::span<int> shaped)
+		{
+			calls++;
+			size = shaped.size();
+		}, false);
+
+		// Delivered through the queue even though nothing was shaped
+		PGUI_CHECK(calls == 0);
+		queue.Drain();
+		PGUI_CHECK(calls == 1);
+		PGUI_CHECK(size == 0);
+	}
+
+	void BatchesFinishedTogetherShareAPost()
+	{
+		DispatcherQueue queue{ [] { return true; } };
+		// One worker runs the batches one after another, each completes before the next starts
+		ShapingScheduler<MockRequest, int> scheduler{ &MockShape, 1 };
+		const std::shared_ptr<DispatcherQueue> queuePtr{ &queue, [](auto*) { } };
+
+		constexpr auto BatchCount = 5;
+		auto delivered = 0;
+		for (auto i = 0; i < BatchCount; i++)
+		{
+			scheduler.Submit(MakeRequests(10), { }, queuePtr, [&delivered](std::span<int>) { delivered++; }, false);
+		}
+
+		// Once the last batch is being shaped the ones before it have completed
+		std::atomic_bool lastStarted = false;
+		auto lastDelivered = false;
+		std::vector<MockRequest> last(1);
+		last[0].started = &lastStarted;
+		scheduler.Submit(std::move(last), { }, queuePtr, [&lastDelivered](std::span<int>) { lastDelivered = true; }, false);
+		WaitFor(lastStarted);
+
+		queue.Drain();
+		PGUI_CHECK(delivered == BatchCount);
+
+		DrainUntil(queue, [&lastDelivered] { return lastDelivered; });
+		PGUI_CHECK(lastDelivered);
+		PGUI_CHECK(scheduler.GetPostCount() <= 2);
+	}
+
+	void CancelledBatchesStopShaping()
+	{
+		DispatcherQueue queue{ [] { return true; } };
+		ShapingScheduler<MockRequest, int> scheduler{ &MockShape, 1 };
+		const std::shared_ptr<DispatcherQueue> queuePtr{ &queue, [](auto*) { } };
+
+		// Stopped before it was submitted, nothing is shaped and nothing is delivered
+		std::stop_source stopped;
+		stopped.request_stop();
+		auto calls = 0;
+		scheduler.Submit(MakeRequests(50), stopped.get_token(), queuePtr, [&calls](std::span<int>) { calls++; }, false);
+
+		// Stopped while its first request is shaped, the rest stay value initialized
+		std::stop_source stopSource;
+		std::atomic_bool started = false;
+		std::atomic_bool release = false;
+		auto requests = MakeRequests(50);
+		requests[0].started = &started;
+		requests[0].release = &release;
+
+		std::vector<int> results;
+		auto cancelledDelivered = false;
+		scheduler.Submit(std::move(requests), stopSource.get_token(), queuePtr, [&](std::span<int> shaped)
+		{
+			results.assign(shaped.begin(), shaped.end());
+			cancelledDelivered = true;
+		}, true);
+
+		WaitFor(started);
+		stopSource.request_stop();
+		release.store(true);
+
+		DrainUntil(queue, [&cancelledDelivered] { return cancelledDelivered; });
+		PGUI_CHECK(calls == 0);
+		PGUI_CHECK(results.size() == 50);
+		PGUI_CHECK(!results.empty() && results[0] == 1);
+		auto restEmpty = true;
+		for (std::size_t i = 1; i < results.size(); i++)
+		{
+			restEmpty = restEmpty && results[i] == 0;
+		}
+		PGUI_CHECK(restEmpty);
+		PGUI_CHECK(scheduler.GetShapedCount() == 1);
+	}
+
+	void QueuesGetTheirOwnResults()
+	{
+		DispatcherQueue first{ [] { return true; } };
+		ShapingScheduler<MockRequest, int> scheduler{ &MockShape, 3 };
+
+		auto firstResult = 0;
+		scheduler.Submit(MakeRequests(3), { }, std::shared_ptr<DispatcherQueue>{ &first, [](auto*) { } },
+			[&firstResult](std::span<int> shaped) { firstResult = shaped[2]; }, false);
+
+		// The other queue is consumed by its own thread
+		std::atomic_int secondResult = 0;
+		std::thread other{ [&scheduler, &secondResult]
+		{
+			DispatcherQueue second{ [] { return true; } };
+			scheduler.Submit(MakeRequests(4), { }, std::shared_ptr<DispatcherQueue>{ &second, [](auto*) { } },
+				[&secondResult](std::span<int> shaped) { secondResult = shaped[3]; }, false);
+			DrainUntil(second, [&secondResult] { return secondResult != 0; });
+		} };
+
+		DrainUntil(first, [&firstResult] { return firstResult != 0; });
+		other.join();
+		PGUI_CHECK(firstResult == 9);
+		PGUI_CHECK(secondResult == 16);
+	}
+}
+
+auto main() -> int
+{
+	ResultsArriveInOrderOnTheQueue();
+	EmptyBatchStillCallsBack();
+	BatchesFinishedTogetherShareAPost();
+	CancelledBatchesStopShaping();
+	QueuesGetTheirOwnResults();
+
+	return PGUI::Tests::Finish();
+}
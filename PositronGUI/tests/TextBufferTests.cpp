@@ -0,0 +1,372 @@
+#include "Check.hpp"
+#include "ui/TextBuffer.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace
+{
+	using PGUI::UI::TextBuffer;
+
+	std::mt19937 engine{ 1 };
+
+	auto Next(std::size_t bound) -> std::size_t
+	{
+		return bound == 0 ? 0 : static_cast<std::size_t>(engine()) % bound;
+	}
+
+	auto RandomText(std::size_t length) -> std::wstring
+	{
+		std::wstring text;
+		for (std::size_t i = 0; i < length; i++)
+		{
+			text += Next(8) == 0 ? L'\n' : static_cast<wchar_t>(L'a' + Next(26));
+		}
+		return text;
+	}
+
+	auto LineFromPosition(const std::wstring& text, std::size_t position) -> std::size_t
+	{
+		const auto end = text.begin() + static_cast<std::ptrdiff_t>(std::min(position, text.size()));
+		return static_cast<std::size_t>(std::count(text.begin(), end, L'\n'));
+	}
+
+	auto LineStart(const std::wstring& text, std::size_t line) -> std::size_t
+	{
+		std::size_t position = 0;
+		for (std::size_t i = 0; i < line; i++)
+		{
+			position = text.find(L'\n', position);
+			if (position == std::wstring::npos)
+			{
+				return text.size();
+			}
+			position++;
+		}
+		return position;
+	}
+
+	/*
+	* Compares the buffer with a flat string at a few random places
+	*/
+	void MatchesModel(const TextBuffer& buffer, const std::wstring& model)
+	{
+		PGUI_CHECK(buffer.GetLength() == model.size());
+		PGUI_CHECK(buffer.GetText() == model);
+		PGUI_CHECK(buffer.GetLineCount() == static_cast<std::size_t>(std::ranges::count(model, L'\n')) + 1);
+
+		for (auto probe = 0; probe < 5; probe++)
+		{
+			const auto position = Next(model.size() + 2);
+			PGUI_CHECK(buffer.GetLineFromPosition(position) == LineFromPosition(model, position));
+			PGUI_CHECK(buffer.GetChar(position) == (position < model.size() ? model[position] : L'\0'));
+
+			const auto line = Next(buffer.GetLineCount() + 1);
+			const auto start = LineStart(model, line);
+			PGUI_CHECK(buffer.GetLineStart(line) == start);
+			if (line < buffer.GetLineCount())
+			{
+				const auto end = std::min(model.find(L'\n', start), model.size());
+				PGUI_CHECK(buffer.GetLineLength(line) == end - start);
+				PGUI_CHECK(buffer.GetLine(line) == model.substr(start, end - start));
+			}
+
+			const auto from = Next(model.size() + 1);
+			const auto length = Next(50);
+			PGUI_CHECK(buffer.GetText(from, length) == model.substr(from, length));
+		}
+	}
+
+	/*
+	* Random edits, typing runs, groups, undo and redo against a string and its history
+	*/
+	void RandomEditsMatchModel()
+	{
+		for (auto round = 0; round < 30; round++)
+		{
+			auto model = RandomText(Next(3000));
+			TextBuffer buffer{ model };
+			std::vector<std::wstring> history{ model };
+			std::size_t current = 0;
+
+			const auto pushHistory = [&]
+			{
+				history.resize(current + 1);
+				history.push_back(model);
+				current++;
+			};
+
+			for (auto op = 0; op < 400; op++)
+			{
+				const auto kind = Next(10);
+				if (kind < 4)
+				{
+					// Now and then longer than a piece
+					const auto position = Next(model.size() + 1);
+					const auto text = RandomText(1 + Next(Next(10) == 0 ? 40000 : 20));
+					buffer.StopGroupTyping();
+					buffer.Insert(position, text);
+					model.insert(position, text);
+					pushHistory();
+				}
+				else if (kind < 6)
+				{
+					const auto position = Next(model.size() + 1);
+					const auto length = std::min(Next(200), model.size() - position);
+					buffer.Erase(position, length);
+					if (length != 0)
+					{
+						model.erase(position, length);
+						pushHistory();
+					}
+				}
+				else if (kind < 7)
+				{
+					const auto position = Next(model.size() + 1);
+					const auto length = std::min(Next(200), model.size() - position);
+					const auto text = RandomText(Next(30));
+					buffer.Replace(position, length, text);
+					if (length != 0 || !text.empty())
+					{
+						model.replace(position, length, text);
+						pushHistory();
+					}
+				}
+				else if (kind < 8)
+				{
+					// Characters typed one after another undo as one step
+					buffer.StopGroupTyping();
+					const auto position = Next(model.size() + 1);
+					const auto count = 1 + Next(30);
+					for (std::size_t i = 0; i < count; i++)
+					{
+						const auto character = static_cast<wchar_t>(L'a' + Next(26));
+						buffer.Insert(position + i, std::wstring(1, character));
+						model.insert(position + i, 1, character);
+					}
+					pushHistory();
+				}
+				else if (kind < 9)
+				{
+					buffer.BeginUndoGroup();
+					buffer.BeginUndoGroup();
+					for (auto i = 0; i < 3; i++)
+					{
+						const auto position = Next(model.size() + 1);
+						const auto text = RandomText(5);
+						buffer.Insert(position, text);
+						model.insert(position, text);
+
+						const auto erasePosition = Next(model.size() + 1);
+						const auto length = std::min<std::size_t>(3, model.size() - erasePosition);
+						buffer.Erase(erasePosition, length);
+						model.erase(erasePosition, length);
+					}
+					buffer.EndUndoGroup();
+					buffer.EndUndoGroup();
+					pushHistory();
+				}
+				else if (Next(2) == 0)
+				{
+					const auto undone = buffer.Undo();
+					PGUI_CHECK(undone == (current > 0));
+					if (undone)
+					{
+						current--;
+						model = history[current];
+					}
+				}
+				else
+				{
+					const auto redone = buffer.Redo();
+					PGUI_CHECK(redone == (current + 1 < history.size()));
+					if (redone)
+					{
+						current++;
+						model = history[current];
+					}
+				}
+
+				MatchesModel(buffer, model);
+			}
+
+			auto undoneCount = 0;
+			while (buffer.Undo())
+			{
+				current--;
+				undoneCount++;
+				PGUI_CHECK(buffer.GetText() == history[current]);
+			}
+			// Steps are only forgotten past the limit
+			PGUI_CHECK(undoneCount <= static_cast<int>(TextBuffer::DefaultUndoLimit));
+			PGUI_CHECK(current == 0 || history.size() - 1 > TextBuffer::DefaultUndoLimit);
+		}
+	}
+
+	void UndoLimitDropsOldestSteps()
+	{
+		TextBuffer buffer;
+		buffer.SetUndoLimit(3);
+		for (auto i = 0; i < 10; i++)
+		{
+			buffer.StopGroupTyping();
+			buffer.Insert(0, L"x");
+		}
+
+		auto undoneCount = 0;
+		while (buffer.Undo())
+		{
+			undoneCount++;
+		}
+		PGUI_CHECK(undoneCount == 3);
+		PGUI_CHECK(buffer.GetLength() == 7);
+
+		buffer.SetUndoLimit(0);
+		buffer.Insert(0, L"y");
+		PGUI_CHECK(!buffer.CanUndo());
+	}
+
+	void TypingExtendsOnePiece()
+	{
+		const std::wstring original(100, L'z');
+		TextBuffer buffer{ original };
+		for (std::size_t i = 0; i < 1000; i++)
+		{
+			buffer.Insert(50 + i, L"k");
+		}
+		PGUI_CHECK(buffer.GetPieceCount() <= 4);
+
+		auto undoneCount = 0;
+		while (buffer.Undo())
+		{
+			undoneCount++;
+		}
+		PGUI_CHECK(undoneCount == 1);
+		PGUI_CHECK(buffer.GetText() == original);
+
+		buffer.Redo();
+		PGUI_CHECK(buffer.GetLength() == 1100);
+	}
+
+	/*
+	* Small alphabet so matches are frequent and often span pieces
+	*/
+	auto RandomFindText(std::size_t length) -> std::wstring
+	{
+		std::wstring text;
+		for (std::size_t i = 0; i < length; i++)
+		{
+			text += L"ab\rc"[Next(4)];
+		}
+		return text;
+	}
+
+	void FindAndVisitTextMatchModel()
+	{
+		TextBuffer buffer{ RandomFindText(300), L'\r' };
+		auto model = buffer.GetText();
+
+		for (auto op = 0; op < 6000; op++)
+		{
+			const auto version = buffer.GetVersion();
+			const auto position = Next(model.size() + 1);
+			switch (Next(5))
+			{
+				case 0:
+				case 1:
+				{
+					const auto text = RandomFindText(1 + Next(40));
+					buffer.Insert(position, text);
+					model.insert(position, text);
+					PGUI_CHECK(buffer.GetVersion() != version);
+					break;
+				}
+				case 2:
+				{
+					const auto length = std::min(Next(30), model.size() - position);
+					buffer.Erase(position, length);
+					model.erase(position, length);
+					PGUI_CHECK((buffer.GetVersion() != version) == (length != 0));
+					break;
+				}
+				case 3:
+				{
+					if (buffer.Undo())
+					{
+						PGUI_CHECK(buffer.GetVersion() != version);
+						model = buffer.GetText();
+					}
+					break;
+				}
+				default:
+				{
+					if (buffer.Redo())
+					{
+						PGUI_CHECK(buffer.GetVersion() != version);
+						model = buffer.GetText();
+					}
+					break;
+				}
+			}
+			if (model.size() > 4000)
+			{
+				buffer.Assign(RandomFindText(300));
+				model = buffer.GetText();
+				PGUI_CHECK(buffer.GetVersion() != version);
+			}
+
+			for (auto query = 0; query < 8; query++)
+			{
+				const auto pattern = Next(3) == 0 ?
+					RandomFindText(1 + Next(12)) : model.substr(Next(model.size()), 1 + Next(20));
+				const auto from = Next(model.size() + 1);
+				const auto to = Next(4) == 0 ? TextBuffer::NotFound : from + Next(model.size() + 1 - from);
+
+				const auto expected = pattern.empty() ?
+					TextBuffer::NotFound : std::wstring_view{ model }.substr(0, std::min(to, model.size())).find(pattern, from);
+				PGUI_CHECK(buffer.Find(pattern, from, to) == expected);
+			}
+
+			// The views put together are the text, and a visitor returning false stops the visit
+			const auto from = Next(model.size() + 1);
+			const auto length = Next(model.size() + 10);
+			std::wstring visited;
+			buffer.VisitText(from, length, [&visited](std::wstring_view chunk) { visited += chunk; });
+			PGUI_CHECK(visited == model.substr(from, length));
+
+			std::size_t allChunkCount = 0;
+			buffer.VisitText(0, model.size(), [&allChunkCount](std::wstring_view) { allChunkCount++; });
+			std::size_t visitedCount = 0;
+			buffer.VisitText(0, model.size(), [&visitedCount](std::wstring_view)
+			{
+				visitedCount++;
+				return visitedCount < 2;
+			});
+			PGUI_CHECK(visitedCount == std::min<std::size_t>(allChunkCount, 2));
+		}
+	}
+
+	void OtherLineBreaks()
+	{
+		const TextBuffer buffer{ L"a\rb\r", L'\r' };
+		PGUI_CHECK(buffer.GetLineCount() == 3);
+		PGUI_CHECK(buffer.GetLineStart(2) == 4);
+		PGUI_CHECK(buffer.GetLine(1) == L"b");
+	}
+}
+
+auto main() -> int
+{
+	RandomEditsMatchModel();
+	UndoLimitDropsOldestSteps();
+	TypingExtendsOnePiece();
+	FindAndVisitTextMatchModel();
+	OtherLineBreaks();
+
+	return PGUI::Tests::Finish();
+}
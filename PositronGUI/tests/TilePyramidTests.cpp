@@ -0,0 +1,308 @@
+#include "Check.hpp"
+#include "ui/bmp/TilePyramid.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+	using namespace PGUI;
+	using namespace PGUI::UI::Bmp;
+
+	// Premultiplied, every channel at most alpha, and different for neighbouring pixels
+	auto PixelAt(std::uint32_t x, std::uint32_t y) noexcept -> std::uint32_t
+	{
+		const auto alpha = (x * 7 + y * 13) & 0xFFU;
+		const auto red = alpha * ((x ^ y) & 0xFFU) / 255;
+		const auto green = alpha * (x & 1U);
+		return (alpha << 24) | (red << 16) | (green << 8) | (alpha / 2);
+	}
+
+	auto MakeReader(std::vector<RectU>& reads) -> TilePyramid::TileReader
+	{
+		return [&reads](RectU rect, std::span<std::uint32_t> pixels)
+		{
+			reads.push_back(rect);
+			for (auto y = rect.top; y < rect.bottom; y++)
+			{
+				for (auto x = rect.left; x < rect.right; x++)
+				{
+					pixels[static_cast<std::size_t>(y - rect.top) * rect.Width() + (x - rect.left)] = PixelAt(x, y);
+				}
+			}
+		};
+	}
+
+	void DownsampleOddEdges()
+	{
+		// A 2x2 block rounds each channel to nearest
+		{
+			const std::uint32_t source[] = { 0xFF000000, 0xFF000001, 0x01FFFFFF, 0x00000002 };
+			std::uint32_t destination[1]{ };
+			tile_detail::Downsample(source, SizeU{ 2, 2 }, destination);
+			PGUI_CHECK(destination[0] == 0x80404041);
+		}
+
+		// 3x3 into 2x2, the odd last column and row only average the pixels that are there
+		{
+			const std::uint32_t source[] = {
+				0x04040404, 0x08080808, 0x10101010,
+				0x0C0C0C0C, 0x10101010, 0x20202020,
+				0x40404040, 0x80808080, 0xFFFFFFFF
+			};
+			std::uint32_t destination[4]{ };
+			tile_detail::Downsample(source, SizeU{ 3, 3 }, destination);
+			PGUI_CHECK(destination[0] == 0x0A0A0A0A);
+			PGUI_CHECK(destination[1] == 0x18181818);
+			PGUI_CHECK(destination[2] == 0x60606060);
+			PGUI_CHECK(destination[3] == 0xFFFFFFFF);
+		}
+
+		// A single row and a single pixel
+		{
+			const std::uint32_t source[] = { 0x00000010, 0x00000020, 0x00000031 };
+			std::uint32_t destination[2]{ };
+			tile_detail::Downsample(source, SizeU{ 3, 1 }, destination);
+			PGUI_CHECK(destination[0] == 0x00000018);
+			PGUI_CHECK(destination[1] == 0x00000031);
+
+			tile_detail::Downsample(std::span{ source }.first(1), SizeU{ 1, 1 }, std::span{ destination }.first(1));
+			PGUI_CHECK(destination[0] == 0x00000010);
+		}
+	}
+
+	void Geometry()
+	{
+		std::vector<RectU> reads;
+		const TilePyramid pyramid{ SizeU{ 1000, 777 }, MakeReader(reads), 128 };
+
+		// 1000x777, 500x389, 250x195, 125x98
+		PGUI_CHECK(pyramid.GetLevelCount() == 4);
+		PGUI_CHECK(pyramid.GetLevelSize(1) == (SizeU{ 500, 389 }));
+		PGUI_CHECK(pyramid.GetLevelSize(3) == (SizeU{ 125, 98 }));
+		PGUI_CHECK(pyramid.GetTileGrid(0) == (SizeU{ 8, 7 }));
+		PGUI_CHECK(pyramid.GetTileGrid(3) == (SizeU{ 1, 1 }));
+
+		PGUI_CHECK(pyramid.GetTileRect(TileKey{ 0, 0, 0 }) == (RectU{ 0, 0, 128, 128 }));
+		// Tiles on the right and bottom edges are cut to the level
+		PGUI_CHECK(pyramid.GetTileRect(TileKey{ 0, 7, 6 }) == (RectU{ 896, 768, 1000, 777 }));
+		PGUI_CHECK(pyramid.GetTileRect(TileKey{ 1, 3, 3 }) == (RectU{ 384, 384, 500, 389 }));
+
+		PGUI_CHECK(pyramid.SelectLevel(1.0F) == 0);
+		PGUI_CHECK(pyramid.SelectLevel(4.0F) == 0);
+		PGUI_CHECK(pyramid.SelectLevel(0.5F) == 1);
+		PGUI_CHECK(pyramid.SelectLevel(0.3F) == 1);
+		PGUI_CHECK(pyramid.SelectLevel(0.25F) == 2);
+		// Zoomed out past the last level stays on it
+		PGUI_CHECK(pyramid.SelectLevel(0.01F) == 3);
+		PGUI_CHECK(pyramid.SelectLevel(0.0F) == 0);
+		PGUI_CHECK(pyramid.SelectLevel(-1.0F) == 0);
+
+		auto keys = pyramid.GetTilesInRect(0, RectF{ 255.5F, 0, 513, 10 });
+		PGUI_CHECK(keys.size() == 4);
+		PGUI_CHECK(keys.size() == 4 && keys.front() == (TileKey{ 0, 1, 0 }) && keys.back() == (TileKey{ 0, 4, 0 }));
+
+		// The rect is in full resolution pixels whatever the level
+		keys = pyramid.GetTilesInRect(1, RectF{ 0, 0, 600, 300 });
+		PGUI_CHECK(keys.size() == 6);
+		PGUI_CHECK(keys.size() == 6 && keys.back() == (TileKey{ 1, 2, 1 }));
+
+		// Clamped to the image, and to the last level
+		PGUI_CHECK(pyramid.GetTilesInRect(0, RectF{ -100, -100, 5000, 5000 }).size() == 56);
+		keys = pyramid.GetTilesInRect(9, RectF{ 0, 0, 1000, 777 });
+		PGUI_CHECK(keys.size() == 1 && keys.front() == (TileKey{ 3, 0, 0 }));
+
+		PGUI_CHECK(reads.empty());
+	}
+
+	/*
+	* Every tile of every level against the whole image downsampled a level at a time,
+	* sizes that leave odd edges at each level
+	*/
+	void BuildsLevels()
+	{
+		for (const auto& [width, height, tileSize] : {
+			std::tuple{ 300U, 177U, 32U }, std::tuple{ 257U, 1U, 64U }, std::tuple{ 3U, 5U, 1U } })
+		{
+			std::vector<RectU> reads;
+			TilePyramid pyramid{ SizeU{ width, height }, MakeReader(reads), tileSize, 1 << 20 };
+
+			SizeU levelSize{ width, height };
+			std::vector<std::uint32_t> level(static_cast<std::size_t>(width) * height);
+			for (std::uint32_t y = 0; y < height; y++)
+			{
+				for (std::uint32_t x = 0; x < width; x++)
+				{
+					level[static_cast<std::size_t>(y) * width + x] = PixelAt(x, y);
+				}
+			}
+
+			bool allMatch = true;
+			for (std::uint32_t l = 0; l < pyramid.GetLevelCount(); l++)
+			{
+				PGUI_CHECK(pyramid.GetLevelSize(l) == levelSize);
+
+				const auto grid = pyramid.GetTileGrid(l);
+				for (std::uint32_t row = 0; row < grid.cy; row++)
+				{
+					for (std::uint32_t column = 0; column < grid.cx; column++)
+					{
+						const auto tile = pyramid.GetTile(TileKey{ l, column, row });
+						const auto rect = pyramid.GetTileRect(TileKey{ l, column, row });
+						if (!tile || tile->size != rect.Size())
+						{
+							allMatch = false;
+							continue;
+						}
+						for (std::uint32_t y = 0; y < rect.Height(); y++)
+						{
+							for (std::uint32_t x = 0; x < rect.Width(); x++)
+							{
+								allMatch = allMatch && tile->pixels[static_cast<std::size_t>(y) * rect.Width() + x] ==
+									level[static_cast<std::size_t>(rect.top + y) * levelSize.cx + rect.left + x];
+							}
+						}
+					}
+				}
+
+				const SizeU nextSize{ (levelSize.cx + 1) / 2, (levelSize.cy + 1) / 2 };
+				std::vector<std::uint32_t> next(static_cast<std::size_t>(nextSize.cx) * nextSize.cy);
+				tile_detail::Downsample(level, levelSize, next);
+				level = std::move(next);
+				levelSize = nextSize;
+			}
+			PGUI_CHECK(allMatch);
+
+			const auto lastSize = pyramid.GetLevelSize(pyramid.GetLevelCount() - 1);
+			PGUI_CHECK(lastSize.cx <= tileSize && lastSize.cy <= tileSize);
+			// Full resolution tiles are only read once, the coarser ones come from the cache
+			const auto baseGrid = pyramid.GetTileGrid(0);
+			PGUI_CHECK(reads.size() == static_cast<std::size_t>(baseGrid.cx) * baseGrid.cy);
+			PGUI_CHECK(pyramid.GetReadCount() == reads.size());
+		}
+
+		std::vector<RectU> reads;
+		TilePyramid pyramid{ SizeU{ 64, 64 }, MakeReader(reads), 16 };
+		PGUI_CHECK(!pyramid.GetTile(TileKey{ 3, 0, 0 }));
+		PGUI_CHECK(!pyramid.GetTile(TileKey{ 0, 4, 0 }));
+		PGUI_CHECK(!pyramid.GetTile(TileKey{ 1, 0, 2 }));
+		PGUI_CHECK(reads.empty());
+	}
+
+	void EvictsOverBudget()
+	{
+		constexpr std::size_t TileBytes = 4 * 4 * sizeof(std::uint32_t);
+
+		std::vector<RectU> reads;
+		TilePyramid pyramid{ SizeU{ 16, 4 }, MakeReader(reads), 4, 3 * TileBytes };
+
+		for (std::uint32_t column = 0; column < 3; column++)
+		{
+			PGUI_CHECK(pyramid.GetTile(TileKey{ 0, column, 0 }) != nullptr);
+		}
+		PGUI_CHECK(pyramid.GetCachedTileCount() == 3);
+		PGUI_CHECK(pyramid.GetByteSize() == 3 * TileBytes);
+
+		// A hit makes the tile the most recently used, the least recently used one goes
+		PGUI_CHECK(pyramid.GetTile(TileKey{ 0, 0, 0 }) != nullptr);
+		PGUI_CHECK(pyramid.GetHitCount() == 1);
+		PGUI_CHECK(pyramid.GetTile(TileKey{ 0, 3, 0 }) != nullptr);
+		PGUI_CHECK(pyramid.GetCachedTileCount() == 3);
+		PGUI_CHECK(pyramid.GetByteSize() == 3 * TileBytes);
+		PGUI_CHECK(pyramid.FindTile(TileKey{ 0, 1, 0 }) == nullptr);
+		PGUI_CHECK(pyramid.FindTile(TileKey{ 0, 0, 0 }) != nullptr);
+		PGUI_CHECK(pyramid.FindTile(TileKey{ 0, 2, 0 }) != nullptr);
+
+		// Evicted tiles are read again
+		PGUI_CHECK(pyramid.GetTile(TileKey{ 0, 1, 0 }) != nullptr);
+		PGUI_CHECK(reads.size() == 5);
+		PGUI_CHECK(pyramid.FindTile(TileKey{ 0, 2, 0 }) == nullptr);
+
+		// Tiles handed out outlive their eviction
+		const auto held = pyramid.FindTile(TileKey{ 0, 1, 0 });
+		pyramid.SetByteBudget(TileBytes + 1);
+		PGUI_CHECK(pyramid.GetCachedTileCount() == 1);
+		PGUI_CHECK(pyramid.FindTile(TileKey{ 0, 1, 0 }) != nullptr);
+		PGUI_CHECK(held && held->pixels.size() == 16);
+
+		// The most recent tile is kept even when it alone is over budget
+		pyramid.SetByteBudget(0);
+		PGUI_CHECK(pyramid.GetCachedTileCount() == 1);
+		PGUI_CHECK(pyramid.GetTile(TileKey{ 0, 2, 0 }) != nullptr);
+		PGUI_CHECK(pyramid.GetCachedTileCount() == 1);
+		PGUI_CHECK(pyramid.FindTile(TileKey{ 0, 2, 0 }) != nullptr);
+
+		// A coarse tile is still built right with no room to cache its children
+		const auto coarse = pyramid.GetTile(TileKey{ 2, 0, 0 });
+		PGUI_CHECK(coarse != nullptr);
+		PGUI_CHECK(coarse && coarse->size == (SizeU{ 4, 1 }));
+		PGUI_CHECK(pyramid.GetCachedTileCount() == 1);
+		PGUI_CHECK(pyramid.GetBuildCount() == 3);
+
+		pyramid.Clear();
+		PGUI_CHECK(pyramid.GetCachedTileCount() == 0);
+		PGUI_CHECK(pyramid.GetByteSize() == 0);
+	}
+
+	/*
+	* A tile that runs out of time keeps what it finished, the next call starts from there
+	*/
+	void ResumesAfterDeadline()
+	{
+		using Clock = TilePyramid::Clock;
+		const auto passed = Clock::now() - std::chrono::seconds{ 1 };
+		const auto future = Clock::now() + std::chrono::hours{ 1 };
+
+		std::vector<RectU> reads;
+		TilePyramid pyramid{ SizeU{ 32, 32 }, MakeReader(reads), 16 };
+		const TileKey coarse{ 1, 0, 0 };
+
+		PGUI_CHECK(pyramid.GetTile(coarse, passed) == nullptr);
+		PGUI_CHECK(reads.empty());
+		PGUI_CHECK(pyramid.GetCachedTileCount() == 0);
+
+		// Finished in an earlier frame
+		PGUI_CHECK(pyramid.GetTile(TileKey{ 0, 0, 0 }, future) != nullptr);
+		PGUI_CHECK(pyramid.GetTile(TileKey{ 0, 1, 1 }, future) != nullptr);
+
+		// Out of time again, what's cached is used and nothing new is read
+		PGUI_CHECK(pyramid.GetTile(coarse, passed) == nullptr);
+		PGUI_CHECK(reads.size() == 2);
+		PGUI_CHECK(pyramid.GetHitCount() == 2);
+		PGUI_CHECK(pyramid.FindTile(TileKey{ 0, 0, 0 }) != nullptr);
+		PGUI_CHECK(pyramid.FindTile(TileKey{ 0, 1, 1 }) != nullptr);
+
+		// Only the two missing children are read
+		const auto tile = pyramid.GetTile(coarse, future);
+		PGUI_CHECK(tile != nullptr);
+		PGUI_CHECK(reads.size() == 4);
+		PGUI_CHECK(pyramid.GetBuildCount() == 1);
+
+		// Averaging cached children needs no reads, so it isn't held back by the deadline
+		PGUI_CHECK(pyramid.GetTile(coarse, passed) == tile);
+		pyramid.Clear();
+		for (const auto& key : { TileKey{ 0, 0, 0 }, TileKey{ 0, 1, 0 }, TileKey{ 0, 0, 1 }, TileKey{ 0, 1, 1 } })
+		{
+			PGUI_CHECK(pyramid.GetTile(key) != nullptr);
+		}
+		PGUI_CHECK(pyramid.GetTile(coarse, passed) != nullptr);
+		PGUI_CHECK(pyramid.GetBuildCount() == 2);
+	}
+}
+
+auto main() -> int
+{
+	DownsampleOddEdges();
+	Geometry();
+	BuildsLevels();
+	EvictsOverBudget();
+	ResumesAfterDeadline();
+
+	return PGUI::Tests::Finish();
+}
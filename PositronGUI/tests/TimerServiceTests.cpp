@@ -0,0 +1,168 @@
+#include "Check.hpp"
+#include "helpers/TimerService.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+	using namespace std::chrono_literals;
+	using PGUI::TimerService;
+
+	// Generous so a loaded machine doesn't fail the tests, they check order and counts not precision
+	constexpr auto Slack = 500ms;
+
+	template <typename Predicate>
+	auto WaitFor(Predicate predicate, TimerService::Duration timeout = Slack) -> bool
+	{
+		const auto deadline = TimerService::Clock::now() + timeout;
+		while (!predicate())
+		{
+			if (TimerService::Clock::now() > deadline)
+			{
+				return false;
+			}
+			std::this_thread::sleep_for(1ms);
+		}
+		return true;
+	}
+
+	void OnceRunsOnce()
+	{
+		TimerService service;
+		std::atomic<int> calls = 0;
+
+		const auto id = service.ScheduleOnce(5ms, [&calls] { calls++; });
+		PGUI_CHECK(service.IsScheduled(id));
+		PGUI_CHECK(WaitFor([&calls] { return calls == 1; }));
+
+		std::this_thread::sleep_for(30ms);
+		PGUI_CHECK(calls == 1);
+		PGUI_CHECK(!service.IsScheduled(id));
+		PGUI_CHECK(service.GetTimerCount() == 0);
+	}
+
+	void RepeatingStopsWhenCancelled()
+	{
+		TimerService service;
+		std::atomic<int> calls = 0;
+
+		const auto id = service.Schedule(2ms, [&calls] { calls++; });
+		PGUI_CHECK(WaitFor([&calls] { return calls >= 5; }));
+
+		service.Cancel(id);
+		const int callsAtCancel = calls;
+		std::this_thread::sleep_for(20ms);
+
+		PGUI_CHECK(calls == callsAtCancel);
+		PGUI_CHECK(!service.IsScheduled(id));
+	}
+
+	void CancelFromCallback()
+	{
+		TimerService service;
+		std::atomic<int> calls = 0;
+		std::atomic<TimerService::TimerId> id = TimerService::InvalidTimerId;
+
+		id = service.Schedule(1ms, [&]
+		{
+			if (++calls == 3)
+			{
+				service.Cancel(id);
+			}
+		});
+
+		PGUI_CHECK(WaitFor([&calls] { return calls >= 3; }));
+		std::this_thread::sleep_for(20ms);
+		PGUI_CHECK(calls == 3);
+		PGUI_CHECK(service.GetTimerCount() == 0);
+	}
+
+	void CancelWaitsForRunningCallback()
+	{
+		TimerService service;
+		std::atomic<bool> started = false;
+		std::atomic<bool> finished = false;
+
+		const auto id = service.ScheduleOnce(1ms, [&]
+		{
+			started = true;
+			std::this_thread::sleep_for(50ms);
+			finished = true;
+		});
+
+		PGUI_CHECK(WaitFor([&started] { return started.load(); }));
+		service.Cancel(id);
+		PGUI_CHECK(finished);
+	}
+
+	void EarlierTimerWakesTheThread()
+	{
+		TimerService service;
+		std::atomic<bool> late = false;
+		std::atomic<bool> early = false;
+
+		service.ScheduleOnce(10s, [&late] { late = true; });
+		// Added while the thread sleeps towards the 10s deadline
+		const auto start = TimerService::Clock::now();
+		service.ScheduleOnce(5ms, [&early] { early = true; });
+
+		PGUI_CHECK(WaitFor([&early] { return early.load(); }));
+		PGUI_CHECK(TimerService::Clock::now() - start < Slack);
+		PGUI_CHECK(!late);
+	}
+
+	void DeadlinesKeepTheirOrder()
+	{
+		TimerService service;
+		std::mutex mutex;
+		std::vector<int> order;
+
+		for (const auto i : { 3, 1, 2 })
+		{
+			service.ScheduleOnce(i * 10ms, [&mutex, &order, i]
+			{
+				std::scoped_lock lock{ mutex };
+				order.push_back(i);
+			});
+		}
+
+		PGUI_CHECK(WaitFor([&] { std::scoped_lock lock{ mutex }; return order.size() == 3; }));
+		PGUI_CHECK((order == std::vector{ 1, 2, 3 }));
+	}
+
+	void MissedTicksAreSkipped()
+	{
+		TimerService service;
+		std::atomic<int> calls = 0;
+
+		// Each call takes longer than the interval, the ticks it overran aren't made up in a burst
+		const auto id = service.Schedule(5ms, [&calls]
+		{
+			calls++;
+			std::this_thread::sleep_for(20ms);
+		});
+		std::this_thread::sleep_for(200ms);
+		service.Cancel(id);
+
+		PGUI_CHECK(calls <= 11);
+		PGUI_CHECK(calls >= 2);
+	}
+}
+
+auto main() -> int
+{
+	OnceRunsOnce();
+	RepeatingStopsWhenCancelled();
+	CancelFromCallback();
+	CancelWaitsForRunningCallback();
+	EarlierTimerWakesTheThread();
+	DeadlinesKeepTheirOrder();
+	MissedTicksAreSkipped();
+
+	return PGUI::Tests::Finish();
+}
@@ -0,0 +1,336 @@
+#include "Check.hpp"
+#include "core/VisualTree.hpp"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+	using namespace PGUI;
+	using namespace PGUI::Core;
+
+	struct ReceivedEvent
+	{
+		std::string element;
+		InputEventType type;
+		PointF position;
+	};
+
+	// Every element writes to one log so the tests can check the order across elements
+	std::vector<ReceivedEvent> eventLog;
+	std::vector<std::pair<std::string, bool>> focusLog;
+
+	class TestElement : public VisualElement
+	{
+		public:
+		explicit TestElement(std::string _name, RectF _bounds, bool _handles = false) :
+			name{ std::move(_name) }, handles{ _handles }
+		{
+			SetBounds(_bounds);
+		}
+
+		void SetHandles(bool _handles) noexcept { handles = _handles; }
+
+		protected:
+		auto OnInput(const InputEvent& event) -> bool override
+		{
+			eventLog.push_back(ReceivedEvent{ name, event.type, event.position });
+			return handles;
+		}
+		void OnFocusChanged(bool focused) override
+		{
+			focusLog.emplace_back(name, focused);
+		}
+
+		private:
+		std::string name;
+		bool handles;
+	};
+
+	auto Add(VisualElement& parent, const std::string& name, RectF bounds, bool handles = false) -> TestElement*
+	{
+		return parent.AddChild<TestElement>(name, bounds, handles);
+	}
+
+	auto MakeEvent(InputEventType type, PointF position = { }, std::uint32_t key = 0,
+		ModifierKeys modifiers = ModifierKeys::None) -> InputEvent
+	{
+		InputEvent event;
+		event.type = type;
+		event.position = position;
+		event.key = key;
+		event.modifiers = modifiers;
+		return event;
+	}
+
+	auto LoggedNames() -> std::string
+	{
+		std::string names;
+		for (const auto& received : eventLog)
+		{
+			names += received.element + ' ';
+		}
+		return names;
+	}
+
+	void HitTestOrder()
+	{
+		VisualTree tree;
+		tree.GetRoot().SetBounds(RectF{ 0, 0, 200, 200 });
+
+		auto* panel = Add(tree.GetRoot(), "panel", RectF{ 10, 10, 110, 110 });
+		auto* below = Add(*panel, "below", RectF{ 0, 0, 50, 50 });
+		auto* above = Add(*panel, "above", RectF{ 25, 25, 75, 75 });
+		auto* nested = Add(*above, "nested", RectF{ 10, 10, 20, 20 });
+
+		PGUI_CHECK(tree.HitTest(PointF{ 15, 15 }) == below);
+		// Later children are on top where they overlap
+		PGUI_CHECK(tree.HitTest(PointF{ 40, 40 }) == above);
+		PGUI_CHECK(tree.HitTest(PointF{ 46, 46 }) == nested);
+		PGUI_CHECK(tree.HitTest(PointF{ 100, 100 }) == panel);
+		PGUI_CHECK(tree.HitTest(PointF{ 150, 150 }) == &tree.GetRoot());
+		PGUI_CHECK(tree.HitTest(PointF{ 250, 50 }) == nullptr);
+		// Right and bottom edges are outside
+		PGUI_CHECK(tree.HitTest(PointF{ 85, 40 }) == panel);
+
+		PGUI_CHECK(nested->GetAbsoluteBounds() == (RectF{ 45, 45, 55, 55 }));
+		PGUI_CHECK(nested->ToLocal(PointF{ 50, 47 }) == (PointF{ 5, 2 }));
+
+		above->SetHitTestVisible(false);
+		PGUI_CHECK(tree.HitTest(PointF{ 40, 40 }) == below);
+		PGUI_CHECK(tree.HitTest(PointF{ 46, 46 }) == below);
+		above->SetHitTestVisible(true);
+
+		above->Show(false);
+		PGUI_CHECK(tree.HitTest(PointF{ 46, 46 }) == below);
+		above->Show();
+		PGUI_CHECK(tree.HitTest(PointF{ 46, 46 }) == nested);
+	}
+
+	void FocusAndTab()
+	{
+		VisualTree tree;
+		tree.GetRoot().SetBounds(RectF{ 0, 0, 200, 200 });
+		focusLog.clear();
+
+		auto* first = Add(tree.GetRoot(), "first", RectF{ 0, 0, 50, 50 });
+		auto* group = Add(tree.GetRoot(), "group", RectF{ 50, 0, 150, 50 });
+		auto* second = Add(*group, "second", RectF{ 0, 0, 50, 50 });
+		auto* third = Add(*group, "third", RectF{ 50, 0, 100, 50 });
+		Add(tree.GetRoot(), "label", RectF{ 0, 50, 50, 100 });
+		for (auto* element : { first, second, third })
+		{
+			element->SetFocusable(true);
+		}
+
+		// Tab with nothing focused starts at the first element in tree order
+		PGUI_CHECK(tree.RouteInput(MakeEvent(InputEventType::KeyDown, { }, VisualTree::TabKey)));
+		PGUI_CHECK(first->HasFocus());
+		tree.MoveFocus();
+		PGUI_CHECK(tree.GetFocusedElement() == second);
+		tree.MoveFocus();
+		PGUI_CHECK(tree.GetFocusedElement() == third);
+		tree.MoveFocus();
+		PGUI_CHECK(tree.GetFocusedElement() == first);
+
+		// Shift+Tab goes back and wraps around
+		tree.RouteInput(MakeEvent(InputEventType::KeyDown, { }, VisualTree::TabKey, ModifierKeys::Shift));
+		PGUI_CHECK(tree.GetFocusedElement() == third);
+
+		// Disabled or hidden elements and their children are skipped
+		group->Enable(false);
+		tree.SetFocus(first);
+		tree.MoveFocus();
+		PGUI_CHECK(tree.GetFocusedElement() == first);
+		group->Enable(true);
+		second->Show(false);
+		tree.MoveFocus();
+		PGUI_CHECK(tree.GetFocusedElement() == third);
+		second->Show();
+
+		// Clicking focuses the nearest focusable ancestor of the element under the cursor
+		tree.RouteInput(MakeEvent(InputEventType::MouseDown, PointF{ 60, 10 }));
+		PGUI_CHECK(second->HasFocus());
+		tree.RouteInput(MakeEvent(InputEventType::MouseDown, PointF{ 10, 60 }));
+		PGUI_CHECK(second->HasFocus());
+
+		focusLog.clear();
+		tree.SetFocus(first);
+		PGUI_CHECK(focusLog.size() == 2);
+		PGUI_CHECK(focusLog.size() == 2 && focusLog[0].first == "second" && !focusLog[0].second);
+		PGUI_CHECK(focusLog.size() == 2 && focusLog[1].first == "first" && focusLog[1].second);
+
+		// Focus is dropped when the focused element or an ancestor goes away
+		tree.SetFocus(third);
+		group->Enable(false);
+		PGUI_CHECK(tree.GetFocusedElement() == nullptr);
+		group->Enable(true);
+		tree.SetFocus(third);
+		auto removed = tree.GetRoot().RemoveChild(group);
+		PGUI_CHECK(removed != nullptr);
+		PGUI_CHECK(tree.GetFocusedElement() == nullptr);
+		PGUI_CHECK(third->GetTree() == nullptr);
+		PGUI_CHECK(!third->HasFocus());
+	}
+
+	void CaptureAndHover()
+	{
+		VisualTree tree;
+		tree.GetRoot().SetBounds(RectF{ 0, 0, 200, 200 });
+
+		auto* left = Add(tree.GetRoot(), "left", RectF{ 0, 0, 100, 100 });
+		auto* right = Add(tree.GetRoot(), "right", RectF{ 100, 0, 200, 100 });
+
+		eventLog.clear();
+		tree.RouteInput(MakeEvent(InputEventType::MouseMove, PointF{ 10, 10 }));
+		PGUI_CHECK(tree.GetHoveredElement() == left);
+		PGUI_CHECK(eventLog.size() == 2);
+		PGUI_CHECK(eventLog.size() == 2 && eventLog[0].element == "left" && eventLog[0].type == InputEventType::MouseEnter);
+		PGUI_CHECK(eventLog.size() == 2 && eventLog[1].type == InputEventType::MouseMove);
+
+		// Moving within the element doesn't enter again
+		eventLog.clear();
+		tree.RouteInput(MakeEvent(InputEventType::MouseMove, PointF{ 20, 10 }));
+		PGUI_CHECK(eventLog.size() == 1);
+		PGUI_CHECK(!eventLog.empty() && eventLog[0].type == InputEventType::MouseMove);
+
+		// Leave comes before enter, each in the receiving element's coordinates
+		eventLog.clear();
+		tree.RouteInput(MakeEvent(InputEventType::MouseMove, PointF{ 150, 10 }));
+		PGUI_CHECK(tree.GetHoveredElement() == right);
+		PGUI_CHECK(LoggedNames() == "left right right ");
+		PGUI_CHECK(eventLog.size() == 3 && eventLog[0].element == "left" && eventLog[0].type == InputEventType::MouseLeave);
+		PGUI_CHECK(eventLog.size() == 3 && eventLog[0].position == (PointF{ 150, 10 }));
+		PGUI_CHECK(eventLog.size() == 3 && eventLog[1].element == "right" && eventLog[1].type == InputEventType::MouseEnter);
+		PGUI_CHECK(eventLog.size() == 3 && eventLog[1].position == (PointF{ 50, 10 }));
+
+		// A captured element gets every mouse event and hover stays where it was
+		right->CaptureMouse();
+		PGUI_CHECK(tree.GetCapturedElement() == right);
+		eventLog.clear();
+		tree.RouteInput(MakeEvent(InputEventType::MouseMove, PointF{ 10, 10 }));
+		tree.RouteInput(MakeEvent(InputEventType::MouseUp, PointF{ 10, 10 }));
+		PGUI_CHECK(tree.GetHoveredElement() == right);
+		PGUI_CHECK(LoggedNames() == "right right ");
+		PGUI_CHECK(!eventLog.empty() && eventLog[0].position == (PointF{ -90, 10 }));
+
+		// Leaving the window doesn't drop the hover while captured
+		tree.RouteInput(MakeEvent(InputEventType::MouseLeave));
+		PGUI_CHECK(tree.GetHoveredElement() == right);
+
+		// Only the element holding the capture can release it
+		left->ReleaseMouse();
+		PGUI_CHECK(tree.GetCapturedElement() == right);
+		right->ReleaseMouse();
+		PGUI_CHECK(tree.GetCapturedElement() == nullptr);
+
+		eventLog.clear();
+		tree.RouteInput(MakeEvent(InputEventType::MouseLeave));
+		PGUI_CHECK(tree.GetHoveredElement() == nullptr);
+		PGUI_CHECK(eventLog.size() == 1 && eventLog[0].type == InputEventType::MouseLeave);
+
+		// Hiding a captured element releases the capture
+		left->CaptureMouse();
+		left->Show(false);
+		PGUI_CHECK(tree.GetCapturedElement() == nullptr);
+	}
+
+	void Bubbling()
+	{
+		VisualTree tree;
+		tree.GetRoot().SetBounds(RectF{ 0, 0, 200, 200 });
+
+		auto* outer = Add(tree.GetRoot(), "outer", RectF{ 0, 0, 100, 100 });
+		auto* middle = Add(*outer, "middle", RectF{ 10, 10, 90, 90 });
+		auto* inner = Add(*middle, "inner", RectF{ 10, 10, 70, 70 });
+		inner->SetFocusable(true);
+
+		// Nothing handles it, the event goes all the way up
+		eventLog.clear();
+		PGUI_CHECK(!tree.RouteInput(MakeEvent(InputEventType::MouseUp, PointF{ 30, 30 })));
+		PGUI_CHECK(LoggedNames() == "inner middle outer ");
+		PGUI_CHECK(eventLog.size() == 3 && eventLog[0].position == (PointF{ 10, 10 }));
+		PGUI_CHECK(eventLog.size() == 3 && eventLog[1].position == (PointF{ 20, 20 }));
+		PGUI_CHECK(eventLog.size() == 3 && eventLog[2].position == (PointF{ 30, 30 }));
+
+		// A handler stops it
+		middle->SetHandles(true);
+		eventLog.clear();
+		PGUI_CHECK(tree.RouteInput(MakeEvent(InputEventType::MouseWheel, PointF{ 30, 30 })));
+		PGUI_CHECK(LoggedNames() == "inner middle ");
+
+		// Disabled elements are passed over, not the end of the route
+		middle->SetHandles(false);
+		middle->Enable(false);
+		eventLog.clear();
+		tree.RouteInput(MakeEvent(InputEventType::MouseUp, PointF{ 30, 30 }));
+		PGUI_CHECK(LoggedNames() == "inner outer ");
+		middle->Enable(true);
+
+		// Key events start at the focused element
+		tree.SetFocus(inner);
+		outer->SetHandles(true);
+		eventLog.clear();
+		PGUI_CHECK(tree.RouteInput(MakeEvent(InputEventType::Char, { }, 'a')));
+		PGUI_CHECK(LoggedNames() == "inner middle outer ");
+
+		// A handled Tab doesn't move the focus
+		PGUI_CHECK(tree.RouteInput(MakeEvent(InputEventType::KeyDown, { }, VisualTree::TabKey)));
+		PGUI_CHECK(inner->HasFocus());
+
+		// Key events with nothing focused go nowhere
+		tree.SetFocus(nullptr);
+		eventLog.clear();
+		PGUI_CHECK(!tree.RouteInput(MakeEvent(InputEventType::KeyUp, { }, 'A')));
+		PGUI_CHECK(eventLog.empty());
+	}
+
+	void RenderAndInvalidate()
+	{
+		VisualTree tree;
+		tree.GetRoot().SetBounds(RectF{ 0, 0, 200, 200 });
+
+		std::vector<RectF> invalidated;
+		tree.SetInvalidateCallback([&invalidated](RectF rect) { invalidated.push_back(rect); });
+
+		auto* panel = Add(tree.GetRoot(), "panel", RectF{ 100, 100, 200, 200 });
+		PGUI_CHECK(!invalidated.empty() && invalidated.back() == (RectF{ 100, 100, 200, 200 }));
+		auto* child = Add(*panel, "child", RectF{ 10, 10, 20, 20 });
+		PGUI_CHECK(!invalidated.empty() && invalidated.back() == (RectF{ 110, 110, 120, 120 }));
+		Add(tree.GetRoot(), "corner", RectF{ 0, 0, 10, 10 });
+
+		std::vector<std::pair<VisualElement*, RectF>> rendered;
+		const auto render = [&rendered](VisualElement& element, RectF bounds)
+		{
+			rendered.emplace_back(&element, bounds);
+		};
+
+		tree.Render(render);
+		PGUI_CHECK(rendered.size() == 3);
+		PGUI_CHECK(rendered.size() == 3 && rendered[1].first == child && rendered[1].second == (RectF{ 110, 110, 120, 120 }));
+
+		// Elements outside the clip rect are skipped along with their children
+		rendered.clear();
+		tree.Render(render, RectF{ 0, 0, 50, 50 });
+		PGUI_CHECK(rendered.size() == 1);
+
+		child->Show(false);
+		rendered.clear();
+		tree.Render(render);
+		PGUI_CHECK(rendered.size() == 2);
+	}
+}
+
+auto main() -> int
+{
+	HitTestOrder();
+	FocusAndTab();
+	CaptureAndHover();
+	Bubbling();
+	RenderAndInvalidate();
+
+	return PGUI::Tests::Finish();
+}
@@ -0,0 +1,125 @@
+#include "Check.hpp"
+#include "helpers/WorkerPool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <semaphore>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+	using namespace PGUI;
+
+	void RunsTasksInOrder()
+	{
+		std::atomic_int started = 0;
+		std::atomic_int exited = 0;
+
+		std::vector<int> order;
+		std::mutex orderMutex;
+		std::binary_semaphore done{ 0 };
+		{
+			WorkerPool pool{ 1, [&started] { started++; }, [&exited] { exited++; } };
+			PGUI_CHECK(pool.GetThreadCount() == 1);
+
+			for (auto i = 0; i < 100; i++)
+			{
+				pool.Submit([&, i]
+				{
+					std::scoped_lock lock{ orderMutex };
+					order.push_back(i);
+				});
+			}
+			pool.Submit([&done] { done.release(); });
+			done.acquire();
+		}
+
+		PGUI_CHECK(started == 1 && exited == 1);
+		PGUI_CHECK(order.size() == 100);
+		for (auto i = 0; i < static_cast<int>(order.size()); i++)
+		{
+			PGUI_CHECK(order[i] == i);
+		}
+	}
+
+	void DestructionDropsQueuedTasks()
+	{
+		std::binary_semaphore running{ 0 };
+		std::atomic_bool release = false;
+		std::atomic_int ranAfter = 0;
+
+		struct DestroyCounter
+		{
+			std::atomic_int* destroyed;
+			explicit DestroyCounter(std::atomic_int& _destroyed) noexcept : destroyed{ &_destroyed } { }
+			DestroyCounter(DestroyCounter&& other) noexcept : destroyed{ std::exchange(other.destroyed, nullptr) } { }
+			~DestroyCounter() noexcept
+			{
+				if (destroyed != nullptr)
+				{
+					(*destroyed)++;
+				}
+			}
+		};
+		std::atomic_int destroyed = 0;
+
+		std::optional<WorkerPool> pool{ std::in_place, 1 };
+		pool->Submit([&]
+		{
+			running.release();
+			while (!release)
+			{
+				std::this_thread::yield();
+			}
+		});
+		for (auto i = 0; i < 50; i++)
+		{
+			pool->Submit([&ranAfter, counter = DestroyCounter{ destroyed }] { ranAfter++; });
+		}
+		running.acquire();
+		PGUI_CHECK(pool->GetQueuedCount() == 50);
+
+		// Let the running task finish only after the destructor asked the thread to stop
+		std::jthread releaser{ [&release]
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds{ 50 });
+			release = true;
+		} };
+		pool.reset();
+
+		PGUI_CHECK(ranAfter == 0);
+		PGUI_CHECK(destroyed == 50);
+	}
+
+	void ManyThreadsRunEverything()
+	{
+		std::atomic_int ran = 0;
+		std::counting_semaphore<> done{ 0 };
+		{
+			WorkerPool pool{ 4 };
+			for (auto i = 0; i < 10000; i++)
+			{
+				pool.Submit([&] { ran++; done.release(); });
+			}
+			for (auto i = 0; i < 10000; i++)
+			{
+				done.acquire();
+			}
+		}
+		PGUI_CHECK(ran == 10000);
+	}
+}
+
+auto main() -> int
+{
+	RunsTasksInOrder();
+	DestructionDropsQueuedTasks();
+	ManyThreadsRunEverything();
+
+	return PGUI::Tests::Finish();
+}
@@ -0,0 +1,88 @@
+#include "helpers/AtlasPacker.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+	using namespace PGUI;
+	using Clock = std::chrono::steady_clock;
+
+	std::mt19937 engine{ 3 };
+
+	auto Next() -> std::uint32_t
+	{
+		return static_cast<std::uint32_t>(engine());
+	}
+
+	constexpr std::uint32_t IconSizes[] = { 16, 20, 24, 32, 40, 48, 64 };
+
+	/*
+	* Fills one 1024x1024 page, frees a random half and fills it again,
+	* then shows what a repack wins back
+	*/
+	void MeasurePacking(const char* name, const std::function<SizeU()>& nextSize)
+	{
+		AtlasAllocator allocator{ SizeU{ 1024, 1024 }, 1, 1 };
+		std::vector<AtlasEntryId> ids;
+
+		const auto fillStart = Clock::now();
+		while (const auto id = allocator.Allocate(nextSize()))
+		{
+			ids.push_back(*id);
+		}
+		const std::chrono::duration<double, std::micro> fillTime = Clock::now() - fillStart;
+		const auto insertCount = ids.size();
+		const auto filled = allocator.GetOccupancy();
+
+		std::ranges::shuffle(ids, engine);
+		for (std::size_t i = 0; i < ids.size() / 2; i++)
+		{
+			allocator.Free(ids[i]);
+		}
+		ids.erase(ids.begin(), ids.begin() + static_cast<std::ptrdiff_t>(ids.size() / 2));
+		while (const auto id = allocator.Allocate(nextSize()))
+		{
+			ids.push_back(*id);
+		}
+		const auto afterChurn = allocator.GetOccupancy();
+
+		const auto repackStart = Clock::now();
+		const auto moves = allocator.Repack();
+		const std::chrono::duration<double, std::micro> repackTime = Clock::now() - repackStart;
+
+		auto extraCount = 0;
+		while (allocator.Allocate(nextSize()).has_value())
+		{
+			extraCount++;
+		}
+
+		std::printf("%-18s %5zu rects, fill %.1f%% (%.2f us per insert), after churn %.1f%%, "
+			"repack %zu moves in %.0f us -> %.1f%% (+%d rects)\n",
+			name, insertCount, filled * 100, fillTime.count() / static_cast<double>(insertCount), afterChurn * 100,
+			moves.size(), repackTime.count(), allocator.GetOccupancy() * 100, extraCount);
+	}
+}
+
+auto main() -> int
+{
+	MeasurePacking("square icons", []
+	{
+		const auto side = IconSizes[Next() % std::size(IconSizes)];
+		return SizeU{ side, side };
+	});
+	MeasurePacking("random 8..128", []
+	{
+		return SizeU{ 8 + Next() % 121, 8 + Next() % 121 };
+	});
+	MeasurePacking("glyph-like 6..40", []
+	{
+		return SizeU{ 6 + Next() % 20, 12 + Next() % 29 };
+	});
+}
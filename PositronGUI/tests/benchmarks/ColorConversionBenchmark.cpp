@@ -0,0 +1,122 @@
+#include "Benchmark.hpp"
+#include "ui/ColorConversion.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+	using namespace PGUI::UI;
+	using PGUI::Tests::KeepAlive;
+	using PGUI::Tests::MeasureNanoseconds;
+
+	constexpr std::size_t ColorCount = 1 << 20;
+
+	template <typename Function>
+	void PrintThroughput(const char* name, Function&& function)
+	{
+		const auto nanoseconds = MeasureNanoseconds(2, [&function](std::size_t)
+		{
+			function();
+		});
+		std::printf("%-24s %7.0f\n", name, static_cast<double>(ColorCount) * 1000.0 / nanoseconds);
+	}
+}
+
+auto main() -> int
+{
+	std::mt19937 engine{ 1 };
+	std::uniform_real_distribution<float> unit{ 0.0F, 1.0F };
+
+	std::vector<float> first(ColorCount);
+	std::vector<float> second(ColorCount);
+	std::vector<float> third(ColorCount);
+	std::vector<float> r(ColorCount);
+	std::vector<float> g(ColorCount);
+	std::vector<float> b(ColorCount);
+	std::vector<float> k(ColorCount);
+	std::vector<HSV> hsv(ColorCount);
+	std::vector<HSL> hsl(ColorCount);
+	std::vector<RGBA> rgba(ColorCount);
+	for (std::size_t i = 0; i < ColorCount; i++)
+	{
+		first[i] = unit(engine) * 360.0F;
+		second[i] = unit(engine);
+		third[i] = unit(engine);
+		hsv[i] = HSV{ first[i], second[i], third[i] };
+	}
+
+	std::printf("Millions of colors per second\n");
+	PrintThroughput("hsv->rgb one by one", [&]
+	{
+		std::ranges::transform(hsv, rgba.begin(), [](HSV color) { return RGBA{ color }; });
+		KeepAlive(rgba.data());
+	});
+	PrintThroughput("hsv->rgb planar", [&]
+	{
+		HsvToRgb(first.data(), second.data(), third.data(), r.data(), g.data(), b.data(), ColorCount);
+		KeepAlive(r.data());
+	});
+	PrintThroughput("hsv->rgb packed", [&]
+	{
+		ConvertColors(hsv, rgba.data());
+		KeepAlive(rgba.data());
+	});
+	PrintThroughput("hsl->rgb planar", [&]
+	{
+		HslToRgb(first.data(), second.data(), third.data(), r.data(), g.data(), b.data(), ColorCount);
+		KeepAlive(r.data());
+	});
+	PrintThroughput("cmyk->rgb planar", [&]
+	{
+		CmykToRgb(second.data(), third.data(), second.data(), third.data(), r.data(), g.data(), b.data(), ColorCount);
+		KeepAlive(r.data());
+	});
+
+	// Hues sorted take the same sector over long runs, so the one by one branches predict well
+	auto sortedHsv = hsv;
+	std::ranges::sort(sortedHsv, { }, &HSV::h);
+	PrintThroughput("hsv->rgb sorted hues", [&]
+	{
+		std::ranges::transform(sortedHsv, rgba.begin(), [](HSV color) { return RGBA{ color }; });
+		KeepAlive(rgba.data());
+	});
+
+	for (std::size_t i = 0; i < ColorCount; i++)
+	{
+		r[i] = unit(engine);
+		g[i] = unit(engine);
+		b[i] = unit(engine);
+		rgba[i] = RGBA{ r[i], g[i], b[i] };
+	}
+	PrintThroughput("rgb->hsv one by one", [&]
+	{
+		std::ranges::transform(rgba, hsv.begin(), [](RGBA color) { return HSV{ color }; });
+		KeepAlive(hsv.data());
+	});
+	PrintThroughput("rgb->hsv planar", [&]
+	{
+		RgbToHsv(r.data(), g.data(), b.data(), first.data(), second.data(), third.data(), ColorCount);
+		KeepAlive(first.data());
+	});
+	PrintThroughput("rgb->hsl planar", [&]
+	{
+		RgbToHsl(r.data(), g.data(), b.data(), first.data(), second.data(), third.data(), ColorCount);
+		KeepAlive(first.data());
+	});
+	PrintThroughput("rgb->cmyk planar", [&]
+	{
+		RgbToCmyk(r.data(), g.data(), b.data(), first.data(), second.data(), third.data(), k.data(), ColorCount);
+		KeepAlive(first.data());
+	});
+	PrintThroughput("rgb->hsl packed", [&]
+	{
+		ConvertColors(rgba, hsl.data());
+		KeepAlive(hsl.data());
+	});
+
+	return 0;
+}
@@ -0,0 +1,125 @@
+#include "core/Event.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace PGUI::Core
+{
+	auto event_detail::GetCurrentThreadQueue() -> std::shared_ptr<DispatcherQueue>
+	{
+		return nullptr;
+	}
+}
+
+namespace
+{
+	using namespace PGUI::Core;
+
+	constexpr auto HandlerCount = 4;
+
+	thread_local long sink = 0;
+
+	// The Event this replaced with a lock added, the unlocked original wasn't safe to emit from several threads
+	class LockedListEvent
+	{
+		public:
+		void Subscribe(std::function<void(int)> handler)
+		{
+			handlers.push_back(std::move(handler));
+		}
+		void Emit(int value) const
+		{
+			std::scoped_lock lock{ mutex };
+			for (const auto& handler : handlers)
+			{
+				handler(value);
+			}
+		}
+
+		private:
+		std::list<std::function<void(int)>> handlers;
+		mutable std::mutex mutex;
+	};
+
+	// Copy on write through atomic<shared_ptr>, the usual alternative
+	class SharedPtrEvent
+	{
+		using Handlers = std::vector<std::function<void(int)>>;
+
+		public:
+		void Subscribe(std::function<void(int)> handler)
+		{
+			auto next = std::make_shared<Handlers>(*handlers.load());
+			next->push_back(std::move(handler));
+			handlers.store(std::move(next));
+		}
+		void Emit(int value) const
+		{
+			for (const auto snapshot = handlers.load(); const auto& handler : *snapshot)
+			{
+				handler(value);
+			}
+		}
+
+		private:
+		std::atomic<std::shared_ptr<const Handlers>> handlers{ std::make_shared<const Handlers>() };
+	};
+
+	template <typename EventType>
+	auto MeasureEmit(int threadCount, long emitsPerThread) -> double
+	{
+		EventType event;
+		for (auto i = 0; i < HandlerCount; i++)
+		{
+			event.Subscribe([](int value) { sink += value; });
+		}
+
+		std::atomic_int ready = 0;
+		const auto start = std::chrono::steady_clock::now();
+		{
+			std::vector<std::jthread> threads;
+			for (auto i = 0; i < threadCount; i++)
+			{
+				threads.emplace_back([&]
+				{
+					ready++;
+					while (ready < threadCount)
+					{
+						std::this_thread::yield();
+					}
+					for (long emit = 0; emit < emitsPerThread; emit++)
+					{
+						event.Emit(1);
+					}
+				});
+			}
+		}
+		const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+		return elapsed.count() / static_cast<double>(emitsPerThread * threadCount);
+	}
+}
+
+auto main() -> int
+{
+	std::printf("%u hardware threads, %d handlers, ns per Emit\n", std::thread::hardware_concurrency(), HandlerCount);
+
+	for (const auto threadCount : { 1, 8, 64 })
+	{
+		const long emitsPerThread = 4'000'000 / threadCount;
+
+		std::printf("%2d emitting threads: Event %6.1f, mutex + list %6.1f, atomic<shared_ptr> %6.1f\n",
+			threadCount,
+			MeasureEmit<Event<int>>(threadCount, emitsPerThread),
+			MeasureEmit<LockedListEvent>(threadCount, emitsPerThread),
+			MeasureEmit<SharedPtrEvent>(threadCount, emitsPerThread));
+	}
+}
@@ -0,0 +1,92 @@
+#include "Benchmark.hpp"
+#include "helpers/FenwickTree.hpp"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+	using PGUI::FenwickTree;
+	using PGUI::Tests::KeepAlive;
+	using PGUI::Tests::MeasureNanoseconds;
+
+	// The linear walks ListView did before the height index
+	auto LinearFind(const std::vector<long>& heights, long offset) -> std::size_t
+	{
+		std::size_t index = 0;
+		for (long top = 0; index < heights.size(); index++)
+		{
+			top += heights[index];
+			if (offset < top)
+			{
+				break;
+			}
+		}
+		return index;
+	}
+	auto LinearHeightUpTo(const std::vector<long>& heights, std::size_t count) -> long
+	{
+		long height = 0;
+		for (std::size_t i = 0; i < count; i++)
+		{
+			height += heights[i];
+		}
+		return height;
+	}
+
+	void Run(std::size_t rowCount)
+	{
+		std::mt19937 random{ 1 };
+		std::uniform_int_distribution<long> heightDistribution{ 20, 80 };
+
+		std::vector<long> heights(rowCount);
+		for (auto& height : heights)
+		{
+			height = heightDistribution(random);
+		}
+		const FenwickTree<long> tree{ heights };
+		const auto total = tree.Total();
+
+		std::vector<long> offsets(1024);
+		std::vector<std::size_t> indexes(1024);
+		for (std::size_t i = 0; i < offsets.size(); i++)
+		{
+			offsets[i] = static_cast<long>(random() % static_cast<unsigned long>(total));
+			indexes[i] = random() % rowCount;
+		}
+
+		// The linear walks are O(n), fewer calls keep the big lists from taking minutes
+		const auto linearIterations = std::max<std::size_t>(4, 4'000'000 / rowCount);
+		constexpr std::size_t indexIterations = 1'000'000;
+
+		const auto linearFind = MeasureNanoseconds(linearIterations, [&](std::size_t i)
+		{
+			KeepAlive(LinearFind(heights, offsets[i % offsets.size()]));
+		});
+		const auto treeFind = MeasureNanoseconds(indexIterations, [&](std::size_t i)
+		{
+			KeepAlive(tree.Find(offsets[i % offsets.size()]));
+		});
+		const auto linearHeight = MeasureNanoseconds(linearIterations, [&](std::size_t i)
+		{
+			KeepAlive(LinearHeightUpTo(heights, indexes[i % indexes.size()]));
+		});
+		const auto treeHeight = MeasureNanoseconds(indexIterations, [&](std::size_t i)
+		{
+			KeepAlive(tree.PrefixSum(indexes[i % indexes.size()]));
+		});
+
+		std::printf("%9zu rows | hit test: linear %12.1f ns, index %6.1f ns | height up to index: linear %12.1f ns, index %6.1f ns\n",
+			rowCount, linearFind, treeFind, linearHeight, treeHeight);
+	}
+}
+
+auto main() -> int
+{
+	for (const auto rowCount : { 1'000ULL, 100'000ULL, 10'000'000ULL })
+	{
+		Run(rowCount);
+	}
+}
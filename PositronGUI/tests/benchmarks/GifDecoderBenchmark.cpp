@@ -0,0 +1,145 @@
+#include "Benchmark.hpp"
+#include "ui/bmp/GifDecoder.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+	using namespace PGUI::UI::Bmp;
+	using PGUI::Tests::KeepAlive;
+	using PGUI::Tests::MeasureNanoseconds;
+
+	// Uncompressed LZW, a clear code before the table grows, so any size can be made without an encoder
+	auto MakeAnimation(std::uint16_t width, std::uint16_t height, int frameCount) -> std::vector<std::byte>
+	{
+		std::vector<std::uint8_t> out{ 'G', 'I', 'F', '8', '9', 'a' };
+		auto put16 = [&out](std::uint32_t value)
+		{
+			out.push_back(static_cast<std::uint8_t>(value));
+			out.push_back(static_cast<std::uint8_t>(value >> 8));
+		};
+
+		put16(width);
+		put16(height);
+		out.insert(out.end(), { 0xF7, 0x00, 0x00 });
+		for (auto i = 0; i < 256; i++)
+		{
+			out.insert(out.end(), { static_cast<std::uint8_t>(i), static_cast<std::uint8_t>(255 - i), static_cast<std::uint8_t>(i * 7) });
+		}
+
+		std::mt19937 random{ 1 };
+		for (auto frame = 0; frame < frameCount; frame++)
+		{
+			// Every other frame is transparent in places and disposed to the background
+			out.insert(out.end(), { 0x21, 0xF9, 0x04, static_cast<std::uint8_t>(frame % 2 == 0 ? 0x04 : 0x09), 0x02, 0x00, 0x00, 0x00 });
+			out.push_back(0x2C);
+			put16(0);
+			put16(0);
+			put16(width);
+			put16(height);
+			out.push_back(0);
+			out.push_back(8);
+
+			// 9 bit codes, clear every 254 pixels so the table never grows past them
+			std::vector<std::uint8_t> bytes;
+			std::uint32_t accumulator = 0;
+			std::uint32_t bitCount = 0;
+			auto write = [&](std::uint32_t code)
+			{
+				accumulator |= code << bitCount;
+				bitCount += 9;
+				while (bitCount >= 8)
+				{
+					bytes.push_back(static_cast<std::uint8_t>(accumulator));
+					accumulator >>= 8;
+					bitCount -= 8;
+				}
+			};
+			const auto pixelCount = static_cast<std::size_t>(width) * height;
+			for (std::size_t pixel = 0; pixel < pixelCount; pixel++)
+			{
+				if (pixel % 254 == 0)
+				{
+					write(256);
+				}
+				write(random() % 256);
+			}
+			write(257);
+			if (bitCount != 0)
+			{
+				bytes.push_back(static_cast<std::uint8_t>(accumulator));
+			}
+
+			for (std::size_t i = 0; i < bytes.size(); i += 255)
+			{
+				const auto length = std::min<std::size_t>(255, bytes.size() - i);
+				out.push_back(static_cast<std::uint8_t>(length));
+				out.insert(out.end(), bytes.begin() + static_cast<std::ptrdiff_t>(i), bytes.begin() + static_cast<std::ptrdiff_t>(i + length));
+			}
+			out.push_back(0);
+		}
+		out.push_back(0x3B);
+
+		std::vector<std::byte> file(out.size());
+		std::ranges::transform(out, file.begin(), [](std::uint8_t value) { return std::byte{ value }; });
+		return file;
+	}
+}
+
+auto main() -> int
+{
+	std::mt19937 random{ 1 };
+	GifPalette palette{ };
+	for (auto& color : palette)
+	{
+		color = random() | 0xFF000000U;
+	}
+
+	for (const std::size_t count : { 32U, 256U, 4096U })
+	{
+		std::vector<std::uint8_t> indices(count);
+		for (auto& index : indices)
+		{
+			index = static_cast<std::uint8_t>(random());
+		}
+		std::vector<std::uint32_t> row(count);
+
+		for (const auto transparentIndex : { std::optional<std::uint8_t>{ }, std::optional<std::uint8_t>{ 7 } })
+		{
+			const auto scalar = MeasureNanoseconds(100000, [&](std::size_t)
+			{
+				gif_detail::ExpandPaletteIndicesScalar(indices, palette, transparentIndex, row.data());
+				KeepAlive(row);
+			});
+			const auto avx2 = MeasureNanoseconds(100000, [&](std::size_t)
+			{
+				gif_detail::ExpandPaletteIndicesAvx2(indices, palette, transparentIndex, row.data());
+				KeepAlive(row);
+			});
+			std::printf("expand %4zu px, transparent %d: scalar %7.1f ns (%.2f px/ns), avx2 %7.1f ns (%.2f px/ns)\n",
+				count, transparentIndex.has_value(), scalar, static_cast<double>(count) / scalar, avx2, static_cast<double>(count) / avx2);
+		}
+	}
+
+	for (const auto& [width, height] : { std::pair<std::uint16_t, std::uint16_t>{ 120, 90 }, { 480, 270 }, { 1280, 720 } })
+	{
+		const auto decoder = std::make_shared<const GifDecoder>(MakeAnimation(width, height, 8));
+		GifComposer composer{ decoder };
+
+		const auto frameCount = decoder->GetFrameCount();
+		const auto perFrame = MeasureNanoseconds(200, [&](std::size_t i)
+		{
+			KeepAlive(composer.ComposeFrame(i % frameCount));
+		});
+		std::printf("compose %4ux%-4u: %9.0f ns per frame (%.2f px/ns)\n", width, height, perFrame,
+			static_cast<double>(width) * height / perFrame);
+	}
+}
@@ -0,0 +1,203 @@
+#include "Benchmark.hpp"
+#include "core/MessageDispatchTable.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+
+namespace
+{
+	using namespace PGUI::Core;
+	using PGUI::Tests::KeepAlive;
+
+	constexpr auto StreamLength = 400'000;
+	constexpr auto Repeats = 10;
+
+	struct TestWindow
+	{
+		long callCount = 0;
+
+		auto OnMessage(UINT msg, WPARAM, LPARAM) -> HandlerResult
+		{
+			callCount++;
+			return static_cast<LRESULT>(msg);
+		}
+	};
+
+	// What Window kept before the table, bound member functions in a map looked up twice a message
+	using Handler = std::function<HandlerResult(UINT, WPARAM, LPARAM)>;
+	using HandlerMap = std::unordered_map<UINT, std::vector<Handler>>;
+
+	[[gnu::noinline]] auto MapDispatch(HandlerMap& handlerMap, UINT msg, WPARAM wParam, LPARAM lParam) -> bool
+	{
+		if (!handlerMap.contains(msg))
+		{
+			return false;
+		}
+
+		LRESULT result = 0;
+		bool passToDefWindowProc = false;
+		bool forceCurrentResult = false;
+		for (const auto& handler : handlerMap[msg])
+		{
+			auto [lResult, flags] = std::invoke(handler, msg, wParam, lParam);
+			using enum HandlerResultFlag;
+
+			if (!(flags & ReturnPrevResult))
+			{
+				result = lResult;
+			}
+			if ((flags & NoFurtherHandling) != Nothing)
+			{
+				break;
+			}
+			if (forceCurrentResult)
+			{
+				continue;
+			}
+			if ((flags & ForceThisResult) != Nothing)
+			{
+				forceCurrentResult = true;
+			}
+			if ((flags & PassToDefWindowProc) != Nothing)
+			{
+				passToDefWindowProc = true;
+			}
+		}
+		KeepAlive(result);
+		KeepAlive(passToDefWindowProc);
+
+		return true;
+	}
+
+	[[gnu::noinline]] auto TableDispatch(const MessageDispatchTable& table, UINT msg, WPARAM wParam, LPARAM lParam) -> bool
+	{
+		const auto result = table.Dispatch(msg, wParam, lParam);
+		KeepAlive(result.result);
+		return result.handled;
+	}
+
+	// About what a control registers, the first three get a handler from each layer of the class hierarchy
+	constexpr UINT RegisteredMessages[] = {
+		WM_CREATE, WM_SIZE, WM_LBUTTONDOWN, WM_DESTROY, 0x0007, 0x0008, WM_PAINT, 0x0014, WM_SETCURSOR,
+		0x0046, 0x0047, 0x0081, 0x0083, WM_NCHITTEST, 0x0087, WM_KEYDOWN, WM_CHAR, WM_MOUSEMOVE,
+		WM_LBUTTONUP, WM_MOUSEWHEEL, WM_MOUSELEAVE, WM_DPICHANGED, 0x0214, 0x0216
+	};
+	// Mouse, hit-test, cursor and key traffic, some of which no handler wants
+	constexpr UINT StreamMessages[] = {
+		WM_MOUSEMOVE, WM_NCHITTEST, WM_SETCURSOR, WM_MOUSEMOVE, WM_MOUSEMOVE, WM_PAINT, WM_TIMER, 0x0281, WM_KEYDOWN,
+		WM_CHAR, WM_LBUTTONDOWN, WM_LBUTTONUP, 0x0024, WM_MOUSEMOVE, WM_NCHITTEST, WM_SETCURSOR, 0x02A1, 0x0210
+	};
+
+	struct Windows
+	{
+		std::vector<std::unique_ptr<TestWindow>> windows;
+		std::vector<std::unique_ptr<MessageDispatchTable>> tables;
+		std::vector<std::unique_ptr<HandlerMap>> handlerMaps;
+
+		explicit Windows(std::size_t count)
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+				auto* window = windows.emplace_back(std::make_unique<TestWindow>()).get();
+				auto& table = *tables.emplace_back(std::make_unique<MessageDispatchTable>());
+				auto& handlerMap = *handlerMaps.emplace_back(std::make_unique<HandlerMap>());
+
+				for (std::size_t m = 0; m < std::size(RegisteredMessages); m++)
+				{
+					const auto msg = RegisteredMessages[m];
+					for (auto layer = 0; layer < (m < 3 ? 3 : 1); layer++)
+					{
+						table.Add(msg, MessageHandlerRef{ window, &TestWindow::OnMessage });
+						handlerMap[msg].push_back(std::bind_front(&TestWindow::OnMessage, window));
+					}
+				}
+			}
+		}
+	};
+
+	struct Message
+	{
+		std::size_t window;
+		RecordedMessage message;
+	};
+
+	auto MakeStream(std::size_t windowCount, bool predictable) -> std::vector<Message>
+	{
+		std::mt19937 random{ 1 };
+		std::vector<Message> stream;
+		stream.reserve(StreamLength);
+
+		for (auto i = 0; i < StreamLength; i++)
+		{
+			const auto window = windowCount == 1 ? 0 : static_cast<std::size_t>(i) % windowCount;
+			const auto msg = predictable ?
+				StreamMessages[static_cast<std::size_t>(i) % std::size(StreamMessages)] :
+				StreamMessages[random() % std::size(StreamMessages)];
+			stream.push_back(Message{ window, RecordedMessage{ msg, 0, 0 } });
+		}
+		return stream;
+	}
+
+	template <typename Dispatcher>
+	auto MeasureStream(const std::vector<Message>& stream, Dispatcher&& dispatch) -> double
+	{
+		std::size_t handledCount = 0;
+
+		const auto start = std::chrono::steady_clock::now();
+		for (auto repeat = 0; repeat < Repeats; repeat++)
+		{
+			for (const auto& [window, message] : stream)
+			{
+				handledCount += dispatch(window, message) ? 1 : 0;
+			}
+		}
+		const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+		KeepAlive(handledCount);
+
+		return elapsed.count() / static_cast<double>(stream.size() * Repeats);
+	}
+
+	void MeasureDispatch(const char* name, std::size_t windowCount, bool predictable)
+	{
+		Windows windows{ windowCount };
+		const auto stream = MakeStream(windowCount, predictable);
+
+		const auto mapTime = MeasureStream(stream, [&windows](std::size_t window, const RecordedMessage& message)
+		{
+			return MapDispatch(*windows.handlerMaps[window], message.msg, message.wParam, message.lParam);
+		});
+		const auto tableTime = MeasureStream(stream, [&windows](std::size_t window, const RecordedMessage& message)
+		{
+			return TableDispatch(*windows.tables[window], message.msg, message.wParam, message.lParam);
+		});
+
+		std::printf("%-32s map %6.2f, table %6.2f\n", name, mapTime, tableTime);
+	}
+}
+
+auto main() -> int
+{
+	std::printf("%zu registered messages a window, ns per message\n", std::size(RegisteredMessages));
+
+	MeasureDispatch("1 window, predictable stream", 1, true);
+	MeasureDispatch("1 window, random stream", 1, false);
+	MeasureDispatch("2000 windows, round-robin", 2000, false);
+
+	// ReplayMessages is what Window::RecordMessages streams are timed with
+	Windows windows{ 1 };
+	std::vector<RecordedMessage> messages;
+	for (const auto& [window, message] : MakeStream(1, false))
+	{
+		messages.push_back(message);
+	}
+	const auto replay = ReplayMessages(*windows.tables.front(), messages, Repeats);
+	std::printf("%-32s table %6.2f, %zu of %zu handled\n", "ReplayMessages, random stream",
+		replay.NanosecondsPerMessage(), replay.handledCount, replay.messageCount);
+}
@@ -0,0 +1,103 @@
+#include "Benchmark.hpp"
+#include "graphics/PixelConversion.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+
+namespace
+{
+	using namespace PGUI::Graphics;
+	using PGUI::Tests::KeepAlive;
+	using PGUI::Tests::MeasureNanoseconds;
+
+	// One 1080p frame
+	constexpr std::size_t PixelCount = 1920 * 1080;
+
+	/*
+	* Throughput in GB of source read per second
+	*/
+	template <typename Function>
+	void PrintThroughput(const char* name, std::size_t sourceBytes, Function&& function)
+	{
+		const auto nanoseconds = MeasureNanoseconds(3, [&function](std::size_t)
+		{
+			function();
+		});
+		std::printf(" %s %6.2f", name, static_cast<double>(sourceBytes) / nanoseconds);
+	}
+
+	void MeasureKernels(const char* levelName, const PixelKernels& kernels)
+	{
+		std::vector<std::uint32_t> pixels(PixelCount);
+		std::vector<std::uint32_t> converted(PixelCount);
+		std::vector<std::uint16_t> pixels565(PixelCount);
+		std::vector<std::uint8_t> grays(PixelCount);
+		std::vector<std::uint64_t> halves(PixelCount);
+		for (std::size_t i = 0; i < PixelCount; i++)
+		{
+			pixels[i] = static_cast<std::uint32_t>(i * 2654435761U);
+			pixels565[i] = static_cast<std::uint16_t>(i * 40503U);
+			grays[i] = static_cast<std::uint8_t>(i);
+		}
+		kernels.bgra8ToRgba16Float(pixels.data(), halves.data(), PixelCount, false);
+
+		std::printf("%-7s", levelName);
+		PrintThroughput("swap", PixelCount * 4, [&]
+		{
+			kernels.swapRedBlue(pixels.data(), converted.data(), PixelCount);
+		});
+		PrintThroughput("premultiply", PixelCount * 4, [&]
+		{
+			kernels.premultiply(pixels.data(), converted.data(), PixelCount);
+		});
+		PrintThroughput("unpremultiply", PixelCount * 4, [&]
+		{
+			kernels.unpremultiply(pixels.data(), converted.data(), PixelCount);
+		});
+		PrintThroughput("gray8", PixelCount, [&]
+		{
+			kernels.gray8ToBgra8(grays.data(), converted.data(), PixelCount);
+		});
+		PrintThroughput("565to8", PixelCount * 2, [&]
+		{
+			kernels.bgr565ToBgra8(pixels565.data(), converted.data(), PixelCount);
+		});
+		PrintThroughput("8to565", PixelCount * 4, [&]
+		{
+			kernels.bgra8ToBgr565(pixels.data(), pixels565.data(), PixelCount);
+		});
+		PrintThroughput("toHalf", PixelCount * 4, [&]
+		{
+			kernels.bgra8ToRgba16Float(pixels.data(), halves.data(), PixelCount, false);
+		});
+		PrintThroughput("toHalfSrgb", PixelCount * 4, [&]
+		{
+			kernels.bgra8ToRgba16Float(pixels.data(), halves.data(), PixelCount, true);
+		});
+		PrintThroughput("fromHalf", PixelCount * 8, [&]
+		{
+			kernels.rgba16FloatToBgra8(halves.data(), converted.data(), PixelCount, false);
+		});
+		PrintThroughput("fromHalfSrgb", PixelCount * 8, [&]
+		{
+			kernels.rgba16FloatToBgra8(halves.data(), converted.data(), PixelCount, true);
+		});
+		std::printf("\n");
+
+		KeepAlive(converted.data());
+		KeepAlive(pixels565.data());
+		KeepAlive(halves.data());
+	}
+}
+
+auto main() -> int
+{
+	std::printf("GB/s of source converted, 1920x1080 frames\n");
+	MeasureKernels("scalar", GetPixelKernels(PixelKernelLevel::Scalar));
+	MeasureKernels("sse4.1", GetPixelKernels(PixelKernelLevel::Sse41));
+	MeasureKernels("avx2", GetPixelKernels(PixelKernelLevel::Avx2));
+
+	return 0;
+}
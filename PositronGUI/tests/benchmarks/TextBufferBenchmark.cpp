@@ -0,0 +1,148 @@
+#include "Benchmark.hpp"
+#include "ui/TextBuffer.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+
+
+namespace
+{
+	using PGUI::UI::TextBuffer;
+	using PGUI::Tests::KeepAlive;
+	using PGUI::Tests::MeasureNanoseconds;
+	using Clock = std::chrono::steady_clock;
+
+	// 100 MB of UTF-16 in 80 character lines
+	constexpr std::size_t TextLength = 50'000'000;
+	constexpr std::size_t LineLength = 80;
+	constexpr std::size_t EditCount = 200'000;
+
+	constexpr std::wstring_view Needle = L"needle in";
+
+	std::mt19937_64 engine{ 7 };
+
+	auto Next(std::size_t bound) -> std::size_t
+	{
+		return static_cast<std::size_t>(engine() % bound);
+	}
+
+	/*
+	* 4M characters of prose with the needle at the end, searched in pieces against a flat copy
+	*/
+	void MeasureFind()
+	{
+		constexpr std::wstring_view Words[] = { L"the ", L"quick ", L"brown ", L"fox ", L"jumps ", L"over ", L"lazy ", L"dog\r" };
+		std::wstring prose;
+		while (prose.size() < 4'000'000)
+		{
+			prose += Words[Next(std::size(Words))];
+		}
+		prose += L"needle in the haystack";
+
+		TextBuffer buffer{ prose, L'\r' };
+		for (auto i = 0; i < 2000; i++)
+		{
+			buffer.Insert(Next(buffer.GetLength() - 100), L"fox ");
+		}
+		const auto flat = buffer.GetText();
+
+		std::printf("find in %zu pieces      %10.0f ns\n", buffer.GetPieceCount(), MeasureNanoseconds(10, [&buffer](std::size_t)
+		{
+			KeepAlive(buffer.Find(Needle));
+		}));
+		std::printf("find in a flat copy      %10.0f ns\n", MeasureNanoseconds(10, [&flat](std::size_t)
+		{
+			KeepAlive(std::wstring_view{ flat }.find(Needle));
+		}));
+		std::printf("copy then find           %10.0f ns\n", MeasureNanoseconds(10, [&buffer](std::size_t)
+		{
+			KeepAlive(buffer.GetText().find(Needle));
+		}));
+	}
+
+	auto MakeText() -> std::wstring
+	{
+		std::wstring text(TextLength, L'x');
+		for (auto i = LineLength - 1; i < TextLength; i += LineLength)
+		{
+			text[i] = L'\n';
+		}
+		return text;
+	}
+}
+
+auto main() -> int
+{
+	auto loadStart = Clock::now();
+	TextBuffer buffer{ MakeText() };
+	const std::chrono::duration<double, std::milli> loadTime = Clock::now() - loadStart;
+	std::printf("load %zu characters     %10.1f ms, %zu pieces, %zu lines\n",
+		TextLength, loadTime.count(), buffer.GetPieceCount(), buffer.GetLineCount());
+
+	auto editStart = Clock::now();
+	for (std::size_t i = 0; i < EditCount; i++)
+	{
+		const auto position = Next(buffer.GetLength());
+		if (i % 2 == 0)
+		{
+			buffer.Erase(position, 5);
+		}
+		else
+		{
+			buffer.Insert(position, L"hello\n");
+		}
+	}
+	const std::chrono::duration<double, std::nano> editTime = Clock::now() - editStart;
+	std::printf("random insert or erase   %10.0f ns, %zu pieces\n",
+		editTime.count() / static_cast<double>(EditCount), buffer.GetPieceCount());
+
+	std::printf("undo then redo           %10.0f ns\n", MeasureNanoseconds(100, [&buffer](std::size_t)
+	{
+		buffer.Undo();
+		buffer.Redo();
+	}) / 2.0);
+	std::printf("line start               %10.0f ns\n", MeasureNanoseconds(EditCount, [&buffer](std::size_t)
+	{
+		KeepAlive(buffer.GetLineStart(Next(buffer.GetLineCount())));
+	}));
+	std::printf("line from position       %10.0f ns\n", MeasureNanoseconds(EditCount, [&buffer](std::size_t)
+	{
+		KeepAlive(buffer.GetLineFromPosition(Next(buffer.GetLength())));
+	}));
+
+	// Typed characters extend the piece before them instead of adding one each
+	auto typingStart = Clock::now();
+	for (std::size_t i = 0; i < EditCount; i++)
+	{
+		const auto position = Next(buffer.GetLength());
+		buffer.Insert(position, L"a");
+		buffer.Insert(position + 1, L"b");
+		buffer.Insert(position + 2, L"c");
+	}
+	const std::chrono::duration<double, std::nano> typingTime = Clock::now() - typingStart;
+	std::printf("typed character          %10.0f ns, %zu pieces\n",
+		typingTime.count() / (3.0 * static_cast<double>(EditCount)), buffer.GetPieceCount());
+
+	// What every edit cost when the text was one string
+	auto flat = MakeText();
+	std::printf("std::wstring insert      %10.0f ns\n", MeasureNanoseconds(40, [&flat](std::size_t)
+	{
+		flat.insert(Next(flat.size()), L"hello\n");
+	}));
+
+	auto copyStart = Clock::now();
+	auto text = buffer.GetText();
+	const std::chrono::duration<double, std::milli> copyTime = Clock::now() - copyStart;
+	KeepAlive(text.data());
+	std::printf("whole text copy          %10.1f ms\n", copyTime.count());
+
+	MeasureFind();
+
+	return 0;
+}
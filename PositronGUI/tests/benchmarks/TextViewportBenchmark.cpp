@@ -0,0 +1,148 @@
+#include "Benchmark.hpp"
+#include "ui/TextViewport.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+
+/*
+* A stub shaper in place of DirectWrite, a layout is one line as many characters wide as it has
+* and LineHeight tall, so the timings are the viewport's and the layout cache's own
+*/
+namespace
+{
+	constexpr float CharacterWidth = 8.0F;
+	constexpr float LineHeight = 20.0F;
+
+	struct StubTextLayout : IDWriteTextLayout4
+	{
+		UINT32 length = 0;
+	};
+}
+
+namespace PGUI::UI
+{
+	TextFormat::TextFormat(const TextFormatDescriptor& descriptor) noexcept
+	{
+		auto* format = new IDWriteTextFormat3{ };
+		format->wordWrapping = descriptor.wordWrapping;
+		*GetHeldPtrAddress() = format;
+	}
+
+	TextLayout::TextLayout(std::wstring_view text, const TextFormat& textFormat, SizeF) noexcept
+	{
+		auto* layout = new StubTextLayout{ };
+		layout->wordWrapping = textFormat->GetWordWrapping();
+		layout->length = static_cast<UINT32>(text.size());
+		*GetHeldPtrAddress() = layout;
+	}
+
+	auto TextLayout::GetClusterCount() const noexcept -> UINT32
+	{
+		return static_cast<const StubTextLayout*>(GetHeldPtr())->length;
+	}
+
+	auto TextLayout::GetLineMetrics() const noexcept -> std::vector<DWRITE_LINE_METRICS1>
+	{
+		DWRITE_LINE_METRICS1 line{ };
+		line.length = GetClusterCount();
+		line.height = LineHeight;
+		return { line };
+	}
+
+	auto TextLayout::GetMetrics() const noexcept -> DWRITE_TEXT_METRICS1
+	{
+		DWRITE_TEXT_METRICS1 metrics{ };
+		metrics.width = CharacterWidth * static_cast<float>(GetClusterCount());
+		metrics.widthIncludingTrailingWhitespace = metrics.width;
+		metrics.height = LineHeight;
+		metrics.lineCount = 1;
+		return metrics;
+	}
+}
+
+namespace
+{
+	using namespace PGUI;
+	using PGUI::Tests::KeepAlive;
+	using Clock = std::chrono::steady_clock;
+
+	constexpr auto FrameCount = 3000;
+	constexpr long ScrollStep = 13;
+	constexpr SizeF ViewSize{ 800.0F, 600.0F };
+
+	auto MakeText(std::size_t lineCount) -> std::wstring
+	{
+		std::wstring text;
+		for (std::size_t i = 0; i < lineCount; i++)
+		{
+			text += L"line " + std::to_wstring(i) + L" the quick brown fox jumps over the lazy dog";
+			if (i + 1 < lineCount)
+			{
+				text += L'\r';
+			}
+		}
+		return text;
+	}
+
+	/*
+	* Scrolls a few pixels a frame from the middle of the document, the way a wheel or a dragged thumb does
+	*/
+	void MeasureScrolling(std::size_t lineCount)
+	{
+		const UI::TextBuffer document{ MakeText(lineCount), L'\r' };
+		UI::TextViewport viewport{ document };
+		UI::TextFormatDescriptor descriptor;
+		descriptor.wordWrapping = DWRITE_WORD_WRAPPING_NO_WRAP;
+		viewport.SetTextFormat(UI::TextFormat{ descriptor });
+
+		const Graphics::Graphics g;
+		const UI::Brush brush;
+
+		const auto maxScroll = static_cast<long>(viewport.GetContentHeight() - ViewSize.cy);
+		auto scroll = maxScroll / 2;
+
+		Clock::duration layoutTime{ };
+		Clock::duration worstLayoutTime{ };
+		Clock::duration drawTime{ };
+		std::size_t realizedCount = 0;
+		std::size_t shapedCount = 0;
+		for (auto frame = 0; frame < FrameCount; frame++)
+		{
+			scroll = scroll + ScrollStep > maxScroll ? 0 : scroll + ScrollStep;
+			viewport.Layout(PointL{ 0, scroll }, ViewSize);
+			viewport.Draw(g, PointF{ }, brush);
+
+			const auto& stats = viewport.GetFrameStats();
+			layoutTime += stats.layoutTime;
+			worstLayoutTime = std::max(worstLayoutTime, stats.layoutTime);
+			drawTime += stats.drawTime;
+			realizedCount += stats.realizedLineCount;
+			shapedCount += stats.shapedLineCount;
+		}
+		KeepAlive(Graphics::Graphics::drawCount);
+
+		using Microseconds = std::chrono::duration<double, std::micro>;
+		std::printf("%8zu lines, %9.0f px   layout %6.1f us/frame (worst %6.1f), draw %5.2f us/frame, "
+			"%4.1f realized, %4.2f shaped\n",
+			lineCount, viewport.GetContentHeight(),
+			Microseconds{ layoutTime }.count() / FrameCount, Microseconds{ worstLayoutTime }.count(),
+			Microseconds{ drawTime }.count() / FrameCount,
+			static_cast<double>(realizedCount) / FrameCount, static_cast<double>(shapedCount) / FrameCount);
+	}
+}
+
+auto main() -> int
+{
+	// The big documents scroll well past the 16 bits EM_GETSCROLLPOS could report
+	for (const auto lineCount : { 200UZ, 20'000UZ, 2'000'000UZ })
+	{
+		MeasureScrolling(lineCount);
+	}
+
+	return 0;
+}
@@ -0,0 +1,119 @@
+#include "helpers/TimerService.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+	using namespace std::chrono_literals;
+	using PGUI::TimerService;
+
+	constexpr auto TimerCount = 10;
+	constexpr auto Interval = 16ms;
+	constexpr auto RunTime = 2s;
+
+	auto ProcessCpuSeconds() noexcept -> double
+	{
+		timespec time{ };
+		clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+		return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_nsec) * 1e-9;
+	}
+
+	struct CpuUsage
+	{
+		double cpuStart = ProcessCpuSeconds();
+		TimerService::Clock::time_point wallStart = TimerService::Clock::now();
+
+		// Percent of one core since construction
+		[[nodiscard]] auto Get() const -> double
+		{
+			const auto wall = std::chrono::duration<double>(TimerService::Clock::now() - wallStart).count();
+			return 100.0 * (ProcessCpuSeconds() - cpuStart) / wall;
+		}
+	};
+
+	void MeasureTimerService()
+	{
+		TimerService service;
+
+		std::mutex mutex;
+		std::vector<double> lateness;
+		std::vector<TimerService::TimerId> ids;
+
+		const CpuUsage cpuUsage;
+		for (auto i = 0; i < TimerCount; i++)
+		{
+			auto expected = TimerService::Clock::now() + Interval;
+			ids.push_back(service.Schedule(Interval, [&mutex, &lateness, expected]() mutable
+			{
+				const auto late = std::chrono::duration<double, std::micro>(TimerService::Clock::now() - expected);
+				expected += Interval;
+
+				std::scoped_lock lock{ mutex };
+				lateness.push_back(late.count());
+			}));
+		}
+
+		std::this_thread::sleep_for(RunTime);
+		for (const auto id : ids)
+		{
+			service.Cancel(id);
+		}
+		const auto cpu = cpuUsage.Get();
+
+		std::ranges::sort(lateness);
+		double mean = 0.0;
+		for (const auto late : lateness)
+		{
+			mean += late / static_cast<double>(lateness.size());
+		}
+
+		std::printf("TimerService, %d timers every %lld ms: %zu ticks, late by mean %.0f us, p50 %.0f us, p99 %.0f us, max %.0f us, "
+			"%.2f%% of one core\n",
+			TimerCount, static_cast<long long>(Interval.count()), lateness.size(), mean,
+			lateness[lateness.size() / 2], lateness[lateness.size() * 99 / 100], lateness.back(), cpu);
+	}
+
+	// What TimerEvent did before, a thread per timer yielding until the interval passed
+	void MeasureBusyYield()
+	{
+		std::atomic<bool> stop = false;
+
+		const CpuUsage cpuUsage;
+		{
+			std::vector<std::jthread> threads;
+			for (auto i = 0; i < TimerCount; i++)
+			{
+				threads.emplace_back([&stop]
+				{
+					while (!stop)
+					{
+						const auto deadline = TimerService::Clock::now() + Interval;
+						while (TimerService::Clock::now() < deadline && !stop)
+						{
+							std::this_thread::yield();
+						}
+					}
+				});
+			}
+
+			std::this_thread::sleep_for(RunTime);
+			stop = true;
+		}
+
+		std::printf("Busy yield thread per timer, %d timers: %.2f%% of one core\n", TimerCount, cpuUsage.Get());
+	}
+}
+
+auto main() -> int
+{
+	MeasureTimerService();
+	MeasureBusyYield();
+}
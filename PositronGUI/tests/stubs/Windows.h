@@ -0,0 +1,129 @@
+#pragma once
+
+/*
+* Just enough of the Windows headers for the platform independent parts of PositronGUI to compile on Linux,
+* nothing here links to Windows code
+*/
+#include <atomic>
+#include <cstdint>
+
+
+using FLOAT = float;
+using BYTE = unsigned char;
+using DWORD = std::uint32_t;
+using COLORREF = DWORD;
+
+struct D2D1_COLOR_F
+{
+	FLOAT r;
+	FLOAT g;
+	FLOAT b;
+	FLOAT a;
+};
+
+namespace winrt::Windows::UI
+{
+	struct Color
+	{
+		BYTE A;
+		BYTE R;
+		BYTE G;
+		BYTE B;
+	};
+}
+
+using SHORT = short;
+using INT = int;
+using UINT16 = std::uint16_t;
+using UINT = unsigned int;
+using UINT32 = std::uint32_t;
+using LONG = long;
+using BOOL = int;
+using HRESULT = long;
+using WPARAM = std::uintptr_t;
+using LPARAM = std::intptr_t;
+using LRESULT = std::intptr_t;
+
+using HWND = struct HWND__*;
+using HINSTANCE = struct HINSTANCE__*;
+
+#define S_OK static_cast<HRESULT>(0)
+#define E_NOINTERFACE static_cast<HRESULT>(0x80004002L)
+#define E_OUTOFMEMORY static_cast<HRESULT>(0x8007000EL)
+#define E_NOT_SUFFICIENT_BUFFER static_cast<HRESULT>(0x8007007AL)
+#define FAILED(hr) (static_cast<HRESULT>(hr) < 0)
+#define SUCCEEDED(hr) (static_cast<HRESULT>(hr) >= 0)
+#define HRESULT_FROM_WIN32(error) static_cast<HRESULT>((error) == 0 ? 0 : (((error) & 0x0000FFFFL) | 0x80070000L))
+
+#define WM_CREATE 0x0001
+#define WM_DESTROY 0x0002
+#define WM_SIZE 0x0005
+#define WM_PAINT 0x000F
+#define WM_SETCURSOR 0x0020
+#define WM_NCHITTEST 0x0084
+#define WM_KEYDOWN 0x0100
+#define WM_CHAR 0x0102
+#define WM_TIMER 0x0113
+#define WM_MOUSEMOVE 0x0200
+#define WM_LBUTTONDOWN 0x0201
+#define WM_LBUTTONUP 0x0202
+#define WM_MOUSEWHEEL 0x020A
+#define WM_MOUSELEAVE 0x02A3
+#define WM_DPICHANGED 0x02E0
+#define WM_USER 0x0400
+
+inline auto GetLastError() -> DWORD
+{
+	return 0;
+}
+
+struct POINT
+{
+	LONG x;
+	LONG y;
+};
+
+struct POINTS
+{
+	SHORT x;
+	SHORT y;
+};
+
+struct SIZE
+{
+	LONG cx;
+	LONG cy;
+};
+
+struct RECT
+{
+	LONG left;
+	LONG top;
+	LONG right;
+	LONG bottom;
+};
+
+/*
+* COM reference counting without the registry, QueryInterface is a dynamic_cast
+*/
+struct IUnknown
+{
+	virtual ~IUnknown() = default;
+
+	auto AddRef() noexcept -> UINT
+	{
+		return ++referenceCount;
+	}
+	auto Release() noexcept -> UINT
+	{
+		const auto count = --referenceCount;
+		if (count == 0)
+		{
+			delete this;
+		}
+		return count;
+	}
+
+	private:
+	std::atomic<UINT> referenceCount = 1;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Windows.h"
+
+
+struct D2D1_POINT_2F
+{
+	FLOAT x;
+	FLOAT y;
+};
+
+struct D2D1_POINT_2U
+{
+	UINT32 x;
+	UINT32 y;
+};
+
+struct D2D1_SIZE_F
+{
+	FLOAT width;
+	FLOAT height;
+};
+
+struct D2D1_SIZE_U
+{
+	UINT32 width;
+	UINT32 height;
+};
+
+struct D2D1_RECT_F
+{
+	FLOAT left;
+	FLOAT top;
+	FLOAT right;
+	FLOAT bottom;
+};
+
+struct D2D1_RECT_U
+{
+	UINT32 left;
+	UINT32 top;
+	UINT32 right;
+	UINT32 bottom;
+};
@@ -0,0 +1,3 @@
+#pragma once
+
+#include "d2d1.h"
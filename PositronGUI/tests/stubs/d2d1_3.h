@@ -0,0 +1,3 @@
+#pragma once
+
+#include "d2d1_1.h"
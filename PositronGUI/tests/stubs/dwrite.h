@@ -0,0 +1,165 @@
+#pragma once
+
+#include "Windows.h"
+
+
+enum DWRITE_FONT_WEIGHT
+{
+	DWRITE_FONT_WEIGHT_THIN = 100,
+	DWRITE_FONT_WEIGHT_EXTRA_LIGHT = 200,
+	DWRITE_FONT_WEIGHT_ULTRA_LIGHT = 200,
+	DWRITE_FONT_WEIGHT_LIGHT = 300,
+	DWRITE_FONT_WEIGHT_SEMI_LIGHT = 350,
+	DWRITE_FONT_WEIGHT_NORMAL = 400,
+	DWRITE_FONT_WEIGHT_REGULAR = 400,
+	DWRITE_FONT_WEIGHT_MEDIUM = 500,
+	DWRITE_FONT_WEIGHT_DEMI_BOLD = 600,
+	DWRITE_FONT_WEIGHT_SEMI_BOLD = 600,
+	DWRITE_FONT_WEIGHT_BOLD = 700,
+	DWRITE_FONT_WEIGHT_EXTRA_BOLD = 800,
+	DWRITE_FONT_WEIGHT_ULTRA_BOLD = 800,
+	DWRITE_FONT_WEIGHT_BLACK = 900,
+	DWRITE_FONT_WEIGHT_HEAVY = 900,
+	DWRITE_FONT_WEIGHT_EXTRA_BLACK = 950,
+	DWRITE_FONT_WEIGHT_ULTRA_BLACK = 950
+};
+
+enum DWRITE_FONT_STRETCH
+{
+	DWRITE_FONT_STRETCH_UNDEFINED = 0,
+	DWRITE_FONT_STRETCH_ULTRA_CONDENSED = 1,
+	DWRITE_FONT_STRETCH_EXTRA_CONDENSED = 2,
+	DWRITE_FONT_STRETCH_CONDENSED = 3,
+	DWRITE_FONT_STRETCH_SEMI_CONDENSED = 4,
+	DWRITE_FONT_STRETCH_NORMAL = 5,
+	DWRITE_FONT_STRETCH_MEDIUM = 5,
+	DWRITE_FONT_STRETCH_SEMI_EXPANDED = 6,
+	DWRITE_FONT_STRETCH_EXPANDED = 7,
+	DWRITE_FONT_STRETCH_EXTRA_EXPANDED = 8,
+	DWRITE_FONT_STRETCH_ULTRA_EXPANDED = 9
+};
+
+enum DWRITE_FONT_STYLE
+{
+	DWRITE_FONT_STYLE_NORMAL,
+	DWRITE_FONT_STYLE_OBLIQUE,
+	DWRITE_FONT_STYLE_ITALIC
+};
+
+enum DWRITE_TEXT_ALIGNMENT
+{
+	DWRITE_TEXT_ALIGNMENT_LEADING,
+	DWRITE_TEXT_ALIGNMENT_TRAILING,
+	DWRITE_TEXT_ALIGNMENT_CENTER,
+	DWRITE_TEXT_ALIGNMENT_JUSTIFIED
+};
+
+enum DWRITE_PARAGRAPH_ALIGNMENT
+{
+	DWRITE_PARAGRAPH_ALIGNMENT_NEAR,
+	DWRITE_PARAGRAPH_ALIGNMENT_FAR,
+	DWRITE_PARAGRAPH_ALIGNMENT_CENTER
+};
+
+enum DWRITE_WORD_WRAPPING
+{
+	DWRITE_WORD_WRAPPING_WRAP = 0,
+	DWRITE_WORD_WRAPPING_NO_WRAP = 1,
+	DWRITE_WORD_WRAPPING_EMERGENCY_BREAK = 2,
+	DWRITE_WORD_WRAPPING_WHOLE_WORD = 3,
+	DWRITE_WORD_WRAPPING_CHARACTER = 4
+};
+
+enum DWRITE_READING_DIRECTION
+{
+	DWRITE_READING_DIRECTION_LEFT_TO_RIGHT = 0,
+	DWRITE_READING_DIRECTION_RIGHT_TO_LEFT = 1,
+	DWRITE_READING_DIRECTION_TOP_TO_BOTTOM = 2,
+	DWRITE_READING_DIRECTION_BOTTOM_TO_TOP = 3
+};
+
+enum DWRITE_FLOW_DIRECTION
+{
+	DWRITE_FLOW_DIRECTION_TOP_TO_BOTTOM = 0,
+	DWRITE_FLOW_DIRECTION_BOTTOM_TO_TOP = 1,
+	DWRITE_FLOW_DIRECTION_LEFT_TO_RIGHT = 2,
+	DWRITE_FLOW_DIRECTION_RIGHT_TO_LEFT = 3
+};
+
+enum DWRITE_TRIMMING_GRANULARITY
+{
+	DWRITE_TRIMMING_GRANULARITY_NONE,
+	DWRITE_TRIMMING_GRANULARITY_CHARACTER,
+	DWRITE_TRIMMING_GRANULARITY_WORD
+};
+
+enum DWRITE_LINE_SPACING_METHOD
+{
+	DWRITE_LINE_SPACING_METHOD_DEFAULT,
+	DWRITE_LINE_SPACING_METHOD_UNIFORM,
+	DWRITE_LINE_SPACING_METHOD_PROPORTIONAL
+};
+
+enum DWRITE_FONT_LINE_GAP_USAGE
+{
+	DWRITE_FONT_LINE_GAP_USAGE_DEFAULT,
+	DWRITE_FONT_LINE_GAP_USAGE_DISABLED,
+	DWRITE_FONT_LINE_GAP_USAGE_ENABLED
+};
+
+struct DWRITE_LINE_SPACING
+{
+	DWRITE_LINE_SPACING_METHOD method;
+	FLOAT height;
+	FLOAT baseline;
+	FLOAT leadingBefore;
+	DWRITE_FONT_LINE_GAP_USAGE fontLineGapUsage;
+};
+
+struct DWRITE_TRIMMING
+{
+	DWRITE_TRIMMING_GRANULARITY granularity;
+	UINT32 delimiter;
+	UINT32 delimiterCount;
+};
+
+struct DWRITE_TEXT_RANGE
+{
+	UINT32 startPosition;
+	UINT32 length;
+};
+
+struct DWRITE_CLUSTER_METRICS
+{
+	FLOAT width;
+	UINT16 length;
+	UINT16 flags;
+};
+
+struct DWRITE_TEXT_METRICS
+{
+	FLOAT left;
+	FLOAT top;
+	FLOAT width;
+	FLOAT widthIncludingTrailingWhitespace;
+	FLOAT height;
+	FLOAT layoutWidth;
+	FLOAT layoutHeight;
+	UINT32 maxBidiReorderingDepth;
+	UINT32 lineCount;
+};
+
+struct DWRITE_HIT_TEST_METRICS
+{
+	UINT32 textPosition;
+	UINT32 length;
+	FLOAT left;
+	FLOAT top;
+	FLOAT width;
+	FLOAT height;
+	UINT32 bidiLevel;
+	BOOL isText;
+	BOOL isTrimmed;
+};
+
+struct IDWriteInlineObject : IUnknown { };
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "dwrite.h"
+
+
+struct DWRITE_TEXT_METRICS1 : DWRITE_TEXT_METRICS
+{
+	FLOAT heightIncludingTrailingWhitespace;
+};
+
+struct DWRITE_LINE_METRICS1
+{
+	UINT32 length;
+	UINT32 trailingWhitespaceLength;
+	UINT32 newlineLength;
+	FLOAT height;
+	FLOAT baseline;
+	BOOL isTrimmed;
+	FLOAT leadingBefore;
+	FLOAT leadingAfter;
+};
+
+struct IDWriteFontCollection3 : IUnknown { };
+
+/*
+* The layout settings as plain fields, a test's layout fills in the rest
+*/
+struct IDWriteTextFormat3 : IUnknown
+{
+	DWRITE_TEXT_ALIGNMENT textAlignment = DWRITE_TEXT_ALIGNMENT_LEADING;
+	DWRITE_PARAGRAPH_ALIGNMENT paragraphAlignment = DWRITE_PARAGRAPH_ALIGNMENT_NEAR;
+	DWRITE_WORD_WRAPPING wordWrapping = DWRITE_WORD_WRAPPING_WRAP;
+	DWRITE_READING_DIRECTION readingDirection = DWRITE_READING_DIRECTION_LEFT_TO_RIGHT;
+	DWRITE_FLOW_DIRECTION flowDirection = DWRITE_FLOW_DIRECTION_TOP_TO_BOTTOM;
+	DWRITE_TRIMMING trimming{ };
+
+	[[nodiscard]] auto GetTextAlignment() const noexcept { return textAlignment; }
+	[[nodiscard]] auto GetParagraphAlignment() const noexcept { return paragraphAlignment; }
+	[[nodiscard]] auto GetWordWrapping() const noexcept { return wordWrapping; }
+	[[nodiscard]] auto GetReadingDirection() const noexcept { return readingDirection; }
+	[[nodiscard]] auto GetFlowDirection() const noexcept { return flowDirection; }
+	auto GetTrimming(DWRITE_TRIMMING* _trimming, IDWriteInlineObject** trimmingSign) const noexcept -> HRESULT
+	{
+		*_trimming = trimming;
+		*trimmingSign = nullptr;
+		return S_OK;
+	}
+};
+
+struct IDWriteTextLayout4 : IDWriteTextFormat3
+{
+	/**
+	* @brief One box per range, a character wide per character and a line high
+	*/
+	auto HitTestTextRange(UINT32 textPosition, UINT32 textLength, FLOAT originX, FLOAT originY,
+		DWRITE_HIT_TEST_METRICS* hitTestMetrics, UINT32 maxHitTestMetricsCount, UINT32* actualHitTestMetricsCount) const noexcept -> HRESULT
+	{
+		*actualHitTestMetricsCount = 1;
+		if (maxHitTestMetricsCount < 1)
+		{
+			return E_NOT_SUFFICIENT_BUFFER;
+		}
+		hitTestMetrics[0] = DWRITE_HIT_TEST_METRICS{
+			.textPosition = textPosition,
+			.length = textLength,
+			.left = originX + static_cast<FLOAT>(textPosition),
+			.top = originY,
+			.width = static_cast<FLOAT>(textLength),
+			.height = 1.0F,
+			.bidiLevel = 0,
+			.isText = 1,
+			.isTrimmed = 0
+		};
+		return S_OK;
+	}
+
+	auto GetDrawingEffect(UINT32, IUnknown** drawingEffect, DWRITE_TEXT_RANGE*) const noexcept -> HRESULT
+	{
+		*drawingEffect = nullptr;
+		return S_OK;
+	}
+	auto SetDrawingEffect(IUnknown*, DWRITE_TEXT_RANGE) noexcept -> HRESULT
+	{
+		return S_OK;
+	}
+};
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "core/Point.hpp"
+#include "core/Rect.hpp"
+#include "ui/Brush.hpp"
+#include "ui/TextLayout.hpp"
+
+#include <cstddef>
+
+
+namespace PGUI::Graphics
+{
+	/**
+	* @brief Stands in for the Direct2D device context, counts what it would have drawn
+	*/
+	class Graphics
+	{
+		public:
+		void DrawTextLayout(PointF, const UI::TextLayout&, const UI::Brush&) const noexcept { drawCount++; }
+		void FillRect(RectF, const UI::Brush&) const noexcept { fillCount++; }
+
+		static inline std::size_t drawCount = 0;
+		static inline std::size_t fillCount = 0;
+	};
+}
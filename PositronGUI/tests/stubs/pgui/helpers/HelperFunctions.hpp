@@ -0,0 +1,47 @@
+#pragma once
+
+/*
+* The parts of helpers/HelperFunctions.hpp the text code uses, the real header needs <format>
+*/
+#include "core/Point.hpp"
+#include "core/Rect.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <Windows.h>
+
+
+namespace PGUI
+{
+	inline constexpr std::uint64_t HashSeed = 0xCBF29CE484222325ULL;
+
+	[[nodiscard]] inline auto HashBytes(std::span<const std::byte> bytes, std::uint64_t hash = HashSeed) noexcept
+		-> std::uint64_t
+	{
+		for (const auto byte : bytes)
+		{
+			hash = (hash ^ static_cast<std::uint64_t>(byte)) * 0x100000001B3ULL;
+		}
+		return hash;
+	}
+	template <typename T> requires std::is_trivially_copyable_v<T>
+	[[nodiscard]] auto HashValue(const T& value, std::uint64_t hash = HashSeed) noexcept -> std::uint64_t
+	{
+		return HashBytes(std::as_bytes(std::span{ &value, 1 }), hash);
+	}
+
+	inline void HR_L(HRESULT) noexcept
+	{
+	}
+
+	inline void HR_T(HRESULT hr) noexcept(false)
+	{
+		if (FAILED(hr))
+		{
+			throw std::runtime_error{ "HRESULT failed" };
+		}
+	}
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+
+namespace PGUI::UI
+{
+	/**
+	* @brief Stands in for the Direct2D brush, nothing reads it
+	*/
+	class Brush
+	{
+	};
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+
+namespace Microsoft::WRL
+{
+	template <typename T>
+	class ComPtr
+	{
+		public:
+		ComPtr() noexcept = default;
+		ComPtr(std::nullptr_t) noexcept { }
+		ComPtr(T* _ptr) noexcept : ptr{ _ptr }
+		{
+			if (ptr != nullptr)
+			{
+				ptr->AddRef();
+			}
+		}
+		template <typename U> requires std::is_convertible_v<U*, T*>
+		ComPtr(const ComPtr<U>& other) noexcept : ComPtr{ other.Get() } { }
+		ComPtr(const ComPtr& other) noexcept : ComPtr{ other.ptr } { }
+		ComPtr(ComPtr&& other) noexcept : ptr{ std::exchange(other.ptr, nullptr) } { }
+		~ComPtr() noexcept
+		{
+			if (ptr != nullptr)
+			{
+				ptr->Release();
+			}
+		}
+
+		auto operator=(ComPtr other) noexcept -> ComPtr&
+		{
+			std::swap(ptr, other.ptr);
+			return *this;
+		}
+
+		[[nodiscard]] auto Get() const noexcept { return ptr; }
+		[[nodiscard]] auto GetAddressOf() noexcept { return &ptr; }
+		[[nodiscard]] auto GetAddressOf() const noexcept { return &ptr; }
+		[[nodiscard]] auto operator->() const noexcept { return ptr; }
+		[[nodiscard]] operator bool() const noexcept { return ptr != nullptr; }
+		auto operator&() noexcept
+		{
+			*this = nullptr;
+			return &ptr;
+		}
+
+		template <typename U>
+		auto As(ComPtr<U>* other) const noexcept -> long
+		{
+			*other = dynamic_cast<U*>(ptr);
+			return *other ? 0 : static_cast<long>(0x80004002L);
+		}
+
+		private:
+		T* ptr = nullptr;
+	};
+}